@@ -779,7 +779,10 @@ classdef Us4R < handle
             
             %% If GPU is available...
             obj.rec.gpuEnable	= license('test', 'Distrib_Computing_Toolbox') && ~isempty(ver('parallel')) && parallel.gpu.GPUDevice.isAvailable;
-            
+
+            % Add location of the CPU kernels
+            addpath([fileparts(mfilename('fullpath')) '\mexcpu']);
+
             if obj.rec.gpuEnable && obj.rec.gridModeEnable
                 % Add location of the CUDA kernels
                 addpath([fileparts(mfilename('fullpath')) '\mexcuda']);
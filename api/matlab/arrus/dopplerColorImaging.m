@@ -31,35 +31,62 @@ if nRep-proc.wcFiltInitSize < 2
     error('Not enough data for Color Doppler. Possibly nRep to small or wcFiltInitSize to large.');
 end
 
-%% Wall Clutter Filtration
-iqImgSetFlt = zeros(nZPix,nXPix,nRep,nProj,'like',iqImgSet);
-if isempty(proc.wcFiltA)
+if ~proc.gpuEnable
+    %% Wall Clutter Filtration + Mean frequency estimator (CPU, single pass)
+    if isempty(proc.wcFiltA)
+        % FIR filter: causal filtration with zero initial state, the first
+        % wcFiltInitSize (transient) samples are rejected; for
+        % wcFiltInitSize = numel(wcFiltB)-1 the same (complete) filter windows
+        % are kept as by the 'same' convolution of the GPU path
+        wcFiltA         = 1;
+        wcFiltInitCoeff = [];
+    else
+        wcFiltA         = proc.wcFiltA;
+        wcFiltInitCoeff = proc.wcFiltInitCoeff;
+    end
+    color = zeros(nZPix,nXPix,1,nProj,'single');
+    power = zeros(nZPix,nXPix,1,nProj,'single');
+    turbu = zeros(nZPix,nXPix,1,nProj,'single');
     for iProj=1:nProj
-        iqImgSetFltAux = reshape(iqImgSet(:,:,:,iProj),nZPix*nXPix,nRep);
-        iqImgSetFlt(:,:,:,iProj) = reshape(conv2(iqImgSetFltAux,proc.wcFiltB(:).','same'),nZPix,nXPix,nRep);
+        [color(:,:,1,iProj), ...
+         power(:,:,1,iProj), ...
+         turbu(:,:,1,iProj)] = dopplerColorCpu(single(gather(iqImgSet(:,:,:,iProj))), ...
+                                               single(proc.wcFiltB), ...
+                                               single(wcFiltA), ...
+                                               single(wcFiltInitCoeff), ...
+                                               proc.wcFiltInitSize);
     end
-    iqImgSetFlt = iqImgSetFlt(:, :, (1 + floor(proc.wcFiltInitSize/2)) : (nRep - ceil(proc.wcFiltInitSize/2)), :);
 else
-    for iProj=1:nProj
-        if proc.gpuEnable && ((max(numel(proc.wcFiltB),numel(proc.wcFiltA))-1) <= 8)
-            iqImgSetFlt(:,:,:,iProj) = wcFilter(iqImgSet(:,:,:,iProj), proc.wcFiltB, proc.wcFiltA, proc.wcFiltInitCoeff);
-        else
-            wcFiltInitState = proc.wcFiltInitCoeff(:).*reshape(iqImgSet(:,:,1,iProj),1,nZPix*nXPix);
-            iqImgSetFltAux = reshape(iqImgSet(:,:,:,iProj),nZPix*nXPix,nRep).';
-            iqImgSetFlt(:,:,:,iProj) = reshape(filter(proc.wcFiltB, proc.wcFiltA, iqImgSetFltAux, wcFiltInitState).',nZPix,nXPix,nRep);
+    %% Wall Clutter Filtration
+    iqImgSetFlt = zeros(nZPix,nXPix,nRep,nProj,'like',iqImgSet);
+    if isempty(proc.wcFiltA)
+        for iProj=1:nProj
+            iqImgSetFltAux = reshape(iqImgSet(:,:,:,iProj),nZPix*nXPix,nRep);
+            iqImgSetFlt(:,:,:,iProj) = reshape(conv2(iqImgSetFltAux,proc.wcFiltB(:).','same'),nZPix,nXPix,nRep);
+        end
+        iqImgSetFlt = iqImgSetFlt(:, :, (1 + floor(proc.wcFiltInitSize/2)) : (nRep - ceil(proc.wcFiltInitSize/2)), :);
+    else
+        for iProj=1:nProj
+            if proc.gpuEnable && ((max(numel(proc.wcFiltB),numel(proc.wcFiltA))-1) <= 8)
+                iqImgSetFlt(:,:,:,iProj) = wcFilter(iqImgSet(:,:,:,iProj), proc.wcFiltB, proc.wcFiltA, proc.wcFiltInitCoeff);
+            else
+                wcFiltInitState = proc.wcFiltInitCoeff(:).*reshape(iqImgSet(:,:,1,iProj),1,nZPix*nXPix);
+                iqImgSetFltAux = reshape(iqImgSet(:,:,:,iProj),nZPix*nXPix,nRep).';
+                iqImgSetFlt(:,:,:,iProj) = reshape(filter(proc.wcFiltB, proc.wcFiltA, iqImgSetFltAux, wcFiltInitState).',nZPix,nXPix,nRep);
+            end
         end
+        iqImgSetFlt = iqImgSetFlt(:, :, (1 + proc.wcFiltInitSize) : end, :);
     end
-    iqImgSetFlt = iqImgSetFlt(:, :, (1 + proc.wcFiltInitSize) : end, :);
-end
 
-%% Mean frequency estimator (in fact - it's a mean phase shift estimator)
-color = zeros(nZPix,nXPix,1,nProj,'single','gpuArray');
-power = zeros(nZPix,nXPix,1,nProj,'single','gpuArray');
-turbu = zeros(nZPix,nXPix,1,nProj,'single','gpuArray');
-for iProj=1:nProj
-    [color(:,:,1,iProj), ...
-     power(:,:,1,iProj), ...
-     turbu(:,:,1,iProj),] = dopplerColor(iqImgSetFlt(:,:,:,iProj));
+    %% Mean frequency estimator (in fact - it's a mean phase shift estimator)
+    color = zeros(nZPix,nXPix,1,nProj,'single','gpuArray');
+    power = zeros(nZPix,nXPix,1,nProj,'single','gpuArray');
+    turbu = zeros(nZPix,nXPix,1,nProj,'single','gpuArray');
+    for iProj=1:nProj
+        [color(:,:,1,iProj), ...
+         power(:,:,1,iProj), ...
+         turbu(:,:,1,iProj),] = dopplerColor(iqImgSetFlt(:,:,:,iProj));
+    end
 end
 
 %% Vector Doppler (optional)
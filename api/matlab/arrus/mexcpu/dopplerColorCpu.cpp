@@ -0,0 +1,71 @@
+#include "mex.h"
+
+#include <string>
+#include <vector>
+
+#include "arrus/core/api/processing/ColorDoppler.h"
+
+/*
+ * [color, power, turbu] = dopplerColorCpu(iqImg, wcFiltB, wcFiltA, wcFiltInitCoeff, wcFiltInitSize)
+ *
+ * CPU Color Doppler: wall clutter filtration (IIR, state initialized with wcFiltInitCoeff*(the first sample),
+ * the first wcFiltInitSize output samples rejected) and mean phase shift estimation.
+ * iqImg should be a single, complex (nZPix, nXPix, nRep) array. Requires the interleaved complex API (-R2018a).
+ */
+
+static std::vector<float> getCoefficients(mxArray const *array, char const *msgId, char const *name) {
+    if (mxGetClassID(array) != mxSINGLE_CLASS || mxIsComplex(array)) {
+        mexErrMsgIdAndTxt(msgId, "%s must be single, real vector", name);
+    }
+    mxSingle const *data = mxGetSingles(array);
+    return std::vector<float>(data, data + mxGetNumberOfElements(array));
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, mxArray const *prhs[]) {
+    char const *const invalidInputMsgId = "dopplerColorCpu:InvalidInput";
+    char const *const invalidOutputMsgId = "dopplerColorCpu:InvalidOutput";
+    char const *const processingMsgId = "dopplerColorCpu:ProcessingError";
+
+    /* Validate mex inputs/outputs */
+    if (nrhs != 5) {
+        mexErrMsgIdAndTxt(invalidInputMsgId, "Five inputs required");
+    }
+    if (nlhs > 3) {
+        mexErrMsgIdAndTxt(invalidOutputMsgId, "Three outputs allowed");
+    }
+    mxArray const *iqImg = prhs[0];
+    if (mxGetClassID(iqImg) != mxSINGLE_CLASS || !mxIsComplex(iqImg) || mxGetNumberOfDimensions(iqImg) > 3) {
+        mexErrMsgIdAndTxt(invalidInputMsgId, "iqImg must be single, complex 3D array");
+    }
+    if (!mxIsScalar(prhs[4])) {
+        mexErrMsgIdAndTxt(invalidInputMsgId, "wcFiltInitSize must be a scalar");
+    }
+    std::vector<float> b = getCoefficients(prhs[1], invalidInputMsgId, "wcFiltB");
+    std::vector<float> a = getCoefficients(prhs[2], invalidInputMsgId, "wcFiltA");
+    std::vector<float> initCoeff = getCoefficients(prhs[3], invalidInputMsgId, "wcFiltInitCoeff");
+    unsigned nRejected = (unsigned) mxGetScalar(prhs[4]);
+
+    mwSize const *dims = mxGetDimensions(iqImg);
+    mwSize nZPix = dims[0];
+    mwSize nXPix = dims[1];
+    mwSize nRep = mxGetNumberOfDimensions(iqImg) == 3 ? dims[2] : 1;
+
+    /* Create outputs */
+    plhs[0] = mxCreateNumericMatrix(nZPix, nXPix, mxSINGLE_CLASS, mxREAL);
+    plhs[1] = mxCreateNumericMatrix(nZPix, nXPix, mxSINGLE_CLASS, mxREAL);
+    plhs[2] = mxCreateNumericMatrix(nZPix, nXPix, mxSINGLE_CLASS, mxREAL);
+
+    /* Column-major (nZPix, nXPix, nRep) == (nRep, nPixels) in row-major order, as expected by ColorDoppler */
+    std::string errorMsg;
+    try {
+        arrus::processing::ColorDoppler doppler{b, a, initCoeff, nRejected};
+        doppler.process(reinterpret_cast<float const *>(mxGetComplexSingles(iqImg)), nRep, nZPix * nXPix,
+                        mxGetSingles(plhs[0]), mxGetSingles(plhs[1]), mxGetSingles(plhs[2]));
+    } catch (std::exception const &e) {
+        errorMsg = e.what();
+    }
+    /* Note: mexErrMsgIdAndTxt does not return, so it is called outside the try-catch block */
+    if (!errorMsg.empty()) {
+        mexErrMsgIdAndTxt(processingMsgId, "%s", errorMsg.c_str());
+    }
+}
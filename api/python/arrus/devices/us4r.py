@@ -3,6 +3,7 @@ import numpy as np
 
 from arrus.devices.device import Device, DeviceId, DeviceType
 from arrus.devices.ultrasound import Ultrasound
+import arrus.core
 import arrus.exceptions
 import arrus.devices.probe
 import arrus.ops.imaging
@@ -40,6 +41,118 @@ class FrameChannelMapping:
     batch_size: int = 1
 
 
+@dataclasses.dataclass(frozen=True)
+class Us4OEMTelemetry:
+    """
+    A single telemetry sample of a single us4OEM module.
+    Values that could not be read from the device are NaN.
+
+    :param fpga_temperature: FPGA temperature [Celsius]
+    :param ucd_temperature: UCD temperature [Celsius]
+    :param ucd_external_temperature: UCD external temperature [Celsius]
+    :param hvp_voltage: measured HVP voltage [V]
+    :param hvm_voltage: measured HVM voltage [V]
+    :param fpga_wallclock: FPGA wallclock [s]
+    :param ucd_voltages: voltages measured on the selected UCD rails [V]
+    """
+    fpga_temperature: float
+    ucd_temperature: float
+    ucd_external_temperature: float
+    hvp_voltage: float
+    hvm_voltage: float
+    fpga_wallclock: float
+    ucd_voltages: tuple
+
+
+@dataclasses.dataclass(frozen=True)
+class TelemetrySnapshot:
+    """
+    Telemetry of all us4OEM modules, sampled at the given time.
+
+    :param timestamp: sampling time, the number of milliseconds since the Unix epoch
+    :param us4oems: telemetry of the subsequent us4OEM modules
+    """
+    timestamp: int
+    us4oems: tuple
+
+
+@dataclasses.dataclass(frozen=True)
+class DurationHistogram:
+    """
+    Histogram of the measured durations [s]; the bins are spaced logarithmically.
+
+    :param bin_edges: bin edges [s], bin i covers [bin_edges[i], bin_edges[i+1])
+    :param counts: the number of values in each bin
+    :param min: minimum value [s]
+    :param max: maximum value [s]
+    :param mean: mean value [s]
+    :param p50: median (approximate, the upper edge of the bin) [s]
+    :param p99: 99th percentile (approximate, the upper edge of the bin) [s]
+    """
+    bin_edges: np.ndarray
+    counts: np.ndarray
+    min: float
+    max: float
+    mean: float
+    p50: float
+    p99: float
+
+
+@dataclasses.dataclass(frozen=True)
+class AcquisitionStatistics:
+    """
+    Acquisition statistics of the us4R output buffer, collected since the last reset.
+    A single frame is a single output buffer element.
+
+    :param n_acquired: the number of frames acquired by all us4OEMs
+    :param n_delivered: the number of frames passed to the user callback
+    :param n_dropped: the estimated number of frames lost (based on the frame metadata
+      trigger numbers, 0 if the frame metadata is not available)
+    :param n_overflows: the number of buffer overflows
+    :param buffer_occupancy_high_water_mark: maximum number of elements waiting to be released
+    :param duration: time since the last reset [s]
+    :param frame_rate: mean frame rate measured with the host clock [Hz]
+    :param host_interval: intervals between subsequent frames, measured with the host clock
+    :param fpga_interval: intervals between subsequent frames, measured with the FPGA timestamps
+    :param callback_duration: durations of the user callback
+    """
+    n_acquired: int
+    n_delivered: int
+    n_dropped: int
+    n_overflows: int
+    buffer_occupancy_high_water_mark: int
+    duration: float
+    frame_rate: float
+    host_interval: DurationHistogram
+    fpga_interval: DurationHistogram
+    callback_duration: DurationHistogram
+
+
+def _convert_duration_histogram(h):
+    return DurationHistogram(
+        bin_edges=np.asarray(h.getBinEdges(), dtype=np.float32),
+        counts=np.asarray(h.getCounts(), dtype=np.uint64),
+        min=h.getMin(), max=h.getMax(), mean=h.getMean(),
+        p50=h.getPercentile(50), p99=h.getPercentile(99))
+
+
+def convert_acquisition_statistics(stats) -> AcquisitionStatistics:
+    """
+    Converts arrus.core.AcquisitionStatistics to the AcquisitionStatistics dataclass.
+    """
+    return AcquisitionStatistics(
+        n_acquired=stats.getNumberOfAcquiredFrames(),
+        n_delivered=stats.getNumberOfDeliveredFrames(),
+        n_dropped=stats.getNumberOfDroppedFrames(),
+        n_overflows=stats.getNumberOfOverflows(),
+        buffer_occupancy_high_water_mark=stats.getBufferOccupancyHighWaterMark(),
+        duration=stats.getDuration(),
+        frame_rate=stats.getFrameRate(),
+        host_interval=_convert_duration_histogram(stats.getHostInterval()),
+        fpga_interval=_convert_duration_histogram(stats.getFPGAInterval()),
+        callback_duration=_convert_duration_histogram(stats.getCallbackDuration()))
+
+
 class Backplane:
     """
     Digital backplane of the us4R device.
@@ -310,14 +423,22 @@ class Us4R(Device, Ultrasound):
         fcm = self._get_fcm(upload_result, sequence)
         return arrus.metadata.EchoDataDescription(
             sampling_frequency=self.current_sampling_frequency,
-            custom={"frame_channel_mapping": fcm}
+            custom={
+                "frame_channel_mapping": fcm,
+                "frame_metadata_offsets": self._get_frame_metadata_offsets(
+                    upload_result)
+            }
         )
 
     def get_data_description_updated_for_subsequence(self, upload_result, sequence):
         fcm = self._get_fcm(upload_result, sequence)
         return arrus.metadata.EchoDataDescription(
             sampling_frequency=self.current_sampling_frequency,
-            custom={"frame_channel_mapping": fcm}
+            custom={
+                "frame_channel_mapping": fcm,
+                "frame_metadata_offsets": self._get_frame_metadata_offsets(
+                    upload_result)
+            }
         )
 
     def set_stop_on_overflow(self, is_stop):
@@ -336,6 +457,106 @@ class Us4R(Device, Ultrasound):
         """
         self._handle.setMaximumPulseLength(max_length)
 
+    def set_rx_nops_metadata_only(self, value: bool):
+        """
+        Enables/disables metadata-only acquisitions for RX NOPs on the us4OEM that gathers the frame metadata.
+
+        When enabled, TX/RXs without any active RX channel acquire only the first few samples (including
+        the metadata). These compact frames are stored after all data frames of the us4OEM;
+        the ExtractMetadata operator still returns the metadata of all TX/RXs, in the order of acquisition.
+        Sub-sequences are not available in this mode. The setting is applied on the next upload.
+
+        :param value: whether the metadata-only RX NOPs should be enabled
+        """
+        self._handle.setRxNopsMetadataOnly(value)
+
+    def start_telemetry(self, sampling_period: float = 1.0, history_size: int = 600,
+                        ucd_rails: Iterable = (),
+                        max_fpga_temperature: Optional[float] = None,
+                        max_ucd_temperature: Optional[float] = None):
+        """
+        Starts sampling the telemetry of all us4OEM modules (temperatures and voltages)
+        on a separate, low-priority thread. The sampling does not affect the data acquisition.
+
+        The threshold alerts are reported as warnings in the log.
+
+        :param sampling_period: time between subsequent samples [s]
+        :param history_size: the number of the most recent samples to keep
+        :param ucd_rails: UCD rails, which voltages should be sampled
+        :param max_fpga_temperature: FPGA temperature alert threshold, None means no alert
+        :param max_ucd_temperature: UCD temperature alert threshold, None means no alert
+        """
+        rails = arrus.core.VectorUInt8()
+        for rail in ucd_rails:
+            rails.push_back(int(rail))
+        settings = arrus.core.TelemetrySettings(
+            float(sampling_period), int(history_size), rails,
+            max_fpga_temperature, max_ucd_temperature)
+        self._handle.startTelemetry(settings)
+
+    def stop_telemetry(self):
+        """
+        Stops sampling the telemetry. The samples collected so far are discarded.
+        """
+        self._handle.stopTelemetry()
+
+    def get_latest_telemetry(self) -> Optional[TelemetrySnapshot]:
+        """
+        Returns the most recent telemetry sample, None if the telemetry sampler is not running or
+        no sample is available yet.
+        """
+        snapshots = arrus.core.arrusUs4RGetLatestTelemetry(self._handle)
+        if len(snapshots) == 0:
+            return None
+        return self._convert_telemetry_snapshot(snapshots[0])
+
+    def get_telemetry_history(self) -> list:
+        """
+        Returns all the telemetry samples currently kept in memory, ordered from the oldest to the newest one.
+        """
+        return [self._convert_telemetry_snapshot(s)
+                for s in self._handle.getTelemetryHistory()]
+
+    def get_acquisition_statistics(self) -> AcquisitionStatistics:
+        """
+        Returns the acquisition statistics (acquired, delivered and dropped frames, frame intervals, etc.)
+        collected since the last reset. The statistics are kept across the uploads.
+        """
+        return convert_acquisition_statistics(self._handle.getAcquisitionStatistics())
+
+    def reset_acquisition_statistics(self):
+        """
+        Resets the acquisition statistics.
+        """
+        self._handle.resetAcquisitionStatistics()
+
+    def _convert_telemetry_snapshot(self, snapshot):
+        us4oems = []
+        for i in range(snapshot.getNumberOfUs4OEMs()):
+            t = snapshot.getUs4OEM(i)
+            us4oems.append(Us4OEMTelemetry(
+                fpga_temperature=t.getFPGATemperature(),
+                ucd_temperature=t.getUCDTemperature(),
+                ucd_external_temperature=t.getUCDExternalTemperature(),
+                hvp_voltage=t.getMeasuredHVPVoltage(),
+                hvm_voltage=t.getMeasuredHVMVoltage(),
+                fpga_wallclock=t.getFPGAWallclock(),
+                ucd_voltages=tuple(t.getUCDMeasuredVoltages())
+            ))
+        return TelemetrySnapshot(timestamp=snapshot.getTimestamp(), us4oems=tuple(us4oems))
+
+
+    def _get_frame_metadata_offsets(self, upload_result):
+        """
+        Returns the positions of the frame metadata rows in the buffer
+        element (the number of int16 values from the beginning of the
+        element), in the order of acquisition (firing).
+
+        :param upload_result: self.upload result
+        :return: numpy array of offsets, empty if the metadata is not available
+        """
+        offsets = arrus.core.getFrameMetadataOffsets(upload_result)
+        return np.array(list(offsets), dtype=np.uint64)
 
     def _get_fcm(self, upload_result, sequence):
         """
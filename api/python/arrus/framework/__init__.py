@@ -34,6 +34,23 @@ class OnBufferOverflowCallback(arrus.core.OnBufferOverflowCallbackWrapper):
             traceback.print_exc()
 
 
+# DLPack DLDeviceType.kDLCPU
+_DLPACK_DEVICE_CPU = 1
+
+
+def ndarray_to_dlpack(ndarray):
+    """
+    Exports the given arrus.core.NdArray as a DLPack capsule, without copying
+    the data. The array owning its memory is kept alive as long as the tensor
+    is used; for views (e.g. the buffer element data), the caller is
+    responsible for keeping the memory valid.
+
+    :param ndarray: arrus.core.NdArray to export
+    :return: DLPack capsule
+    """
+    return arrus.core.arrusNdArrayToDlpack(ndarray)
+
+
 class DataBufferElement:
     """
     Data buffer element. Allows to access the space of the acquired data.
@@ -55,18 +72,58 @@ class DataBufferElement:
     def size(self):
         return self._size
 
+    @property
+    def n_frame_metadata(self):
+        """
+        The number of frames, for which the frame metadata is available.
+        """
+        return self._element_handle.getNumberOfFrameMetadata()
+
+    def get_frame_metadata(self, frame):
+        """
+        Returns metadata of the given frame (FPGA timestamp, trigger number,
+        tx begin/end). The metadata is decoded directly from the buffer
+        element memory, so it is valid until the element is released.
+
+        :param frame: frame number, in the order of acquisition
+        :return: arrus.core.FrameMetadata (getTimestamp(), getTriggerNumber(),
+          getTxBegin(), getTxEnd(), getValue(i))
+        """
+        return self._element_handle.getFrameMetadata(frame)
+
     def release(self):
         self._element_handle.release()
 
+    def to_dlpack(self):
+        """
+        Returns the element data as a DLPack capsule, without copying the data
+        (the tensor points directly to the buffer element memory).
+
+        The element is released when the consumer (e.g. torch.from_dlpack,
+        numpy.from_dlpack, jax.dlpack.from_dlpack) deletes the tensor, i.e.
+        the element should not be released in any other way; new data can be
+        written to the element only after that. The capsule can be consumed
+        only once.
+        """
+        return arrus.core.arrusBufferElementToDlpack(self._element_handle)
+
+    def __dlpack__(self, stream=None):
+        """
+        DLPack protocol, see to_dlpack. The data is located in the host memory,
+        so the stream is ignored.
+        """
+        return self.to_dlpack()
+
+    def __dlpack_device__(self):
+        return _DLPACK_DEVICE_CPU, 0
+
     def _create_np_array(self, element):
         ndarray = element.getData()
         if ndarray.getDataType() != arrus.core.NdArray.DataType_INT16:
             raise ValueError("Currently output data type int16 is supported "
                              "only.")
-        addr = arrus.core.castToInt(ndarray.getInt16())
-        ctypes_ptr = ctypes.cast(addr, ctypes.POINTER(ctypes.c_int16))
         shape = arrus.utils.core.convert_from_tuple(ndarray.getShape())
-        arr = np.ctypeslib.as_array(ctypes_ptr, shape=shape)
+        arr = self._wrap_int16_array(ndarray)
         self.shape = shape
         return arr
 
@@ -74,12 +131,28 @@ class DataBufferElement:
         if self._element_handle != self.shape:
             ndarray = self._element_handle.getData()
             shape = arrus.utils.core.convert_from_tuple(ndarray.getShape())
-            addr = arrus.core.castToInt(ndarray.getInt16())
-            ctypes_ptr = ctypes.cast(addr, ctypes.POINTER(ctypes.c_int16))
-            self._numpy_array_wrapping = np.ctypeslib.as_array(ctypes_ptr,
-                                                               shape=shape)
+            self._numpy_array_wrapping = self._wrap_int16_array(ndarray)
             self.shape = shape
 
+    @staticmethod
+    def _wrap_int16_array(ndarray):
+        """
+        Returns numpy array that wraps the given arrus.core.NdArray int16 data
+        (no copy), taking into account the array strides (e.g. for sliced
+        arrays).
+        """
+        addr = arrus.core.castToInt(ndarray.getInt16())
+        shape = arrus.utils.core.convert_from_tuple(ndarray.getShape())
+        strides = arrus.utils.core.convert_from_tuple(ndarray.getStrides())
+        # The memory range spanned by the array.
+        n_elements = 1 + sum((n-1)*s for n, s in zip(shape, strides)) \
+            if all(n > 0 for n in shape) else 0
+        ctypes_ptr = ctypes.cast(addr, ctypes.POINTER(ctypes.c_int16))
+        arr = np.ctypeslib.as_array(ctypes_ptr, shape=(n_elements, ))
+        itemsize = arr.itemsize
+        return np.lib.stride_tricks.as_strided(
+            arr, shape=shape, strides=tuple(s*itemsize for s in strides))
+
 
 class DataBuffer:
     """
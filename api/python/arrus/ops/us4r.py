@@ -184,11 +184,18 @@ class TxRxSequence:
     :param sri: sequence repetition interval - the time between consecutive RF \
         frames. When None, the time between consecutive RF frames is \
         determined by the total pri only. [s]
+    :param n_repeats: the number of repetitions of the sequence
+    :param auto_pri_margin: when provided, the pri of each tx/rx is set to \
+        the minimum value accepted by the system (determined by the rx \
+        sample range, decimation and sequencer reprogramming mode), \
+        increased by the given margin; the pri of the tx/rxs is ignored \
+        then. [s]
     """
     ops: typing.List[TxRx]
     tgc_curve: typing.Union[np.ndarray, Iterable] = field(default_factory=lambda: [])
     sri: float = None
     n_repeats: int = 1
+    auto_pri_margin: typing.Optional[float] = None
 
     def __post_init__(self):
         object.__setattr__(self, "tgc_curve", np.asarray(self.tgc_curve))
@@ -240,9 +247,41 @@ class DataBufferSpec:
 
     :param n_elements: number of elements the buffer should consists of
     :param type: type of a buffer, available values: "FIFO"
+    :param n_coalesced_elements: the number of consecutive elements that \
+      should be transferred to the buffer and signaled at once (transfer \
+      coalescing); 1 means that each element is signaled separately; \
+      available only in the "ASYNC" and "SYNC" work modes
+    :param max_coalescing_latency: the maximum additional latency [s] the \
+      coalescing may introduce; the number of coalesced elements will be \
+      reduced to not exceed it; None means no limit
     """
     n_elements: int
     type: str
+    n_coalesced_elements: int = 1
+    max_coalescing_latency: float = None
+
+
+@dataclass(frozen=True)
+class TransferRoi:
+    """
+    Transfer region of interest: the part of the acquired data, that should
+    be transferred from the us4OEM memory to the host buffer.
+
+    The data acquisition is not changed (each TX/RX still acquires its whole
+    rx sample range), only the data transfers to the host are limited
+    to the ROI, so the output buffer elements are smaller.
+
+    The frame metadata is available only if the sample range starts at 0.
+    The transfer ROI cannot be used together with Session.set_subsequence.
+
+    :param sample_range: [start, end) range of samples to transfer, relative \
+      to the first sample acquired by each RX
+    :param frame_range: [start, end] range of TX/RXs to transfer (both \
+      inclusive, the same as for Session.set_subsequence); None means all \
+      TX/RXs
+    """
+    sample_range: tuple
+    frame_range: tuple = None
 
 
 @dataclass(frozen=True)
@@ -257,6 +296,8 @@ class Scheme:
     :param work_mode: determines the system work mode, available values: 'ASYNC', 'HOST', 'MANUAL', 'MANUAL_OP'
     :param processing: data processing to perform on the raw channel RF data \
       currently only arrus.utils.imaging is supported
+    :param transfer_roi: the part of the acquired data that should be \
+      transferred to the output buffer (see TransferRoi); None means all data
     """
     tx_rx_sequence: TxRxSequence
     rx_buffer_size: int = 2
@@ -265,3 +306,4 @@ class Scheme:
     processing: object = None
     digital_down_conversion: DigitalDownConversion = None
     constants: typing.List[Constant] = tuple()
+    transfer_roi: TransferRoi = None
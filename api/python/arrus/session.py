@@ -57,6 +57,71 @@ class SessionContext:
     medium: arrus.medium.Medium
 
 
+class UploadFuture:
+    """
+    A result of the asynchronous scheme upload (see Session.upload_async).
+    """
+
+    def __init__(self, handle, on_upload):
+        self._handle = handle
+        self._on_upload = on_upload
+        self._result = None
+
+    @property
+    def stage(self) -> str:
+        """
+        The current stage of the upload: COMPILING, WAITING_FOR_DEVICE,
+        PROGRAMMING, DONE, FAILED or CANCELLED.
+        """
+        stage = self._handle.getStage()
+        return {
+            arrus.core.UploadFuture.Stage_COMPILING: "COMPILING",
+            arrus.core.UploadFuture.Stage_WAITING_FOR_DEVICE: "WAITING_FOR_DEVICE",
+            arrus.core.UploadFuture.Stage_PROGRAMMING: "PROGRAMMING",
+            arrus.core.UploadFuture.Stage_DONE: "DONE",
+            arrus.core.UploadFuture.Stage_FAILED: "FAILED",
+            arrus.core.UploadFuture.Stage_CANCELLED: "CANCELLED",
+        }[stage]
+
+    @property
+    def progress(self) -> float:
+        """
+        The progress of the current stage (COMPILING or PROGRAMMING),
+        a value in [0, 1].
+        """
+        return self._handle.getProgress()
+
+    def wait(self, timeout: int = None) -> bool:
+        """
+        Waits until the upload is finished (done, failed or cancelled).
+
+        :param timeout: timeout [ms], None means to wait infinitely
+        :return: True if the upload is finished, False on timeout
+        """
+        return arrus.core.arrusUploadFutureWait(self._handle, timeout)
+
+    def cancel(self) -> bool:
+        """
+        Cancels the upload. The upload can be cancelled only before
+        the device programming has started.
+
+        :return: True if the upload was cancelled, False otherwise
+        """
+        return arrus.core.arrusUploadFutureCancel(self._handle)
+
+    def result(self):
+        """
+        Waits until the upload is finished and returns its result.
+
+        :raises: the upload exception, when the upload failed or was cancelled
+        :return: a data buffer and constant metadata
+        """
+        if self._result is None:
+            upload_result = arrus.core.arrusUploadFutureGet(self._handle)
+            self._result = self._on_upload(upload_result)
+        return self._result
+
+
 class Session(AbstractSession):
     """
     A communication session with the ultrasound system.
@@ -77,11 +142,16 @@ class Session(AbstractSession):
         """
         super().__init__()
         self._session_handle = arrus.core.createSessionSharedHandle(cfg_path)
+        # DataBuffer wraps the element data into numpy arrays, so the merged
+        # output buffer of multiple us4Rs should provide the concatenated data.
+        self._session_handle.setMergedBufferConcatenation(True)
         self._context = SessionContext(medium=medium)
         self._py_devices = self._create_py_devices()
         self._current_processing: arrus.utils.imaging.Processing = None
         # Current metadata (for the full sequence)
         self.const_metadata = None
+        # Schemes uploaded with upload_schemes (None if a single scheme was uploaded).
+        self._resident_schemes = None
 
     def upload(self, scheme: arrus.ops.us4r.Scheme):
         """
@@ -91,35 +161,97 @@ class Session(AbstractSession):
         :raises: ValueError when some of the input parameters are invalid
         :return: a data buffer and constant metadata
         """
-        # Verify the input parameters.
-        # Prepare sequence to load
+        kernel_context, raw_seq, tx_delay_constants = self._convert_scheme(
+            scheme)
+        core_scheme = self._to_core_scheme(scheme, raw_seq, tx_delay_constants)
+        upload_result = self._session_handle.upload(core_scheme)
+        return self._on_upload(scheme, kernel_context, raw_seq,
+                               tx_delay_constants, upload_result)
+
+    def upload_async(self, scheme: arrus.ops.us4r.Scheme):
+        """
+        Uploads a given scheme asynchronously.
+
+        The scheme is validated and compiled in the background, without
+        blocking the currently uploaded scheme. The device is programmed
+        as soon as the session is stopped.
+
+        :param scheme: scheme to upload
+        :raises: ValueError when some of the input parameters are invalid
+        :return: upload future; UploadFuture.result() returns a data buffer
+            and constant metadata (the same as the upload method)
+        """
+        kernel_context, raw_seq, tx_delay_constants = self._convert_scheme(
+            scheme)
+        core_scheme = self._to_core_scheme(scheme, raw_seq, tx_delay_constants)
+        future_handle = self._session_handle.uploadAsync(core_scheme)
+        return UploadFuture(
+            future_handle,
+            lambda upload_result: self._on_upload(
+                scheme, kernel_context, raw_seq, tx_delay_constants,
+                upload_result)
+        )
+
+    def _convert_scheme(self, scheme):
+        """
+        Converts the given scheme TX/RX sequence to the raw sequence.
+
+        :return: kernel context, raw sequence and TX delay constants
+        """
         us_device: Ultrasound = self.get_device("/Ultrasound:0")
         us_device_dto = us_device.get_dto()
         medium = self._context.medium
         seq = scheme.tx_rx_sequence
-        processing = scheme.processing
-        constants = scheme.constants
-
         kernel_context = self._create_kernel_context(
             seq,
             us_device_dto,
             medium,
             scheme.digital_down_conversion,
-            constants
+            scheme.constants
         )
         conversion_results = arrus.kernels.get_kernel(type(seq))(kernel_context)
-        raw_seq = conversion_results.sequence
-        tx_delay_constants = conversion_results.constants
+        return (kernel_context, conversion_results.sequence,
+                conversion_results.constants)
 
+    def _to_core_scheme(self, scheme, raw_seq, tx_delay_constants):
         actual_scheme = dataclasses.replace(
             scheme,
             tx_rx_sequence=raw_seq,
             constants=tx_delay_constants
         )
-        core_scheme = arrus.utils.core.convert_to_core_scheme(actual_scheme)
-        upload_result = self._session_handle.upload(core_scheme)
+        return arrus.utils.core.convert_to_core_scheme(actual_scheme)
+
+    def _apply_programmed_pris(self, raw_seq, upload_result):
+        """
+        Returns the raw sequence with the PRIs actually programmed on the
+        device (e.g. the PRIs resolved for the auto_pri_margin).
+        """
+        pris = list(arrus.core.getPris(upload_result))
+        if len(pris) != len(raw_seq.ops):
+            # Not reported by the device.
+            return raw_seq
+        ops = [dataclasses.replace(op, pri=pri)
+               for op, pri in zip(raw_seq.ops, pris)]
+        return dataclasses.replace(raw_seq, ops=ops)
+
+    def _on_upload(self, scheme, kernel_context, raw_seq, tx_delay_constants,
+                   upload_result):
+        """
+        Creates the output buffer, constant metadata and processing
+        for the uploaded scheme.
+        """
+        us_device: Ultrasound = self.get_device("/Ultrasound:0")
+        us_device_dto = us_device.get_dto()
+        medium = kernel_context.medium
+        seq = scheme.tx_rx_sequence
+        processing = scheme.processing
+        self._resident_schemes = None
 
         us_device.set_kernel_context(kernel_context)
+        raw_seq = self._apply_programmed_pris(raw_seq, upload_result)
+        if scheme.transfer_roi is not None:
+            seq, raw_seq = self._apply_transfer_roi(
+                scheme.transfer_roi, seq, raw_seq)
         data_description = us_device.get_data_description(upload_result, raw_seq)
 
         # Output buffer
@@ -142,6 +274,96 @@ class Session(AbstractSession):
         # numpy/cupy processing initialization
         return  self._set_processing(self.buffer, self.const_metadata, processing)
 
+    def upload_schemes(self, schemes):
+        """
+        Uploads the given schemes to the device memory at once.
+
+        The TX/RXs of all the schemes are programmed once, and the output
+        buffer of each scheme is allocated and registered once, then you can
+        switch between the schemes with the select_scheme method, without
+        re-programming the device. Each scheme has its own TX/RXs, SRI and
+        output buffer. The remaining parameters apply to the whole sequence
+        programmed in the device, so all the schemes should have the same
+        rx buffer size, work mode, digital down conversion, TGC curve and
+        number of repeats. Constants (including TX delays computed by
+        the sequence kernels) and transfer ROI are not supported.
+
+        The first scheme is selected after upload.
+
+        :param schemes: a list of schemes to upload
+        :raises: ValueError when some of the input parameters are invalid
+        :return: a data buffer and constant metadata of the first scheme
+        """
+        us_device: Ultrasound = self.get_device("/Ultrasound:0")
+        us_device_dto = us_device.get_dto()
+        medium = self._context.medium
+        resident_schemes = []
+        core_schemes = arrus.core.SchemeVector()
+        for i, scheme in enumerate(schemes):
+            if scheme.transfer_roi is not None or scheme.constants:
+                raise ValueError(f"Scheme {i}: constants and transfer ROI "
+                                 f"are not supported for resident schemes.")
+            seq = scheme.tx_rx_sequence
+            kernel_context = self._create_kernel_context(
+                seq, us_device_dto, medium, scheme.digital_down_conversion,
+                scheme.constants)
+            conversion_results = arrus.kernels.get_kernel(type(seq))(
+                kernel_context)
+            raw_seq = conversion_results.sequence
+            if conversion_results.constants:
+                raise ValueError(f"Scheme {i}: TX delay constants are not "
+                                 f"supported for resident schemes.")
+            actual_scheme = dataclasses.replace(
+                scheme, tx_rx_sequence=raw_seq, constants=[])
+            arrus.core.SchemeVectorPushBack(
+                core_schemes,
+                arrus.utils.core.convert_to_core_scheme(actual_scheme))
+            resident_schemes.append((scheme, kernel_context, seq, raw_seq))
+        arrus.core.arrusSessionUploadSchemes(self._session_handle, core_schemes)
+        self._resident_schemes = resident_schemes
+        return self.select_scheme(0)
+
+    def select_scheme(self, scheme: int, processing=None):
+        """
+        Selects the scheme uploaded with upload_schemes to run.
+
+        Neither the TX/RXs nor the data transfers are re-programmed; only
+        the sequencer range is updated, and the output buffer of the selected
+        scheme becomes the current one. The scheme should be stopped.
+
+        :param scheme: the index of the scheme (in the list passed to
+            upload_schemes)
+        :param processing: the processing to use; if None, the processing
+            of the selected scheme will be used
+        :return: the new data buffer and metadata
+        """
+        if self._resident_schemes is None:
+            raise ValueError("No resident schemes were uploaded, "
+                             "call upload_schemes first.")
+        py_scheme, kernel_context, seq, raw_seq = \
+            self._resident_schemes[scheme]
+        upload_result = self._session_handle.switchScheme(scheme)
+        us_device: Ultrasound = self.get_device("/Ultrasound:0")
+        us_device.set_kernel_context(kernel_context)
+        raw_seq = self._apply_programmed_pris(raw_seq, upload_result)
+        data_description = us_device.get_data_description(
+            upload_result, raw_seq)
+        buffer_handle = arrus.core.getFifoLockFreeBuffer(upload_result)
+        fac = self._create_frame_acquisition_context(
+            seq, raw_seq, us_device.get_dto(), self._context.medium, [])
+        self.buffer = arrus.framework.DataBuffer(buffer_handle)
+        input_shape = self.buffer.elements[0].data.shape
+        is_iq_data = py_scheme.digital_down_conversion is not None
+        self.const_metadata = arrus.metadata.ConstMetadata(
+            context=fac, data_desc=data_description,
+            input_shape=input_shape, is_iq_data=is_iq_data, dtype="int16",
+            version=arrus.__version__
+        )
+        if processing is None:
+            processing = py_scheme.processing
+        return self._set_processing(self.buffer, self.const_metadata,
+                                    processing)
+
     def __enter__(self):
         return self
 
@@ -257,6 +479,23 @@ class Session(AbstractSession):
         if self._current_processing is not None:
             return self._current_processing.pipeline.get_parameters()
 
+    def get_acquisition_statistics(self, us4r: int = 0) -> arrus.devices.us4r.AcquisitionStatistics:
+        """
+        Returns the acquisition statistics of the given us4R device,
+        see :func:`arrus.devices.us4r.Us4R.get_acquisition_statistics`.
+        Each us4R of the session collects its own statistics.
+
+        :param us4r: the ordinal number of the us4R device
+        """
+        return arrus.devices.us4r.convert_acquisition_statistics(
+            self._session_handle.getAcquisitionStatistics(us4r))
+
+    def reset_acquisition_statistics(self):
+        """
+        Resets the acquisition statistics of all the us4R devices.
+        """
+        self._session_handle.resetAcquisitionStatistics()
+
     def get_session_context(self):
         return self._context
 
@@ -292,6 +531,8 @@ class Session(AbstractSession):
         :return: the new data buffer and metadata
         """
         upload_result = self._session_handle.setSubsequence(start, end, sri)
+        # The resident schemes are released by the device.
+        self._resident_schemes = None
         # Get the new buffer
         buffer_handle = arrus.core.getFifoLockFreeBuffer(upload_result)
         self.buffer = arrus.framework.DataBuffer(buffer_handle)
@@ -384,6 +625,35 @@ class Session(AbstractSession):
             constants=constants
         )
 
+    def _apply_transfer_roi(self, roi, seq, raw_seq):
+        """
+        Limits the given sequences to the TX/RXs and samples transferred
+        to the output buffer.
+        """
+        if roi.frame_range is not None:
+            start, end = roi.frame_range
+            seq = seq.get_subsequence(start, end)
+            raw_seq = raw_seq.get_subsequence(start, end)
+        roi_start, roi_end = roi.sample_range
+
+        def _limit_sample_range(sample_range):
+            start_sample, _ = sample_range
+            return start_sample + roi_start, start_sample + roi_end
+
+        def _limit_ops(sequence):
+            ops = [dataclasses.replace(op, rx=dataclasses.replace(
+                       op.rx, sample_range=_limit_sample_range(op.rx.sample_range)))
+                   for op in sequence.ops]
+            return dataclasses.replace(sequence, ops=ops)
+
+        raw_seq = _limit_ops(raw_seq)
+        if isinstance(seq, arrus.ops.us4r.TxRxSequence):
+            seq = _limit_ops(seq)
+        elif getattr(seq, "rx_sample_range", None) is not None:
+            seq = dataclasses.replace(
+                seq, rx_sample_range=_limit_sample_range(seq.rx_sample_range))
+        return seq, raw_seq
+
     def _create_frame_acquisition_context(self, seq, raw_seq, device, medium,
                                           constants):
         return arrus.metadata.FrameAcquisitionContext(
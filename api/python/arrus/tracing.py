@@ -0,0 +1,42 @@
+"""
+Tracing of the acquisition data path.
+
+The trace points are available only when arrus is built with the
+ARRUS_TRACING CMake option. The recorded events can be dumped to a Chrome
+trace event JSON file, which can be opened in chrome://tracing or
+https://ui.perfetto.dev.
+"""
+import arrus.core
+
+
+def is_available():
+    """
+    Returns True if arrus was built with the data path trace points.
+    """
+    return arrus.core.isTracingAvailable()
+
+
+def set_enabled(enabled: bool):
+    """
+    Enables/disables recording of the trace events (disabled by default).
+
+    :param enabled: whether the trace events should be recorded
+    """
+    arrus.core.setTracingEnabled(enabled)
+
+
+def clear():
+    """
+    Removes all the trace events recorded so far.
+    """
+    arrus.core.clearTrace()
+
+
+def dump(filepath: str):
+    """
+    Writes the recorded trace events to the given file (Chrome trace event
+    JSON format).
+
+    :param filepath: path to the output file
+    """
+    arrus.core.dumpTrace(filepath)
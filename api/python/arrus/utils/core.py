@@ -58,8 +58,10 @@ def convert_to_core_sequence(seq):
             f"Parameter n_repeats should be in range "
             f"[{_UINT16_MIN}, {_UINT16_MAX}]"
         )
+    auto_pri_margin = None if seq.auto_pri_margin is None \
+        else float(seq.auto_pri_margin)
     core_seq = arrus.core.TxRxSequence(core_seq, seq.tgc_curve.tolist(), sri,
-                                       seq.n_repeats)
+                                       seq.n_repeats, auto_pri_margin)
     return core_seq
 
 
@@ -130,8 +132,10 @@ def convert_to_core_scheme(scheme):
     core_buffer_type = {
         "FIFO": arrus.core.DataBufferSpec.Type_FIFO
     }[output_buffer.type]
-    data_buffer_spec = arrus.core.DataBufferSpec(core_buffer_type,
-                                                 output_buffer.n_elements)
+    data_buffer_spec = arrus.core.DataBufferSpec(
+        core_buffer_type, output_buffer.n_elements,
+        output_buffer.n_coalesced_elements,
+        output_buffer.max_coalescing_latency)
 
     # Convert sequence to core sequence.
     core_seq = arrus.utils.core.convert_to_core_sequence(seq)
@@ -153,11 +157,28 @@ def convert_to_core_scheme(scheme):
             convert_array_to_vector_float(ddc.fir_coefficients),
             ddc.decimation_factor
         )
-        return arrus.core.Scheme(core_seq, rx_buffer_size, data_buffer_spec,
-                                 core_work_mode, ddc, constants)
+        core_scheme = arrus.core.Scheme(core_seq, rx_buffer_size,
+                                        data_buffer_spec, core_work_mode, ddc,
+                                        constants)
     else:
-        return arrus.core.Scheme(core_seq, rx_buffer_size, data_buffer_spec,
-                                 core_work_mode, constants)
+        core_scheme = arrus.core.Scheme(core_seq, rx_buffer_size,
+                                        data_buffer_spec, core_work_mode,
+                                        constants)
+    if scheme.transfer_roi is not None:
+        core_scheme = core_scheme.withTransferRoi(
+            convert_to_core_transfer_roi(scheme.transfer_roi))
+    return core_scheme
+
+
+def convert_to_core_transfer_roi(roi):
+    start_sample, end_sample = roi.sample_range
+    sample_range = arrus.core.PairUint32(int(start_sample), int(end_sample))
+    if roi.frame_range is None:
+        return arrus.core.TransferRoi(sample_range)
+    else:
+        start, end = roi.frame_range
+        return arrus.core.TransferRoi(
+            sample_range, arrus.core.PairChannelIdx(int(start), int(end)))
 
 
 def convert_to_test_pattern(test_pattern_str):
@@ -1361,6 +1361,136 @@ class EnvelopeDetection(Operation):
         return self.xp.abs(data)
 
 
+class ColorDoppler(Operation):
+    """
+    Color Doppler: wall clutter filtering and the mean phase shift
+    (lag-1 autocorrelation) estimation, computed in a single pass over the
+    data by the arrus core.
+
+    Expects I/Q data (complex64) of shape (n_repetitions, ...), where the
+    first axis is the ensemble (slow time). Returns a float32 array of shape
+    (3, ...): color [rad/PRI], power and turbulence maps.
+
+    Currently this op is available for CPU (numpy) only.
+
+    :param b: wall filter numerator coefficients
+    :param a: wall filter denominator coefficients; (1, ) means FIR filter
+    :param init_state: wall filter initial state coefficients (the initial \
+      state is init_state*(the first ensemble sample)), None means zero \
+      initial state
+    :param n_rejected: the number of initial wall filter output samples to \
+      reject
+    :param n_threads: number of threads to use, 0 means the number of \
+      hardware threads
+    """
+
+    def __init__(self, b, a=(1.0, ), init_state=None, n_rejected=0,
+                 n_threads=0):
+        self.b = np.asarray(b, dtype=np.float32)
+        self.a = np.asarray(a, dtype=np.float32)
+        self.init_state = np.asarray(
+            init_state if init_state is not None else [], dtype=np.float32)
+        self.n_rejected = n_rejected
+        self.n_threads = n_threads
+        self.doppler = None
+        self.output = None
+
+    def set_pkgs(self, num_pkg, **kwargs):
+        if num_pkg is not np:
+            raise ValueError("ColorDoppler is currently available for CPU "
+                             "(numpy) only.")
+
+    def prepare(self, const_metadata):
+        import arrus.core
+        input_shape = const_metadata.input_shape
+        if len(input_shape) < 2:
+            raise ValueError("Expected at least 2D array "
+                             "(n_repetitions, ...).")
+        self.n_repetitions = input_shape[0]
+        if self.n_repetitions < self.n_rejected + 2:
+            raise ValueError("Not enough data for Color Doppler: "
+                             f"n_repetitions: {self.n_repetitions}, "
+                             f"n_rejected: {self.n_rejected}")
+        self.image_shape = tuple(input_shape[1:])
+        self.n_pixels = int(np.prod(self.image_shape))
+        self.doppler = arrus.core.ColorDoppler(
+            arrus.core.VectorFloat(self.b.tolist()),
+            arrus.core.VectorFloat(self.a.tolist()),
+            arrus.core.VectorFloat(self.init_state.tolist()),
+            self.n_rejected, self.n_threads)
+        self.output = np.zeros((3, ) + self.image_shape, dtype=np.float32)
+        return const_metadata.copy(input_shape=self.output.shape,
+                                   is_iq_data=False, dtype="float32")
+
+    def process(self, data):
+        import arrus.core
+        if data.dtype != np.complex64:
+            raise ValueError(
+                f"Data type {data.dtype} is currently not supported.")
+        data = np.ascontiguousarray(data)
+        arrus.core.colorDopplerProcess(
+            self.doppler, data.ctypes.data, self.n_repetitions, self.n_pixels,
+            self.output[0].ctypes.data, self.output[1].ctypes.data,
+            self.output[2].ctypes.data)
+        return self.output
+
+
+class SvdClutterFilter(Operation):
+    """
+    Spatiotemporal (SVD) clutter filter for ultrafast Doppler imaging,
+    computed by the arrus core.
+
+    Expects I/Q data (complex64) of shape (n_frames, ...), where the first
+    axis is the ensemble (slow time). Removes the n_tissue largest and n_noise
+    smallest singular components of the Casorati matrix (n_pixels, n_frames).
+    Returns the filtered ensemble (the same shape as the input).
+
+    Currently this op is available for CPU (numpy) only.
+
+    :param n_tissue: the number of the largest singular components to remove
+    :param n_noise: the number of the smallest singular components to remove
+    :param n_threads: number of threads to use, 0 means the number of \
+      hardware threads
+    """
+
+    def __init__(self, n_tissue, n_noise=0, n_threads=0):
+        self.n_tissue = n_tissue
+        self.n_noise = n_noise
+        self.n_threads = n_threads
+        self.filter = None
+        self.output = None
+
+    def set_pkgs(self, num_pkg, **kwargs):
+        if num_pkg is not np:
+            raise ValueError("SvdClutterFilter is currently available for "
+                             "CPU (numpy) only.")
+
+    def prepare(self, const_metadata):
+        import arrus.core
+        input_shape = const_metadata.input_shape
+        if len(input_shape) < 2:
+            raise ValueError("Expected at least 2D array (n_frames, ...).")
+        n_frames = input_shape[0]
+        if n_frames <= self.n_tissue + self.n_noise:
+            raise ValueError("The number of removed components should be "
+                             f"less than the ensemble length ({n_frames}).")
+        n_pixels = int(np.prod(input_shape[1:]))
+        self.filter = arrus.core.SvdClutterFilter(
+            n_frames, n_pixels, self.n_tissue, self.n_noise, self.n_threads)
+        self.output = np.zeros(input_shape, dtype=np.complex64)
+        return const_metadata
+
+    def process(self, data):
+        import arrus.core
+        if data.dtype != np.complex64:
+            raise ValueError(
+                f"Data type {data.dtype} is currently not supported.")
+        data = np.ascontiguousarray(data)
+        arrus.core.svdClutterFilterProcess(
+            self.filter, data.ctypes.data, self.output.ctypes.data)
+        return self.output
+
+
 class Transpose(Operation):
     """
     Data transposition.
@@ -2342,6 +2472,83 @@ class Mean(Operation):
         return self.num_pkg.mean(data, axis=self.axis)
 
 
+class SlidingWindowCompounding(Operation):
+    """
+    Coherent compounding of the last n low-resolution images (LRIs),
+    updated incrementally.
+
+    The operator keeps a ring of the last window_size LRIs and their sum.
+    Each new LRI replaces the oldest one (subtract the oldest, add the
+    newest), so the operator produces one compounded frame per TX (e.g. per
+    plane wave angle), instead of one frame per full sequence.
+    The window is kept between subsequent batches of data.
+
+    Expected input: LRIs with shape (n_seq, n_tx, ...), e.g. the output of
+    ReconstructLri. Output: compounded images, shape (n_seq*n_tx, ...),
+    where output[i] is the compound of the last window_size LRIs up to and
+    including the i-th LRI. Until window_size LRIs are collected, the
+    compound of the LRIs collected so far is returned.
+
+    :param window_size: the number of compounded LRIs; None means n_tx
+    :param average: whether to return the mean instead of the sum of LRIs
+    :param refresh_period: the number of updates after which the sum is \
+      recomputed from the stored LRIs (limits the accumulation of rounding \
+      errors)
+    """
+
+    def __init__(self, window_size=None, average=False, refresh_period=1024):
+        self.window_size = window_size
+        self.average = average
+        self.refresh_period = refresh_period
+        self.num_pkg = None
+
+    def set_pkgs(self, num_pkg, **kwargs):
+        self.num_pkg = num_pkg
+
+    def prepare(self, const_metadata):
+        xp = self.num_pkg
+        input_shape = const_metadata.input_shape
+        if len(input_shape) < 3:
+            raise ValueError("Expected LRIs with shape (n_seq, n_tx, ...).")
+        n_seq, n_tx = input_shape[:2]
+        self.lri_shape = tuple(input_shape[2:])
+        if self.window_size is None:
+            self.window_size = n_tx
+        if self.window_size < 1:
+            raise ValueError("Window size should be positive.")
+        dtype = const_metadata.dtype
+        self.ring = xp.zeros((self.window_size, ) + self.lri_shape, dtype=dtype)
+        self.sum = xp.zeros(self.lri_shape, dtype=dtype)
+        self.next = 0
+        self.count = 0
+        self.n_updates = 0
+        output_shape = (n_seq*n_tx, ) + self.lri_shape
+        self.output_buffer = xp.zeros(output_shape, dtype=dtype)
+        return const_metadata.copy(input_shape=output_shape)
+
+    def process(self, data):
+        xp = self.num_pkg
+        lris = data.reshape((-1, ) + self.lri_shape)
+        for i in range(lris.shape[0]):
+            lri = lris[i]
+            if self.count == self.window_size:
+                # Replace the oldest LRI.
+                self.sum += lri - self.ring[self.next]
+            else:
+                self.sum += lri
+                self.count += 1
+            self.ring[self.next] = lri
+            self.next = (self.next + 1) % self.window_size
+            self.n_updates += 1
+            if self.n_updates % self.refresh_period == 0:
+                self.sum[:] = xp.sum(self.ring[:self.count], axis=0)
+            if self.average:
+                xp.divide(self.sum, self.count, out=self.output_buffer[i])
+            else:
+                self.output_buffer[i] = self.sum
+        return self.output_buffer
+
+
 def _get_rx_aperture_origin(aperture_center_element, aperture_size):
     return np.round(aperture_center_element - (aperture_size - 1) / 2 + 1e-9)
 
@@ -2704,6 +2911,14 @@ def _get_speed_of_sound(context):
 
 
 class ExtractMetadata(Operation):
+    """
+    Extracts the frame metadata (the first sample of each frame acquired by us4OEM:0).
+
+    The metadata rows are returned in the order of acquisition (one row per
+    TX/RX), also when the metadata-only RX NOPs are enabled (see
+    Us4R.set_rx_nops_metadata_only), i.e. when the RX NOP frames are stored
+    after the data frames.
+    """
 
     def __init__(self):
         super().__init__()
@@ -2712,19 +2927,29 @@ class ExtractMetadata(Operation):
         super().set_pkgs(**kwargs)
 
     def prepare(self, const_metadata):
-        n_samples = const_metadata.context.raw_sequence.get_n_samples()
-        if len(n_samples) > 1:
-            raise ValueError("All Rx ops should gather the same number "
-                             "of samples.")
-        self._n_samples = next(iter(n_samples))
-        fcm = const_metadata.data_description.custom["frame_channel_mapping"]
-        # Metadata is saved by us4OEM:0 module only.
-        self._n_frames = fcm.n_frames[0]
-        self._n_repeats = const_metadata.context.raw_sequence.n_repeats
-
         input_shape = const_metadata.input_shape
         is_ddc = len(input_shape) == 3
-        self._slices = (slice(0, self._n_samples * self._n_frames, self._n_samples),)
+        custom = const_metadata.data_description.custom
+        offsets = custom.get("frame_metadata_offsets", None)
+        if offsets is not None and len(offsets) > 0:
+            # Offsets: the number of int16 values from the beginning of the
+            # element, in the order of acquisition.
+            row_size = int(np.prod(input_shape[1:]))
+            rows = np.asarray(offsets, dtype=np.int64) // row_size
+            self._n_frames = len(rows)
+            self._slices = (rows, )
+        else:
+            n_samples = const_metadata.context.raw_sequence.get_n_samples()
+            if len(n_samples) > 1:
+                raise ValueError("All Rx ops should gather the same number "
+                                 "of samples.")
+            self._n_samples = next(iter(n_samples))
+            fcm = custom["frame_channel_mapping"]
+            # Metadata is saved by us4OEM:0 module only.
+            self._n_frames = fcm.n_frames[0]
+            self._slices = (slice(0, self._n_samples * self._n_frames,
+                                  self._n_samples),)
+        self._n_repeats = const_metadata.context.raw_sequence.n_repeats
         if is_ddc:
             self._slices = self._slices + (0,)  # Select "I" value.
         return const_metadata
@@ -2739,6 +2964,9 @@ class ReconstructLri3D(Operation):
     """
     Rx beamforming for synthetic aperture imaging for matrix array.
 
+    On CPU (numpy), the reconstruction is performed by the arrus core
+    (multithreaded, cache-blocked delay-and-sum).
+
     tx_foc, tx_ang_zx, tx_ang_zy: arrays
 
     Expected input data shape: batch_size, n_emissions, n_rx_x, n_rx_y, n_samples
@@ -2758,13 +2986,12 @@ class ReconstructLri3D(Operation):
         self.y_grid = y_grid
         self.z_grid = z_grid
         self.speed_of_sound = speed_of_sound
-        import cupy as cp
-        self.num_pkg = cp
+        self.num_pkg = None
         self.rx_tang_limits = rx_tang_limits
+        self._cpu_reconstruction = None
 
     def set_pkgs(self, num_pkg, **kwargs):
-        if num_pkg is np:
-            raise ValueError("ReconstructLri3D operation is implemented for GPU only.")
+        self.num_pkg = num_pkg
 
     def _get_aperture_boundaries(self, apertures):
         def get_min_max_x_y(ap):
@@ -2779,13 +3006,13 @@ class ReconstructLri3D(Operation):
         return min_x, max_x, min_y, max_y
 
     def prepare(self, const_metadata):
-        import cupy as cp
-
-        current_dir = os.path.dirname(os.path.join(os.path.abspath(__file__)))
-        _kernel_source = Path(os.path.join(current_dir, "iq_raw_2_lri_3d.cu")).read_text()
-        self._kernel_module = self.num_pkg.RawModule(code=_kernel_source)
-        self._kernel_module.compile()
-        self._kernel = self._kernel_module.get_function("iqRaw2Lri3D")
+        self.is_gpu = self.num_pkg is not np
+        if self.is_gpu:
+            current_dir = os.path.dirname(os.path.join(os.path.abspath(__file__)))
+            _kernel_source = Path(os.path.join(current_dir, "iq_raw_2_lri_3d.cu")).read_text()
+            self._kernel_module = self.num_pkg.RawModule(code=_kernel_source)
+            self._kernel_module.compile()
+            self._kernel = self._kernel_module.get_function("iqRaw2Lri3D")
 
         # INPUT PARAMETERS.
         # Input data shape.
@@ -2843,16 +3070,20 @@ class ReconstructLri3D(Operation):
 
         element_pos_x = element_pos_x.astype(np.float32)
         element_pos_y = element_pos_y.astype(np.float32)
-        # Put the data into GPU constant memory.
-        device_props = cp.cuda.runtime.getDeviceProperties(0)
-        if device_props["totalConstMem"] < 256 * 2 * 4:  # 2 float32 arrays, 256 elements max
-            raise ValueError("There is not enough constant memory available!")
-        x_elem = np.asarray(element_pos_x, dtype=self.num_pkg.float32)
-        self._x_elem_const = _get_const_memory_array(
-            self._kernel_module, name="xElemConst", input_array=x_elem)
-        y_elem = np.asarray(element_pos_y, dtype=self.num_pkg.float32)
-        self._y_elem_const = _get_const_memory_array(
-            self._kernel_module, name="yElemConst", input_array=y_elem)
+        self.element_pos_x = element_pos_x
+        self.element_pos_y = element_pos_y
+        if self.is_gpu:
+            import cupy as cp
+            # Put the data into GPU constant memory.
+            device_props = cp.cuda.runtime.getDeviceProperties(0)
+            if device_props["totalConstMem"] < 256 * 2 * 4:  # 2 float32 arrays, 256 elements max
+                raise ValueError("There is not enough constant memory available!")
+            x_elem = np.asarray(element_pos_x, dtype=self.num_pkg.float32)
+            self._x_elem_const = _get_const_memory_array(
+                self._kernel_module, name="xElemConst", input_array=x_elem)
+            y_elem = np.asarray(element_pos_y, dtype=self.num_pkg.float32)
+            self._y_elem_const = _get_const_memory_array(
+                self._kernel_module, name="yElemConst", input_array=y_elem)
 
         def get_min_max_x_y(aperture):
             cords = np.argwhere(aperture)
@@ -2940,11 +3171,58 @@ class ReconstructLri3D(Operation):
         self.rx_apod = scipy.signal.windows.hamming(20).astype(np.float32)
         self.rx_apod = self.num_pkg.asarray(self.rx_apod)
         self.n_rx_apod = self.num_pkg.int32(len(self.rx_apod))
+        if not self.is_gpu:
+            self._cpu_reconstruction = self._create_cpu_reconstruction()
 
         return const_metadata.copy(input_shape=output_shape)
 
+    def _create_cpu_reconstruction(self):
+        import arrus.core
+
+        def to_float(values):
+            return arrus.core.VectorFloat(
+                np.asarray(values, dtype=np.float32).flatten().tolist())
+
+        def to_uint16(values):
+            return arrus.core.VectorUInt16(
+                np.asarray(values, dtype=np.uint16).flatten().tolist())
+
+        s = arrus.core.VolumeReconstructionSettings()
+        s.xGrid = to_float(self.x_grid)
+        s.yGrid = to_float(self.y_grid)
+        s.zGrid = to_float(self.z_grid)
+        s.xElements = to_float(self.element_pos_x)
+        s.yElements = to_float(self.element_pos_y)
+        s.speedOfSound = float(self.sos)
+        s.samplingFrequency = float(self.fs)
+        s.centerFrequency = float(self.fn)
+        s.initialDelay = float(self.initial_delay)
+        s.txFocus = to_float(self.tx_foc)
+        s.txAngleZx = to_float(self.tx_ang_zx)
+        s.txAngleZy = to_float(self.tx_ang_zy)
+        s.txApertureCenterX = to_float(self.tx_ap_cent_x)
+        s.txApertureCenterY = to_float(self.tx_ap_cent_y)
+        s.txApertureFirstElementX = to_uint16(self.tx_ap_first_elem_x)
+        s.txApertureLastElementX = to_uint16(self.tx_ap_last_elem_x)
+        s.txApertureFirstElementY = to_uint16(self.tx_ap_first_elem_y)
+        s.txApertureLastElementY = to_uint16(self.tx_ap_last_elem_y)
+        s.rxApertureFirstElementX = to_uint16(self.rx_ap_first_elem_x)
+        s.rxApertureFirstElementY = to_uint16(self.rx_ap_first_elem_y)
+        s.minRxTangZx = s.minRxTangZy = float(self.min_tang)
+        s.maxRxTangZx = s.maxRxTangZy = float(self.max_tang)
+        s.rxApodization = to_float(self.rx_apod)
+        return arrus.core.VolumeReconstruction(s)
+
     def process(self, data):
         data = self.num_pkg.ascontiguousarray(data)
+        if not self.is_gpu:
+            import arrus.core
+            data = data.astype(np.complex64, copy=False)
+            arrus.core.volumeReconstructionProcess(
+                self._cpu_reconstruction, data.ctypes.data,
+                self.n_seq, self.n_rx_y, self.n_rx_x, self.n_samples,
+                self.output_buffer.ctypes.data)
+            return self.output_buffer
         params = (
             self.output_buffer, data,
             self.n_seq, self.n_tx, self.n_rx_y, self.n_rx_x, self.n_samples,
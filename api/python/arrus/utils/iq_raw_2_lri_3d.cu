@@ -89,7 +89,7 @@ __global__ void iqRaw2Lri3D(complex<float> *iqLri, const complex<float> *input,
                 /* Virtual Point Source IN FRONT OF probe surface */
                 // Projection of the Foc-Pix vector on the ApCent-Foc vector (dot product) ...
                 // to determine if the pixel is behind (-) or in front of (+) the focal point (VSP).
-                pixFocArrang = (((zPix[z]-zFoc)* zFoc + (xPix[x]-xFoc)*(xFoc-txApCentX[iTx]) + (yPix[x]-yFoc)*(yFoc-txApCentY[iTx])) >= 0.f) ? 1.f : -1.f;
+                pixFocArrang = (((zPix[z]-zFoc)* zFoc + (xPix[x]-xFoc)*(xFoc-txApCentX[iTx]) + (yPix[y]-yFoc)*(yFoc-txApCentY[iTx])) >= 0.f) ? 1.f : -1.f;
             }
             txDist = ownHypotf(zPix[z]-zFoc, xPix[x]-xFoc, yPix[y]-yFoc);
             txDist *= pixFocArrang; // Compensation for the Pix-Foc arrangement
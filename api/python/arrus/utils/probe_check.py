@@ -8,8 +8,6 @@ from typing import Set, List, Iterable, Tuple, Dict, Any
 import threading
 
 import numpy as np
-from scipy.optimize import curve_fit
-from scipy.signal import butter, sosfiltfilt, hilbert
 
 import arrus.session
 import arrus.logging
@@ -35,67 +33,70 @@ _VOLTAGE = 10
 LOGGER = arrus.logging.get_logger()
 
 
-def _get_mid_rx(nrx):
-    """
-    Returns channel in the receiving aperture
-    corresponding to the transmit one.
-    """
-    return int(np.ceil(nrx/2) - 1)
-
-
-def _hpfilter(
-        rf: np.ndarray,
-        n: int = 4,
-        wn: float = 1e5,
-        fs: float = 65e6,
-        axis: int = -1,
-) -> np.ndarray:
-    """
-    Returns rf signals high-pass filtered using the Butterworth filter.
-
-    :param rf: numpy array of rf signals
-    :param n: the order of the iir filter
-    :param wn: iir filter cut-off frequency
-    :param fs: sampling frequency
-    :return: numpy array of filtered rf signals
-    """
-    btype = "highpass"
-    output = "sos"
-    iir = butter(n, wn, btype=btype, output=output, fs=fs)
-    return sosfiltfilt(iir, rf, axis=axis)
+# Sampling frequency assumed by the high-pass filter of the feature extractors.
+_SAMPLING_FREQUENCY = 65e6
+# Default cutoff frequency of the high-pass filter of the feature extractors.
+_HP_CUTOFF_FREQUENCY = 1e5
 
 
-def _normalize(x: np.ndarray) -> np.ndarray:
+def _as_core_rf(rf: np.ndarray) -> np.ndarray:
     """
-    Normalizes input np.ndarray (i.e. moves values into [0, 1] range.
-    If x contains some np.nans, they are ignored.
-    If x contains only np.nans, non-modified x is returned.
-
-    :param x: np.ndarray
-    :return: normalized np.ndarray
+    Returns rf data that can be passed to the arrus core feature extractor:
+    C-contiguous int16 (raw data) or float32 (any other type) array.
     """
-
-    mx = np.nanmax(x)
-    if np.isfinite(mx):
-        mn = np.nanmin(x)
-        if mx != mn:
-            normalized = (x - mn) / (mx - mn)
-        else:
-            normalized = 0
+    if rf.dtype == np.int16:
+        return np.ascontiguousarray(rf)
     else:
-        normalized = x
-
-    return normalized
-
-
-def _envelope(rf: np.ndarray) -> np.ndarray:
-    """
-    Returns _envelope of the signal using Hilbert transform.
-
-    :param rf: signals in np.ndarray
-    :return: _envelope in np.ndarray
-    """
-    return np.abs(hilbert(rf))
+        return np.ascontiguousarray(rf, dtype=np.float32)
+
+
+def _extract_core_feature(feature: str, rf: np.ndarray, cutoff: float,
+                          footprint_rf: np.ndarray = None,
+                          gate_length: int = 0) -> np.ndarray:
+    """
+    Computes the given probe element feature using arrus core
+    (arrus::processing::ProbeElementFeatureExtractor); the TXs (probe
+    elements) are processed in parallel.
+
+    :param feature: one of: "amplitude", "energy", "signal_duration_time",
+      "footprint_pcc"
+    :param rf: rf data (number of frames, number of tx, number of samples,
+      number of rx channels)
+    :param cutoff: high-pass filter cutoff frequency
+    :param footprint_rf: footprint rf data (only for "footprint_pcc")
+    :param gate_length: the number of samples taken into account
+      (only for "footprint_pcc")
+    :return: numpy array of features, one value per tx
+    """
+    import arrus.core
+    if footprint_rf is not None and footprint_rf.dtype != rf.dtype:
+        # Both arrays should have the same type.
+        footprint_rf = footprint_rf.astype(np.float32)
+        rf = rf.astype(np.float32)
+    rf = _as_core_rf(rf)
+    n_frames, ntx, n_samples, nrx = rf.shape
+    extractor = arrus.core.ProbeElementFeatureExtractor(
+        n_frames, ntx, n_samples, nrx, _SAMPLING_FREQUENCY,
+        _N_SKIPPED_SAMPLES)
+    is_int16 = rf.dtype == np.int16
+    output = np.zeros(ntx, dtype=np.float32)
+    if feature == "amplitude":
+        arrus.core.probeElementMaxAmplitude(
+            extractor, rf.ctypes.data, is_int16, cutoff, output.ctypes.data)
+    elif feature == "energy":
+        arrus.core.probeElementEnergy(
+            extractor, rf.ctypes.data, is_int16, cutoff, output.ctypes.data)
+    elif feature == "signal_duration_time":
+        arrus.core.probeElementSignalDuration(
+            extractor, rf.ctypes.data, is_int16, cutoff, output.ctypes.data)
+    elif feature == "footprint_pcc":
+        footprint_rf = _as_core_rf(footprint_rf)
+        arrus.core.probeElementFootprintPcc(
+            extractor, rf.ctypes.data, footprint_rf.ctypes.data, is_int16,
+            gate_length, cutoff, output.ctypes.data)
+    else:
+        raise ValueError(f"Unknown feature: {feature}")
+    return output.astype(np.float64)
 
 
 class StdoutLogger:
@@ -301,19 +302,11 @@ class MaxAmplitudeExtractor(ProbeElementFeatureExtractor):
     feature = "amplitude"
 
     def extract(self, rf: np.ndarray) -> np.ndarray:
-        # Highpass filter data
+        # Highpass filter data (along samples)
         # with cutoff frequency equal 50% of tx_frequency.
         tx_frequency = self.metadata.context.sequence.pulse.center_frequency
         cutoff = tx_frequency/2
-        rf = _hpfilter(rf, wn=cutoff, axis=-2)
-
-        rf = np.abs(rf[:, :, :, :])
-        # Reduce each RF frame into a vector of n elements
-        # (where n is the number of probe elements).
-        frame_max = np.max(rf[:, :, _N_SKIPPED_SAMPLES:, :], axis=(2, 3))
-        # Choose median of a list of Tx/Rxs sequences.
-        frame_max = np.median(frame_max, axis=0)
-        return frame_max
+        return _extract_core_feature(self.feature, rf, cutoff)
 
 
 class MaxHVPSCurrentExtractor(ProbeElementFeatureExtractor):
@@ -380,30 +373,7 @@ class EnergyExtractor(ProbeElementFeatureExtractor):
             number of rx channels)
         :return: numpy array of signal energies
         """
-        n_frames, ntx, _, nrx = data.shape
-        energies = []
-        for itx in range(ntx):
-            frames_energies = []
-            for frame in range(n_frames):
-                rf = data[frame, itx, _N_SKIPPED_SAMPLES:, _get_mid_rx(nrx)]
-                rf = rf.astype(float)
-                e = self.__get_signal_energy(np.squeeze(rf))
-                frames_energies.append(e)
-            mean_energy = np.mean(frames_energies)
-            energies.append(mean_energy)
-        return np.array(energies)
-
-    def __get_signal_energy(self, rf: np.ndarray) -> float:
-        """
-        Returns normalized and high-pass filtered signal energy.
-
-        :param rf: signal
-        :return: signal energy (float)
-        """
-        rf = _hpfilter(rf)
-        rf = rf ** 2
-        rf = _normalize(rf)
-        return float(np.sum(rf))
+        return _extract_core_feature(self.feature, data, _HP_CUTOFF_FREQUENCY)
 
 
 class SignalDurationTimeExtractor(ProbeElementFeatureExtractor):
@@ -428,71 +398,7 @@ class SignalDurationTimeExtractor(ProbeElementFeatureExtractor):
          number of rx channels]
         :return: np.array of signal duration times
         """
-        n_frames, ntx, _, nrx = data.shape
-        times = []
-        for itx in range(ntx):
-            frames_times = []
-            for iframe in range(n_frames):
-                rf = data[iframe, itx, _N_SKIPPED_SAMPLES:, _get_mid_rx(nrx)]
-                rf = rf.copy()
-                rf = rf.astype(float)
-                t = self.__get_signal_duration(np.squeeze(rf))
-                frames_times.append(t)
-            mean_time = np.mean(frames_times)
-            times.append(mean_time)
-        result = np.array(times)
-        return result
-
-    def __gauss(self, x: float, a: float, x0: float, sigma: float) -> float:
-        """
-        Returns the value of a gaussian function
-            f(x)=a*exp(-(x-x0)**2/(2*sigma**2)
-        at given argument x.
-
-        :param x: argument
-        :param a: height of the peak
-        :param x0: expected value
-        :param sigma: standard deviation
-        :return: function value at x
-        """
-        return a * np.exp(-(x - x0) ** 2 / (2 * sigma ** 2))
-
-
-    def __fitgauss(self, y: np.ndarray) -> tuple:
-        """
-        The function fits gauss curve to signal, and returns tuple of curve
-        parameters.
-        """
-        if np.all(y == 0):
-            pars = (0, 0, 0)
-        else:
-            bounds = (np.array([0, 0, 1]),
-                      np.array([np.max(y), len(y), len(y) * 0.9]))
-            p0 = [np.max(y) / 2, len(y) / 2, 20]
-            try:
-                pars, _ = curve_fit(self.__gauss, np.arange(y.size), y,
-                                    bounds=bounds, p0=p0)
-            except Exception as e:
-                # When curve_fit() can not fit gauss, sigma is set to 0
-                pars = (0, 0, 0)
-                LOGGER.log(arrus.logging.INFO,
-                    "The expected signal _envelope couldn't be fitted "
-                    "in some signal, probably due to low SNR.")
-
-        return pars
-
-    def __get_signal_duration(self, rf: np.ndarray) -> float:
-        """
-        Returns signal duration estimate.
-
-        :param rf: signal vector
-        :return: signal duration estimate in samples
-        """
-        rf = _hpfilter(rf)
-        rf = _envelope(rf)
-        # for return values, see definition of __gauss
-        _, _, sigma = self.__fitgauss(rf)
-        return round(3 * sigma)
+        return _extract_core_feature(self.feature, data, _HP_CUTOFF_FREQUENCY)
 
 
 class FootprintSimilarityPCCExtractor(ProbeElementFeatureExtractor):
@@ -510,38 +416,14 @@ class FootprintSimilarityPCCExtractor(ProbeElementFeatureExtractor):
     )-> np.ndarray:
 
         gate_length = 128
-        smp = slice(_N_SKIPPED_SAMPLES, _N_SKIPPED_SAMPLES + gate_length)
-        crs = self.__get_corrcoefs(
-            rf,
-            footprint_rf,
-            smp=smp,
-        )
-        return crs
-
-    def __get_corrcoefs(
-            self,
-            rf,
-            footprint_rf,
-            smp=None,
-            nround=3,
-    ):
         if rf.shape != footprint_rf.shape:
             raise ValueError(
                 "rf and footprint.rf arrays must have the same shape"
             )
-        nframe, ntx, nsmp, nrx = rf.shape
-        mid_rx = int(np.ceil(nrx/2) - 1)
-        # average frames
-        avdat = _hpfilter(rf.mean(axis=0))
-        avref = _hpfilter(footprint_rf.mean(axis=0))
-        crs = np.full(ntx, 0).astype(float)
-        if smp is None:
-            smp = slice(0, nsmp)
-        for itx in range(ntx):
-            dline = avdat[itx, smp, mid_rx]
-            rline = avref[itx, smp, mid_rx]
-            crs[itx] = np.corrcoef(dline, rline)[0,1].round(nround)
-        return crs
+        crs = _extract_core_feature(
+            self.feature, rf, _HP_CUTOFF_FREQUENCY,
+            footprint_rf=footprint_rf, gate_length=gate_length)
+        return crs.round(3)
 
 
 class ByThresholdValidator(ProbeElementValidator):
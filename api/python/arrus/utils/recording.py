@@ -0,0 +1,86 @@
+import numpy as np
+
+import arrus.core
+import arrus.framework
+
+
+class RfRecorder:
+    """
+    Lossless, multi-threaded recorder of the int16 RF data (per-channel
+    prediction + bit-packing, see arrus::io::RfRecorder).
+
+    The recordings can be replayed with the File device (the compressed file
+    is detected automatically) or read with read_rf_recording.
+
+    Example (recording the consecutive buffer elements)::
+
+        recorder = RfRecorder("data.rf", sample_stride=32)
+
+        def callback(element):
+            recorder.write(element)
+            element.release()
+
+        ...
+        recorder.close()
+
+    :param filepath: path to the output file (an existing file is overwritten)
+    :param sample_stride: the distance (the number of int16 values) between
+      two consecutive samples of the same channel: 32 for the raw us4R data,
+      the number of components (1: RF, 2: I/Q) for the File device layout
+    :param n_threads: number of threads to use; 0 means the number of
+      hardware threads
+    """
+
+    def __init__(self, filepath: str, sample_stride: int, n_threads: int = 0):
+        self._recorder = arrus.core.RfRecorder(filepath, sample_stride,
+                                               n_threads)
+
+    def write(self, data):
+        """
+        Encodes and appends a single frame to the recording. The data can be
+        released just after this call.
+
+        :param data: arrus.framework.DataBufferElement or a C-contiguous
+          int16 numpy array
+        """
+        if isinstance(data, arrus.framework.DataBufferElement):
+            data = data.data
+        if data.dtype != np.int16 or not data.flags["C_CONTIGUOUS"]:
+            raise ValueError("Only C-contiguous int16 arrays can be recorded.")
+        arrus.core.arrusRfRecorderWrite(self._recorder, data.ctypes.data,
+                                        data.size)
+
+    def close(self):
+        self._recorder.close()
+
+    @property
+    def n_frames(self):
+        return self._recorder.getNumberOfFrames()
+
+    @property
+    def compression_ratio(self):
+        """
+        The ratio of the raw data size to the encoded data size.
+        """
+        encoded = self._recorder.getNumberOfEncodedBytes()
+        return self._recorder.getNumberOfRawBytes() / encoded if encoded > 0 else 0.0
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
+
+
+def read_rf_recording(filepath: str, n_threads: int = 0) -> np.ndarray:
+    """
+    Reads and decodes all frames of the given recording (see RfRecorder).
+
+    :param filepath: path to the recording
+    :param n_threads: number of threads to use; 0 means the number of
+      hardware threads
+    :return: int16 numpy array of shape (n_frames, frame shape...)
+    """
+    ndarray = arrus.core.readRfRecording(filepath, n_threads)
+    # Copy: the decoded data is owned by the (temporary) core array.
+    return arrus.framework.DataBufferElement._wrap_int16_array(ndarray).copy()
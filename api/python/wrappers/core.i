@@ -46,6 +46,8 @@ namespace std {
 %template(VectorBool) vector<bool>;
 %template(VectorFloat) vector<float>;
 %template(VectorUInt16) vector<unsigned short>;
+%template(VectorUInt8) vector<unsigned char>;
+%template(VectorUInt64) vector<unsigned long long>;
 %template(PairUint32) pair<unsigned, unsigned>;
 %template(PairChannelIdx) pair<unsigned short, unsigned short>;
 
@@ -117,6 +119,10 @@ namespace std {
     }
 %}
 
+%typemap(typecheck, precedence=SWIG_TYPECHECK_FLOAT) std::optional<float> %{
+    $1 = ($input == Py_None || PyFloat_Check($input) || PyLong_Check($input)) ? 1 : 0;
+%}
+
 %typemap(out) std::optional<float> %{
     if($1) {
         $result = PyFloat_FromDouble((double)(*$1));
@@ -163,8 +169,10 @@ namespace std {
 
 #include "arrus/core/api/common/types.h"
 #include "arrus/core/api/io/settings.h"
+#include "arrus/core/api/io/RfRecorder.h"
 #include "arrus/core/api/session/Session.h"
 #include "arrus/core/api/common/logging.h"
+#include "arrus/core/api/common/tracing.h"
 #include "arrus/core/api/devices/us4r/Us4OEM.h"
 #include "arrus/core/api/devices/us4r/Us4R.h"
 #include "arrus/core/api/ops/us4r/TxRxSequence.h"
@@ -192,6 +200,9 @@ using namespace ::arrus;
 %include "arrus/core/api/common/LogSeverity.h"
 %include "arrus/core/api/common/Logger.h"
 
+// ------------------------------------------ TRACING
+%include "arrus/core/api/common/tracing.h"
+
 %inline %{
     ::arrus::Logging* LOGGING_FACTORY;
 
@@ -242,6 +253,7 @@ using namespace ::arrus;
 %{
 #include "arrus/core/api/framework/NdArray.h"
 #include "arrus/core/api/framework/DataBufferSpec.h"
+#include "arrus/core/api/framework/FrameMetadata.h"
 #include "arrus/core/api/framework/Buffer.h"
 #include "arrus/core/api/framework/DataBuffer.h"
 #include "arrus/core/api/devices/us4r/FrameChannelMapping.h"
@@ -261,13 +273,54 @@ namespace arrus {
 };
 
 %ignore arrus::framework::NdArray::NdArray;
+%ignore arrus::framework::NdArray::Slice;
+%ignore arrus::framework::NdArray::slice(const std::vector<Slice> &) const;
+%ignore arrus::framework::NdArray::transpose(const std::vector<size_t> &) const;
 %include "arrus/core/api/framework/NdArray.h"
 
 %include "arrus/core/api/devices/us4r/FrameChannelMapping.h"
 %include "arrus/core/api/framework/DataBufferSpec.h"
+%include "arrus/core/api/framework/FrameMetadata.h"
 %include "arrus/core/api/framework/Buffer.h"
 %include "arrus/core/api/framework/DataBuffer.h"
 
+%{
+#include "arrus/core/api/framework/dlpack.h"
+
+// DLPack Python protocol: the consumer renames the capsule to "used_dltensor" and takes over the tensor ownership.
+static void arrusDlpackCapsuleDestructor(PyObject *capsule) {
+    if(PyCapsule_IsValid(capsule, "used_dltensor")) {
+        return;
+    }
+    auto *tensor = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+    if(tensor == nullptr) {
+        PyErr_WriteUnraisable(capsule);
+        return;
+    }
+    if(tensor->deleter != nullptr) {
+        tensor->deleter(tensor);
+    }
+}
+
+static PyObject *arrusDlpackToCapsule(DLManagedTensor *tensor) {
+    PyObject *capsule = PyCapsule_New(tensor, "dltensor", arrusDlpackCapsuleDestructor);
+    if(capsule == nullptr) {
+        tensor->deleter(tensor);
+    }
+    return capsule;
+}
+%}
+
+%inline %{
+PyObject *arrusNdArrayToDlpack(const arrus::framework::NdArray &array) {
+    return arrusDlpackToCapsule(::arrus::framework::toDLPack(array));
+}
+
+PyObject *arrusBufferElementToDlpack(const std::shared_ptr<arrus::framework::BufferElement> &element) {
+    return arrusDlpackToCapsule(::arrus::framework::toDLPack(element));
+}
+%}
+
 %feature("director") OnNewDataCallbackWrapper;
 %feature("director") OnBufferOverflowCallbackWrapper;
 
@@ -324,6 +377,8 @@ void registerOnBufferOverflowCallback(const std::shared_ptr<arrus::framework::Bu
 %{
 #include "arrus/core/api/session/Metadata.h"
 #include "arrus/core/api/session/UploadResult.h"
+#include "arrus/core/api/session/UploadFuture.h"
+#include "arrus/core/api/devices/us4r/AcquisitionStatistics.h"
 #include "arrus/core/api/session/Session.h"
 using namespace ::arrus::session;
 
@@ -332,15 +387,20 @@ using namespace ::arrus::session;
 
 %shared_ptr(arrus::session::Metadata);
 %shared_ptr(arrus::session::Session);
+%shared_ptr(arrus::session::UploadFuture);
 %ignore createSession;
 
 // Ignore overloaded `run` methods -- the full signature will be used only.
 %ignore arrus::session::Session::run();
 %ignore arrus::session::Session::run(bool);
+// Resident schemes are uploaded using arrusSessionUploadSchemes (see below, the scheme vector is defined there).
+%ignore arrus::session::Session::upload(const std::vector<arrus::ops::us4r::Scheme> &);
 
 
 %include "arrus/core/api/session/Metadata.h"
 %include "arrus/core/api/session/UploadResult.h"
+%include "arrus/core/api/session/UploadFuture.h"
+%include "arrus/core/api/devices/us4r/AcquisitionStatistics.h"
 %include "arrus/core/api/session/Session.h"
 
 %inline %{
@@ -354,6 +414,27 @@ std::shared_ptr<arrus::devices::FrameChannelMapping> getFrameChannelMapping(arru
     return uploadResult->getConstMetadata()->get<arrus::devices::FrameChannelMapping>("frameChannelMapping");
 }
 
+std::vector<unsigned long long> getFrameMetadataOffsets(arrus::session::UploadResult* uploadResult) {
+    std::vector<unsigned long long> result;
+    try {
+        auto offsets = uploadResult->getConstMetadata()->get<std::vector<size_t>>("frameMetadataOffsets");
+        result.assign(std::begin(*offsets), std::end(*offsets));
+    } catch(const std::out_of_range &) {
+        // The frame metadata is not available for the given upload.
+    }
+    return result;
+}
+
+std::vector<float> getPris(arrus::session::UploadResult* uploadResult) {
+    std::vector<float> result;
+    try {
+        result = *uploadResult->getConstMetadata()->get<std::vector<float>>("pris");
+    } catch(const std::out_of_range &) {
+        // The PRIs are not reported for the given upload.
+    }
+    return result;
+}
+
 std::shared_ptr<arrus::framework::DataBuffer> getFifoLockFreeBuffer(arrus::session::UploadResult* uploadResult) {
     auto buffer = std::static_pointer_cast<DataBuffer>(uploadResult->getBuffer());
     return buffer;
@@ -377,6 +458,21 @@ void arrusSessionRun(std::shared_ptr<arrus::session::Session> session, bool asyn
     session->run(async, timeout);
 }
 
+arrus::session::UploadResult arrusUploadFutureGet(std::shared_ptr<arrus::session::UploadFuture> future) {
+    ArrusPythonGILUnlock unlock;
+    return future->get();
+}
+
+bool arrusUploadFutureWait(std::shared_ptr<arrus::session::UploadFuture> future, std::optional<long long> timeout) {
+    ArrusPythonGILUnlock unlock;
+    return future->wait(timeout);
+}
+
+bool arrusUploadFutureCancel(std::shared_ptr<arrus::session::UploadFuture> future) {
+    ArrusPythonGILUnlock unlock;
+    return future->cancel();
+}
+
 void arrusUs4OEMWaitForHVPSMeasuerementDone(arrus::devices::Us4OEM *us4oem, std::optional<long long> timeout) {
     ArrusPythonGILUnlock unlock;
     us4oem->waitForHVPSMeasurementDone(timeout);
@@ -404,6 +500,15 @@ using namespace arrus::devices;
 %include "arrus/core/api/devices/Device.h"
 %include "arrus/core/api/devices/DeviceWithComponents.h"
 %include "arrus/core/api/devices/us4r/Us4OEM.h"
+// Telemetry: the alert callbacks are available in C++ only (the alerts are logged).
+%ignore arrus::devices::Us4R::startTelemetry(const TelemetrySettings &, TelemetryAlertCallback);
+%ignore arrus::devices::Us4R::getLatestTelemetry;
+%ignore arrus::devices::TelemetrySettings::getMaxFPGATemperature;
+%ignore arrus::devices::TelemetrySettings::getMaxUCDTemperature;
+%include "arrus/core/api/devices/us4r/Telemetry.h"
+namespace std {
+%template(TelemetrySnapshotVector) vector<arrus::devices::TelemetrySnapshot>;
+};
 %include "arrus/core/api/devices/us4r/Us4R.h"
 %include "arrus/core/api/devices/File.h"
 %include "arrus/core/api/devices/probe/ProbeModelId.h"
@@ -461,6 +566,16 @@ float arrusUs4OEMGetUCDExternalTemperature(::arrus::devices::Us4OEM *us4oem) {
     return us4oem->getUCDExternalTemperature();
 }
 
+/** Returns the latest telemetry snapshot as a vector with at most one element (empty: no sample available). */
+std::vector<arrus::devices::TelemetrySnapshot> arrusUs4RGetLatestTelemetry(::arrus::devices::Us4R *us4r) {
+    std::vector<arrus::devices::TelemetrySnapshot> result;
+    auto snapshot = us4r->getLatestTelemetry();
+    if(snapshot.has_value()) {
+        result.push_back(std::move(snapshot.value()));
+    }
+    return result;
+}
+
 %};
 
 // ------------------------------------------ OPERATIONS
@@ -472,6 +587,7 @@ float arrusUs4OEMGetUCDExternalTemperature(::arrus::devices::Us4OEM *us4oem) {
 #include "arrus/core/api/ops/us4r/Rx.h"
 #include "arrus/core/api/ops/us4r/Tx.h"
 #include "arrus/core/api/ops/us4r/TxRxSequence.h"
+#include "arrus/core/api/ops/us4r/TransferRoi.h"
 #include "arrus/core/api/ops/us4r/Scheme.h"
 #include "arrus/core/api/ops/us4r/DigitalDownConversion.h"
 #include <vector>
@@ -485,6 +601,9 @@ using namespace arrus::ops::us4r;
 %include "arrus/core/api/ops/us4r/Rx.h"
 %include "arrus/core/api/ops/us4r/Tx.h"
 %include "arrus/core/api/ops/us4r/TxRxSequence.h"
+%ignore arrus::ops::us4r::TransferRoi::getFrameRange;
+%ignore arrus::ops::us4r::Scheme::getTransferRoi;
+%include "arrus/core/api/ops/us4r/TransferRoi.h"
 %include "arrus/core/api/ops/us4r/Scheme.h"
 %include "arrus/core/api/ops/us4r/DigitalDownConversion.h"
 
@@ -495,6 +614,7 @@ using namespace arrus::ops::us4r;
 namespace std {
 %template(TxRxVector) vector<arrus::ops::us4r::TxRx>;
 %template(ArrusNdArrayVector) vector<arrus::framework::NdArray>;
+%template(SchemeVector) vector<arrus::ops::us4r::Scheme>;
 };
 
 %inline %{
@@ -503,6 +623,15 @@ void TxRxVectorPushBack(std::vector<arrus::ops::us4r::TxRx> &txrxs, arrus::ops::
     txrxs.push_back(txrx);
 }
 
+void SchemeVectorPushBack(std::vector<arrus::ops::us4r::Scheme> &schemes, arrus::ops::us4r::Scheme &scheme) {
+    schemes.push_back(scheme);
+}
+
+arrus::session::UploadResult arrusSessionUploadSchemes(
+    std::shared_ptr<arrus::session::Session> session, const std::vector<arrus::ops::us4r::Scheme> &schemes) {
+    return session->upload(schemes);
+}
+
 void VectorFloatPushBack(std::vector<float> &vector, double value) {
     vector.push_back(float(value));
 }
@@ -528,6 +657,97 @@ void Arrus2dArrayVectorPushBack(
 %};
 
 
+// ------------------------------------------ PROCESSING
+%{
+#include "arrus/core/api/processing/ColorDoppler.h"
+#include "arrus/core/api/processing/VolumeReconstruction.h"
+#include "arrus/core/api/processing/SvdClutterFilter.h"
+#include "arrus/core/api/processing/ProbeElementFeatureExtractor.h"
+%};
+
+%ignore arrus::processing::ColorDoppler::ColorDoppler(Span<float>, Span<float>, Span<float>, unsigned, unsigned);
+%ignore arrus::processing::ColorDoppler::process;
+%include "arrus/core/api/processing/ColorDoppler.h"
+%ignore arrus::processing::VolumeReconstruction::process;
+%include "arrus/core/api/processing/VolumeReconstruction.h"
+%ignore arrus::processing::SvdClutterFilter::push;
+%ignore arrus::processing::SvdClutterFilter::process;
+%include "arrus/core/api/processing/SvdClutterFilter.h"
+%ignore arrus::processing::ProbeElementFeatureExtractor::getMaxAmplitude;
+%ignore arrus::processing::ProbeElementFeatureExtractor::getEnergy;
+%ignore arrus::processing::ProbeElementFeatureExtractor::getSignalDuration;
+%ignore arrus::processing::ProbeElementFeatureExtractor::getFootprintPcc;
+%include "arrus/core/api/processing/ProbeElementFeatureExtractor.h"
+
+%inline %{
+/**
+ * Color Doppler for the given memory addresses (e.g. numpy ndarray.ctypes.data).
+ */
+void colorDopplerProcess(const arrus::processing::ColorDoppler &doppler, size_t iq, size_t nRepetitions,
+                         size_t nPixels, size_t color, size_t power, size_t turbulence) {
+    doppler.process((const float *) iq, nRepetitions, nPixels, (float *) color, (float *) power,
+                    (float *) turbulence);
+}
+
+/**
+ * 3D reconstruction for the given memory addresses (e.g. numpy ndarray.ctypes.data).
+ */
+void volumeReconstructionProcess(const arrus::processing::VolumeReconstruction &reconstruction, size_t iq,
+                                 size_t nSequences, size_t nRxY, size_t nRxX, size_t nSamples, size_t output) {
+    reconstruction.process((const float *) iq, nSequences, nRxY, nRxX, nSamples, (float *) output);
+}
+
+/**
+ * SVD clutter filter for the given memory addresses (e.g. numpy ndarray.ctypes.data).
+ */
+void svdClutterFilterProcess(arrus::processing::SvdClutterFilter &filter, size_t iq, size_t output) {
+    filter.process((const float *) iq, (float *) output);
+}
+
+/**
+ * Probe element features for the given memory addresses (e.g. numpy ndarray.ctypes.data).
+ * isInt16: true if the rf (and footprint) data is int16, false if float32.
+ */
+void probeElementMaxAmplitude(const arrus::processing::ProbeElementFeatureExtractor &extractor, size_t rf,
+                              bool isInt16, float cutoffFrequency, size_t output) {
+    if (isInt16) {
+        extractor.getMaxAmplitude((const int16_t *) rf, cutoffFrequency, (float *) output);
+    } else {
+        extractor.getMaxAmplitude((const float *) rf, cutoffFrequency, (float *) output);
+    }
+}
+
+void probeElementEnergy(const arrus::processing::ProbeElementFeatureExtractor &extractor, size_t rf,
+                        bool isInt16, float cutoffFrequency, size_t output) {
+    if (isInt16) {
+        extractor.getEnergy((const int16_t *) rf, cutoffFrequency, (float *) output);
+    } else {
+        extractor.getEnergy((const float *) rf, cutoffFrequency, (float *) output);
+    }
+}
+
+void probeElementSignalDuration(const arrus::processing::ProbeElementFeatureExtractor &extractor, size_t rf,
+                                bool isInt16, float cutoffFrequency, size_t output) {
+    if (isInt16) {
+        extractor.getSignalDuration((const int16_t *) rf, cutoffFrequency, (float *) output);
+    } else {
+        extractor.getSignalDuration((const float *) rf, cutoffFrequency, (float *) output);
+    }
+}
+
+void probeElementFootprintPcc(const arrus::processing::ProbeElementFeatureExtractor &extractor, size_t rf,
+                              size_t footprint, bool isInt16, size_t gateLength, float cutoffFrequency,
+                              size_t output) {
+    if (isInt16) {
+        extractor.getFootprintPcc((const int16_t *) rf, (const int16_t *) footprint, gateLength, cutoffFrequency,
+                                  (float *) output);
+    } else {
+        extractor.getFootprintPcc((const float *) rf, (const float *) footprint, gateLength, cutoffFrequency,
+                                  (float *) output);
+    }
+}
+%};
+
 // ------------------------------------------ SETTINGS
 // TODO wrap std optional
 // TODO test creating settings
@@ -568,3 +788,14 @@ using namespace ::arrus::devices;
 
 // ------------------------------------------ IO
 %include "arrus/core/api/io/settings.h"
+%ignore arrus::io::RfRecorder::write(const int16 *, size_t);
+%include "arrus/core/api/io/RfRecorder.h"
+
+%inline %{
+/**
+ * Records int16 data from the given memory address (e.g. numpy ndarray.ctypes.data).
+ */
+void arrusRfRecorderWrite(arrus::io::RfRecorder &recorder, size_t data, size_t size) {
+    recorder.write((const int16_t *) data, size);
+}
+%};
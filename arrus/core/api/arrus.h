@@ -6,5 +6,6 @@
 #include "arrus/core/api/devices.h"
 #include "arrus/core/api/framework.h"
 #include "arrus/core/api/io.h"
+#include "arrus/core/api/processing.h"
 
 #endif //ARRUS_CORE_API_ARRUS_H
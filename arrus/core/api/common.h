@@ -6,6 +6,7 @@
 #include "arrus/core/api/common/Tuple.h"
 #include "arrus/core/api/common/Interval.h"
 #include "arrus/core/api/common/logging.h"
+#include "arrus/core/api/common/tracing.h"
 #include "arrus/core/api/common/Span.h"
 #include "arrus/core/api/common/UniqueHandle.h"
 
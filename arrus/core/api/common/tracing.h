@@ -0,0 +1,47 @@
+#ifndef ARRUS_CORE_API_COMMON_TRACING_H
+#define ARRUS_CORE_API_COMMON_TRACING_H
+
+#include <string>
+
+#include "arrus/core/api/common/macros.h"
+
+namespace arrus {
+
+/**
+ * Returns true if arrus was built with the data path trace points (ARRUS_TRACING CMake option).
+ * Otherwise, no trace events are recorded.
+ */
+ARRUS_CPP_EXPORT
+bool isTracingAvailable();
+
+/**
+ * Enables/disables recording of the trace events (disabled by default).
+ *
+ * The trace points are placed on the acquisition data path: us4OEM interrupt callbacks, output buffer signal and
+ * release, user callback dispatch, device buffer entries release, overflow callbacks and scheme upload phases.
+ * Each thread records the events into its own ring buffer, i.e. only the most recent events are kept.
+ * The most recent events of the finished threads are kept as well, up to the ring buffer size in total.
+ *
+ * @param enabled whether the trace events should be recorded
+ */
+ARRUS_CPP_EXPORT
+void setTracingEnabled(bool enabled);
+
+/**
+ * Removes all the trace events recorded so far.
+ */
+ARRUS_CPP_EXPORT
+void clearTrace();
+
+/**
+ * Writes the recorded trace events to the given file, in the Chrome trace event JSON format
+ * (can be opened in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * @param filepath path to the output file
+ */
+ARRUS_CPP_EXPORT
+void dumpTrace(const std::string &filepath);
+
+}
+
+#endif //ARRUS_CORE_API_COMMON_TRACING_H
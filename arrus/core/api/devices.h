@@ -4,6 +4,7 @@
 #include "arrus/core/api/devices/DeviceId.h"
 #include "arrus/core/api/devices/Device.h"
 #include "arrus/core/api/devices/us4r/Us4R.h"
+#include "arrus/core/api/devices/us4r/SchemePlan.h"
 #include "arrus/core/api/devices/Ultrasound.h"
 
 #endif //ARRUS_CORE_API_DEVICES_H
@@ -0,0 +1,151 @@
+#ifndef ARRUS_CORE_API_DEVICES_US4R_ACQUISITIONSTATISTICS_H
+#define ARRUS_CORE_API_DEVICES_US4R_ACQUISITIONSTATISTICS_H
+
+#include <utility>
+#include <vector>
+
+#include "arrus/core/api/common/types.h"
+
+namespace arrus::devices {
+
+/**
+ * Histogram of the measured durations (intervals) [s].
+ *
+ * The bins are spaced logarithmically: bin i covers [edges[i], edges[i+1]). The first and the last bin
+ * additionally contain all the values below and above the histogram range, respectively.
+ */
+class DurationHistogram {
+public:
+    DurationHistogram(std::vector<float> binEdges, std::vector<uint64> counts, float min, float max, double sum)
+        : binEdges(std::move(binEdges)), counts(std::move(counts)), min(min), max(max), sum(sum) {}
+
+    /** Returns the bin edges [s]; the number of edges is the number of bins + 1. */
+    const std::vector<float> &getBinEdges() const { return binEdges; }
+
+    const std::vector<uint64> &getCounts() const { return counts; }
+
+    uint64 getNumberOfSamples() const {
+        uint64 result = 0;
+        for (auto c : counts) {
+            result += c;
+        }
+        return result;
+    }
+
+    /** Returns the minimum value [s]; 0 when no value was recorded. */
+    float getMin() const { return min; }
+
+    /** Returns the maximum value [s]; 0 when no value was recorded. */
+    float getMax() const { return max; }
+
+    /** Returns the mean value [s]; 0 when no value was recorded. */
+    float getMean() const {
+        auto n = getNumberOfSamples();
+        return n == 0 ? 0.0f : (float) (sum / (double) n);
+    }
+
+    /**
+     * Returns the approximate p-th percentile [s]: the upper edge of the bin containing the percentile,
+     * limited to the [min, max] range.
+     *
+     * @param p percentile, [0, 100]
+     */
+    float getPercentile(float p) const {
+        auto n = getNumberOfSamples();
+        if (n == 0) {
+            return 0.0f;
+        }
+        auto rank = (uint64) ((double) p / 100.0 * (double) n);
+        if (rank >= n) {
+            rank = n - 1;
+        }
+        uint64 cumulative = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            cumulative += counts[i];
+            if (cumulative > rank) {
+                float value = binEdges[i + 1];
+                return value < min ? min : (value > max ? max : value);
+            }
+        }
+        return max;
+    }
+
+private:
+    std::vector<float> binEdges;
+    std::vector<uint64> counts;
+    float min, max;
+    double sum;
+};
+
+/**
+ * Acquisition statistics of the Us4R output buffer, collected since the last reset.
+ *
+ * A single "frame" here is a single output buffer element (i.e. the output of a single batch of TX/RX sequences).
+ */
+class AcquisitionStatistics {
+public:
+    AcquisitionStatistics(uint64 nAcquired, uint64 nDelivered, uint64 nDropped, uint64 nOverflows,
+                          size_t occupancyHighWaterMark, float duration, DurationHistogram hostInterval,
+                          DurationHistogram fpgaInterval, DurationHistogram callbackDuration)
+        : nAcquired(nAcquired), nDelivered(nDelivered), nDropped(nDropped), nOverflows(nOverflows),
+          occupancyHighWaterMark(occupancyHighWaterMark), duration(duration), hostInterval(std::move(hostInterval)),
+          fpgaInterval(std::move(fpgaInterval)), callbackDuration(std::move(callbackDuration)) {}
+
+    /** Returns the number of buffer elements filled with data by all us4OEMs. */
+    uint64 getNumberOfAcquiredFrames() const { return nAcquired; }
+
+    /** Returns the number of buffer elements passed to the user 'on new data' callback. */
+    uint64 getNumberOfDeliveredFrames() const { return nDelivered; }
+
+    /**
+     * Returns the estimated number of buffer elements that were lost, i.e. acquired by the device but never
+     * delivered to the host. The value is estimated based on the trigger numbers of the frame metadata (if
+     * available), i.e. it is 0 if the frame metadata is not available.
+     */
+    uint64 getNumberOfDroppedFrames() const { return nDropped; }
+
+    /** Returns the number of the RX or host buffer overflows detected. */
+    uint64 getNumberOfOverflows() const { return nOverflows; }
+
+    /** Returns the maximum number of buffer elements that were waiting to be released at the same time. */
+    size_t getBufferOccupancyHighWaterMark() const { return occupancyHighWaterMark; }
+
+    /** Returns the time since the last reset [s]. */
+    float getDuration() const { return duration; }
+
+    /**
+     * Returns the mean frame rate, based on the intervals measured with the host clock [Hz]; 0 when
+     * less than two frames were acquired.
+     */
+    float getFrameRate() const {
+        float mean = hostInterval.getMean();
+        return mean > 0.0f ? 1.0f / mean : 0.0f;
+    }
+
+    /** Returns the histogram of the intervals between subsequent frames, measured with the host clock [s]. */
+    const DurationHistogram &getHostInterval() const { return hostInterval; }
+
+    /**
+     * Returns the histogram of the intervals between subsequent frames, measured with the FPGA timestamps
+     * of the frame metadata [s]; empty if the frame metadata is not available.
+     */
+    const DurationHistogram &getFPGAInterval() const { return fpgaInterval; }
+
+    /** Returns the histogram of the user 'on new data' callback durations [s]. */
+    const DurationHistogram &getCallbackDuration() const { return callbackDuration; }
+
+private:
+    uint64 nAcquired;
+    uint64 nDelivered;
+    uint64 nDropped;
+    uint64 nOverflows;
+    size_t occupancyHighWaterMark;
+    float duration;
+    DurationHistogram hostInterval;
+    DurationHistogram fpgaInterval;
+    DurationHistogram callbackDuration;
+};
+
+}// namespace arrus::devices
+
+#endif//ARRUS_CORE_API_DEVICES_US4R_ACQUISITIONSTATISTICS_H
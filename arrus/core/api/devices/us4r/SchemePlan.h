@@ -0,0 +1,157 @@
+#ifndef ARRUS_CORE_API_DEVICES_US4R_SCHEMEPLAN_H
+#define ARRUS_CORE_API_DEVICES_US4R_SCHEMEPLAN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrus/core/api/common/macros.h"
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/devices/us4r/Us4RSettings.h"
+#include "arrus/core/api/ops/us4r/Scheme.h"
+
+namespace arrus::devices {
+
+/**
+ * us4OEM resources that would be used by the planned scheme.
+ */
+class Us4OEMPlan {
+public:
+    Us4OEMPlan(Ordinal ordinal, uint16 nFirings, uint32 nTriggers, size_t ddrUsage, size_t elementSize,
+               size_t nTransfersPerElement, size_t nTransfers, int transferStrategy)
+        : ordinal(ordinal), nFirings(nFirings), nTriggers(nTriggers), ddrUsage(ddrUsage), elementSize(elementSize),
+          nTransfersPerElement(nTransfersPerElement), nTransfers(nTransfers), transferStrategy(transferStrategy) {}
+
+    Ordinal getOrdinal() const { return ordinal; }
+
+    /**
+     * Returns the number of firings (sequencer entries) programmed on this module.
+     */
+    uint16 getNumberOfFirings() const { return nFirings; }
+
+    /**
+     * Returns the number of triggers (nFirings * batchSize * rxBufferSize).
+     */
+    uint32 getNumberOfTriggers() const { return nTriggers; }
+
+    /**
+     * Returns the number of bytes of the us4OEM DDR memory used by the rx buffer.
+     */
+    size_t getDdrUsage() const { return ddrUsage; }
+
+    /**
+     * Returns the number of bytes transferred to host by this module per a single rx buffer element.
+     */
+    size_t getElementSize() const { return elementSize; }
+
+    /**
+     * Returns the number of DMA transfers required to transfer a single buffer element.
+     */
+    size_t getNumberOfTransfersPerElement() const { return nTransfersPerElement; }
+
+    /**
+     * Returns the number of DMA transfers that will be programmed for the rx buffer
+     * (nTransfersPerElement * rxBufferSize).
+     */
+    size_t getNumberOfTransfers() const { return nTransfers; }
+
+    /**
+     * Returns the transfer registration strategy that will be used:
+     * 0: nHost == nRx, 1: nRx < nHost <= 256, 2: nHost > 256 (transfers reprogrammed in the callback).
+     */
+    int getTransferStrategy() const { return transferStrategy; }
+
+private:
+    Ordinal ordinal;
+    uint16 nFirings;
+    uint32 nTriggers;
+    size_t ddrUsage;
+    size_t elementSize;
+    size_t nTransfersPerElement;
+    size_t nTransfers;
+    int transferStrategy;
+};
+
+/**
+ * The result of a dry-run compilation of a scheme (see planScheme function).
+ */
+class SchemePlan {
+public:
+    SchemePlan(float sequenceDuration, float frameRate, float hostBandwidth, uint16 maxRxBufferSize,
+               std::vector<Us4OEMPlan> us4oems, std::vector<std::string> violations)
+        : sequenceDuration(sequenceDuration), frameRate(frameRate), hostBandwidth(hostBandwidth),
+          maxRxBufferSize(maxRxBufferSize), us4oems(std::move(us4oems)), violations(std::move(violations)) {}
+
+    /**
+     * Returns true if the scheme can be uploaded to the configured system, i.e. no hardware limit is violated.
+     */
+    bool isFeasible() const { return violations.empty(); }
+
+    /**
+     * Returns the list of violated hardware limits (empty if the scheme is feasible).
+     */
+    const std::vector<std::string> &getViolations() const { return violations; }
+
+    /**
+     * Returns the time of a single TX/RX sequence execution [s], including the SRI (if set).
+     */
+    float getSequenceDuration() const { return sequenceDuration; }
+
+    /**
+     * Returns the achievable TX/RX sequence rate [Hz], i.e. the number of sequences acquired per second.
+     * Note: for the HOST and MANUAL work modes this is an upper bound, the actual rate is determined by the
+     * host-side trigger.
+     */
+    float getFrameRate() const { return frameRate; }
+
+    /**
+     * Returns the required us4R -> host data transfer bandwidth [MB/s] (1 MB = 10^6 bytes).
+     */
+    float getHostBandwidth() const { return hostBandwidth; }
+
+    /**
+     * Returns the largest rx buffer size (number of elements) that fits the us4OEM memory, triggers and
+     * transfers limits. 0 means that even a single element does not fit.
+     */
+    uint16 getMaxRxBufferSize() const { return maxRxBufferSize; }
+
+    const std::vector<Us4OEMPlan> &getUs4OEMs() const { return us4oems; }
+
+private:
+    float sequenceDuration;
+    float frameRate;
+    float hostBandwidth;
+    uint16 maxRxBufferSize;
+    std::vector<Us4OEMPlan> us4oems;
+    std::vector<std::string> violations;
+};
+
+/**
+ * Runs a dry-run compilation of the given scheme for the given us4R configuration and returns a report
+ * of the resources that would be used.
+ *
+ * No hardware is accessed: the TX/RX sequence is split and compiled exactly as in Session::upload, but
+ * against virtual us4OEM modules. Hardware limits (number of firings, triggers, DDR memory, DMA transfers,
+ * minimum PRI) are reported via SchemePlan::getViolations instead of thrown as exceptions.
+ *
+ * @param settings us4R settings (should contain probe and adapter settings)
+ * @param scheme the scheme to plan
+ * @return scheme plan
+ * @throws arrus::IllegalArgumentException when the scheme or the settings are invalid
+ */
+ARRUS_CPP_EXPORT
+SchemePlan planScheme(const Us4RSettings &settings, const ::arrus::ops::us4r::Scheme &scheme);
+
+/**
+ * Reads the given session settings file and plans the scheme for the us4R:0 described there.
+ *
+ * @param filepath a path to session settings
+ * @param scheme the scheme to plan
+ * @return scheme plan
+ */
+ARRUS_CPP_EXPORT
+SchemePlan planScheme(const std::string &filepath, const ::arrus::ops::us4r::Scheme &scheme);
+
+}
+
+#endif //ARRUS_CORE_API_DEVICES_US4R_SCHEMEPLAN_H
@@ -0,0 +1,157 @@
+#ifndef ARRUS_CORE_API_DEVICES_US4R_TELEMETRY_H
+#define ARRUS_CORE_API_DEVICES_US4R_TELEMETRY_H
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/devices/DeviceId.h"
+
+namespace arrus::devices {
+
+/**
+ * A single telemetry sample of a single us4OEM module.
+ *
+ * Values that could not be read from the device are NaN.
+ */
+class Us4OEMTelemetry {
+public:
+    Us4OEMTelemetry(float fpgaTemperature, float ucdTemperature, float ucdExternalTemperature, float hvpVoltage,
+                    float hvmVoltage, float fpgaWallclock, std::vector<float> ucdVoltages)
+        : fpgaTemperature(fpgaTemperature), ucdTemperature(ucdTemperature),
+          ucdExternalTemperature(ucdExternalTemperature), hvpVoltage(hvpVoltage), hvmVoltage(hvmVoltage),
+          fpgaWallclock(fpgaWallclock), ucdVoltages(std::move(ucdVoltages)) {}
+
+    /** See Us4OEM::getFPGATemperature. */
+    float getFPGATemperature() const { return fpgaTemperature; }
+
+    /** See Us4OEM::getUCDTemperature. */
+    float getUCDTemperature() const { return ucdTemperature; }
+
+    /** See Us4OEM::getUCDExternalTemperature. */
+    float getUCDExternalTemperature() const { return ucdExternalTemperature; }
+
+    /** See Us4OEM::getMeasuredHVPVoltage. */
+    float getMeasuredHVPVoltage() const { return hvpVoltage; }
+
+    /** See Us4OEM::getMeasuredHVMVoltage. */
+    float getMeasuredHVMVoltage() const { return hvmVoltage; }
+
+    /** See Us4OEM::getFPGAWallclock. */
+    float getFPGAWallclock() const { return fpgaWallclock; }
+
+    /**
+     * Returns the voltages measured on the UCD rails selected in TelemetrySettings (in the same order),
+     * see Us4OEM::getUCDMeasuredVoltage.
+     */
+    const std::vector<float> &getUCDMeasuredVoltages() const { return ucdVoltages; }
+
+private:
+    float fpgaTemperature;
+    float ucdTemperature;
+    float ucdExternalTemperature;
+    float hvpVoltage;
+    float hvmVoltage;
+    float fpgaWallclock;
+    std::vector<float> ucdVoltages;
+};
+
+/**
+ * Telemetry of all us4OEM modules, sampled at the given time.
+ */
+class TelemetrySnapshot {
+public:
+    TelemetrySnapshot(int64 timestamp, std::vector<Us4OEMTelemetry> us4oems)
+        : timestamp(timestamp), us4oems(std::move(us4oems)) {}
+
+    /**
+     * Returns the sampling time: the number of milliseconds since the Unix epoch.
+     */
+    int64 getTimestamp() const { return timestamp; }
+
+    /**
+     * Returns the telemetry of the given us4OEM.
+     */
+    const Us4OEMTelemetry &getUs4OEM(Ordinal ordinal) const { return us4oems.at(ordinal); }
+
+    size_t getNumberOfUs4OEMs() const { return us4oems.size(); }
+
+private:
+    int64 timestamp;
+    std::vector<Us4OEMTelemetry> us4oems;
+};
+
+/**
+ * Telemetry threshold alert: the given value of the given us4OEM exceeded the threshold.
+ */
+class TelemetryAlert {
+public:
+    TelemetryAlert(int64 timestamp, Ordinal us4oem, std::string parameter, float value, float threshold)
+        : timestamp(timestamp), us4oem(us4oem), parameter(std::move(parameter)), value(value),
+          threshold(threshold) {}
+
+    /** Sampling time: the number of milliseconds since the Unix epoch. */
+    int64 getTimestamp() const { return timestamp; }
+
+    Ordinal getUs4OEM() const { return us4oem; }
+
+    /** The name of the parameter, e.g. "FPGATemperature". */
+    const std::string &getParameter() const { return parameter; }
+
+    float getValue() const { return value; }
+
+    float getThreshold() const { return threshold; }
+
+private:
+    int64 timestamp;
+    Ordinal us4oem;
+    std::string parameter;
+    float value;
+    float threshold;
+};
+
+using TelemetryAlertCallback = std::function<void(const TelemetryAlert &)>;
+
+/**
+ * Telemetry sampler settings.
+ */
+class TelemetrySettings {
+public:
+    /**
+     * @param samplingPeriod the time between subsequent samples [s]
+     * @param historySize the number of the most recent samples to keep
+     * @param ucdRails the UCD rails, which voltages should be sampled (see Us4OEM::getUCDMeasuredVoltage)
+     * @param maxFPGATemperature the FPGA temperature alert threshold; nullopt means no alert
+     * @param maxUCDTemperature the UCD temperature alert threshold; nullopt means no alert
+     */
+    explicit TelemetrySettings(float samplingPeriod = 1.0f, size_t historySize = 600,
+                               std::vector<uint8> ucdRails = {},
+                               std::optional<float> maxFPGATemperature = std::nullopt,
+                               std::optional<float> maxUCDTemperature = std::nullopt)
+        : samplingPeriod(samplingPeriod), historySize(historySize), ucdRails(std::move(ucdRails)),
+          maxFPGATemperature(maxFPGATemperature), maxUCDTemperature(maxUCDTemperature) {}
+
+    float getSamplingPeriod() const { return samplingPeriod; }
+
+    size_t getHistorySize() const { return historySize; }
+
+    const std::vector<uint8> &getUCDRails() const { return ucdRails; }
+
+    const std::optional<float> &getMaxFPGATemperature() const { return maxFPGATemperature; }
+
+    const std::optional<float> &getMaxUCDTemperature() const { return maxUCDTemperature; }
+
+private:
+    float samplingPeriod;
+    size_t historySize;
+    std::vector<uint8> ucdRails;
+    std::optional<float> maxFPGATemperature;
+    std::optional<float> maxUCDTemperature;
+};
+
+}// namespace arrus::devices
+
+#endif//ARRUS_CORE_API_DEVICES_US4R_TELEMETRY_H
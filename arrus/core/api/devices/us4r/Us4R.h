@@ -6,8 +6,10 @@
 #include "arrus/core/api/devices/Device.h"
 #include "arrus/core/api/devices/DeviceWithComponents.h"
 #include "arrus/core/api/devices/probe/Probe.h"
+#include "arrus/core/api/devices/us4r/AcquisitionStatistics.h"
 #include "arrus/core/api/devices/us4r/ProbeAdapter.h"
 #include "arrus/core/api/devices/us4r/RxSettings.h"
+#include "arrus/core/api/devices/us4r/Telemetry.h"
 #include "arrus/core/api/devices/us4r/Us4OEM.h"
 #include "arrus/core/api/framework/Buffer.h"
 #include "arrus/core/api/framework/DataBufferSpec.h"
@@ -335,6 +337,77 @@ public:
      */
     virtual void setMaximumPulseLength(std::optional<float> maxLength) = 0;
 
+    /**
+     * Enables/disables metadata-only acquisitions for RX NOPs on the us4OEM that gathers the frame metadata.
+     *
+     * By default, the frame metadata us4OEM acquires and transfers complete frames for all TX/RXs, including
+     * the ones without any active RX channel (RX NOPs), just to keep the metadata stored in the first sample of
+     * each frame. When this mode is enabled, for RX NOPs only the first few samples (including the metadata) are
+     * acquired. These compact RX NOP frames are stored after all the data frames of the buffer element, and the
+     * frame channel mapping describes data frames only (i.e. the same as for any other us4OEM).
+     * Sub-sequences (setSubsequence) and the transfer ROI (see ops::us4r::TransferRoi) are not available
+     * in this mode.
+     *
+     * The setting is applied on the next upload call.
+     *
+     * @param value whether the metadata-only RX NOPs should be enabled
+     */
+    virtual void setRxNopsMetadataOnly(bool value) = 0;
+
+    /**
+     * Returns true if the metadata-only RX NOPs are enabled (see setRxNopsMetadataOnly).
+     */
+    virtual bool isRxNopsMetadataOnly() const = 0;
+
+    /**
+     * Starts sampling the telemetry of all us4OEM modules (temperatures, voltages, see Us4OEMTelemetry)
+     * on a separate, low-priority thread.
+     *
+     * The sampler does not lock the device and works independently of the data acquisition. The most recent
+     * samples are kept in memory (see TelemetrySettings::getHistorySize).
+     *
+     * @param settings sampler settings
+     * @param onAlert callback called (on the sampler thread) when a value exceeds its threshold; the alert is
+     *  triggered once, when the value crosses the threshold; the alerts are also logged as warnings
+     * @throws IllegalStateException when the telemetry sampler is already running
+     */
+    virtual void startTelemetry(const TelemetrySettings &settings, TelemetryAlertCallback onAlert) = 0;
+
+    /**
+     * Starts sampling the telemetry of all us4OEM modules; threshold alerts are only logged.
+     */
+    virtual void startTelemetry(const TelemetrySettings &settings) = 0;
+
+    /**
+     * Stops the telemetry sampler. The samples collected so far are discarded.
+     * Does nothing when the sampler is not running.
+     */
+    virtual void stopTelemetry() = 0;
+
+    /**
+     * Returns the most recent telemetry sample. This function does not block the sampler thread.
+     *
+     * @return the most recent sample, nullopt if the sampler is not running or no sample is available yet
+     */
+    virtual std::optional<TelemetrySnapshot> getLatestTelemetry() = 0;
+
+    /**
+     * Returns the telemetry samples currently stored in memory, ordered from the oldest to the newest one.
+     */
+    virtual std::vector<TelemetrySnapshot> getTelemetryHistory() = 0;
+
+    /**
+     * Returns the acquisition statistics (the number of acquired, delivered and dropped frames, frame intervals,
+     * etc.) collected since the last reset (see resetAcquisitionStatistics) or since the device was created.
+     * The statistics are kept across the uploads.
+     */
+    virtual AcquisitionStatistics getAcquisitionStatistics() = 0;
+
+    /**
+     * Resets the acquisition statistics.
+     */
+    virtual void resetAcquisitionStatistics() = 0;
+
     Us4R(Us4R const &) = delete;
     Us4R(Us4R const &&) = delete;
     void operator=(Us4R const &) = delete;
@@ -3,7 +3,11 @@
 
 #include "arrus/core/api/framework/DataBufferSpec.h"
 #include "arrus/core/api/framework/Buffer.h"
+#include "arrus/core/api/framework/FrameMetadata.h"
 #include "arrus/core/api/framework/NdArray.h"
 #include "arrus/core/api/framework/DataBuffer.h"
+#include "arrus/core/api/framework/dlpack.h"
+#include "arrus/core/api/framework/FrameAligner.h"
+#include "arrus/core/api/framework/MergedBufferElement.h"
 
 #endif //ARRUS_CORE_API_FRAMEWORK_H
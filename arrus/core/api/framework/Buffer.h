@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <functional>
+#include "FrameMetadata.h"
 #include "NdArray.h"
 
 namespace arrus::framework {
@@ -40,6 +41,20 @@ public:
     virtual size_t getPosition() = 0;
 
     virtual State getState() const = 0;
+
+    /**
+     * Returns the number of frames of this element, for which the frame metadata is available.
+     */
+    virtual size_t getNumberOfFrameMetadata() { return 0; }
+
+    /**
+     * Returns the metadata of the given frame (a view of the element data, the metadata is not copied).
+     *
+     * @param frame frame number, in the order of acquisition
+     */
+    virtual FrameMetadata getFrameMetadata(size_t /*frame*/) {
+        throw IllegalStateException("Frame metadata is not available for this buffer element.");
+    }
 };
 
 /**
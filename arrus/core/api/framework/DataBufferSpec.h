@@ -1,6 +1,8 @@
 #ifndef ARRUS_ARRUS_CORE_API_FRAMEWORK_DATABUFFERSPEC_H
 #define ARRUS_ARRUS_CORE_API_FRAMEWORK_DATABUFFERSPEC_H
 
+#include <optional>
+
 namespace arrus::framework {
 
 /**
@@ -23,9 +25,15 @@ public:
      *
      * @param bufferType buffer type
      * @param nElements number of elements (a single element of the buffer is an output of a single tx/rx sequence execution)
+     * @param nCoalescedElements the number of consecutive elements that should be transferred to the buffer and
+     *   signaled at once (transfer coalescing); 1 means that each element is signaled separately
+     * @param maxCoalescingLatency the maximum additional latency [s] the coalescing may introduce; the number
+     *   of coalesced elements will be reduced to not exceed it; nullopt means no limit
      */
-    DataBufferSpec(Type bufferType, const unsigned &nElements)
-        : bufferType(bufferType), nElements(nElements) {}
+    DataBufferSpec(Type bufferType, const unsigned &nElements, unsigned nCoalescedElements = 1,
+                   std::optional<float> maxCoalescingLatency = std::nullopt)
+        : bufferType(bufferType), nElements(nElements), nCoalescedElements(nCoalescedElements),
+          maxCoalescingLatency(maxCoalescingLatency) {}
 
     Type getType() const {
         return bufferType;
@@ -38,9 +46,25 @@ public:
         return nElements;
     }
 
+    /**
+     * Returns the (requested) number of elements that should be transferred and signaled at once.
+     */
+    unsigned getNumberOfCoalescedElements() const {
+        return nCoalescedElements;
+    }
+
+    /**
+     * Returns the maximum additional latency [s] of the transfer coalescing.
+     */
+    const std::optional<float> &getMaxCoalescingLatency() const {
+        return maxCoalescingLatency;
+    }
+
 private:
     Type bufferType;
     unsigned nElements;
+    unsigned nCoalescedElements;
+    std::optional<float> maxCoalescingLatency;
 };
 
 }
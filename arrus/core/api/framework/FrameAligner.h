@@ -0,0 +1,70 @@
+#ifndef ARRUS_CORE_API_FRAMEWORK_FRAMEALIGNER_H
+#define ARRUS_CORE_API_FRAMEWORK_FRAMEALIGNER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "arrus/core/api/common/macros.h"
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/framework/Buffer.h"
+
+namespace arrus::framework {
+
+/**
+ * Aligns the buffer elements produced by several systems (e.g. us4R devices driven by a common trigger),
+ * by the element position (frame index).
+ *
+ * The elements of each system should be pushed from the system's 'on new data' callback. When the elements
+ * of a given position have been pushed by all the systems, the callback is called with all of them (in the order
+ * of systems), in the thread of the system that pushed the last element. The aligned elements are not released
+ * by the aligner: the callback is responsible for that.
+ *
+ * When some system skips an element (e.g. drops a frame), the elements of that position pushed by the other
+ * systems would never be aligned; they are detected when the next element of the same position arrives
+ * (see push), released and dropped, so none of the systems is blocked waiting for the release of its element.
+ *
+ * Thread-safe.
+ */
+class ARRUS_CPP_EXPORT FrameAligner {
+    class Impl;
+    std::shared_ptr<Impl> impl;
+
+public:
+    using OnAlignedCallback = std::function<void(const std::vector<BufferElement::SharedHandle> &)>;
+
+    /**
+     * @param nSystems the number of aligned systems
+     * @param nElements the number of elements of each system buffer
+     * @param onAligned callback to call with the aligned elements
+     */
+    FrameAligner(size_t nSystems, size_t nElements, OnAlignedCallback onAligned);
+
+    /**
+     * Pushes a new element of the given system.
+     *
+     * If the given system has already pushed an element of the same position, which has not been aligned yet
+     * (i.e. some other system skipped that element), the position is stale: all the elements of the position
+     * are released and dropped, and the position is started again with the given element, so the systems are
+     * resynchronized on their next elements of that position.
+     *
+     * @param system the system number
+     * @param element the new element of the system
+     * @return false if a stale position was dropped, true otherwise
+     */
+    bool push(size_t system, const BufferElement::SharedHandle &element);
+
+    /**
+     * Releases and drops all the elements pushed so far and not aligned yet.
+     */
+    void reset();
+
+    /**
+     * Returns the number of positions, for which some (but not all) of the systems have pushed their elements.
+     */
+    size_t getNumberOfPendingPositions() const;
+};
+
+}// namespace arrus::framework
+
+#endif//ARRUS_CORE_API_FRAMEWORK_FRAMEALIGNER_H
@@ -0,0 +1,83 @@
+#ifndef ARRUS_CORE_API_FRAMEWORK_FRAMEMETADATA_H
+#define ARRUS_CORE_API_FRAMEWORK_FRAMEMETADATA_H
+
+#include <cstddef>
+
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/common/exceptions.h"
+
+namespace arrus::framework {
+
+/**
+ * Metadata of a single frame, written by the frame metadata us4OEM (see IOSettings frame metadata capability)
+ * into the first sample of the frame, i.e. N_VALUES int16 words (one per RX channel).
+ *
+ * This class is a read-only view of the metadata row: the values are decoded lazily directly from the buffer
+ * element memory, no data is copied. The view is valid only as long as the buffer element is not released.
+ *
+ * Multi-word values are stored with the least significant 16-bit word first.
+ *
+ * NOTE: the word layout below (trigger number, timestamp, sub-sequence range) is the layout assumed by arrus;
+ * it has not been verified against the us4OEM firmware documentation, which is not a part of this repository.
+ * The File device writes the metadata in the same layout.
+ */
+class FrameMetadata {
+public:
+    /** The number of int16 words of the metadata row. */
+    static constexpr size_t N_VALUES = 32;
+    /** Trigger (pulse) counter: 2 words, uint32. */
+    static constexpr size_t TRIGGER_NUMBER_WORD = 0;
+    /** FPGA timestamp: 4 words, uint64. */
+    static constexpr size_t TIMESTAMP_WORD = 4;
+    /** The first and the last (exclusive) TX/RX of the currently acquired sub-sequence. */
+    static constexpr size_t TX_BEGIN_WORD = 8;
+    static constexpr size_t TX_END_WORD = 9;
+
+    /**
+     * @param row pointer to the first word of the metadata row
+     * @param stride distance between the subsequent words of the row (the number of int16 values)
+     */
+    FrameMetadata(const int16 *row, size_t stride) : row(row), stride(stride) {}
+
+    /**
+     * Returns the FPGA timestamp of the frame: the number of us4OEM clock cycles (65 MHz, the us4OEM sampling
+     * frequency). The File device writes the number of the emulated clock cycles since the device start.
+     */
+    uint64 getTimestamp() const { return getUnsigned<uint64>(TIMESTAMP_WORD, 4); }
+
+    /**
+     * Returns the trigger number, i.e. the value of the trigger counter when the frame was acquired.
+     * Consecutive frames of the same TX/RX have consecutive trigger numbers, unless some frames were dropped.
+     */
+    uint32 getTriggerNumber() const { return getUnsigned<uint32>(TRIGGER_NUMBER_WORD, 2); }
+
+    uint16 getTxBegin() const { return getUnsigned<uint16>(TX_BEGIN_WORD, 1); }
+
+    uint16 getTxEnd() const { return getUnsigned<uint16>(TX_END_WORD, 1); }
+
+    /**
+     * Returns the raw i-th word of the metadata row.
+     */
+    int16 getValue(size_t i) const {
+        if (i >= N_VALUES) {
+            throw IllegalArgumentException("Frame metadata word index out of range.");
+        }
+        return row[i * stride];
+    }
+
+private:
+    template<typename T> T getUnsigned(size_t word, size_t nWords) const {
+        T result = 0;
+        for (size_t i = 0; i < nWords; ++i) {
+            result |= static_cast<T>(static_cast<uint16>(row[(word + i) * stride])) << (16 * i);
+        }
+        return result;
+    }
+
+    const int16 *row;
+    size_t stride;
+};
+
+}// namespace arrus::framework
+
+#endif//ARRUS_CORE_API_FRAMEWORK_FRAMEMETADATA_H
@@ -0,0 +1,41 @@
+#ifndef ARRUS_CORE_API_FRAMEWORK_MERGEDBUFFERELEMENT_H
+#define ARRUS_CORE_API_FRAMEWORK_MERGEDBUFFERELEMENT_H
+
+#include <memory>
+
+#include "arrus/core/api/framework/Buffer.h"
+
+namespace arrus::framework {
+
+/**
+ * An element of the output buffer of a session driving several systems (see Session::upload): the elements
+ * of the same position (frame index) of all the systems, i.e. the parts of this element.
+ *
+ * The parts are available without copying the data, see getPart. The data of all the parts concatenated
+ * (getData) is available only when the concatenation is enabled (see Session::setMergedBufferConcatenation).
+ * Releasing this element releases all the parts.
+ */
+class MergedBufferElement : public BufferElement {
+public:
+    using SharedHandle = std::shared_ptr<MergedBufferElement>;
+
+    /**
+     * Returns the number of parts (systems) of this element.
+     */
+    virtual size_t getNumberOfParts() const = 0;
+
+    /**
+     * Returns the i-th part of this element (the element of the i-th system), nullptr if the element is not ready.
+     */
+    virtual BufferElement::SharedHandle getPart(size_t i) const = 0;
+
+    /**
+     * Returns true if getData provides the data of all the parts concatenated; otherwise getData throws
+     * IllegalStateException.
+     */
+    virtual bool isConcatenated() const = 0;
+};
+
+}// namespace arrus::framework
+
+#endif//ARRUS_CORE_API_FRAMEWORK_MERGEDBUFFERELEMENT_H
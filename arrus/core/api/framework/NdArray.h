@@ -3,7 +3,9 @@
 
 #include <utility>
 #include <cstring>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include "arrus/core/api/common/Tuple.h"
 #include "arrus/core/api/devices/DeviceId.h"
@@ -14,7 +16,14 @@ namespace arrus::framework {
 /**
  * N-dimensional array.
  *
- * The data order in memory is C-contiguous (last axis varies the fastest).
+ * The array is described by a pointer to its first element, shape and strides (the number of elements between
+ * the consecutive values along a given axis). By default, the data order in memory is C-contiguous (last axis
+ * varies the fastest); slicing and transposing produce views with the same data, but different strides.
+ *
+ * The array either owns its data (the memory is allocated by the array and shared by all its copies and views,
+ * the memory is released when the last of them is destroyed) or is a view of an externally managed memory
+ * (e.g. buffer element memory). Copying an NdArray never copies the data, use the `copy` method to get an independent
+ * (C-contiguous) array.
  *
  * The address returned by `getData` function is located on a device determined by placement property.
  * CPU:0 placement means that the data is located in host computer's RAM.
@@ -25,7 +34,14 @@ public:
     /** A list of currently supported data types of the output buffer.*/
     enum class DataType {
         INT16,
-        FLOAT32
+        FLOAT32,
+        UINT8,
+        /** Interleaved (real, imaginary) int16 pairs. */
+        COMPLEX_INT16,
+        /** IEEE 754 half precision floating point number (stored as 16-bit value). */
+        FLOAT16,
+        /** Interleaved (real, imaginary) float32 pairs. */
+        COMPLEX_FLOAT32
     };
 
     static size_t getDataTypeSize(DataType type) {
@@ -34,6 +50,14 @@ public:
             return sizeof(int16_t);
         case DataType::FLOAT32:
             return sizeof(float32);
+        case DataType::UINT8:
+            return sizeof(uint8_t);
+        case DataType::COMPLEX_INT16:
+            return 2*sizeof(int16_t);
+        case DataType::FLOAT16:
+            return sizeof(uint16_t);
+        case DataType::COMPLEX_FLOAT32:
+            return 2*sizeof(float32);
         default:
             throw arrus::IllegalArgumentException("Unsupported data type");
         }
@@ -41,117 +65,99 @@ public:
 
     /** Array shape. */
     typedef Tuple<size_t> Shape;
+    /** Array strides, in the number of elements (not bytes). */
+    typedef Tuple<size_t> Strides;
+
+    /**
+     * Range [begin, end) along a single axis, with the given step. Negative begin/end are counted from the end of
+     * the axis, end == -1 means the end of the axis (i.e. the last element is included).
+     */
+    struct Slice {
+        int begin{0};
+        int end{-1};
+        size_t step{1};
+    };
 
-    NdArray(): ptr(nullptr), placement(devices::DeviceId(devices::DeviceType::CPU, 0)){}
+    NdArray(): ptr(nullptr), dataType(DataType::INT16), placement(devices::DeviceId(devices::DeviceType::CPU, 0)){}
 
+    /**
+     * Creates a new C-contiguous array with the given shape, filled with zeros.
+     */
     NdArray(Shape shape, DataType dataType, devices::DeviceId placement, std::string name)
-        : shape(std::move(shape)), dataType(dataType), placement(std::move(placement)),
-          isView(false), name(std::move(name)) {
-
-        this->nBytes = this->shape.product() * getDataTypeSize(this->dataType);
-        this->ptr = new char[this->nBytes];
-        std::memset((char*)(this->ptr), 0, this->nBytes);
+        : shape(std::move(shape)), dataType(dataType), placement(std::move(placement)), name(std::move(name)) {
+        this->strides = getContiguousStrides(this->shape);
+        size_t nBytes = getNumberOfBytes();
+        this->storage = std::shared_ptr<char>(new char[nBytes], std::default_delete<char[]>());
+        this->ptr = this->storage.get();
+        std::memset(this->ptr, 0, nBytes);
     }
 
+    /**
+     * Creates a view of the C-contiguous data under the given address.
+     */
     NdArray(void *ptr, Shape shape, DataType dataType, const devices::DeviceId &placement) :
-        ptr(ptr), shape(std::move(shape)), dataType(dataType), placement(placement), isView(true) {
-        this->nBytes = this->shape.product() * getDataTypeSize(this->dataType);
+        ptr(ptr), shape(std::move(shape)), dataType(dataType), placement(placement) {
+        this->strides = getContiguousStrides(this->shape);
     }
 
-    NdArray(void *ptr, Shape shape, DataType dataType, const devices::DeviceId &placement, std::string name, bool isView):
-        shape(std::move(shape)), dataType(dataType), placement(placement), isView(isView), name(std::move(name)) {
-        this->nBytes = this->shape.product() * getDataTypeSize(this->dataType);
-        if(isView) {
-            this->ptr = ptr;
-        } else {
-            this->ptr = new char[this->nBytes];
-            std::memcpy(this->ptr, ptr, this->nBytes);
-        }
-    }
-
-    NdArray(const NdArray &other): shape(std::move(other.shape)), dataType(other.dataType), placement(other.placement),
-                              isView(other.isView), name(other.name), nBytes(other.nBytes) {
-        if(other.isView) {
-            this->ptr = other.ptr;
-        }
-        else {
-            this->ptr = new char[this->nBytes];
-            std::memcpy(this->ptr, other.ptr, this->nBytes);
+    /**
+     * Creates a view of the data under the given address, with the given strides.
+     */
+    NdArray(void *ptr, Shape shape, Strides strides, DataType dataType, const devices::DeviceId &placement) :
+        ptr(ptr), shape(std::move(shape)), strides(std::move(strides)), dataType(dataType), placement(placement) {
+        if(this->shape.size() != this->strides.size()) {
+            throw ::arrus::IllegalArgumentException("Array shape and strides should have the same length.");
         }
     }
 
-    NdArray(NdArray &&other): ptr(other.ptr), shape(std::move(other.shape)), dataType(other.dataType),
-                              placement(other.placement), isView(other.isView), name(other.name), nBytes(other.nBytes) {
-        other.ptr = nullptr;
-        other.nBytes = 0;
-    }
-
-    NdArray& operator=(NdArray&& rhs) noexcept {
-        if(this == &rhs) {
-            return *this;
-        }
-        this->shape = rhs.shape;
-        this->dataType = rhs.dataType;
-        this->placement = rhs.placement;
-        this->name = rhs.name;
-
-        if(!this->isView) {
-            delete (char*)this->ptr;
-            this->nBytes = 0;
+    /**
+     * Creates a view of the C-contiguous data under the given address (isView == true) or a new array with
+     * the copy of that data (isView == false).
+     */
+    NdArray(void *ptr, Shape shape, DataType dataType, const devices::DeviceId &placement, std::string name, bool isView):
+        NdArray(ptr, std::move(shape), dataType, placement) {
+        this->name = std::move(name);
+        if(!isView) {
+            *this = copy();
         }
-        this->ptr = rhs.ptr;
-        this->nBytes = rhs.nBytes;
-        this->isView = rhs.isView;
-        rhs.ptr = nullptr;
-        rhs.nBytes = 0;
-
-        return *this;
     }
 
-    NdArray& operator=(const NdArray& rhs) noexcept {
-        if(this == &rhs) {
-            return *this;
-        }
-        this->shape = rhs.shape;
-        this->dataType = rhs.dataType;
-        this->placement = rhs.placement;
-        this->name = rhs.name;
-
-        if(!this->isView) {
-            delete (char*)this->ptr;
-            this->nBytes = 0;
-        }
-        if(!rhs.isView) {
-            this->nBytes = rhs.nBytes;
-            this->ptr = new char[this->nBytes];
-            std::memcpy(this->ptr, rhs.ptr, this->nBytes);
-        }
-        else {
-            this->nBytes = rhs.nBytes;
-            this->ptr = rhs.ptr;
-        }
-        this->isView = rhs.isView;
-
-        return *this;
-    }
+    NdArray(const NdArray &other) = default;
+    NdArray(NdArray &&other) noexcept = default;
+    NdArray& operator=(const NdArray& rhs) = default;
+    NdArray& operator=(NdArray&& rhs) noexcept = default;
 
+    virtual ~NdArray() = default;
 
     NdArray zerosLike() const {
         NdArray array(this->shape, this->dataType, this->placement, this->name);
         return array;
     }
 
-    // TODO implement - copy, move constructors
-
-    virtual ~NdArray() {
-        if(!isView && this->ptr != nullptr && this->nBytes > 0) {
-            // NOTE: migration to new framework API: the non-view ndarrays will have the char* ptr property.
-            delete[] (char*)ptr;
+    /**
+     * Returns a new C-contiguous array with the copy of this array's data.
+     * Currently only arrays located in the host memory can be copied.
+     */
+    NdArray copy() const {
+        NdArray result = zerosLike();
+        if(getNumberOfElements() == 0) {
+            return result;
         }
+        if(isContiguous()) {
+            std::memcpy(result.ptr, this->ptr, getNumberOfBytes());
+            return result;
+        }
+        const size_t elementSize = getDataTypeSize(this->dataType);
+        char *dst = (char*)result.ptr;
+        forEachOffset([&](size_t offset) {
+            std::memcpy(dst, (const char*)this->ptr + offset*elementSize, elementSize);
+            dst += elementSize;
+        });
+        return result;
     }
 
     /**
-    * Returns a pointer to data.
+    * Returns a pointer to data (the first element of the array).
     *
     * @tparam T data type
     * @return a pointer to data
@@ -162,7 +168,7 @@ public:
     }
 
     /**
-    * Returns a pointer to data.
+    * Returns a pointer to data (the first element of the array).
     *
     * @tparam T data type
     * @return a pointer to data
@@ -174,46 +180,26 @@ public:
 
     template<typename T>
     T get(size_t row, size_t column) const {
-        if(this->shape.size() != 2) {
-            throw ::arrus::IllegalArgumentException("The array is expected to be 2D.");
-        }
-        size_t height = this->shape[0];
-        size_t width = this->shape[1];
-        if(row >= height || column >= width) {
-            throw ::arrus::IllegalArgumentException(
-                "Accessing arrays out of bounds, "
-                "dimensions: " + std::to_string(height) + ", " + std::to_string(height) +
-                "indices: " + std::to_string(row) + ", " + std::to_string(column));
-        }
-        T* dst = (T*)ptr + (row*width + column);
-        return *dst;
+        return *((T*)ptr + getOffset2D(row, column));
     }
 
     template<typename T>
     void set(size_t row, size_t column, T value) {
-        if(this->shape.size() != 2) {
-            throw ::arrus::IllegalArgumentException("The array is expected to be 2D.");
-        }
-        size_t height = this->shape[0];
-        size_t width = this-> shape[1];
-        if(row >= height || column >= width) {
-            throw ::arrus::IllegalArgumentException(
-                "Accessing arrays out of bounds, "
-                "dimensions: " + std::to_string(height) + ", " + std::to_string(height) +
-                    "indices: " + std::to_string(row) + ", " + std::to_string(column));
-        }
-        T* dst = (T*)ptr + (row*width + column);
-        *dst = value;
+        *((T*)ptr + getOffset2D(row, column)) = value;
     }
 
-
+    /**
+     * Sets the i-th element of the array (in the C-order, regardless of the strides).
+     */
     template<typename T>
     void set(size_t i, T value) {
-        if(!this->isView) {
-            throw ::arrus::IllegalArgumentException("The NdArray value setter can be used only for non-view NdArrays.");
+        size_t nElements = getNumberOfElements();
+        if(i >= nElements) {
+            throw ::arrus::IllegalArgumentException(
+                "Accessing array out of bounds, number of elements: " + std::to_string(nElements)
+                + ", index: " + std::to_string(i));
         }
-        T* dst = (char*)ptr + i*sizeof(T);
-        *dst = value;
+        *((T*)ptr + getOffset(i)) = value;
     }
 
     /**
@@ -231,10 +217,24 @@ public:
         return shape;
     }
 
+    /**
+     * Returns data strides (the number of elements between consecutive values along each axis).
+     */
+    const Strides &getStrides() const {
+        return strides;
+    }
+
     size_t getNumberOfElements() const {
         return shape.product();
     }
 
+    /**
+     * Returns the number of bytes the array elements occupy (assuming the data is C-contiguous).
+     */
+    size_t getNumberOfBytes() const {
+        return getNumberOfElements()*getDataTypeSize(dataType);
+    }
+
     /**
      * Returns array data type.
      */
@@ -242,20 +242,113 @@ public:
         return dataType;
     }
 
+    /**
+     * Returns true if the array data is C-contiguous (i.e. the strides are the default strides for the array shape).
+     */
+    bool isContiguous() const {
+        size_t expected = 1;
+        for(size_t i = shape.size(); i > 0; --i) {
+            if(shape[i-1] != 1 && strides[i-1] != expected) {
+                return false;
+            }
+            expected *= shape[i-1];
+        }
+        return true;
+    }
+
+    /**
+     * Returns true if this array owns (shares the ownership of) its data.
+     */
+    bool isOwner() const {
+        return storage != nullptr;
+    }
+
     NdArray view() const {
-        return NdArray{ptr, shape, dataType, placement};
+        return *this;
+    }
+
+    /**
+     * Returns a view of the range [begin, end) along the given axis (end == -1 means the end of the axis).
+     */
+    NdArray slice(size_t axis, int begin, int end) const {
+        if(axis >= shape.size()) {
+            throw ::arrus::IllegalArgumentException(
+                "Slice axis " + std::to_string(axis) + " out of range for array with "
+                + std::to_string(shape.size()) + " dimensions.");
+        }
+        std::vector<Slice> slices(axis+1);
+        slices[axis] = Slice{begin, end, 1};
+        return slice(slices);
     }
 
-    NdArray slice(size_t i, int begin, int end) {
-        size_t multiplier = 1;
-        for(size_t j = shape.size()-1; j > i; --j) {
-            multiplier *= shape[j];
+    /**
+     * Returns a view of the array, sliced along the subsequent axes; the i-th slice applies to the i-th axis.
+     * The axes without the slice are not modified.
+     */
+    NdArray slice(const std::vector<Slice> &slices) const {
+        if(slices.size() > shape.size()) {
+            throw ::arrus::IllegalArgumentException(
+                "Too many slices (" + std::to_string(slices.size()) + ") for array with "
+                + std::to_string(shape.size()) + " dimensions.");
         }
-        if(end == -1) {
-            end = (int)shape[i];
+        std::vector<size_t> newShape = shape.getValues();
+        std::vector<size_t> newStrides = strides.getValues();
+        size_t offset = 0;
+        for(size_t axis = 0; axis < slices.size(); ++axis) {
+            const Slice &s = slices[axis];
+            const auto size = (long long)shape[axis];
+            long long begin = s.begin < 0 ? size + s.begin : s.begin;
+            long long end = s.end == -1 ? size : (s.end < 0 ? size + s.end : s.end);
+            if(begin < 0 || end > size || begin > end || s.step == 0) {
+                throw ::arrus::IllegalArgumentException(
+                    "Invalid slice [" + std::to_string(s.begin) + ", " + std::to_string(s.end) + ") with step "
+                    + std::to_string(s.step) + " for axis " + std::to_string(axis) + " of size "
+                    + std::to_string(size));
+            }
+            offset += (size_t)begin*strides[axis];
+            newShape[axis] = ((size_t)(end-begin) + s.step - 1)/s.step;
+            newStrides[axis] = strides[axis]*s.step;
         }
-        Shape newShape = shape.set(i, end-begin);
-        return NdArray{((int16_t*)ptr) + multiplier*begin, newShape, dataType, placement};
+        NdArray result = *this;
+        result.ptr = (char*)ptr + offset*getDataTypeSize(dataType);
+        result.shape = Shape{newShape};
+        result.strides = Strides{newStrides};
+        return result;
+    }
+
+    /**
+     * Returns a view of the array with the axes permuted: the i-th axis of the result is the axes[i] axis of
+     * this array.
+     */
+    NdArray transpose(const std::vector<size_t> &axes) const {
+        if(axes.size() != shape.size()) {
+            throw ::arrus::IllegalArgumentException("Transpose axes should be a permutation of the array axes.");
+        }
+        std::vector<size_t> newShape(axes.size()), newStrides(axes.size());
+        std::vector<bool> used(axes.size(), false);
+        for(size_t i = 0; i < axes.size(); ++i) {
+            if(axes[i] >= axes.size() || used[axes[i]]) {
+                throw ::arrus::IllegalArgumentException("Transpose axes should be a permutation of the array axes.");
+            }
+            used[axes[i]] = true;
+            newShape[i] = shape[axes[i]];
+            newStrides[i] = strides[axes[i]];
+        }
+        NdArray result = *this;
+        result.shape = Shape{newShape};
+        result.strides = Strides{newStrides};
+        return result;
+    }
+
+    /**
+     * Returns a view of the array with the reversed order of axes.
+     */
+    NdArray transpose() const {
+        std::vector<size_t> axes(shape.size());
+        for(size_t i = 0; i < axes.size(); ++i) {
+            axes[i] = axes.size()-1-i;
+        }
+        return transpose(axes);
     }
 
     const devices::DeviceId &getPlacement() const { return placement; }
@@ -276,14 +369,72 @@ public:
 	return ss.str();
     }
 
+    static Strides getContiguousStrides(const Shape &shape) {
+        std::vector<size_t> result(shape.size());
+        size_t stride = 1;
+        for(size_t i = shape.size(); i > 0; --i) {
+            result[i-1] = stride;
+            stride *= shape[i-1];
+        }
+        return Strides{result};
+    }
+
 private:
+    size_t getOffset2D(size_t row, size_t column) const {
+        if(this->shape.size() != 2) {
+            throw ::arrus::IllegalArgumentException("The array is expected to be 2D.");
+        }
+        size_t height = this->shape[0];
+        size_t width = this->shape[1];
+        if(row >= height || column >= width) {
+            throw ::arrus::IllegalArgumentException(
+                "Accessing arrays out of bounds, "
+                "dimensions: " + std::to_string(height) + ", " + std::to_string(width) +
+                ", indices: " + std::to_string(row) + ", " + std::to_string(column));
+        }
+        return row*strides[0] + column*strides[1];
+    }
+
+    /** Returns the offset (in elements) of the i-th element (in the C-order). */
+    size_t getOffset(size_t i) const {
+        size_t offset = 0;
+        for(size_t axis = shape.size(); axis > 0; --axis) {
+            offset += (i % shape[axis-1])*strides[axis-1];
+            i /= shape[axis-1];
+        }
+        return offset;
+    }
+
+    /** Calls func(offset) for the offsets (in elements) of all the array elements, in the C-order. */
+    template<typename F>
+    void forEachOffset(F &&func) const {
+        const size_t nDims = shape.size();
+        std::vector<size_t> index(nDims, 0);
+        size_t nElements = getNumberOfElements();
+        size_t offset = 0;
+        for(size_t i = 0; i < nElements; ++i) {
+            func(offset);
+            // Increment the multi-index (the last axis first).
+            for(size_t axis = nDims; axis > 0; --axis) {
+                offset += strides[axis-1];
+                if(++index[axis-1] < shape[axis-1]) {
+                    break;
+                }
+                offset -= strides[axis-1]*shape[axis-1];
+                index[axis-1] = 0;
+            }
+        }
+    }
+
+    /** Pointer to the first element of the array. */
     void *ptr;
+    /** The memory owned by this array (nullptr for views of the external memory). */
+    std::shared_ptr<char> storage;
     Shape shape;
+    Strides strides;
     DataType dataType;
     ::arrus::devices::DeviceId placement;
-    bool isView;
     std::string name{};
-    size_t nBytes;
 };
 
 }
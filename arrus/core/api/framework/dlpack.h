@@ -0,0 +1,44 @@
+#ifndef ARRUS_CORE_API_FRAMEWORK_DLPACK_H
+#define ARRUS_CORE_API_FRAMEWORK_DLPACK_H
+
+#include "arrus/core/api/common/macros.h"
+#include "arrus/core/api/framework/Buffer.h"
+#include "arrus/core/api/framework/NdArray.h"
+#include "arrus/core/api/framework/dlpack/dlpack.h"
+
+namespace arrus::framework {
+
+/**
+ * Exports the given array as a DLPack tensor (no data is copied).
+ *
+ * The returned tensor keeps a copy of the array, so the data of an array that owns its memory stays valid until
+ * the tensor deleter is called. For a view of an externally managed memory (e.g. buffer element data), the caller
+ * is responsible for keeping that memory valid.
+ *
+ * COMPLEX_INT16 arrays are exported as int16 arrays with an additional last axis of size 2 (real, imaginary).
+ * Arrays placed on CPU are exported as kDLCPU tensors, arrays placed on GPU:n as kDLCUDA tensors on device n.
+ *
+ * @param array array to export
+ * @return a new DLPack tensor; the consumer is responsible for calling its deleter
+ * @throws IllegalArgumentException when the array placement is not supported
+ */
+ARRUS_CPP_EXPORT
+DLManagedTensor *toDLPack(const NdArray &array);
+
+/**
+ * Exports the data of the given buffer element as a DLPack tensor (no data is copied, the tensor points directly
+ * to the buffer element memory).
+ *
+ * The returned tensor keeps a reference to the element; the tensor deleter releases the element (see
+ * BufferElement::release), i.e. the element memory can be overwritten by new data only after the consumer
+ * is done with the tensor. The element should not be released in any other way in the meantime.
+ *
+ * @param element buffer element to export
+ * @return a new DLPack tensor; the consumer is responsible for calling its deleter
+ */
+ARRUS_CPP_EXPORT
+DLManagedTensor *toDLPack(const BufferElement::SharedHandle &element);
+
+}// namespace arrus::framework
+
+#endif//ARRUS_CORE_API_FRAMEWORK_DLPACK_H
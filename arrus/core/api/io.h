@@ -2,5 +2,6 @@
 #define ARRUS_CORE_API_IO_H
 
 #include "arrus/core/api/io/settings.h"
+#include "arrus/core/api/io/RfRecorder.h"
 
 #endif //ARRUS_CORE_API_IO_H
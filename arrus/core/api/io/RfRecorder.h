@@ -0,0 +1,109 @@
+#ifndef ARRUS_CORE_API_IO_RFRECORDER_H
+#define ARRUS_CORE_API_IO_RFRECORDER_H
+
+#include <memory>
+#include <string>
+
+#include "arrus/core/api/common/macros.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/framework/NdArray.h"
+
+namespace arrus::io {
+
+/**
+ * Lossless, multi-threaded recorder of the int16 RF data (e.g. the consecutive buffer elements).
+ *
+ * Each recorded frame (buffer element) is split into chunks of consecutive values, which are encoded independently
+ * (in parallel). Within a chunk, each value is predicted from the previous samples of the same channel
+ * (the value located sampleStride values earlier): the encoder selects, for each block of 64 values, the best of:
+ * no prediction, delta (first-order) or linear (second-order) prediction. The residuals are zigzag-encoded and
+ * bit-packed with the minimum bit width required by the block, so the upper bits of the low-amplitude signals
+ * are not stored. In the worst case (white noise over the full int16 range) the output is ~1% larger
+ * than the raw data.
+ *
+ * The sample stride should correspond to the layout of the recorded data:
+ * - raw us4R buffer elements (shape (nSamples, 32), channels next to each other): 32,
+ * - File device layout (shape (1, nTx, nRx, nSamples, nComponents)): nComponents (1 for RF, 2 for I/Q data).
+ *
+ * The recordings can be replayed with the File device (the file is detected automatically) or read with
+ * readRfRecording.
+ */
+class ARRUS_CPP_EXPORT RfRecorder {
+    class Impl;
+    std::unique_ptr<Impl> impl;
+
+public:
+    /**
+     * Creates a new recording (an existing file is overwritten).
+     *
+     * @param filepath path to the output file
+     * @param sampleStride the distance (the number of int16 values) between two consecutive samples
+     *   of the same channel
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    RfRecorder(const std::string &filepath, size_t sampleStride, unsigned nThreads = 0);
+
+    RfRecorder(const RfRecorder &o) = delete;
+    RfRecorder(RfRecorder &&o) noexcept;
+    virtual ~RfRecorder();
+    RfRecorder &operator=(const RfRecorder &o) = delete;
+    RfRecorder &operator=(RfRecorder &&o) noexcept;
+
+    /**
+     * Encodes and appends a single frame to the recording. The function returns after the frame
+     * is written, i.e. the input data can be released (e.g. the buffer element) just after this call.
+     *
+     * All the frames of a single recording should have the same number of values.
+     *
+     * @param data frame values
+     * @param size the number of values
+     */
+    void write(const int16 *data, size_t size);
+
+    /**
+     * Encodes and appends a single frame to the recording; the shape of the first frame is stored
+     * in the recording.
+     *
+     * @param data contiguous int16 array (e.g. the buffer element data)
+     */
+    void write(const framework::NdArray &data);
+
+    /**
+     * Flushes and closes the recording. Called automatically by the destructor.
+     */
+    void close();
+
+    size_t getNumberOfFrames() const;
+
+    /**
+     * Returns the total size of the recorded (raw) data, the number of bytes.
+     */
+    size_t getNumberOfRawBytes() const;
+
+    /**
+     * Returns the total size of the encoded data written to the file, the number of bytes.
+     */
+    size_t getNumberOfEncodedBytes() const;
+};
+
+/**
+ * Returns true if the given file is a recording created by RfRecorder.
+ */
+ARRUS_CPP_EXPORT
+bool isRfRecording(const std::string &filepath);
+
+/**
+ * Reads and decodes all frames of the given recording (see RfRecorder).
+ *
+ * @param filepath path to the recording
+ * @param nThreads number of threads to use; 0 means the number of hardware threads
+ * @return int16 array of shape (nFrames, frame shape...)
+ * @throws ArrusException when the file is not a valid recording
+ */
+ARRUS_CPP_EXPORT
+framework::NdArray readRfRecording(const std::string &filepath, unsigned nThreads = 0);
+
+}// namespace arrus::io
+
+#endif//ARRUS_CORE_API_IO_RFRECORDER_H
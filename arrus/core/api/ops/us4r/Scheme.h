@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "DigitalDownConversion.h"
+#include "TransferRoi.h"
 #include "TxRxSequence.h"
 #include "arrus/core/api/framework/DataBufferSpec.h"
 
@@ -101,6 +102,18 @@ public:
 
     const std::vector<arrus::framework::NdArray> &getConstants() const { return constants; }
 
+    /**
+     * Returns a copy of this scheme, which transfers to the host only the given ROI of the acquired data
+     * (see TransferRoi).
+     */
+    Scheme withTransferRoi(TransferRoi roi) const {
+        Scheme result(*this);
+        result.transferRoi = std::move(roi);
+        return result;
+    }
+
+    const std::optional<TransferRoi> &getTransferRoi() const { return transferRoi; }
+
 private:
     TxRxSequence txRxSequence;
     uint16 rxBufferSize;
@@ -108,6 +121,7 @@ private:
     WorkMode workMode;
     std::optional<DigitalDownConversion> ddc;
     std::vector<arrus::framework::NdArray> constants;
+    std::optional<TransferRoi> transferRoi;
 };
 
 }// namespace arrus::ops::us4r
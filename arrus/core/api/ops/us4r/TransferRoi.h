@@ -0,0 +1,55 @@
+#ifndef ARRUS_CORE_API_OPS_US4R_TRANSFERROI_H
+#define ARRUS_CORE_API_OPS_US4R_TRANSFERROI_H
+
+#include <optional>
+#include <utility>
+
+#include "arrus/core/api/common/types.h"
+
+namespace arrus::ops::us4r {
+
+/**
+ * Transfer region of interest: the part of the acquired data, that should be transferred from the us4OEM memory
+ * to the host buffer.
+ *
+ * The ROI does not change the data acquisition: each TX/RX still acquires its whole rx sample range to the us4OEM
+ * memory. Only the data transfers to the host are limited to the ROI, so the host buffer elements are smaller
+ * (and less data is transferred over PCIe).
+ *
+ * The frame metadata is available only if the ROI starts at the first sample. The transfer ROI cannot be used
+ * together with sub-sequences (Us4R::setSubsequence) and metadata-only RX NOPs (Us4R::setRxNopsMetadataOnly).
+ */
+class TransferRoi {
+public:
+    /**
+     * Transfer ROI constructor: transfer the given range of samples of each TX/RX.
+     *
+     * @param sampleRange [start, end) range of samples to transfer, relative to the first sample acquired
+     *  by a given RX (i.e. 0 means the Rx sampleRange start); each RX should acquire at least `end` samples
+     */
+    explicit TransferRoi(std::pair<unsigned, unsigned> sampleRange)
+        : sampleRange(std::move(sampleRange)), frameRange(std::nullopt) {}
+
+    /**
+     * Transfer ROI constructor: transfer the given range of samples of the given range of TX/RXs.
+     *
+     * @param sampleRange [start, end) range of samples to transfer, relative to the first sample acquired
+     *  by a given RX (i.e. 0 means the Rx sampleRange start); each RX should acquire at least `end` samples
+     * @param frameRange [start, end] range of TX/RXs (frames) to transfer (note: end is inclusive, the same as
+     *  for Us4R::setSubsequence)
+     */
+    TransferRoi(std::pair<unsigned, unsigned> sampleRange, std::pair<uint16, uint16> frameRange)
+        : sampleRange(std::move(sampleRange)), frameRange(std::move(frameRange)) {}
+
+    const std::pair<unsigned, unsigned> &getSampleRange() const { return sampleRange; }
+
+    const std::optional<std::pair<uint16, uint16>> &getFrameRange() const { return frameRange; }
+
+private:
+    std::pair<unsigned, unsigned> sampleRange;
+    std::optional<std::pair<uint16, uint16>> frameRange;
+};
+
+}// namespace arrus::ops::us4r
+
+#endif//ARRUS_CORE_API_OPS_US4R_TRANSFERROI_H
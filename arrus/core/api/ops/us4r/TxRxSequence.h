@@ -59,12 +59,17 @@ public:
      * @param tgcCurve tgc curve to apply
      * @param sri sequence repetition interval - the total time that a given sequence should take.
      * @param nRepeats - the number of repetitions of a given sequence. Determines the size of the batch
+     * @param autoPriMargin - when provided, the PRI of each tx/rx is set to the minimum value accepted by the system
+     *   (determined by the rx sample range, decimation and sequencer reprogramming mode), increased by the
+     *   given margin [s]; the PRIs of the tx/rxs are ignored in that case
      */
-    TxRxSequence(std::vector<TxRx> sequence, TGCCurve tgcCurve, float sri = NO_SRI, int16 nRepeats = 1)
-        : txrxs(std::move(sequence)), tgcCurve(std::move(tgcCurve)), sri(sri), nRepeats(nRepeats) {}
+    TxRxSequence(std::vector<TxRx> sequence, TGCCurve tgcCurve, float sri = NO_SRI, int16 nRepeats = 1,
+                 std::optional<float> autoPriMargin = std::nullopt)
+        : txrxs(std::move(sequence)), tgcCurve(std::move(tgcCurve)), sri(sri), nRepeats(nRepeats),
+          autoPriMargin(autoPriMargin) {}
 
     TxRxSequence copy(std::vector<TxRx> ops) {
-        return TxRxSequence(std::move(ops), this->tgcCurve, this->sri.value(), this->nRepeats);
+        return TxRxSequence(std::move(ops), this->tgcCurve, this->sri.value(), this->nRepeats, this->autoPriMargin);
     }
 
     /**
@@ -98,11 +103,20 @@ public:
         return nRepeats;
     }
 
+    /**
+     * Returns the margin [s] that should be added to the minimum PRI of each tx/rx.
+     * nullopt means that the PRIs provided in the tx/rxs should be used.
+     */
+    const std::optional<float> &getAutoPriMargin() const {
+        return autoPriMargin;
+    }
+
 private:
     std::vector<TxRx> txrxs;
     TGCCurve tgcCurve;
     std::optional<float> sri;
     int16 nRepeats;
+    std::optional<float> autoPriMargin;
 };
 
 }
@@ -0,0 +1,9 @@
+#ifndef ARRUS_CORE_API_PROCESSING_H
+#define ARRUS_CORE_API_PROCESSING_H
+
+#include "arrus/core/api/processing/ColorDoppler.h"
+#include "arrus/core/api/processing/ProbeElementFeatureExtractor.h"
+#include "arrus/core/api/processing/SvdClutterFilter.h"
+#include "arrus/core/api/processing/VolumeReconstruction.h"
+
+#endif //ARRUS_CORE_API_PROCESSING_H
@@ -0,0 +1,70 @@
+#ifndef ARRUS_CORE_API_PROCESSING_COLORDOPPLER_H
+#define ARRUS_CORE_API_PROCESSING_COLORDOPPLER_H
+
+#include <vector>
+
+#include "arrus/core/api/common.h"
+
+namespace arrus::processing {
+
+/**
+ * Color/power Doppler estimation on CPU: wall clutter filtering followed by the lag-1 autocorrelation (Kasai)
+ * estimator.
+ *
+ * The wall filter is an IIR filter (b, a) applied along the ensemble (repetition) dimension of each pixel,
+ * with an arbitrary order. The initial state of the filter is equal initialState*(the first ensemble sample),
+ * the first nRejected filter outputs are dropped (filter transient). For a FIR filter, provide a = {1}.
+ *
+ * For each pixel, the following values are computed from the filtered ensemble y[n], n = 0, ..., N-1:
+ * - color: the mean phase shift between subsequent samples: arg(R1) [rad/PRI],
+ * - power: the mean power P/N,
+ * - turbulence: 1 - |R1|/P * N/(N-1),
+ * where P = sum(|y[n]|^2), R1 = sum(y[n]*conj(y[n-1])).
+ *
+ * The wall filter, power and autocorrelation are computed in a single pass over the data. Pixels are processed in
+ * blocks: the whole ensemble of a block is processed at once (the ensemble is the inner loop of each block), so the
+ * filter state and accumulators of a block stay in the L1 cache. Blocks are distributed over the given number of
+ * threads.
+ */
+class ARRUS_CPP_EXPORT ColorDoppler {
+    class Impl;
+    UniqueHandle<Impl> impl;
+
+public:
+    /**
+     * @param b wall filter numerator coefficients
+     * @param a wall filter denominator coefficients (a[0] should be non-zero)
+     * @param initialState wall filter initial state coefficients; should be empty (zero initial state) or
+     *   have max(size(a), size(b))-1 elements
+     * @param nRejected the number of initial wall filter output samples to reject
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    ColorDoppler(Span<float> b, Span<float> a, Span<float> initialState, unsigned nRejected, unsigned nThreads = 0);
+
+    ColorDoppler(const std::vector<float> &b, const std::vector<float> &a, const std::vector<float> &initialState,
+                 unsigned nRejected, unsigned nThreads = 0)
+        : ColorDoppler(Span<float>{b}, Span<float>{a}, Span<float>{initialState}, nRejected, nThreads) {}
+
+    ColorDoppler(const ColorDoppler &o);
+    ColorDoppler(ColorDoppler &&o) noexcept;
+    virtual ~ColorDoppler();
+    ColorDoppler &operator=(const ColorDoppler &o);
+    ColorDoppler &operator=(ColorDoppler &&o) noexcept;
+
+    /**
+     * Computes color, power and turbulence maps for the given ensemble of IQ images.
+     *
+     * @param iq IQ data: complex64 values (interleaved real and imaginary parts), shape (nRepetitions, nPixels)
+     * @param nRepetitions ensemble length (should be greater than nRejected + 1)
+     * @param nPixels number of pixels of a single image
+     * @param color output color map (nPixels values)
+     * @param power output power map (nPixels values)
+     * @param turbulence output turbulence map (nPixels values)
+     */
+    void process(const float32 *iq, size_t nRepetitions, size_t nPixels, float32 *color, float32 *power,
+                 float32 *turbulence) const;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_API_PROCESSING_COLORDOPPLER_H
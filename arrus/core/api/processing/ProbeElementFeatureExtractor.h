@@ -0,0 +1,86 @@
+#ifndef ARRUS_CORE_API_PROCESSING_PROBEELEMENTFEATUREEXTRACTOR_H
+#define ARRUS_CORE_API_PROCESSING_PROBEELEMENTFEATUREEXTRACTOR_H
+
+#include "arrus/core/api/common.h"
+
+namespace arrus::processing {
+
+/**
+ * Probe element health check features, computed from the RF data acquired by the probe check sequence
+ * (each TX is a short excitation of a single element, see arrus.utils.probe_check).
+ *
+ * The input RF data should have shape (nFrames, nTx, nSamples, nRx) (e.g. the us4R output buffer data
+ * after remapping to the logical order), the element excited by a given TX is received by the middle RX channel
+ * (ceil(nRx/2)-1). The first nSkippedSamples of each RX are not taken into account.
+ *
+ * The signals are high-pass filtered with a Butterworth filter applied forward and backward (zero-phase), with the
+ * odd extension of the signal at both ends and the steady-state initial conditions (as scipy.signal.sosfiltfilt does).
+ *
+ * All features are computed in double precision, TXs (probe elements) are distributed over the given number of
+ * threads. Each method writes nTx values (one per element) to the output array.
+ */
+class ARRUS_CPP_EXPORT ProbeElementFeatureExtractor {
+    class Impl;
+    UniqueHandle<Impl> impl;
+
+public:
+    static constexpr unsigned DEFAULT_N_SKIPPED_SAMPLES = 80;
+    static constexpr unsigned DEFAULT_FILTER_ORDER = 4;
+
+    /**
+     * @param nFrames number of frames (repetitions of the sequence)
+     * @param nTx number of transmissions (tested elements)
+     * @param nSamples number of samples of a single RX
+     * @param nRx number of RX channels
+     * @param samplingFrequency sampling frequency assumed by the high-pass filter [Hz]
+     * @param nSkippedSamples the number of initial samples to skip
+     * @param filterOrder order of the high-pass filter
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    ProbeElementFeatureExtractor(size_t nFrames, size_t nTx, size_t nSamples, size_t nRx,
+                                 float samplingFrequency = 65e6f,
+                                 unsigned nSkippedSamples = DEFAULT_N_SKIPPED_SAMPLES,
+                                 unsigned filterOrder = DEFAULT_FILTER_ORDER, unsigned nThreads = 0);
+
+    ProbeElementFeatureExtractor(const ProbeElementFeatureExtractor &o);
+    ProbeElementFeatureExtractor(ProbeElementFeatureExtractor &&o) noexcept;
+    virtual ~ProbeElementFeatureExtractor();
+    ProbeElementFeatureExtractor &operator=(const ProbeElementFeatureExtractor &o);
+    ProbeElementFeatureExtractor &operator=(ProbeElementFeatureExtractor &&o) noexcept;
+
+    /**
+     * Maximum amplitude: the median (over frames) of the maximum absolute value of the high-pass filtered signals
+     * of all RX channels.
+     */
+    void getMaxAmplitude(const int16 *rf, float cutoffFrequency, float32 *output) const;
+    void getMaxAmplitude(const float32 *rf, float cutoffFrequency, float32 *output) const;
+
+    /**
+     * Normalized signal energy: the mean (over frames) of sum((x-min(x))/(max(x)-min(x))), where x is
+     * the squared high-pass filtered signal of the middle RX channel.
+     */
+    void getEnergy(const int16 *rf, float cutoffFrequency, float32 *output) const;
+    void getEnergy(const float32 *rf, float cutoffFrequency, float32 *output) const;
+
+    /**
+     * Signal duration: the mean (over frames) of round(3*sigma) [samples], where sigma is the standard deviation of
+     * the gaussian curve fitted (least squares) to the envelope of the high-pass filtered signal of the middle
+     * RX channel.
+     */
+    void getSignalDuration(const int16 *rf, float cutoffFrequency, float32 *output) const;
+    void getSignalDuration(const float32 *rf, float cutoffFrequency, float32 *output) const;
+
+    /**
+     * Pearson correlation coefficient between the middle RX channel signals of the given RF data and
+     * the footprint (reference) RF data (the same shape), both averaged over frames and high-pass filtered,
+     * in the range [nSkippedSamples, nSkippedSamples+gateLength). NaN when any of the signals is constant.
+     */
+    void getFootprintPcc(const int16 *rf, const int16 *footprint, size_t gateLength, float cutoffFrequency,
+                         float32 *output) const;
+    void getFootprintPcc(const float32 *rf, const float32 *footprint, size_t gateLength, float cutoffFrequency,
+                         float32 *output) const;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_API_PROCESSING_PROBEELEMENTFEATUREEXTRACTOR_H
@@ -0,0 +1,92 @@
+#ifndef ARRUS_CORE_API_PROCESSING_SVDCLUTTERFILTER_H
+#define ARRUS_CORE_API_PROCESSING_SVDCLUTTERFILTER_H
+
+#include <vector>
+
+#include "arrus/core/api/common.h"
+
+namespace arrus::processing {
+
+/**
+ * Spatiotemporal (SVD) clutter filter for ultrafast Doppler imaging, CPU implementation.
+ *
+ * An ensemble of nFrames complex images is arranged into the Casorati matrix S (nPixels x nFrames, one column per
+ * frame). The filter removes the nTissueComponents largest and nNoiseComponents smallest singular components
+ * of S, i.e. returns S*Vk*Vk^H, where Vk are the right singular vectors of the remaining components.
+ *
+ * The right singular vectors are computed with the eigendecomposition of the Gram matrix S^H*S (nFrames x nFrames),
+ * which is much cheaper than the SVD of S, as nPixels >> nFrames. The Gram matrix and the projection are computed
+ * in blocks of rows (pixels) distributed over the given number of threads; the Gram matrix is accumulated and
+ * decomposed in double precision.
+ *
+ * The ensemble can be provided at once (see process(iq, output)) or accumulated frame by frame (see push),
+ * directly into the preallocated Casorati matrix.
+ */
+class ARRUS_CPP_EXPORT SvdClutterFilter {
+    class Impl;
+    UniqueHandle<Impl> impl;
+
+public:
+    /**
+     * @param nFrames ensemble length (the number of frames)
+     * @param nPixels number of pixels of a single frame
+     * @param nTissueComponents the number of the largest singular components to remove (tissue clutter)
+     * @param nNoiseComponents the number of the smallest singular components to remove (noise)
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    SvdClutterFilter(size_t nFrames, size_t nPixels, unsigned nTissueComponents, unsigned nNoiseComponents = 0,
+                     unsigned nThreads = 0);
+
+    SvdClutterFilter(const SvdClutterFilter &o);
+    SvdClutterFilter(SvdClutterFilter &&o) noexcept;
+    virtual ~SvdClutterFilter();
+    SvdClutterFilter &operator=(const SvdClutterFilter &o);
+    SvdClutterFilter &operator=(SvdClutterFilter &&o) noexcept;
+
+    /**
+     * Appends the given frames to the currently accumulated ensemble.
+     *
+     * @param frames complex64 values (interleaved real and imaginary parts), shape (n, nPixels)
+     * @param n the number of frames
+     * @return the number of frames actually appended, i.e. min(n, the number of frames missing in the ensemble)
+     */
+    size_t push(const float32 *frames, size_t n);
+
+    /**
+     * Returns true if the ensemble of nFrames frames has been accumulated.
+     */
+    bool isReady() const;
+
+    /**
+     * Filters the accumulated ensemble and starts accumulating a new one.
+     *
+     * @param output output ensemble: complex64 values, shape (nFrames, nPixels)
+     */
+    void process(float32 *output);
+
+    /**
+     * Filters the given ensemble (the accumulated frames are not affected).
+     *
+     * @param iq input ensemble: complex64 values (interleaved real and imaginary parts), shape (nFrames, nPixels)
+     * @param output output ensemble: complex64 values, shape (nFrames, nPixels); can be the same as iq
+     */
+    void process(const float32 *iq, float32 *output);
+
+    /**
+     * Drops the accumulated frames.
+     */
+    void reset();
+
+    /**
+     * Returns the singular values of the last filtered ensemble, in descending order.
+     */
+    std::vector<float> getSingularValues() const;
+
+    size_t getNumberOfFrames() const;
+
+    size_t getNumberOfPixels() const;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_API_PROCESSING_SVDCLUTTERFILTER_H
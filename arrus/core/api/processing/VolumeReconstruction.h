@@ -0,0 +1,92 @@
+#ifndef ARRUS_CORE_API_PROCESSING_VOLUMERECONSTRUCTION_H
+#define ARRUS_CORE_API_PROCESSING_VOLUMERECONSTRUCTION_H
+
+#include <vector>
+
+#include "arrus/core/api/common.h"
+
+namespace arrus::processing {
+
+/**
+ * Parameters of the 3D (matrix array) low resolution image reconstruction.
+ *
+ * The tx* and rx* vectors describe subsequent transmissions (one value per TX/RX). All element indices are
+ * indices of the probe elements in the xElements/yElements arrays.
+ */
+struct VolumeReconstructionSettings {
+    /** Output grid [m]. */
+    std::vector<float> xGrid, yGrid, zGrid;
+    /** Positions of the probe elements (rows and columns of the matrix array) [m]. */
+    std::vector<float> xElements, yElements;
+    /** Speed of sound [m/s]. */
+    float speedOfSound{1540.0f};
+    /** Sampling frequency of the input IQ data [Hz]. */
+    float samplingFrequency{0.0f};
+    /** Center frequency of the transmitted signal, i.e. the frequency used for IQ demodulation [Hz]. */
+    float centerFrequency{0.0f};
+    /** The time between the first acquired sample and the moment when TX aperture center fires [s]. */
+    float initialDelay{0.0f};
+
+    /** TX focus depth [m]: inf means plane wave, negative values mean virtual point source behind the probe. */
+    std::vector<float> txFocus;
+    /** TX angles in the ZX and ZY planes [rad]. */
+    std::vector<float> txAngleZx, txAngleZy;
+    /** TX aperture center position [m]. */
+    std::vector<float> txApertureCenterX, txApertureCenterY;
+    /** TX aperture edges: the first and the last element. */
+    std::vector<unsigned short> txApertureFirstElementX, txApertureLastElementX;
+    std::vector<unsigned short> txApertureFirstElementY, txApertureLastElementY;
+    /** The first element (the top left corner) of the rectangular RX aperture. */
+    std::vector<unsigned short> rxApertureFirstElementX, rxApertureFirstElementY;
+
+    /** RX apodization angle limits, given as the tangent of the angle. */
+    float minRxTangZx{-0.5f}, maxRxTangZx{0.5f}, minRxTangZy{-0.5f}, maxRxTangZy{0.5f};
+    /** RX apodization window, sampled uniformly over [minRxTang, maxRxTang]. */
+    std::vector<float> rxApodization;
+};
+
+/**
+ * Delay-and-sum reconstruction of the low resolution volumes (one per transmission), compounded over all transmissions
+ * (CPU implementation of the iqRaw2Lri3D kernel).
+ *
+ * The voxel grid is divided into tiles and the RX aperture into blocks of elements, so that the delay tables of
+ * a single tile (TX delays per transmission, RX delays, phase shifts and apodization weights per element block) fit
+ * the L2 cache. The RX tables are computed once per tile and element block and reused for all transmissions. Voxels
+ * of a tile are processed with SIMD instructions (when available), tiles are distributed over the given number of
+ * threads.
+ */
+class ARRUS_CPP_EXPORT VolumeReconstruction {
+    class Impl;
+    UniqueHandle<Impl> impl;
+
+public:
+    /**
+     * @param settings reconstruction parameters
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    explicit VolumeReconstruction(const VolumeReconstructionSettings &settings, unsigned nThreads = 0);
+
+    VolumeReconstruction(const VolumeReconstruction &o);
+    VolumeReconstruction(VolumeReconstruction &&o) noexcept;
+    virtual ~VolumeReconstruction();
+    VolumeReconstruction &operator=(const VolumeReconstruction &o);
+    VolumeReconstruction &operator=(VolumeReconstruction &&o) noexcept;
+
+    /**
+     * Reconstructs the volumes.
+     *
+     * @param iq input IQ data: complex64 values (interleaved real and imaginary parts),
+     *   shape (nSequences, nTx, nRxY, nRxX, nSamples)
+     * @param nSequences number of sequences (batch size)
+     * @param nRxY number of RX aperture rows
+     * @param nRxX number of RX aperture columns
+     * @param nSamples number of samples
+     * @param output output volume: complex64 values, shape (nSequences, size(yGrid), size(xGrid), size(zGrid))
+     */
+    void process(const float32 *iq, size_t nSequences, size_t nRxY, size_t nRxX, size_t nSamples,
+                 float32 *output) const;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_API_PROCESSING_VOLUMERECONSTRUCTION_H
@@ -5,9 +5,11 @@
 #include "arrus/core/api/common/macros.h"
 #include "arrus/core/api/devices/Device.h"
 #include "arrus/core/api/devices/DeviceId.h"
+#include "arrus/core/api/devices/us4r/AcquisitionStatistics.h"
 #include "arrus/core/api/ops/us4r/Scheme.h"
 #include "arrus/core/api/ops/us4r/TxRxSequence.h"
 #include "arrus/core/api/session/SessionSettings.h"
+#include "arrus/core/api/session/UploadFuture.h"
 #include "arrus/core/api/session/UploadResult.h"
 
 namespace arrus::session {
@@ -50,7 +52,16 @@ public:
     /**
      * Uploads a given scheme on the available devices.
      *
-     * Currently, the scheme upload is performed on the Us4R:0 device only.
+     * For a session with a single us4R (or no us4R), the scheme upload is performed on the Ultrasound:0 device only.
+     * For a session with multiple us4Rs, the scheme is uploaded to all the us4Rs in parallel; the output buffer
+     * of the result is then a merged buffer: its i-th element contains the data of the i-th elements of all the
+     * us4Rs (in the order of devices), and is ready when all of them are ready. The elements of the merged buffer
+     * are framework::MergedBufferElement: the data of the consecutive us4Rs are available without copying
+     * (getPart), the concatenated copy of the data (getData) only when enabled with setMergedBufferConcatenation.
+     * The buffers of the consecutive us4Rs are available via UploadResult::getDeviceResult; the const metadata are
+     * the metadata of the Us4R:0.
+     * The us4Rs are expected to be driven by a common trigger: exactly one of them should be the master, the other
+     * ones should be configured with the external trigger (see Us4RSettings::isExternalTrigger).
      *
      * After uploading a new sequence the previously returned output buffers will be in invalid state.
      *
@@ -59,8 +70,47 @@ public:
      */
     virtual UploadResult upload(const ::arrus::ops::us4r::Scheme &scheme) = 0;
 
+    /**
+     * Uploads the given schemes at once, so it is possible to switch between them later without reprogramming
+     * the TX/RXs (see switchScheme).
+     *
+     * The TX/RXs of all schemes are programmed one after another in the device sequencer, and the data of each
+     * scheme is stored in a separate part of the device memory. The output buffer of each scheme is allocated,
+     * page-locked and its data transfers are registered here, so all schemes together cannot exceed the limit of
+     * the device data transfers. The first scheme is set as the current one.
+     *
+     * Each scheme has its own TX/RXs, SRI and output buffer. The remaining parameters apply to the whole sequence
+     * programmed in the device, so all schemes should have the same: rx buffer size, work mode, DDC, TGC curve,
+     * the number of repeats and the automatic PRI margin. Constants and transfer ROI are not supported.
+     *
+     * After uploading new schemes the previously returned output buffers will be in invalid state.
+     *
+     * @param schemes schemes to upload
+     * @return upload result of the first scheme
+     */
+    virtual UploadResult upload(const std::vector<::arrus::ops::us4r::Scheme> &schemes) = 0;
+
+    /**
+     * Uploads a given scheme asynchronously.
+     *
+     * The upload is performed in a separate thread. First, the scheme is validated and compiled on the host
+     * (the us4OEM sequences, frame channel mapping, TX delay profiles and the host buffer), without locking
+     * the session, so the currently uploaded scheme can still be run in the meantime. Then the upload waits until
+     * the session is stopped and programs the devices with the compiled scheme, i.e. only writes the device
+     * registers and registers the host buffer. The upload can be cancelled until the device programming has
+     * started; see UploadFuture for the upload stage and progress.
+     *
+     * After the device is programmed, the previously returned output buffers will be in invalid state.
+     *
+     * @param scheme scheme to upload
+     * @return a handle to the upload result
+     */
+    virtual UploadFuture::SharedHandle uploadAsync(const ::arrus::ops::us4r::Scheme &scheme) = 0;
+
     /**
      * Starts currently uploaded scheme.
+     *
+     * For multiple us4Rs, the devices waiting for the external trigger are started first, then the master(s).
      */
     virtual void startScheme() = 0;
 
@@ -112,6 +162,8 @@ public:
      * - the TX/RX sequence length is greater than the `end` value,
      * - the scheme is stopped.
      *
+     * The schemes uploaded with upload(const std::vector<Scheme>&) cannot be switched afterwards.
+     *
      * @param start the TX/RX number which should now be the first TX/RX
      * @param end the TX/RX number which should now be the last TX/RX
      * @param sri the new SRI to apply
@@ -119,6 +171,45 @@ public:
      */
     virtual UploadResult setSubsequence(uint16 start, uint16 end, std::optional<float> sri) = 0;
 
+    /**
+     * Sets the given scheme, uploaded with upload(const std::vector<Scheme>&), as the current one.
+     *
+     * Neither the TX/RXs nor the data transfers are reprogrammed: only the sequencer range and SRI are updated,
+     * and the output buffer of the selected scheme (the same one each time the scheme is selected) becomes
+     * the current one. The session should be stopped.
+     *
+     * @param scheme the number of the scheme to select, in the order provided to upload
+     * @return the new data buffer and metadata
+     */
+    virtual UploadResult switchScheme(size_t scheme) = 0;
+
+    /**
+     * Sets whether the elements of the merged output buffer of a session with multiple us4Rs (see upload) should
+     * provide the data of all the us4Rs concatenated (MergedBufferElement::getData). The data is then copied
+     * into the merged element (in a separate thread, not the data acquisition thread of the us4Rs).
+     * By default the concatenation is disabled. Applies to the subsequent uploads.
+     *
+     * @param enabled whether the concatenation should be enabled
+     */
+    virtual void setMergedBufferConcatenation(bool enabled) = 0;
+
+    /**
+     * Returns the acquisition statistics of the given us4R device, see Us4R::getAcquisitionStatistics.
+     * Each us4R of the session collects its own statistics.
+     *
+     * @param us4r the ordinal number of the us4R device
+     * @throws IllegalStateException when the session does not contain a us4R device
+     * @throws IllegalArgumentException when the session does not contain the given us4R device
+     */
+    virtual arrus::devices::AcquisitionStatistics getAcquisitionStatistics(arrus::devices::Ordinal us4r = 0) = 0;
+
+    /**
+     * Resets the acquisition statistics of all the us4R devices, see Us4R::resetAcquisitionStatistics.
+     *
+     * @throws IllegalStateException when the session does not contain a us4R device
+     */
+    virtual void resetAcquisitionStatistics() = 0;
+
     virtual ~Session() = default;
 
 };
@@ -0,0 +1,72 @@
+#ifndef ARRUS_CORE_API_SESSION_UPLOADFUTURE_H
+#define ARRUS_CORE_API_SESSION_UPLOADFUTURE_H
+
+#include <memory>
+#include <optional>
+
+#include "arrus/core/api/session/UploadResult.h"
+
+namespace arrus::session {
+
+/**
+ * A result of the asynchronous scheme upload (see Session::uploadAsync).
+ */
+class UploadFuture {
+public:
+    using SharedHandle = std::shared_ptr<UploadFuture>;
+
+    /**
+     * Upload stage.
+     *
+     * - COMPILING: the scheme is validated and compiled on the host (TX/RX aperture splitting, frame channel
+     *   mapping, delay tables); the session is not locked, i.e. the currently uploaded scheme can still be run,
+     * - WAITING_FOR_DEVICE: the scheme is compiled, the upload waits until the session is stopped,
+     * - PROGRAMMING: the device is programmed; the upload cannot be cancelled anymore,
+     * - DONE: the scheme was uploaded, the result is available,
+     * - FAILED: the upload failed, get() throws the upload exception,
+     * - CANCELLED: the upload was cancelled, the device was not programmed.
+     */
+    enum class Stage {
+        COMPILING, WAITING_FOR_DEVICE, PROGRAMMING, DONE, FAILED, CANCELLED
+    };
+
+    /**
+     * Waits until the upload is finished and returns its result.
+     *
+     * @return upload result information
+     * @throws IllegalStateException when the upload was cancelled; rethrows the upload exception on failure
+     */
+    virtual UploadResult get() = 0;
+
+    /**
+     * Waits until the upload is finished (done, failed or cancelled).
+     *
+     * @param timeout timeout [ms]; std::nullopt means to wait infinitely
+     * @return true if the upload is finished, false if the timeout has expired
+     */
+    virtual bool wait(std::optional<long long> timeout = std::nullopt) = 0;
+
+    /**
+     * Returns the current stage of the upload.
+     */
+    virtual Stage getStage() const = 0;
+
+    /**
+     * Returns the progress of the current stage (COMPILING or PROGRAMMING), a value in [0, 1].
+     * The progress is reset to 0 at the beginning of each stage.
+     */
+    virtual float getProgress() const = 0;
+
+    /**
+     * Cancels the upload. The upload can be cancelled only before the device programming has started.
+     *
+     * @return true if the upload was cancelled, false otherwise (e.g. the device is already being programmed)
+     */
+    virtual bool cancel() = 0;
+
+    virtual ~UploadFuture() = default;
+};
+
+}
+
+#endif //ARRUS_CORE_API_SESSION_UPLOADFUTURE_H
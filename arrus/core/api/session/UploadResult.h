@@ -1,6 +1,8 @@
 #ifndef ARRUS_ARRUS_CORE_API_SESSION_UPLOADRESULT_H
 #define ARRUS_ARRUS_CORE_API_SESSION_UPLOADRESULT_H
 
+#include <vector>
+
 #include "Metadata.h"
 #include "arrus/core/api/framework/Buffer.h"
 
@@ -19,6 +21,19 @@ public:
                  std::shared_ptr<Metadata> constMetadata)
         : buffer(std::move(buffer)), constMetadata(std::move(constMetadata)) {}
 
+    /**
+     * Upload result of a session driving several systems.
+     *
+     * @param buffer the merged output buffer of all the systems
+     * @param constMetadata metadata of the first system
+     * @param deviceResults the upload results of the consecutive systems
+     */
+    UploadResult(std::shared_ptr<::arrus::framework::Buffer> buffer,
+                 std::shared_ptr<Metadata> constMetadata,
+                 std::vector<UploadResult> deviceResults)
+        : buffer(std::move(buffer)), constMetadata(std::move(constMetadata)),
+          deviceResults(std::move(deviceResults)) {}
+
 	/**
 	 * Returns a pointer to the ouptput data buffer.
 	 */
@@ -34,9 +49,30 @@ public:
         return constMetadata;
     }
 
+    /**
+     * Returns the number of systems (ultrasound devices) the scheme was uploaded to.
+     */
+    size_t getNumberOfDevices() const {
+        return deviceResults.empty() ? 1 : deviceResults.size();
+    }
+
+    /**
+     * Returns the upload result of the i-th system, i.e. the output buffer of that system only.
+     * For a single system, this is the same as this result.
+     *
+     * Note: registering a callback directly on the buffer of a system detaches that system from the merged buffer.
+     */
+    const UploadResult &getDeviceResult(size_t i) const {
+        if (deviceResults.empty() && i == 0) {
+            return *this;
+        }
+        return deviceResults.at(i);
+    }
+
 private:
     ::arrus::framework::Buffer::SharedHandle buffer;
     Metadata::SharedHandle constMetadata;
+    std::vector<UploadResult> deviceResults;
 };
 
 }
@@ -0,0 +1,285 @@
+#include "arrus/core/common/tracing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "arrus/common/format.h"
+#include "arrus/core/api/common/exceptions.h"
+
+namespace arrus {
+
+namespace tracing {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+struct EventData {
+    const char *category;
+    const char *name;
+    char phase;
+    int64 timestamp;
+    int64 value;
+    uint32 tid;
+};
+
+/**
+ * A single ring buffer slot. The fields are written by the owner thread only, the seq number allows the reader
+ * to detect a slot that was overwritten while being read (seq == 2*i+2 means that the slot contains the i-th event
+ * of the thread, odd values mean that the write is in progress).
+ */
+struct Event {
+    std::atomic<uint64> seq{0};
+    std::atomic<const char *> category{nullptr};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<char> phase{0};
+    std::atomic<int64> timestamp{0};
+    std::atomic<int64> value{0};
+};
+
+/**
+ * Single-producer ring buffer of the given thread events.
+ */
+class ThreadBuffer {
+public:
+    explicit ThreadBuffer(uint32 tid) : tid(tid), events(std::make_unique<Event[]>(RING_BUFFER_SIZE)) {}
+
+    /**
+     * Prepares the buffer for a new thread. Should be called only when no thread writes to the buffer.
+     * The remaining slots are not visible, they were written before the new head.
+     */
+    void reset(uint32 newTid) {
+        tid = newTid;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    void push(const char *category, const char *name, char phase, int64 timestamp, int64 value) {
+        uint64 i = head.load(std::memory_order_relaxed);
+        Event &event = events[i % RING_BUFFER_SIZE];
+        event.seq.store(2 * i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        event.category.store(category, std::memory_order_relaxed);
+        event.name.store(name, std::memory_order_relaxed);
+        event.phase.store(phase, std::memory_order_relaxed);
+        event.timestamp.store(timestamp, std::memory_order_relaxed);
+        event.value.store(value, std::memory_order_relaxed);
+        event.seq.store(2 * i + 2, std::memory_order_release);
+        head.store(i + 1, std::memory_order_release);
+    }
+
+    void copyTo(std::vector<EventData> &output) const {
+        uint64 end = head.load(std::memory_order_acquire);
+        uint64 oldest = end > RING_BUFFER_SIZE ? end - RING_BUFFER_SIZE : 0;
+        uint64 begin = std::max(tail.load(std::memory_order_relaxed), oldest);
+        for (uint64 i = begin; i < end; ++i) {
+            const Event &event = events[i % RING_BUFFER_SIZE];
+            uint64 seq = event.seq.load(std::memory_order_acquire);
+            EventData data{event.category.load(std::memory_order_relaxed), event.name.load(std::memory_order_relaxed),
+                           event.phase.load(std::memory_order_relaxed),
+                           event.timestamp.load(std::memory_order_relaxed),
+                           event.value.load(std::memory_order_relaxed), tid};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq == 2 * i + 2 && event.seq.load(std::memory_order_relaxed) == seq) {
+                output.push_back(data);
+            }
+            // Otherwise the slot was overwritten by a newer event in the meantime.
+        }
+    }
+
+    void clear() { tail.store(head.load(std::memory_order_acquire), std::memory_order_relaxed); }
+
+private:
+    uint32 tid;
+    std::unique_ptr<Event[]> events;
+    std::atomic<uint64> head{0};
+    /** Events before this one were cleared. */
+    std::atomic<uint64> tail{0};
+};
+
+class Registry {
+public:
+    std::shared_ptr<ThreadBuffer> registerThread() {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (freeBuffers.empty()) {
+            buffers.push_back(std::make_shared<ThreadBuffer>(nextTid++));
+        } else {
+            freeBuffers.back()->reset(nextTid++);
+            buffers.push_back(std::move(freeBuffers.back()));
+            freeBuffers.pop_back();
+        }
+        return buffers.back();
+    }
+
+    /**
+     * Moves the events of the finished thread out of its ring buffer, so the buffer can be reused by the next
+     * thread. Only the RING_BUFFER_SIZE most recent events of all finished threads are kept.
+     */
+    void releaseThread(const std::shared_ptr<ThreadBuffer> &buffer) {
+        std::lock_guard<std::mutex> guard(mutex);
+        std::vector<EventData> events;
+        buffer->copyTo(events);
+        finishedEvents.insert(std::end(finishedEvents), std::begin(events), std::end(events));
+        if (finishedEvents.size() > RING_BUFFER_SIZE) {
+            finishedEvents.erase(std::begin(finishedEvents),
+                                 std::end(finishedEvents) - (std::ptrdiff_t) RING_BUFFER_SIZE);
+        }
+        buffers.erase(std::find(std::begin(buffers), std::end(buffers), buffer));
+        freeBuffers.push_back(buffer);
+    }
+
+    size_t getNumberOfBuffers() {
+        std::lock_guard<std::mutex> guard(mutex);
+        return buffers.size() + freeBuffers.size();
+    }
+
+    std::vector<EventData> getEvents() {
+        std::vector<EventData> result;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            result.assign(std::begin(finishedEvents), std::end(finishedEvents));
+            for (auto &buffer : buffers) {
+                buffer->copyTo(result);
+            }
+        }
+        std::stable_sort(std::begin(result), std::end(result),
+                         [](const EventData &a, const EventData &b) { return a.timestamp < b.timestamp; });
+        return result;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> guard(mutex);
+        for (auto &buffer : buffers) {
+            buffer->clear();
+        }
+        finishedEvents.clear();
+    }
+
+private:
+    std::mutex mutex;
+    /** Buffers of the running threads. */
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    /** Buffers of the finished threads, to be reused by the new threads. */
+    std::vector<std::shared_ptr<ThreadBuffer>> freeBuffers;
+    /** Events of the finished threads. */
+    std::deque<EventData> finishedEvents;
+    uint32 nextTid{1};
+};
+
+Registry &getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+/**
+ * The calling thread buffer; returned to the registry when the thread exits.
+ * NOTE: the thread_local objects are destroyed before the static ones (i.e. the registry).
+ */
+class ThreadBufferHandle {
+public:
+    ThreadBufferHandle() = default;
+
+    ~ThreadBufferHandle() {
+        if (buffer) {
+            getRegistry().releaseThread(buffer);
+        }
+    }
+
+    ThreadBufferHandle(ThreadBufferHandle const &) = delete;
+    void operator=(ThreadBufferHandle const &) = delete;
+    ThreadBufferHandle(ThreadBufferHandle const &&) = delete;
+    void operator=(ThreadBufferHandle const &&) = delete;
+
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+thread_local ThreadBufferHandle threadBuffer;
+
+int64 getTimestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void writeJsonString(std::ostream &os, const char *str) {
+    os << '"';
+    for (const char *c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            os << '\\';
+        }
+        os << *c;
+    }
+    os << '"';
+}
+
+}// namespace
+
+void record(const char *category, const char *name, char phase, int64 value) {
+    auto &buffer = threadBuffer.buffer;
+    if (!buffer) {
+        buffer = getRegistry().registerThread();
+    }
+    buffer->push(category, name, phase, getTimestamp(), value);
+}
+
+std::string toChromeTraceJson() {
+    std::stringstream ss;
+    ss << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (auto &event : getRegistry().getEvents()) {
+        if (!first) {
+            ss << ",\n";
+        }
+        first = false;
+        ss << "{\"name\":";
+        writeJsonString(ss, event.name);
+        ss << ",\"cat\":";
+        writeJsonString(ss, event.category);
+        // Chrome trace timestamps are in microseconds.
+        ss << format(",\"ph\":\"{}\",\"ts\":{:.3f},\"pid\":1,\"tid\":{}", event.phase,
+                     (double) event.timestamp / 1e3, event.tid);
+        if (event.phase == 'i') {
+            // Thread-scoped instant event.
+            ss << ",\"s\":\"t\"";
+        }
+        if (event.phase != 'E') {
+            ss << ",\"args\":{\"value\":" << event.value << "}";
+        }
+        ss << "}";
+    }
+    ss << "]}\n";
+    return ss.str();
+}
+
+void clear() { getRegistry().clear(); }
+
+size_t getNumberOfBuffers() { return getRegistry().getNumberOfBuffers(); }
+
+}// namespace tracing
+
+bool isTracingAvailable() {
+#ifdef ARRUS_ENABLE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void setTracingEnabled(bool value) { tracing::enabled.store(value, std::memory_order_relaxed); }
+
+void clearTrace() { tracing::clear(); }
+
+void dumpTrace(const std::string &filepath) {
+    std::ofstream file{filepath};
+    if (!file) {
+        throw IllegalArgumentException(format("Cannot open the trace file: {}", filepath));
+    }
+    file << tracing::toChromeTraceJson();
+}
+
+}// namespace arrus
@@ -0,0 +1,95 @@
+#ifndef ARRUS_CORE_COMMON_TRACING_H
+#define ARRUS_CORE_COMMON_TRACING_H
+
+#include <atomic>
+#include <string>
+
+#include "arrus/core/api/common/tracing.h"
+#include "arrus/core/api/common/types.h"
+
+namespace arrus::tracing {
+
+/** The maximum number of events kept for a single running thread, and for all the finished threads. */
+constexpr size_t RING_BUFFER_SIZE = 1u << 15u;
+
+extern std::atomic<bool> enabled;
+
+inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+/**
+ * Records a single trace event in the calling thread ring buffer (lock-free, except the first event
+ * recorded by a given thread).
+ *
+ * @param category event category; should be a string literal
+ * @param name event name; should be a string literal
+ * @param phase Chrome trace event phase: 'B' (begin), 'E' (end) or 'i' (instant)
+ * @param value event argument
+ */
+void record(const char *category, const char *name, char phase, int64 value);
+
+/**
+ * Returns the recorded events, in the Chrome trace event JSON format.
+ */
+std::string toChromeTraceJson();
+
+void clear();
+
+/**
+ * Returns the number of the allocated thread ring buffers. The buffers of the finished threads are reused,
+ * i.e. this is the maximum number of the threads recording events at the same time.
+ */
+size_t getNumberOfBuffers();
+
+/**
+ * Records the begin and end events of the enclosing scope.
+ */
+class Scope {
+public:
+    Scope(const char *category, const char *name, int64 value = 0)
+        : category(category), name(name), active(isEnabled()) {
+        if (active) {
+            record(category, name, 'B', value);
+        }
+    }
+
+    ~Scope() {
+        if (active) {
+            record(category, name, 'E', 0);
+        }
+    }
+
+    Scope(Scope const &) = delete;
+    void operator=(Scope const &) = delete;
+    Scope(Scope const &&) = delete;
+    void operator=(Scope const &&) = delete;
+
+private:
+    const char *category;
+    const char *name;
+    bool active;
+};
+
+}
+
+#define ARRUS_TRACE_CONCAT_IMPL(a, b) a##b
+#define ARRUS_TRACE_CONCAT(a, b) ARRUS_TRACE_CONCAT_IMPL(a, b)
+
+// Trace points, removed at compile time unless ARRUS_ENABLE_TRACING is defined (see ARRUS_TRACING CMake option).
+#ifdef ARRUS_ENABLE_TRACING
+#define ARRUS_TRACE_SCOPE(category, name) \
+    ::arrus::tracing::Scope ARRUS_TRACE_CONCAT(arrusTraceScope, __LINE__){category, name}
+#define ARRUS_TRACE_SCOPE_VALUE(category, name, value) \
+    ::arrus::tracing::Scope ARRUS_TRACE_CONCAT(arrusTraceScope, __LINE__){category, name, (::arrus::int64)(value)}
+#define ARRUS_TRACE_INSTANT(category, name, value)                                                                     \
+    do {                                                                                                               \
+        if (::arrus::tracing::isEnabled()) {                                                                           \
+            ::arrus::tracing::record(category, name, 'i', (::arrus::int64)(value));                                    \
+        }                                                                                                              \
+    } while (0)
+#else
+#define ARRUS_TRACE_SCOPE(category, name) do {} while (0)
+#define ARRUS_TRACE_SCOPE_VALUE(category, name, value) do {} while (0)
+#define ARRUS_TRACE_INSTANT(category, name, value) do {} while (0)
+#endif
+
+#endif //ARRUS_CORE_COMMON_TRACING_H
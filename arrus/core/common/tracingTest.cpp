@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <regex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "arrus/common/format.h"
+#include "arrus/core/common/tracing.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+
+size_t countOccurrences(const std::string &str, const std::string &pattern) {
+    size_t count = 0;
+    for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+class TracingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        setTracingEnabled(true);
+        clearTrace();
+    }
+
+    void TearDown() override {
+        setTracingEnabled(false);
+        clearTrace();
+    }
+};
+
+TEST_F(TracingTest, RecordsScopeAndInstantEvents) {
+    {
+        tracing::Scope scope{"buffer", "signal", 3};
+        tracing::record("overflow", "rxOverflow", 'i', 7);
+    }
+    auto json = tracing::toChromeTraceJson();
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"signal\""), 2);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), 1);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"E\""), 1);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"i\""), 1);
+    EXPECT_EQ(countOccurrences(json, "\"args\":{\"value\":3}"), 1);
+    EXPECT_EQ(countOccurrences(json, "\"args\":{\"value\":7}"), 1);
+}
+
+TEST_F(TracingTest, DoesNotRecordWhenDisabled) {
+    setTracingEnabled(false);
+    { tracing::Scope scope{"buffer", "signal"}; }
+    EXPECT_EQ(countOccurrences(tracing::toChromeTraceJson(), "\"name\""), 0);
+}
+
+TEST_F(TracingTest, KeepsEventsOfEachThreadSeparately) {
+    std::thread t1([]() { tracing::record("us4oem", "irq", 'i', 0); });
+    std::thread t2([]() { tracing::record("us4oem", "irq", 'i', 1); });
+    t1.join();
+    t2.join();
+    auto json = tracing::toChromeTraceJson();
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"irq\""), 2);
+    // The events of the finished threads should still be available, each thread has its own id.
+    std::regex tidPattern{"\"tid\":([0-9]+)"};
+    std::set<std::string> tids;
+    for (auto it = std::sregex_iterator(json.begin(), json.end(), tidPattern); it != std::sregex_iterator(); ++it) {
+        tids.insert((*it)[1].str());
+    }
+    EXPECT_EQ(tids.size(), 2);
+}
+
+TEST_F(TracingTest, KeepsTheMostRecentEvents) {
+    for (size_t i = 0; i < tracing::RING_BUFFER_SIZE + 10; ++i) {
+        tracing::record("buffer", "release", 'i', (int64) i);
+    }
+    auto json = tracing::toChromeTraceJson();
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"release\""), tracing::RING_BUFFER_SIZE);
+    EXPECT_EQ(countOccurrences(json, "\"args\":{\"value\":9}"), 0);
+    EXPECT_EQ(countOccurrences(json, "\"args\":{\"value\":10}"), 1);
+    clearTrace();
+    EXPECT_EQ(countOccurrences(tracing::toChromeTraceJson(), "\"name\""), 0);
+}
+
+TEST_F(TracingTest, ReusesBuffersOfFinishedThreads) {
+    tracing::record("upload", "main", 'i', 0);
+    auto nBuffers = tracing::getNumberOfBuffers();
+    for (int i = 0; i < 100; ++i) {
+        std::thread t([i]() { tracing::record("upload", "upload", 'i', i); });
+        t.join();
+    }
+    // At most a single new buffer, reused by all the subsequent threads.
+    EXPECT_LE(tracing::getNumberOfBuffers(), nBuffers + 1);
+    // The events of the finished threads are still available.
+    auto json = tracing::toChromeTraceJson();
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"upload\""), 100);
+    EXPECT_EQ(countOccurrences(json, "\"args\":{\"value\":99}"), 1);
+    clearTrace();
+    EXPECT_EQ(countOccurrences(tracing::toChromeTraceJson(), "\"name\""), 0);
+}
+
+TEST_F(TracingTest, KeepsTheMostRecentEventsOfFinishedThreads) {
+    for (int i = 0; i < 2; ++i) {
+        std::thread t([i]() {
+            for (size_t j = 0; j < tracing::RING_BUFFER_SIZE; ++j) {
+                tracing::record("buffer", "release", 'i', (int64) (i * tracing::RING_BUFFER_SIZE + j));
+            }
+        });
+        t.join();
+    }
+    auto json = tracing::toChromeTraceJson();
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"release\""), tracing::RING_BUFFER_SIZE);
+    EXPECT_EQ(countOccurrences(json, format("\"args\":{{\"value\":{}}}", tracing::RING_BUFFER_SIZE - 1)), 0);
+    EXPECT_EQ(countOccurrences(json, format("\"args\":{{\"value\":{}}}", tracing::RING_BUFFER_SIZE)), 1);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
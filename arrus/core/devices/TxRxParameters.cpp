@@ -26,4 +26,19 @@ uint16 getNumberOfNoRxNOPs(const TxRxParamsSequence &seq) {
     return res;
 }
 
+TxRxParamsSequence toTxRxParamsSequence(const ops::us4r::TxRxSequence &seq) {
+    TxRxParamsSequence result;
+    for (const auto &txrx : seq.getOps()) {
+        auto &tx = txrx.getTx();
+        auto &rx = txrx.getRx();
+
+        Interval<uint32> sampleRange(rx.getSampleRange().first, rx.getSampleRange().second);
+        Tuple<ChannelIdx> padding({rx.getPadding().first, rx.getPadding().second});
+
+        result.push_back(TxRxParameters(tx.getAperture(), tx.getDelays(), tx.getExcitation(), rx.getAperture(),
+                                        sampleRange, rx.getDownsamplingFactor(), txrx.getPri(), padding));
+    }
+    return result;
+}
+
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "arrus/common/format.h"
 #include "arrus/core/common/collections.h"
 #include "arrus/core/api/ops/us4r/Pulse.h"
+#include "arrus/core/api/ops/us4r/TxRxSequence.h"
 
 namespace arrus::devices {
 
@@ -177,6 +178,11 @@ using TxRxParamsSequence = std::vector<TxRxParameters>;
  */
 uint16 getNumberOfNoRxNOPs(const TxRxParamsSequence &seq);
 
+/**
+ * Converts the given TX/RX sequence to the intermediate representation (TxRxParameters).
+ */
+TxRxParamsSequence toTxRxParamsSequence(const ops::us4r::TxRxSequence &seq);
+
 }
 
 #endif //ARRUS_CORE_DEVICES_TXRXPARAMETERS_H
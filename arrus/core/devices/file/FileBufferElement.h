@@ -2,29 +2,20 @@
 #define ARRUS_CORE_DEVICES_FILE_FILEBUFFERELEMENT_H
 
 #include "arrus/core/api/framework/Buffer.h"
+#include "arrus/common/format.h"
 
 namespace arrus::devices {
 
 class FileBufferElement: public arrus::framework::BufferElement {
 public:
 
-    FileBufferElement(size_t position, const arrus::framework::NdArray::Shape& shape) {
+    FileBufferElement(size_t position, const arrus::framework::NdArray::Shape& shape)
+        : ndarray(shape, arrus::framework::NdArray::DataType::INT16, DeviceId(DeviceType::CPU, 0), "") {
         this->size = shape.product(); // The number of int16 elements.
-        this->data = new int16_t[size];
-        this->ndarray = arrus::framework::NdArray{
-            this->data,
-            shape,
-            arrus::framework::NdArray::DataType::INT16,
-            DeviceId(DeviceType::CPU, 0)
-        };
         this->dataView = this->ndarray.view();
         this->position = position;
     }
 
-    ~FileBufferElement() {
-        delete data;
-    }
-
     bool write(const std::function<void()> &func) {
         std::unique_lock<std::mutex> lock{stateMutex};
 
@@ -70,6 +61,45 @@ public:
         this->dataView = ndarray.slice(i, begin, end);
     }
 
+    /**
+     * Writes us4R-like frame metadata into the first sample of the given TX/RX frame (see FrameMetadata)
+     * of the whole element data. The remaining words of the metadata row are zeroed.
+     */
+    void writeFrameMetadata(size_t tx, uint32 triggerNumber, uint64 timestamp, uint16 txBegin, uint16 txEnd) {
+        using arrus::framework::FrameMetadata;
+        const auto &shape = ndarray.getShape();
+        if (shape[2] < FrameMetadata::N_VALUES) {
+            return;// Not enough RX channels to store the metadata row.
+        }
+        const size_t stride = shape[3] * shape[4];
+        int16 *row = ndarray.get<int16>() + tx * shape[2] * stride;
+        for (size_t i = 0; i < FrameMetadata::N_VALUES; ++i) {
+            row[i * stride] = 0;
+        }
+        auto write = [row, stride](size_t word, uint64 value, size_t nWords) {
+            for (size_t i = 0; i < nWords; ++i) {
+                row[(word + i) * stride] = static_cast<int16>(static_cast<uint16>(value >> (16 * i)));
+            }
+        };
+        write(FrameMetadata::TRIGGER_NUMBER_WORD, triggerNumber, 2);
+        write(FrameMetadata::TIMESTAMP_WORD, timestamp, 4);
+        write(FrameMetadata::TX_BEGIN_WORD, txBegin, 1);
+        write(FrameMetadata::TX_END_WORD, txEnd, 1);
+    }
+
+    size_t getNumberOfFrameMetadata() override {
+        const auto &shape = dataView.getShape();
+        return shape[2] < arrus::framework::FrameMetadata::N_VALUES ? 0 : shape[1];
+    }
+
+    arrus::framework::FrameMetadata getFrameMetadata(size_t frame) override {
+        if (frame >= getNumberOfFrameMetadata()) {
+            throw IllegalArgumentException(format("Frame metadata not available for frame: {}", frame));
+        }
+        const auto &strides = dataView.getStrides();
+        return arrus::framework::FrameMetadata{dataView.get<int16>() + frame * strides[1], strides[2]};
+    }
+
     arrus::framework::NdArray &getData() override { return dataView; }
     arrus::framework::NdArray &getAllData() {return ndarray; }
     size_t getSize() override { return size*sizeof(int16_t); }
@@ -79,15 +109,8 @@ private:
     std::mutex stateMutex;
     std::condition_variable readyForWrite;
     std::condition_variable readyForRead;
-    int16_t *data{nullptr};
     size_t size;
-    // NdArray: view of the above data pointer.
-    arrus::framework::NdArray ndarray{
-        data,
-        arrus::framework::NdArray::Shape{},
-        arrus::framework::NdArray::DataType::INT16,
-        DeviceId{DeviceType::CPU, 0}
-    };
+    arrus::framework::NdArray ndarray;
     arrus::framework::NdArray dataView;
     size_t position;
     State state{arrus::framework::BufferElement::State::FREE};
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+
+#include "arrus/core/devices/file/FileBufferElement.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::devices;
+using namespace arrus::framework;
+
+TEST(FrameMetadataTest, DecodesMultiWordValues) {
+    std::vector<int16> row(FrameMetadata::N_VALUES * 2, 0);
+    const size_t stride = 2;
+    // Trigger number 0x0001FFFF, timestamp 0x0004000300020001
+    row[0 * stride] = (int16) 0xFFFF;
+    row[1 * stride] = 1;
+    for (int16 i = 0; i < 4; ++i) {
+        row[(FrameMetadata::TIMESTAMP_WORD + i) * stride] = (int16) (i + 1);
+    }
+    row[FrameMetadata::TX_BEGIN_WORD * stride] = 3;
+    row[FrameMetadata::TX_END_WORD * stride] = 7;
+    FrameMetadata metadata{row.data(), stride};
+
+    EXPECT_EQ(metadata.getTriggerNumber(), 0x0001FFFFu);
+    EXPECT_EQ(metadata.getTimestamp(), 0x0004000300020001ull);
+    EXPECT_EQ(metadata.getTxBegin(), 3);
+    EXPECT_EQ(metadata.getTxEnd(), 7);
+    EXPECT_EQ(metadata.getValue(1), 1);
+    EXPECT_THROW(metadata.getValue(FrameMetadata::N_VALUES), IllegalArgumentException);
+}
+
+TEST(FileBufferElementTest, ReadsWrittenFrameMetadataOfEachTx) {
+    const size_t nTx = 4, nRx = 32, nSamples = 16, nValues = 2;
+    FileBufferElement element{0, NdArray::Shape{1, nTx, nRx, nSamples, nValues}};
+    for (size_t tx = 0; tx < nTx; ++tx) {
+        element.writeFrameMetadata(tx, (uint32) (70000 + tx), 1234567890123ull + tx, 1, 3);
+    }
+    ASSERT_EQ(element.getNumberOfFrameMetadata(), nTx);
+    for (size_t tx = 0; tx < nTx; ++tx) {
+        auto metadata = element.getFrameMetadata(tx);
+        EXPECT_EQ(metadata.getTriggerNumber(), 70000 + tx);
+        EXPECT_EQ(metadata.getTimestamp(), 1234567890123ull + tx);
+        EXPECT_EQ(metadata.getTxBegin(), 1);
+        EXPECT_EQ(metadata.getTxEnd(), 3);
+    }
+    // The metadata row is the first sample of each RX channel.
+    EXPECT_EQ(element.getAllData().get<int16>()[(FrameMetadata::TX_END_WORD * nSamples) * nValues], 3);
+    EXPECT_THROW(element.getFrameMetadata(nTx), IllegalArgumentException);
+
+    // Sub-sequence: the metadata of the selected TXs only.
+    element.slice(1, 1, 3);
+    ASSERT_EQ(element.getNumberOfFrameMetadata(), 2);
+    EXPECT_EQ(element.getFrameMetadata(0).getTriggerNumber(), 70001u);
+    EXPECT_EQ(element.getFrameMetadata(1).getTriggerNumber(), 70002u);
+}
+
+TEST(FileBufferElementTest, NoMetadataForLessThan32Channels) {
+    FileBufferElement element{0, NdArray::Shape{1, 2, 16, 8, 1}};
+    element.writeFrameMetadata(0, 1, 1, 0, 2);
+    EXPECT_EQ(element.getNumberOfFrameMetadata(), 0);
+    EXPECT_THROW(element.getFrameMetadata(0), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -3,9 +3,10 @@
 #include "arrus/core/common/collections.h"
 #include "arrus/core/common/logging.h"
 #include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/io/RfCodec.h"
 #include <cmath>
 #include <utility>
-#include <ctime>
+#include <chrono>
 
 namespace arrus::devices {
 
@@ -32,6 +33,19 @@ std::vector<FileImpl::Frame> FileImpl::readDataset(const std::string &filepath)
     if(fileSize == 0) {
         throw ArrusException("Empty input file. Is your input file correct?");
     }
+    // Compressed recording (see arrus::io::RfRecorder).
+    auto header = io::readRfRecordingHeader(file);
+    if(header.has_value()) {
+        logger->log(LogSeverity::INFO, format("Decoding RF recording, frame size: {} values", header->shape.product()));
+        std::vector<Frame> result = io::readRfFrames(file, header.value(), 0);
+        if(result.size() != settings.getNFrames()) {
+            throw ArrusException(format(
+                "The number of frames in the RF recording ({}) is different than the number of declared frames "
+                "({}). Is your input file correct?", result.size(), settings.getNFrames()));
+        }
+        logger->log(LogSeverity::INFO, "Data ready.");
+        return result;
+    }
     if(fileSize % sizeof(int16_t) != 0) {
         throw ArrusException("Invalid input data size: the number of read bytes is not divisible by 2 (int16_t). "
                              "Is your input file correct?");
@@ -123,25 +137,24 @@ void FileImpl::stop() {
 void FileImpl::producer() {
     size_t elementNr = 0;
     size_t frameNr = 0;
+    uint32 triggerNumber = 0;
+    const auto startTime = std::chrono::steady_clock::now();
     logger->log(LogSeverity::INFO, "Starting producer.");
     while(this->state == State::STARTED) {
-        bool cont = buffer->write(elementNr, [this, &frameNr] (const framework::BufferElement::SharedHandle &element) {
+        bool cont = buffer->write(elementNr, [this, &frameNr, &triggerNumber, &startTime]
+                                  (const framework::BufferElement::SharedHandle &element) {
             auto &frame = this->dataset.at(frameNr);
             auto fileBufferElement = std::dynamic_pointer_cast<FileBufferElement>(element);
             std::memcpy(fileBufferElement->getAllData().getInt16(), frame.data(), frame.size()*sizeof(int16_t));
 
-            // Write us4R specific metadata
-            // Zero metadata row: (32 int16)
-            for(int i = 0; i < 32; ++i) {
-                size_t offset = i*this->frameShape[3]*this->frameShape[4];
-                *(element->getData().get<int16_t>()+offset) = 0;
+            // Write us4R specific metadata (see FrameMetadata), the timestamp is the number of (emulated) us4OEM
+            // clock cycles since start.
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            auto timestamp = (uint64)(elapsed*this->getSamplingFrequency());
+            for(size_t tx = 0; tx < this->frameShape[1]; ++tx) {
+                fileBufferElement->writeFrameMetadata(tx, triggerNumber++, timestamp,
+                                                      (uint16)this->txBegin, (uint16)this->txEnd);
             }
-            size_t beginOffset = 8*this->frameShape[3]*this->frameShape[4];
-            size_t endOffset = 9*this->frameShape[3]*this->frameShape[4];
-            size_t timestampOffset = 4*this->frameShape[3]*this->frameShape[4];
-            *(element->getData().get<int16_t>()+beginOffset) = (int16_t)this->txBegin;
-            *(element->getData().get<int16_t>()+endOffset) = (int16_t)this->txEnd;
-            *((int16_t*)(element->getData().get<int16_t>()+timestampOffset)) = (int16_t)std::time(nullptr);
             using namespace std::chrono_literals;
             std::this_thread::sleep_for(50ms);
         });
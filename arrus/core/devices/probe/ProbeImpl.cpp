@@ -49,12 +49,12 @@ class ProbeTxRxValidator : public Validator<TxRxParamsSequence> {
   const ProbeModel &modelRef;
 };
 
-std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-ProbeImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
-                           uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
-                           arrus::ops::us4r::Scheme::WorkMode workMode,
-                           const std::optional<ops::us4r::DigitalDownConversion> &ddc,
-                           const std::vector<framework::NdArray> &txDelayProfiles) {
+ProbeSequence
+ProbeImpl::compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                               uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                               arrus::ops::us4r::Scheme::WorkMode workMode,
+                               const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                               const std::vector<framework::NdArray> &txDelayProfiles) {
     // Validate input sequence
     ProbeTxRxValidator validator(format("tx rx sequence for {}", getDeviceId().toString()), model);
     validator.validate(seq);
@@ -126,10 +126,20 @@ ProbeImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us
         ++opIdx;
     }
 
-    auto[buffer, fcm] = adapter->setTxRxSequence(adapterSeq, tgcSamples, rxBufferSize, rxBatchSize, sri, workMode,
-                                                 ddc, adapterTxDelayProfiles);
-    FrameChannelMapping::Handle actualFcm = remapFcm(fcm, rxApertureChannelMappings, rxPaddingLeft, rxPaddingRight);
-    return std::make_tuple(std::move(buffer), std::move(actualFcm));
+    auto adapterSequence = adapter->compileTxRxSequence(adapterSeq, tgcSamples, rxBufferSize, rxBatchSize, sri,
+                                                        workMode, ddc, adapterTxDelayProfiles);
+    FrameChannelMapping::Handle adapterFcm = FrameChannelMappingBuilder::copy(*adapterSequence.fcm).build();
+    FrameChannelMapping::Handle actualFcm =
+        remapFcm(adapterFcm, rxApertureChannelMappings, rxPaddingLeft, rxPaddingRight);
+    return ProbeSequence{std::move(adapterSequence), std::move(actualFcm)};
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeImpl::programTxRxSequence(const ProbeSequence &seq) {
+    auto [buffer, adapterFcm] = adapter->programTxRxSequence(seq.adapterSequence);
+    FrameChannelMapping::Handle fcm =
+        FrameChannelMappingBuilder::copy(dynamic_cast<const FrameChannelMappingImpl &>(*seq.fcm)).build();
+    return std::make_tuple(std::move(buffer), std::move(fcm));
 }
 
 Interval<Voltage> ProbeImpl::getAcceptedVoltageRange() {
@@ -224,4 +234,18 @@ ProbeImpl::setSubsequence(uint16_t start, uint16_t end, const std::optional<floa
     return this->adapter->setSubsequence(start, end, sri);
 }
 
+void ProbeImpl::programSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) {
+    this->adapter->programSubsequence(start, end, sri);
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeImpl::getSubsequenceView(const ProbeSequence &seq, uint16_t start, uint16_t end) {
+    return this->adapter->getSubsequenceView(seq.adapterSequence, start, end, *seq.fcm);
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeImpl::getTransferRoiView(const ProbeSequence &seq, const ops::us4r::TransferRoi &roi) {
+    return this->adapter->getTransferRoiView(seq.adapterSequence, roi, *seq.fcm);
+}
+
 }// namespace arrus::devices
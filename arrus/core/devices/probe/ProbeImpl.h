@@ -24,11 +24,15 @@ public:
         return model;
     }
 
+    ProbeSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<framework::NdArray> &txDelayProfiles) override;
+
     std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-    setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples, uint16 rxBufferSize,
-                    uint16 rxBatchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
-                    const std::optional<ops::us4r::DigitalDownConversion> &ddc,
-                    const std::vector<framework::NdArray> &txDelayProfiles) override;
+    programTxRxSequence(const ProbeSequence &seq) override;
 
     Interval<Voltage> getAcceptedVoltageRange() override;
 
@@ -45,6 +49,14 @@ public:
 
     std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
     setSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) override;
+
+    void programSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) override;
+
+    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getSubsequenceView(const ProbeSequence &seq, uint16_t start, uint16_t end) override;
+
+    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getTransferRoiView(const ProbeSequence &seq, const ops::us4r::TransferRoi &roi) override;
 private:
     Logger::Handle logger;
     ProbeModel model;
@@ -4,25 +4,70 @@
 #include "arrus/core/api/devices/probe/Probe.h"
 #include "arrus/core/api/ops/us4r/Scheme.h"
 #include "arrus/core/devices/us4r/Us4RBuffer.h"
+#include "arrus/core/devices/us4r/probeadapter/ProbeAdapterImplBase.h"
 #include "arrus/core/devices/UltrasoundDevice.h"
 
 namespace arrus::devices {
 
+/**
+ * A TX/RX sequence compiled for the probe (see ProbeImplBase::compileTxRxSequence).
+ */
+struct ProbeSequence {
+    ProbeAdapterSequence adapterSequence;
+    /** The FCM of the probe output (i.e. the adapter FCM with the probe channels order). */
+    FrameChannelMapping::Handle fcm;
+};
+
 class ProbeImplBase : public Probe, public UltrasoundDevice {
 public:
     using Handle = std::unique_ptr<ProbeImplBase>;
     using RawHandle = ProbeImplBase *;
     using Probe::Probe;
 
+    /**
+     * Compiles the given TX/RX sequence, without changing the state of the devices.
+     */
+    virtual ProbeSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<framework::NdArray> &txDelayProfiles) = 0;
+
+    /**
+     * Programs the devices with the given compiled sequence.
+     *
+     * @return the us4R buffer and FCM of the sequence
+     */
     virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    programTxRxSequence(const ProbeSequence &seq) = 0;
+
+    /**
+     * Compiles and programs the given TX/RX sequence.
+     */
+    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
     setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples, uint16 rxBufferSize,
                     uint16 rxBatchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
                     const std::optional<ops::us4r::DigitalDownConversion> &ddc,
-                    const std::vector<framework::NdArray> &txDelayProfiles) = 0;
+                    const std::vector<framework::NdArray> &txDelayProfiles) {
+        return programTxRxSequence(compileTxRxSequence(seq, tgcSamples, rxBufferSize, rxBatchSize, sri, workMode, ddc,
+                                                       txDelayProfiles));
+    }
 
     virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
     setSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) = 0;
 
+    /**
+     * Sets the sequencer range and SRI to the given sub-sequence, the data transfers are left unchanged.
+     */
+    virtual void programSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) = 0;
+
+    virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getSubsequenceView(const ProbeSequence &seq, uint16_t start, uint16_t end) = 0;
+
+    virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getTransferRoiView(const ProbeSequence &seq, const ops::us4r::TransferRoi &roi) = 0;
+
 };
 
 }
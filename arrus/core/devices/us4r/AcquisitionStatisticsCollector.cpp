@@ -0,0 +1,149 @@
+#include "AcquisitionStatisticsCollector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace arrus::devices {
+
+namespace {
+
+// Histogram range: [1 us, 100 s), 10 bins per decade.
+constexpr float HISTOGRAM_MIN = 1e-6f;
+constexpr size_t HISTOGRAM_N_DECADES = 8;
+constexpr size_t HISTOGRAM_BINS_PER_DECADE = 10;
+constexpr size_t HISTOGRAM_N_BINS = HISTOGRAM_N_DECADES * HISTOGRAM_BINS_PER_DECADE;
+
+std::vector<float> getHistogramBinEdges() {
+    std::vector<float> edges(HISTOGRAM_N_BINS + 1);
+    for (size_t i = 0; i <= HISTOGRAM_N_BINS; ++i) {
+        edges[i] = HISTOGRAM_MIN * std::pow(10.0f, (float) i / (float) HISTOGRAM_BINS_PER_DECADE);
+    }
+    return edges;
+}
+
+size_t getHistogramBin(float value) {
+    if (!(value > HISTOGRAM_MIN)) {
+        return 0;
+    }
+    auto bin = (long long) std::floor(std::log10(value / HISTOGRAM_MIN) * (float) HISTOGRAM_BINS_PER_DECADE);
+    return (size_t) std::clamp(bin, 0LL, (long long) HISTOGRAM_N_BINS - 1);
+}
+
+float toSeconds(AcquisitionStatisticsCollector::Clock::duration duration) {
+    return std::chrono::duration<float>(duration).count();
+}
+
+}// namespace
+
+AcquisitionStatisticsCollector::Histogram::Histogram() : counts(HISTOGRAM_N_BINS, 0) {}
+
+void AcquisitionStatisticsCollector::Histogram::add(float value) {
+    ++counts[getHistogramBin(value)];
+    min = n == 0 ? value : std::min(min, value);
+    max = n == 0 ? value : std::max(max, value);
+    sum += value;
+    ++n;
+}
+
+DurationHistogram AcquisitionStatisticsCollector::Histogram::get() const {
+    return DurationHistogram{getHistogramBinEdges(), counts, min, max, sum};
+}
+
+void AcquisitionStatisticsCollector::Histogram::reset() {
+    std::fill(std::begin(counts), std::end(counts), 0);
+    min = max = 0.0f;
+    sum = 0.0;
+    n = 0;
+}
+
+AcquisitionStatisticsCollector::AcquisitionStatisticsCollector(float fpgaClockFrequency)
+    : fpgaClockFrequency(fpgaClockFrequency), startTime(Clock::now()) {}
+
+void AcquisitionStatisticsCollector::onAcquired(Clock::time_point time, std::optional<uint64> fpgaTimestamp,
+                                                std::optional<uint32> triggerNumber) {
+    std::lock_guard<std::mutex> guard{mutex};
+    ++nAcquired;
+    ++occupancy;
+    occupancyHighWaterMark = std::max(occupancyHighWaterMark, occupancy);
+    if (lastTime.has_value()) {
+        hostInterval.add(toSeconds(time - lastTime.value()));
+    }
+    lastTime = time;
+    if (fpgaTimestamp.has_value()) {
+        if (lastFpgaTimestamp.has_value() && fpgaTimestamp.value() > lastFpgaTimestamp.value()) {
+            fpgaInterval.add((float) (fpgaTimestamp.value() - lastFpgaTimestamp.value()) / fpgaClockFrequency);
+        }
+        lastFpgaTimestamp = fpgaTimestamp;
+    }
+    if (triggerNumber.has_value()) {
+        if (lastTriggerNumber.has_value()) {
+            // Note: unsigned arithmetic, handles the trigger counter wraparound.
+            uint32 delta = triggerNumber.value() - lastTriggerNumber.value();
+            if (delta > 0) {
+                if (!triggersPerElement.has_value() || delta < triggersPerElement.value()) {
+                    triggersPerElement = delta;
+                }
+                nDropped += delta / triggersPerElement.value() - 1;
+            }
+        }
+        lastTriggerNumber = triggerNumber;
+    }
+}
+
+void AcquisitionStatisticsCollector::onDelivered(Clock::duration duration) {
+    std::lock_guard<std::mutex> guard{mutex};
+    ++nDelivered;
+    callbackDuration.add(toSeconds(duration));
+}
+
+void AcquisitionStatisticsCollector::onReleased() {
+    std::lock_guard<std::mutex> guard{mutex};
+    // Elements acquired before the reset can be released after it.
+    if (occupancy > 0) {
+        --occupancy;
+    }
+}
+
+void AcquisitionStatisticsCollector::onOverflow() {
+    std::lock_guard<std::mutex> guard{mutex};
+    ++nOverflows;
+}
+
+void AcquisitionStatisticsCollector::onNewBuffer() {
+    std::lock_guard<std::mutex> guard{mutex};
+    occupancy = 0;
+    resetReferences();
+}
+
+AcquisitionStatistics AcquisitionStatisticsCollector::get() const {
+    std::lock_guard<std::mutex> guard{mutex};
+    return AcquisitionStatistics{nAcquired,
+                                 nDelivered,
+                                 nDropped,
+                                 nOverflows,
+                                 occupancyHighWaterMark,
+                                 toSeconds(Clock::now() - startTime),
+                                 hostInterval.get(),
+                                 fpgaInterval.get(),
+                                 callbackDuration.get()};
+}
+
+void AcquisitionStatisticsCollector::reset() {
+    std::lock_guard<std::mutex> guard{mutex};
+    startTime = Clock::now();
+    nAcquired = nDelivered = nDropped = nOverflows = 0;
+    occupancyHighWaterMark = occupancy;
+    hostInterval.reset();
+    fpgaInterval.reset();
+    callbackDuration.reset();
+    resetReferences();
+}
+
+void AcquisitionStatisticsCollector::resetReferences() {
+    lastTime.reset();
+    lastFpgaTimestamp.reset();
+    lastTriggerNumber.reset();
+    triggersPerElement.reset();
+}
+
+}// namespace arrus::devices
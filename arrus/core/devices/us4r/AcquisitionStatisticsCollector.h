@@ -0,0 +1,101 @@
+#ifndef ARRUS_CORE_DEVICES_US4R_ACQUISITIONSTATISTICSCOLLECTOR_H
+#define ARRUS_CORE_DEVICES_US4R_ACQUISITIONSTATISTICSCOLLECTOR_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/devices/us4r/AcquisitionStatistics.h"
+
+namespace arrus::devices {
+
+/**
+ * Collects the Us4R output buffer statistics (see AcquisitionStatistics).
+ *
+ * The collector is updated by the output buffer: each update takes a short, constant time (no allocations).
+ * All methods are thread-safe.
+ */
+class AcquisitionStatisticsCollector {
+public:
+    using SharedHandle = std::shared_ptr<AcquisitionStatisticsCollector>;
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param fpgaClockFrequency the frequency of the clock used by the FPGA to generate frame timestamps [Hz]
+     */
+    explicit AcquisitionStatisticsCollector(float fpgaClockFrequency);
+
+    /**
+     * Should be called when the buffer element was filled with data by all us4OEMs.
+     *
+     * @param time host time of the element readiness
+     * @param fpgaTimestamp the FPGA timestamp of the first frame of the element (if available)
+     * @param triggerNumber the trigger number of the first frame of the element (if available)
+     */
+    void onAcquired(Clock::time_point time, std::optional<uint64> fpgaTimestamp,
+                    std::optional<uint32> triggerNumber);
+
+    /**
+     * Should be called when the element was successfully passed to the user callback.
+     *
+     * @param callbackDuration the duration of the user callback
+     */
+    void onDelivered(Clock::duration callbackDuration);
+
+    /** Should be called when the buffer element was released. */
+    void onReleased();
+
+    /** Should be called on each buffer overflow. */
+    void onOverflow();
+
+    /**
+     * Should be called when a new output buffer is created: the occupancy and the interval references are reset,
+     * the remaining counters are kept.
+     */
+    void onNewBuffer();
+
+    AcquisitionStatistics get() const;
+
+    void reset();
+
+private:
+    class Histogram {
+    public:
+        Histogram();
+        void add(float value);
+        DurationHistogram get() const;
+        void reset();
+
+    private:
+        std::vector<uint64> counts;
+        float min{0.0f}, max{0.0f};
+        double sum{0.0};
+        uint64 n{0};
+    };
+
+    void resetReferences();
+
+    float fpgaClockFrequency;
+    mutable std::mutex mutex;
+    Clock::time_point startTime;
+    uint64 nAcquired{0};
+    uint64 nDelivered{0};
+    uint64 nDropped{0};
+    uint64 nOverflows{0};
+    size_t occupancy{0};
+    size_t occupancyHighWaterMark{0};
+    Histogram hostInterval, fpgaInterval, callbackDuration;
+    // The previous element references.
+    std::optional<Clock::time_point> lastTime;
+    std::optional<uint64> lastFpgaTimestamp;
+    std::optional<uint32> lastTriggerNumber;
+    /** The smallest trigger number difference between subsequent elements, i.e. the expected one. */
+    std::optional<uint32> triggersPerElement;
+};
+
+}// namespace arrus::devices
+
+#endif//ARRUS_CORE_DEVICES_US4R_ACQUISITIONSTATISTICSCOLLECTOR_H
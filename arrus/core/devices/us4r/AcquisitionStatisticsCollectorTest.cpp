@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+
+#include "arrus/core/common/logging.h"
+#include "arrus/core/devices/us4r/AcquisitionStatisticsCollector.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::devices;
+using namespace std::chrono_literals;
+using Clock = AcquisitionStatisticsCollector::Clock;
+
+constexpr float FPGA_CLOCK_FREQUENCY = 1e6f;// 1 tick = 1 us
+
+TEST(AcquisitionStatisticsCollectorTest, CountsAcquiredAndDeliveredFrames) {
+    AcquisitionStatisticsCollector collector{FPGA_CLOCK_FREQUENCY};
+    auto t0 = Clock::now();
+    for (int i = 0; i < 3; ++i) {
+        collector.onAcquired(t0 + i * 10ms, std::nullopt, std::nullopt);
+    }
+    collector.onDelivered(1ms);
+    collector.onDelivered(3ms);
+    auto stats = collector.get();
+    EXPECT_EQ(stats.getNumberOfAcquiredFrames(), 3);
+    EXPECT_EQ(stats.getNumberOfDeliveredFrames(), 2);
+    EXPECT_EQ(stats.getNumberOfDroppedFrames(), 0);
+    EXPECT_EQ(stats.getHostInterval().getNumberOfSamples(), 2);
+    EXPECT_NEAR(stats.getHostInterval().getMean(), 10e-3f, 1e-6f);
+    EXPECT_NEAR(stats.getFrameRate(), 100.0f, 1e-2f);
+    EXPECT_EQ(stats.getFPGAInterval().getNumberOfSamples(), 0);
+    EXPECT_NEAR(stats.getCallbackDuration().getMin(), 1e-3f, 1e-6f);
+    EXPECT_NEAR(stats.getCallbackDuration().getMax(), 3e-3f, 1e-6f);
+}
+
+TEST(AcquisitionStatisticsCollectorTest, ComputesFPGAIntervalsAndDrops) {
+    AcquisitionStatisticsCollector collector{FPGA_CLOCK_FREQUENCY};
+    auto t0 = Clock::now();
+    // 4 triggers per element, the third element is lost.
+    collector.onAcquired(t0, 1000, 100);
+    collector.onAcquired(t0 + 2ms, 3000, 104);
+    collector.onAcquired(t0 + 6ms, 7000, 112);
+    auto stats = collector.get();
+    EXPECT_EQ(stats.getNumberOfDroppedFrames(), 1);
+    EXPECT_EQ(stats.getFPGAInterval().getNumberOfSamples(), 2);
+    EXPECT_NEAR(stats.getFPGAInterval().getMin(), 2e-3f, 1e-6f);
+    EXPECT_NEAR(stats.getFPGAInterval().getMax(), 4e-3f, 1e-6f);
+}
+
+TEST(AcquisitionStatisticsCollectorTest, HandlesTriggerCounterWraparound) {
+    AcquisitionStatisticsCollector collector{FPGA_CLOCK_FREQUENCY};
+    auto t0 = Clock::now();
+    collector.onAcquired(t0, std::nullopt, 0xFFFFFFFEu);
+    collector.onAcquired(t0 + 1ms, std::nullopt, 0x00000000u);
+    collector.onAcquired(t0 + 2ms, std::nullopt, 0x00000002u);
+    EXPECT_EQ(collector.get().getNumberOfDroppedFrames(), 0);
+}
+
+TEST(AcquisitionStatisticsCollectorTest, TracksBufferOccupancyHighWaterMark) {
+    AcquisitionStatisticsCollector collector{FPGA_CLOCK_FREQUENCY};
+    auto t0 = Clock::now();
+    collector.onAcquired(t0, std::nullopt, std::nullopt);
+    collector.onAcquired(t0, std::nullopt, std::nullopt);
+    collector.onReleased();
+    collector.onAcquired(t0, std::nullopt, std::nullopt);
+    collector.onAcquired(t0, std::nullopt, std::nullopt);
+    collector.onReleased();
+    collector.onReleased();
+    collector.onReleased();
+    EXPECT_EQ(collector.get().getBufferOccupancyHighWaterMark(), 3);
+}
+
+TEST(AcquisitionStatisticsCollectorTest, ComputesPercentiles) {
+    AcquisitionStatisticsCollector collector{FPGA_CLOCK_FREQUENCY};
+    for (int i = 0; i < 99; ++i) {
+        collector.onDelivered(1ms);
+    }
+    collector.onDelivered(100ms);
+    auto histogram = collector.get().getCallbackDuration();
+    // Bin upper edge: 10 bins per decade.
+    EXPECT_NEAR(histogram.getPercentile(50), 1e-3f * std::pow(10.0f, 0.1f), 1e-6f);
+    EXPECT_NEAR(histogram.getPercentile(100), 100e-3f, 1e-6f);
+    EXPECT_EQ(histogram.getBinEdges().size(), histogram.getCounts().size() + 1);
+}
+
+TEST(AcquisitionStatisticsCollectorTest, ResetsCounters) {
+    AcquisitionStatisticsCollector collector{FPGA_CLOCK_FREQUENCY};
+    auto t0 = Clock::now();
+    collector.onAcquired(t0, 1000, 0);
+    collector.onAcquired(t0 + 1ms, 2000, 1);
+    collector.onDelivered(1ms);
+    collector.onOverflow();
+    collector.reset();
+    auto stats = collector.get();
+    EXPECT_EQ(stats.getNumberOfAcquiredFrames(), 0);
+    EXPECT_EQ(stats.getNumberOfDeliveredFrames(), 0);
+    EXPECT_EQ(stats.getNumberOfOverflows(), 0);
+    EXPECT_EQ(stats.getHostInterval().getNumberOfSamples(), 0);
+    EXPECT_EQ(stats.getCallbackDuration().getNumberOfSamples(), 0);
+    // The elements acquired before the reset are still occupied.
+    EXPECT_EQ(stats.getBufferOccupancyHighWaterMark(), 2);
+    // No interval between the elements acquired before and after the reset.
+    collector.onAcquired(t0 + 2ms, 3000, 2);
+    EXPECT_EQ(collector.get().getHostInterval().getNumberOfSamples(), 0);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,80 +1,128 @@
 #ifndef ARRUS_CORE_DEVICES_US4R_US4OEMDATATRANSFERREGISTRAR_H
 #define ARRUS_CORE_DEVICES_US4R_US4OEMDATATRANSFERREGISTRAR_H
 
+#include <algorithm>
+#include <numeric>
+
 #include "arrus/core/devices/us4r/us4oem/Us4OEMImplBase.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMImpl.h"
 #include "arrus/core/devices/us4r/Us4ROutputBuffer.h"
 #include "arrus/core/api/common/types.h"
 #include "arrus/core/common/logging.h"
+#include "arrus/core/common/tracing.h"
 #include "arrus/common/compiler.h"
 
 namespace arrus::devices {
 
 class Transfer {
 public:
-    Transfer(size_t address, size_t size, uint16 firing) : address(address), size(size), firing(firing) {}
+    Transfer(size_t address, size_t size, uint16 firing, uint16 element = 0)
+        : address(address), dstAddress(address), size(size), firing(firing), element(element) {}
+
+    Transfer(size_t address, size_t dstAddress, size_t size, uint16 firing, uint16 element)
+        : address(address), dstAddress(dstAddress), size(size), firing(firing), element(element) {}
 
     bool operator==(const Transfer &rhs) const {
-        return address == rhs.address && size == rhs.size && firing == rhs.firing;
+        return address == rhs.address && dstAddress == rhs.dstAddress && size == rhs.size && firing == rhs.firing
+            && element == rhs.element;
     }
     bool operator!=(const Transfer &rhs) const {
         return !(rhs == *this);
     }
 
     size_t address{0};
+    /** The address in the host buffer element, differs from address only for the transfer ROI views. */
+    size_t dstAddress{0};
     size_t size{0};
     uint16 firing{0};
+    /** The number of element within the group of coalesced elements, the address is relative to that element. */
+    uint16 element{0};
 };
 
 /**
  * Registers transfers from us4R internal DDR memory to the destination (host) memory.
+ *
+ * Transfers can be coalesced: K consecutive buffer elements (a group) are transferred and signaled to the host
+ * buffer at once, i.e. the host is notified once per group. If the group is contiguous both in the us4OEM and host
+ * memory, the data of all group elements are moved using the minimum number of transfers (IRQs).
  */
 class Us4OEMDataTransferRegistrar {
 public:
     static constexpr size_t MAX_N_TRANSFERS = 256;
     static constexpr size_t MAX_TRANSFER_SIZE = Us4OEMImpl::MAX_TRANSFER_SIZE;
 
-    Us4OEMDataTransferRegistrar(Us4ROutputBuffer *dst, const Us4OEMBuffer &src, Us4OEMImplBase *us4oem)
-            : logger(loggerFactory->getLogger()), dstBuffer(dst), srcBuffer(src) {
+    /**
+     * @param nElementsPerGroup the number of consecutive elements that should be transferred and signaled at once;
+     *   must be a divisor of the number of src elements
+     * @param transferIdxOffset the number of the first us4OEM transfer this registrar may use, so the transfers
+     *   of multiple registrars (host buffers) can be programmed at the same time (see getNumberOfTransfers)
+     */
+    Us4OEMDataTransferRegistrar(Us4ROutputBuffer *dst, const Us4OEMBuffer &src, Us4OEMImplBase *us4oem,
+                                uint16 nElementsPerGroup = 1, size_t transferIdxOffset = 0)
+            : logger(loggerFactory->getLogger()), dstBuffer(dst), srcBuffer(src), nElementsPerGroup(nElementsPerGroup),
+              transferIdxOffset(transferIdxOffset) {
         ARRUS_INIT_COMPONENT_LOGGER(logger, "Us4OEMDataTransferRegistrar");
         if (dst->getNumberOfElements() % src.getNumberOfElements() != 0) {
             throw IllegalArgumentException("Host buffer should have multiple of rx buffer elements.");
         }
+        if (nElementsPerGroup == 0 || src.getNumberOfElements() % nElementsPerGroup != 0) {
+            throw IllegalArgumentException(
+                format("The number of coalesced elements ({}) should be a divisor of the rx buffer size ({}).",
+                       nElementsPerGroup, src.getNumberOfElements()));
+        }
         ius4oem = us4oem->getIUs4oem();
         us4oemOrdinal = us4oem->getDeviceId().getOrdinal();
-        elementTransfers = groupPartsIntoTransfers(src.getElementParts());
+        bool isDstContiguous = dst->getElementSize() == src.getElement(0).getViewSize();
+        groupTransfers = groupElementsIntoTransfers(src, nElementsPerGroup, isDstContiguous);
 
-        srcNElements = src.getNumberOfElements();
-        dstNElements = dst->getNumberOfElements();
-        nTransfersPerElement = elementTransfers.size();
+        srcNGroups = src.getNumberOfElements() / nElementsPerGroup;
+        dstNGroups = dst->getNumberOfElements() / nElementsPerGroup;
+        nTransfersPerGroup = groupTransfers.size();
         // Number of transfer src points.
-        srcNTransfers = nTransfersPerElement*srcNElements; // Should be <= 256
+        srcNTransfers = nTransfersPerGroup*srcNGroups; // Should be <= 256
         // Number of transfer dst points.
-        dstNTransfers = nTransfersPerElement*dstNElements; // Can be > 256
+        dstNTransfers = nTransfersPerGroup*dstNGroups; // Can be > 256
 
         ARRUS_REQUIRES_AT_MOST(srcNTransfers, MAX_N_TRANSFERS, "Exceeded maximum number of transfers.");
+        strategy = getStrategy(srcNTransfers, dstNTransfers);
+        ARRUS_REQUIRES_AT_MOST(transferIdxOffset + getNumberOfTransfers(), MAX_N_TRANSFERS,
+                               "Exceeded maximum number of transfers.");
+    }
 
+    /**
+     * Returns the number of us4OEM transfers used by this registrar, starting from transferIdxOffset.
+     */
+    size_t getNumberOfTransfers() const {
+        return strategy == 2 ? srcNTransfers : dstNTransfers;
+    }
+
+    /**
+     * Returns the transfer strategy (0, 1 or 2, see ARRUS_ON_NEW_DATA_CALLBACK_strategy_*) that should be used
+     * for the given number of src (us4OEM) and dst (host) transfer points.
+     */
+    static int getStrategy(size_t srcNTransfers, size_t dstNTransfers) {
         // If true: create only nSrc transfers, the callback function will reprogram the appropriate number transfers.
         if(dstNTransfers > MAX_N_TRANSFERS) {
-            strategy = 2;
+            return 2;
         }
         else if(dstNTransfers > srcNTransfers) {
             // reschedule needed
-            strategy = 1;
+            return 1;
         }
         else {
             // nTransferDst == nTransferSrc
-            strategy = 0;
+            return 0;
         }
     }
 
     void registerTransfers() {
+        ARRUS_TRACE_SCOPE_VALUE("upload", "registerTransfers", us4oemOrdinal);
         // Page-lock all host dest points.
         pageLockDstMemory();
 
         // Send page descriptors to us4OEM DMA.
-        size_t nSrcPoints = srcNElements;
-        size_t nDstPoints = strategy == 2 ? srcNElements : dstNElements;
+        size_t nSrcPoints = srcNGroups;
+        size_t nDstPoints = strategy == 2 ? srcNGroups : dstNGroups;
 
         programTransfers(nSrcPoints, nDstPoints);
         scheduleTransfers();
@@ -88,49 +136,116 @@ public:
     }
 
     void cleanupSequencerTransfers() {
-        uint16 elementFirstFiring = 0;
-        for(uint16 srcIdx = 0; srcIdx < srcNElements; ++srcIdx) {
-            for(auto &transfer: elementTransfers) {
-                auto firing = elementFirstFiring + transfer.firing;
+        uint16 groupFirstFiring = 0;
+        for(uint16 srcIdx = 0; srcIdx < srcNGroups; ++srcIdx) {
+            for(auto &transfer: groupTransfers) {
+                auto firing = groupFirstFiring + transfer.firing;
                 ius4oem->ClearTransferRXBufferToHost(firing);
             }
             // element.getFiring() -- the last firing of the given element
-            elementFirstFiring = srcBuffer.getElement(srcIdx).getFiring() + 1;
+            groupFirstFiring = getGroupLastFiring(srcIdx) + 1;
         }
     }
 
+    /**
+     * Groups the given parts into transfers of at most MAX_TRANSFER_SIZE bytes.
+     *
+     * The parts are grouped in the order of their addresses (which may differ from the order of firings, e.g.
+     * for the metadata-only RX NOPs). Each transfer is triggered by the last firing that writes to its memory range;
+     * the output transfers are ordered by firing. A transfer covers only parts that are contiguous both in the
+     * us4OEM and host memory (the parts of a transfer ROI view may not be).
+     */
     static std::vector<Transfer> groupPartsIntoTransfers(const std::vector<Us4OEMBufferElementPart> &parts) {
+        std::vector<Us4OEMBufferElementPart> sortedParts(parts);
+        std::stable_sort(std::begin(sortedParts), std::end(sortedParts),
+                         [](const auto &a, const auto &b) { return a.getAddress() < b.getAddress(); });
         std::vector<Transfer> transfers;
-        size_t address = 0;
+        size_t address = sortedParts.at(0).getAddress();
+        size_t dstAddress = sortedParts.at(0).getDstAddress();
         size_t size = 0;
-        uint16 firing = parts.at(0).getFiring();
-        for(auto &part: parts) {
+        uint16 firing = sortedParts.at(0).getFiring();
+        for(auto &part: sortedParts) {
+            if(part.getSize() == 0) {
+                // Nothing to transfer, but the transfer cannot be triggered before this firing.
+                if(size > 0) {
+                    firing = std::max(firing, part.getFiring());
+                }
+                continue;
+            }
+            bool isContiguous = part.getAddress() == address + size && part.getDstAddress() == dstAddress + size;
             // Assumption: size of each part is less than the possible maximum
-            if(size + part.getSize() > MAX_TRANSFER_SIZE) {
-                transfers.emplace_back(address, size, firing);
-                address = part.getAddress();
+            if(size > 0 && (!isContiguous || size + part.getSize() > MAX_TRANSFER_SIZE)) {
+                transfers.emplace_back(address, dstAddress, size, firing, 0);
                 size = 0;
             }
+            if(size == 0) {
+                address = part.getAddress();
+                dstAddress = part.getDstAddress();
+                firing = part.getFiring();
+            }
             size += part.getSize();
-            firing = part.getFiring();
+            firing = std::max(firing, part.getFiring());
         }
         if(size > 0) {
-            transfers.emplace_back(address, size, firing);
+            transfers.emplace_back(address, dstAddress, size, firing, 0);
         }
+        std::stable_sort(std::begin(transfers), std::end(transfers),
+                         [](const auto &a, const auto &b) { return a.firing < b.firing; });
         return transfers;
     }
 
+    /**
+     * Groups the parts of nElements consecutive src elements into transfers.
+     *
+     * If the elements are contiguous in both us4OEM and host memory (isDstContiguous), the parts of all elements
+     * are grouped together, so a single transfer can cover multiple elements. Otherwise the transfers of each
+     * element are kept separately. Transfer firings are relative to the first firing of the group.
+     */
+    static std::vector<Transfer> groupElementsIntoTransfers(const Us4OEMBuffer &src, uint16 nElements,
+                                                            bool isDstContiguous) {
+        const auto &parts = src.getElementParts();
+        size_t elementSize = src.getElement(0).getViewSize();
+        size_t partsSize = std::accumulate(std::begin(parts), std::end(parts), (size_t)0,
+                                           [](const auto &a, const auto &b) { return a + b.getSize(); });
+        bool isSrcContiguous = partsSize == elementSize;
+        std::vector<uint16> elementFirstFirings;
+        for(uint16 i = 0; i < nElements; ++i) {
+            elementFirstFirings.push_back(i == 0 ? 0 : (uint16)(src.getElement(i-1).getFiring() + 1));
+            size_t expectedAddress = src.getElement(0).getAddress() + i*elementSize;
+            isSrcContiguous = isSrcContiguous && src.getElement(i).getAddress() == expectedAddress;
+        }
+        std::vector<Transfer> result;
+        if(nElements > 1 && isSrcContiguous && isDstContiguous) {
+            std::vector<Us4OEMBufferElementPart> groupParts;
+            for(uint16 i = 0; i < nElements; ++i) {
+                for(auto &part: parts) {
+                    groupParts.emplace_back(i*elementSize + part.getAddress(), i*elementSize + part.getDstAddress(),
+                                            part.getSize(), (uint16)(elementFirstFirings[i] + part.getFiring()),
+                                            part.getNSamples());
+                }
+            }
+            result = groupPartsIntoTransfers(groupParts);
+        }
+        else {
+            auto elementTransfers = groupPartsIntoTransfers(parts);
+            for(uint16 i = 0; i < nElements; ++i) {
+                for(auto &transfer: elementTransfers) {
+                    result.emplace_back(transfer.address, transfer.dstAddress, transfer.size,
+                                        (uint16)(elementFirstFirings[i] + transfer.firing), i);
+                }
+            }
+        }
+        return result;
+    }
+
     void pageLockDstMemory() {
-        for(uint16 dstIdx = 0, srcIdx = 0; dstIdx < dstNElements; ++dstIdx, srcIdx = (srcIdx+1) % srcNElements) {
-            uint8 *addressDst = dstBuffer->getAddress(dstIdx, us4oemOrdinal);
-            // NOTE: addressSrc should be the address of the complete buffer element here -- even if
-            // we are processing some sub-sequence buffer here (i.e. setSubsequence was used).
-            // The reason for that is that the transfer src address is relative to the begining of the FULL buffer
-            // element (because element parts are relative to the FULL element).
-            size_t addressSrc = srcBuffer.getElement(srcIdx).getAddress(); // byte-addressed
-            for(auto &transfer: elementTransfers) {
-                uint8 *dst = addressDst + transfer.address;
-                size_t src = addressSrc + transfer.address;
+        for(uint16 dstIdx = 0, srcIdx = 0; dstIdx < dstNGroups; ++dstIdx, srcIdx = (srcIdx+1) % srcNGroups) {
+            for(auto &transfer: groupTransfers) {
+                // NOTE: the transfer src address is relative to the beginning of the src element (view), the dst
+                // address -- to the beginning of the host buffer element (these are different e.g. for
+                // the transfer ROI views).
+                uint8 *dst = getDstAddress(dstIdx, transfer) + transfer.dstAddress;
+                size_t src = getSrcAddress(srcIdx, transfer) + transfer.address;
                 size_t size = transfer.size;
                 ius4oem->PrepareHostBuffer(dst, size, src, false);
             }
@@ -138,12 +253,11 @@ public:
     }
 
     void pageUnlockDstMemory() {
-        for(uint16 dstIdx = 0, srcIdx = 0; dstIdx < dstNElements; ++dstIdx, srcIdx = (srcIdx+1) % srcNElements) {
-            uint8 *addressDst = dstBuffer->getAddressUnsafe(dstIdx, us4oemOrdinal);
-            size_t addressSrc = srcBuffer.getElement(srcIdx).getAddress(); // byte-addressed
-            for(auto &transfer: elementTransfers) {
-                uint8 *dst = addressDst + transfer.address;
-                size_t src = addressSrc + transfer.address;
+        for(uint16 dstIdx = 0, srcIdx = 0; dstIdx < dstNGroups; ++dstIdx, srcIdx = (srcIdx+1) % srcNGroups) {
+            for(auto &transfer: groupTransfers) {
+                uint8 *dst = dstBuffer->getAddressUnsafe(dstIdx*nElementsPerGroup + transfer.element, us4oemOrdinal)
+                             + transfer.dstAddress;
+                size_t src = getSrcAddress(srcIdx, transfer) + transfer.address;
                 size_t size = transfer.size;
                 ius4oem->ReleaseTransferRxBufferToHost(dst, size, src);
             }
@@ -152,15 +266,13 @@ public:
 
     void programTransfers(size_t nSrcPoints, size_t nDstPoints) {
         for(uint16 dstIdx = 0, srcIdx = 0; dstIdx < nDstPoints; ++dstIdx, srcIdx = (srcIdx+1) % nSrcPoints) {
-            uint8 *addressDst = dstBuffer->getAddress(dstIdx, us4oemOrdinal);
-            size_t addressSrc = srcBuffer.getElement(srcIdx).getAddress(); // byte-addressed
-            for(size_t localTransferIdx = 0; localTransferIdx < nTransfersPerElement; ++localTransferIdx) {
-                auto &transfer = elementTransfers[localTransferIdx];
-                size_t transferIdx = dstIdx * nTransfersPerElement + localTransferIdx; // global transfer idx
-                uint8 *dst = addressDst + transfer.address;
-                size_t src = addressSrc + transfer.address;
+            for(size_t localTransferIdx = 0; localTransferIdx < nTransfersPerGroup; ++localTransferIdx) {
+                auto &transfer = groupTransfers[localTransferIdx];
+                size_t transferIdx = dstIdx * nTransfersPerGroup + localTransferIdx; // global transfer idx
+                uint8 *dst = getDstAddress(dstIdx, transfer) + transfer.dstAddress;
+                size_t src = getSrcAddress(srcIdx, transfer) + transfer.address;
                 size_t size = transfer.size;
-                ius4oem->PrepareTransferRXBufferToHost(transferIdx, dst, size, src, false);
+                ius4oem->PrepareTransferRXBufferToHost(transferIdxOffset + transferIdx, dst, size, src, false);
             }
         }
     }
@@ -168,10 +280,11 @@ public:
 // ON NEW DATA CALLBACK POLICIES
 // TODO replace macros with templates after refactoring us4r-api
 #define ARRUS_ON_NEW_DATA_CALLBACK_signal_true \
-    dstBuffer->signal(us4oemOrdinal, currentDstIdx); \
-    currentDstIdx = (int16)((currentDstIdx + srcNElements) % dstNElements);
+    dstBuffer->signal(us4oemOrdinal, (uint16)(currentDstIdx*nElementsPerGroup), nElementsPerGroup); \
+    currentDstIdx = (int16)((currentDstIdx + srcNGroups) % dstNGroups);
 
-#define ARRUS_ON_NEW_DATA_CALLBACK_signal_false
+#define ARRUS_ON_NEW_DATA_CALLBACK_signal_false \
+    currentDstIdx = (int16)((currentDstIdx + srcNGroups) % dstNGroups);
 
 // Strategy 0: keep transfers as they are (nSrc == nDst)
 #define ARRUS_ON_NEW_DATA_CALLBACK_strategy_0
@@ -180,21 +293,23 @@ public:
 // (nSrc < nDst && nDst <= 256)
 #define ARRUS_ON_NEW_DATA_CALLBACK_strategy_1 \
     currentTransferIdx = (int16)((currentTransferIdx + srcNTransfers) % dstNTransfers); \
-    ius4oem->ScheduleTransferRXBufferToHost(transferLastFiring, currentTransferIdx, nullptr);
+    ius4oem->ScheduleTransferRXBufferToHost(transferLastFiring, transferIdxOffset + currentTransferIdx, nullptr);
 
 // Strategy 2: change transfer definition, so in the next call this transfer will write to subsequent dst element
 // (nDst > 256)
 #define ARRUS_ON_NEW_DATA_CALLBACK_strategy_2 \
-    uint16 nextElementIdx = (int16)((currentDstIdx + srcNElements) % dstNElements); \
-    auto nextDstAddress = dstBuffer->getAddress(nextElementIdx, us4oemOrdinal); \
-    nextDstAddress += transfer.address;                                    \
-    ius4oem->PrepareTransferRXBufferToHost(currentTransferIdx, nextDstAddress, transferSize, src, false);
+    uint16 nextGroupIdx = (int16)((currentDstIdx + srcNGroups) % dstNGroups); \
+    auto nextDstAddress = getDstAddress(nextGroupIdx, transfer); \
+    nextDstAddress += transfer.dstAddress;                                 \
+    ius4oem->PrepareTransferRXBufferToHost(transferIdxOffset + currentTransferIdx, nextDstAddress, transferSize, \
+                                           src, false);
 
 
 #define ARRUS_ON_NEW_DATA_CALLBACK(signal, strategy) \
 [=, currentDstIdx = srcIdx, currentTransferIdx = transferIdx] () mutable { \
     IGNORE_UNUSED(currentTransferIdx);               \
     IGNORE_UNUSED(currentDstIdx);                    \
+    ARRUS_TRACE_SCOPE_VALUE("us4oem", "irqCallback", us4oemOrdinal); \
     try {                                            \
         ARRUS_ON_NEW_DATA_CALLBACK_strategy_##strategy                             \
         ARRUS_ON_NEW_DATA_CALLBACK_signal_##signal                       \
@@ -208,20 +323,19 @@ public:
     void scheduleTransfers() {
         // Schedule transfers only from the start points (nSrc calls), dst pointers will be incremented
         // appropriately (if necessary).
-        uint16 elementFirstFiring = 0;
-        for(uint16 srcIdx = 0; srcIdx < srcNElements; ++srcIdx) {
-            size_t addressSrc = srcBuffer.getElement(srcIdx).getAddress(); // bytes addressed
-            uint16 elementLastFiring = srcBuffer.getElement(srcIdx).getFiring();
-            // for each element's part transfer:
-            for(uint16 localTransferIdx = 0; localTransferIdx < nTransfersPerElement; ++localTransferIdx) {
-                auto &transfer = elementTransfers[localTransferIdx];
-                size_t transferIdx = srcIdx*nTransfersPerElement + localTransferIdx; // global transfer idx
-                size_t src = addressSrc + transfer.address;
+        uint16 groupFirstFiring = 0;
+        for(uint16 srcIdx = 0; srcIdx < srcNGroups; ++srcIdx) {
+            uint16 groupLastFiring = getGroupLastFiring(srcIdx);
+            // for each group's part transfer:
+            for(uint16 localTransferIdx = 0; localTransferIdx < nTransfersPerGroup; ++localTransferIdx) {
+                auto &transfer = groupTransfers[localTransferIdx];
+                size_t transferIdx = srcIdx*nTransfersPerGroup + localTransferIdx; // global transfer idx
+                size_t src = getSrcAddress(srcIdx, transfer) + transfer.address;
                 size_t transferSize = transfer.size;
-                // transfer.firing - firing offset within (the whole) element
-                uint16 transferLastFiring = elementFirstFiring + transfer.firing;
+                // transfer.firing - firing offset within (the whole) group
+                uint16 transferLastFiring = groupFirstFiring + transfer.firing;
 
-                bool isLastTransfer = localTransferIdx == nTransfersPerElement-1;
+                bool isLastTransfer = localTransferIdx == nTransfersPerGroup-1;
                 std::function<void()> callback;
                 if(isLastTransfer) {
                     switch(strategy) {
@@ -239,23 +353,38 @@ public:
                         default: throw std::runtime_error("Unknown us4R buffer registrar strategy");
                     }
                 }
-                ius4oem->ScheduleTransferRXBufferToHost(transferLastFiring, transferIdx, callback);
+                ius4oem->ScheduleTransferRXBufferToHost(transferLastFiring, transferIdxOffset + transferIdx, callback);
             }
-            elementFirstFiring = elementLastFiring+1;
+            groupFirstFiring = groupLastFiring+1;
         }
     }
 
 private:
+    uint16 getGroupLastFiring(uint16 srcGroupIdx) const {
+        return srcBuffer.getElement(srcGroupIdx*nElementsPerGroup + nElementsPerGroup - 1).getFiring();
+    }
+
+    size_t getSrcAddress(uint16 srcGroupIdx, const Transfer &transfer) const {
+        return srcBuffer.getElement(srcGroupIdx*nElementsPerGroup + transfer.element).getAddress(); // byte-addressed
+    }
+
+    uint8 *getDstAddress(uint16 dstGroupIdx, const Transfer &transfer) const {
+        return dstBuffer->getAddress((uint16)(dstGroupIdx*nElementsPerGroup + transfer.element), us4oemOrdinal);
+    }
+
     Logger::Handle logger;
     Us4ROutputBuffer *dstBuffer{nullptr};
     const Us4OEMBuffer srcBuffer;
     // All derived parameters
     IUs4OEM *ius4oem{nullptr};
     Ordinal us4oemOrdinal{0};
-    std::vector<Transfer> elementTransfers;
-    size_t srcNElements{0};
-    size_t dstNElements{0};
-    size_t nTransfersPerElement{0};
+    uint16 nElementsPerGroup{1};
+    /** The number of the first us4OEM transfer used by this registrar. */
+    size_t transferIdxOffset{0};
+    std::vector<Transfer> groupTransfers;
+    size_t srcNGroups{0};
+    size_t dstNGroups{0};
+    size_t nTransfersPerGroup{0};
     // Number of transfer src points.
     size_t srcNTransfers{0};
     // Number of transfer dst points.
@@ -10,6 +10,22 @@ using ::arrus::devices::Us4OEMDataTransferRegistrar;
 using ::arrus::devices::Us4OEMBufferElementPart;
 using ::arrus::devices::Transfer;
 using ::arrus::devices::Us4OEMImpl;
+using ::arrus::devices::Us4OEMBuffer;
+using ::arrus::devices::Us4OEMBufferElement;
+
+// 4 elements, 2 parts (firings) each, 1024 bytes per part.
+Us4OEMBuffer getTestUs4OEMBuffer() {
+    std::vector<Us4OEMBufferElementPart> parts{
+        Us4OEMBufferElementPart{0, 1024, 0, 16},
+        Us4OEMBufferElementPart{1024, 1024, 1, 16},
+    };
+    std::vector<Us4OEMBufferElement> elements;
+    for(uint16_t i = 0; i < 4; ++i) {
+        elements.emplace_back(i*2048, 2048, (uint16_t)(2*i+1), ::arrus::framework::NdArray::Shape{32, 32},
+                              ::arrus::framework::NdArray::DataType::INT16);
+    }
+    return Us4OEMBuffer(elements, parts);
+}
 
 TEST(Us4OEMDataTransferRegistrarTest, CorrectlyPassesSinglePartAsSingleTransfer) {
     std::vector<Us4OEMBufferElementPart> parts{
@@ -79,6 +95,75 @@ TEST(Us4OEMDataTransferRegistrarTest, CorrectlyGroupsMultiplePartsIntoThreeTrans
     };
     ASSERT_EQ(transfers, expected);
 }
+
+TEST(Us4OEMDataTransferRegistrarTest, GroupsPartsInTheOrderOfAddresses) {
+    // Firing 1: metadata-only RX NOP, stored after the data frames.
+    std::vector<Us4OEMBufferElementPart> parts{
+        Us4OEMBufferElementPart{0, 1024, 0, 16},
+        Us4OEMBufferElementPart{2048, 64, 1, 1},
+        Us4OEMBufferElementPart{1024, 1024, 2, 16},
+    };
+    auto transfers = Us4OEMDataTransferRegistrar::groupPartsIntoTransfers(parts);
+    std::vector<Transfer> expected{
+        Transfer{0, 2048 + 64, 2}
+    };
+    ASSERT_EQ(transfers, expected);
+}
+
+TEST(Us4OEMDataTransferRegistrarTest, KeepsElementTransfersWhenNotCoalescing) {
+    auto transfers = Us4OEMDataTransferRegistrar::groupElementsIntoTransfers(getTestUs4OEMBuffer(), 1, true);
+    std::vector<Transfer> expected{
+        Transfer{0, 2048, 1}
+    };
+    ASSERT_EQ(transfers, expected);
+}
+
+TEST(Us4OEMDataTransferRegistrarTest, GroupsContiguousElementsIntoSingleTransfer) {
+    auto transfers = Us4OEMDataTransferRegistrar::groupElementsIntoTransfers(getTestUs4OEMBuffer(), 2, true);
+    std::vector<Transfer> expected{
+        Transfer{0, 4096, 3}
+    };
+    ASSERT_EQ(transfers, expected);
+}
+
+TEST(Us4OEMDataTransferRegistrarTest, KeepsTransfersOfEachElementWhenHostMemoryIsNotContiguous) {
+    auto transfers = Us4OEMDataTransferRegistrar::groupElementsIntoTransfers(getTestUs4OEMBuffer(), 2, false);
+    std::vector<Transfer> expected{
+        Transfer{0, 2048, 1, 0},
+        Transfer{0, 2048, 3, 1}
+    };
+    ASSERT_EQ(transfers, expected);
+}
+
+TEST(Us4OEMDataTransferRegistrarTest, TransferRoiViewPacksSampleWindowsOfEachPart) {
+    // Samples [4, 12) of each part, 64 bytes per sample.
+    auto view = getTestUs4OEMBuffer().getTransferRoiView(0, 1, 2, 4, 12);
+    EXPECT_EQ(view.getElement(1).getAddress(), 2048);
+    EXPECT_EQ(view.getElement(1).getViewSize(), 1024);
+    EXPECT_EQ(view.getElement(1).getViewShape(), (::arrus::framework::NdArray::Shape{16, 32}));
+    auto transfers = Us4OEMDataTransferRegistrar::groupElementsIntoTransfers(view, 1, true);
+    std::vector<Transfer> expected{
+        Transfer{256, 0, 512, 0, 0},
+        Transfer{1024 + 256, 512, 512, 1, 0}
+    };
+    ASSERT_EQ(transfers, expected);
+}
+
+TEST(Us4OEMDataTransferRegistrarTest, TransferRoiViewSkipsOpsOutsideTheFrameRange) {
+    auto view = getTestUs4OEMBuffer().getTransferRoiView(1, 1, 2, 0, 16);
+    EXPECT_EQ(view.getElement(0).getViewSize(), 1024);
+    auto transfers = Us4OEMDataTransferRegistrar::groupElementsIntoTransfers(view, 2, false);
+    std::vector<Transfer> expected{
+        Transfer{1024, 0, 1024, 1, 0},
+        Transfer{1024, 0, 1024, 3, 1}
+    };
+    ASSERT_EQ(transfers, expected);
+}
+
+TEST(Us4OEMDataTransferRegistrarTest, TransferRoiViewRequiresSamplesToBeAcquired) {
+    EXPECT_THROW(getTestUs4OEMBuffer().getTransferRoiView(0, 1, 2, 8, 17), ::arrus::IllegalArgumentException);
+    EXPECT_THROW(getTestUs4OEMBuffer().getTransferRoiView(0, 2, 2, 0, 16), ::arrus::IllegalArgumentException);
+}
 }
 
 
@@ -84,7 +84,7 @@ public:
         return elements.size();
     }
 
-    [[nodiscard]] bool empty() {
+    [[nodiscard]] bool empty() const {
         return elements.empty();
     }
 
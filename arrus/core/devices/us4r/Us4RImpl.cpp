@@ -1,12 +1,17 @@
 #include "Us4RImpl.h"
 #include "arrus/core/devices/us4r/validators/RxSettingsValidator.h"
+#include "arrus/core/devices/us4r/common.h"
 
 #include "arrus/core/common/interpolate.h"
+#include "arrus/core/common/tracing.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <memory>
 #include <thread>
 #include <future>
+#include <limits>
 
 #define ARRUS_ASSERT_RX_SETTINGS_SET()                                                                                 \
     if (!rxSettings.has_value()) {                                                                                     \
@@ -20,6 +25,7 @@ using ::arrus::framework::DataBufferSpec;
 using ::arrus::ops::us4r::Pulse;
 using ::arrus::ops::us4r::Rx;
 using ::arrus::ops::us4r::Scheme;
+using ::arrus::ops::us4r::TransferRoi;
 using ::arrus::ops::us4r::Tx;
 using ::arrus::ops::us4r::TxRxSequence;
 
@@ -233,45 +239,214 @@ void Us4RImpl::disableHV() {
 
 std::pair<Buffer::SharedHandle, arrus::session::Metadata::SharedHandle>
 Us4RImpl::upload(const Scheme &scheme) {
+    ARRUS_TRACE_SCOPE("upload", "Us4R::upload");
+    return program(compile(scheme));
+}
+
+Us4RImpl::CompiledScheme::Handle Us4RImpl::compile(const Scheme &scheme, const ProgressCallback &onProgress) {
+    ARRUS_TRACE_SCOPE("upload", "Us4R::compile");
+    auto reportProgress = [&onProgress](float progress) {
+        if (onProgress) {
+            onProgress(progress);
+        }
+    };
     auto &outputBufferSpec = scheme.getOutputBuffer();
     auto rxBufferNElements = scheme.getRxBufferSize();
-    auto workMode = scheme.getWorkMode();
-
     unsigned hostBufferNElements = outputBufferSpec.getNumberOfElements();
+    auto &seq = scheme.getTxRxSequence();
+    auto &transferRoi = scheme.getTransferRoi();
+
+    validateScheme(scheme);
+    reportProgress(0.1f);
+
+    auto txrxs = getTxRxParameters(seq, scheme.getDigitalDownConversion());
+    auto sequence = compileSequence(seq, txrxs, rxBufferNElements, seq.getNRepeats(), scheme.getWorkMode(),
+                                    scheme.getDigitalDownConversion(), scheme.getConstants());
+    reportProgress(0.7f);
+    Us4RBuffer::Handle rxBuffer;
+    FrameChannelMapping::Handle fcm;
+    if (transferRoi.has_value()) {
+        // The complete sequence is acquired, only the transfers to the host are limited to the ROI.
+        std::tie(rxBuffer, fcm) = getProbeImpl()->getTransferRoiView(sequence, transferRoi.value());
+    } else {
+        rxBuffer = sequence.adapterSequence.getBuffer();
+        fcm = FrameChannelMappingBuilder::copy(dynamic_cast<const FrameChannelMappingImpl &>(*sequence.fcm)).build();
+    }
+    // All us4OEMs execute the same number of TX/RXs with the same PRIs, the master module determines the timing.
+    float sequenceDuration = sequence.adapterSequence.us4oemSequences.at(0).duration;
+    auto nCoalescedElements =
+        getNumberOfCoalescedElements(outputBufferSpec, rxBufferNElements, seq.getNRepeats(), sequenceDuration,
+                                     scheme.getWorkMode());
+    auto hostBuffer = createHostBuffer(hostBufferNElements, *rxBuffer, transferRoi);
+    reportProgress(1.0f);
+    std::vector<float> pris;
+    std::transform(std::begin(txrxs), std::end(txrxs), std::back_inserter(pris),
+                   [](const auto &txrx) { return txrx.getPri(); });
+    return std::make_unique<CompiledScheme>(CompiledScheme{scheme, std::move(sequence), std::move(rxBuffer),
+                                                           std::move(fcm), nCoalescedElements, std::move(pris),
+                                                           std::move(hostBuffer)});
+}
+
+std::pair<Buffer::SharedHandle, arrus::session::Metadata::SharedHandle>
+Us4RImpl::program(CompiledScheme::Handle compiled, const ProgressCallback &onProgress) {
+    ARRUS_TRACE_SCOPE("upload", "Us4R::program");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(compiled != nullptr, "The compiled scheme should be provided.");
+    auto reportProgress = [&onProgress](float progress) {
+        if (onProgress) {
+            onProgress(progress);
+        }
+    };
+    std::unique_lock<std::mutex> guard(deviceStateMutex);
+    if (this->state == State::STARTED) {
+        throw IllegalStateException("The device is running, uploading sequence is forbidden.");
+    }
+    const auto &scheme = compiled->scheme;
+    getProbeImpl()->programTxRxSequence(compiled->sequence);
+    reportProgress(0.5f);
+    // Page-locking the host buffer takes the most of the remaining time.
+    prepareHostBuffer(std::move(compiled->buffer), std::move(compiled->rxBuffer), scheme.getWorkMode(), false,
+                      compiled->nCoalescedElements,
+                      [&reportProgress](float progress) { reportProgress(0.5f + 0.5f * progress); });
+    this->currentTransferRoi = scheme.getTransferRoi();
+    this->currentScheme = scheme;
+    this->currentPris = std::move(compiled->pris);
+    return {this->buffer, createUploadMetadata(std::move(compiled->fcm), 0,
+                                               static_cast<uint16>(currentPris.size() - 1))};
+}
 
-    // Validate input parameters.
+void Us4RImpl::validateScheme(const Scheme &scheme) {
     ARRUS_REQUIRES_EQUAL(
         getDefaultComponent(), probe.value().get(),
         IllegalArgumentException("Currently TxRx sequence upload is available for system with probes only."));
+    unsigned hostBufferNElements = scheme.getOutputBuffer().getNumberOfElements();
+    auto rxBufferNElements = scheme.getRxBufferSize();
     if ((hostBufferNElements % rxBufferNElements) != 0) {
         throw IllegalArgumentException(
             format("The size of the host buffer {} must be equal or a multiple of the size of the rx buffer {}.",
                    hostBufferNElements, rxBufferNElements));
     }
+    auto &transferRoi = scheme.getTransferRoi();
+    if (transferRoi.has_value()) {
+        auto [sampleBegin, sampleEnd] = transferRoi->getSampleRange();
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(sampleBegin < sampleEnd,
+                                         format("Invalid transfer ROI sample range: [{}, {})", sampleBegin, sampleEnd));
+        ARRUS_REQUIRES_TRUE_E(!rxNopsMetadataOnly, IllegalArgumentException(
+            "Transfer ROI is not available when the RX NOPs acquire frame metadata only."));
+    }
+}
+
+void Us4RImpl::uploadResidentSubsequences(const Scheme &scheme, const std::vector<Subsequence> &subsequences) {
+    ARRUS_TRACE_SCOPE("upload", "Us4R::uploadResidentSubsequences");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!subsequences.empty(), "At least one sub-sequence should be provided.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!scheme.getTransferRoi().has_value(),
+                                     "Sub-sequences are not available for the scheme with the transfer ROI.");
+    ARRUS_REQUIRES_TRUE_E(!rxNopsMetadataOnly, IllegalArgumentException(
+        "Sub-sequences are not available when the RX NOPs acquire frame metadata only."));
+    validateScheme(scheme);
+    auto &seq = scheme.getTxRxSequence();
+    auto rxBufferNElements = scheme.getRxBufferSize();
+    auto txrxs = getTxRxParameters(seq, scheme.getDigitalDownConversion());
+    auto sequence = compileSequence(seq, txrxs, rxBufferNElements, seq.getNRepeats(), scheme.getWorkMode(),
+                                    scheme.getDigitalDownConversion(), scheme.getConstants());
+    // Host part: the buffers and FCMs of all the sub-sequences.
+    const auto &logicalToPhysicalOp = sequence.adapterSequence.logicalToPhysicalOp;
+    const auto &masterSequence = sequence.adapterSequence.us4oemSequences.at(0);
+    std::vector<ResidentSubsequence> residents;
+    for (const auto &subsequence : subsequences) {
+        const auto &spec = subsequence.outputBuffer;
+        if ((spec.getNumberOfElements() % rxBufferNElements) != 0) {
+            throw IllegalArgumentException(
+                format("The size of the host buffer {} must be equal or a multiple of the size of the rx buffer {}.",
+                       spec.getNumberOfElements(), rxBufferNElements));
+        }
+        auto [rxBuffer, fcm] = getProbeImpl()->getSubsequenceView(sequence, subsequence.start, subsequence.end);
+        // All us4OEMs execute the same number of TX/RXs with the same PRIs, the master module determines the timing.
+        float duration = Us4OEMImpl::getSubsequenceDuration(masterSequence.txrxs,
+                                                            logicalToPhysicalOp.at(subsequence.start).first,
+                                                            logicalToPhysicalOp.at(subsequence.end).second,
+                                                            subsequence.sri);
+        auto nCoalescedElements = getNumberOfCoalescedElements(spec, rxBufferNElements, seq.getNRepeats(), duration,
+                                                               scheme.getWorkMode());
+        auto hostBuffer = createHostBuffer(spec.getNumberOfElements(), *rxBuffer, std::nullopt);
+        residents.push_back(ResidentSubsequence{subsequence, std::move(hostBuffer), std::move(rxBuffer),
+                                                std::move(fcm), nCoalescedElements, {}});
+    }
+
     std::unique_lock<std::mutex> guard(deviceStateMutex);
     if (this->state == State::STARTED) {
         throw IllegalStateException("The device is running, uploading sequence is forbidden.");
     }
-    auto &seq = scheme.getTxRxSequence();
-
-    auto [rxBuffer, fcm] = uploadSequence(seq, rxBufferNElements, seq.getNRepeats(), scheme.getWorkMode(),
-                                          scheme.getDigitalDownConversion(), scheme.getConstants());
-
-    prepareHostBuffer(hostBufferNElements, workMode, rxBuffer);
-    // NOTE: starting from this point, rxBuffer is no longer a valid variable
-    // Metadata
-    arrus::session::MetadataBuilder metadataBuilder;
-    metadataBuilder.add<FrameChannelMapping>("frameChannelMapping", std::move(fcm));
+    getProbeImpl()->programTxRxSequence(sequence);
+    releaseHostBuffer(false);
+    this->residentSubsequences = std::move(residents);
     this->currentScheme = scheme;
-    return {this->buffer, metadataBuilder.buildPtr()};
+    this->currentPris.clear();
+    std::transform(std::begin(txrxs), std::end(txrxs), std::back_inserter(currentPris),
+                   [](const auto &txrx) { return txrx.getPri(); });
+    this->currentTransferRoi = std::nullopt;
+    // The firings of the sub-sequences are disjoint and each of them uses a separate range of the us4OEM transfers,
+    // so the transfers of all of them can be registered at once.
+    try {
+        std::vector<size_t> transferIdxOffsets(us4oems.size(), 0);
+        for (auto &resident : this->residentSubsequences) {
+            resident.transferRegistrar.resize(us4oems.size());
+            for (Ordinal ordinal = 0; ordinal < us4oems.size(); ++ordinal) {
+                auto registrar = registerOutputBuffer(
+                    resident.buffer.get(), resident.rxBuffer->getUs4oemBuffer(ordinal), us4oems[ordinal].get(),
+                    scheme.getWorkMode(), resident.nCoalescedElements, transferIdxOffsets[ordinal]);
+                if (registrar) {
+                    transferIdxOffsets[ordinal] += registrar->getNumberOfTransfers();
+                }
+                resident.transferRegistrar[ordinal] = std::move(registrar);
+            }
+        }
+    } catch (...) {
+        unregisterOutputBuffer(false);
+        throw;
+    }
+}
+
+std::pair<Buffer::SharedHandle, arrus::session::Metadata::SharedHandle>
+Us4RImpl::switchResidentSubsequence(size_t subsequence) {
+    ARRUS_TRACE_SCOPE("upload", "Us4R::switchResidentSubsequence");
+    std::unique_lock<std::mutex> guard(deviceStateMutex);
+    if (this->state == State::STARTED) {
+        throw IllegalStateException("The device is running, switching the sub-sequence is forbidden.");
+    }
+    if (residentSubsequences.empty()) {
+        throw IllegalStateException("Please upload the sub-sequences before switching them.");
+    }
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        subsequence < residentSubsequences.size(),
+        format("Sub-sequence number {} is out of the range of uploaded sub-sequences [0, {}).", subsequence,
+               residentSubsequences.size()));
+    auto &resident = residentSubsequences[subsequence];
+    const auto &subsequenceRange = resident.subsequence;
+    getProbeImpl()->programSubsequence(subsequenceRange.start, subsequenceRange.end, subsequenceRange.sri);
+    if (this->buffer && this->buffer != resident.buffer) {
+        this->buffer->shutdown();
+    }
+    this->buffer = resident.buffer;
+    this->buffer->setStatisticsCollector(acquisitionStatistics);
+    for (Ordinal ordinal = 0; ordinal < us4oems.size(); ++ordinal) {
+        if (resident.transferRegistrar.at(ordinal)) {
+            registerOverflowCallbacks(this->buffer.get(), us4oems[ordinal].get(),
+                                      this->currentScheme.value().getWorkMode());
+        }
+    }
+    return {this->buffer,
+            createUploadMetadata(
+                FrameChannelMappingBuilder::copy(dynamic_cast<const FrameChannelMappingImpl &>(*resident.fcm)).build(),
+                subsequenceRange.start, subsequenceRange.end)};
 }
 
-void Us4RImpl::prepareHostBuffer(unsigned nElements, Scheme::WorkMode workMode, std::unique_ptr<Us4RBuffer> &rxBuffer,
-                                 bool cleanupSequencer) {
-    ARRUS_REQUIRES_TRUE(!rxBuffer->empty(), "Us4R Rx buffer cannot be empty.");
+std::shared_ptr<Us4ROutputBuffer> Us4RImpl::createHostBuffer(unsigned nElements, const Us4RBuffer &rxBuffer,
+                                                             const std::optional<TransferRoi> &transferRoi) {
+    ARRUS_TRACE_SCOPE("upload", "createHostBuffer");
+    ARRUS_REQUIRES_TRUE(!rxBuffer.empty(), "Us4R Rx buffer cannot be empty.");
 
     // Calculate how much of the data each Us4OEM produces.
-    auto &element = rxBuffer->getElement(0);
+    auto &element = rxBuffer.getElement(0);
     // a vector, where value[i] contains a size that is produced by a single us4oem.
     std::vector<size_t> us4oemComponentSize(element.getNumberOfUs4oems(), 0);
     int i = 0;
@@ -280,26 +455,79 @@ void Us4RImpl::prepareHostBuffer(unsigned nElements, Scheme::WorkMode workMode,
     }
     auto &shape = element.getShape();
     auto dataType = element.getDataType();
-    // If the output buffer already exists - remove it.
-    if (this->buffer) {
-        // The buffer should be already unregistered (after stopping the device).
-        this->buffer->shutdown();
-        // We must be sure here, that there is no thread working on the us4rBuffer here.
-        if (this->us4rBuffer) {
-            unregisterOutputBuffer(cleanupSequencer);
-            this->us4rBuffer.reset();
-        }
-        this->buffer.reset();
-    }
-    // Create output buffer.
-    this->buffer =
+    auto hostBuffer =
         std::make_shared<Us4ROutputBuffer>(us4oemComponentSize, shape, dataType, nElements, stopOnOverflow);
-    registerOutputBuffer(this->buffer.get(), rxBuffer, workMode);
+    hostBuffer->setFrameMetadataOffsets(getFrameMetadataOffsets(rxBuffer, *hostBuffer, transferRoi));
+    return hostBuffer;
+}
+
+void Us4RImpl::prepareHostBuffer(std::shared_ptr<Us4ROutputBuffer> hostBuffer, Us4RBuffer::Handle rxBuffer,
+                                 Scheme::WorkMode workMode, bool cleanupSequencer, uint16 nCoalescedElements,
+                                 const ProgressCallback &onProgress) {
+    ARRUS_TRACE_SCOPE("upload", "prepareHostBuffer");
+    // If the output buffer already exists - remove it.
+    releaseHostBuffer(cleanupSequencer);
+    this->buffer = std::move(hostBuffer);
+    // Only the active buffer reports to the collector (a compiled buffer may be still discarded).
+    this->buffer->setStatisticsCollector(acquisitionStatistics);
+    registerOutputBuffer(this->buffer.get(), rxBuffer, workMode, nCoalescedElements, onProgress);
 
     // Note: use only as a marker, that the upload was performed, and there is still some memory to unlock.
     this->us4rBuffer = std::move(rxBuffer);
 }
 
+std::vector<size_t> Us4RImpl::getFrameMetadataOffsets(const Us4RBuffer &rxBuffer, const Us4ROutputBuffer &hostBuffer,
+                                                      const std::optional<TransferRoi> &transferRoi) const {
+    std::vector<size_t> offsets;
+    if(!probeAdapter.has_value()) {
+        return offsets;
+    }
+    Ordinal oem = probeAdapter.value()->getFrameMetadataOem();
+    if(oem >= rxBuffer.getElement(0).getNumberOfUs4oems()) {
+        return offsets;
+    }
+    const auto us4oemBuffer = rxBuffer.getUs4oemBuffer(oem);
+    const auto &parts = us4oemBuffer.getElementParts();
+    if(parts.empty()) {
+        return offsets;
+    }
+    if(transferRoi.has_value() && transferRoi->getSampleRange().first > 0) {
+        // The frame metadata is stored in the first samples of each frame, which are not transferred.
+        return offsets;
+    }
+    // The host buffer contains the view only, the part dst addresses are relative to the view.
+    const size_t viewSize = rxBuffer.getElement(0).getUs4oemComponent(oem).getViewSize();
+    const size_t us4oemOffset = hostBuffer.getUs4oemOffset(oem);
+    // (firing, offset)
+    std::vector<std::pair<uint16, size_t>> frames;
+    for(const auto &part: parts) {
+        // Skip the ops that do not acquire any data (e.g. RX NOPs without metadata).
+        if(part.getSize() == 0 || part.getDstAddress() >= viewSize) {
+            continue;
+        }
+        frames.emplace_back(part.getFiring(), (us4oemOffset + part.getDstAddress()) / sizeof(int16));
+    }
+    // The order of acquisition, which is not the order of addresses in general (e.g. the metadata-only RX NOPs are
+    // placed after the data frames).
+    std::stable_sort(std::begin(frames), std::end(frames),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    for(const auto &[firing, offset]: frames) {
+        offsets.push_back(offset);
+    }
+    return offsets;
+}
+
+std::shared_ptr<arrus::session::Metadata> Us4RImpl::createUploadMetadata(FrameChannelMapping::Handle fcm, uint16 start,
+                                                                         uint16 end) const {
+    arrus::session::MetadataBuilder metadataBuilder;
+    metadataBuilder.add<FrameChannelMapping>("frameChannelMapping", std::move(fcm));
+    metadataBuilder.add<std::vector<size_t>>("frameMetadataOffsets",
+                                             std::make_shared<std::vector<size_t>>(buffer->getFrameMetadataOffsets()));
+    metadataBuilder.add<std::vector<float>>(
+        "pris", std::make_shared<std::vector<float>>(std::begin(currentPris) + start, std::begin(currentPris) + end + 1));
+    return metadataBuilder.buildPtr();
+}
+
 void Us4RImpl::start() {
     std::unique_lock<std::mutex> guard(deviceStateMutex);
     logger->log(LogSeverity::INFO, "Starting us4r.");
@@ -354,43 +582,35 @@ void Us4RImpl::stopDevice() {
 Us4RImpl::~Us4RImpl() {
     try {
         getDefaultLogger()->log(LogSeverity::DEBUG, "Closing connection with Us4R.");
+        this->stopTelemetry();
         this->stopDevice();
 	// TODO: the below should be part of session handler
-        if (this->buffer != nullptr) {
-            this->buffer->shutdown();
-            // We must be sure here, that there is no thread working on the us4rBuffer here.
-            if (this->us4rBuffer) {
-                unregisterOutputBuffer(false);
-                this->us4rBuffer.reset();
-            }
-        }
+        this->releaseHostBuffer(false);
         getDefaultLogger()->log(LogSeverity::INFO, "Connection to Us4R closed.");
     } catch(const std::exception &e) {
         std::cerr << "Exception while destroying handle to the Us4R device: " << e.what() << std::endl;
     }
 }
 
-std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-Us4RImpl::uploadSequence(const TxRxSequence &seq, uint16 bufferSize, uint16 batchSize,
-                         arrus::ops::us4r::Scheme::WorkMode workMode,
-                         const std::optional<ops::us4r::DigitalDownConversion> &ddc,
-                         const std::vector<framework::NdArray> &txDelayProfiles) {
-    std::vector<TxRxParameters> actualSeq;
+std::vector<TxRxParameters>
+Us4RImpl::getTxRxParameters(const TxRxSequence &seq, const std::optional<ops::us4r::DigitalDownConversion> &ddc) const {
     // Convert to intermediate representation (TxRxParameters).
-    size_t opIdx = 0;
-    for (const auto &txrx : seq.getOps()) {
-        auto &tx = txrx.getTx();
-        auto &rx = txrx.getRx();
-
-        Interval<uint32> sampleRange(rx.getSampleRange().first, rx.getSampleRange().second);
-        Tuple<ChannelIdx> padding({rx.getPadding().first, rx.getPadding().second});
-
-        actualSeq.push_back(TxRxParameters(tx.getAperture(), tx.getDelays(), tx.getExcitation(), rx.getAperture(),
-                                           sampleRange, rx.getDownsamplingFactor(), txrx.getPri(), padding));
-        ++opIdx;
+    std::vector<TxRxParameters> actualSeq = toTxRxParamsSequence(seq);
+    if (seq.getAutoPriMargin().has_value()) {
+        actualSeq = setMinimumPris(actualSeq, seq.getAutoPriMargin().value(), us4oems.at(0)->getReprogrammingMode(),
+                                   ddc);
     }
-    return getProbeImpl()->setTxRxSequence(actualSeq, seq.getTgcCurve(), bufferSize,
-                                           batchSize, seq.getSri(), workMode, ddc, txDelayProfiles);
+    return actualSeq;
+}
+
+ProbeSequence
+Us4RImpl::compileSequence(const TxRxSequence &seq, const std::vector<TxRxParameters> &txrxs, uint16 bufferSize,
+                          uint16 batchSize, arrus::ops::us4r::Scheme::WorkMode workMode,
+                          const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                          const std::vector<framework::NdArray> &txDelayProfiles) {
+    ARRUS_TRACE_SCOPE("upload", "compileSequence");
+    return getProbeImpl()->compileTxRxSequence(txrxs, seq.getTgcCurve(), bufferSize,
+                                               batchSize, seq.getSri(), workMode, ddc, txDelayProfiles);
 }
 
 void Us4RImpl::trigger(bool sync, std::optional<long long> timeout) {
@@ -601,7 +821,8 @@ void Us4RImpl::setAfe(uint8_t reg, uint16_t val) {
 }
 
 void Us4RImpl::registerOutputBuffer(Us4ROutputBuffer *outputBuffer, const Us4RBuffer::Handle &us4rDDRBuffer,
-                                            Scheme::WorkMode workMode) {
+                                    Scheme::WorkMode workMode, uint16 nCoalescedElements,
+                                    const ProgressCallback &onProgress) {
     Ordinal us4oemOrdinal = 0;
 
     if(transferRegistrar.size() < us4oems.size()) {
@@ -609,8 +830,15 @@ void Us4RImpl::registerOutputBuffer(Us4ROutputBuffer *outputBuffer, const Us4RBu
     }
     for(auto &us4oem: us4oems) {
         auto us4oemBuffer = us4rDDRBuffer->getUs4oemBuffer(us4oemOrdinal);
-        this->registerOutputBuffer(outputBuffer, us4oemBuffer, us4oem.get(), workMode);
+        transferRegistrar[us4oemOrdinal] =
+            this->registerOutputBuffer(outputBuffer, us4oemBuffer, us4oem.get(), workMode, nCoalescedElements);
+        if(transferRegistrar[us4oemOrdinal]) {
+            registerOverflowCallbacks(outputBuffer, us4oem.get(), workMode);
+        }
         ++us4oemOrdinal;
+        if(onProgress) {
+            onProgress((float) us4oemOrdinal / (float) us4oems.size());
+        }
     }
 }
 
@@ -619,20 +847,19 @@ void Us4RImpl::registerOutputBuffer(Us4ROutputBuffer *outputBuffer, const Us4RBu
  *  is a multiple of number of us4oem elements.
  * - this function will not schedule data transfer when the us4oem element size is 0.
  */
-void Us4RImpl::registerOutputBuffer(Us4ROutputBuffer *bufferDst, const Us4OEMBuffer &bufferSrc,
-                                    Us4OEMImplBase *us4oem, Scheme::WorkMode workMode) {
-    auto us4oemOrdinal = us4oem->getDeviceId().getOrdinal();
-    auto ius4oem = us4oem->getIUs4oem();
+std::shared_ptr<Us4OEMDataTransferRegistrar>
+Us4RImpl::registerOutputBuffer(Us4ROutputBuffer *bufferDst, const Us4OEMBuffer &bufferSrc, Us4OEMImplBase *us4oem,
+                               Scheme::WorkMode workMode, uint16 nCoalescedElements, size_t transferIdxOffset) {
     const auto nElementsSrc = bufferSrc.getNumberOfElements();
     const size_t nElementsDst = bufferDst->getNumberOfElements();
     size_t elementSize = getUniqueUs4OEMBufferElementSize(bufferSrc);
     if (elementSize == 0) {
-        return;
+        return nullptr;
     }
-    transferRegistrar[us4oemOrdinal] = std::make_shared<Us4OEMDataTransferRegistrar>(bufferDst, bufferSrc, us4oem);
-    transferRegistrar[us4oemOrdinal]->registerTransfers();
+    auto registrar = std::make_shared<Us4OEMDataTransferRegistrar>(bufferDst, bufferSrc, us4oem, nCoalescedElements,
+                                                                   transferIdxOffset);
+    registrar->registerTransfers();
     // Register buffer element release functions.
-    bool isMaster = us4oem->getDeviceId().getOrdinal() == this->getMasterUs4oem()->getDeviceId().getOrdinal();
     size_t nRepeats = nElementsDst/nElementsSrc;
     uint16 startFiring = 0;
     for(size_t i = 0; i < bufferSrc.getNumberOfElements(); ++i) {
@@ -644,9 +871,15 @@ void Us4RImpl::registerOutputBuffer(Us4ROutputBuffer *bufferDst, const Us4OEMBuf
         }
         startFiring = endFiring+1;
     }
+    return registrar;
+}
+
+void Us4RImpl::registerOverflowCallbacks(Us4ROutputBuffer *buffer, Us4OEMImplBase *us4oem, Scheme::WorkMode workMode) {
+    auto ius4oem = us4oem->getIUs4oem();
+    bool isMaster = us4oem->getDeviceId().getOrdinal() == this->getMasterUs4oem()->getDeviceId().getOrdinal();
     // Overflow handling
-    ius4oem->RegisterReceiveOverflowCallback(createOnReceiveOverflowCallback(workMode, bufferDst, isMaster));
-    ius4oem->RegisterTransferOverflowCallback(createOnTransferOverflowCallback(workMode, bufferDst, isMaster));
+    ius4oem->RegisterReceiveOverflowCallback(createOnReceiveOverflowCallback(workMode, buffer, isMaster));
+    ius4oem->RegisterTransferOverflowCallback(createOnTransferOverflowCallback(workMode, buffer, isMaster));
     // Work mode specific initialization
     if(workMode == ops::us4r::Scheme::WorkMode::SYNC) {
         ius4oem->EnableWaitOnReceiveOverflow();
@@ -668,15 +901,34 @@ size_t Us4RImpl::getUniqueUs4OEMBufferElementSize(const Us4OEMBuffer &us4oemBuff
 }
 
 void Us4RImpl::unregisterOutputBuffer(bool cleanupSequencer) {
-    if(transferRegistrar.empty()) {
-        return;
+    for (auto &registrar : transferRegistrar) {
+        if(registrar) {
+            registrar->unregisterTransfers(cleanupSequencer);
+            registrar.reset();
+        }
     }
-    for (Ordinal i = 0; i < us4oems.size(); ++i) {
-        if(transferRegistrar[i]) {
-            transferRegistrar[i]->unregisterTransfers(cleanupSequencer);
-            transferRegistrar[i].reset();
+    for (auto &resident : residentSubsequences) {
+        for (auto &registrar : resident.transferRegistrar) {
+            if(registrar) {
+                registrar->unregisterTransfers(cleanupSequencer);
+                registrar.reset();
+            }
         }
     }
+    residentSubsequences.clear();
+}
+
+void Us4RImpl::releaseHostBuffer(bool cleanupSequencer) {
+    if (this->buffer) {
+        // The buffer should be already unregistered (after stopping the device).
+        this->buffer->shutdown();
+        this->buffer.reset();
+    }
+    // We must be sure here, that there is no thread working on the us4rBuffer here.
+    if (this->us4rBuffer || !this->residentSubsequences.empty()) {
+        unregisterOutputBuffer(cleanupSequencer);
+        this->us4rBuffer.reset();
+    }
 }
 
 std::function<void()> Us4RImpl::createReleaseCallback(
@@ -685,6 +937,7 @@ std::function<void()> Us4RImpl::createReleaseCallback(
     switch(workMode) {
     case Scheme::WorkMode::HOST: // Automatically generate new trigger after releasing all elements.
         return [this, startFiring, endFiring]() {
+          ARRUS_TRACE_SCOPE_VALUE("us4oem", "markEntriesAsReady", startFiring);
           for(int i = (int)us4oems.size()-1; i >= 0; --i) {
               us4oems[i]->getIUs4oem()->MarkEntriesAsReadyForReceive(startFiring, endFiring);
               us4oems[i]->getIUs4oem()->MarkEntriesAsReadyForTransfer(startFiring, endFiring);
@@ -698,6 +951,7 @@ std::function<void()> Us4RImpl::createReleaseCallback(
     case Scheme::WorkMode::MANUAL:// Trigger generator: external (e.g. user)
     case Scheme::WorkMode::MANUAL_OP:
         return [this, startFiring, endFiring]() {
+          ARRUS_TRACE_SCOPE_VALUE("us4oem", "markEntriesAsReady", startFiring);
           for(int i = (int)us4oems.size()-1; i >= 0; --i) {
               us4oems[i]->getIUs4oem()->MarkEntriesAsReadyForReceive(startFiring, endFiring);
               us4oems[i]->getIUs4oem()->MarkEntriesAsReadyForTransfer(startFiring, endFiring);
@@ -715,6 +969,7 @@ std::function<void()> Us4RImpl::createOnReceiveOverflowCallback(
     switch(workMode) {
     case Scheme::WorkMode::SYNC:
         return  [this, outputBuffer, isMaster]() {
+          ARRUS_TRACE_SCOPE_VALUE("overflow", "rxOverflowCallback", isMaster);
           try {
               this->logger->log(LogSeverity::WARNING, "Detected RX data overflow.");
               size_t nElements = outputBuffer->getNumberOfElements();
@@ -744,6 +999,7 @@ std::function<void()> Us4RImpl::createOnReceiveOverflowCallback(
     case Scheme::WorkMode::MANUAL:
     case Scheme::WorkMode::MANUAL_OP:
         return [this, outputBuffer]() {
+          ARRUS_TRACE_SCOPE("overflow", "rxOverflowCallback");
           try {
               if(outputBuffer->isStopOnOverflow()) {
                   this->logger->log(LogSeverity::ERROR, "Rx data overflow, stopping the device.");
@@ -771,6 +1027,7 @@ std::function<void()> Us4RImpl::createOnTransferOverflowCallback(
     switch(workMode) {
     case Scheme::WorkMode::SYNC:
         return  [this, outputBuffer, isMaster]() {
+          ARRUS_TRACE_SCOPE_VALUE("overflow", "hostOverflowCallback", isMaster);
           try {
               this->logger->log(LogSeverity::WARNING, "Detected host data overflow.");
               size_t nElements = outputBuffer->getNumberOfElements();
@@ -800,6 +1057,7 @@ std::function<void()> Us4RImpl::createOnTransferOverflowCallback(
     case Scheme::WorkMode::MANUAL:
     case Scheme::WorkMode::MANUAL_OP:
         return [this, outputBuffer]() {
+          ARRUS_TRACE_SCOPE("overflow", "hostOverflowCallback");
           try {
               if(outputBuffer->isStopOnOverflow()) {
                   this->logger->log(LogSeverity::ERROR, "Host data overflow, stopping the device.");
@@ -862,6 +1120,9 @@ Us4RImpl::setSubsequence(uint16_t start, uint16_t end, const std::optional<float
     if(!this->currentScheme.has_value()) {
         throw IllegalStateException("Please upload scheme before setting sub-sequence.");
     }
+    if(this->currentTransferRoi.has_value()) {
+        throw IllegalStateException("Sub-sequences are not available for the scheme with the transfer ROI.");
+    }
     const auto &s = this->currentScheme.value();
     const auto &seq = s.getTxRxSequence();
     const auto currentSequenceSize = static_cast<uint16_t>(seq.getOps().size());
@@ -870,10 +1131,12 @@ Us4RImpl::setSubsequence(uint16_t start, uint16_t end, const std::optional<float
                                        "uploaded sequence: [0, {})", start, end, currentSequenceSize));
     }
     auto [rxBuffer, fcm] = this->getProbeImpl()->setSubsequence(start, end, sri);
-    prepareHostBuffer(s.getOutputBuffer().getNumberOfElements(), s.getWorkMode(), rxBuffer, true);
-    arrus::session::MetadataBuilder metadataBuilder;
-    metadataBuilder.add<FrameChannelMapping>("frameChannelMapping", std::move(fcm));
-    return {this->buffer, metadataBuilder.buildPtr()};
+    auto nCoalescedElements = getNumberOfCoalescedElements(s.getOutputBuffer(), s.getRxBufferSize(),
+                                                           seq.getNRepeats(), getMasterUs4oem()->getSequenceDuration(),
+                                                           s.getWorkMode());
+    auto hostBuffer = createHostBuffer(s.getOutputBuffer().getNumberOfElements(), *rxBuffer, std::nullopt);
+    prepareHostBuffer(std::move(hostBuffer), std::move(rxBuffer), s.getWorkMode(), true, nCoalescedElements);
+    return {this->buffer, createUploadMetadata(std::move(fcm), start, end)};
 }
 
 void Us4RImpl::setMaximumPulseLength(std::optional<float> maxLength) {
@@ -882,5 +1145,78 @@ void Us4RImpl::setMaximumPulseLength(std::optional<float> maxLength) {
     }
 }
 
+void Us4RImpl::setRxNopsMetadataOnly(bool value) {
+    for(auto &us4oem: us4oems) {
+        us4oem->setRxNopsMetadataOnly(value);
+    }
+    this->rxNopsMetadataOnly = value;
+}
+
+void Us4RImpl::startTelemetry(const TelemetrySettings &settings, TelemetryAlertCallback onAlert) {
+    std::unique_lock<std::mutex> guard(telemetryMutex);
+    if (telemetrySampler) {
+        throw IllegalStateException("The telemetry sampler is already running.");
+    }
+    const auto ucdRails = settings.getUCDRails();
+    telemetrySampler = std::make_unique<TelemetrySampler>(
+        us4oems.size(), settings,
+        [this, ucdRails](Ordinal ordinal) { return readTelemetry(ordinal, ucdRails); }, std::move(onAlert));
+    logger->log(LogSeverity::INFO, format("Telemetry sampler started, sampling period: {} [s].",
+                                          settings.getSamplingPeriod()));
+}
+
+void Us4RImpl::stopTelemetry() {
+    TelemetrySampler::Handle sampler;
+    {
+        std::unique_lock<std::mutex> guard(telemetryMutex);
+        sampler = std::move(telemetrySampler);
+    }
+    // Join the sampler thread outside of the lock, so the readers are not blocked in the meantime.
+    if (sampler) {
+        sampler.reset();
+        logger->log(LogSeverity::INFO, "Telemetry sampler stopped.");
+    }
+}
+
+std::optional<TelemetrySnapshot> Us4RImpl::getLatestTelemetry() {
+    std::unique_lock<std::mutex> guard(telemetryMutex);
+    if (!telemetrySampler) {
+        return std::nullopt;
+    }
+    return telemetrySampler->getLatest();
+}
+
+std::vector<TelemetrySnapshot> Us4RImpl::getTelemetryHistory() {
+    std::unique_lock<std::mutex> guard(telemetryMutex);
+    if (!telemetrySampler) {
+        return {};
+    }
+    return telemetrySampler->getHistory();
+}
+
+Us4OEMTelemetry Us4RImpl::readTelemetry(Ordinal ordinal, const std::vector<uint8> &ucdRails) {
+    auto &us4oem = us4oems.at(ordinal);
+    auto read = [&](const char *name, const std::function<float()> &func) {
+        try {
+            return func();
+        } catch (const std::exception &e) {
+            logger->log(LogSeverity::DEBUG, format("Us4OEM:{}: could not read {}: {}", ordinal, name, e.what()));
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+    };
+    std::vector<float> ucdVoltages;
+    ucdVoltages.reserve(ucdRails.size());
+    for (auto rail : ucdRails) {
+        ucdVoltages.push_back(read("UCD voltage", [&]() { return us4oem->getUCDMeasuredVoltage(rail); }));
+    }
+    return Us4OEMTelemetry{read("FPGA temperature", [&]() { return us4oem->getFPGATemperature(); }),
+                           read("UCD temperature", [&]() { return us4oem->getUCDTemperature(); }),
+                           read("UCD external temperature", [&]() { return us4oem->getUCDExternalTemperature(); }),
+                           read("HVP voltage", [&]() { return us4oem->getMeasuredHVPVoltage(); }),
+                           read("HVM voltage", [&]() { return us4oem->getMeasuredHVMVoltage(); }),
+                           read("FPGA wallclock", [&]() { return us4oem->getFPGAWallclock(); }),
+                           std::move(ucdVoltages)};
+}
+
 
 }// namespace arrus::devices
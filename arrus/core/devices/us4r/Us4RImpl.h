@@ -1,6 +1,7 @@
 #ifndef ARRUS_CORE_DEVICES_US4R_US4RIMPL_H
 #define ARRUS_CORE_DEVICES_US4R_US4RIMPL_H
 
+#include <functional>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
@@ -16,11 +17,13 @@
 #include "arrus/core/api/framework/DataBufferSpec.h"
 #include "arrus/core/common/logging.h"
 #include "arrus/core/devices/probe/ProbeImplBase.h"
+#include "arrus/core/devices/us4r/AcquisitionStatisticsCollector.h"
 #include "arrus/core/devices/us4r/RxSettings.h"
 #include "arrus/core/devices/us4r/Us4OEMDataTransferRegistrar.h"
 #include "arrus/core/devices/us4r/Us4RBuffer.h"
 #include "arrus/core/devices/us4r/backplane/DigitalBackplane.h"
 #include "arrus/core/devices/us4r/hv/HighVoltageSupplier.h"
+#include "arrus/core/devices/us4r/telemetry/TelemetrySampler.h"
 #include "arrus/core/devices/us4r/probeadapter/ProbeAdapterImplBase.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMImpl.h"
 #include "arrus/core/devices/utils.h"
@@ -99,10 +102,108 @@ public:
         return getMasterOEM()->getOemVersion() == 2;
     }
 
+    /** Called with the progress of the given upload phase, a value in [0, 1]. */
+    using ProgressCallback = std::function<void(float)>;
+
+    /**
+     * A scheme compiled for this device (see compile), ready to be programmed.
+     */
+    struct CompiledScheme {
+        using Handle = std::unique_ptr<CompiledScheme>;
+
+        ops::us4r::Scheme scheme;
+        ProbeSequence sequence;
+        /** The us4R buffer of the data transferred to the host (i.e. limited to the transfer ROI, if set). */
+        Us4RBuffer::Handle rxBuffer;
+        /** The FCM of the data transferred to the host. */
+        FrameChannelMapping::Handle fcm;
+        uint16 nCoalescedElements;
+        /** The PRIs of the subsequent TX/RXs of the scheme, that will be actually programmed (see auto-PRI). */
+        std::vector<float> pris;
+        /** Allocated host buffer, not registered yet. */
+        std::shared_ptr<Us4ROutputBuffer> buffer;
+    };
+
     std::pair<std::shared_ptr<arrus::framework::Buffer>, std::shared_ptr<arrus::session::Metadata>>
     upload(const ::arrus::ops::us4r::Scheme &scheme) override;
-    void prepareHostBuffer(unsigned nElements, ops::us4r::Scheme::WorkMode workMode,
-                           std::unique_ptr<Us4RBuffer> &rxBuffer, bool cleanupSequencer = false);
+
+    /**
+     * Does the host part of the upload: validates the scheme, compiles the sequence for all the us4OEMs and
+     * allocates the host buffer. Does not change the state of the device, so it can be called while the
+     * device is running.
+     */
+    CompiledScheme::Handle compile(const ::arrus::ops::us4r::Scheme &scheme,
+                                   const ProgressCallback &onProgress = nullptr);
+
+    /**
+     * Programs the device with the given compiled scheme: writes the us4OEM registers and registers the
+     * host buffer. The device should be stopped.
+     */
+    std::pair<std::shared_ptr<arrus::framework::Buffer>, std::shared_ptr<arrus::session::Metadata>>
+    program(CompiledScheme::Handle compiled, const ProgressCallback &onProgress = nullptr);
+
+    /**
+     * A sub-sequence of the uploaded scheme, see uploadResidentSubsequences.
+     */
+    struct Subsequence {
+        /** The first TX/RX of the sub-sequence. */
+        uint16 start;
+        /** The last TX/RX of the sub-sequence (inclusive). */
+        uint16 end;
+        std::optional<float> sri;
+        framework::DataBufferSpec outputBuffer;
+    };
+
+    /**
+     * Uploads the given scheme and prepares the host buffers of the given sub-sequences of it, so it is possible
+     * to switch between them later without reprogramming the TX/RXs and data transfers (see
+     * switchResidentSubsequence). The host buffer of each sub-sequence is allocated, page-locked and its data
+     * transfers are registered here; each sub-sequence uses a separate range of the us4OEM transfers (at most
+     * Us4OEMDataTransferRegistrar::MAX_N_TRANSFERS in total).
+     *
+     * None of the sub-sequences is set as the current one, see switchResidentSubsequence.
+     */
+    void uploadResidentSubsequences(const ::arrus::ops::us4r::Scheme &scheme,
+                                    const std::vector<Subsequence> &subsequences);
+
+    /**
+     * Sets the given sub-sequence uploaded with uploadResidentSubsequences as the current one: only the
+     * sequencer range and SRI are updated, and the host buffer of the sub-sequence is set as the current one.
+     * The device should be stopped.
+     *
+     * @param subsequence the number of the sub-sequence, in the order provided to uploadResidentSubsequences
+     */
+    std::pair<std::shared_ptr<arrus::framework::Buffer>, std::shared_ptr<arrus::session::Metadata>>
+    switchResidentSubsequence(size_t subsequence);
+
+    /**
+     * Allocates the host buffer for the given us4R buffer (not registered yet and not attached to the acquisition
+     * statistics, see prepareHostBuffer).
+     */
+    std::shared_ptr<Us4ROutputBuffer> createHostBuffer(unsigned nElements, const Us4RBuffer &rxBuffer,
+                                                       const std::optional<ops::us4r::TransferRoi> &transferRoi);
+
+    /**
+     * Replaces the current host buffer with the given one and registers the data transfers to it.
+     */
+    void prepareHostBuffer(std::shared_ptr<Us4ROutputBuffer> hostBuffer, Us4RBuffer::Handle rxBuffer,
+                           ops::us4r::Scheme::WorkMode workMode, bool cleanupSequencer = false,
+                           uint16 nCoalescedElements = 1, const ProgressCallback &onProgress = nullptr);
+
+    /**
+     * Returns the positions of the frame metadata rows in the host buffer element, in the order of acquisition
+     * (firing), see Us4ROutputBufferElement::setFrameMetadataOffsets.
+     */
+    std::vector<size_t> getFrameMetadataOffsets(const Us4RBuffer &rxBuffer, const Us4ROutputBuffer &hostBuffer,
+                                                const std::optional<ops::us4r::TransferRoi> &transferRoi) const;
+
+    /**
+     * Returns the upload metadata of the current host buffer: the frame channel mapping ("frameChannelMapping"),
+     * the positions of the frame metadata rows in the buffer element ("frameMetadataOffsets") and the PRIs
+     * of the TX/RXs [start, end] of the current scheme, as programmed on the device ("pris").
+     */
+    std::shared_ptr<arrus::session::Metadata> createUploadMetadata(FrameChannelMapping::Handle fcm, uint16 start,
+                                                                   uint16 end) const;
 
     void start() override;
 
@@ -152,7 +253,11 @@ public:
     void setAfe(uint8_t reg, uint16_t val) override;
 
     void registerOutputBuffer(Us4ROutputBuffer *buffer, const Us4RBuffer::Handle &us4rBuffer,
-                              ::arrus::ops::us4r::Scheme::WorkMode workMode);
+                              ::arrus::ops::us4r::Scheme::WorkMode workMode, uint16 nCoalescedElements = 1,
+                              const ProgressCallback &onProgress = nullptr);
+    /**
+     * Unregisters the data transfers of the current host buffer and of all the resident sub-sequences.
+     */
     void unregisterOutputBuffer(bool cleanSequencer);
     const char *getBackplaneSerialNumber() override;
     const char *getBackplaneRevision() override;
@@ -163,16 +268,59 @@ public:
 
     void setMaximumPulseLength(std::optional<float> maxLength) override;
 
+    void setRxNopsMetadataOnly(bool value) override;
+
+    bool isRxNopsMetadataOnly() const override { return rxNopsMetadataOnly; }
+
+    void startTelemetry(const TelemetrySettings &settings, TelemetryAlertCallback onAlert) override;
+    void startTelemetry(const TelemetrySettings &settings) override { startTelemetry(settings, nullptr); }
+    void stopTelemetry() override;
+    std::optional<TelemetrySnapshot> getLatestTelemetry() override;
+    std::vector<TelemetrySnapshot> getTelemetryHistory() override;
+
+    AcquisitionStatistics getAcquisitionStatistics() override { return acquisitionStatistics->get(); }
+    void resetAcquisitionStatistics() override { acquisitionStatistics->reset(); }
+
 private:
+    /**
+     * A sub-sequence uploaded with uploadResidentSubsequences, with its host buffer registered.
+     */
+    struct ResidentSubsequence {
+        Subsequence subsequence;
+        std::shared_ptr<Us4ROutputBuffer> buffer;
+        Us4RBuffer::Handle rxBuffer;
+        FrameChannelMapping::Handle fcm;
+        uint16 nCoalescedElements;
+        /** us4OEM ordinal -> transfer registrar; nullptr for us4OEMs which do not transfer any data. */
+        std::vector<std::shared_ptr<Us4OEMDataTransferRegistrar>> transferRegistrar;
+    };
+
     UltrasoundDevice *getDefaultComponent();
 
+    /**
+     * Validates the scheme parameters, which are not validated by the sequence compilation.
+     */
+    void validateScheme(const ::arrus::ops::us4r::Scheme &scheme);
+
+    /**
+     * Shuts down the current host buffer and unregisters the data transfers of all the host buffers.
+     */
+    void releaseHostBuffer(bool cleanupSequencer);
+
     void stopDevice();
 
-    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-    uploadSequence(const ops::us4r::TxRxSequence &seq, uint16_t bufferSize, uint16_t batchSize,
-                   arrus::ops::us4r::Scheme::WorkMode workMode,
-                   const std::optional<ops::us4r::DigitalDownConversion> &ddc,
-                   const std::vector<framework::NdArray> &txDelayProfiles);
+    /**
+     * Converts the given sequence to the TX/RX parameters that will be actually programmed, i.e. with the PRIs
+     * resolved in the auto-PRI mode.
+     */
+    std::vector<TxRxParameters> getTxRxParameters(const ops::us4r::TxRxSequence &seq,
+                                                  const std::optional<ops::us4r::DigitalDownConversion> &ddc) const;
+
+    ProbeSequence
+    compileSequence(const ops::us4r::TxRxSequence &seq, const std::vector<TxRxParameters> &txrxs,
+                    uint16_t bufferSize, uint16_t batchSize, arrus::ops::us4r::Scheme::WorkMode workMode,
+                    const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                    const std::vector<framework::NdArray> &txDelayProfiles);
 
     /**
      * Applies a given function on all functions.
@@ -187,8 +335,18 @@ private:
 
     ProbeImplBase::RawHandle getProbeImpl() { return probe.value().get(); }
 
-    void registerOutputBuffer(Us4ROutputBuffer *bufferDst, const Us4OEMBuffer &bufferSrc,
-                              Us4OEMImplBase::RawHandle us4oem, ::arrus::ops::us4r::Scheme::WorkMode workMode);
+    /**
+     * Registers the data transfers from the given us4OEM buffer to the given host buffer.
+     *
+     * @param transferIdxOffset the number of the first us4OEM transfer to use
+     * @return the transfer registrar, nullptr if the us4OEM does not transfer any data
+     */
+    std::shared_ptr<Us4OEMDataTransferRegistrar>
+    registerOutputBuffer(Us4ROutputBuffer *bufferDst, const Us4OEMBuffer &bufferSrc,
+                         Us4OEMImplBase::RawHandle us4oem, ::arrus::ops::us4r::Scheme::WorkMode workMode,
+                         uint16 nCoalescedElements, size_t transferIdxOffset = 0);
+    void registerOverflowCallbacks(Us4ROutputBuffer *buffer, Us4OEMImplBase::RawHandle us4oem,
+                                   ::arrus::ops::us4r::Scheme::WorkMode workMode);
     size_t getUniqueUs4OEMBufferElementSize(const Us4OEMBuffer &us4oemBuffer) const;
 
     std::function<void()> createReleaseCallback(
@@ -200,6 +358,9 @@ private:
 
     Us4OEMImplBase::RawHandle getMasterUs4oem() const {return this->us4oems[0].get();}
 
+    /** Reads the telemetry of the given us4OEM, the values that could not be read are set to NaN. */
+    Us4OEMTelemetry readTelemetry(Ordinal ordinal, const std::vector<uint8> &ucdRails);
+
     std::mutex deviceStateMutex;
     std::mutex afeParamsMutex;
     Logger::Handle logger;
@@ -218,6 +379,19 @@ private:
     std::vector<std::shared_ptr<Us4OEMDataTransferRegistrar>> transferRegistrar;
     /** Currently uploaded scheme. */
     std::optional<ops::us4r::Scheme> currentScheme;
+    /** The PRIs of the currently uploaded scheme TX/RXs, as programmed on the device (see auto-PRI). */
+    std::vector<float> currentPris;
+    /** Transfer ROI of the currently uploaded scheme. */
+    std::optional<ops::us4r::TransferRoi> currentTransferRoi;
+    /** Sub-sequences uploaded with uploadResidentSubsequences, empty otherwise. */
+    std::vector<ResidentSubsequence> residentSubsequences;
+    bool rxNopsMetadataOnly{false};
+    /** Guards the telemetry sampler handle only; the sampler itself does not take any of the device locks. */
+    std::mutex telemetryMutex;
+    TelemetrySampler::Handle telemetrySampler;
+    /** Shared with the output buffer, which updates the statistics. */
+    AcquisitionStatisticsCollector::SharedHandle acquisitionStatistics{
+        std::make_shared<AcquisitionStatisticsCollector>(Us4OEMImpl::SAMPLING_FREQUENCY)};
 };
 
 }// namespace arrus::devices
@@ -12,7 +12,9 @@
 #include "arrus/common/asserts.h"
 #include "arrus/common/format.h"
 #include "arrus/core/common/logging.h"
+#include "arrus/core/common/tracing.h"
 #include "arrus/core/api/framework/DataBuffer.h"
+#include "arrus/core/devices/us4r/AcquisitionStatisticsCollector.h"
 
 
 namespace arrus::devices {
@@ -38,6 +40,7 @@ public:
           {}
 
     void release() override {
+        ARRUS_TRACE_SCOPE_VALUE("buffer", "release", position);
         std::unique_lock<std::mutex> guard(mutex);
         this->accumulator = 0;
         releaseFunction();
@@ -76,6 +79,28 @@ public:
         releaseFunction = func;
     }
 
+    /**
+     * Sets the positions of the frame metadata rows: offsets[i] is the number of int16 values between
+     * the beginning of the element and the first sample of the i-th frame acquired by the frame metadata us4OEM
+     * (in the order of acquisition, which may differ from the order of the frames in the element).
+     */
+    void setFrameMetadataOffsets(std::vector<size_t> offsets) {
+        frameMetadataOffsets = std::move(offsets);
+    }
+
+    size_t getNumberOfFrameMetadata() override {
+        return frameMetadataOffsets.size();
+    }
+
+    framework::FrameMetadata getFrameMetadata(size_t frame) override {
+        validateState();
+        if(frame >= frameMetadataOffsets.size()) {
+            throw IllegalArgumentException(::arrus::format("Frame metadata not available for frame: {}", frame));
+        }
+        // The metadata row is the first sample of the frame: subsequent RX channels are stored next to each other.
+        return framework::FrameMetadata{data.get<int16>() + frameMetadataOffsets[frame], 1};
+    }
+
     [[nodiscard]] bool isElementReady() {
         std::unique_lock<std::mutex> guard(mutex);
         return state == State::READY;
@@ -125,6 +150,7 @@ private:
     /** A pattern of the filled accumulator, which indicates that the hole element is ready. */
     AccumulatorType filledAccumulator;
     std::function<void()> releaseFunction;
+    std::vector<size_t> frameMetadataOffsets;
     size_t position;
     State state{State::FREE};
 };
@@ -253,24 +279,50 @@ public:
      *  @return true if the buffer signal was successful, false otherwise (e.g. the queue was shut down).
      */
     bool signal(Ordinal n, uint16 elementNr) {
+        return signal(n, elementNr, 1);
+    }
+
+    /**
+     * Signals the readiness of new data acquired by the n-th Us4OEM module, for nElements consecutive elements,
+     * starting from the firstElementNr (coalesced transfers).
+     *
+     * The buffer lock is acquired once for all the elements; the 'on new data' callback is called for each
+     * element that is ready, in order.
+     */
+    bool signal(Ordinal n, uint16 firstElementNr, uint16 nElements) {
+        ARRUS_TRACE_SCOPE_VALUE("buffer", "signal", firstElementNr);
         std::unique_lock<std::mutex> guard(mutex);
         if(this->state != State::RUNNING) {
             getDefaultLogger()->log(LogSeverity::DEBUG, "Signal queue shutdown.");
             return false;
         }
         this->validateState();
-        auto &element = this->elements[elementNr];
-        try {
-            element->signal(n);
-        } catch(const IllegalArgumentException &e) {
-            this->markAsInvalid();
-            throw e;
+        std::vector<uint16> readyElements;
+        readyElements.reserve(nElements);
+        for(uint16 elementNr = firstElementNr; elementNr < firstElementNr + nElements; ++elementNr) {
+            auto &element = this->elements[elementNr];
+            try {
+                element->signal(n);
+            } catch(const IllegalArgumentException &e) {
+                this->markAsInvalid();
+                throw e;
+            }
+            if(element->isElementReady()) {
+                readyElements.push_back(elementNr);
+            }
         }
-        if(element->isElementReady()) {
-            guard.unlock();
-            onNewDataCallback(elements[elementNr]);
-        } else {
-            guard.unlock();
+        guard.unlock();
+        for(auto elementNr: readyElements) {
+            auto &element = elements[elementNr];
+            if(statistics) {
+                recordAcquired(*element);
+            }
+            ARRUS_TRACE_SCOPE_VALUE("buffer", "onNewDataCallback", elementNr);
+            auto callbackStart = AcquisitionStatisticsCollector::Clock::now();
+            onNewDataCallback(element);
+            if(statistics) {
+                statistics->onDelivered(AcquisitionStatisticsCollector::Clock::now() - callbackStart);
+            }
         }
         return true;
     }
@@ -282,6 +334,9 @@ public:
             for(auto &element: elements) {
                 element->markAsInvalid();
             }
+            if(statistics) {
+                statistics->onOverflow();
+            }
             this->onOverflowCallback();
         }
     }
@@ -305,8 +360,51 @@ public:
         }
     }
 
+    /**
+     * Sets the positions of the frame metadata rows in each element, see
+     * Us4ROutputBufferElement::setFrameMetadataOffsets.
+     */
+    void setFrameMetadataOffsets(const std::vector<size_t> &offsets) {
+        for(auto &element: elements) {
+            element->setFrameMetadataOffsets(offsets);
+        }
+        frameMetadataOffsets = offsets;
+    }
+
+    /**
+     * Returns the positions of the frame metadata rows in each element (the number of int16 values from
+     * the beginning of the element), in the order of acquisition.
+     */
+    [[nodiscard]] const std::vector<size_t> &getFrameMetadataOffsets() const {
+        return frameMetadataOffsets;
+    }
+
+    /**
+     * Returns the offset (the number of bytes) of the data produced by the given us4OEM within a single element.
+     */
+    [[nodiscard]] size_t getUs4oemOffset(Ordinal us4oem) const {
+        return us4oemOffsets[us4oem];
+    }
+
     void registerReleaseFunction(size_t element, std::function<void()> &releaseFunction) {
-        this->elements[element]->registerReleaseFunction(releaseFunction);
+        std::function<void()> func = [this, releaseFunction]() {
+            releaseFunction();
+            if(statistics) {
+                statistics->onReleased();
+            }
+        };
+        this->elements[element]->registerReleaseFunction(func);
+    }
+
+    /**
+     * Sets the collector of the acquisition statistics of this buffer; should be called before the buffer
+     * is registered in the device.
+     */
+    void setStatisticsCollector(AcquisitionStatisticsCollector::SharedHandle collector) {
+        this->statistics = std::move(collector);
+        if(this->statistics) {
+            this->statistics->onNewBuffer();
+        }
     }
 
     bool isStopOnOverflow() {
@@ -324,10 +422,25 @@ public:
     }
 
     void runOnOverflowCallback() {
+        if(statistics) {
+            statistics->onOverflow();
+        }
         this->onOverflowCallback();
     }
 
 private:
+    void recordAcquired(Us4ROutputBufferElement &element) {
+        auto now = AcquisitionStatisticsCollector::Clock::now();
+        std::optional<uint64> timestamp;
+        std::optional<uint32> triggerNumber;
+        if(element.getNumberOfFrameMetadata() > 0) {
+            auto metadata = element.getFrameMetadata(0);
+            timestamp = metadata.getTimestamp();
+            triggerNumber = metadata.getTriggerNumber();
+        }
+        statistics->onAcquired(now, timestamp, triggerNumber);
+    }
+
     /**
      * Throws IllegalStateException when the buffer is in invalid state.
      *
@@ -353,6 +466,8 @@ private:
     std::vector<Us4ROutputBufferElement::SharedHandle> elements;
     /** Relative addresses where us4oem modules will write. IN NUMBER OF BYTES. */
     std::vector<size_t> us4oemOffsets;
+    /** Positions of the frame metadata rows in each element, see setFrameMetadataOffsets. */
+    std::vector<size_t> frameMetadataOffsets;
     // Callback that should be called once new data arrive.
     framework::OnNewDataCallback onNewDataCallback;
     framework::OnOverflowCallback onOverflowCallback{[]() {}};
@@ -364,6 +479,7 @@ private:
     };
     State state{State::RUNNING};
     bool stopOnOverflow{true};
+    AcquisitionStatisticsCollector::SharedHandle statistics;
 };
 
 }
@@ -3,12 +3,14 @@
 #include "arrus/common/utils.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <numeric>
 #include <tuple>
 
 #include "arrus/core/common/aperture.h"
 #include "arrus/core/common/collections.h"
+#include "arrus/core/common/logging.h"
 
 namespace arrus::devices {
 
@@ -60,7 +62,8 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
                             const std::vector<std::vector<uint8_t>> &us4oemL2PMappings,
                             const std::unordered_map<Ordinal,
                             std::vector<framework::NdArray>> &inputTxDelayProfiles,
-                            Ordinal frameMetadataOem = 0) {
+                            Ordinal frameMetadataOem,
+                            const std::vector<std::unordered_set<uint8_t>> &us4oemChannelsMasks) {
     using FrameNumber = FrameChannelMapping::FrameNumber;
     // All sequences must have the same length.
     ARRUS_REQUIRES_NON_EMPTY_IAE(seqs);
@@ -81,6 +84,8 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
     std::vector<size_t> srcOpIdx; // srcOpIdx[output op idx] = input op idx (before splitting into sub-apertures)
     // Logical op number -> first physical op number, last physical op number
     std::vector<std::pair<uint16_t, uint16_t>> logicalToPhysicalOp(seqs.at(0).size());
+    const std::unordered_set<uint8_t> noMask;
+    size_t nFiringsWithoutMask = 0;
 
     opDestOp.setZero();
     opDestChannel.setConstant(FrameChannelMapping::UNAVAILABLE);
@@ -106,6 +111,8 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
     // For each operation
     for(size_t opIdx = 0; opIdx < seqLength; ++opIdx) { // For each TX/RX
         auto opPhysicalStart = ARRUS_SAFE_CAST(result.at(0).size(), uint16_t);
+        // The number of firings that would be required if masked channels were treated as the active ones.
+        ChannelIdx maxSubaperturesPerOp = 0;
         for(size_t seqIdx = 0; seqIdx < seqs.size(); ++seqIdx) { // for each OEM
             const auto &seq = seqs[seqIdx];
             const auto &op = seq[opIdx];
@@ -113,26 +120,58 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
             // Split rx aperture, if necessary.
             // subaperture number starts from 1, 0 means that the channel
             // should be inactive.
+            // Each us4OEM rx channel 'ch' can acquire data from a single addressable channel per firing, so the
+            // minimum number of firings is equal to the maximum number of active (not masked) addressable channels
+            // connected to the same rx channel. Masked channels are not acquired by us4OEM anyway (see
+            // Us4OEMImpl::getRxMappings), so they are put into the remaining free slots only and they never
+            // enforce additional firings.
+            const auto &channelsMask = seqIdx < us4oemChannelsMasks.size() ? us4oemChannelsMasks[seqIdx] : noMask;
             std::vector<ChannelIdx> subapertureIdxs(op.getRxAperture().size());
+            std::vector<bool> isDropped(op.getRxAperture().size(), false);
+            std::vector<ChannelIdx> nextFreeSubaperture(N_RX_CHANNELS);
+            ChannelIdx maxSubapertureIdx = 0;
+            ChannelIdx maxSubapertureIdxAllChannels = 0;
             for(ChannelIdx ch = 0; ch < N_RX_CHANNELS; ++ch) {
                 ChannelIdx subaperture = 1;
+                ChannelIdx nActive = 0;
                 for(ChannelIdx group = 0; group < N_GROUPS; ++group) {
                     // Us4OEM Physical address
                     ChannelIdx physicalIdx = group*N_RX_CHANNELS + ch;
                     // Us4OEM Logical address
                     ChannelIdx logicalIdx = us4oemP2LMappings[seqIdx][physicalIdx];
                     if(op.getRxAperture()[logicalIdx]) {
-                        // channel active
-                        subapertureIdxs[logicalIdx] = subaperture++;
-                    } else {
-                        // channel inactive
-                        subapertureIdxs[logicalIdx] = 0;
+                        ++nActive;
+                        if(!setContains(channelsMask, (uint8_t)logicalIdx)) {
+                            subapertureIdxs[logicalIdx] = subaperture++;
+                        }
                     }
                 }
+                nextFreeSubaperture[ch] = subaperture;
+                maxSubapertureIdx = std::max(maxSubapertureIdx, ChannelIdx(subaperture - 1));
+                maxSubapertureIdxAllChannels = std::max(maxSubapertureIdxAllChannels, nActive);
             }
-            ChannelIdx maxSubapertureIdx = *std::max_element(
-                std::begin(subapertureIdxs), std::end(subapertureIdxs));
-            if(maxSubapertureIdx > 1) {
+            if(maxSubapertureIdxAllChannels > 0) {
+                // At least a single firing is necessary, even if all of the active channels are masked.
+                maxSubapertureIdx = std::max(maxSubapertureIdx, ChannelIdx(1));
+            }
+            // Masked channels: use the free slots only, drop the rest (the channel will be unavailable in the FCM).
+            bool isAnyChannelDropped = false;
+            for(ChannelIdx ch = 0; ch < N_RX_CHANNELS; ++ch) {
+                ChannelIdx subaperture = nextFreeSubaperture[ch];
+                for(ChannelIdx group = 0; group < N_GROUPS; ++group) {
+                    ChannelIdx logicalIdx = us4oemP2LMappings[seqIdx][group*N_RX_CHANNELS + ch];
+                    if(op.getRxAperture()[logicalIdx] && setContains(channelsMask, (uint8_t)logicalIdx)) {
+                        if(subaperture <= maxSubapertureIdx) {
+                            subapertureIdxs[logicalIdx] = subaperture++;
+                        } else {
+                            isDropped[logicalIdx] = true;
+                            isAnyChannelDropped = true;
+                        }
+                    }
+                }
+            }
+            maxSubaperturesPerOp = std::max(maxSubaperturesPerOp, maxSubapertureIdxAllChannels);
+            if(maxSubapertureIdx > 1 || isAnyChannelDropped) {
                 // Split aperture into smaller subapertures (Muxing).
                 std::vector<BitMask> rxSubapertures(maxSubapertureIdx);
                 for(auto &subaperture : rxSubapertures) {
@@ -143,7 +182,11 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
                 std::vector<ChannelIdx> subopActiveChannels(maxSubapertureIdx, 0);
                 for(size_t ch = 0; ch < subapertureIdxs.size(); ++ch) {
                     auto subapIdx = subapertureIdxs[ch];
-                    if(subapIdx > 0) {
+                    if(isDropped[ch]) {
+                        // Masked channel without free slot: keep FCM UNAVAILABLE value.
+                        ++opActiveChannel;
+                    }
+                    else if(subapIdx > 0) {
                         rxSubapertures[subapIdx-1][ch] = true;
                         // FC mapping
                         // -1 because subapIdx starts from one
@@ -209,6 +252,7 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
         currentFrameIdx[frameMetadataOem] = FrameNumber(maxSize);
 
         srcOpIdx.resize(maxSize, opIdx);
+        nFiringsWithoutMask += std::max(size_t(maxSubaperturesPerOp), size_t(1));
         // Determine logical -> physical op number mapping.
         auto opPhysicalEnd = ARRUS_SAFE_CAST(result.at(0).size()-1, uint16_t);
         logicalToPhysicalOp.at(opIdx) = {opPhysicalStart, opPhysicalEnd};
@@ -222,7 +266,8 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
             opDestOp,
             opDestChannel,
             inputTxDelayProfiles,
-            logicalToPhysicalOp};
+            logicalToPhysicalOp,
+            nFiringsWithoutMask - result.at(0).size()};
     }
     else {
         for(size_t seqIdx = 0; seqIdx < result.size(); ++seqIdx) {
@@ -248,9 +293,60 @@ splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
             opDestOp,
             opDestChannel,
             outputTxDelayProfiles,
-            logicalToPhysicalOp};
+            logicalToPhysicalOp,
+            nFiringsWithoutMask - result.at(0).size()};
+    }
+}
+
+TxRxParamsSequence
+setMinimumPris(const TxRxParamsSequence &seq, float margin, Us4OEMSettings::ReprogrammingMode reprogrammingMode,
+               const std::optional<ops::us4r::DigitalDownConversion> &ddc) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(margin >= 0.0f,
+                                     ::arrus::format("PRI margin should be non-negative, got: {}", margin));
+    TxRxParamsSequence result;
+    result.reserve(seq.size());
+    for(const auto &op: seq) {
+        float decimationFactor = ddc.has_value() ? ddc->getDecimationFactor() : (float) op.getRxDecimationFactor();
+        float samplingFrequency = Us4OEMImpl::SAMPLING_FREQUENCY / decimationFactor;
+        float pri = Us4OEMImpl::getMinimumPri(op.getRxSampleRange().end(), samplingFrequency, reprogrammingMode);
+        result.emplace_back(op.getTxAperture(), op.getTxDelays(), op.getTxPulse(), op.getRxAperture(),
+                            op.getRxSampleRange(), op.getRxDecimationFactor(), pri + margin,
+                            op.getRxPadding(), op.getRxDelay());
     }
+    return result;
 }
 
+uint16 getNumberOfCoalescedElements(const framework::DataBufferSpec &spec, uint16 rxBufferNElements,
+                                    uint16 batchSize, float sequenceDuration, ops::us4r::Scheme::WorkMode workMode) {
+    using WorkMode = ops::us4r::Scheme::WorkMode;
+    unsigned requested = spec.getNumberOfCoalescedElements();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(requested >= 1, "The number of coalesced elements should be at least 1.");
+    if (requested > 1 && workMode != WorkMode::ASYNC && workMode != WorkMode::SYNC) {
+        throw IllegalArgumentException(
+            ::arrus::format("Transfer coalescing ({} elements) is available only in the ASYNC and SYNC work modes.",
+                            requested));
+    }
+    unsigned result = std::min(requested, (unsigned) rxBufferNElements);
+    const auto &maxLatency = spec.getMaxCoalescingLatency();
+    if (maxLatency.has_value()) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(maxLatency.value() >= 0.0f, "Coalescing latency should be non-negative.");
+        float elementDuration = sequenceDuration * (float) batchSize;
+        if (elementDuration > 0.0f) {
+            // The first element of the group is signaled after acquiring the remaining elements of the group.
+            auto maxResult = 1 + static_cast<unsigned>(std::floor(maxLatency.value() / elementDuration));
+            result = std::min(result, maxResult);
+        }
+    }
+    // The rx buffer should consist of complete groups.
+    while (rxBufferNElements % result != 0) {
+        --result;
+    }
+    if (result != requested) {
+        getDefaultLogger()->log(
+            LogSeverity::INFO,
+            ::arrus::format("Transferring {} rx buffer elements at once (requested: {}).", result, requested));
+    }
+    return static_cast<uint16>(result);
 }
 
+}
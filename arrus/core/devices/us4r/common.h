@@ -3,8 +3,11 @@
 
 #include <vector>
 #include <tuple>
+#include <unordered_set>
 
 #include "arrus/core/api/common/types.h"
+#include "arrus/core/api/framework/DataBufferSpec.h"
+#include "arrus/core/api/ops/us4r/Scheme.h"
 #include "arrus/common/asserts.h"
 #include "arrus/core/devices/TxRxParameters.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMImpl.h"
@@ -23,6 +26,8 @@ struct SplitResult {
     /** A list of updated constants */
     std::unordered_map<Ordinal, std::vector<arrus::framework::NdArray>> constants;
     std::vector<std::pair<uint16_t, uint16_t>> logicalToPhysicalOp;
+    /** The number of firings saved thanks to skipping masked rx channels when splitting rx apertures. */
+    size_t nFiringsSaved{0};
 };
 
 /**
@@ -43,8 +48,15 @@ struct SplitResult {
  * 4 tx/rx ops, and seqs[1] first op must be split into 2 tx/rx ops only,
  * the second sequence will extended by NOP TxRxParameters.
  *
+ * The number of output ops for a given input op is the lowest possible one: it is equal
+ * to the maximum number of active addressable channels connected to the same us4oem rx channel.
+ * Masked channels (which are not acquired by the us4oem anyway) do not increase the number of output ops:
+ * they are put into the output ops with a free slot only, otherwise they are turned off
+ * and marked as unavailable in the output mappings.
+ *
  * @param seqs tx/rx sequences to recalculate
  * @param mappings tx/rx us4oem mappings to apply - in order to determien
+ * @param channelsMasks us4oem ordinal -> us4oem channels mask (logical channel numbers); empty means no masks
  * @return recalculated sequences,
  *         a mapping (module, input op index, rx channel) -> output frame number,
  *         a mapping (module, input op index, rx channel) -> output frame rx channel
@@ -53,7 +65,42 @@ SplitResult
 splitRxAperturesIfNecessary(const std::vector<TxRxParamsSequence> &seqs,
                             const std::vector<std::vector<uint8_t>> &mappings,
                             const std::unordered_map<Ordinal, std::vector<arrus::framework::NdArray>> &txDelayProfiles,
-                            Ordinal frameMetadataOem);
+                            Ordinal frameMetadataOem,
+                            const std::vector<std::unordered_set<uint8_t>> &channelsMasks = {});
+
+/**
+ * Sets the PRI of each tx/rx to the minimum value accepted by us4OEM increased by the given margin.
+ *
+ * The minimum PRI is determined by the rx end sample, the sampling frequency after decimation (the DDC decimation
+ * factor, if DDC is on) and the sequencer reprogramming mode. The SRI extension of the last PRI is computed later
+ * on the output sequence, so the SRI is still honoured.
+ *
+ * @param seq input tx/rx sequence
+ * @param margin the time [s] to add to the minimum PRI (e.g. an acoustic safety margin)
+ * @param reprogrammingMode us4OEM sequencer reprogramming mode
+ * @param ddc digital down conversion to apply, nullopt if turned off
+ * @return the input sequence with the updated PRIs
+ */
+TxRxParamsSequence
+setMinimumPris(const TxRxParamsSequence &seq, float margin, Us4OEMSettings::ReprogrammingMode reprogrammingMode,
+               const std::optional<ops::us4r::DigitalDownConversion> &ddc);
+
+/**
+ * Returns the number of rx buffer elements that should be transferred and signaled at once: the requested
+ * value, reduced to meet the latency limit and to be a divisor of the rx buffer size.
+ *
+ * Transfer coalescing is available only in the ASYNC and SYNC work modes: in the remaining modes the sequencer
+ * waits for the host after each rx buffer element, so a group of elements would never be completed.
+ *
+ * @param spec output buffer specification (the requested number of elements and the latency limit)
+ * @param rxBufferNElements the number of rx buffer elements
+ * @param batchSize the number of sequence repetitions in a single rx buffer element
+ * @param sequenceDuration duration of a single sequence [s]
+ * @param workMode scheme work mode
+ * @throws IllegalArgumentException when more than one element is requested in a work mode other than ASYNC or SYNC
+ */
+uint16 getNumberOfCoalescedElements(const framework::DataBufferSpec &spec, uint16 rxBufferNElements,
+                                    uint16 batchSize, float sequenceDuration, ops::us4r::Scheme::WorkMode workMode);
 
 }
 
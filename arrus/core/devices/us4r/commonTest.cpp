@@ -392,4 +392,117 @@ TEST(SplitRxApertureIfNecessaryTest, PadsWithNopsCorrectly) {
     ARRUS_EXPECT_TENSORS_EQ(r.channels, expectedDstChannel);
 }
 
-}
\ No newline at end of file
+
+TEST(SplitRxApertureIfNecessaryTest, DoesNotSplitOpBecauseOfMaskedChannels) {
+    std::vector<bool> rxAperture(128);
+    rxAperture[1] = rxAperture[2] = rxAperture[33] = rxAperture[65] = true;
+
+    std::vector<TxRxParamsSequence> in = {
+        {
+            getStdTxRxParameters(rxAperture)
+        }
+    };
+    std::unordered_map<Ordinal, std::vector<arrus::framework::NdArray>> inputTxDelayProfiles;
+    std::vector<std::unordered_set<uint8_t>> masks = {{2, 33}};
+
+    auto r = splitRxAperturesIfNecessary(in, DEFAULT_MAPPING1, inputTxDelayProfiles, 0, masks);
+
+    // Channel 33 is masked and would require an additional firing: it should be turned off.
+    // Channel 2 is masked, but us4oem rx channel 2 is free in the first firing.
+    std::vector<bool> expectedRxAperture0(128);
+    expectedRxAperture0[1] = true;
+    expectedRxAperture0[2] = true;
+    std::vector<bool> expectedRxAperture1(128);
+    expectedRxAperture1[65] = true;
+    std::vector<TxRxParamsSequence> expected{
+        {
+            getStdTxRxParameters(expectedRxAperture0),
+            getStdTxRxParameters(expectedRxAperture1)
+        }
+    };
+    verifyOps(expected, r.sequences);
+    EXPECT_EQ(r.nFiringsSaved, 1);
+
+    // FCM
+    Eigen::Tensor<int32, 3> expectedDstFrame(1, 1, 4);
+    Eigen::Tensor<int32, 3> expectedDstChannel(1, 1, 4);
+    ARRUS_SET_FCM(0, 0, 0, 0, 0);
+    ARRUS_SET_FCM(0, 0, 1, 0, 1);
+    ARRUS_SET_FCM(0, 0, 2, 0, FCM_UNAVAILABLE_VALUE);
+    ARRUS_SET_FCM(0, 0, 3, 1, 0);
+
+    ARRUS_EXPECT_TENSORS_EQ(r.frames, expectedDstFrame);
+    ARRUS_EXPECT_TENSORS_EQ(r.channels, expectedDstChannel);
+}
+
+
+TEST(SetMinimumPrisTest, SetsMinimumPriForSequentialReprogramming) {
+    // 4096 samples: 63.015 us + 5 us (rx time epsilon) + 35 us (reprogramming) -> 104 us, + 10 us margin
+    std::vector<TxRxParameters> seq = {
+        TxRxParameters(TX_APERTURE, TX_DELAYS, PULSE, getNTimes(true, 128), {0, 4096}, 1, PRI),
+        TxRxParameters(TX_APERTURE, TX_DELAYS, PULSE, getNTimes(true, 128), {0, 4096}, 2, PRI),
+    };
+    auto result = setMinimumPris(seq, 10e-6f, Us4OEMSettings::ReprogrammingMode::SEQUENTIAL, std::nullopt);
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_NEAR(result[0].getPri(), 114e-6f, 1e-9f);
+    // decimation 2: 126.03 us + 5 us + 35 us -> 167 us, + 10 us margin
+    EXPECT_NEAR(result[1].getPri(), 177e-6f, 1e-9f);
+    EXPECT_EQ(result[0].getRxSampleRange(), seq[0].getRxSampleRange());
+}
+
+TEST(SetMinimumPrisTest, SetsMinimumPriForParallelReprogramming) {
+    std::vector<TxRxParameters> seq = {
+        TxRxParameters(TX_APERTURE, TX_DELAYS, PULSE, getNTimes(true, 128), {0, 4096}, 1, PRI),
+        TxRxParameters(TX_APERTURE, TX_DELAYS, PULSE, getNTimes(true, 128), {0, 64}, 1, PRI),
+    };
+    auto result = setMinimumPris(seq, 0.0f, Us4OEMSettings::ReprogrammingMode::PARALLEL, std::nullopt);
+    // max(68.015 us, 35 us) -> 69 us
+    EXPECT_NEAR(result[0].getPri(), 69e-6f, 1e-9f);
+    // max(minimum rx time 20 us, 35 us) -> 35 us
+    EXPECT_NEAR(result[1].getPri(), 35e-6f, 1e-9f);
+}
+
+TEST(SetMinimumPrisTest, ThrowsOnNegativeMargin) {
+    std::vector<TxRxParameters> seq = {getStdTxRxParameters(getNTimes(true, 128))};
+    EXPECT_THROW(setMinimumPris(seq, -1e-6f, Us4OEMSettings::ReprogrammingMode::SEQUENTIAL, std::nullopt),
+                 IllegalArgumentException);
+}
+
+// ------------------------------------------ getNumberOfCoalescedElements
+
+using ::arrus::framework::DataBufferSpec;
+
+TEST(GetNumberOfCoalescedElementsTest, ReturnsRequestedValueInAsyncMode) {
+    DataBufferSpec spec(DataBufferSpec::Type::FIFO, 8, 4);
+    EXPECT_EQ(getNumberOfCoalescedElements(spec, 4, 1, 1e-3f, Scheme::WorkMode::ASYNC), 4);
+    EXPECT_EQ(getNumberOfCoalescedElements(spec, 4, 1, 1e-3f, Scheme::WorkMode::SYNC), 4);
+}
+
+TEST(GetNumberOfCoalescedElementsTest, ReducesToDivisorOfRxBufferSize) {
+    DataBufferSpec spec(DataBufferSpec::Type::FIFO, 12, 4);
+    EXPECT_EQ(getNumberOfCoalescedElements(spec, 6, 1, 1e-3f, Scheme::WorkMode::ASYNC), 3);
+}
+
+TEST(GetNumberOfCoalescedElementsTest, ReducesToMeetLatencyLimit) {
+    // 2 x 1 ms per element, 5 ms latency -> at most 1 + 2 elements.
+    DataBufferSpec spec(DataBufferSpec::Type::FIFO, 8, 4, 5e-3f);
+    EXPECT_EQ(getNumberOfCoalescedElements(spec, 4, 2, 1e-3f, Scheme::WorkMode::ASYNC), 2);
+}
+
+TEST(GetNumberOfCoalescedElementsTest, AcceptsSingleElementInAllWorkModes) {
+    DataBufferSpec spec(DataBufferSpec::Type::FIFO, 4, 1);
+    for (auto workMode: {Scheme::WorkMode::ASYNC, Scheme::WorkMode::SYNC, Scheme::WorkMode::HOST,
+                         Scheme::WorkMode::MANUAL, Scheme::WorkMode::MANUAL_OP}) {
+        EXPECT_EQ(getNumberOfCoalescedElements(spec, 4, 1, 1e-3f, workMode), 1);
+    }
+}
+
+TEST(GetNumberOfCoalescedElementsTest, ThrowsOnCoalescingInModesWaitingForHost) {
+    // The sequencer stops after each element in these modes, so a group would never be completed.
+    DataBufferSpec spec(DataBufferSpec::Type::FIFO, 4, 2);
+    for (auto workMode: {Scheme::WorkMode::HOST, Scheme::WorkMode::MANUAL, Scheme::WorkMode::MANUAL_OP}) {
+        EXPECT_THROW(getNumberOfCoalescedElements(spec, 4, 1, 1e-3f, workMode), IllegalArgumentException);
+    }
+}
+
+}
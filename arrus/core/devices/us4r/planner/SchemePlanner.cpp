@@ -0,0 +1,149 @@
+#include "SchemePlanner.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/api/io/settings.h"
+#include "arrus/core/common/collections.h"
+#include "arrus/core/devices/TxRxParameters.h"
+#include "arrus/core/devices/probe/ProbeFactoryImpl.h"
+#include "arrus/core/devices/us4r/Us4OEMDataTransferRegistrar.h"
+#include "arrus/core/devices/us4r/Us4RSettingsConverterImpl.h"
+#include "arrus/core/devices/us4r/Us4RSettingsValidator.h"
+#include "arrus/core/devices/us4r/common.h"
+#include "arrus/core/devices/us4r/probeadapter/ProbeAdapterFactoryImpl.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMSettingsValidator.h"
+
+namespace arrus::devices {
+
+using ::arrus::ops::us4r::Scheme;
+
+SchemePlanner::SchemePlanner(const Us4RSettings &settings) {
+    Us4RSettingsValidator validator(0);
+    validator.validate(settings);
+    validator.throwOnErrors();
+    if (!settings.getProbeAdapterSettings().has_value()) {
+        throw IllegalArgumentException("Scheme planning is available for systems with probe adapter and probe only.");
+    }
+    auto &probeAdapterSettings = settings.getProbeAdapterSettings().value();
+    auto &probeSettings = settings.getProbeSettings().value();
+    auto &rxSettings = settings.getRxSettings().value();
+    auto [us4oemSettings, adapterSettings] = Us4RSettingsConverterImpl().convertToUs4OEMSettings(
+        probeAdapterSettings, probeSettings, rxSettings, settings.getChannelsMask(), settings.getReprogrammingMode(),
+        settings.getNumberOfUs4oems(), settings.getAdapterToUs4RModuleNumber(), settings.getTxFrequencyRange());
+
+    // The same assumption as in Us4RFactoryImpl: the frame metadata OEM acquires RX NOPs.
+    auto &io = probeAdapterSettings.getIOSettings();
+    std::unordered_set<Ordinal> pulseCounterOems;
+    if (io.hasFrameMetadataCapability()) {
+        pulseCounterOems = io.getFrameMetadataCapabilityOEMs();
+    } else {
+        pulseCounterOems.insert(Ordinal(0));
+    }
+    std::vector<Us4OEMImplBase::RawHandle> us4oemPtrs;
+    for (size_t i = 0; i < us4oemSettings.size(); ++i) {
+        auto ordinal = static_cast<Ordinal>(i);
+        auto &cfg = us4oemSettings[i];
+        Us4OEMSettingsValidator us4oemValidator(ordinal);
+        us4oemValidator.validate(cfg);
+        us4oemValidator.throwOnErrors();
+
+        std::vector<uint8_t> channelMapping;
+        for (auto value : cfg.getChannelMapping()) {
+            channelMapping.push_back(static_cast<uint8_t>(value));
+        }
+        us4oems.push_back(std::make_unique<VirtualUs4OEM>(DeviceId(DeviceType::Us4OEM, ordinal), channelMapping,
+                                                          cfg.getChannelsMask(), cfg.getReprogrammingMode(),
+                                                          setContains(pulseCounterOems, ordinal)));
+        us4oemPtrs.push_back(us4oems.back().get());
+    }
+    adapter = ProbeAdapterFactoryImpl().getProbeAdapter(adapterSettings, us4oemPtrs);
+    probe = ProbeFactoryImpl().getProbe(probeSettings, adapter.get());
+}
+
+SchemePlan SchemePlanner::plan(const Scheme &scheme) {
+    auto &seq = scheme.getTxRxSequence();
+    auto rxBufferNElements = scheme.getRxBufferSize();
+    auto hostBufferNElements = scheme.getOutputBuffer().getNumberOfElements();
+    auto batchSize = seq.getNRepeats();
+    if ((hostBufferNElements % rxBufferNElements) != 0) {
+        throw IllegalArgumentException(
+            format("The size of the host buffer {} must be equal or a multiple of the size of the rx buffer {}.",
+                   hostBufferNElements, rxBufferNElements));
+    }
+    auto &ddc = scheme.getDigitalDownConversion();
+    std::vector<TxRxParameters> actualSeq = toTxRxParamsSequence(seq);
+    if (seq.getAutoPriMargin().has_value()) {
+        actualSeq = setMinimumPris(actualSeq, seq.getAutoPriMargin().value(), us4oems.at(0)->getReprogrammingMode(),
+                                   ddc);
+    }
+    auto [rxBuffer, fcm] = probe->setTxRxSequence(actualSeq, seq.getTgcCurve(), rxBufferNElements, batchSize,
+                                                  seq.getSri(), scheme.getWorkMode(), ddc, scheme.getConstants());
+
+    std::vector<std::string> violations;
+    std::vector<Us4OEMPlan> us4oemPlans;
+    // All us4OEMs execute the same number of TX/RXs with the same PRIs, the master module determines the timing.
+    float sequenceDuration = us4oems.at(0)->getSequenceDuration();
+    size_t totalElementSize = 0;
+    size_t maxRxBufferSize = std::numeric_limits<uint16>::max();
+
+    for (Ordinal ordinal = 0; ordinal < us4oems.size(); ++ordinal) {
+        auto &us4oem = us4oems[ordinal];
+        auto &us4oemViolations = us4oem->getViolations();
+        violations.insert(std::end(violations), std::begin(us4oemViolations), std::end(us4oemViolations));
+
+        auto us4oemBuffer = rxBuffer->getUs4oemBuffer(ordinal);
+        size_t elementSize = us4oemBuffer.getElement(0).getViewSize();
+        // Each element of the rx buffer consists of batchSize sequences (nFirings TX/RXs each).
+        size_t nTriggersPerElement = us4oemBuffer.getElementParts().size();
+        auto nFirings = ARRUS_SAFE_CAST(nTriggersPerElement / batchSize, uint16);
+        size_t nTransfersPerElement = 0;
+        size_t nTransfers = 0;
+        int strategy = 0;
+        // NOTE: no transfers are registered when the us4OEM element size is 0 (see Us4RImpl::registerOutputBuffer).
+        if (elementSize > 0) {
+            nTransfersPerElement =
+                Us4OEMDataTransferRegistrar::groupPartsIntoTransfers(us4oemBuffer.getElementParts()).size();
+            nTransfers = nTransfersPerElement * rxBufferNElements;
+            strategy = Us4OEMDataTransferRegistrar::getStrategy(nTransfers,
+                                                                 nTransfersPerElement * hostBufferNElements);
+            if (nTransfers > Us4OEMDataTransferRegistrar::MAX_N_TRANSFERS) {
+                violations.push_back(format("{}: exceeded the maximum ({}) number of transfers: {}",
+                                            us4oem->getDeviceId().toString(),
+                                            Us4OEMDataTransferRegistrar::MAX_N_TRANSFERS, nTransfers));
+            }
+            maxRxBufferSize = std::min(maxRxBufferSize, Us4OEMImpl::DDR_SIZE / elementSize);
+            maxRxBufferSize =
+                std::min(maxRxBufferSize, Us4OEMDataTransferRegistrar::MAX_N_TRANSFERS / nTransfersPerElement);
+        }
+        maxRxBufferSize = std::min(maxRxBufferSize, (size_t) Us4OEMImpl::MAX_N_TRIGGERS / nTriggersPerElement);
+        totalElementSize += elementSize;
+        us4oemPlans.emplace_back(ordinal, nFirings, us4oem->getNumberOfTriggers(),
+                                 us4oem->getDdrUsage(), elementSize, nTransfersPerElement, nTransfers, strategy);
+    }
+    float frameRate = sequenceDuration > 0.0f ? 1.0f / sequenceDuration : 0.0f;
+    // A single element contains batchSize sequences.
+    float hostBandwidth = (float) totalElementSize * frameRate / (float) batchSize / 1e6f;
+    return SchemePlan{sequenceDuration, frameRate, hostBandwidth, static_cast<uint16>(maxRxBufferSize),
+                      std::move(us4oemPlans), std::move(violations)};
+}
+
+void SchemePlanner::setRxNopsMetadataOnly(bool value) {
+    for (auto &us4oem : us4oems) {
+        us4oem->setRxNopsMetadataOnly(value);
+    }
+}
+
+SchemePlan planScheme(const Us4RSettings &settings, const Scheme &scheme) {
+    return SchemePlanner(settings).plan(scheme);
+}
+
+SchemePlan planScheme(const std::string &filepath, const Scheme &scheme) {
+    auto settings = ::arrus::io::readSessionSettings(filepath);
+    return planScheme(settings.getUs4RSettings(0), scheme);
+}
+
+}
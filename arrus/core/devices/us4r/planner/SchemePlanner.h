@@ -0,0 +1,39 @@
+#ifndef ARRUS_CORE_DEVICES_US4R_PLANNER_SCHEMEPLANNER_H
+#define ARRUS_CORE_DEVICES_US4R_PLANNER_SCHEMEPLANNER_H
+
+#include <memory>
+#include <vector>
+
+#include "arrus/core/api/devices/us4r/SchemePlan.h"
+#include "arrus/core/api/devices/us4r/Us4RSettings.h"
+#include "arrus/core/api/ops/us4r/Scheme.h"
+#include "arrus/core/devices/probe/ProbeImplBase.h"
+#include "arrus/core/devices/us4r/planner/VirtualUs4OEM.h"
+#include "arrus/core/devices/us4r/probeadapter/ProbeAdapterImplBase.h"
+
+namespace arrus::devices {
+
+/**
+ * Compiles schemes against a virtual us4R (Probe -> ProbeAdapter -> virtual us4OEMs), built from the given
+ * us4R settings, and computes the resources that would be used by the real device.
+ */
+class SchemePlanner {
+public:
+    explicit SchemePlanner(const Us4RSettings &settings);
+
+    SchemePlan plan(const ::arrus::ops::us4r::Scheme &scheme);
+
+    /**
+     * See Us4R::setRxNopsMetadataOnly.
+     */
+    void setRxNopsMetadataOnly(bool value);
+
+private:
+    std::vector<std::unique_ptr<VirtualUs4OEM>> us4oems;
+    ProbeAdapterImplBase::Handle adapter;
+    ProbeImplBase::Handle probe;
+};
+
+}
+
+#endif //ARRUS_CORE_DEVICES_US4R_PLANNER_SCHEMEPLANNER_H
@@ -0,0 +1,58 @@
+#include "VirtualUs4OEM.h"
+
+#include <numeric>
+#include <utility>
+
+#include "arrus/common/format.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMTxRxValidator.h"
+
+namespace arrus::devices {
+
+VirtualUs4OEM::VirtualUs4OEM(DeviceId id, std::vector<uint8_t> channelMapping, std::unordered_set<uint8_t> channelsMask,
+                             Us4OEMSettings::ReprogrammingMode reprogrammingMode, bool acceptRxNops)
+    : Us4OEMImplBase(id), channelMapping(std::move(channelMapping)), channelsMask(std::move(channelsMask)),
+      reprogrammingMode(reprogrammingMode), acceptRxNops(acceptRxNops) {}
+
+Us4OEMSequence
+VirtualUs4OEM::compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgc,
+                                   uint16 rxBufferSize, uint16 batchSize, std::optional<float> sri,
+                                   arrus::ops::us4r::Scheme::WorkMode workMode,
+                                   const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
+                                   const std::vector<arrus::framework::NdArray> &txDelays) {
+    std::string deviceIdStr = getDeviceId().toString();
+    bool isDDCOn = ddc.has_value();
+    Us4OEMTxRxValidator seqValidator(format("{} tx rx sequence", deviceIdStr), Us4OEMImpl::MIN_TX_FREQUENCY,
+                                     Us4OEMImpl::MAX_TX_FREQUENCY, this->maxPulseLength);
+    seqValidator.validate(seq);
+    seqValidator.throwOnErrors();
+
+    auto rxMappings = Us4OEMImpl::getRxMappings(
+        seq, channelMapping, channelsMask, static_cast<FrameChannelMapping::Us4OEMNumber>(getDeviceId().getOrdinal()),
+        acceptRxNops && !rxNopsMetadataOnly);
+    auto layout = Us4OEMImpl::getBufferLayout(seq, rxBufferSize, batchSize, isDDCOn, acceptRxNops, rxNopsMetadataOnly);
+    std::optional<float> lastPriExtend = Us4OEMImpl::getLastPriExtend(std::begin(seq), std::end(seq), sri);
+    float duration = std::accumulate(std::begin(seq), std::end(seq), 0.0f,
+                                     [](const auto &a, const auto &b) { return a + b.getPri(); });
+    duration += lastPriExtend.value_or(0.0f);
+    return Us4OEMSequence{seq, tgc, rxBufferSize, batchSize, workMode, ddc, txDelays, lastPriExtend, duration,
+                          std::move(rxMappings), std::move(layout)};
+}
+
+void VirtualUs4OEM::programTxRxSequence(const Us4OEMSequence &sequence) {
+    const auto &seq = sequence.txrxs;
+    const auto &ddc = sequence.ddc;
+    violations = Us4OEMImpl::getSequenceViolations(getDeviceId().toString(), seq, sequence.rxBufferSize,
+                                                   sequence.batchSize, ddc, reprogrammingMode, sequence.rxMappings,
+                                                   sequence.layout);
+    nTriggers = static_cast<uint32>(seq.size() * sequence.batchSize * sequence.rxBufferSize);
+    ddrUsage = sequence.layout.ddrUsage;
+    if (!seq.empty()) {
+        // The sampling frequency of the last TX/RX, the same as in Us4OEMImpl.
+        float decimationFactor = ddc.has_value() ? ddc->getDecimationFactor()
+                                                 : (float) seq.back().getRxDecimationFactor();
+        this->currentSamplingFrequency = Us4OEMImpl::SAMPLING_FREQUENCY / decimationFactor;
+    }
+    sequenceDuration = sequence.duration;
+}
+
+}
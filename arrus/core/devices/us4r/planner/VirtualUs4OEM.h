@@ -0,0 +1,138 @@
+#ifndef ARRUS_CORE_DEVICES_US4R_PLANNER_VIRTUALUS4OEM_H
+#define ARRUS_CORE_DEVICES_US4R_PLANNER_VIRTUALUS4OEM_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "arrus/core/api/devices/us4r/Us4OEMSettings.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMImpl.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMImplBase.h"
+
+namespace arrus::devices {
+
+/**
+ * A us4OEM module without the underlying hardware.
+ *
+ * The TX/RX sequence is validated and compiled to the us4OEM RX mappings and buffer layout by the same functions
+ * as in Us4OEMImpl (Us4OEMImpl::getRxMappings, getBufferLayout, getSequenceViolations), but nothing is programmed.
+ * Violated hardware limits are collected (see getViolations) instead of being thrown, so the planner can report
+ * all of them at once. All other methods throw IllegalStateException.
+ */
+class VirtualUs4OEM : public Us4OEMImplBase {
+public:
+    VirtualUs4OEM(DeviceId id, std::vector<uint8_t> channelMapping, std::unordered_set<uint8_t> channelsMask,
+                  Us4OEMSettings::ReprogrammingMode reprogrammingMode, bool acceptRxNops);
+
+    Us4OEMSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<arrus::framework::NdArray> &txDelays) override;
+
+    /**
+     * Collects the results of the given sequence (see getViolations, getNumberOfTriggers, etc.).
+     */
+    void programTxRxSequence(const Us4OEMSequence &seq) override;
+
+    std::vector<uint8_t> getChannelMapping() override { return channelMapping; }
+
+    std::unordered_set<uint8_t> getChannelsMask() override { return channelsMask; }
+
+    Us4OEMSettings::ReprogrammingMode getReprogrammingMode() const override { return reprogrammingMode; }
+
+    bool isMaster() override { return getDeviceId().getOrdinal() == 0; }
+
+    float getSamplingFrequency() override { return Us4OEMImpl::SAMPLING_FREQUENCY; }
+
+    float getCurrentSamplingFrequency() const override { return currentSamplingFrequency; }
+
+    Interval<Voltage> getAcceptedVoltageRange() override {
+        return Interval<Voltage>(Us4OEMImpl::MIN_VOLTAGE, Us4OEMImpl::MAX_VOLTAGE);
+    }
+
+    void setMaximumPulseLength(std::optional<float> maxLength) override { this->maxPulseLength = maxLength; }
+
+    void setRxNopsMetadataOnly(bool value) override { this->rxNopsMetadataOnly = value; }
+
+    // Results of the last programmed sequence.
+    /**
+     * Returns the number of triggers that would be programmed.
+     */
+    uint32 getNumberOfTriggers() const { return nTriggers; }
+
+    /**
+     * Returns the number of bytes of DDR memory that would be used by the rx buffer.
+     */
+    size_t getDdrUsage() const { return ddrUsage; }
+
+    /**
+     * Returns the duration of a single sequence [s] (sum of PRIs, extended to SRI if necessary).
+     */
+    float getSequenceDuration() const override { return sequenceDuration; }
+
+    const std::vector<std::string> &getViolations() const { return violations; }
+
+    // Methods below require hardware.
+    void startTrigger() override { throwNoHardware(); }
+    void stopTrigger() override { throwNoHardware(); }
+    void syncTrigger() override { throwNoHardware(); }
+    void start() override { throwNoHardware(); }
+    void stop() override { throwNoHardware(); }
+    Ius4OEMRawHandle getIUs4oem() override { throwNoHardware(); }
+    void enableSequencer(uint16_t) override { throwNoHardware(); }
+    void setRxSettings(const RxSettings &) override { throwNoHardware(); }
+    void setTestPattern(RxTestPattern) override { throwNoHardware(); }
+    void setSubsequence(uint16, uint16, bool, const std::optional<float> &) override { throwNoHardware(); }
+    void clearCallbacks() override { throwNoHardware(); }
+    void sync(std::optional<long long>) override { throwNoHardware(); }
+    float getFPGATemperature() override { throwNoHardware(); }
+    float getUCDTemperature() override { throwNoHardware(); }
+    float getUCDExternalTemperature() override { throwNoHardware(); }
+    float getUCDMeasuredVoltage(uint8_t) override { throwNoHardware(); }
+    float getMeasuredHVPVoltage() override { throwNoHardware(); }
+    float getMeasuredHVMVoltage() override { throwNoHardware(); }
+    uint16_t getAfe(uint8_t) override { throwNoHardware(); }
+    void setAfe(uint8_t, uint16_t) override { throwNoHardware(); }
+    void setAfeDemod(float, float, const float *, size_t) override { throwNoHardware(); }
+    void disableAfeDemod() override { throwNoHardware(); }
+    void checkFirmwareVersion() override { throwNoHardware(); }
+    void checkState() override { throwNoHardware(); }
+    uint32 getFirmwareVersion() override { throwNoHardware(); }
+    uint32 getTxFirmwareVersion() override { throwNoHardware(); }
+    uint32_t getTxOffset() override { throwNoHardware(); }
+    uint32_t getOemVersion() override { throwNoHardware(); }
+    float getFPGAWallclock() override { throwNoHardware(); }
+    void setHpfCornerFrequency(uint32_t) override { throwNoHardware(); }
+    const char *getSerialNumber() override { throwNoHardware(); }
+    const char *getRevision() override { throwNoHardware(); }
+    void disableHpf() override { throwNoHardware(); }
+    HVPSMeasurement getHVPSMeasurement() override { throwNoHardware(); }
+    float setHVPSSyncMeasurement(uint16_t, float) override { throwNoHardware(); }
+    void setWaitForHVPSMeasurementDone() override { throwNoHardware(); }
+    void waitForHVPSMeasurementDone(std::optional<long long>) override { throwNoHardware(); }
+
+private:
+    [[noreturn]] void throwNoHardware() const {
+        throw IllegalStateException(
+            format("{} is a virtual device, the operation requires us4OEM hardware.", getDeviceId().toString()));
+    }
+
+    std::vector<uint8_t> channelMapping;
+    std::unordered_set<uint8_t> channelsMask;
+    Us4OEMSettings::ReprogrammingMode reprogrammingMode;
+    bool acceptRxNops;
+    bool rxNopsMetadataOnly{false};
+    std::optional<float> maxPulseLength{std::nullopt};
+    float currentSamplingFrequency{Us4OEMImpl::SAMPLING_FREQUENCY};
+
+    uint32 nTriggers{0};
+    size_t ddrUsage{0};
+    float sequenceDuration{0.0f};
+    std::vector<std::string> violations;
+};
+
+}
+
+#endif //ARRUS_CORE_DEVICES_US4R_PLANNER_VIRTUALUS4OEM_H
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include "VirtualUs4OEM.h"
+#include "arrus/core/common/tests.h"
+#include "arrus/core/common/collections.h"
+#include "arrus/core/common/logging.h"
+#include "arrus/core/api/ops/us4r/tgc.h"
+
+namespace {
+using namespace arrus;
+using namespace arrus::devices;
+using namespace arrus::ops::us4r;
+
+struct TestTxRxParams {
+
+    TestTxRxParams() {
+        for(int i = 0; i < 32; ++i) {
+            rxAperture[i] = true;
+        }
+    }
+
+    BitMask txAperture = getNTimes(true, Us4OEMImpl::N_TX_CHANNELS);
+    std::vector<float> txDelays = getNTimes(0.0f, Us4OEMImpl::N_TX_CHANNELS);
+    ops::us4r::Pulse pulse{2.0e6f, 2.5f, true};
+    BitMask rxAperture = getNTimes(false, Us4OEMImpl::N_ADDR_CHANNELS);
+    uint32 decimationFactor = 1;
+    float pri = 200e-6f;
+    Interval<uint32> sampleRange{0, 4096};
+
+    [[nodiscard]] TxRxParameters getTxRxParameters() const {
+        return TxRxParameters(txAperture, txDelays, pulse, rxAperture, sampleRange, decimationFactor, pri);
+    }
+};
+
+class VirtualUs4OEMTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        us4oem = std::make_unique<VirtualUs4OEM>(DeviceId(DeviceType::Us4OEM, 0), getRange<uint8>(0, 128),
+                                                 std::unordered_set<uint8>(),
+                                                 Us4OEMSettings::ReprogrammingMode::SEQUENTIAL, false);
+    }
+
+    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle>
+    setTxRxSequence(const std::vector<TxRxParameters> &seq, uint16 rxBufferSize, uint16 batchSize = 1,
+                    std::optional<float> sri = std::nullopt) {
+        return us4oem->setTxRxSequence(seq, {}, rxBufferSize, batchSize, sri, Scheme::WorkMode::SYNC, std::nullopt,
+                                       {});
+    }
+
+    std::unique_ptr<VirtualUs4OEM> us4oem;
+};
+
+TEST_F(VirtualUs4OEMTest, ComputesBufferLayout) {
+    std::vector<TxRxParameters> seq(3, TestTxRxParams().getTxRxParameters());
+    auto [buffer, fcm] = setTxRxSequence(seq, 4, 2);
+
+    size_t partSize = 4096 * Us4OEMImpl::N_RX_CHANNELS * sizeof(int16);
+    EXPECT_EQ(buffer.getNumberOfElements(), 4);
+    EXPECT_EQ(buffer.getElementParts().size(), 3 * 2);
+    EXPECT_EQ(buffer.getElement(0).getViewSize(), 3 * 2 * partSize);
+    EXPECT_EQ(buffer.getElement(1).getAddress(), 3 * 2 * partSize);
+    EXPECT_EQ(us4oem->getDdrUsage(), 4 * 3 * 2 * partSize);
+    EXPECT_EQ(us4oem->getNumberOfTriggers(), 3 * 2 * 4);
+    EXPECT_EQ(fcm->getNumberOfLogicalFrames(), 3);
+    EXPECT_FLOAT_EQ(us4oem->getSequenceDuration(), 3 * 200e-6f);
+    EXPECT_TRUE(us4oem->getViolations().empty());
+}
+
+TEST_F(VirtualUs4OEMTest, ExtendsSequenceDurationToSri) {
+    std::vector<TxRxParameters> seq(3, TestTxRxParams().getTxRxParameters());
+    setTxRxSequence(seq, 2, 1, 1e-3f);
+    EXPECT_FLOAT_EQ(us4oem->getSequenceDuration(), 1e-3f);
+}
+
+TEST_F(VirtualUs4OEMTest, SkipsRxNops) {
+    std::vector<TxRxParameters> seq = {
+        TestTxRxParams().getTxRxParameters(),
+        ARRUS_STRUCT_INIT_LIST(TestTxRxParams,
+                               (x.rxAperture = getNTimes(false, Us4OEMImpl::N_ADDR_CHANNELS))).getTxRxParameters()
+    };
+    auto [buffer, fcm] = setTxRxSequence(seq, 2);
+    size_t partSize = 4096 * Us4OEMImpl::N_RX_CHANNELS * sizeof(int16);
+    EXPECT_EQ(buffer.getElement(0).getViewSize(), partSize);
+    EXPECT_EQ(buffer.getElementParts()[1].getSize(), 0);
+    EXPECT_EQ(fcm->getNumberOfLogicalFrames(), 1);
+}
+
+TEST_F(VirtualUs4OEMTest, AcquiresOnlyMetadataForRxNops) {
+    us4oem = std::make_unique<VirtualUs4OEM>(DeviceId(DeviceType::Us4OEM, 0), getRange<uint8>(0, 128),
+                                             std::unordered_set<uint8>(),
+                                             Us4OEMSettings::ReprogrammingMode::SEQUENTIAL, true);
+    us4oem->setRxNopsMetadataOnly(true);
+    auto rxNop = ARRUS_STRUCT_INIT_LIST(TestTxRxParams,
+                                        (x.rxAperture = getNTimes(false, Us4OEMImpl::N_ADDR_CHANNELS)));
+    std::vector<TxRxParameters> seq = {
+        rxNop.getTxRxParameters(),
+        TestTxRxParams().getTxRxParameters(),
+        rxNop.getTxRxParameters(),
+    };
+    auto [buffer, fcm] = setTxRxSequence(seq, 2);
+    size_t rowSize = Us4OEMImpl::N_RX_CHANNELS * sizeof(int16);
+    size_t partSize = 4096 * rowSize;
+    size_t metadataSize = Us4OEMImpl::N_METADATA_SAMPLES * rowSize;
+    auto &parts = buffer.getElementParts();
+    // The data frame first, then the RX NOPs metadata, padded to the whole frame.
+    EXPECT_EQ(parts[0].getAddress(), partSize);
+    EXPECT_EQ(parts[0].getSize(), metadataSize);
+    EXPECT_EQ(parts[1].getAddress(), 0);
+    EXPECT_EQ(parts[1].getSize(), partSize);
+    EXPECT_EQ(parts[2].getAddress(), partSize + metadataSize);
+    EXPECT_EQ(buffer.getElement(0).getViewSize(), 2 * partSize);
+    EXPECT_EQ(buffer.getElement(1).getAddress(), 2 * partSize);
+    EXPECT_EQ(fcm->getNumberOfLogicalFrames(), 1);
+}
+
+TEST_F(VirtualUs4OEMTest, ReportsExceededNumberOfTriggers) {
+    std::vector<TxRxParameters> seq(
+        1024, ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 64})).getTxRxParameters());
+    setTxRxSequence(seq, 17);
+    EXPECT_EQ(us4oem->getViolations().size(), 1);
+}
+
+TEST_F(VirtualUs4OEMTest, ReportsExceededDdrMemory) {
+    std::vector<TxRxParameters> seq(
+        1000, ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 8192})).getTxRxParameters());
+    // 1000 * 8192 * 32 * 2 B = 524 MB per element
+    setTxRxSequence(seq, 9);
+    EXPECT_EQ(us4oem->getViolations().size(), 1);
+    setTxRxSequence(seq, 8);
+    EXPECT_TRUE(us4oem->getViolations().empty());
+}
+
+TEST_F(VirtualUs4OEMTest, ReportsTooShortPri) {
+    std::vector<TxRxParameters> seq = {
+        ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.pri = 50e-6f, x.sampleRange = {0, 4096})).getTxRxParameters()
+    };
+    // 4096/65e6 + 5us + 35us > 50 us
+    setTxRxSequence(seq, 1);
+    EXPECT_EQ(us4oem->getViolations().size(), 1);
+}
+
+TEST_F(VirtualUs4OEMTest, ThrowsOnHardwareAccess) {
+    EXPECT_THROW(us4oem->start(), IllegalStateException);
+    EXPECT_THROW(us4oem->getFPGATemperature(), IllegalStateException);
+}
+
+}
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
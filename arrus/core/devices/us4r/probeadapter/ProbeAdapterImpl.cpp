@@ -6,6 +6,7 @@
 #include "arrus/core/devices/us4r/FrameChannelMappingImpl.h"
 #include "arrus/core/devices/us4r/common.h"
 #include "arrus/core/external/eigen/Dense.h"
+#include <algorithm>
 #include <thread>
 
 #undef ERROR
@@ -59,18 +60,12 @@ private:
     ChannelIdx nChannels;
 };
 
-std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-ProbeAdapterImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
-                                  uint16 rxBufferSize, uint16 batchSize, std::optional<float> sri,
-                                  arrus::ops::us4r::Scheme::WorkMode workMode,
-                                  const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
-                                  const std::vector<arrus::framework::NdArray> &txDelayProfiles) {
-    // Reset current subsequence structures.
-    logicalToPhysicalOp.clear();
-    physicalOpToNextFrame.clear();
-    fullSequenceOEMBuffers.clear();
-    fullSequenceFCM.reset();
-
+ProbeAdapterSequence
+ProbeAdapterImpl::compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                                      uint16 rxBufferSize, uint16 batchSize, std::optional<float> sri,
+                                      arrus::ops::us4r::Scheme::WorkMode workMode,
+                                      const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
+                                      const std::vector<arrus::framework::NdArray> &txDelayProfiles) {
     // Validate input sequence
     ProbeAdapterTxRxValidator validator(::arrus::format("{} tx rx sequence", getDeviceId().toString()),
                                         numberOfChannels);
@@ -118,7 +113,7 @@ ProbeAdapterImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const
                                                    txDelayProfiles[i].getPlacement(), txDelayProfiles[i].getName());
             txDelayProfilesForModule.push_back(std::move(emptyArray));
         }
-        txDelayProfilesList.emplace(ordinal, txDelayProfilesForModule);
+        txDelayProfilesList.emplace(ordinal, std::move(txDelayProfilesForModule));
     }
 
     // Split Tx, Rx apertures and tx delays into sub-apertures specific for each us4oem module.
@@ -208,45 +203,47 @@ ProbeAdapterImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const
     }
     // split operations if necessary
     std::vector<std::vector<uint8_t>> us4oemL2PChannelMappings;
+    std::vector<std::unordered_set<uint8_t>> us4oemChannelsMasks;
     for (auto &us4oem : us4oems) {
         us4oemL2PChannelMappings.push_back(us4oem->getChannelMapping());
+        us4oemChannelsMasks.push_back(us4oem->getChannelsMask());
+    }
+    auto splitResult = splitRxAperturesIfNecessary(seqs, us4oemL2PChannelMappings, txDelayProfilesList,
+                                                   frameMetadataOem, us4oemChannelsMasks);
+    if (splitResult.nFiringsSaved > 0) {
+        logger->log(LogSeverity::INFO,
+                    ::arrus::format("Skipping masked rx channels reduced the number of TX/RXs by {} (to {}).",
+                           splitResult.nFiringsSaved, splitResult.sequences.at(0).size()));
     }
-    auto splitResult =
-        splitRxAperturesIfNecessary(seqs, us4oemL2PChannelMappings, txDelayProfilesList, frameMetadataOem);
     auto &splittedOps = splitResult.sequences;
     auto &opDstSplittedOp = splitResult.frames;
     auto &opDestSplittedCh = splitResult.channels;
     auto &us4oemTxDelayProfiles = splitResult.constants;
-    this->logicalToPhysicalOp = splitResult.logicalToPhysicalOp;
 
     calculateRxDelays(splittedOps);
 
-    // set sequence on each us4oem
-    std::vector<FrameChannelMapping::Handle> fcMappings;
-    // section -> us4oem -> transfer
-    std::vector<std::vector<DataTransfer>> outputTransfers;
+    // compile sequence for each us4oem
+    std::vector<Us4OEMSequence> us4oemSequences;
     uint32 currentFrameOffset = 0;
     std::vector<uint32> frameOffsets(static_cast<unsigned int>(us4oems.size()), 0);
     std::vector<uint32> numberOfFrames(static_cast<unsigned int>(us4oems.size()), 0);
 
-    Us4RBufferBuilder us4RBufferBuilder;
     for (Ordinal us4oemOrdinal = 0; us4oemOrdinal < us4oems.size(); ++us4oemOrdinal) {
         auto &us4oem = us4oems[us4oemOrdinal];
         std::vector<arrus::framework::NdArray> profile;
         if (!us4oemTxDelayProfiles.empty()) {
             profile = us4oemTxDelayProfiles.at(us4oemOrdinal);
         }
-        auto [buffer, fcMapping] = us4oem->setTxRxSequence(splittedOps[us4oemOrdinal], tgcSamples, rxBufferSize,
-                                                           batchSize, sri, workMode, ddc, profile);
+        auto us4oemSequence = us4oem->compileTxRxSequence(splittedOps[us4oemOrdinal], tgcSamples, rxBufferSize,
+                                                          batchSize, sri, workMode, ddc, profile);
+        const auto &fcMapping = us4oemSequence.rxMappings.fcm;
+        uint32 nFrames = fcMapping->getNumberOfLogicalFrames() * batchSize;
+        // The frame metadata OEM may store additional frames after the data frames (metadata-only RX NOPs).
+        uint32 nElementFrames = nFrames + ARRUS_SAFE_CAST(us4oemSequence.layout.nMetadataFrames, uint32);
         frameOffsets[us4oemOrdinal] = currentFrameOffset;
-        currentFrameOffset += fcMapping->getNumberOfLogicalFrames() * batchSize;
-        numberOfFrames[us4oemOrdinal] = fcMapping->getNumberOfLogicalFrames() * batchSize;
-        fcMappings.push_back(std::move(fcMapping));
-        // fcMapping is not valid anymore here
-        us4RBufferBuilder.pushBack(buffer);
-        this->fullSequenceOEMBuffers.push_back(buffer);
-        this->physicalOpToNextFrame.push_back(
-            OpToNextFrameMapping{ARRUS_SAFE_CAST(splittedOps[us4oemOrdinal].size(), uint16_t), buffer.getElementParts()});
+        currentFrameOffset += nElementFrames;
+        numberOfFrames[us4oemOrdinal] = nFrames;
+        us4oemSequences.push_back(std::move(us4oemSequence));
     }
 
     // generate FrameChannelMapping for the adapter output.
@@ -285,7 +282,7 @@ ProbeAdapterImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const
                     FrameChannelMapping::FrameNumber dstFrame = 0;
                     int8 dstFrameChannel = -1;
                     if (!FrameChannelMapping::isChannelUnavailable(dstChannel)) {
-                        auto res = fcMappings[dstModule]->getLogical(dstOp, dstChannel);
+                        auto res = us4oemSequences[dstModule].rxMappings.fcm->getLogical(dstOp, dstChannel);
                         us4oem = arrus::devices::get<0>(res);
                         dstFrame = arrus::devices::get<1>(res);
                         dstFrameChannel = arrus::devices::get<2>(res);
@@ -301,13 +298,45 @@ ProbeAdapterImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const
     outFcBuilder.setFrameOffsets(frameOffsets);
     outFcBuilder.setNumberOfFrames(numberOfFrames);
 
+    return ProbeAdapterSequence{std::move(us4oemSequences), splitResult.logicalToPhysicalOp, outFcBuilder.build(),
+                                batchSize, workMode};
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeAdapterImpl::programTxRxSequence(const ProbeAdapterSequence &seq) {
+    ARRUS_REQUIRES_EQUAL_IAE(seq.us4oemSequences.size(), us4oems.size());
+    // Reset current subsequence structures.
+    logicalToPhysicalOp.clear();
+    physicalOpToNextFrame.clear();
+    fullSequenceOEMBuffers.clear();
+    fullSequenceFCM.reset();
+
+    for (Ordinal us4oemOrdinal = 0; us4oemOrdinal < us4oems.size(); ++us4oemOrdinal) {
+        us4oems[us4oemOrdinal]->programTxRxSequence(seq.us4oemSequences[us4oemOrdinal]);
+    }
+    this->logicalToPhysicalOp = seq.logicalToPhysicalOp;
+    this->fullSequenceBatchSize = seq.batchSize;
+    for (const auto &us4oemSequence : seq.us4oemSequences) {
+        this->fullSequenceOEMBuffers.push_back(us4oemSequence.layout.buffer);
+    }
+    this->physicalOpToNextFrame = getOpToNextFrameMappings(seq);
     // Create the copy of FCM.
-    fullSequenceFCM = outFcBuilder.build();
+    fullSequenceFCM = FrameChannelMappingBuilder::copy(*seq.fcm).build();
     // Move the sequence to the beginning.
     this->oemSequencerStartEntry = 0;
-    this->isCurrentlyTriggerSync = arrus::ops::us4r::Scheme::isWorkModeManual(workMode);
+    this->isCurrentlyTriggerSync = arrus::ops::us4r::Scheme::isWorkModeManual(seq.workMode);
     // Return the copy of FCM.
-    return {us4RBufferBuilder.build(), outFcBuilder.build()};
+    return {seq.getBuffer(), FrameChannelMappingBuilder::copy(*seq.fcm).build()};
+}
+
+std::vector<ProbeAdapterImpl::OpToNextFrameMapping>
+ProbeAdapterImpl::getOpToNextFrameMappings(const ProbeAdapterSequence &seq) {
+    std::vector<OpToNextFrameMapping> result;
+    for (const auto &us4oemSequence : seq.us4oemSequences) {
+        result.emplace_back(ARRUS_SAFE_CAST(us4oemSequence.txrxs.size(), uint16_t),
+                            us4oemSequence.layout.buffer.getElementParts());
+    }
+    return result;
 }
 
 Ordinal ProbeAdapterImpl::getNumberOfUs4OEMs() { return ARRUS_SAFE_CAST(this->us4oems.size(), Ordinal); }
@@ -386,6 +415,48 @@ ProbeAdapterImpl::setSubsequence(uint16_t start, uint16_t end, const std::option
     for(auto &us4oem: us4oems) {
         us4oem->clearCallbacks();
     }
+    auto view = createSubsequenceView(logicalToPhysicalOp, fullSequenceOEMBuffers, physicalOpToNextFrame,
+                                      *fullSequenceFCM, start, end);
+    programSubsequence(start, end, sri);
+    return view;
+}
+
+void ProbeAdapterImpl::programSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        start <= end && end < logicalToPhysicalOp.size(),
+        format("The sub-sequence [{}, {}] is outside of the sequence: [0, {})", start, end,
+               logicalToPhysicalOp.size()));
+    uint16_t oemStart = logicalToPhysicalOp[start].first;
+    uint16_t oemEnd = logicalToPhysicalOp[end].second;
+    // Update OEM sequencer configuration.
+    bool syncMode = this->isCurrentlyTriggerSync;
+    for (auto &oem : us4oems) {
+        oem->setSubsequence(oemStart, oemEnd, syncMode, sri);
+    }
+    // Do not reset sequencer pointer -- the next ptr was already handled by the setSubsequence method.
+    this->oemSequencerStartEntry = oemStart;
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeAdapterImpl::getSubsequenceView(const ProbeAdapterSequence &seq, uint16_t start, uint16_t end,
+                                     const FrameChannelMapping &fcm) {
+    const auto nOps = seq.logicalToPhysicalOp.size();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        start <= end && end < nOps,
+        format("The sub-sequence [{}, {}] is outside of the sequence: [0, {})", start, end, nOps));
+    std::vector<Us4OEMBuffer> oemBuffers;
+    for (const auto &us4oemSequence : seq.us4oemSequences) {
+        oemBuffers.push_back(us4oemSequence.layout.buffer);
+    }
+    return createSubsequenceView(seq.logicalToPhysicalOp, oemBuffers, getOpToNextFrameMappings(seq),
+                                 dynamic_cast<const FrameChannelMappingImpl &>(fcm), start, end);
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeAdapterImpl::createSubsequenceView(const std::vector<std::pair<uint16_t, uint16_t>> &logicalToPhysicalOp,
+                                        const std::vector<Us4OEMBuffer> &oemBuffers,
+                                        const std::vector<OpToNextFrameMapping> &physicalOpToNextFrame,
+                                        const FrameChannelMappingImpl &fcm, uint16_t start, uint16_t end) {
     // Determine start/stop OEMs op.
     uint16_t oemStart = logicalToPhysicalOp[start].first;
     uint16_t oemEnd = logicalToPhysicalOp[end].second;
@@ -394,15 +465,15 @@ ProbeAdapterImpl::setSubsequence(uint16_t start, uint16_t end, const std::option
     // We only limit the range of the parts list and change the size and shape of the elements buffer (required
     // for creating new host buffer).
     // We do not recalculate firing numbers! This way transfer registrar will use the proper firing numbers.
-    for (const auto &oemBuffer : fullSequenceOEMBuffers) {
+    for (const auto &oemBuffer : oemBuffers) {
         us4RBufferBuilder.pushBack(oemBuffer.getView(oemStart, oemEnd));
     }
     // Update FCM.
-    FrameChannelMappingBuilder outFCMBuilder = FrameChannelMappingBuilder::copy(*fullSequenceFCM);
+    FrameChannelMappingBuilder outFCMBuilder = FrameChannelMappingBuilder::copy(fcm);
     outFCMBuilder.slice(start, end);// slice to logical frames to [start, end]
     // OEM nr -> number of frames
     std::vector<uint32> nFrames;
-    for (size_t oem = 0; oem < fullSequenceOEMBuffers.size(); ++oem) {
+    for (size_t oem = 0; oem < oemBuffers.size(); ++oem) {
         auto nextFrameNumber = physicalOpToNextFrame.at(oem).getNextFrame(oemStart);
         auto n = physicalOpToNextFrame.at(oem).getNumberOfFrames(oemStart, oemEnd);
         nFrames.push_back(n);
@@ -414,13 +485,45 @@ ProbeAdapterImpl::setSubsequence(uint16_t start, uint16_t end, const std::option
     // recalculate frame offsets
     outFCMBuilder.setNumberOfFrames(nFrames);
     outFCMBuilder.recalculateOffsets();
-    // Update OEM sequencer configuration.
-    bool syncMode = this->isCurrentlyTriggerSync;
-    for (auto &oem : us4oems) {
-        oem->setSubsequence(oemStart, oemEnd, syncMode, sri);
+    return {us4RBufferBuilder.build(), outFCMBuilder.build()};
+}
+
+std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+ProbeAdapterImpl::getTransferRoiView(const ProbeAdapterSequence &seq, const ops::us4r::TransferRoi &roi,
+                                     const FrameChannelMapping &fcm) {
+    const auto &logicalToPhysicalOp = seq.logicalToPhysicalOp;
+    auto physicalOpToNextFrame = getOpToNextFrameMappings(seq);
+    const auto nOps = ARRUS_SAFE_CAST(logicalToPhysicalOp.size(), uint16_t);
+    auto [start, end] = roi.getFrameRange().value_or(std::make_pair((uint16_t) 0, (uint16_t) (nOps - 1)));
+    auto [sampleBegin, sampleEnd] = roi.getSampleRange();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        start <= end && end < nOps,
+        format("The transfer ROI frames [{}, {}] are outside of the uploaded sequence: [0, {})", start, end, nOps));
+    // Determine start/stop OEMs op.
+    uint16_t oemStart = logicalToPhysicalOp[start].first;
+    uint16_t oemEnd = logicalToPhysicalOp[end].second;
+    // The ROI is applied to the data transfers only, so the firings (and us4OEM sequencers) stay unchanged.
+    Us4RBufferBuilder us4RBufferBuilder;
+    for (size_t oem = 0; oem < seq.us4oemSequences.size(); ++oem) {
+        const auto &oemBuffer = seq.us4oemSequences[oem].layout.buffer;
+        auto nPhysicalOps = ARRUS_SAFE_CAST(physicalOpToNextFrame.at(oem).opToNextFrame.size(), uint16_t);
+        us4RBufferBuilder.pushBack(oemBuffer.getTransferRoiView(oemStart, oemEnd, nPhysicalOps, sampleBegin, sampleEnd));
     }
-    // Do not reset sequencer pointer -- the next ptr was already handled by the setSubsequence method.
-    this->oemSequencerStartEntry = oemStart;
+    // Update FCM (the same way as for the sub-sequence).
+    FrameChannelMappingBuilder outFCMBuilder =
+        FrameChannelMappingBuilder::copy(dynamic_cast<const FrameChannelMappingImpl &>(fcm));
+    outFCMBuilder.slice(start, end);
+    std::vector<uint32> nFrames;
+    for (size_t oem = 0; oem < seq.us4oemSequences.size(); ++oem) {
+        auto nextFrameNumber = physicalOpToNextFrame.at(oem).getNextFrame(oemStart);
+        auto n = physicalOpToNextFrame.at(oem).getNumberOfFrames(oemStart, oemEnd);
+        nFrames.push_back(ARRUS_SAFE_CAST(n * seq.batchSize, uint32));
+        if (nextFrameNumber.has_value()) {
+            outFCMBuilder.subtractPhysicalFrameNumber((Ordinal)oem, nextFrameNumber.value());
+        }
+    }
+    outFCMBuilder.setNumberOfFrames(nFrames);
+    outFCMBuilder.recalculateOffsets();
     return {us4RBufferBuilder.build(), outFCMBuilder.build()};
 }
 
@@ -33,17 +33,20 @@ public:
         return numberOfChannels;
     }
 
+    ProbeAdapterSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<framework::NdArray> &txDelays) override;
+
     std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-    setTxRxSequence(const std::vector<TxRxParameters> &seq,
-                    const ops::us4r::TGCCurve &tgcSamples, uint16 rxBufferSize=2,
-                    uint16 rxBatchSize=1, std::optional<float> sri=std::nullopt,
-                    arrus::ops::us4r::Scheme::WorkMode workMode=arrus::ops::us4r::Scheme::WorkMode::SYNC,
-                    const std::optional<ops::us4r::DigitalDownConversion> &ddc = std::nullopt,
-                    const std::vector<framework::NdArray> &txDelays = std::vector<arrus::framework::NdArray>()
-                    ) override;
+    programTxRxSequence(const ProbeAdapterSequence &seq) override;
 
     Ordinal getNumberOfUs4OEMs() override;
 
+    Ordinal getFrameMetadataOem() const override { return frameMetadataOem; }
+
     void start() override;
 
     void stop() override;
@@ -53,11 +56,21 @@ public:
     std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
     setSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) override;
 
+    void programSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) override;
+
+    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getSubsequenceView(const ProbeAdapterSequence &seq, uint16_t start, uint16_t end,
+                       const FrameChannelMapping &fcm) override;
+
+    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getTransferRoiView(const ProbeAdapterSequence &seq, const ops::us4r::TransferRoi &roi,
+                       const FrameChannelMapping &fcm) override;
+
 private:
     struct OpToNextFrameMapping {
         OpToNextFrameMapping(uint16_t nFirings, const std::vector<Us4OEMBufferElementPart> &frames);
 
-        std::optional<uint16> getNextFrame(uint16 op) {
+        std::optional<uint16> getNextFrame(uint16 op) const {
             if(op >= opToNextFrame.size()) {
                 throw IllegalArgumentException("Accessing mapping outside the avialable range.");
             }
@@ -67,7 +80,7 @@ private:
         /**
          * Returns the number of frames acquired by ops with numbers between [start, end] (both inclusive).
          */
-        long getNumberOfFrames(uint16 start, uint16 end) {
+        long getNumberOfFrames(uint16 start, uint16 end) const {
             if(start > end || end >= isRxOp.size()) {
                 throw std::runtime_error("Accessing isRxOp outside the available range.");
             }
@@ -86,6 +99,17 @@ private:
     };
 
 
+    /** us4OEM number -> mapping of the given sequence. */
+    static std::vector<OpToNextFrameMapping> getOpToNextFrameMappings(const ProbeAdapterSequence &seq);
+    /**
+     * Returns the us4R buffer and FCM of the [start, end] sub-sequence of the sequence with the given
+     * properties (see the subsequence selection properties below).
+     */
+    static std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    createSubsequenceView(const std::vector<std::pair<uint16_t, uint16_t>> &logicalToPhysicalOp,
+                          const std::vector<Us4OEMBuffer> &oemBuffers,
+                          const std::vector<OpToNextFrameMapping> &physicalOpToNextFrame,
+                          const FrameChannelMappingImpl &fcm, uint16_t start, uint16_t end);
     void calculateRxDelays(std::vector<TxRxParamsSequence> &sequences);
     Ordinal getFrameMetadataOem(const us4r::IOSettings &settings);
 
@@ -104,6 +128,8 @@ private:
     /** OEM number -> physical op -> next frame number (from the complete frame sequence) */
     std::vector<OpToNextFrameMapping> physicalOpToNextFrame;
     FrameChannelMappingImpl::Handle fullSequenceFCM;
+    /** The number of sequences acquired within a single us4OEM buffer element. */
+    uint16 fullSequenceBatchSize{1};
     /** Sequencer start pointer that should be set in the next call of the start method. NOTE: this property
         will usually be set to 0, except the case where the setting Seqeuncer pointer to 0 is not acceptable
         e.g. after calling setSubsequence method with start > 0. */
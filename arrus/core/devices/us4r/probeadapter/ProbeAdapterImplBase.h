@@ -7,11 +7,39 @@
 #include "arrus/core/api/ops/us4r/tgc.h"
 #include "arrus/core/devices/TxRxParameters.h"
 #include "arrus/core/devices/us4r/DataTransfer.h"
+#include "arrus/core/devices/us4r/FrameChannelMappingImpl.h"
 #include "arrus/core/devices/us4r/Us4RBuffer.h"
 #include "arrus/core/devices/us4r/Us4ROutputBuffer.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMSequence.h"
 
 namespace arrus::devices {
 
+/**
+ * A TX/RX sequence compiled for the probe adapter (see ProbeAdapterImplBase::compileTxRxSequence).
+ */
+struct ProbeAdapterSequence {
+    /** us4OEM ordinal -> the sequence compiled for that us4OEM. */
+    std::vector<Us4OEMSequence> us4oemSequences;
+    /** Logical -> physical [start, end] op (TX/RX). */
+    std::vector<std::pair<uint16_t, uint16_t>> logicalToPhysicalOp;
+    /** The FCM of the adapter output. */
+    FrameChannelMappingImpl::Handle fcm;
+    /** The number of sequences acquired within a single us4OEM buffer element. */
+    uint16 batchSize;
+    ops::us4r::Scheme::WorkMode workMode;
+
+    /**
+     * Returns the layout of the us4R buffer, i.e. the buffers of the consecutive us4OEMs.
+     */
+    Us4RBuffer::Handle getBuffer() const {
+        Us4RBufferBuilder builder;
+        for (const auto &us4oemSequence : us4oemSequences) {
+            builder.pushBack(us4oemSequence.layout.buffer);
+        }
+        return builder.build();
+    }
+};
+
 class ProbeAdapterImplBase : public ProbeAdapter {
 public:
     using ProbeAdapter::ProbeAdapter;
@@ -19,14 +47,45 @@ public:
     using Handle = std::unique_ptr<ProbeAdapterImplBase>;
     using RawHandle = PtrHandle<ProbeAdapterImplBase>;
 
+    /**
+     * Splits the given TX/RX sequence into the us4OEM sequences and compiles them. Does not change the state
+     * of the adapter nor the us4OEMs.
+     */
+    virtual ProbeAdapterSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<arrus::framework::NdArray> &txDelays) = 0;
+
+    /**
+     * Programs the us4OEMs with the given compiled sequence.
+     *
+     * @return the us4R buffer and FCM of the sequence
+     */
     virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
-    setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples, uint16 rxBufferSize,
-                    uint16 rxBatchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
-                    const std::optional<ops::us4r::DigitalDownConversion> &ddc,
-                    const std::vector<arrus::framework::NdArray> &txDelays) = 0;
+    programTxRxSequence(const ProbeAdapterSequence &seq) = 0;
+
+    /**
+     * Compiles and programs the given TX/RX sequence.
+     */
+    std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                    uint16 rxBufferSize = 2, uint16 rxBatchSize = 1, std::optional<float> sri = std::nullopt,
+                    arrus::ops::us4r::Scheme::WorkMode workMode = arrus::ops::us4r::Scheme::WorkMode::SYNC,
+                    const std::optional<ops::us4r::DigitalDownConversion> &ddc = std::nullopt,
+                    const std::vector<arrus::framework::NdArray> &txDelays = std::vector<arrus::framework::NdArray>()) {
+        return programTxRxSequence(
+            compileTxRxSequence(seq, tgcSamples, rxBufferSize, rxBatchSize, sri, workMode, ddc, txDelays));
+    }
 
     virtual Ordinal getNumberOfUs4OEMs() = 0;
 
+    /**
+     * Returns the ordinal of the us4OEM which writes the frame metadata.
+     */
+    virtual Ordinal getFrameMetadataOem() const = 0;
+
     virtual void start() = 0;
 
     virtual void stop() = 0;
@@ -35,6 +94,33 @@ public:
 
     virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
     setSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) = 0;
+
+    /**
+     * Sets the us4OEM sequencers to the [start, end] sub-sequence (both inclusive) of the currently programmed
+     * sequence. Only the sequencer range and SRI are updated, the data transfers are left unchanged.
+     */
+    virtual void programSubsequence(uint16_t start, uint16_t end, const std::optional<float> &sri) = 0;
+
+    /**
+     * Returns the us4R buffer and FCM of the [start, end] sub-sequence (both inclusive) of the given sequence
+     * (see setSubsequence). Does not change the state of the device.
+     *
+     * @param fcm the FCM of the given sequence
+     */
+    virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getSubsequenceView(const ProbeAdapterSequence &seq, uint16_t start, uint16_t end,
+                       const FrameChannelMapping &fcm) = 0;
+
+    /**
+     * Returns the us4R buffer and FCM of the given sequence, limited to the given transfer ROI
+     * (see ops::us4r::TransferRoi). The us4OEM sequencers are not changed, only the data transfers should be
+     * programmed using the returned buffer.
+     *
+     * @param fcm the FCM of the given sequence
+     */
+    virtual std::tuple<Us4RBuffer::Handle, FrameChannelMapping::Handle>
+    getTransferRoiView(const ProbeAdapterSequence &seq, const ops::us4r::TransferRoi &roi,
+                       const FrameChannelMapping &fcm) = 0;
 };
 
 }// namespace arrus::devices
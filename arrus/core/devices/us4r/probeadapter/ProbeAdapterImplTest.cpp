@@ -74,29 +74,38 @@ Us4OEMBuffer createUs4OEMBuffer(FrameChannelMapping::FrameNumber nFrames, Channe
     return buffer;
 }
 
-std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> createEmptySetTxRxResult(FrameChannelMapping::Us4OEMNumber us4oem,
-                                                                               FrameChannelMapping::FrameNumber nFrames,
-                                                                               ChannelIdx nChannels,
-                                                                               uint32_t nSamples = 4096) {
+// A compiled us4OEM sequence with the given buffer and FCM, a single TX/RX per each buffer element part.
+Us4OEMSequence createUs4OEMSequence(const Us4OEMBuffer &buffer, FrameChannelMapping::Handle fcm) {
+    std::vector<TxRxParameters> txrxs(buffer.getElementParts().size(), TestTxRxParams{}.getTxRxParameters());
+    Us4OEMRxMappings rxMappings{{}, {}, {}, std::move(fcm)};
+    Us4OEMBufferLayout layout{{}, buffer, 0};
+    return Us4OEMSequence{txrxs, {}, 2, 1, Scheme::WorkMode::SYNC, std::nullopt, {}, std::nullopt, 0.0f,
+                          std::move(rxMappings), std::move(layout)};
+}
+
+Us4OEMSequence createEmptySetTxRxResult(FrameChannelMapping::Us4OEMNumber us4oem,
+                                        FrameChannelMapping::FrameNumber nFrames, ChannelIdx nChannels,
+                                        uint32_t nSamples = 4096) {
     FrameChannelMappingBuilder builder(nFrames, nChannels);
     for (int i = 0; i < nFrames; ++i) {
         for (int j = 0; j < nChannels; ++j) {
             builder.setChannelMapping(i, j, us4oem, i, j);
         }
     }
-    return std::make_tuple(createUs4OEMBuffer(nFrames, nChannels, nSamples), builder.build());
+    return createUs4OEMSequence(createUs4OEMBuffer(nFrames, nChannels, nSamples), builder.build());
 }
 
 class MockUs4OEM : public Us4OEMImplBase {
 public:
     explicit MockUs4OEM(Ordinal id) : Us4OEMImplBase(DeviceId(DeviceType::Us4OEM, id)) {}
 
-    MOCK_METHOD((std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle>), setTxRxSequence,
+    MOCK_METHOD(Us4OEMSequence, compileTxRxSequence,
                 (const TxRxParamsSequence &seq, const ::arrus::ops::us4r::TGCCurve &tgc, uint16 rxBufferSize,
                  uint16 batchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
                  const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
                  const std::vector<arrus::framework::NdArray> &txDelayProfiles),
                 (override));
+    MOCK_METHOD(void, programTxRxSequence, (const Us4OEMSequence &seq), (override));
     MOCK_METHOD(Interval<Voltage>, getAcceptedVoltageRange, (), (override));
     MOCK_METHOD(float, getSamplingFrequency, (), (override));
     MOCK_METHOD(float, getCurrentSamplingFrequency, (), (const, override));
@@ -110,6 +119,9 @@ public:
     MOCK_METHOD(Ius4OEMRawHandle, getIUs4oem, (), (override));
     MOCK_METHOD(void, enableSequencer, (uint16 startEntry), (override));
     MOCK_METHOD(std::vector<uint8_t>, getChannelMapping, (), (override));
+    MOCK_METHOD(std::unordered_set<uint8_t>, getChannelsMask, (), (override));
+    MOCK_METHOD(Us4OEMSettings::ReprogrammingMode, getReprogrammingMode, (), (const, override));
+    MOCK_METHOD(float, getSequenceDuration, (), (const, override));
     MOCK_METHOD(float, getFPGATemperature, (), (override));
     MOCK_METHOD(void, setTestPattern, (Us4OEMImpl::RxTestPattern), (override));
     MOCK_METHOD(void, checkFirmwareVersion, (), (override));
@@ -141,6 +153,7 @@ public:
     MOCK_METHOD(HVPSMeasurement, getHVPSMeasurement, (), (override));
     MOCK_METHOD(float, setHVPSSyncMeasurement, (uint16_t nSamples, float frequency), (override));
     MOCK_METHOD(void, setMaximumPulseLength, (std::optional<float> maxPulseLength), (override));
+    MOCK_METHOD(void, setRxNopsMetadataOnly, (bool value), (override));
     MOCK_METHOD(void, waitForHVPSMeasurementDone, (std::optional<long long> timeout), (override));
     MOCK_METHOD(void, setWaitForHVPSMeasurementDone, (), (override));
     MOCK_METHOD(void, sync, (std::optional<long long> timeout), (override));
@@ -237,7 +250,7 @@ class ProbeAdapterChannelMapping1Test : public AbstractProbeAdapterImplTest {
 #define EXPECT_SEQUENCE_PROPERTY_NFRAMES(deviceId, matcher, nFrames)                                                   \
     do {                                                                                                               \
                                                                                                                        \
-        EXPECT_CALL(*(us4oems[deviceId].get()), setTxRxSequence(matcher, _, _, _, _, _, _, _))                         \
+        EXPECT_CALL(*(us4oems[deviceId].get()), compileTxRxSequence(matcher, _, _, _, _, _, _, _))                         \
             .WillOnce(Return(ByMove(createEmptySetTxRxResult(deviceId, nFrames, 32))));                                \
     } while (0)
 
@@ -245,7 +258,7 @@ class ProbeAdapterChannelMapping1Test : public AbstractProbeAdapterImplTest {
 
 #define SET_TX_RX_SEQUENCE(probeAdapter, seq) probeAdapter->setTxRxSequence(seq, defaultTGCCurve)
 
-#define US4OEM_MOCK_SET_TX_RX_SEQUENCE() setTxRxSequence(_, _, _, _, _, _, _, _)
+#define US4OEM_MOCK_SET_TX_RX_SEQUENCE() compileTxRxSequence(_, _, _, _, _, _, _, _)
 
 TEST_F(ProbeAdapterChannelMapping1Test, DistributesTxAperturesCorrectly) {
     BitMask txAperture(64, false);
@@ -608,8 +621,8 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, ProducesCorrectFCMSingleDistribute
     auto fcm1 = builder1.build();
     auto us4oemBuffer = createUs4OEMBuffer(1, 32, 4096);
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res0(us4oemBuffer, std::move(fcm0));
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res1(us4oemBuffer, std::move(fcm1));
+    auto res0 = createUs4OEMSequence(us4oemBuffer, std::move(fcm0));
+    auto res1 = createUs4OEMSequence(us4oemBuffer, std::move(fcm1));
 
     EXPECT_CALL(*(us4oems[0].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res0))));
     EXPECT_CALL(*(us4oems[1].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res1))));
@@ -679,8 +692,8 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, ProducesCorrectFCMSingleDistribute
 
     auto us4oemBuffer = createUs4OEMBuffer(1, 32, 4096);
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res0(us4oemBuffer, std::move(fcm0));
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res1(us4oemBuffer, std::move(fcm1));
+    auto res0 = createUs4OEMSequence(us4oemBuffer, std::move(fcm0));
+    auto res1 = createUs4OEMSequence(us4oemBuffer, std::move(fcm1));
 
     EXPECT_CALL(*(us4oems[0].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res0))));
     EXPECT_CALL(*(us4oems[1].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res1))));
@@ -763,8 +776,8 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, ProducesCorrectFCMForMultiOpRxAper
 
     auto us4oemBuffer = createUs4OEMBuffer(2, 32, 4096);
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res0(us4oemBuffer, std::move(fcm0));
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res1(us4oemBuffer, std::move(fcm1));
+    auto res0 = createUs4OEMSequence(us4oemBuffer, std::move(fcm0));
+    auto res1 = createUs4OEMSequence(us4oemBuffer, std::move(fcm1));
 
     EXPECT_CALL(*(us4oems[0].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res0))));
     EXPECT_CALL(*(us4oems[1].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res1))));
@@ -845,8 +858,8 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, AppliesPaddingToFCMCorrectly) {
 
     auto us4oemBuffer = createUs4OEMBuffer(1, 32, 4096);
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res0(us4oemBuffer, std::move(fcm0));
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res1(us4oemBuffer, std::move(fcm1));
+    auto res0 = createUs4OEMSequence(us4oemBuffer, std::move(fcm0));
+    auto res1 = createUs4OEMSequence(us4oemBuffer, std::move(fcm1));
 
     EXPECT_CALL(*(us4oems[0].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res0))));
     EXPECT_CALL(*(us4oems[1].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res1))));
@@ -899,8 +912,8 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, AppliesPaddingToFCMCorrectlyRxAper
 
     auto us4oemBuffer = createUs4OEMBuffer(1, 32, 4096);
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res0(us4oemBuffer, std::move(fcm0));
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res1(us4oemBuffer, std::move(fcm1));
+    auto res0 = createUs4OEMSequence(us4oemBuffer, std::move(fcm0));
+    auto res1 = createUs4OEMSequence(us4oemBuffer, std::move(fcm1));
 
     EXPECT_CALL(*(us4oems[0].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res0))));
     EXPECT_CALL(*(us4oems[1].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res1))));
@@ -954,8 +967,8 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, AppliesPaddingToFCMCorrectlyRightS
 
     auto us4oemBuffer = createUs4OEMBuffer(1, 32, 4096);
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res0(us4oemBuffer, std::move(fcm0));
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle> res1(us4oemBuffer, std::move(fcm1));
+    auto res0 = createUs4OEMSequence(us4oemBuffer, std::move(fcm0));
+    auto res1 = createUs4OEMSequence(us4oemBuffer, std::move(fcm1));
 
     EXPECT_CALL(*(us4oems[0].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res0))));
     EXPECT_CALL(*(us4oems[1].get()), US4OEM_MOCK_SET_TX_RX_SEQUENCE()).WillOnce(Return(ByMove(std::move(res1))));
@@ -1056,9 +1069,9 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, SetsSubapertureCorrectly) {
                                 x.txDelays = getDefaultTxDelays(getNChannels())))
             .getTxRxParameters()};
 
-    EXPECT_CALL(*(us4oems[0].get()), setTxRxSequence(_, _, _, _, _, _, _, _))
+    EXPECT_CALL(*(us4oems[0].get()), compileTxRxSequence(_, _, _, _, _, _, _, _))
         .WillOnce(Return(ByMove(createEmptySetTxRxResult(0, 6, 32))));
-    EXPECT_CALL(*(us4oems[1].get()), setTxRxSequence(_, _, _, _, _, _, _, _))
+    EXPECT_CALL(*(us4oems[1].get()), compileTxRxSequence(_, _, _, _, _, _, _, _))
         .WillOnce(Return(ByMove(createEmptySetTxRxResult(1, 6, 32))));
 
     SET_TX_RX_SEQUENCE(probeAdapter, seq);
@@ -1165,6 +1178,41 @@ TEST_F(ProbeAdapterChannelMappingEsaote3Test, SetsSubapertureCorrectly) {
     EXPECT_EQ(firings, std::vector<uint16>({0, 1, 2, 3, 4, 5}));
 }
 
+TEST_F(ProbeAdapterChannelMappingEsaote3Test, CreatesSubsequenceViewWithoutProgrammingUs4OEMs) {
+    BitMask rxAperture128(getNChannels(), false);
+    setValuesInRange(rxAperture128, 0, 128, true);
+    auto op = ARRUS_STRUCT_INIT_LIST(TestTxRxParams,
+                                     (x.txAperture = getDefaultTxAperture(getNChannels()), x.rxAperture = rxAperture128,
+                                      x.txDelays = getDefaultTxDelays(getNChannels())))
+                  .getTxRxParameters();
+    std::vector<TxRxParameters> seq = {op, op, op};
+
+    EXPECT_CALL(*(us4oems[0].get()), compileTxRxSequence(_, _, _, _, _, _, _, _))
+        .WillOnce(Return(ByMove(createEmptySetTxRxResult(0, 6, 32))));
+    EXPECT_CALL(*(us4oems[1].get()), compileTxRxSequence(_, _, _, _, _, _, _, _))
+        .WillOnce(Return(ByMove(createEmptySetTxRxResult(1, 6, 32))));
+    EXPECT_CALL(*(us4oems[0].get()), programTxRxSequence(_)).Times(0);
+    EXPECT_CALL(*(us4oems[1].get()), programTxRxSequence(_)).Times(0);
+    EXPECT_CALL(*(us4oems[0].get()), setSubsequence(_, _, _, _)).Times(0);
+    EXPECT_CALL(*(us4oems[1].get()), setSubsequence(_, _, _, _)).Times(0);
+
+    auto compiled = probeAdapter->compileTxRxSequence(seq, defaultTGCCurve, 2, 1, std::nullopt,
+                                                      Scheme::WorkMode::SYNC, std::nullopt, {});
+    auto [buffer, fcm] = probeAdapter->getSubsequenceView(compiled, 1, 2, *compiled.fcm);
+
+    unsigned nSamples = 4096;
+    EXPECT_EQ(buffer->getElement(0).getShape(), NdArray::Shape({2 * 2 * 2 * nSamples, 32}));
+    for (Ordinal oem = 0; oem < 2; ++oem) {
+        auto parts = buffer->getUs4oemBuffer(oem).getElementParts();
+        std::vector<uint16> firings;
+        std::transform(std::begin(parts), std::end(parts), std::back_inserter(firings),
+                       [](const auto &part) { return part.getFiring(); });
+        EXPECT_EQ(firings, std::vector<uint16>({2, 3, 4, 5}));
+    }
+    EXPECT_EQ(fcm->getNumberOfLogicalFrames(), 2);
+    EXPECT_THROW(probeAdapter->getSubsequenceView(compiled, 2, 3, *compiled.fcm), IllegalArgumentException);
+}
+
 }// namespace
 
 int main(int argc, char **argv) {
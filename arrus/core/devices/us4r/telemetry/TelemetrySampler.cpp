@@ -0,0 +1,236 @@
+#include "TelemetrySampler.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#undef ERROR
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/common/logging.h"
+
+namespace arrus::devices {
+
+namespace {
+
+/**
+ * Lowers the priority of the calling thread, so the sampling does not compete with the data path threads.
+ */
+bool setCurrentThreadLowPriority() {
+#if defined(_WIN32)
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST) != 0;
+#elif defined(__linux__)
+    sched_param param{};
+    param.sched_priority = 0;
+    return pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) == 0;
+#else
+    return false;
+#endif
+}
+
+int64 getTimestamp() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}// namespace
+
+TelemetrySampler::TelemetrySampler(size_t nUs4OEMs, TelemetrySettings settings, ReadFunc read,
+                                   TelemetryAlertCallback onAlert)
+    : nUs4OEMs(nUs4OEMs), settings(std::move(settings)), readUs4OEM(std::move(read)), onAlert(std::move(onAlert)),
+      logger{getLoggerFactory()->getLogger()} {
+    ARRUS_INIT_COMPONENT_LOGGER(logger, "TelemetrySampler");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(this->settings.getSamplingPeriod() > 0.0f,
+                                     "Telemetry sampling period should be greater than 0.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(this->settings.getHistorySize() > 0,
+                                     "Telemetry history size should be greater than 0.");
+    nValuesPerUs4OEM = N_SCALARS + this->settings.getUCDRails().size();
+    nValuesPerSample = nUs4OEMs * nValuesPerUs4OEM;
+    size_t historySize = this->settings.getHistorySize();
+    // Note: the ring buffer is allocated once, here; the sampler thread does not allocate the ring memory.
+    seqs = std::make_unique<std::atomic<uint64>[]>(historySize);
+    timestamps = std::make_unique<std::atomic<int64>[]>(historySize);
+    values = std::make_unique<std::atomic<float>[]>(historySize * nValuesPerSample);
+    for (size_t i = 0; i < historySize; ++i) {
+        seqs[i].store(0, std::memory_order_relaxed);
+    }
+    // Two alerts per us4OEM: FPGA and UCD temperature.
+    isAlertActive = std::vector<bool>(nUs4OEMs * 2, false);
+    thread = std::thread(&TelemetrySampler::run, this);
+}
+
+TelemetrySampler::~TelemetrySampler() {
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        isStopped = true;
+    }
+    stopCv.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void TelemetrySampler::run() {
+    if (!setCurrentThreadLowPriority()) {
+        logger->log(LogSeverity::DEBUG, "Could not lower the telemetry sampler thread priority.");
+    }
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(settings.getSamplingPeriod()));
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock{mutex};
+    while (!isStopped) {
+        lock.unlock();
+        try {
+            sample();
+        } catch (const std::exception &e) {
+            logger->log(LogSeverity::ERROR, format("Telemetry sampling failed: {}", e.what()));
+        } catch (...) {
+            logger->log(LogSeverity::ERROR, "Telemetry sampling failed: unknown exception.");
+        }
+        lock.lock();
+        next += period;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            // The sampling took longer than the period, skip the missed samples.
+            next = now;
+        }
+        stopCv.wait_until(lock, next, [this]() { return isStopped; });
+    }
+}
+
+void TelemetrySampler::sample() {
+    std::vector<Us4OEMTelemetry> us4oems;
+    us4oems.reserve(nUs4OEMs);
+    for (Ordinal i = 0; i < nUs4OEMs; ++i) {
+        us4oems.push_back(readUs4OEM(i));
+    }
+    int64 timestamp = getTimestamp();
+    write(timestamp, us4oems);
+    for (Ordinal i = 0; i < nUs4OEMs; ++i) {
+        const auto &t = us4oems[i];
+        checkThreshold(timestamp, i, "FPGATemperature", t.getFPGATemperature(), settings.getMaxFPGATemperature(),
+                       2 * i);
+        checkThreshold(timestamp, i, "UCDTemperature", t.getUCDTemperature(), settings.getMaxUCDTemperature(),
+                       2 * i + 1);
+    }
+}
+
+void TelemetrySampler::checkThreshold(int64 timestamp, Ordinal us4oem, const char *parameter, float value,
+                                      const std::optional<float> &threshold, size_t alertIdx) {
+    if (!threshold.has_value() || std::isnan(value)) {
+        return;
+    }
+    bool isAbove = value > threshold.value();
+    if (isAbove && !isAlertActive[alertIdx]) {
+        logger->log(LogSeverity::WARNING,
+                    format("Us4OEM:{} {}: {} exceeds the threshold {}.", us4oem, parameter, value, threshold.value()));
+        if (onAlert) {
+            try {
+                onAlert(TelemetryAlert{timestamp, us4oem, parameter, value, threshold.value()});
+            } catch (const std::exception &e) {
+                logger->log(LogSeverity::ERROR, format("Telemetry alert callback failed: {}", e.what()));
+            } catch (...) {
+                logger->log(LogSeverity::ERROR, "Telemetry alert callback failed: unknown exception.");
+            }
+        }
+    }
+    isAlertActive[alertIdx] = isAbove;
+}
+
+void TelemetrySampler::write(int64 timestamp, const std::vector<Us4OEMTelemetry> &us4oems) {
+    const auto &rails = settings.getUCDRails();
+    uint64 i = nSamples.load(std::memory_order_relaxed);
+    size_t slot = i % settings.getHistorySize();
+    seqs[slot].store(2 * i + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    timestamps[slot].store(timestamp, std::memory_order_relaxed);
+    std::atomic<float> *dst = &values[slot * nValuesPerSample];
+    for (const auto &t : us4oems) {
+        dst[0].store(t.getFPGATemperature(), std::memory_order_relaxed);
+        dst[1].store(t.getUCDTemperature(), std::memory_order_relaxed);
+        dst[2].store(t.getUCDExternalTemperature(), std::memory_order_relaxed);
+        dst[3].store(t.getMeasuredHVPVoltage(), std::memory_order_relaxed);
+        dst[4].store(t.getMeasuredHVMVoltage(), std::memory_order_relaxed);
+        dst[5].store(t.getFPGAWallclock(), std::memory_order_relaxed);
+        const auto &voltages = t.getUCDMeasuredVoltages();
+        for (size_t r = 0; r < rails.size(); ++r) {
+            dst[N_SCALARS + r].store(r < voltages.size() ? voltages[r] : std::numeric_limits<float>::quiet_NaN(),
+                                     std::memory_order_relaxed);
+        }
+        dst += nValuesPerUs4OEM;
+    }
+    seqs[slot].store(2 * i + 2, std::memory_order_release);
+    nSamples.store(i + 1, std::memory_order_release);
+}
+
+bool TelemetrySampler::read(uint64 i, std::optional<TelemetrySnapshot> &output) const {
+    size_t slot = i % settings.getHistorySize();
+    uint64 seq = seqs[slot].load(std::memory_order_acquire);
+    if (seq != 2 * i + 2) {
+        return false;
+    }
+    int64 timestamp = timestamps[slot].load(std::memory_order_relaxed);
+    std::vector<Us4OEMTelemetry> us4oems;
+    us4oems.reserve(nUs4OEMs);
+    const std::atomic<float> *src = &values[slot * nValuesPerSample];
+    for (size_t o = 0; o < nUs4OEMs; ++o) {
+        std::vector<float> voltages(nValuesPerUs4OEM - N_SCALARS);
+        for (size_t r = 0; r < voltages.size(); ++r) {
+            voltages[r] = src[N_SCALARS + r].load(std::memory_order_relaxed);
+        }
+        us4oems.emplace_back(src[0].load(std::memory_order_relaxed), src[1].load(std::memory_order_relaxed),
+                             src[2].load(std::memory_order_relaxed), src[3].load(std::memory_order_relaxed),
+                             src[4].load(std::memory_order_relaxed), src[5].load(std::memory_order_relaxed),
+                             std::move(voltages));
+        src += nValuesPerUs4OEM;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seqs[slot].load(std::memory_order_relaxed) != seq) {
+        return false;
+    }
+    output.emplace(timestamp, std::move(us4oems));
+    return true;
+}
+
+std::optional<TelemetrySnapshot> TelemetrySampler::getLatest() const {
+    std::optional<TelemetrySnapshot> result;
+    while (true) {
+        uint64 n = nSamples.load(std::memory_order_acquire);
+        if (n == 0) {
+            return std::nullopt;
+        }
+        // The sampler thread writes the next slot, so the latest one can be overwritten only if the reader
+        // was delayed by the whole history; just read the newest sample again.
+        if (read(n - 1, result)) {
+            return result;
+        }
+    }
+}
+
+std::vector<TelemetrySnapshot> TelemetrySampler::getHistory() const {
+    std::vector<TelemetrySnapshot> result;
+    uint64 end = nSamples.load(std::memory_order_acquire);
+    uint64 historySize = settings.getHistorySize();
+    uint64 begin = end > historySize ? end - historySize : 0;
+    result.reserve(end - begin);
+    for (uint64 i = begin; i < end; ++i) {
+        std::optional<TelemetrySnapshot> snapshot;
+        if (read(i, snapshot)) {
+            result.push_back(std::move(snapshot.value()));
+        }
+        // Otherwise the sample was overwritten by a newer one in the meantime.
+    }
+    return result;
+}
+
+}// namespace arrus::devices
@@ -0,0 +1,102 @@
+#ifndef ARRUS_CORE_DEVICES_US4R_TELEMETRY_TELEMETRYSAMPLER_H
+#define ARRUS_CORE_DEVICES_US4R_TELEMETRY_TELEMETRYSAMPLER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "arrus/core/api/common/Logger.h"
+#include "arrus/core/api/devices/us4r/Telemetry.h"
+
+namespace arrus::devices {
+
+/**
+ * Samples the telemetry of all us4OEMs on a separate, low-priority thread.
+ *
+ * The samples are stored in a ring buffer of a fixed size (TelemetrySettings::getHistorySize). There is a single
+ * writer (the sampler thread); readers do not take any lock, they only retry when the sample they read was
+ * overwritten in the meantime, which can happen only when the reader is delayed by the whole history
+ * size of sampling periods.
+ */
+class TelemetrySampler {
+public:
+    using Handle = std::unique_ptr<TelemetrySampler>;
+    /** Reads the telemetry of the given us4OEM; should return NaN for the values that are not available. */
+    using ReadFunc = std::function<Us4OEMTelemetry(Ordinal)>;
+
+    /**
+     * Starts sampling.
+     *
+     * @param nUs4OEMs the number of us4OEMs to sample
+     * @param settings sampler settings
+     * @param read function that reads the telemetry of the given us4OEM
+     * @param onAlert called (on the sampler thread) when a value exceeds its threshold; the alert is triggered
+     *  once, when the value crosses the threshold
+     */
+    TelemetrySampler(size_t nUs4OEMs, TelemetrySettings settings, ReadFunc read, TelemetryAlertCallback onAlert);
+
+    /**
+     * Stops sampling and waits for the sampler thread.
+     */
+    ~TelemetrySampler();
+
+    TelemetrySampler(TelemetrySampler const &) = delete;
+    void operator=(TelemetrySampler const &) = delete;
+    TelemetrySampler(TelemetrySampler const &&) = delete;
+    void operator=(TelemetrySampler const &&) = delete;
+
+    /**
+     * Returns the most recent sample; nullopt if no sample is available yet.
+     */
+    std::optional<TelemetrySnapshot> getLatest() const;
+
+    /**
+     * Returns all the available samples, ordered from the oldest to the newest one.
+     */
+    std::vector<TelemetrySnapshot> getHistory() const;
+
+private:
+    // The number of the scalar values of a single us4OEM sample, excluding the UCD voltages.
+    static constexpr size_t N_SCALARS = 6;
+
+    void run();
+    void sample();
+    void checkThreshold(int64 timestamp, Ordinal us4oem, const char *parameter, float value,
+                        const std::optional<float> &threshold, size_t alertIdx);
+    void write(int64 timestamp, const std::vector<Us4OEMTelemetry> &us4oems);
+    /** Returns false when the i-th sample was overwritten (or is being written) by the sampler thread. */
+    bool read(uint64 i, std::optional<TelemetrySnapshot> &output) const;
+
+    size_t nUs4OEMs;
+    TelemetrySettings settings;
+    ReadFunc readUs4OEM;
+    TelemetryAlertCallback onAlert;
+    Logger::Handle logger;
+    size_t nValuesPerUs4OEM;
+    size_t nValuesPerSample;
+
+    // Ring buffer; the i-th sample is stored in the slot i % historySize; seqs[slot] == 2*i+2 means that the slot
+    // contains the i-th sample, odd values mean that the slot is being written.
+    std::unique_ptr<std::atomic<uint64>[]> seqs;
+    std::unique_ptr<std::atomic<int64>[]> timestamps;
+    std::unique_ptr<std::atomic<float>[]> values;
+    /** The number of samples written so far. */
+    std::atomic<uint64> nSamples{0};
+
+    /** Whether the given (us4OEM, parameter) value is currently above its threshold. */
+    std::vector<bool> isAlertActive;
+
+    std::mutex mutex;
+    std::condition_variable stopCv;
+    bool isStopped{false};
+    std::thread thread;
+};
+
+}// namespace arrus::devices
+
+#endif//ARRUS_CORE_DEVICES_US4R_TELEMETRY_TELEMETRYSAMPLER_H
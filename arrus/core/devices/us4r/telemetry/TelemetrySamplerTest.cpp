@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/common/logging.h"
+#include "arrus/core/devices/us4r/telemetry/TelemetrySampler.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::devices;
+
+constexpr float SAMPLING_PERIOD = 0.001f;
+
+/** Fake us4OEM: returns the current temperature; each read increments the number of reads. */
+class FakeUs4OEMs {
+public:
+    Us4OEMTelemetry read(Ordinal ordinal) {
+        float temperature = fpgaTemperature.load();
+        ++nReads;
+        return Us4OEMTelemetry{temperature, 40.0f + (float) ordinal, 30.0f, 90.0f, 90.0f, 1.0f,
+                               {3.3f, std::numeric_limits<float>::quiet_NaN()}};
+    }
+
+    TelemetrySampler::ReadFunc getReadFunc() {
+        return [this](Ordinal ordinal) { return read(ordinal); };
+    }
+
+    std::atomic<float> fpgaTemperature{50.0f};
+    std::atomic<size_t> nReads{0};
+};
+
+template<typename Predicate> bool waitFor(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+TEST(TelemetrySamplerTest, ProvidesTheLatestSample) {
+    FakeUs4OEMs us4oems;
+    TelemetrySampler sampler{2, TelemetrySettings{SAMPLING_PERIOD, 10, {1, 2}}, us4oems.getReadFunc(), nullptr};
+    ASSERT_TRUE(waitFor([&]() { return sampler.getLatest().has_value(); }));
+    us4oems.fpgaTemperature = 60.0f;
+    ASSERT_TRUE(waitFor([&]() { return sampler.getLatest()->getUs4OEM(0).getFPGATemperature() == 60.0f; }));
+
+    auto latest = sampler.getLatest().value();
+    ASSERT_EQ(latest.getNumberOfUs4OEMs(), 2);
+    EXPECT_EQ(latest.getUs4OEM(1).getUCDTemperature(), 41.0f);
+    EXPECT_EQ(latest.getUs4OEM(1).getMeasuredHVPVoltage(), 90.0f);
+    const auto &voltages = latest.getUs4OEM(1).getUCDMeasuredVoltages();
+    ASSERT_EQ(voltages.size(), 2);
+    EXPECT_EQ(voltages[0], 3.3f);
+    EXPECT_TRUE(std::isnan(voltages[1]));
+    EXPECT_GT(latest.getTimestamp(), 0);
+}
+
+TEST(TelemetrySamplerTest, KeepsTheGivenNumberOfTheMostRecentSamples) {
+    FakeUs4OEMs us4oems;
+    TelemetrySampler sampler{1, TelemetrySettings{SAMPLING_PERIOD, 5}, us4oems.getReadFunc(), nullptr};
+    ASSERT_TRUE(waitFor([&]() { return us4oems.nReads.load() >= 12; }));
+    auto history = sampler.getHistory();
+    EXPECT_GE(history.size(), 4);
+    EXPECT_LE(history.size(), 5);
+    for (size_t i = 1; i < history.size(); ++i) {
+        EXPECT_LE(history[i - 1].getTimestamp(), history[i].getTimestamp());
+    }
+}
+
+TEST(TelemetrySamplerTest, TriggersAlertOnceWhenValueCrossesThreshold) {
+    FakeUs4OEMs us4oems;
+    std::mutex mutex;
+    std::vector<TelemetryAlert> alerts;
+    auto onAlert = [&](const TelemetryAlert &alert) {
+        std::lock_guard<std::mutex> guard{mutex};
+        alerts.push_back(alert);
+    };
+    auto nAlerts = [&]() {
+        std::lock_guard<std::mutex> guard{mutex};
+        return alerts.size();
+    };
+    TelemetrySampler sampler{1, TelemetrySettings{SAMPLING_PERIOD, 10, {}, 70.0f}, us4oems.getReadFunc(), onAlert};
+    us4oems.fpgaTemperature = 80.0f;
+    ASSERT_TRUE(waitFor([&]() { return nAlerts() == 1; }));
+    // Still above the threshold: no new alerts.
+    size_t nReads = us4oems.nReads.load();
+    ASSERT_TRUE(waitFor([&]() { return us4oems.nReads.load() >= nReads + 5; }));
+    EXPECT_EQ(nAlerts(), 1);
+    // Below and then above again: new alert.
+    us4oems.fpgaTemperature = 60.0f;
+    nReads = us4oems.nReads.load();
+    ASSERT_TRUE(waitFor([&]() { return us4oems.nReads.load() >= nReads + 2; }));
+    us4oems.fpgaTemperature = 75.0f;
+    ASSERT_TRUE(waitFor([&]() { return nAlerts() == 2; }));
+
+    std::lock_guard<std::mutex> guard{mutex};
+    EXPECT_EQ(alerts[0].getParameter(), "FPGATemperature");
+    EXPECT_EQ(alerts[0].getUs4OEM(), 0);
+    EXPECT_EQ(alerts[0].getValue(), 80.0f);
+    EXPECT_EQ(alerts[0].getThreshold(), 70.0f);
+    EXPECT_EQ(alerts[1].getValue(), 75.0f);
+}
+
+TEST(TelemetrySamplerTest, StopsSamplingOnDestruction) {
+    FakeUs4OEMs us4oems;
+    {
+        TelemetrySampler sampler{1, TelemetrySettings{SAMPLING_PERIOD, 10}, us4oems.getReadFunc(), nullptr};
+        ASSERT_TRUE(waitFor([&]() { return us4oems.nReads.load() > 0; }));
+    }
+    size_t nReads = us4oems.nReads.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(us4oems.nReads.load(), nReads);
+}
+
+TEST(TelemetrySamplerTest, ThrowsOnInvalidSettings) {
+    FakeUs4OEMs us4oems;
+    EXPECT_THROW(TelemetrySampler(1, TelemetrySettings{0.0f, 10}, us4oems.getReadFunc(), nullptr),
+                 IllegalArgumentException);
+    EXPECT_THROW(TelemetrySampler(1, TelemetrySettings{1.0f, 0}, us4oems.getReadFunc(), nullptr),
+                 IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
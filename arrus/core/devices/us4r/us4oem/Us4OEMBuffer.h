@@ -14,15 +14,25 @@ namespace arrus::devices {
 class Us4OEMBufferElementPart {
 public:
     Us4OEMBufferElementPart(const size_t address, const size_t size, const uint16 firing, const unsigned nSamples)
-        : address(address), size(size), firing(firing), nSamples(nSamples) {}
+        : address(address), dstAddress(address), size(size), firing(firing), nSamples(nSamples) {}
+
+    /**
+     * @param dstAddress the address of this part in the host buffer element (relative to the beginning of the host
+     *   element component of this us4OEM), may differ from address when only a part of the data is transferred
+     */
+    Us4OEMBufferElementPart(const size_t address, const size_t dstAddress, const size_t size, const uint16 firing,
+                            const unsigned nSamples)
+        : address(address), dstAddress(dstAddress), size(size), firing(firing), nSamples(nSamples) {}
 
     size_t getAddress() const { return address; }
+    size_t getDstAddress() const { return dstAddress; }
     size_t getSize() const { return size; }
     uint16 getFiring() const { return firing; }
     unsigned getNSamples() const { return nSamples; }
 
 private:
     size_t address;
+    size_t dstAddress;
     size_t size;
     uint16 firing;
     unsigned nSamples;
@@ -128,7 +138,13 @@ public:
         auto b = std::begin(elementParts);
 
         // NOTE: +1 because end is inclusive
-        std::vector<Us4OEMBufferElementPart> newParts(b + start, b + end + 1);
+        std::vector<Us4OEMBufferElementPart> newParts;
+        // The view element starts at the first part, the parts are relative to the view element.
+        size_t viewBegin = (b + start)->getAddress();
+        for (auto it = b + start; it != b + end + 1; ++it) {
+            newParts.emplace_back(it->getAddress() - viewBegin, it->getDstAddress() - viewBegin, it->getSize(),
+                                  it->getFiring(), it->getNSamples());
+        }
         std::vector<Us4OEMBufferElement> newElements;
         size_t oldSize = getUniqueElementSize(elements);
         IGNORE_UNUSED(oldSize);
@@ -140,7 +156,7 @@ public:
         auto newShape = getShape(oldShape, newNSamples);
         for(const auto &oldElement: elements) {
             Us4OEMBufferElement newElement(oldElement);
-            newElement.address = oldElement.address + newParts.at(0).getAddress();
+            newElement.address = oldElement.address + viewBegin;
             newElement.viewSize = newSize;
             newElement.viewShape = newShape;
             newElements.push_back(newElement);
@@ -148,6 +164,64 @@ public:
         return Us4OEMBuffer(newElements, newParts);
     }
 
+    /**
+     * Returns the view of this buffer, that transfers only the given ROI of the data to the host:
+     * samples [sampleBegin, sampleEnd) of each part (each part is the output of a single TX/RX) and only
+     * the parts of ops [firstOp, lastOp] (the i-th part is the output of op i % nOps, where nOps is the number of ops
+     * of a single sequence; note: lastOp is inclusive). The other parts are kept with size 0 (so the firings of
+     * the sequence are kept unchanged).
+     *
+     * The element addresses are not changed (the parts are still relative to the beginning of the whole element),
+     * the parts are packed one after another in the host buffer element (see Us4OEMBufferElementPart::dstAddress).
+     */
+    Us4OEMBuffer getTransferRoiView(uint16 firstOp, uint16 lastOp, uint16 nOps,
+                                    unsigned sampleBegin, unsigned sampleEnd) const {
+        if (sampleBegin >= sampleEnd) {
+            throw IllegalArgumentException("Us4OEMBuffer transfer ROI: sample range begin should be less than end.");
+        }
+        if (firstOp > lastOp || lastOp >= nOps) {
+            throw IllegalArgumentException(
+                format("Us4OEMBuffer transfer ROI: invalid op range [{}, {}] (number of ops: {}).",
+                       firstOp, lastOp, nOps));
+        }
+        auto oldShape = getUniqueShape(elements);
+        std::vector<Us4OEMBufferElementPart> newParts;
+        size_t dstAddress = 0;
+        unsigned newNSamples = 0;
+        for (size_t i = 0; i < elementParts.size(); ++i) {
+            const auto &part = elementParts[i];
+            auto op = (uint16) (i % nOps);
+            if (part.getSize() == 0 || op < firstOp || op > lastOp) {
+                newParts.emplace_back(part.getAddress(), dstAddress, 0, part.getFiring(), 0);
+                continue;
+            }
+            if (part.getNSamples() < sampleEnd) {
+                throw IllegalArgumentException(
+                    format("Us4OEMBuffer transfer ROI: the sample range end ({}) exceeds the number of samples "
+                           "acquired by op {} ({}).", sampleEnd, op, part.getNSamples()));
+            }
+            size_t bytesPerSample = part.getSize() / part.getNSamples();
+            unsigned nSamples = sampleEnd - sampleBegin;
+            size_t size = nSamples * bytesPerSample;
+            newParts.emplace_back(part.getAddress() + sampleBegin * bytesPerSample, dstAddress, size,
+                                  part.getFiring(), nSamples);
+            dstAddress += size;
+            newNSamples += nSamples;
+        }
+        if (newNSamples == 0) {
+            throw IllegalArgumentException("Us4OEMBuffer transfer ROI: the ROI does not contain any data.");
+        }
+        auto newShape = getShape(oldShape, newNSamples);
+        std::vector<Us4OEMBufferElement> newElements;
+        for (const auto &oldElement : elements) {
+            Us4OEMBufferElement newElement(oldElement);
+            newElement.viewSize = dstAddress;
+            newElement.viewShape = newShape;
+            newElements.push_back(newElement);
+        }
+        return Us4OEMBuffer(newElements, newParts);
+    }
+
 private:
     size_t getUniqueElementSize(const std::vector<Us4OEMBufferElement> &els) const {
         std::unordered_set<size_t> sizes;
@@ -2,9 +2,13 @@
 
 #include <chrono>
 #include <cmath>
+#include <list>
+#include <numeric>
 #include <thread>
 #include <utility>
 
+#include <boost/algorithm/string/join.hpp>
+
 #include "arrus/common/asserts.h"
 #include "arrus/common/format.h"
 #include "arrus/common/utils.h"
@@ -21,6 +25,7 @@
 #include "arrus/core/devices/us4r/external/ius4oem/LPFCutoffValueMap.h"
 #include "arrus/core/devices/us4r/external/ius4oem/PGAGainValueMap.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMBuffer.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMTxRxValidator.h"
 
 namespace arrus::devices {
 
@@ -155,77 +160,12 @@ void Us4OEMImpl::disableHpf() { ius4oem->AfeDisableHPF(); }
 
 void Us4OEMImpl::resetAfe() { ius4oem->AfeSoftReset(); }
 
-class Us4OEMTxRxValidator : public Validator<TxRxParamsSequence> {
-public:
-    Us4OEMTxRxValidator(const std::string &componentName, float txFrequencyMin, float txFrequencyMax, std::optional<float> maxPulseLength=std::nullopt)
-        : Validator(componentName), txFrequencyMin(txFrequencyMin), txFrequencyMax(txFrequencyMax), maxPulseLength(maxPulseLength) {}
-
-    void validate(const TxRxParamsSequence &txRxs) {
-        // Validation according to us4oem technote
-        const auto decimationFactor = txRxs[0].getRxDecimationFactor();
-        const auto startSample = txRxs[0].getRxSampleRange().start();
-        for (size_t firing = 0; firing < txRxs.size(); ++firing) {
-            const auto &op = txRxs[firing];
-            if (!op.isNOP()) {
-                auto firingStr = ::arrus::format(" (firing {})", firing);
-
-                // Tx
-                ARRUS_VALIDATOR_EXPECT_EQUAL_M(op.getTxAperture().size(), size_t(Us4OEMImpl::N_TX_CHANNELS), firingStr);
-                ARRUS_VALIDATOR_EXPECT_EQUAL_M(op.getTxDelays().size(), size_t(Us4OEMImpl::N_TX_CHANNELS), firingStr);
-                ARRUS_VALIDATOR_EXPECT_ALL_IN_RANGE_VM(op.getTxDelays(), Us4OEMImpl::MIN_TX_DELAY,
-                                                       Us4OEMImpl::MAX_TX_DELAY, firingStr);
-
-                // Tx - pulse
-                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getTxPulse().getCenterFrequency(), txFrequencyMin, txFrequencyMax,
-                                                  firingStr);
-                if(maxPulseLength.has_value()) {
-                    float pulseLength = op.getTxPulse().getNPeriods()/op.getTxPulse().getCenterFrequency();
-                    ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(pulseLength, 0.0f, maxPulseLength.value(), firingStr);
-                }
-                else {
-                    // The legacy OEM constraint
-                    ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getTxPulse().getNPeriods(), 0.0f, 32.0f, firingStr);
-                }
-                float ignore = 0.0f;
-                float fractional = std::modf(op.getTxPulse().getNPeriods(), &ignore);
-                ARRUS_VALIDATOR_EXPECT_TRUE_M((fractional == 0.0f || fractional == 0.5f), (firingStr + ", n periods"));
-
-                // Rx
-                ARRUS_VALIDATOR_EXPECT_EQUAL_M(op.getRxAperture().size(), size_t(Us4OEMImpl::N_ADDR_CHANNELS),
-                                               firingStr);
-                size_t numberOfActiveRxChannels =
-                    std::accumulate(std::begin(op.getRxAperture()), std::end(op.getRxAperture()), 0);
-                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(numberOfActiveRxChannels, size_t(0), size_t(32), firingStr);
-                uint32 numberOfSamples = op.getNumberOfSamples();
-                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(
-                    // should be enough for condition rxTime < 4000 [us]
-                    numberOfSamples, Us4OEMImpl::MIN_NSAMPLES, Us4OEMImpl::MAX_NSAMPLES, firingStr);
-                ARRUS_VALIDATOR_EXPECT_DIVISIBLE_M(numberOfSamples, 64u, firingStr);
-                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getRxDecimationFactor(), 0, 10, firingStr);
-                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getPri(), Us4OEMImpl::MIN_PRI, Us4OEMImpl::MAX_PRI, firingStr);
-                ARRUS_VALIDATOR_EXPECT_TRUE_M(op.getRxDecimationFactor() == decimationFactor,
-                                              "Decimation factor should be the same for all operations." + firingStr);
-                ARRUS_VALIDATOR_EXPECT_TRUE_M(op.getRxSampleRange().start() == startSample,
-                                              "Start sample should be the same for all operations." + firingStr);
-                ARRUS_VALIDATOR_EXPECT_TRUE_M((op.getRxPadding() == ::arrus::Tuple<ChannelIdx>{0, 0}),
-                                              ("Rx padding is not allowed for us4oems. " + firingStr));
-            }
-        }
-    }
-
-private:
-    float txFrequencyMin;
-    float txFrequencyMax;
-    std::optional<float> maxPulseLength;
-};
-
-
-std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle>
-Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgc, uint16 rxBufferSize,
-                            uint16 batchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
-                            const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
-                            const std::vector<arrus::framework::NdArray> &txDelays) {
-    std::unique_lock<std::mutex> lock{stateMutex};
+Us4OEMSequence
+Us4OEMImpl::compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgc,
+                                uint16 rxBufferSize, uint16 batchSize, std::optional<float> sri,
+                                arrus::ops::us4r::Scheme::WorkMode workMode,
+                                const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
+                                const std::vector<arrus::framework::NdArray> &txDelays) {
     // Validate input sequence and parameters.
     std::string deviceIdStr = getDeviceId().toString();
     bool isDDCOn = ddc.has_value();
@@ -238,12 +178,41 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
     seqValidator.validate(seq);
     seqValidator.throwOnErrors();
 
+    // NOTE: the mappings, buffer layout and hardware limits are determined in the same way as in VirtualUs4OEM
+    // (the scheme planner), so the plan is consistent with what is programmed here.
+    auto rxMappings = getRxMappings(seq, channelMapping, channelsMask,
+                                    static_cast<FrameChannelMapping::Us4OEMNumber>(getDeviceId().getOrdinal()),
+                                    isRxNopFullFrame());
+    auto layout = getBufferLayout(seq, rxBufferSize, batchSize, isDDCOn, acceptRxNops, rxNopsMetadataOnly);
+    auto violations = getSequenceViolations(deviceIdStr, seq, rxBufferSize, batchSize, ddc, reprogrammingMode,
+                                            rxMappings, layout);
+    if (!violations.empty()) {
+        throw IllegalArgumentException(boost::algorithm::join(violations, "; "));
+    }
+    // Set frame repetition interval if possible.
+    std::optional<float> lastPriExtend = getLastPriExtend(std::begin(seq), std::end(seq), sri);
+    float duration = std::accumulate(std::begin(seq), std::end(seq), 0.0f,
+                                     [](float a, const auto &op) { return a + op.getPri(); })
+                     + lastPriExtend.value_or(0.0f);
+    return Us4OEMSequence{seq, tgc, rxBufferSize, batchSize, workMode, ddc, txDelays, lastPriExtend, duration,
+                          std::move(rxMappings), std::move(layout)};
+}
+
+void Us4OEMImpl::programTxRxSequence(const Us4OEMSequence &sequence) {
+    std::unique_lock<std::mutex> lock{stateMutex};
+    const auto &seq = sequence.txrxs;
+    const auto &tgc = sequence.tgc;
+    const auto &ddc = sequence.ddc;
+    const auto &txDelays = sequence.txDelays;
+    const auto &rxMappings = sequence.rxMappings;
+    const auto &layout = sequence.layout;
+    const auto rxBufferSize = sequence.rxBufferSize;
+    const auto batchSize = sequence.batchSize;
+    const auto workMode = sequence.workMode;
+    const auto &lastPriExtend = sequence.lastPriExtend;
+    bool isDDCOn = ddc.has_value();
     // General sequence parameters.
     auto nOps = static_cast<uint16>(seq.size());
-    ARRUS_REQUIRES_AT_MOST(nOps, 1024, ::arrus::format("Exceeded the maximum ({}) number of firings: {}", 1024, nOps));
-    ARRUS_REQUIRES_AT_MOST(
-        nOps * batchSize * rxBufferSize, 16384,
-        ::arrus::format("Exceeded the maximum ({}) number of triggers: {}", 16384, nOps * batchSize * rxBufferSize));
 
     RxSettingsBuilder rxSettingsBuilder(this->rxSettings);
     this->rxSettings = RxSettingsBuilder(this->rxSettings).setTgcSamples(tgc)->build();
@@ -253,7 +222,9 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
     ius4oem->SetNumberOfFirings(nOps);
     ius4oem->ClearScheduledReceive();
     ius4oem->ResetCallbacks();
-    auto [rxMappings, rxApertures, fcm] = setRxMappings(seq);
+    for (uint16 rxMapId = 0; rxMapId < rxMappings.mappings.size(); ++rxMapId) {
+        ius4oem->SetRxChannelMapping(rxMappings.mappings[rxMapId], rxMapId);
+    }
     // helper data
     const std::bitset<N_ADDR_CHANNELS> emptyAperture;
     const std::bitset<N_ACTIVE_CHANNEL_GROUPS> emptyChannelGroups;
@@ -278,16 +249,8 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
         auto endSample = std::get<1>(sampleRange);
         float decimationFactor = isDDCOn ? ddc->getDecimationFactor() : (float) op.getRxDecimationFactor();
         this->currentSamplingFrequency = SAMPLING_FREQUENCY / decimationFactor;
+        // The total TX/RX time has been already checked against PRI (getSequenceViolations).
         float rxTime = getRxTime(endSample, this->currentSamplingFrequency);
-
-        // Computing total TX/RX time
-        float txrxTime = 0.0f;
-        txrxTime = getTxRxTime(rxTime);
-        // receive time + reprogramming time
-        if (txrxTime > op.getPri()) {
-            throw IllegalArgumentException(::arrus::format(
-                "Total time required for a single TX/RX ({}) should not exceed PRI ({})", txrxTime, op.getPri()));
-        }
         if (op.isNOP()) {
             ius4oem->SetActiveChannelGroup(emptyChannelGroups, opIdx);
             // Intentionally filtering empty aperture to reduce possibility of a mistake.
@@ -303,7 +266,7 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
             // active channel groups already remapped in constructor
             ius4oem->SetActiveChannelGroup(activeChannelGroups, opIdx);
             auto txAperture = filterAperture(::arrus::toBitset<N_TX_CHANNELS>(op.getTxAperture()));
-            auto rxAperture = filterAperture(rxApertures[opIdx]);
+            auto rxAperture = filterAperture(::arrus::toBitset<N_ADDR_CHANNELS>(rxMappings.rxApertures[opIdx]));
             // Intentionally validating tx apertures, to reduce the risk of mistake channel activation
             // (e.g. the masked one).
             validateAperture(txAperture);
@@ -347,120 +310,59 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
     ius4oem->SetNTriggers(nOps * batchSize * rxBufferSize);
 
     // Program data acquisitions ("ScheduleReceive" part).
-    // element == the result data frame of the given operations sequence
-    // Buffer elements.
-    // The below code programs us4OEM sequencer to fill the us4OEM memory with the acquired data.
-    // us4oem RXDMA output address
-    size_t outputAddress = 0;
-    size_t transferAddressStart = 0;
-    uint16 firing = 0;
-    std::vector<Us4OEMBufferElement> rxBufferElements;
-    // Assumption: all elements consists of the same parts.
-    std::vector<Us4OEMBufferElementPart> rxBufferElementParts;
-
-    for (uint16 batchIdx = 0; batchIdx < rxBufferSize; ++batchIdx) {
-        // Total number of samples in a single batch.
-        unsigned int totalNSamples = 0;
-        // Sequences.
-        for (uint16 seqIdx = 0; seqIdx < batchSize; ++seqIdx) {
-            // Ops.
-            for (uint16 opIdx = 0; opIdx < seq.size(); ++opIdx) {
-                firing = opIdx + seqIdx * nOps + batchIdx * batchSize * nOps;
-                auto const &op = seq[opIdx];
-                auto [startSample, endSample] = op.getRxSampleRange().asPair();
-                size_t nSamples = endSample - startSample;
-                auto rxMapId = rxMappings.find(opIdx)->second;
-
-                // Start sample, after transforming to the system number of cycles.
-                // The start sample should be provided to the us4r-api
-                // as for the nominal sampling frequency of us4OEM, i.e. 65 MHz.
-                // The ARRUS API assumes that the start sample and end sample are for the same
-                // sampling frequency.
-                uint32_t startSampleRaw = 0;
-                // RX offset to the moment tx delay = 0.
-                uint32_t sampleOffset = 0;
-                // Number of samples to acquire to be set in us4r::IUS4OEM object.
-                size_t nSamplesRaw = 0;
-                // Number of bytes a single sample takes (e.g. RF: a single int16, IQ: a pair of int16)
-                size_t sampleSize = 0;
-
-                // Determine number of samples and offsets depending on whether hardware
-                // DDC is on or off.
-                if (isDDCOn) {
-                    float decInt = 0;
-                    float decFloat = modf(ddc->getDecimationFactor(), &decInt);
-                    uint32_t div = 1;
-
-                    if (decFloat == 0.5f) {
-                        div = 2;
-                    } else if (decFloat == 0.25f || decFloat == 0.75f) {
-                        div = 4;
-                    }
-
-                    if (startSample != (startSample / div) * div) {
-                        startSample = (startSample / div) * div;
-                        this->logger->log(LogSeverity::WARNING,
-                                          ::arrus::format("Decimation factor {} requires start offset to be multiple "
-                                                          "of {}. Offset adjusted to {}.",
-                                                          ddc->getDecimationFactor(), div, startSample));
-                    }
-                    startSampleRaw = startSample * (uint32_t) ddc->getDecimationFactor();
-                    sampleOffset = getTxStartSampleNumberAfeDemod(ddc->getDecimationFactor());
-                    nSamplesRaw = nSamples * 2;
-                    sampleSize = 2 * sizeof(OutputDType);
-                } else {
-                    startSampleRaw = startSample * op.getRxDecimationFactor();
-                    sampleOffset = ius4oem->GetTxOffset();
-                    nSamplesRaw = nSamples;
-                    sampleSize = sizeof(OutputDType);
-                }
-                size_t nBytes = nSamples * N_RX_CHANNELS * sampleSize;
-
-                ARRUS_REQUIRES_AT_MOST(
-                    outputAddress + nBytes, DDR_SIZE,
-                    ::arrus::format("Total data size cannot exceed 4GiB (device {})", getDeviceId().toString()));
+    // The below code programs us4OEM sequencer to fill the us4OEM memory with the acquired data,
+    // according to the buffer layout.
+    for (const auto &acquisition : layout.acquisitions) {
+        auto const &op = seq[acquisition.op];
+        auto startSample = op.getRxSampleRange().start();
+        size_t nSamples = acquisition.nSamples;
+        auto rxMapId = rxMappings.mappingIds[acquisition.op];
+
+        // Start sample, after transforming to the system number of cycles.
+        // The start sample should be provided to the us4r-api
+        // as for the nominal sampling frequency of us4OEM, i.e. 65 MHz.
+        // The ARRUS API assumes that the start sample and end sample are for the same
+        // sampling frequency.
+        uint32_t startSampleRaw = 0;
+        // RX offset to the moment tx delay = 0.
+        uint32_t sampleOffset = 0;
+        // Number of samples to acquire to be set in us4r::IUS4OEM object.
+        size_t nSamplesRaw = 0;
+
+        // Determine number of samples and offsets depending on whether hardware
+        // DDC is on or off.
+        if (isDDCOn) {
+            float decInt = 0;
+            float decFloat = modf(ddc->getDecimationFactor(), &decInt);
+            uint32_t div = 1;
+
+            if (decFloat == 0.5f) {
+                div = 2;
+            } else if (decFloat == 0.25f || decFloat == 0.75f) {
+                div = 4;
+            }
 
-                ius4oem->ScheduleReceive(firing, outputAddress, nSamplesRaw, sampleOffset + startSampleRaw,
-                                         op.getRxDecimationFactor() - 1, rxMapId, nullptr);
-                if (batchIdx == 0) {
-                    size_t partSize = 0;
-                    unsigned partNSamples = 0;
-                    if(!op.isRxNOP() || acceptRxNops) {
-                        partSize = nBytes;
-                        partNSamples = (unsigned) nSamples;
-                    }
-                    // Otherwise, make an empty part (i.e. partSize = 0).
-                    // (note: the firing number will be needed for transfer configuration to release element in
-                    // us4oem sequencer, and for the subSequence setter).
-                    rxBufferElementParts.emplace_back(outputAddress, partSize, firing, partNSamples);
-                }
-                if (!op.isRxNOP() || acceptRxNops) {
-                    // Also, allows rx nops.
-                    // For example, the master module gathers frame metadata, so we cannot miss any of it.
-                    // In all other cases, all RX nops are just overwritten.
-                    outputAddress += nBytes;
-                    totalNSamples += (unsigned) nSamples;
-                }
+            if (startSample != (startSample / div) * div) {
+                startSample = (startSample / div) * div;
+                this->logger->log(LogSeverity::WARNING,
+                                  ::arrus::format("Decimation factor {} requires start offset to be multiple "
+                                                  "of {}. Offset adjusted to {}.",
+                                                  ddc->getDecimationFactor(), div, startSample));
             }
+            startSampleRaw = startSample * (uint32_t) ddc->getDecimationFactor();
+            sampleOffset = getTxStartSampleNumberAfeDemod(ddc->getDecimationFactor());
+            nSamplesRaw = nSamples * 2;
+        } else {
+            startSampleRaw = startSample * op.getRxDecimationFactor();
+            sampleOffset = ius4oem->GetTxOffset();
+            nSamplesRaw = nSamples;
         }
-        // The size of the chunk, in the number of BYTES.
-        // NOTE: THE BELOW LINE MUST BE CONSISTENT WITH Us4OEMBuffer::getView IMPLEMENTATION!
-        auto size = outputAddress - transferAddressStart;
-        // Where the chunk starts.
-        auto srcAddress = transferAddressStart;
-        transferAddressStart = outputAddress;
-        // NOTE: THE BELOW LINE MUST BE CONSISTENT WITH Us4OEMBuffer::getView IMPLEMENTATION!
-        framework::NdArray::Shape shape = Us4OEMBuffer::getShape(isDDCOn, totalNSamples, N_RX_CHANNELS);
-        rxBufferElements.emplace_back(srcAddress, size, firing, shape, NdArrayDataType);
+        ius4oem->ScheduleReceive(acquisition.firing, acquisition.address, nSamplesRaw, sampleOffset + startSampleRaw,
+                                 op.getRxDecimationFactor() - 1, rxMapId, nullptr);
     }
 
-    // Set frame repetition interval if possible.
-    std::optional<float> lastPriExtend = getLastPriExtend(
-        std::begin(seq), std::end(seq), sri
-    );
-
     // Program triggers
-    firing = 0;
+    uint16 firing = 0;
     for (uint16 batchIdx = 0; batchIdx < rxBufferSize; ++batchIdx) {
         for (uint16 seqIdx = 0; seqIdx < batchSize; ++seqIdx) {
             for (uint16 opIdx = 0; opIdx < seq.size(); ++opIdx) {
@@ -485,6 +387,7 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
     }
     setAfeDemod(ddc);
     this->currentSequence = seq;
+    this->sequenceDuration = sequence.duration;
 
     if(arrus::ops::us4r::Scheme::isWorkModeManual(workMode)) {
         // Register event_done callback in case we would like to wait for the interrupt to happen
@@ -494,10 +397,20 @@ Us4OEMImpl::setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::u
             this->irqEvents.at(eventDoneIrq).notifyOne();
         });
     }
-    return {Us4OEMBuffer(rxBufferElements, rxBufferElementParts), std::move(fcm)};
 }
 
-float Us4OEMImpl::getTxRxTime(float rxTime) const {
+float Us4OEMImpl::getMinimumPri(size_t endSample, float samplingFrequency,
+                                 Us4OEMSettings::ReprogrammingMode reprogrammingMode) {
+    float txrxTime = getTxRxTime(getRxTime(endSample, samplingFrequency), reprogrammingMode);
+    // Triggers are set with 1 us resolution (see getTimeToNextTrigger).
+    float pri = std::ceil(txrxTime * 1e6f) / 1e6f;
+    if (pri < txrxTime) {
+        pri += 1e-6f;
+    }
+    return std::max(pri, MIN_PRI);
+}
+
+float Us4OEMImpl::getTxRxTime(float rxTime, Us4OEMSettings::ReprogrammingMode reprogrammingMode) {
     float txrxTime = 0.0f;
     if (reprogrammingMode == Us4OEMSettings::ReprogrammingMode::SEQUENTIAL) {
         txrxTime = rxTime + SEQUENCER_REPROGRAMMING_TIME;
@@ -510,25 +423,22 @@ float Us4OEMImpl::getTxRxTime(float rxTime) const {
     return txrxTime;
 }
 
-std::tuple<std::unordered_map<uint16, uint16>, std::vector<Us4OEMImpl::Us4OEMBitMask>, FrameChannelMapping::Handle>
-Us4OEMImpl::setRxMappings(const std::vector<TxRxParameters> &seq) {
-    // a map: op ordinal number -> rx map id
-    std::unordered_map<uint16, uint16> result;
+Us4OEMRxMappings Us4OEMImpl::getRxMappings(const std::vector<TxRxParameters> &seq,
+                                           const std::vector<uint8_t> &channelMapping,
+                                           const std::unordered_set<uint8_t> &channelsMask,
+                                           FrameChannelMapping::Us4OEMNumber us4oem, bool isRxNopFullFrame) {
+    Us4OEMRxMappings result;
+    // rx mapping -> rx map id
     std::unordered_map<std::vector<uint8>, uint16, ContainerHash<std::vector<uint8>>> rxMappings;
 
     // FC mapping
     auto numberOfOutputFrames = getNumberOfNoRxNOPs(seq);
-    if (acceptRxNops) {
+    if (isRxNopFullFrame) {
         // We transfer all module frames due to possible metadata stored in the frame (if enabled).
         numberOfOutputFrames = ARRUS_SAFE_CAST(seq.size(), ChannelIdx);
     }
     FrameChannelMappingBuilder fcmBuilder(numberOfOutputFrames, N_RX_CHANNELS);
 
-    // Rx apertures after taking into account possible conflicts in Rx channel
-    // mapping.
-    std::vector<Us4OEMBitMask> outputRxApertures;
-
-    uint16 rxMapId = 0;
     uint16 opId = 0;
     uint16 noRxNopId = 0;
 
@@ -539,7 +449,7 @@ Us4OEMImpl::setRxMappings(const std::vector<TxRxParameters> &seq) {
         std::vector<std::optional<uint8>> mapping;
         std::unordered_set<uint8> channelsUsed;
         // Convert rx aperture + channel mapping -> new rx aperture (with conflicting channels turned off).
-        std::bitset<N_ADDR_CHANNELS> outputRxAperture;
+        BitMask outputRxAperture(N_ADDR_CHANNELS, false);
         // Us4OEM channel number: values from 0-127
         uint8 channel = 0;
         // Number of Us4OEM active channel, values from 0-31
@@ -554,7 +464,7 @@ Us4OEMImpl::setRxMappings(const std::vector<TxRxParameters> &seq) {
                 // Physical channel number, values 0-31
                 auto rxChannel = channelMapping[channel];
                 rxChannel = rxChannel % N_RX_CHANNELS;
-                if (!setContains(channelsUsed, rxChannel) && !setContains(this->channelsMask, channel)) {
+                if (!setContains(channelsUsed, rxChannel) && !setContains(channelsMask, channel)) {
                     // This channel is OK.
                     // STRATEGY: if there are conflicting/masked rx channels, keep the
                     // first one (with the lowest channel number), turn off all
@@ -567,17 +477,15 @@ Us4OEMImpl::setRxMappings(const std::vector<TxRxParameters> &seq) {
                     mapping.emplace_back(std::nullopt);
                 }
                 auto frameNumber = noRxNopId;
-                if (acceptRxNops) {
+                if (isRxNopFullFrame) {
                     frameNumber = opId;
                 }
-                fcmBuilder.setChannelMapping(frameNumber, onChannel,
-                                             static_cast<FrameChannelMapping::Us4OEMNumber>(getDeviceId().getOrdinal()),
-                                             frameNumber, (int8) (mapping.size() - 1));
+                fcmBuilder.setChannelMapping(frameNumber, onChannel, us4oem, frameNumber, (int8) (mapping.size() - 1));
                 ++onChannel;
             }
             ++channel;
         }
-        outputRxApertures.push_back(outputRxAperture);
+        result.rxApertures.push_back(outputRxAperture);
 
         // Replace invalid channels with unused channels
         std::list<uint8> unusedChannels;
@@ -596,7 +504,7 @@ Us4OEMImpl::setRxMappings(const std::vector<TxRxParameters> &seq) {
             }
         }
         // Move all the non-active channels to the end of mapping.
-        while (rxMapping.size() != 32) {
+        while (rxMapping.size() != N_RX_CHANNELS) {
             rxMapping.push_back(unusedChannels.front());
             unusedChannels.pop_front();
         }
@@ -604,26 +512,149 @@ Us4OEMImpl::setRxMappings(const std::vector<TxRxParameters> &seq) {
         auto mappingIt = rxMappings.find(rxMapping);
         if (mappingIt == std::end(rxMappings)) {
             // Create new Rx channel mapping.
+            auto rxMapId = ARRUS_SAFE_CAST(result.mappings.size(), uint16);
             rxMappings.emplace(rxMapping, rxMapId);
-            result.emplace(opId, rxMapId);
-            // Set channel mapping
-            ARRUS_REQUIRES_TRUE(rxMapping.size() == N_RX_CHANNELS,
-                                format("Invalid size of the RX channel mapping to set: {}", rxMapping.size()));
-            ARRUS_REQUIRES_TRUE(
-                rxMapId < 128,
-                format("128 different rx mappings can be loaded only, deviceId: {}.", getDeviceId().toString()));
-            ius4oem->SetRxChannelMapping(rxMapping, rxMapId);
-            ++rxMapId;
+            result.mappingIds.push_back(rxMapId);
+            result.mappings.push_back(std::move(rxMapping));
         } else {
             // Use the existing one.
-            result.emplace(opId, mappingIt->second);
+            result.mappingIds.push_back(mappingIt->second);
         }
         ++opId;
         if (!isRxNop) {
             ++noRxNopId;
         }
     }
-    return {result, outputRxApertures, fcmBuilder.build()};
+    result.fcm = fcmBuilder.build();
+    return result;
+}
+
+Us4OEMBufferLayout Us4OEMImpl::getBufferLayout(const std::vector<TxRxParameters> &seq, uint16 rxBufferSize,
+                                               uint16 batchSize, bool isDDCOn, bool acceptRxNops,
+                                               bool rxNopsMetadataOnly) {
+    // element == the result data frame of the given operations sequence
+    // us4oem RXDMA output address
+    auto nOps = static_cast<uint16>(seq.size());
+    size_t outputAddress = 0;
+    size_t transferAddressStart = 0;
+    FiringIdx firing = 0;
+    std::vector<Us4OEMAcquisition> acquisitions;
+    std::vector<Us4OEMBufferElement> rxBufferElements;
+    // Assumption: all elements consists of the same parts.
+    std::vector<Us4OEMBufferElementPart> rxBufferElementParts;
+    size_t nMetadataFrames = 0;
+    // Metadata-only RX NOPs: the compact RX NOP frames are stored after all data frames of the given element,
+    // so the data frames are placed in the same way as for any other us4OEM.
+    bool isRxNopMetadataOnly = acceptRxNops && rxNopsMetadataOnly;
+    // Number of bytes a single sample takes (e.g. RF: a single int16, IQ: a pair of int16)
+    size_t sampleSize = isDDCOn ? 2 * sizeof(OutputDType) : sizeof(OutputDType);
+    size_t dataFramesSize = 0;
+    for (const auto &op : seq) {
+        if (!op.isRxNOP()) {
+            dataFramesSize += op.getNumberOfSamples() * N_RX_CHANNELS * sampleSize;
+        }
+    }
+    dataFramesSize *= batchSize;
+
+    for (uint16 batchIdx = 0; batchIdx < rxBufferSize; ++batchIdx) {
+        // Total number of samples in a single batch.
+        unsigned int totalNSamples = 0;
+        // Where the next metadata-only RX NOP frame will be written.
+        size_t metadataAddress = outputAddress + dataFramesSize;
+        // Sequences.
+        for (uint16 seqIdx = 0; seqIdx < batchSize; ++seqIdx) {
+            // Ops.
+            for (uint16 opIdx = 0; opIdx < nOps; ++opIdx) {
+                firing = (FiringIdx) (opIdx + seqIdx * nOps + batchIdx * batchSize * nOps);
+                auto const &op = seq[opIdx];
+                bool isMetadataOnly = isRxNopMetadataOnly && op.isRxNOP();
+                size_t nSamples = isMetadataOnly ? N_METADATA_SAMPLES : op.getNumberOfSamples();
+                size_t nBytes = nSamples * N_RX_CHANNELS * sampleSize;
+                size_t address = isMetadataOnly ? metadataAddress : outputAddress;
+                bool isAcquired = !op.isRxNOP() || acceptRxNops;
+                acquisitions.push_back(Us4OEMAcquisition{firing, opIdx, address, nSamples});
+                if (batchIdx == 0) {
+                    // Not acquired: make an empty part (i.e. partSize = 0).
+                    // (note: the firing number will be needed for transfer configuration to release element in
+                    // us4oem sequencer, and for the subSequence setter).
+                    rxBufferElementParts.emplace_back(address, isAcquired ? nBytes : 0, firing,
+                                                      isAcquired ? (unsigned) nSamples : 0);
+                }
+                if (isMetadataOnly) {
+                    metadataAddress += nBytes;
+                    totalNSamples += (unsigned) nSamples;
+                } else if (isAcquired) {
+                    // Also, allows rx nops.
+                    // For example, the master module gathers frame metadata, so we cannot miss any of it.
+                    // In all other cases, all RX nops are just overwritten.
+                    outputAddress += nBytes;
+                    totalNSamples += (unsigned) nSamples;
+                }
+            }
+        }
+        if (isRxNopMetadataOnly && metadataAddress > outputAddress) {
+            // Pad the element to the whole number of frames, so the frames of the next us4OEMs in the host buffer
+            // element still start at the frame boundary (see FrameChannelMapping::getFrameOffsets).
+            size_t frameSize = seq.at(0).getNumberOfSamples() * N_RX_CHANNELS * sampleSize;
+            size_t elementSize = metadataAddress - transferAddressStart;
+            size_t padding = (frameSize - elementSize % frameSize) % frameSize;
+            outputAddress = metadataAddress + padding;
+            totalNSamples += (unsigned) (padding / (N_RX_CHANNELS * sampleSize));
+            nMetadataFrames = (outputAddress - transferAddressStart - dataFramesSize) / frameSize;
+        }
+        // The size of the chunk, in the number of BYTES.
+        // NOTE: THE BELOW LINE MUST BE CONSISTENT WITH Us4OEMBuffer::getView IMPLEMENTATION!
+        auto size = outputAddress - transferAddressStart;
+        // Where the chunk starts.
+        auto srcAddress = transferAddressStart;
+        transferAddressStart = outputAddress;
+        // NOTE: THE BELOW LINE MUST BE CONSISTENT WITH Us4OEMBuffer::getView IMPLEMENTATION!
+        framework::NdArray::Shape shape = Us4OEMBuffer::getShape(isDDCOn, totalNSamples, N_RX_CHANNELS);
+        rxBufferElements.emplace_back(srcAddress, size, firing, shape, NdArrayDataType);
+    }
+    // The metadata-only frames are always placed before the end of the element (see padding above).
+    return Us4OEMBufferLayout{std::move(acquisitions), Us4OEMBuffer(rxBufferElements, rxBufferElementParts),
+                              outputAddress, nMetadataFrames};
+}
+
+std::vector<std::string>
+Us4OEMImpl::getSequenceViolations(const std::string &deviceId, const std::vector<TxRxParameters> &seq,
+                                  uint16 rxBufferSize, uint16 batchSize,
+                                  const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                                  Us4OEMSettings::ReprogrammingMode reprogrammingMode,
+                                  const Us4OEMRxMappings &rxMappings, const Us4OEMBufferLayout &layout) {
+    std::vector<std::string> violations;
+    size_t nOps = seq.size();
+    if (nOps > MAX_N_FIRINGS) {
+        violations.push_back(
+            format("{}: exceeded the maximum ({}) number of firings: {}", deviceId, MAX_N_FIRINGS, nOps));
+    }
+    size_t nTriggers = nOps * batchSize * rxBufferSize;
+    if (nTriggers > MAX_N_TRIGGERS) {
+        violations.push_back(
+            format("{}: exceeded the maximum ({}) number of triggers: {}", deviceId, MAX_N_TRIGGERS, nTriggers));
+    }
+    size_t nRxMappings = rxMappings.mappings.size();
+    if (nRxMappings > MAX_N_RX_MAPPINGS) {
+        violations.push_back(format("{}: exceeded the maximum ({}) number of rx mappings: {}", deviceId,
+                                    MAX_N_RX_MAPPINGS, nRxMappings));
+    }
+    for (size_t opIdx = 0; opIdx < nOps; ++opIdx) {
+        auto const &op = seq[opIdx];
+        float decimationFactor = ddc.has_value() ? ddc->getDecimationFactor() : (float) op.getRxDecimationFactor();
+        float rxTime = getRxTime(op.getRxSampleRange().end(), SAMPLING_FREQUENCY / decimationFactor);
+        // receive time + reprogramming time
+        float txrxTime = getTxRxTime(rxTime, reprogrammingMode);
+        if (txrxTime > op.getPri()) {
+            violations.push_back(format("{}: total time required for TX/RX {} ({}) exceeds PRI ({})", deviceId,
+                                        opIdx, txrxTime, op.getPri()));
+        }
+    }
+    if (layout.ddrUsage > DDR_SIZE) {
+        violations.push_back(format("{}: total data size ({} B) exceeds DDR memory size ({} B)", deviceId,
+                                    layout.ddrUsage, DDR_SIZE));
+    }
+    return violations;
 }
 
 float Us4OEMImpl::getSamplingFrequency() { return Us4OEMImpl::SAMPLING_FREQUENCY; }
@@ -687,6 +718,8 @@ void Us4OEMImpl::enableSequencer(uint16_t startEntry) {
 
 std::vector<uint8_t> Us4OEMImpl::getChannelMapping() { return channelMapping; }
 
+std::unordered_set<uint8_t> Us4OEMImpl::getChannelsMask() { return channelsMask; }
+
 // AFE setters
 void Us4OEMImpl::setTgcCurve(const RxSettings &afeCfg) {
     const ops::us4r::TGCCurve &tgc = afeCfg.getTgcSamples();
@@ -929,6 +962,10 @@ const char* Us4OEMImpl::getSerialNumber() { return this->serialNumber.get().c_st
 const char *Us4OEMImpl::getRevision() { return this->revision.get().c_str(); }
 
 void Us4OEMImpl::setSubsequence(uint16 start, uint16 end, bool syncMode, const std::optional<float> &sri) {
+    if (acceptRxNops && rxNopsMetadataOnly) {
+        throw IllegalStateException(
+            ::arrus::format("{}: sub-sequences are not available with metadata-only RX NOPs.", getDeviceId().toString()));
+    }
     // NOTE: end is inclusive (and the below method expects [start, end) range.
     std::optional<float> priExtend = getLastPriExtend(
         std::begin(currentSequence)+start,
@@ -943,6 +980,7 @@ void Us4OEMImpl::setSubsequence(uint16 start, uint16 end, bool syncMode, const s
         // Just use the PRI of the end TX/RX.
         timeToNextTrigger = getTimeToNextTrigger(this->currentSequence.at(end).getPri());
     }
+    this->sequenceDuration = getSubsequenceDuration(currentSequence, start, end, sri);
     this->ius4oem->SetSubsequence(start, end, syncMode, timeToNextTrigger);
 }
 
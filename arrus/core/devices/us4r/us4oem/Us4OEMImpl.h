@@ -3,7 +3,9 @@
 
 #include <utility>
 #include <iostream>
+#include <string>
 #include <unordered_set>
+#include <vector>
 #include <ius4oem.h>
 
 #include "IRQEvent.h"
@@ -22,6 +24,7 @@
 #include "arrus/core/devices/us4r/external/ius4oem/IUs4OEMFactory.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMBuffer.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMImplBase.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMSequence.h"
 
 namespace arrus::devices {
 
@@ -72,6 +75,8 @@ public:
     static constexpr float SAMPLING_FREQUENCY = 65e6;
     static constexpr uint32 MIN_NSAMPLES = 64;
     static constexpr uint32 MAX_NSAMPLES = 16384;
+    /** The number of samples acquired by RX NOPs in the metadata-only mode (see setRxNopsMetadataOnly). */
+    static constexpr uint32 N_METADATA_SAMPLES = MIN_NSAMPLES;
     // Data
     static constexpr size_t DDR_SIZE = 1ull << 32u;
     static constexpr float SEQUENCER_REPROGRAMMING_TIME = 35e-6f; // [s]
@@ -81,6 +86,10 @@ public:
     // 2^14 descriptors * 2^12 (4096, minimum page size) bytes
     static constexpr size_t MAX_TRANSFER_SIZE = 1ull << (14+12); // bytes
     static constexpr unsigned MAX_IRQ_NR = IUs4OEM::MAX_IRQ_NR;
+    // Sequencer
+    static constexpr uint16 MAX_N_FIRINGS = 1024;
+    static constexpr uint32 MAX_N_TRIGGERS = 16384;
+    static constexpr uint16 MAX_N_RX_MAPPINGS = 128;
 
     /**
      * Us4OEMImpl constructor.
@@ -105,12 +114,14 @@ public:
 
     void syncTrigger() override;
 
-    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle>
-    setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples, uint16 rxBufferSize,
-                    uint16 rxBatchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
-                    const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc = std::nullopt,
-                    const std::vector<arrus::framework::NdArray> &txDelays = std::vector<arrus::framework::NdArray>()
-                    ) override;
+    Us4OEMSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<arrus::framework::NdArray> &txDelays) override;
+
+    void programTxRxSequence(const Us4OEMSequence &seq) override;
 
     float getSamplingFrequency() override;
 
@@ -129,6 +140,12 @@ public:
     void enableSequencer(uint16_t startEntry) override;
 
     std::vector<uint8_t> getChannelMapping() override;
+
+    Us4OEMSettings::ReprogrammingMode getReprogrammingMode() const override { return reprogrammingMode; }
+
+    float getSequenceDuration() const override { return sequenceDuration; }
+
+    std::unordered_set<uint8_t> getChannelsMask() override;
     void setRxSettings(const RxSettings &newSettings) override;
     float getFPGATemperature() override;
     float getUCDTemperature() override;
@@ -175,24 +192,103 @@ public:
 
     void setMaximumPulseLength(std::optional<float> maxLength) override;
 
+    void setRxNopsMetadataOnly(bool value) override { this->rxNopsMetadataOnly = value; }
+
     void sync(std::optional<long long> timeout) override;
     void setWaitForHVPSMeasurementDone() override;
     void waitForHVPSMeasurementDone(std::optional<long long> timeout) override;
 
- private:
-    using Us4OEMBitMask = std::bitset<Us4OEMImpl::N_ADDR_CHANNELS>;
+    /**
+     * Returns the RX time [s] required to acquire the given number of samples.
+     */
+    static float getRxTime(size_t nSamples, float samplingFrequency);
 
-    std::tuple<std::unordered_map<uint16, uint16>, std::vector<Us4OEMImpl::Us4OEMBitMask>, FrameChannelMapping::Handle>
-    setRxMappings(const std::vector<TxRxParameters> &seq);
+    /**
+     * Returns the total TX/RX time [s] (i.e. the minimum PRI) for the given rx time and sequencer reprogramming mode.
+     */
+    static float getTxRxTime(float rxTime, Us4OEMSettings::ReprogrammingMode reprogrammingMode);
 
-    static float getRxTime(size_t nSamples, float samplingFrequency);
+    /**
+     * Returns the minimum PRI [s] for the tx/rx with the given rx end sample and sampling frequency,
+     * rounded up to the trigger time resolution (1 us).
+     */
+    static float getMinimumPri(size_t endSample, float samplingFrequency,
+                               Us4OEMSettings::ReprogrammingMode reprogrammingMode);
+
+    /**
+     * Computes RX channel mappings for the given sequence.
+     *
+     * @param channelMapping us4OEM channel mapping (logical channel -> physical channel)
+     * @param isRxNopFullFrame whether the RX NOPs are acquired as complete frames (affects the frame numbers)
+     */
+    static Us4OEMRxMappings getRxMappings(const std::vector<TxRxParameters> &seq,
+                                          const std::vector<uint8_t> &channelMapping,
+                                          const std::unordered_set<uint8_t> &channelsMask,
+                                          FrameChannelMapping::Us4OEMNumber us4oem, bool isRxNopFullFrame);
+
+    /**
+     * Computes the us4OEM buffer layout for the given sequence.
+     *
+     * @param rxNopsMetadataOnly see setRxNopsMetadataOnly; relevant only when acceptRxNops is true
+     */
+    static Us4OEMBufferLayout getBufferLayout(const std::vector<TxRxParameters> &seq, uint16 rxBufferSize,
+                                              uint16 batchSize, bool isDDCOn, bool acceptRxNops,
+                                              bool rxNopsMetadataOnly);
+
+    /**
+     * Returns the us4OEM hardware limits violated by the given sequence (empty if none).
+     * The sequence should already be validated by Us4OEMTxRxValidator.
+     */
+    static std::vector<std::string>
+    getSequenceViolations(const std::string &deviceId, const std::vector<TxRxParameters> &seq, uint16 rxBufferSize,
+                          uint16 batchSize, const std::optional<ops::us4r::DigitalDownConversion> &ddc,
+                          Us4OEMSettings::ReprogrammingMode reprogrammingMode, const Us4OEMRxMappings &rxMappings,
+                          const Us4OEMBufferLayout &layout);
+
+    /**
+     * Returns the duration [s] of the [start, end] sub-sequence (both inclusive) of the given sequence, i.e.
+     * the sum of PRIs, extended to SRI if set.
+     */
+    static float getSubsequenceDuration(const std::vector<TxRxParameters> &seq, uint16 start, uint16 end,
+                                        const std::optional<float> &sri) {
+        auto first = std::begin(seq) + start;
+        auto last = std::begin(seq) + end + 1;
+        return std::accumulate(first, last, 0.0f, [](float a, const auto &op) { return a + op.getPri(); })
+            + getLastPriExtend(first, last, sri).value_or(0.0f);
+    }
+
+    /**
+     * Returns the value that should be added to the last PRI of the sequence, so that the sequence
+     * repetition interval is equal to sri. Returns nullopt if sri is not set.
+     */
+    static std::optional<float> getLastPriExtend(const std::vector<TxRxParameters>::const_iterator &start,
+                                                 const std::vector<TxRxParameters>::const_iterator &end,
+                                                 std::optional<float> sri) {
+        float totalPri = std::accumulate(start, end, 0.0f, [](const auto &a, const auto &b) {return a + b.getPri();});
+        std::optional<float> lastPriExtend = std::nullopt;
+        // Sequence repetition interval.
+        if (sri.has_value()) {
+            if (totalPri < sri.value()) {
+                lastPriExtend = sri.value() - totalPri;
+            } else {
+                throw IllegalArgumentException(format("Sequence repetition interval {} cannot be set, "
+                                                      "sequence total pri is equal {}",
+                                                      sri.value(), totalPri));
+            }
+        }
+        return lastPriExtend;
+    }
+
+ private:
+    /**
+     * Returns true if RX NOPs are acquired as complete frames, numbered in the same way as the other frames.
+     */
+    bool isRxNopFullFrame() const { return acceptRxNops && !rxNopsMetadataOnly; }
 
     std::bitset<N_ADDR_CHANNELS> filterAperture(std::bitset<N_ADDR_CHANNELS> aperture);
 
     void validateAperture(const std::bitset<N_ADDR_CHANNELS> &aperture);
 
-    float getTxRxTime(float rxTime) const;
-
     /**
      * Returns the sample number that corresponds to the time of Tx.
      */
@@ -226,24 +322,6 @@ public:
         return static_cast<uint32_t>(std::round(pri * 1e6));
     }
 
-    std::optional<float> getLastPriExtend(const std::vector<TxRxParameters>::const_iterator &start,
-                                          const std::vector<TxRxParameters>::const_iterator &end,
-                                          std::optional<float> sri) {
-        float totalPri = std::accumulate(start, end, 0.0f, [](const auto &a, const auto &b) {return a + b.getPri();});
-        std::optional<float> lastPriExtend = std::nullopt;
-        // Sequence repetition interval.
-        if (sri.has_value()) {
-            if (totalPri < sri.value()) {
-                lastPriExtend = sri.value() - totalPri;
-            } else {
-                throw IllegalArgumentException(format("Sequence repetition interval {} cannot be set, "
-                                                      "sequence total pri is equal {}",
-                                                      sri.value(), totalPri));
-            }
-        }
-        return lastPriExtend;
-    }
-
     Logger::Handle logger;
     IUs4OEMHandle ius4oem;
     std::bitset<N_ACTIVE_CHANNEL_GROUPS> activeChannelGroups;
@@ -261,9 +339,12 @@ public:
     arrus::Cached<std::string> serialNumber;
     arrus::Cached<std::string> revision;
     bool acceptRxNops{false};
+    /** Whether the RX NOPs should acquire only the metadata samples (relevant only when acceptRxNops is true). */
+    bool rxNopsMetadataOnly{false};
     bool isDecimationFactorAdjustmentLogged{false};
     /** Currently uploaded sequence; empty when no sequence haven't been uploaded. */
     std::vector<TxRxParameters> currentSequence;
+    float sequenceDuration{0.0f};
     /** Conditional variable that is set when an IRQ with given number is detected. */
 
     std::vector<IRQEvent> irqEvents = std::vector<IRQEvent>(IUs4OEM::MAX_IRQ_NR+1);
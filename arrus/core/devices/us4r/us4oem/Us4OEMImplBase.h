@@ -1,14 +1,17 @@
 #ifndef ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMIMPLBASE_H
 #define ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMIMPLBASE_H
 
+#include <unordered_set>
 #include <vector>
 #include "arrus/core/devices/us4r/external/ius4oem/IUs4OEMFactory.h"
 #include "arrus/core/api/devices/us4r/RxSettings.h"
 #include "arrus/core/api/devices/us4r/FrameChannelMapping.h"
 #include "arrus/core/api/devices/us4r/Us4OEM.h"
+#include "arrus/core/api/devices/us4r/Us4OEMSettings.h"
 #include "arrus/core/devices/TxRxParameters.h"
 #include "arrus/core/api/ops/us4r/tgc.h"
 #include "arrus/core/devices/UltrasoundDevice.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMSequence.h"
 
 namespace arrus::devices {
 
@@ -31,11 +34,36 @@ public:
 
     virtual bool isMaster() = 0;
 
-    virtual std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle>
+    /**
+     * Validates the given TX/RX sequence and computes everything that is needed to program it (RX channel
+     * mappings, buffer layout, FCM). Does not change the state of the device.
+     *
+     * @throws IllegalArgumentException when the sequence violates the us4OEM limits
+     */
+    virtual Us4OEMSequence
+    compileTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples,
+                        uint16 rxBufferSize, uint16 rxBatchSize, std::optional<float> sri,
+                        arrus::ops::us4r::Scheme::WorkMode workMode,
+                        const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
+                        const std::vector<arrus::framework::NdArray> &txDelays) = 0;
+
+    /**
+     * Writes the given compiled sequence to the device.
+     */
+    virtual void programTxRxSequence(const Us4OEMSequence &seq) = 0;
+
+    /**
+     * Compiles and programs the given TX/RX sequence.
+     */
+    std::tuple<Us4OEMBuffer, FrameChannelMapping::Handle>
     setTxRxSequence(const std::vector<TxRxParameters> &seq, const ops::us4r::TGCCurve &tgcSamples, uint16 rxBufferSize,
                     uint16 rxBatchSize, std::optional<float> sri, arrus::ops::us4r::Scheme::WorkMode workMode,
-                    const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc,
-                    const std::vector<arrus::framework::NdArray> &txDelays) = 0;
+                    const std::optional<::arrus::ops::us4r::DigitalDownConversion> &ddc = std::nullopt,
+                    const std::vector<arrus::framework::NdArray> &txDelays = std::vector<arrus::framework::NdArray>()) {
+        auto compiled = compileTxRxSequence(seq, tgcSamples, rxBufferSize, rxBatchSize, sri, workMode, ddc, txDelays);
+        programTxRxSequence(compiled);
+        return {std::move(compiled.layout.buffer), std::move(compiled.rxMappings.fcm)};
+    }
 
     // TODO expose "registerUs4OEMOutputBuffer" function, keep this class hermetic
     virtual Ius4OEMRawHandle getIUs4oem() = 0;
@@ -44,6 +72,19 @@ public:
 
     virtual std::vector<uint8_t> getChannelMapping() = 0;
 
+    /**
+     * Returns the set of us4OEM channels (logical numbers) that are turned off.
+     */
+    virtual std::unordered_set<uint8_t> getChannelsMask() = 0;
+
+    virtual Us4OEMSettings::ReprogrammingMode getReprogrammingMode() const = 0;
+
+    /**
+     * Returns the duration [s] of a single execution of the current tx/rx sequence (or sub-sequence),
+     * i.e. the sum of PRIs, extended to SRI if necessary.
+     */
+    virtual float getSequenceDuration() const = 0;
+
     virtual void setRxSettings(const RxSettings& settings) = 0;
 
     virtual void setTestPattern(RxTestPattern pattern) = 0;
@@ -64,6 +105,12 @@ public:
      */
     virtual void setMaximumPulseLength(std::optional<float> maxLength) = 0;
 
+    /**
+     * Enables/disables metadata-only acquisitions for RX NOPs (see Us4R::setRxNopsMetadataOnly).
+     * This setting is relevant only for us4OEMs that acquire RX NOPs (i.e. the frame metadata us4OEM).
+     */
+    virtual void setRxNopsMetadataOnly(bool value) = 0;
+
 
     virtual void sync(std::optional<long long> timeout) = 0;
 
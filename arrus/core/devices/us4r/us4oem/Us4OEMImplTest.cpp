@@ -9,6 +9,7 @@
 #include "arrus/core/common/logging.h"
 #include "arrus/core/api/ops/us4r/tgc.h"
 #include "arrus/core/devices/us4r/FrameChannelMappingImpl.h"
+#include "arrus/core/devices/us4r/Us4OEMDataTransferRegistrar.h"
 
 namespace {
 using namespace arrus;
@@ -19,6 +20,11 @@ using ::testing::Ge;
 using ::testing::FloatEq;
 using ::testing::FloatNear;
 using ::testing::Pointwise;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Not;
 
 MATCHER_P(FloatNearPointwise, tol, "") {
     return std::abs(std::get<0>(arg) - std::get<1>(arg)) < tol;
@@ -271,7 +277,191 @@ TEST_F(Us4OEMImplEsaote3LikeTest, PreventsInvalidFrequency) {
     };
     EXPECT_THROW(SET_TX_RX_SEQUENCE(us4oem, seq), IllegalArgumentException);
 }
-// TODO test memory overflow protection
+// ------------------------------------------ Testing hardware limits
+
+// Returns the us4OEM limits violated by the given sequence (as determined in Us4OEMImpl::setTxRxSequence).
+std::vector<std::string> getSequenceViolations(const std::vector<TxRxParameters> &seq, uint16 rxBufferSize,
+                                               uint16 batchSize) {
+    auto rxMappings = Us4OEMImpl::getRxMappings(seq, getRange<uint8>(0, 128), {}, 0, false);
+    auto layout = Us4OEMImpl::getBufferLayout(seq, rxBufferSize, batchSize, false, false, false);
+    return Us4OEMImpl::getSequenceViolations("Us4OEM:0", seq, rxBufferSize, batchSize, std::nullopt,
+                                             Us4OEMSettings::ReprogrammingMode::SEQUENTIAL, rxMappings, layout);
+}
+
+TEST_F(Us4OEMImplEsaote3LikeTest, ReportsExceededNumberOfFirings) {
+    auto op = ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 64})).getTxRxParameters();
+    std::vector<TxRxParameters> seq(Us4OEMImpl::MAX_N_FIRINGS, op);
+    EXPECT_THAT(getSequenceViolations(seq, 1, 1), IsEmpty());
+    seq.push_back(op);
+    EXPECT_THAT(getSequenceViolations(seq, 1, 1), ElementsAre(HasSubstr("number of firings: 1025")));
+}
+
+TEST_F(Us4OEMImplEsaote3LikeTest, ReportsExceededNumberOfTriggers) {
+    // 16 TX/RXs * 32 sequences * 32 elements = 16384 triggers.
+    std::vector<TxRxParameters> seq(
+        16, ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 64})).getTxRxParameters());
+    EXPECT_THAT(getSequenceViolations(seq, 32, 32), IsEmpty());
+    EXPECT_THAT(getSequenceViolations(seq, 33, 32), ElementsAre(HasSubstr("number of triggers: 16896")));
+    EXPECT_THAT(getSequenceViolations(seq, 32, 33), ElementsAre(HasSubstr("number of triggers: 16896")));
+}
+
+TEST_F(Us4OEMImplEsaote3LikeTest, ReportsExceededNumberOfRxMappings) {
+    // Each pair of RX channels requires a separate RX mapping.
+    std::vector<TxRxParameters> seq;
+    for (ChannelIdx first = 0; first < Us4OEMImpl::N_RX_CHANNELS; ++first) {
+        for (ChannelIdx second = first + 1; second < Us4OEMImpl::N_RX_CHANNELS; ++second) {
+            BitMask rxAperture(Us4OEMImpl::N_ADDR_CHANNELS, false);
+            rxAperture[first] = true;
+            rxAperture[second] = true;
+            seq.push_back(ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.rxAperture = rxAperture, x.sampleRange = {0, 64}))
+                              .getTxRxParameters());
+        }
+    }
+    std::vector<TxRxParameters> maxSeq(std::begin(seq), std::begin(seq) + Us4OEMImpl::MAX_N_RX_MAPPINGS);
+    EXPECT_THAT(getSequenceViolations(maxSeq, 1, 1), IsEmpty());
+    EXPECT_THAT(getSequenceViolations(seq, 1, 1), ElementsAre(HasSubstr("number of rx mappings: 496")));
+}
+
+TEST_F(Us4OEMImplEsaote3LikeTest, ReportsExceededDdrMemory) {
+    // A single frame: 16384 samples * 32 channels * 2 B = 1 MiB; 64 * 64 frames = 4 GiB.
+    std::vector<TxRxParameters> seq = {
+        ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 16384}, x.pri = 1e-3f)).getTxRxParameters()
+    };
+    EXPECT_THAT(getSequenceViolations(seq, 64, 64), IsEmpty());
+    EXPECT_THAT(getSequenceViolations(seq, 65, 64), ElementsAre(HasSubstr("exceeds DDR memory size")));
+}
+
+TEST_F(Us4OEMImplEsaote3LikeTest, ReportsAllExceededLimitsAtOnce) {
+    // Exceeds the number of firings, triggers and, for the first TX/RX, PRI.
+    std::vector<TxRxParameters> seq(
+        Us4OEMImpl::MAX_N_FIRINGS + 1,
+        ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 64})).getTxRxParameters());
+    seq[0] = ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 16384})).getTxRxParameters();
+    defaultRxBufferSize = 16;
+    // Nothing should be programmed.
+    EXPECT_CALL(*ius4oemPtr, SetNumberOfFirings(_)).Times(0);
+    try {
+        SET_TX_RX_SEQUENCE(us4oem, seq);
+        FAIL() << "Expected IllegalArgumentException";
+    } catch (const IllegalArgumentException &e) {
+        EXPECT_THAT(e.what(), AllOf(HasSubstr("number of firings: 1025"), HasSubstr("number of triggers: 16400"),
+                                    HasSubstr("TX/RX 0"), Not(HasSubstr("TX/RX 1 "))));
+    }
+}
+
+TEST_F(Us4OEMImplEsaote3LikeTest, ExceededNumberOfTransfersIsReportedByTransferRegistrar) {
+    // The number of transfers depends on the host buffer and the transfer coalescing, so it is checked when
+    // the transfers are registered, not together with the sequence limits.
+    std::vector<TxRxParameters> seq = {
+        ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 64})).getTxRxParameters()
+    };
+    auto rxBufferSize = static_cast<uint16>(Us4OEMDataTransferRegistrar::MAX_N_TRANSFERS + 1);
+    EXPECT_THAT(getSequenceViolations(seq, rxBufferSize, 1), IsEmpty());
+    auto layout = Us4OEMImpl::getBufferLayout(seq, rxBufferSize, 1, false, false, false);
+    const auto &element = layout.buffer.getElement(0);
+    Us4ROutputBuffer hostBuffer({element.getViewSize()}, element.getViewShape(), element.getDataType(), rxBufferSize,
+                                false);
+    EXPECT_THROW(Us4OEMDataTransferRegistrar(&hostBuffer, layout.buffer, us4oem.get()), IllegalArgumentException);
+    // All the (contiguous) elements coalesced into a single group are moved by a single transfer.
+    Us4OEMDataTransferRegistrar registrar(&hostBuffer, layout.buffer, us4oem.get(), rxBufferSize);
+    EXPECT_EQ(registrar.getNumberOfTransfers(), 1);
+}
+
+// ------------------------------------------ Testing buffer layout (metadata-only RX NOPs)
+
+// firing, op, address, number of samples
+using ExpectedAcquisition = std::tuple<uint16, uint16, size_t, size_t>;
+
+void expectAcquisitions(const Us4OEMBufferLayout &layout, const std::vector<ExpectedAcquisition> &expected) {
+    ASSERT_EQ(layout.acquisitions.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const auto &acq = layout.acquisitions[i];
+        EXPECT_EQ(std::make_tuple(acq.firing, acq.op, acq.address, acq.nSamples), expected[i]) << "acquisition " << i;
+    }
+}
+
+class Us4OEMImplRxNopMetadataLayoutTest : public ::testing::Test {
+protected:
+    // 128 samples * 32 channels * 2 B
+    static constexpr size_t FRAME_SIZE = 8192;
+    // 64 samples * 32 channels * 2 B
+    static constexpr size_t METADATA_SIZE = 4096;
+
+    TxRxParameters data = ARRUS_STRUCT_INIT_LIST(TestTxRxParams, (x.sampleRange = {0, 128})).getTxRxParameters();
+    TxRxParameters rxNop = ARRUS_STRUCT_INIT_LIST(
+        TestTxRxParams,
+        (x.rxAperture = getNTimes(false, Us4OEMImpl::N_ADDR_CHANNELS), x.sampleRange = {0, 128})
+    ).getTxRxParameters();
+
+    static Us4OEMBufferLayout getLayout(const std::vector<TxRxParameters> &seq, uint16 rxBufferSize,
+                                        uint16 batchSize) {
+        return Us4OEMImpl::getBufferLayout(seq, rxBufferSize, batchSize, false, true, true);
+    }
+};
+
+TEST_F(Us4OEMImplRxNopMetadataLayoutTest, PlacesRxNopMetadataAfterDataFrames) {
+    auto layout = getLayout({data, rxNop, data}, 2, 1);
+    // Element: 2 data frames, RX NOP metadata, padding to 3 frames.
+    size_t elementSize = 3 * FRAME_SIZE;
+    expectAcquisitions(layout, {
+        {0, 0, 0, 128}, {1, 1, 2 * FRAME_SIZE, 64}, {2, 2, FRAME_SIZE, 128},
+        {3, 0, elementSize, 128}, {4, 1, elementSize + 2 * FRAME_SIZE, 64}, {5, 2, elementSize + FRAME_SIZE, 128},
+    });
+    const auto &parts = layout.buffer.getElementParts();
+    ASSERT_EQ(parts.size(), 3);
+    EXPECT_EQ(parts[0].getAddress(), 0);
+    EXPECT_EQ(parts[0].getSize(), FRAME_SIZE);
+    EXPECT_EQ(parts[1].getAddress(), 2 * FRAME_SIZE);
+    EXPECT_EQ(parts[1].getSize(), METADATA_SIZE);
+    EXPECT_EQ(parts[1].getNSamples(), Us4OEMImpl::N_METADATA_SAMPLES);
+    EXPECT_EQ(parts[2].getAddress(), FRAME_SIZE);
+    EXPECT_EQ(parts[2].getSize(), FRAME_SIZE);
+
+    ASSERT_EQ(layout.buffer.getNumberOfElements(), 2);
+    for (size_t i = 0; i < 2; ++i) {
+        const auto &element = layout.buffer.getElement(i);
+        EXPECT_EQ(element.getAddress(), i * elementSize);
+        EXPECT_EQ(element.getViewSize(), elementSize);
+        EXPECT_EQ(element.getViewShape().get(0), 3 * 128);
+    }
+    EXPECT_EQ(layout.nMetadataFrames, 1);
+    EXPECT_EQ(layout.ddrUsage, 2 * elementSize);
+}
+
+TEST_F(Us4OEMImplRxNopMetadataLayoutTest, PlacesRxNopMetadataAfterAllDataFramesOfBatch) {
+    auto layout = getLayout({data, rxNop, data}, 1, 2);
+    // 4 data frames, then the metadata of both sequences (exactly a single frame, no padding).
+    expectAcquisitions(layout, {
+        {0, 0, 0, 128}, {1, 1, 4 * FRAME_SIZE, 64}, {2, 2, FRAME_SIZE, 128},
+        {3, 0, 2 * FRAME_SIZE, 128}, {4, 1, 4 * FRAME_SIZE + METADATA_SIZE, 64}, {5, 2, 3 * FRAME_SIZE, 128},
+    });
+    EXPECT_EQ(layout.buffer.getElement(0).getViewSize(), 5 * FRAME_SIZE);
+    EXPECT_EQ(layout.nMetadataFrames, 1);
+    EXPECT_EQ(layout.ddrUsage, 5 * FRAME_SIZE);
+}
+
+TEST_F(Us4OEMImplRxNopMetadataLayoutTest, StoresOnlyMetadataForRxNopOnlySequence) {
+    auto layout = getLayout({rxNop, rxNop, rxNop}, 2, 1);
+    // Element: 3 RX NOP metadata, padded to 2 frames.
+    size_t elementSize = 2 * FRAME_SIZE;
+    expectAcquisitions(layout, {
+        {0, 0, 0, 64}, {1, 1, METADATA_SIZE, 64}, {2, 2, 2 * METADATA_SIZE, 64},
+        {3, 0, elementSize, 64}, {4, 1, elementSize + METADATA_SIZE, 64}, {5, 2, elementSize + 2 * METADATA_SIZE, 64},
+    });
+    for (const auto &part : layout.buffer.getElementParts()) {
+        EXPECT_EQ(part.getSize(), METADATA_SIZE);
+    }
+    ASSERT_EQ(layout.buffer.getNumberOfElements(), 2);
+    for (size_t i = 0; i < 2; ++i) {
+        const auto &element = layout.buffer.getElement(i);
+        EXPECT_EQ(element.getAddress(), i * elementSize);
+        EXPECT_EQ(element.getViewSize(), elementSize);
+        EXPECT_EQ(element.getViewShape().get(0), 2 * 128);
+    }
+    EXPECT_EQ(layout.nMetadataFrames, 2);
+    EXPECT_EQ(layout.ddrUsage, 2 * elementSize);
+}
+
 // ------------------------------------------ Testing parameters set to IUs4OEM
 
 TEST_F(Us4OEMImplEsaote3LikeTest, SetsCorrectRxMapping032) {
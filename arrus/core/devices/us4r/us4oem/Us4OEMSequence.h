@@ -0,0 +1,81 @@
+#ifndef ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMSEQUENCE_H
+#define ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMSEQUENCE_H
+
+#include <optional>
+#include <vector>
+
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/devices/us4r/FrameChannelMapping.h"
+#include "arrus/core/api/framework/NdArray.h"
+#include "arrus/core/api/ops/us4r/DigitalDownConversion.h"
+#include "arrus/core/api/ops/us4r/Scheme.h"
+#include "arrus/core/api/ops/us4r/tgc.h"
+#include "arrus/core/devices/TxRxParameters.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMBuffer.h"
+
+namespace arrus::devices {
+
+/**
+ * RX channel mappings of a TX/RX sequence.
+ */
+struct Us4OEMRxMappings {
+    /** Distinct RX channel mappings; the i-th mapping should be loaded as the RX mapping i. */
+    std::vector<std::vector<uint8>> mappings;
+    /** TX/RX ordinal number -> RX mapping number. */
+    std::vector<uint16> mappingIds;
+    /** RX apertures (us4OEM logical channels), with the conflicting and masked channels turned off. */
+    std::vector<BitMask> rxApertures;
+    FrameChannelMapping::Handle fcm;
+};
+
+/**
+ * A single data acquisition (ScheduleReceive) of the us4OEM sequencer.
+ */
+struct Us4OEMAcquisition {
+    uint16 firing;
+    /** TX/RX ordinal number. */
+    uint16 op;
+    /** us4OEM DDR memory address. */
+    size_t address;
+    size_t nSamples;
+};
+
+/**
+ * Placement of the data acquired by a TX/RX sequence in us4OEM DDR memory.
+ */
+struct Us4OEMBufferLayout {
+    /** In the firing order. */
+    std::vector<Us4OEMAcquisition> acquisitions;
+    Us4OEMBuffer buffer;
+    /** Number of bytes of DDR memory used. */
+    size_t ddrUsage;
+    /**
+     * Number of frames each element stores after the data frames (metadata-only RX NOPs, padded to the whole
+     * number of frames); 0 if the RX NOPs are not stored in the metadata-only mode.
+     */
+    size_t nMetadataFrames{0};
+};
+
+/**
+ * A TX/RX sequence compiled for a single us4OEM (see Us4OEMImplBase::compileTxRxSequence): the input parameters
+ * and everything that was computed from them on the host. Programming the sequence only writes the registers.
+ */
+struct Us4OEMSequence {
+    std::vector<TxRxParameters> txrxs;
+    ops::us4r::TGCCurve tgc;
+    uint16 rxBufferSize;
+    uint16 batchSize;
+    ops::us4r::Scheme::WorkMode workMode;
+    std::optional<ops::us4r::DigitalDownConversion> ddc;
+    std::vector<framework::NdArray> txDelays;
+    /** The value that should be added to the last PRI, so the sequence repetition interval is equal to SRI. */
+    std::optional<float> lastPriExtend;
+    /** The duration [s] of a single sequence, i.e. the sum of PRIs, extended to SRI if necessary. */
+    float duration;
+    Us4OEMRxMappings rxMappings;
+    Us4OEMBufferLayout layout;
+};
+
+}// namespace arrus::devices
+
+#endif//ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMSEQUENCE_H
@@ -0,0 +1,80 @@
+#ifndef ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMTXRXVALIDATOR_H
+#define ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMTXRXVALIDATOR_H
+
+#include <cmath>
+#include <numeric>
+#include <optional>
+
+#include "arrus/core/common/validation.h"
+#include "arrus/core/devices/TxRxParameters.h"
+#include "arrus/core/devices/us4r/us4oem/Us4OEMImpl.h"
+
+namespace arrus::devices {
+
+class Us4OEMTxRxValidator : public Validator<TxRxParamsSequence> {
+public:
+    Us4OEMTxRxValidator(const std::string &componentName, float txFrequencyMin, float txFrequencyMax, std::optional<float> maxPulseLength=std::nullopt)
+        : Validator(componentName), txFrequencyMin(txFrequencyMin), txFrequencyMax(txFrequencyMax), maxPulseLength(maxPulseLength) {}
+
+    void validate(const TxRxParamsSequence &txRxs) {
+        // Validation according to us4oem technote
+        const auto decimationFactor = txRxs[0].getRxDecimationFactor();
+        const auto startSample = txRxs[0].getRxSampleRange().start();
+        for (size_t firing = 0; firing < txRxs.size(); ++firing) {
+            const auto &op = txRxs[firing];
+            if (!op.isNOP()) {
+                auto firingStr = ::arrus::format(" (firing {})", firing);
+
+                // Tx
+                ARRUS_VALIDATOR_EXPECT_EQUAL_M(op.getTxAperture().size(), size_t(Us4OEMImpl::N_TX_CHANNELS), firingStr);
+                ARRUS_VALIDATOR_EXPECT_EQUAL_M(op.getTxDelays().size(), size_t(Us4OEMImpl::N_TX_CHANNELS), firingStr);
+                ARRUS_VALIDATOR_EXPECT_ALL_IN_RANGE_VM(op.getTxDelays(), Us4OEMImpl::MIN_TX_DELAY,
+                                                       Us4OEMImpl::MAX_TX_DELAY, firingStr);
+
+                // Tx - pulse
+                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getTxPulse().getCenterFrequency(), txFrequencyMin, txFrequencyMax,
+                                                  firingStr);
+                if(maxPulseLength.has_value()) {
+                    float pulseLength = op.getTxPulse().getNPeriods()/op.getTxPulse().getCenterFrequency();
+                    ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(pulseLength, 0.0f, maxPulseLength.value(), firingStr);
+                }
+                else {
+                    // The legacy OEM constraint
+                    ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getTxPulse().getNPeriods(), 0.0f, 32.0f, firingStr);
+                }
+                float ignore = 0.0f;
+                float fractional = std::modf(op.getTxPulse().getNPeriods(), &ignore);
+                ARRUS_VALIDATOR_EXPECT_TRUE_M((fractional == 0.0f || fractional == 0.5f), (firingStr + ", n periods"));
+
+                // Rx
+                ARRUS_VALIDATOR_EXPECT_EQUAL_M(op.getRxAperture().size(), size_t(Us4OEMImpl::N_ADDR_CHANNELS),
+                                               firingStr);
+                size_t numberOfActiveRxChannels =
+                    std::accumulate(std::begin(op.getRxAperture()), std::end(op.getRxAperture()), 0);
+                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(numberOfActiveRxChannels, size_t(0), size_t(32), firingStr);
+                uint32 numberOfSamples = op.getNumberOfSamples();
+                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(
+                    // should be enough for condition rxTime < 4000 [us]
+                    numberOfSamples, Us4OEMImpl::MIN_NSAMPLES, Us4OEMImpl::MAX_NSAMPLES, firingStr);
+                ARRUS_VALIDATOR_EXPECT_DIVISIBLE_M(numberOfSamples, 64u, firingStr);
+                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getRxDecimationFactor(), 0, 10, firingStr);
+                ARRUS_VALIDATOR_EXPECT_IN_RANGE_M(op.getPri(), Us4OEMImpl::MIN_PRI, Us4OEMImpl::MAX_PRI, firingStr);
+                ARRUS_VALIDATOR_EXPECT_TRUE_M(op.getRxDecimationFactor() == decimationFactor,
+                                              "Decimation factor should be the same for all operations." + firingStr);
+                ARRUS_VALIDATOR_EXPECT_TRUE_M(op.getRxSampleRange().start() == startSample,
+                                              "Start sample should be the same for all operations." + firingStr);
+                ARRUS_VALIDATOR_EXPECT_TRUE_M((op.getRxPadding() == ::arrus::Tuple<ChannelIdx>{0, 0}),
+                                              ("Rx padding is not allowed for us4oems. " + firingStr));
+            }
+        }
+    }
+
+private:
+    float txFrequencyMin;
+    float txFrequencyMax;
+    std::optional<float> maxPulseLength;
+};
+
+}
+
+#endif //ARRUS_CORE_DEVICES_US4R_US4OEM_US4OEMTXRXVALIDATOR_H
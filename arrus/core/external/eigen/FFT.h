@@ -0,0 +1,11 @@
+#ifndef ARRUS_CORE_EXTERNAL_EIGEN_FFT_H
+#define ARRUS_CORE_EXTERNAL_EIGEN_FFT_H
+
+#include "arrus/common/compiler.h"
+
+COMPILER_PUSH_DIAGNOSTIC_STATE
+COMPILER_DISABLE_MSVC_WARNINGS(4554 4127)
+#include <unsupported/Eigen/FFT>
+COMPILER_POP_DIAGNOSTIC_STATE
+
+#endif //ARRUS_CORE_EXTERNAL_EIGEN_FFT_H
@@ -0,0 +1,106 @@
+#include "arrus/core/api/framework/FrameAligner.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+
+namespace arrus::framework {
+
+class FrameAligner::Impl {
+public:
+    Impl(size_t nSystems, size_t nElements, OnAlignedCallback onAligned)
+        : nSystems(nSystems), onAligned(std::move(onAligned)), positions(nElements) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nSystems > 0, "The number of systems should be positive.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nElements > 0, "The number of elements should be positive.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT((bool) this->onAligned, "The callback is required.");
+        for (auto &position : positions) {
+            position.elements.resize(nSystems);
+        }
+    }
+
+    bool push(size_t system, const BufferElement::SharedHandle &element) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(system < nSystems, format("System number {} is out of range [0, {}).",
+                                                                   system, nSystems));
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT((bool) element, "Buffer element cannot be null.");
+        std::vector<BufferElement::SharedHandle> aligned, stale;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            Position &position = positions.at(element->getPosition() % positions.size());
+            if (position.elements[system]) {
+                stale = position.drop(nSystems);
+            }
+            position.elements[system] = element;
+            if (++position.nPushed == nSystems) {
+                aligned = position.drop(nSystems);
+            }
+        }
+        // NOTE: releasing an element may trigger the next acquisition, so it is done without the lock.
+        release(stale);
+        if (!aligned.empty()) {
+            onAligned(aligned);
+        }
+        return stale.empty();
+    }
+
+    void reset() {
+        std::vector<BufferElement::SharedHandle> dropped;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            for (auto &position : positions) {
+                auto elements = position.drop(nSystems);
+                dropped.insert(std::end(dropped), std::begin(elements), std::end(elements));
+            }
+        }
+        release(dropped);
+    }
+
+    size_t getNumberOfPendingPositions() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        size_t result = 0;
+        for (auto &position : positions) {
+            result += position.nPushed > 0;
+        }
+        return result;
+    }
+
+private:
+    struct Position {
+        std::vector<BufferElement::SharedHandle> elements;
+        size_t nPushed{0};
+
+        /** Clears this position, returns the elements it contained. */
+        std::vector<BufferElement::SharedHandle> drop(size_t nSystems) {
+            std::vector<BufferElement::SharedHandle> result(nSystems);
+            result.swap(elements);
+            nPushed = 0;
+            result.erase(std::remove(std::begin(result), std::end(result), nullptr), std::end(result));
+            return result;
+        }
+    };
+
+    static void release(const std::vector<BufferElement::SharedHandle> &elements) {
+        for (auto &element : elements) {
+            element->release();
+        }
+    }
+
+    size_t nSystems;
+    OnAlignedCallback onAligned;
+    mutable std::mutex mutex;
+    std::vector<Position> positions;
+};
+
+FrameAligner::FrameAligner(size_t nSystems, size_t nElements, OnAlignedCallback onAligned)
+    : impl(std::make_shared<Impl>(nSystems, nElements, std::move(onAligned))) {}
+
+bool FrameAligner::push(size_t system, const BufferElement::SharedHandle &element) {
+    return impl->push(system, element);
+}
+
+void FrameAligner::reset() { impl->reset(); }
+
+size_t FrameAligner::getNumberOfPendingPositions() const { return impl->getNumberOfPendingPositions(); }
+
+}// namespace arrus::framework
@@ -0,0 +1,313 @@
+#include "arrus/core/framework/MergedDataBuffer.h"
+
+#include <cstring>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/common/logging.h"
+
+namespace arrus::framework {
+
+// MergedBufferElementImpl
+MergedBufferElementImpl::MergedBufferElementImpl(size_t position, const std::vector<NdArray> &parts,
+                                                 bool concatenate)
+    : position(position), concatenate(concatenate), size(0) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!parts.empty(), "At least one part is required.");
+    std::vector<NdArray::Shape> shapes;
+    for (auto &part : parts) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(part.getDataType() == parts[0].getDataType(),
+                                         "All the merged buffers should have the same data type.");
+        shapes.push_back(part.getShape());
+        size += part.getNumberOfBytes();
+    }
+    if (concatenate) {
+        data = NdArray{getMergedShape(shapes), parts[0].getDataType(),
+                       devices::DeviceId(devices::DeviceType::CPU, 0), format("MergedBufferElement:{}", position)};
+    }
+}
+
+void MergedBufferElementImpl::setParts(std::vector<BufferElement::SharedHandle> newParts) {
+    std::lock_guard<std::mutex> lock{mutex};
+    std::vector<NdArray::Shape> shapes;
+    size_t nBytes = 0;
+    for (auto &part : newParts) {
+        shapes.push_back(part->getData().getShape());
+        nBytes += part->getData().getNumberOfBytes();
+    }
+    size = nBytes;
+    if (!concatenate) {
+        parts = std::move(newParts);
+        return;
+    }
+    auto shape = getMergedShape(shapes);
+    if (nBytes != data.getNumberOfBytes() || shape != data.getShape()) {
+        // The shape of the parts has changed (e.g. sliced sequence).
+        data = NdArray{shape, data.getDataType(), data.getPlacement(), format("MergedBufferElement:{}", position)};
+    }
+    auto *destination = data.get<char>();
+    for (auto &part : newParts) {
+        NdArray &source = part->getData();
+        const size_t size = source.getNumberOfBytes();
+        if (source.isContiguous()) {
+            std::memcpy(destination, source.get<char>(), size);
+        } else {
+            std::memcpy(destination, source.copy().get<char>(), size);
+        }
+        destination += size;
+    }
+    parts = std::move(newParts);
+}
+
+void MergedBufferElementImpl::release() {
+    std::vector<BufferElement::SharedHandle> released;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        released.swap(parts);
+    }
+    for (auto &part : released) {
+        part->release();
+    }
+}
+
+NdArray &MergedBufferElementImpl::getData() {
+    if (!concatenate) {
+        throw IllegalStateException("The data of the merged buffer element is not concatenated, use getPart(i) to "
+                                    "access the data of the i-th system.");
+    }
+    return data;
+}
+
+size_t MergedBufferElementImpl::getSize() {
+    std::lock_guard<std::mutex> lock{mutex};
+    return size;
+}
+
+BufferElement::State MergedBufferElementImpl::getState() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (parts.empty()) {
+        return State::FREE;
+    }
+    for (auto &part : parts) {
+        if (part->getState() == State::INVALID) {
+            return State::INVALID;
+        }
+    }
+    return State::READY;
+}
+
+size_t MergedBufferElementImpl::getNumberOfFrameMetadata() {
+    auto part = getPart(0);
+    return part ? part->getNumberOfFrameMetadata() : 0;
+}
+
+FrameMetadata MergedBufferElementImpl::getFrameMetadata(size_t frame) {
+    auto part = getPart(0);
+    if (!part) {
+        throw IllegalStateException("Frame metadata is not available: the element is not ready.");
+    }
+    return part->getFrameMetadata(frame);
+}
+
+size_t MergedBufferElementImpl::getNumberOfParts() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return parts.size();
+}
+
+BufferElement::SharedHandle MergedBufferElementImpl::getPart(size_t i) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return i < parts.size() ? parts[i] : nullptr;
+}
+
+NdArray::Shape MergedBufferElementImpl::getMergedShape(const std::vector<NdArray::Shape> &shapes) {
+    bool isConcatenable = !shapes.empty();
+    size_t nRows = 0, nValues = 0;
+    for (auto &shape : shapes) {
+        nValues += shape.product();
+        if (shape.size() == 0 || shape.size() != shapes[0].size()) {
+            isConcatenable = false;
+            continue;
+        }
+        nRows += shape[0];
+        for (size_t axis = 1; axis < shape.size(); ++axis) {
+            isConcatenable = isConcatenable && shape[axis] == shapes[0][axis];
+        }
+    }
+    if (!isConcatenable) {
+        return NdArray::Shape{nValues};
+    }
+    std::vector<size_t> result{nRows};
+    for (size_t axis = 1; axis < shapes[0].size(); ++axis) {
+        result.push_back(shapes[0][axis]);
+    }
+    return NdArray::Shape{result};
+}
+
+// MergedDataBuffer
+MergedDataBuffer::MergedDataBuffer(std::vector<DataBuffer::SharedHandle> buffers, bool concatenate)
+    : buffers(std::move(buffers)), aligner(std::max<size_t>(this->buffers.size(), 1),
+                                           this->buffers.empty() ? 1 : this->buffers[0]->getNumberOfElements(),
+                                           [this](const auto &parts) { onAligned(parts); }),
+      concatenate(concatenate), queue(std::make_shared<ConcatenationQueue>()) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!this->buffers.empty(), "At least one buffer to merge is required.");
+    const size_t nElements = this->buffers[0]->getNumberOfElements();
+    for (auto &buffer : this->buffers) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            buffer->getNumberOfElements() == nElements,
+            format("All the merged buffers should have the same number of elements (expected: {}, got: {}).",
+                   nElements, buffer->getNumberOfElements()));
+    }
+    for (size_t i = 0; i < nElements; ++i) {
+        std::vector<NdArray> parts;
+        for (auto &buffer : this->buffers) {
+            parts.push_back(buffer->getElement(i)->getData());
+        }
+        elements.push_back(std::make_shared<MergedBufferElementImpl>(i, parts, concatenate));
+    }
+}
+
+MergedDataBuffer::~MergedDataBuffer() {
+    std::deque<std::vector<BufferElement::SharedHandle>> pending;
+    {
+        std::lock_guard<std::mutex> lock{queue->mutex};
+        queue->isClosed = true;
+        pending.swap(queue->elements);
+    }
+    queue->changed.notify_all();
+    if (concatenationThread.joinable()) {
+        if (concatenationThread.get_id() == std::this_thread::get_id()) {
+            // The last reference was dropped by the user callback; the loop exits on the closed queue.
+            concatenationThread.detach();
+        } else {
+            concatenationThread.join();
+        }
+    }
+    // Do not block the systems waiting for the release of the not delivered elements.
+    for (auto &parts : pending) {
+        for (auto &part : parts) {
+            part->release();
+        }
+    }
+}
+
+void MergedDataBuffer::registerOnNewDataCallback(OnNewDataCallback &callback) {
+    onNewDataCallback = callback;
+    std::weak_ptr<MergedDataBuffer> self = weak_from_this();
+    if (concatenate && !concatenationThread.joinable()) {
+        concatenationThread = std::thread(&MergedDataBuffer::concatenationLoop, self, queue);
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        OnNewDataCallback partCallback = [self, i](const BufferElement::SharedHandle &element) {
+            auto buffer = self.lock();
+            if (!buffer) {
+                return;
+            }
+            if (!buffer->aligner.push(i, element)) {
+                getDefaultLogger()->log(
+                    LogSeverity::ERROR,
+                    format("Merged buffer: element {} of the buffer {} arrived before the other buffers "
+                           "delivered the previous one, the elements of that position were dropped.",
+                           element->getPosition(), i));
+                if (buffer->onOverflowCallback) {
+                    buffer->onOverflowCallback();
+                }
+            }
+        };
+        buffers[i]->registerOnNewDataCallback(partCallback);
+    }
+}
+
+void MergedDataBuffer::registerOnOverflowCallback(OnOverflowCallback &callback) {
+    onOverflowCallback = callback;
+    std::weak_ptr<MergedDataBuffer> self = weak_from_this();
+    OnOverflowCallback partCallback = [self]() {
+        auto buffer = self.lock();
+        if (buffer && buffer->onOverflowCallback) {
+            buffer->onOverflowCallback();
+        }
+    };
+    for (auto &buffer : buffers) {
+        buffer->registerOnOverflowCallback(partCallback);
+    }
+}
+
+void MergedDataBuffer::registerShutdownCallback(OnShutdownCallback &callback) {
+    onShutdownCallback = callback;
+    std::weak_ptr<MergedDataBuffer> self = weak_from_this();
+    OnShutdownCallback partCallback = [self]() {
+        auto buffer = self.lock();
+        if (buffer && buffer->onShutdownCallback && !buffer->isShutdownNotified.exchange(true)) {
+            buffer->onShutdownCallback();
+        }
+    };
+    for (auto &buffer : buffers) {
+        buffer->registerShutdownCallback(partCallback);
+    }
+}
+
+size_t MergedDataBuffer::getElementSize() const {
+    size_t result = 0;
+    for (auto &buffer : buffers) {
+        result += buffer->getElementSize();
+    }
+    return result;
+}
+
+size_t MergedDataBuffer::getNumberOfElementsInState(BufferElement::State state) const {
+    size_t result = 0;
+    for (auto &element : elements) {
+        result += element->getState() == state;
+    }
+    return result;
+}
+
+void MergedDataBuffer::onAligned(const std::vector<BufferElement::SharedHandle> &parts) {
+    isShutdownNotified = false;
+    if (!concatenate) {
+        deliver(parts);
+        return;
+    }
+    // Copy the data outside the data acquisition thread of the system.
+    {
+        std::lock_guard<std::mutex> lock{queue->mutex};
+        queue->elements.push_back(parts);
+    }
+    queue->changed.notify_one();
+}
+
+void MergedDataBuffer::deliver(const std::vector<BufferElement::SharedHandle> &parts) {
+    auto &element = elements.at(parts[0]->getPosition() % elements.size());
+    element->setParts(parts);
+    onNewDataCallback(element);
+}
+
+void MergedDataBuffer::concatenationLoop(std::weak_ptr<MergedDataBuffer> self,
+                                         std::shared_ptr<ConcatenationQueue> queue) {
+    while (true) {
+        std::vector<BufferElement::SharedHandle> parts;
+        {
+            std::unique_lock<std::mutex> lock{queue->mutex};
+            queue->changed.wait(lock, [&queue]() { return queue->isClosed || !queue->elements.empty(); });
+            if (queue->isClosed) {
+                return;
+            }
+            parts = std::move(queue->elements.front());
+            queue->elements.pop_front();
+        }
+        auto buffer = self.lock();
+        if (!buffer) {
+            for (auto &part : parts) {
+                part->release();
+            }
+            return;
+        }
+        try {
+            buffer->deliver(parts);
+        } catch (const std::exception &e) {
+            getDefaultLogger()->log(LogSeverity::ERROR, format("Merged buffer: error while delivering the "
+                                                               "element: {}", e.what()));
+        }
+        // NOTE: the buffer may be destroyed here (in this thread), if the callback dropped the last reference.
+    }
+}
+
+}// namespace arrus::framework
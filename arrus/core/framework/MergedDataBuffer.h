@@ -0,0 +1,153 @@
+#ifndef ARRUS_CORE_FRAMEWORK_MERGEDDATABUFFER_H
+#define ARRUS_CORE_FRAMEWORK_MERGEDDATABUFFER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "arrus/core/api/framework/DataBuffer.h"
+#include "arrus/core/api/framework/FrameAligner.h"
+#include "arrus/core/api/framework/MergedBufferElement.h"
+
+namespace arrus::framework {
+
+/**
+ * An element of the MergedDataBuffer.
+ *
+ * When the concatenation is enabled, the element data is a copy of the parts data, concatenated along the first
+ * axis (when all the parts have the same shape except the first axis) or flattened and concatenated.
+ * The parts are kept (i.e. not released) until this element is released, so the acquisition of each system is
+ * throttled the same way as for its own buffer.
+ */
+class MergedBufferElementImpl : public MergedBufferElement {
+public:
+    /**
+     * @param parts the data of the parts, determines the size (and shape) of this element
+     * @param concatenate whether the data of the parts should be copied into this element
+     */
+    MergedBufferElementImpl(size_t position, const std::vector<NdArray> &parts, bool concatenate);
+
+    /**
+     * Sets the parts of this element (and copies their data, if the concatenation is enabled); the element
+     * is READY then.
+     */
+    void setParts(std::vector<BufferElement::SharedHandle> parts);
+
+    /**
+     * Releases all the parts.
+     */
+    void release() override;
+
+    NdArray &getData() override;
+    size_t getSize() override;
+    size_t getPosition() override { return position; }
+    State getState() const override;
+
+    /**
+     * Frame metadata of the first part (the first system).
+     */
+    size_t getNumberOfFrameMetadata() override;
+    FrameMetadata getFrameMetadata(size_t frame) override;
+
+    size_t getNumberOfParts() const override;
+    BufferElement::SharedHandle getPart(size_t i) const override;
+    bool isConcatenated() const override { return concatenate; }
+
+    /**
+     * Returns the shape of the concatenation of the arrays of the given shapes.
+     */
+    static NdArray::Shape getMergedShape(const std::vector<NdArray::Shape> &shapes);
+
+private:
+    mutable std::mutex mutex;
+    size_t position;
+    bool concatenate;
+    size_t size;
+    NdArray data;
+    std::vector<BufferElement::SharedHandle> parts;
+};
+
+/**
+ * A buffer, which merges the buffers of several systems (e.g. us4R devices driven by a common trigger):
+ * the i-th element of this buffer is ready, when the i-th elements of all the merged buffers are ready
+ * (see FrameAligner).
+ *
+ * By default, the elements give access to the parts without copying (MergedBufferElement::getPart), and
+ * the 'on new data' callback is called in the thread of the system that delivered the last part. When the
+ * concatenation is enabled, the parts data is copied into the element and the callback is called in a thread
+ * owned by this buffer, so the copy does not delay the data acquisition threads of the systems.
+ *
+ * The callbacks are registered on all the merged buffers when registered on this buffer, i.e. registering
+ * a callback directly on a merged buffer afterwards detaches that buffer from this one.
+ * The overflow callback is called on the overflow of any of the merged buffers, and when some of the systems
+ * skipped an element (the other systems elements of that position are released and dropped then);
+ * the shutdown callback is called once, on the shutdown of the first of the merged buffers.
+ */
+class MergedDataBuffer : public DataBuffer, public std::enable_shared_from_this<MergedDataBuffer> {
+public:
+    using SharedHandle = std::shared_ptr<MergedDataBuffer>;
+
+    /**
+     * @param buffers buffers to merge; all of them should have the same number of elements and data type
+     * @param concatenate whether the elements data should be concatenated (copied) into the merged elements
+     */
+    explicit MergedDataBuffer(std::vector<DataBuffer::SharedHandle> buffers, bool concatenate = false);
+
+    ~MergedDataBuffer() override;
+
+    MergedDataBuffer(const MergedDataBuffer &) = delete;
+    MergedDataBuffer &operator=(const MergedDataBuffer &) = delete;
+
+    void registerOnNewDataCallback(OnNewDataCallback &callback) override;
+    void registerOnOverflowCallback(OnOverflowCallback &callback) override;
+    void registerShutdownCallback(OnShutdownCallback &callback) override;
+
+    size_t getNumberOfElements() const override { return elements.size(); }
+    BufferElement::SharedHandle getElement(size_t i) override { return elements.at(i); }
+    size_t getElementSize() const override;
+    size_t getNumberOfElementsInState(BufferElement::State state) const override;
+
+    size_t getNumberOfBuffers() const { return buffers.size(); }
+    const DataBuffer::SharedHandle &getBuffer(size_t i) const { return buffers.at(i); }
+
+private:
+    void onAligned(const std::vector<BufferElement::SharedHandle> &parts);
+    void deliver(const std::vector<BufferElement::SharedHandle> &parts);
+
+    /**
+     * Elements aligned by onAligned, waiting for the concatenation thread. Shared with the thread, so the thread
+     * can outlive the buffer (e.g. when the user callback drops the last reference to the buffer).
+     */
+    struct ConcatenationQueue {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::vector<BufferElement::SharedHandle>> elements;
+        bool isClosed{false};
+    };
+    /**
+     * Concatenation thread: delivers the aligned elements queued by onAligned. The buffer is locked only for the
+     * delivery of a single element, the loop exits when the buffer has expired or the queue was closed.
+     */
+    static void concatenationLoop(std::weak_ptr<MergedDataBuffer> self, std::shared_ptr<ConcatenationQueue> queue);
+
+    std::vector<DataBuffer::SharedHandle> buffers;
+    std::vector<std::shared_ptr<MergedBufferElementImpl>> elements;
+    FrameAligner aligner;
+    OnNewDataCallback onNewDataCallback;
+    OnOverflowCallback onOverflowCallback;
+    OnShutdownCallback onShutdownCallback;
+    std::atomic<bool> isShutdownNotified{false};
+
+    bool concatenate;
+    std::shared_ptr<ConcatenationQueue> queue;
+    /** Started on the 'on new data' callback registration, when the buffer is already owned by a shared_ptr. */
+    std::thread concatenationThread;
+};
+
+}// namespace arrus::framework
+
+#endif//ARRUS_CORE_FRAMEWORK_MERGEDDATABUFFER_H
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <numeric>
+#include <thread>
+
+#include "arrus/core/api/framework/FrameAligner.h"
+#include "arrus/core/common/logging.h"
+#include "arrus/core/framework/MergedDataBuffer.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::framework;
+using namespace arrus::devices;
+
+class TestBufferElement : public BufferElement {
+public:
+    TestBufferElement(size_t position, const NdArray::Shape &shape)
+        : data(shape, NdArray::DataType::INT16, DeviceId(DeviceType::CPU, 0), ""), position(position) {}
+
+    void release() override {
+        ++nReleases;
+        state = State::FREE;
+    }
+    NdArray &getData() override { return data; }
+    size_t getSize() override { return data.getNumberOfBytes(); }
+    size_t getPosition() override { return position; }
+    State getState() const override { return state; }
+
+    NdArray data;
+    size_t position;
+    State state{State::FREE};
+    int nReleases{0};
+};
+
+class TestDataBuffer : public DataBuffer {
+public:
+    TestDataBuffer(size_t nElements, const NdArray::Shape &shape) {
+        for (size_t i = 0; i < nElements; ++i) {
+            elements.push_back(std::make_shared<TestBufferElement>(i, shape));
+        }
+    }
+
+    /** Fills the i-th element with the given value and calls the 'on new data' callback. */
+    void produce(size_t i, int16 value) {
+        auto &element = elements.at(i);
+        std::fill(element->data.get<int16>(), element->data.get<int16>() + element->data.getNumberOfElements(),
+                  value);
+        element->state = BufferElement::State::READY;
+        onNewDataCallback(element);
+    }
+
+    void registerOnNewDataCallback(OnNewDataCallback &callback) override { onNewDataCallback = callback; }
+    void registerOnOverflowCallback(OnOverflowCallback &callback) override { onOverflowCallback = callback; }
+    void registerShutdownCallback(OnShutdownCallback &callback) override { onShutdownCallback = callback; }
+    size_t getNumberOfElements() const override { return elements.size(); }
+    BufferElement::SharedHandle getElement(size_t i) override { return elements.at(i); }
+    size_t getElementSize() const override { return elements.at(0)->data.getNumberOfBytes(); }
+    size_t getNumberOfElementsInState(BufferElement::State) const override { return 0; }
+
+    std::vector<std::shared_ptr<TestBufferElement>> elements;
+    OnNewDataCallback onNewDataCallback;
+    OnOverflowCallback onOverflowCallback;
+    OnShutdownCallback onShutdownCallback;
+};
+
+TEST(FrameAlignerTest, CallsCallbackWhenAllSystemsDelivered) {
+    std::vector<std::vector<BufferElement::SharedHandle>> aligned;
+    FrameAligner aligner{2, 3, [&](const auto &elements) { aligned.push_back(elements); }};
+    auto a0 = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto a1 = std::make_shared<TestBufferElement>(1, NdArray::Shape{1});
+    auto b0 = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto b1 = std::make_shared<TestBufferElement>(1, NdArray::Shape{1});
+    EXPECT_TRUE(aligner.push(0, a0));
+    EXPECT_TRUE(aligner.push(0, a1));
+    EXPECT_EQ(aligner.getNumberOfPendingPositions(), 2);
+    EXPECT_TRUE(aligner.push(1, b1));
+    ASSERT_EQ(aligned.size(), 1);
+    EXPECT_EQ(aligned[0], (std::vector<BufferElement::SharedHandle>{a1, b1}));
+    EXPECT_TRUE(aligner.push(1, b0));
+    ASSERT_EQ(aligned.size(), 2);
+    EXPECT_EQ(aligned[1], (std::vector<BufferElement::SharedHandle>{a0, b0}));
+    EXPECT_EQ(aligner.getNumberOfPendingPositions(), 0);
+    EXPECT_EQ(a0->nReleases + a1->nReleases + b0->nReleases + b1->nReleases, 0);
+}
+
+TEST(FrameAlignerTest, ResynchronizesWhenSystemIsAnElementBehind) {
+    std::vector<std::vector<BufferElement::SharedHandle>> aligned;
+    FrameAligner aligner{2, 2, [&](const auto &elements) { aligned.push_back(elements); }};
+    auto a0 = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto a1 = std::make_shared<TestBufferElement>(1, NdArray::Shape{1});
+    auto b0 = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto b1 = std::make_shared<TestBufferElement>(1, NdArray::Shape{1});
+    // The first round: the system 1 skips the element 1.
+    EXPECT_TRUE(aligner.push(0, a0));
+    EXPECT_TRUE(aligner.push(0, a1));
+    EXPECT_TRUE(aligner.push(1, b0));
+    ASSERT_EQ(aligned.size(), 1);
+    // The second round: the stale element of the system 0 is released and replaced with the new one.
+    EXPECT_TRUE(aligner.push(1, b0));
+    EXPECT_TRUE(aligner.push(0, a0));
+    ASSERT_EQ(aligned.size(), 2);
+    EXPECT_FALSE(aligner.push(0, a1));
+    EXPECT_EQ(a1->nReleases, 1);
+    EXPECT_EQ(aligner.getNumberOfPendingPositions(), 1);
+    EXPECT_TRUE(aligner.push(1, b1));
+    ASSERT_EQ(aligned.size(), 3);
+    EXPECT_EQ(aligned[2], (std::vector<BufferElement::SharedHandle>{a1, b1}));
+    EXPECT_EQ(aligner.getNumberOfPendingPositions(), 0);
+}
+
+TEST(FrameAlignerTest, ResynchronizesWhenSystemIsAheadByWholeBuffer) {
+    std::vector<std::vector<BufferElement::SharedHandle>> aligned;
+    FrameAligner aligner{3, 1, [&](const auto &elements) { aligned.push_back(elements); }};
+    auto a = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto aNext = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto b = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto c = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    EXPECT_TRUE(aligner.push(0, a));
+    EXPECT_TRUE(aligner.push(1, b));
+    // The system 2 has not delivered its element, the system 0 delivers the next one.
+    EXPECT_FALSE(aligner.push(0, aNext));
+    EXPECT_EQ(a->nReleases, 1);
+    EXPECT_EQ(b->nReleases, 1);
+    EXPECT_EQ(aNext->nReleases, 0);
+    EXPECT_TRUE(aligner.push(1, b));
+    EXPECT_TRUE(aligner.push(2, c));
+    ASSERT_EQ(aligned.size(), 1);
+    EXPECT_EQ(aligned[0], (std::vector<BufferElement::SharedHandle>{aNext, b, c}));
+}
+
+TEST(FrameAlignerTest, ResetReleasesPendingElements) {
+    FrameAligner aligner{2, 2, [&](const auto &) { FAIL(); }};
+    auto a = std::make_shared<TestBufferElement>(0, NdArray::Shape{1});
+    auto b = std::make_shared<TestBufferElement>(1, NdArray::Shape{1});
+    EXPECT_TRUE(aligner.push(0, a));
+    EXPECT_TRUE(aligner.push(1, b));
+    aligner.reset();
+    EXPECT_EQ(aligner.getNumberOfPendingPositions(), 0);
+    EXPECT_EQ(a->nReleases, 1);
+    EXPECT_EQ(b->nReleases, 1);
+    EXPECT_THROW(aligner.push(2, a), IllegalArgumentException);
+}
+
+TEST(MergedDataBufferTest, ProvidesPartsWithoutCopying) {
+    auto a = std::make_shared<TestDataBuffer>(2, NdArray::Shape{2, 4});
+    auto b = std::make_shared<TestDataBuffer>(2, NdArray::Shape{3, 4});
+    auto merged = std::make_shared<MergedDataBuffer>(std::vector<DataBuffer::SharedHandle>{a, b});
+    EXPECT_EQ(merged->getElementSize(), 20 * sizeof(int16));
+
+    std::vector<BufferElement::SharedHandle> delivered;
+    OnNewDataCallback callback = [&](const BufferElement::SharedHandle &element) { delivered.push_back(element); };
+    merged->registerOnNewDataCallback(callback);
+    a->produce(1, 1);
+    EXPECT_TRUE(delivered.empty());
+    b->produce(1, 2);
+    ASSERT_EQ(delivered.size(), 1);
+    auto element = std::dynamic_pointer_cast<MergedBufferElement>(delivered[0]);
+    ASSERT_TRUE(element);
+    EXPECT_EQ(element->getPosition(), 1);
+    EXPECT_EQ(element->getState(), BufferElement::State::READY);
+    EXPECT_FALSE(element->isConcatenated());
+    EXPECT_THROW(element->getData(), IllegalStateException);
+    ASSERT_EQ(element->getNumberOfParts(), 2);
+    EXPECT_EQ(element->getPart(0), a->elements[1]);
+    EXPECT_EQ(element->getPart(1), b->elements[1]);
+    EXPECT_EQ(element->getSize(), 20 * sizeof(int16));
+    // The parts are released together with the merged element.
+    EXPECT_EQ(a->elements[1]->nReleases, 0);
+    element->release();
+    EXPECT_EQ(a->elements[1]->nReleases, 1);
+    EXPECT_EQ(b->elements[1]->nReleases, 1);
+    EXPECT_EQ(element->getState(), BufferElement::State::FREE);
+    EXPECT_EQ(element->getPart(0), nullptr);
+}
+
+TEST(MergedDataBufferTest, ConcatenatesElementsOutsideProducerThread) {
+    auto a = std::make_shared<TestDataBuffer>(2, NdArray::Shape{2, 4});
+    auto b = std::make_shared<TestDataBuffer>(2, NdArray::Shape{3, 4});
+    auto merged = std::make_shared<MergedDataBuffer>(std::vector<DataBuffer::SharedHandle>{a, b}, true);
+    EXPECT_EQ(merged->getElement(0)->getData().getShape(), (NdArray::Shape{5, 4}));
+
+    std::promise<std::pair<BufferElement::SharedHandle, std::thread::id>> delivered;
+    OnNewDataCallback callback = [&](const BufferElement::SharedHandle &element) {
+        delivered.set_value({element, std::this_thread::get_id()});
+    };
+    merged->registerOnNewDataCallback(callback);
+    a->produce(1, 1);
+    b->produce(1, 2);
+    auto future = delivered.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto [element, threadId] = future.get();
+    EXPECT_NE(threadId, std::this_thread::get_id());
+    EXPECT_EQ(element->getPosition(), 1);
+    const int16 *data = element->getData().get<int16>();
+    EXPECT_EQ(std::accumulate(data, data + 8, 0), 8);
+    EXPECT_EQ(std::accumulate(data + 8, data + 20, 0), 24);
+    element->release();
+    EXPECT_EQ(a->elements[1]->nReleases, 1);
+    EXPECT_EQ(b->elements[1]->nReleases, 1);
+}
+
+TEST(MergedDataBufferTest, CanBeReleasedFromConcatenationThreadCallback) {
+    auto a = std::make_shared<TestDataBuffer>(2, NdArray::Shape{4});
+    auto b = std::make_shared<TestDataBuffer>(2, NdArray::Shape{4});
+    auto merged = std::make_shared<MergedDataBuffer>(std::vector<DataBuffer::SharedHandle>{a, b}, true);
+    std::weak_ptr<MergedDataBuffer> observer = merged;
+
+    std::promise<void> delivered;
+    OnNewDataCallback callback = [&](const BufferElement::SharedHandle &element) {
+        element->release();
+        // Drop the last user reference to the buffer in the concatenation thread.
+        merged.reset();
+        delivered.set_value();
+    };
+    merged->registerOnNewDataCallback(callback);
+    a->produce(0, 1);
+    b->produce(0, 2);
+    auto future = delivered.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!observer.expired() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(observer.expired());
+    EXPECT_EQ(a->elements[0]->nReleases, 1);
+    EXPECT_EQ(b->elements[0]->nReleases, 1);
+    // The systems may still deliver data; it is ignored by the destroyed buffer.
+    a->produce(1, 1);
+    b->produce(1, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(a->elements[1]->nReleases, 0);
+}
+
+TEST(MergedDataBufferTest, ReleasesElementsOfSkippedPosition) {
+    auto a = std::make_shared<TestDataBuffer>(2, NdArray::Shape{4});
+    auto b = std::make_shared<TestDataBuffer>(2, NdArray::Shape{4});
+    auto merged = std::make_shared<MergedDataBuffer>(std::vector<DataBuffer::SharedHandle>{a, b});
+    std::vector<BufferElement::SharedHandle> delivered;
+    int nOverflows = 0;
+    OnNewDataCallback onNewData = [&](const BufferElement::SharedHandle &element) { delivered.push_back(element); };
+    OnOverflowCallback onOverflow = [&]() { ++nOverflows; };
+    merged->registerOnNewDataCallback(onNewData);
+    merged->registerOnOverflowCallback(onOverflow);
+    // The system b skips the element 0.
+    a->produce(0, 1);
+    a->produce(0, 1);
+    EXPECT_EQ(nOverflows, 1);
+    EXPECT_EQ(a->elements[0]->nReleases, 1);
+    b->produce(0, 2);
+    ASSERT_EQ(delivered.size(), 1);
+    EXPECT_EQ(std::dynamic_pointer_cast<MergedBufferElement>(delivered[0])->getPart(0), a->elements[0]);
+}
+
+TEST(MergedDataBufferTest, FlattensElementsOfDifferentShapes) {
+    EXPECT_EQ(MergedBufferElementImpl::getMergedShape({{2, 4}, {2, 3}}), (NdArray::Shape{14}));
+    EXPECT_EQ(MergedBufferElementImpl::getMergedShape({{2, 4}, {4}}), (NdArray::Shape{12}));
+    EXPECT_EQ(MergedBufferElementImpl::getMergedShape({{1, 2, 3}, {2, 2, 3}}), (NdArray::Shape{3, 2, 3}));
+}
+
+TEST(MergedDataBufferTest, ForwardsOverflowAndShutdownOnce) {
+    auto a = std::make_shared<TestDataBuffer>(1, NdArray::Shape{4});
+    auto b = std::make_shared<TestDataBuffer>(1, NdArray::Shape{4});
+    auto merged = std::make_shared<MergedDataBuffer>(std::vector<DataBuffer::SharedHandle>{a, b});
+    int nOverflows = 0, nShutdowns = 0;
+    OnOverflowCallback onOverflow = [&]() { ++nOverflows; };
+    OnShutdownCallback onShutdown = [&]() { ++nShutdowns; };
+    merged->registerOnOverflowCallback(onOverflow);
+    merged->registerShutdownCallback(onShutdown);
+    b->onOverflowCallback();
+    EXPECT_EQ(nOverflows, 1);
+    a->onShutdownCallback();
+    b->onShutdownCallback();
+    EXPECT_EQ(nShutdowns, 1);
+}
+
+TEST(MergedDataBufferTest, RejectsBuffersOfDifferentLength) {
+    auto a = std::make_shared<TestDataBuffer>(2, NdArray::Shape{4});
+    auto b = std::make_shared<TestDataBuffer>(3, NdArray::Shape{4});
+    EXPECT_THROW(MergedDataBuffer(std::vector<DataBuffer::SharedHandle>{a, b}), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/api/framework/NdArray.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::devices;
+using namespace arrus::framework;
+
+const DeviceId CPU0{DeviceType::CPU, 0};
+
+/** (2, 3, 4) int16 array with values 0, 1, ..., 23. */
+NdArray getArray() {
+    NdArray array{NdArray::Shape{2, 3, 4}, NdArray::DataType::INT16, CPU0, "array"};
+    std::iota(array.get<int16>(), array.get<int16>() + array.getNumberOfElements(), (int16) 0);
+    return array;
+}
+
+std::vector<int16> toVector(const NdArray &array) {
+    NdArray copy = array.copy();
+    return std::vector<int16>(copy.get<int16>(), copy.get<int16>() + copy.getNumberOfElements());
+}
+
+TEST(NdArrayTest, CopiesShareData) {
+    NdArray array{NdArray::Shape{2, 2}, NdArray::DataType::FLOAT32, CPU0, "array"};
+    NdArray copy = array;
+    copy.set<float>(1, 0, 3.0f);
+    EXPECT_EQ(array.get<float>(1, 0), 3.0f);
+    EXPECT_EQ(array.get<float>(), copy.get<float>());
+    EXPECT_TRUE(copy.isOwner());
+
+    NdArray independent = array.copy();
+    independent.set<float>(1, 0, 4.0f);
+    EXPECT_EQ(array.get<float>(1, 0), 3.0f);
+}
+
+TEST(NdArrayTest, ViewKeepsOwnedDataAlive) {
+    NdArray view;
+    {
+        NdArray array = getArray();
+        view = array.slice(0, 1, 2);
+    }
+    EXPECT_EQ(toVector(view), std::vector<int16>({12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23}));
+}
+
+TEST(NdArrayTest, SetsFlatIndexValue) {
+    NdArray array{NdArray::Shape{2, 3}, NdArray::DataType::UINT8, CPU0, "array"};
+    array.set<uint8>(4, 7);
+    EXPECT_EQ(array.get<uint8>()[4], 7);
+    EXPECT_THROW(array.set<uint8>(6, 1), IllegalArgumentException);
+
+    // Flat index of a transposed view, in the C-order of the view.
+    NdArray transposed = array.transpose();
+    transposed.set<uint8>(1, 9);// (0, 1) of the view == (1, 0) of the array
+    EXPECT_EQ(array.get<uint8>()[3], 9);
+}
+
+TEST(NdArrayTest, SlicesAlongAnyAxis) {
+    NdArray array = getArray();
+    EXPECT_EQ(array.getStrides(), NdArray::Strides({12, 4, 1}));
+
+    NdArray middle = array.slice(1, 1, 2);
+    EXPECT_EQ(middle.getShape(), NdArray::Shape({2, 1, 4}));
+    EXPECT_EQ(middle.getStrides(), NdArray::Strides({12, 4, 1}));
+    EXPECT_FALSE(middle.isContiguous());
+    EXPECT_EQ(toVector(middle), std::vector<int16>({4, 5, 6, 7, 16, 17, 18, 19}));
+
+    NdArray last = array.slice(2, 2, -1);
+    EXPECT_EQ(last.getShape(), NdArray::Shape({2, 3, 2}));
+    EXPECT_EQ(toVector(last), std::vector<int16>({2, 3, 6, 7, 10, 11, 14, 15, 18, 19, 22, 23}));
+
+    EXPECT_THROW(array.slice(3, 0, 1), IllegalArgumentException);
+    EXPECT_THROW(array.slice(1, 2, 4), IllegalArgumentException);
+}
+
+TEST(NdArrayTest, SlicesMultipleAxesWithStep) {
+    NdArray array = getArray();
+    NdArray result = array.slice({NdArray::Slice{1, -1, 1}, NdArray::Slice{0, -1, 2}, NdArray::Slice{1, 4, 2}});
+    EXPECT_EQ(result.getShape(), NdArray::Shape({1, 2, 2}));
+    EXPECT_EQ(result.getStrides(), NdArray::Strides({12, 8, 2}));
+    EXPECT_EQ(toVector(result), std::vector<int16>({13, 15, 21, 23}));
+    // Slice of the slice.
+    EXPECT_EQ(toVector(result.slice(1, 1, 2)), std::vector<int16>({21, 23}));
+}
+
+TEST(NdArrayTest, SlicesWithDataTypeSize) {
+    NdArray array{NdArray::Shape{3, 2}, NdArray::DataType::COMPLEX_FLOAT32, CPU0, "iq"};
+    auto *data = array.get<float>();
+    for (size_t i = 0; i < 2 * array.getNumberOfElements(); ++i) {
+        data[i] = (float) i;
+    }
+    NdArray row = array.slice(0, 2, 3);
+    EXPECT_EQ(row.get<float>()[0], 8.0f);
+    EXPECT_EQ(row.get<float>()[3], 11.0f);
+    EXPECT_EQ(NdArray::getDataTypeSize(NdArray::DataType::COMPLEX_INT16), 4);
+    EXPECT_EQ(NdArray::getDataTypeSize(NdArray::DataType::FLOAT16), 2);
+}
+
+TEST(NdArrayTest, TransposesWithoutCopy) {
+    NdArray array = getArray();
+    NdArray transposed = array.transpose({2, 0, 1});
+    EXPECT_EQ(transposed.getShape(), NdArray::Shape({4, 2, 3}));
+    EXPECT_EQ(transposed.getStrides(), NdArray::Strides({1, 12, 4}));
+    EXPECT_EQ(transposed.get<int16>(), array.get<int16>());
+    auto values = toVector(transposed);
+    EXPECT_EQ(std::vector<int16>(values.begin(), values.begin() + 6), std::vector<int16>({0, 4, 8, 12, 16, 20}));
+
+    NdArray matrix = array.slice(0, 0, 1).transpose({0, 2, 1}).slice(1, 1, 3);
+    EXPECT_EQ(toVector(matrix), std::vector<int16>({1, 5, 9, 2, 6, 10}));
+    EXPECT_THROW(array.transpose({0, 0, 1}), IllegalArgumentException);
+}
+
+TEST(NdArrayTest, CopiesExternalData) {
+    std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f};
+    NdArray view{values.data(), NdArray::Shape{2, 2}, NdArray::DataType::FLOAT32, CPU0, "view", true};
+    NdArray copy{values.data(), NdArray::Shape{2, 2}, NdArray::DataType::FLOAT32, CPU0, "copy", false};
+    values[3] = 5.0f;
+    EXPECT_FALSE(view.isOwner());
+    EXPECT_EQ(view.get<float>(1, 1), 5.0f);
+    EXPECT_TRUE(copy.isOwner());
+    EXPECT_EQ(copy.get<float>(1, 1), 4.0f);
+    EXPECT_EQ(copy.getName(), "copy");
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include "arrus/core/api/framework/dlpack.h"
+
+#include <vector>
+
+#include "arrus/common/format.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/common/logging.h"
+
+namespace arrus::framework {
+
+namespace {
+
+/**
+ * DLManagedTensor::manager_ctx: keeps the exported array (and its shape and strides) and the buffer
+ * element (if any) alive as long as the tensor is used.
+ */
+struct DLPackContext {
+    NdArray array;
+    BufferElement::SharedHandle element;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    DLManagedTensor tensor{};
+};
+
+void deleteDLPackContext(DLManagedTensor *self) {
+    auto *ctx = static_cast<DLPackContext *>(self->manager_ctx);
+    if (ctx->element) {
+        try {
+            ctx->element->release();
+        } catch (const std::exception &e) {
+            getDefaultLogger()->log(LogSeverity::ERROR,
+                                    format("Exception while releasing the DLPack buffer element: {}", e.what()));
+        } catch (...) {
+            getDefaultLogger()->log(LogSeverity::ERROR,
+                                    "Unknown exception while releasing the DLPack buffer element.");
+        }
+    }
+    delete ctx;
+}
+
+DLDataType toDLDataType(NdArray::DataType type) {
+    switch (type) {
+    case NdArray::DataType::INT16:
+    case NdArray::DataType::COMPLEX_INT16:// (real, imaginary) pairs, see the additional axis.
+        return DLDataType{kDLInt, 16, 1};
+    case NdArray::DataType::FLOAT32: return DLDataType{kDLFloat, 32, 1};
+    case NdArray::DataType::UINT8: return DLDataType{kDLUInt, 8, 1};
+    case NdArray::DataType::FLOAT16: return DLDataType{kDLFloat, 16, 1};
+    case NdArray::DataType::COMPLEX_FLOAT32: return DLDataType{kDLComplex, 64, 1};
+    default: throw IllegalArgumentException("Unsupported data type.");
+    }
+}
+
+DLDevice toDLDevice(const devices::DeviceId &placement) {
+    switch (placement.getDeviceType()) {
+    case devices::DeviceType::CPU:
+    // The data of the buffer elements is placed in the host memory.
+    case devices::DeviceType::Us4R:
+    case devices::DeviceType::File: return DLDevice{kDLCPU, 0};
+    case devices::DeviceType::GPU: return DLDevice{kDLCUDA, (int32_t) placement.getOrdinal()};
+    default:
+        throw IllegalArgumentException(
+            format("Arrays placed on {} cannot be exported to DLPack.", placement.toString()));
+    }
+}
+
+DLManagedTensor *createDLPackTensor(const NdArray &array, BufferElement::SharedHandle element) {
+    DLDevice device = toDLDevice(array.getPlacement());
+    DLDataType dataType = toDLDataType(array.getDataType());
+
+    auto *ctx = new DLPackContext{array, std::move(element), {}, {}, {}};
+    const auto &shape = array.getShape();
+    const auto &strides = array.getStrides();
+    const bool isComplexInt16 = array.getDataType() == NdArray::DataType::COMPLEX_INT16;
+    // Strides of the complex int16 arrays are expressed in the number of int16 values.
+    const int64_t strideScale = isComplexInt16 ? 2 : 1;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        ctx->shape.push_back((int64_t) shape[i]);
+        ctx->strides.push_back((int64_t) strides[i] * strideScale);
+    }
+    if (isComplexInt16) {
+        ctx->shape.push_back(2);
+        ctx->strides.push_back(1);
+    }
+    DLTensor &tensor = ctx->tensor.dl_tensor;
+    tensor.data = const_cast<NdArray &>(ctx->array).get<void>();
+    tensor.device = device;
+    tensor.ndim = (int32_t) ctx->shape.size();
+    tensor.dtype = dataType;
+    tensor.shape = ctx->shape.data();
+    tensor.strides = ctx->strides.data();
+    tensor.byte_offset = 0;
+    ctx->tensor.manager_ctx = ctx;
+    ctx->tensor.deleter = &deleteDLPackContext;
+    return &ctx->tensor;
+}
+
+}// namespace
+
+DLManagedTensor *toDLPack(const NdArray &array) { return createDLPackTensor(array, nullptr); }
+
+DLManagedTensor *toDLPack(const BufferElement::SharedHandle &element) {
+    if (!element) {
+        throw IllegalArgumentException("Buffer element cannot be null.");
+    }
+    return createDLPackTensor(element->getData(), element);
+}
+
+}// namespace arrus::framework
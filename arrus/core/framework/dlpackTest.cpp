@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "arrus/core/api/framework/dlpack.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::framework;
+using namespace arrus::devices;
+
+class TestBufferElement : public BufferElement {
+public:
+    explicit TestBufferElement(NdArray data) : data(std::move(data)) {}
+
+    void release() override { ++nReleases; }
+    NdArray &getData() override { return data; }
+    size_t getSize() override { return data.getNumberOfBytes(); }
+    size_t getPosition() override { return 0; }
+    State getState() const override { return State::READY; }
+
+    NdArray data;
+    int nReleases{0};
+};
+
+std::vector<int64_t> getShape(const DLTensor &tensor) {
+    return std::vector<int64_t>(tensor.shape, tensor.shape + tensor.ndim);
+}
+
+std::vector<int64_t> getStrides(const DLTensor &tensor) {
+    return std::vector<int64_t>(tensor.strides, tensor.strides + tensor.ndim);
+}
+
+TEST(DLPackTest, ExportsArrayWithoutCopy) {
+    NdArray array{{2, 3}, NdArray::DataType::FLOAT32, DeviceId(DeviceType::CPU, 0), "array"};
+    DLManagedTensor *tensor = toDLPack(array);
+    const DLTensor &t = tensor->dl_tensor;
+    EXPECT_EQ(t.data, array.get<float>());
+    EXPECT_EQ(t.device.device_type, kDLCPU);
+    EXPECT_EQ(t.dtype.code, kDLFloat);
+    EXPECT_EQ(t.dtype.bits, 32);
+    EXPECT_EQ(t.dtype.lanes, 1);
+    EXPECT_EQ(getShape(t), (std::vector<int64_t>{2, 3}));
+    EXPECT_EQ(getStrides(t), (std::vector<int64_t>{3, 1}));
+    tensor->deleter(tensor);
+}
+
+TEST(DLPackTest, KeepsOwnedDataAliveUntilDeleted) {
+    DLManagedTensor *tensor;
+    {
+        NdArray array{{4}, NdArray::DataType::INT16, DeviceId(DeviceType::CPU, 0), "array"};
+        array.set<int16>(3, 7);
+        tensor = toDLPack(array);
+    }
+    EXPECT_EQ(static_cast<int16 *>(tensor->dl_tensor.data)[3], 7);
+    tensor->deleter(tensor);
+}
+
+TEST(DLPackTest, ExportsStridedView) {
+    NdArray array{{4, 6}, NdArray::DataType::INT16, DeviceId(DeviceType::CPU, 0), "array"};
+    NdArray view = array.slice({NdArray::Slice{1, 3, 1}, NdArray::Slice{0, -1, 2}}).transpose();
+    DLManagedTensor *tensor = toDLPack(view);
+    EXPECT_EQ(tensor->dl_tensor.data, array.get<int16>() + 6);
+    EXPECT_EQ(getShape(tensor->dl_tensor), (std::vector<int64_t>{3, 2}));
+    EXPECT_EQ(getStrides(tensor->dl_tensor), (std::vector<int64_t>{2, 6}));
+    tensor->deleter(tensor);
+}
+
+TEST(DLPackTest, ExportsComplexInt16AsInt16Pairs) {
+    NdArray array{{2, 3}, NdArray::DataType::COMPLEX_INT16, DeviceId(DeviceType::CPU, 0), "array"};
+    DLManagedTensor *tensor = toDLPack(array);
+    EXPECT_EQ(tensor->dl_tensor.dtype.code, kDLInt);
+    EXPECT_EQ(tensor->dl_tensor.dtype.bits, 16);
+    EXPECT_EQ(getShape(tensor->dl_tensor), (std::vector<int64_t>{2, 3, 2}));
+    EXPECT_EQ(getStrides(tensor->dl_tensor), (std::vector<int64_t>{6, 2, 1}));
+    tensor->deleter(tensor);
+}
+
+TEST(DLPackTest, ExportsGpuPlacement) {
+    int16 data[4];
+    NdArray array{data, {4}, NdArray::DataType::INT16, DeviceId(DeviceType::GPU, 1)};
+    DLManagedTensor *tensor = toDLPack(array);
+    EXPECT_EQ(tensor->dl_tensor.device.device_type, kDLCUDA);
+    EXPECT_EQ(tensor->dl_tensor.device.device_id, 1);
+    tensor->deleter(tensor);
+}
+
+TEST(DLPackTest, ThrowsOnUnsupportedPlacement) {
+    int16 data[4];
+    NdArray array{data, {4}, NdArray::DataType::INT16, DeviceId(DeviceType::Us4OEM, 0)};
+    EXPECT_THROW(toDLPack(array), IllegalArgumentException);
+}
+
+TEST(DLPackTest, ReleasesBufferElementOnDelete) {
+    int16 data[8];
+    auto element = std::make_shared<TestBufferElement>(
+        NdArray{data, {2, 4}, NdArray::DataType::INT16, DeviceId(DeviceType::Us4R, 0)});
+    DLManagedTensor *tensor = toDLPack(std::static_pointer_cast<BufferElement>(element));
+    EXPECT_EQ(tensor->dl_tensor.data, data);
+    EXPECT_EQ(tensor->dl_tensor.device.device_type, kDLCPU);
+    EXPECT_EQ(element.use_count(), 2);
+    EXPECT_EQ(element->nReleases, 0);
+    tensor->deleter(tensor);
+    EXPECT_EQ(element->nReleases, 1);
+    EXPECT_EQ(element.use_count(), 1);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,4 +1,158 @@
 #ifndef ARRUS_CORE_FRAMEWORK_GRAPH_GRAPH_H
 #define ARRUS_CORE_FRAMEWORK_GRAPH_GRAPH_H
 
-#endif //ARRUS_CORE_FRAMEWORK_GRAPH_GRAPH_H
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrus/common/format.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/framework/NdArray.h"
+
+namespace arrus::framework::graph {
+
+/**
+ * Definition of the array produced/consumed by graph nodes: shape and data type.
+ */
+class ArrayDef {
+public:
+    ArrayDef(NdArray::Shape shape, NdArray::DataType dataType) : shape(std::move(shape)), dataType(dataType) {}
+
+    const NdArray::Shape &getShape() const { return shape; }
+
+    NdArray::DataType getDataType() const { return dataType; }
+
+    bool operator==(const ArrayDef &rhs) const {
+        return shape.getValues() == rhs.shape.getValues() && dataType == rhs.dataType;
+    }
+
+    bool operator!=(const ArrayDef &rhs) const { return !(rhs == *this); }
+
+private:
+    NdArray::Shape shape;
+    NdArray::DataType dataType;
+};
+
+/**
+ * Graph operator: consumes one or more arrays and produces a single output array.
+ *
+ * The output array is allocated by the graph executor, based on the definition returned by the prepare method.
+ * The process method is called by a single thread only (the thread of the node), for subsequent frames.
+ */
+class Node {
+public:
+    using Handle = std::unique_ptr<Node>;
+
+    virtual ~Node() = default;
+
+    /**
+     * Prepares the node for processing the inputs with the given definitions.
+     *
+     * @param inputs definitions of the input arrays, in the order of the node inputs
+     * @return the definition of the output array
+     */
+    virtual ArrayDef prepare(const std::vector<ArrayDef> &inputs) = 0;
+
+    /**
+     * Processes a single frame.
+     *
+     * @param inputs input arrays, in the order of the node inputs
+     * @param output the output array, with the definition returned by prepare
+     */
+    virtual void process(const std::vector<const NdArray *> &inputs, NdArray &output) = 0;
+};
+
+/**
+ * A node that wraps the given functions.
+ */
+class FunctionNode : public Node {
+public:
+    using PrepareFunction = std::function<ArrayDef(const std::vector<ArrayDef> &)>;
+    using ProcessFunction = std::function<void(const std::vector<const NdArray *> &, NdArray &)>;
+
+    FunctionNode(PrepareFunction prepareFunc, ProcessFunction processFunc)
+        : prepareFunc(std::move(prepareFunc)), processFunc(std::move(processFunc)) {}
+
+    ArrayDef prepare(const std::vector<ArrayDef> &inputs) override { return prepareFunc(inputs); }
+
+    void process(const std::vector<const NdArray *> &inputs, NdArray &output) override {
+        processFunc(inputs, output);
+    }
+
+private:
+    PrepareFunction prepareFunc;
+    ProcessFunction processFunc;
+};
+
+/**
+ * Directed acyclic graph of operators.
+ *
+ * The graph consists of input nodes (sources of data, e.g. us4R output buffer) and operator nodes. Node inputs have to
+ * be added to the graph before the node, so the order of nodes is always a topological order of the graph.
+ */
+class Graph {
+public:
+    using NodeId = size_t;
+
+    struct NodeDef {
+        std::string name;
+        /** Operator, nullptr for the graph inputs. */
+        std::shared_ptr<Node> node;
+        std::vector<NodeId> inputs;
+        /** Definition of the output array; for operator nodes: determined by the executor (see Node::prepare). */
+        std::optional<ArrayDef> outputDef;
+        /** CPU core the node thread should be pinned to; nullopt: no affinity. */
+        std::optional<unsigned> cpuAffinity;
+    };
+
+    /**
+     * Adds a new input to the graph, i.e. a source of arrays with the given definition.
+     */
+    NodeId addInput(std::string name, ArrayDef def) {
+        nodes.push_back(NodeDef{std::move(name), nullptr, {}, std::move(def), std::nullopt});
+        return nodes.size() - 1;
+    }
+
+    /**
+     * Adds a new operator node to the graph.
+     *
+     * @param name node name (used e.g. in the timing statistics)
+     * @param node operator
+     * @param inputs input nodes; all of them must already be present in the graph
+     * @param cpuAffinity CPU core the node thread should be pinned to
+     * @return id of the new node
+     */
+    NodeId addNode(std::string name, Node::Handle node, std::vector<NodeId> inputs,
+                   std::optional<unsigned> cpuAffinity = std::nullopt) {
+        if (node == nullptr) {
+            throw IllegalArgumentException(format("Node '{}': operator cannot be null.", name));
+        }
+        if (inputs.empty()) {
+            throw IllegalArgumentException(format("Node '{}' should have at least one input.", name));
+        }
+        for (auto input : inputs) {
+            if (input >= nodes.size()) {
+                throw IllegalArgumentException(format("Node '{}': unknown input node: {}", name, input));
+            }
+        }
+        nodes.push_back(NodeDef{std::move(name), std::move(node), std::move(inputs), std::nullopt, cpuAffinity});
+        return nodes.size() - 1;
+    }
+
+    const std::vector<NodeDef> &getNodes() const { return nodes; }
+
+    const NodeDef &getNode(NodeId id) const { return nodes.at(id); }
+
+    bool isInput(NodeId id) const { return nodes.at(id).node == nullptr; }
+
+private:
+    std::vector<NodeDef> nodes;
+};
+
+}// namespace arrus::framework::graph
+
+#endif//ARRUS_CORE_FRAMEWORK_GRAPH_GRAPH_H
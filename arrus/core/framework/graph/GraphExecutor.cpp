@@ -0,0 +1,358 @@
+#include "GraphExecutor.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#undef ERROR
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+
+#include "arrus/common/format.h"
+#include "arrus/core/common/logging.h"
+
+namespace arrus::framework::graph {
+
+namespace {
+
+bool setCurrentThreadAffinity(unsigned cpu) {
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+    return false;
+#endif
+}
+
+}// namespace
+
+GraphExecutor::GraphExecutor(Graph graph, size_t queueSize)
+    : logger{getLoggerFactory()->getLogger()}, graph(std::move(graph)), queueSize(queueSize) {
+    if (queueSize == 0) {
+        throw IllegalArgumentException("The graph executor queue size should be greater than 0.");
+    }
+    const auto &nodeDefs = this->graph.getNodes();
+    nodes = std::vector<NodeState>(nodeDefs.size());
+    for (Graph::NodeId id = 0; id < nodeDefs.size(); ++id) {
+        const auto &def = nodeDefs[id];
+        auto &node = nodes[id];
+        node.statistics.name = def.name;
+        node.slots = std::vector<Slot>(queueSize);
+        if (this->graph.isInput(id)) {
+            node.outputDef = def.outputDef;
+            continue;
+        }
+        std::vector<ArrayDef> inputDefs;
+        for (auto input : def.inputs) {
+            inputDefs.push_back(nodes[input].outputDef.value());
+            nodes[input].consumers.push_back(id);
+        }
+        node.outputDef = def.node->prepare(inputDefs);
+        for (auto &slot : node.slots) {
+            slot.array = NdArray(node.outputDef->getShape(), node.outputDef->getDataType(),
+                                 devices::DeviceId(devices::DeviceType::CPU, 0), def.name);
+        }
+    }
+}
+
+GraphExecutor::~GraphExecutor() {
+    try {
+        stop();
+    } catch (const std::exception &e) {
+        logger->log(LogSeverity::ERROR, format("Exception while stopping graph executor: {}", e.what()));
+    }
+}
+
+void GraphExecutor::registerOutputCallback(Graph::NodeId node, OutputCallback callback) {
+    std::unique_lock<std::mutex> lock{mutex};
+    if (graph.isInput(node)) {
+        throw IllegalArgumentException(format("Node {} is a graph input.", graph.getNode(node).name));
+    }
+    nodes.at(node).outputCallbacks.push_back(std::move(callback));
+}
+
+void GraphExecutor::connect(Graph::NodeId input, DataBuffer &buffer) {
+    if (!graph.isInput(input)) {
+        throw IllegalArgumentException(format("Node {} is not a graph input.", graph.getNode(input).name));
+    }
+    // NOTE: called in the data acquisition thread, must not block.
+    OnNewDataCallback callback = [this, input](const BufferElement::SharedHandle &element) {
+        this->tryPush(input, element);
+    };
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        if (std::find(std::begin(bufferFedInputs), std::end(bufferFedInputs), input) == std::end(bufferFedInputs)) {
+            bufferFedInputs.push_back(input);
+        }
+    }
+    bufferCallbacks[input] = callback;
+    buffer.registerOnNewDataCallback(bufferCallbacks[input]);
+}
+
+void GraphExecutor::start() {
+    std::unique_lock<std::mutex> lock{mutex};
+    if (isRunning) {
+        return;
+    }
+    for (auto &node : nodes) {
+        node.nextFrame = 0;
+        node.nDroppedFrames = 0;
+        node.nReceivedAcquisitions = 0;
+        for (auto &slot : node.slots) {
+            slot.frame = -1;
+            slot.nPendingConsumers = 0;
+        }
+    }
+    pendingAcquisitions.clear();
+    firstPendingAcquisition = 0;
+    nextAcquisitionFrame = 0;
+    isRunning = true;
+    for (Graph::NodeId id = 0; id < nodes.size(); ++id) {
+        if (!graph.isInput(id)) {
+            threads.emplace_back(&GraphExecutor::runNode, this, id);
+        }
+    }
+}
+
+void GraphExecutor::stop() {
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        isRunning = false;
+    }
+    cv.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    // Release input arrays that were not processed.
+    std::vector<ReleaseFunction> toRelease;
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        for (Graph::NodeId id = 0; id < nodes.size(); ++id) {
+            if (!graph.isInput(id)) {
+                continue;
+            }
+            for (auto &slot : nodes[id].slots) {
+                if (slot.nPendingConsumers > 0 && slot.release) {
+                    toRelease.push_back(slot.release);
+                }
+                slot.nPendingConsumers = 0;
+                slot.release = nullptr;
+            }
+        }
+    }
+    for (auto &release : toRelease) {
+        release();
+    }
+}
+
+bool GraphExecutor::push(Graph::NodeId input, const NdArray &array, const ReleaseFunction &release) {
+    return pushArray(input, array, release, true);
+}
+
+bool GraphExecutor::tryPush(Graph::NodeId input, const NdArray &array, const ReleaseFunction &release) {
+    return pushArray(input, array, release, false);
+}
+
+bool GraphExecutor::pushArray(Graph::NodeId input, const NdArray &array, const ReleaseFunction &release,
+                              bool isBlocking) {
+    if (!graph.isInput(input)) {
+        throw IllegalArgumentException(format("Node {} is not a graph input.", graph.getNode(input).name));
+    }
+    auto &node = nodes.at(input);
+    ArrayDef def{array.getShape(), array.getDataType()};
+    if (def != node.outputDef.value()) {
+        throw IllegalArgumentException(
+            format("Graph input {}: the array shape or data type is different than declared.",
+                   graph.getNode(input).name));
+    }
+    bool isReleaseNeeded = false;
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        auto frame = node.nextFrame;
+        auto &slot = node.slots[frame % queueSize];
+        if (isBlocking) {
+            cv.wait(lock, [this, &slot]() { return !isRunning || slot.nPendingConsumers == 0; });
+        }
+        if (!isRunning) {
+            lock.unlock();
+            release();
+            return false;
+        }
+        bool isBufferFed = std::find(std::begin(bufferFedInputs), std::end(bufferFedInputs), input)
+                           != std::end(bufferFedInputs);
+        if ((!isBlocking && isBufferFed && !acceptAcquisition(input)) || slot.nPendingConsumers > 0) {
+            ++node.nDroppedFrames;
+            lock.unlock();
+            release();
+            return false;
+        }
+        slot.array = array.view();
+        slot.frame = frame;
+        slot.nPendingConsumers = node.consumers.size();
+        slot.release = release;
+        ++node.nextFrame;
+        isReleaseNeeded = node.consumers.empty();
+    }
+    if (isReleaseNeeded) {
+        release();
+    }
+    cv.notify_all();
+    return true;
+}
+
+bool GraphExecutor::acceptAcquisition(Graph::NodeId input) {
+    long long acquisition = nodes[input].nReceivedAcquisitions++;
+    if (acquisition == firstPendingAcquisition + (long long) pendingAcquisitions.size()) {
+        // The first input that received this acquisition decides for all the buffer-fed inputs. Each input should
+        // have a free slot for the next frame and should not be queueSize frames behind (its own next frames would
+        // occupy that slot then).
+        const long long frame = nextAcquisitionFrame;
+        bool isAccepted = std::all_of(std::begin(bufferFedInputs), std::end(bufferFedInputs), [&, this](auto id) {
+            const auto &node = nodes[id];
+            return node.nextFrame > frame - (long long) queueSize
+                   && node.slots[frame % queueSize].nPendingConsumers == 0;
+        });
+        pendingAcquisitions.push_back(isAccepted);
+        if (isAccepted) {
+            ++nextAcquisitionFrame;
+        }
+    }
+    bool isAccepted = pendingAcquisitions.at(acquisition - firstPendingAcquisition);
+    // Forget the acquisitions already received by all the buffer-fed inputs.
+    while (!pendingAcquisitions.empty()
+           && std::all_of(std::begin(bufferFedInputs), std::end(bufferFedInputs), [this](auto id) {
+                  return nodes[id].nReceivedAcquisitions > firstPendingAcquisition;
+              })) {
+        pendingAcquisitions.pop_front();
+        ++firstPendingAcquisition;
+    }
+    return isAccepted;
+}
+
+bool GraphExecutor::push(Graph::NodeId input, const BufferElement::SharedHandle &element) {
+    return push(input, element->getData(), [element]() { element->release(); });
+}
+
+bool GraphExecutor::tryPush(Graph::NodeId input, const BufferElement::SharedHandle &element) {
+    return tryPush(input, element->getData(), [element]() { element->release(); });
+}
+
+size_t GraphExecutor::getNumberOfDroppedFrames(Graph::NodeId input) const {
+    if (!graph.isInput(input)) {
+        throw IllegalArgumentException(format("Node {} is not a graph input.", graph.getNode(input).name));
+    }
+    std::unique_lock<std::mutex> lock{mutex};
+    return nodes.at(input).nDroppedFrames;
+}
+
+std::vector<NodeStatistics> GraphExecutor::getStatistics() const {
+    std::unique_lock<std::mutex> lock{mutex};
+    std::vector<NodeStatistics> result;
+    for (Graph::NodeId id = 0; id < nodes.size(); ++id) {
+        if (!graph.isInput(id)) {
+            result.push_back(nodes[id].statistics);
+        }
+    }
+    return result;
+}
+
+bool GraphExecutor::isInputReady(const NodeState &input, long long frame) const {
+    return input.slots[frame % queueSize].frame == frame;
+}
+
+std::vector<GraphExecutor::ReleaseFunction> GraphExecutor::releaseInputs(Graph::NodeId id, long long frame) {
+    std::vector<ReleaseFunction> result;
+    for (auto input : graph.getNode(id).inputs) {
+        auto &slot = nodes[input].slots[frame % queueSize];
+        --slot.nPendingConsumers;
+        if (slot.nPendingConsumers == 0 && slot.release) {
+            result.push_back(std::move(slot.release));
+            slot.release = nullptr;
+        }
+    }
+    return result;
+}
+
+void GraphExecutor::runNode(Graph::NodeId id) {
+    const auto &def = graph.getNode(id);
+    auto &node = nodes[id];
+    if (def.cpuAffinity.has_value() && !setCurrentThreadAffinity(def.cpuAffinity.value())) {
+        logger->log(LogSeverity::WARNING,
+                    format("Node {}: could not set thread affinity to CPU {}.", def.name, def.cpuAffinity.value()));
+    }
+    std::vector<const NdArray *> inputs(def.inputs.size());
+    while (true) {
+        long long frame = 0;
+        Slot *output = nullptr;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            frame = node.nextFrame;
+            output = &node.slots[frame % queueSize];
+            cv.wait(lock, [&, this]() {
+                if (!isRunning) {
+                    return true;
+                }
+                if (output->nPendingConsumers > 0) {
+                    return false;
+                }
+                return std::all_of(std::begin(def.inputs), std::end(def.inputs),
+                                   [&, this](auto input) { return isInputReady(nodes[input], frame); });
+            });
+            if (!isRunning) {
+                return;
+            }
+            for (size_t i = 0; i < def.inputs.size(); ++i) {
+                inputs[i] = &nodes[def.inputs[i]].slots[frame % queueSize].array;
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        try {
+            def.node->process(inputs, output->array);
+            for (auto &callback : node.outputCallbacks) {
+                callback(output->array);
+            }
+        } catch (const std::exception &e) {
+            logger->log(LogSeverity::ERROR,
+                        format("Node {}: exception while processing frame {}: {}, stopping the graph executor.",
+                               def.name, frame, e.what()));
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                isRunning = false;
+            }
+            cv.notify_all();
+            return;
+        }
+        auto end = std::chrono::steady_clock::now();
+        double time = std::chrono::duration<double>(end - start).count();
+        std::vector<ReleaseFunction> toRelease;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            auto &stats = node.statistics;
+            ++stats.nFrames;
+            stats.totalTime += time;
+            stats.minTime = std::min(stats.minTime, time);
+            stats.maxTime = std::max(stats.maxTime, time);
+            output->frame = frame;
+            output->nPendingConsumers = node.consumers.size();
+            ++node.nextFrame;
+            toRelease = releaseInputs(id, frame);
+        }
+        cv.notify_all();
+        for (auto &release : toRelease) {
+            release();
+        }
+    }
+}
+
+}// namespace arrus::framework::graph
@@ -0,0 +1,202 @@
+#ifndef ARRUS_CORE_FRAMEWORK_GRAPH_GRAPHEXECUTOR_H
+#define ARRUS_CORE_FRAMEWORK_GRAPH_GRAPHEXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "arrus/core/framework/graph/Graph.h"
+#include "arrus/core/api/common/Logger.h"
+#include "arrus/core/api/framework/DataBuffer.h"
+
+namespace arrus::framework::graph {
+
+/**
+ * Processing time statistics of a single graph node.
+ */
+struct NodeStatistics {
+    std::string name;
+    /** The number of processed frames. */
+    size_t nFrames{0};
+    /** Processing times [s]. */
+    double totalTime{0.0};
+    double minTime{std::numeric_limits<double>::max()};
+    double maxTime{0.0};
+
+    double getMeanTime() const { return nFrames > 0 ? totalTime / (double) nFrames : 0.0; }
+};
+
+/**
+ * Pipelined executor of the graph.
+ *
+ * Each operator node runs in its own thread and writes to its own, pre-allocated ring of output arrays
+ * (queueSize arrays per node). A node can process frame n as soon as all its inputs produced frame n and all
+ * consumers of its output are done with frame n - queueSize. This way the stage k can process frame n while
+ * the stage k+1 processes frame n-1.
+ *
+ * The graph inputs are fed with the push methods (or directly from a data buffer, see connect). The input arrays are
+ * NOT copied: the provided release function is called when all the consumers of the given array are done with it.
+ * The push method blocks when all queueSize input slots are occupied, the tryPush method drops the array then.
+ *
+ * All the methods that modify the state of the executor (start, stop, push) are thread-safe.
+ */
+class GraphExecutor {
+public:
+    using OutputCallback = std::function<void(const NdArray &)>;
+    using ReleaseFunction = std::function<void()>;
+
+    /**
+     * Prepares all the nodes of the given graph and allocates their output arrays.
+     *
+     * @param graph graph to execute
+     * @param queueSize the number of arrays in the ring buffer of each node
+     */
+    explicit GraphExecutor(Graph graph, size_t queueSize = 2);
+
+    ~GraphExecutor();
+
+    GraphExecutor(GraphExecutor const &) = delete;
+    GraphExecutor(GraphExecutor const &&) = delete;
+    void operator=(GraphExecutor const &) = delete;
+    void operator=(GraphExecutor const &&) = delete;
+
+    /**
+     * Registers a callback that will be called (in the node thread) for each output array of the given node.
+     * The array is valid only during the callback.
+     * NOTE: the callback should be registered before starting the executor.
+     */
+    void registerOutputCallback(Graph::NodeId node, OutputCallback callback);
+
+    /**
+     * Registers this executor as the consumer of the data produced to the given buffer (e.g. us4R output buffer or
+     * file buffer). Each buffer element is passed to the given graph input without copying (see tryPush), and
+     * released once it is no longer needed by the graph.
+     *
+     * The buffer callback is called in the data acquisition thread, so it never blocks: when the graph is not ready
+     * to take a new element (all the input slots are occupied), the element is released immediately and counted
+     * as dropped (see getNumberOfDroppedFrames). The frames are dropped for all the buffer-fed inputs at once: the
+     * i-th element delivered to each of the connected buffers belongs to the i-th acquisition, and the first input
+     * that receives the acquisition decides for all of them (the acquisition is dropped if any of the inputs is not
+     * ready). This way the buffer-fed inputs stay in lockstep, i.e. the graph never combines the frames of
+     * different acquisitions.
+     */
+    void connect(Graph::NodeId input, DataBuffer &buffer);
+
+    void start();
+
+    /**
+     * Stops all the node threads; all input arrays not processed yet are released.
+     */
+    void stop();
+
+    /**
+     * Pushes the next array to the given graph input.
+     *
+     * @param input graph input
+     * @param array array to push; the data should remain valid until the release function is called
+     * @param release function to call when the array is no longer needed by the graph
+     * @return false if the executor was stopped (in that case the release function is called immediately)
+     */
+    bool push(Graph::NodeId input, const NdArray &array, const ReleaseFunction &release = [](){});
+
+    /**
+     * Pushes the given buffer element to the given graph input; the element is released when it's no longer needed.
+     */
+    bool push(Graph::NodeId input, const BufferElement::SharedHandle &element);
+
+    /**
+     * Pushes the next array to the given graph input, if there is a free input slot; never blocks.
+     * Otherwise the array is dropped: the release function is called immediately and the frame is counted
+     * as dropped (see getNumberOfDroppedFrames).
+     *
+     * @return true if the array was pushed, false if it was dropped or the executor was stopped
+     */
+    bool tryPush(Graph::NodeId input, const NdArray &array, const ReleaseFunction &release = [](){});
+
+    /**
+     * Non-blocking version of push(input, element), see tryPush.
+     */
+    bool tryPush(Graph::NodeId input, const BufferElement::SharedHandle &element);
+
+    /**
+     * Returns the number of arrays dropped by tryPush (or by the connected buffer callback) for the given graph input
+     * since the executor start.
+     */
+    size_t getNumberOfDroppedFrames(Graph::NodeId input) const;
+
+    /**
+     * Returns processing time statistics of all the graph operator nodes, in the graph order.
+     */
+    std::vector<NodeStatistics> getStatistics() const;
+
+    /**
+     * Returns the definition of the array produced by the given node.
+     */
+    const ArrayDef &getOutputDef(Graph::NodeId node) const { return nodes.at(node).outputDef.value(); }
+
+    const Graph &getGraph() const { return graph; }
+
+private:
+    /**
+     * A single element of the node ring buffer.
+     */
+    struct Slot {
+        NdArray array;
+        /** The number of frame currently stored in this slot, -1 means no frame. */
+        long long frame{-1};
+        /** The number of consumers that haven't processed the frame yet. */
+        size_t nPendingConsumers{0};
+        /** Graph inputs only: releases the input array. */
+        ReleaseFunction release;
+    };
+
+    struct NodeState {
+        std::optional<ArrayDef> outputDef;
+        std::vector<Slot> slots;
+        std::vector<Graph::NodeId> consumers;
+        /** The number of the next frame to be produced by this node. */
+        long long nextFrame{0};
+        std::vector<OutputCallback> outputCallbacks;
+        NodeStatistics statistics;
+        /** Graph inputs only: the number of arrays dropped by tryPush. */
+        size_t nDroppedFrames{0};
+        /** Buffer-fed inputs only: the number of acquisitions (buffer elements) received so far. */
+        long long nReceivedAcquisitions{0};
+    };
+
+    bool pushArray(Graph::NodeId input, const NdArray &array, const ReleaseFunction &release, bool isBlocking);
+    /**
+     * Registers the next acquisition received by the given buffer-fed input; returns false if the acquisition
+     * should be dropped (by all the buffer-fed inputs). Should be called with the mutex locked.
+     */
+    bool acceptAcquisition(Graph::NodeId input);
+    void runNode(Graph::NodeId id);
+    bool isInputReady(const NodeState &input, long long frame) const;
+    std::vector<ReleaseFunction> releaseInputs(Graph::NodeId id, long long frame);
+
+    Logger::Handle logger;
+    Graph graph;
+    size_t queueSize;
+    std::vector<NodeState> nodes;
+    std::vector<std::thread> threads;
+    std::unordered_map<Graph::NodeId, OnNewDataCallback> bufferCallbacks;
+    std::vector<Graph::NodeId> bufferFedInputs;
+    /** Whether the acquisitions [firstPendingAcquisition, ...) were accepted; forgotten once received by all inputs. */
+    std::deque<bool> pendingAcquisitions;
+    long long firstPendingAcquisition{0};
+    /** The graph frame number of the next accepted acquisition. */
+    long long nextAcquisitionFrame{0};
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    bool isRunning{false};
+};
+
+}// namespace arrus::framework::graph
+
+#endif//ARRUS_CORE_FRAMEWORK_GRAPH_GRAPHEXECUTOR_H
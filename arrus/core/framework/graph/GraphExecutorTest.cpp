@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GraphExecutor.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::framework;
+using namespace arrus::framework::graph;
+
+const NdArray::Shape SHAPE{4, 8};
+const ArrayDef INPUT_DEF{SHAPE, NdArray::DataType::FLOAT32};
+
+/** Returns a node that adds the given value to the (single) input. */
+Node::Handle getAddNode(float value) {
+    return std::make_unique<FunctionNode>(
+        [](const std::vector<ArrayDef> &inputs) { return inputs.at(0); },
+        [value](const std::vector<const NdArray *> &inputs, NdArray &output) {
+            auto *in = inputs.at(0)->get<float>();
+            auto *out = output.get<float>();
+            for (size_t i = 0; i < output.getNumberOfElements(); ++i) {
+                out[i] = in[i] + value;
+            }
+        });
+}
+
+/** Returns a node that sums all the inputs. */
+Node::Handle getSumNode() {
+    return std::make_unique<FunctionNode>(
+        [](const std::vector<ArrayDef> &inputs) {
+            for (auto &def : inputs) {
+                if (def != inputs.at(0)) {
+                    throw IllegalArgumentException("All inputs should have the same definition.");
+                }
+            }
+            return inputs.at(0);
+        },
+        [](const std::vector<const NdArray *> &inputs, NdArray &output) {
+            auto *out = output.get<float>();
+            for (size_t i = 0; i < output.getNumberOfElements(); ++i) {
+                out[i] = 0.0f;
+                for (auto input : inputs) {
+                    out[i] += input->get<float>()[i];
+                }
+            }
+        });
+}
+
+/** Collects the first value of each output array. */
+class OutputCollector {
+public:
+    void operator()(const NdArray &array) {
+        std::unique_lock<std::mutex> lock{mutex};
+        values.push_back(array.get<float>()[0]);
+        cv.notify_all();
+    }
+
+    std::vector<float> waitFor(size_t n) {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv.wait(lock, [&]() { return values.size() >= n; });
+        return values;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<float> values;
+};
+
+TEST(GraphExecutorTest, ProcessesFramesInOrder) {
+    Graph graph;
+    auto input = graph.addInput("input", INPUT_DEF);
+    auto add1 = graph.addNode("add1", getAddNode(1.0f), {input});
+    auto add2 = graph.addNode("add2", getAddNode(2.0f), {add1});
+    GraphExecutor executor{std::move(graph), 2};
+    OutputCollector collector;
+    executor.registerOutputCallback(add2, std::ref(collector));
+    executor.start();
+
+    const size_t nFrames = 10;
+    std::vector<NdArray> frames;
+    for (size_t i = 0; i < nFrames; ++i) {
+        frames.emplace_back(SHAPE, NdArray::DataType::FLOAT32, devices::DeviceId(devices::DeviceType::CPU, 0), "");
+        frames.back().get<float>()[0] = (float) i;
+    }
+    std::atomic<size_t> nReleased{0};
+    for (auto &frame : frames) {
+        ASSERT_TRUE(executor.push(input, frame, [&nReleased]() { ++nReleased; }));
+    }
+    auto values = collector.waitFor(nFrames);
+    executor.stop();
+
+    ASSERT_EQ(values.size(), nFrames);
+    for (size_t i = 0; i < nFrames; ++i) {
+        EXPECT_FLOAT_EQ(values[i], (float) i + 3.0f);
+    }
+    EXPECT_EQ(nReleased, nFrames);
+    auto stats = executor.getStatistics();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats[0].name, "add1");
+    EXPECT_EQ(stats[0].nFrames, nFrames);
+    EXPECT_EQ(stats[1].nFrames, nFrames);
+}
+
+TEST(GraphExecutorTest, JoinsBranches) {
+    Graph graph;
+    auto input = graph.addInput("input", INPUT_DEF);
+    auto add1 = graph.addNode("add1", getAddNode(1.0f), {input});
+    auto add2 = graph.addNode("add2", getAddNode(2.0f), {input});
+    auto sum = graph.addNode("sum", getSumNode(), {add1, add2, input});
+    GraphExecutor executor{std::move(graph), 3};
+    OutputCollector collector;
+    executor.registerOutputCallback(sum, std::ref(collector));
+    executor.start();
+
+    NdArray frame{SHAPE, NdArray::DataType::FLOAT32, devices::DeviceId(devices::DeviceType::CPU, 0), ""};
+    frame.get<float>()[0] = 1.0f;
+    std::atomic<size_t> nReleased{0};
+    for (int i = 0; i < 5; ++i) {
+        executor.push(input, frame, [&nReleased]() { ++nReleased; });
+    }
+    auto values = collector.waitFor(5);
+    executor.stop();
+    for (auto value : values) {
+        // (1+1) + (1+2) + 1
+        EXPECT_FLOAT_EQ(value, 6.0f);
+    }
+    EXPECT_EQ(nReleased, 5);
+}
+
+TEST(GraphExecutorTest, ThrowsOnUnknownInput) {
+    Graph graph;
+    graph.addInput("input", INPUT_DEF);
+    EXPECT_THROW(graph.addNode("add", getAddNode(1.0f), {1}), IllegalArgumentException);
+}
+
+TEST(GraphExecutorTest, ThrowsOnInvalidInputArray) {
+    Graph graph;
+    auto input = graph.addInput("input", INPUT_DEF);
+    graph.addNode("add", getAddNode(1.0f), {input});
+    GraphExecutor executor{std::move(graph)};
+    executor.start();
+    NdArray frame{NdArray::Shape{2, 2}, NdArray::DataType::FLOAT32, devices::DeviceId(devices::DeviceType::CPU, 0),
+                  ""};
+    EXPECT_THROW(executor.push(input, frame), IllegalArgumentException);
+}
+
+TEST(GraphExecutorTest, ReleasesInputsWhenStopped) {
+    Graph graph;
+    auto input = graph.addInput("input", INPUT_DEF);
+    std::mutex blockMutex;
+    std::unique_lock<std::mutex> block{blockMutex};
+    graph.addNode("blocked",
+                  std::make_unique<FunctionNode>(
+                      [](const std::vector<ArrayDef> &inputs) { return inputs.at(0); },
+                      [&blockMutex](const std::vector<const NdArray *> &, NdArray &) {
+                          std::unique_lock<std::mutex> lock{blockMutex};
+                      }),
+                  {input});
+    GraphExecutor executor{std::move(graph), 2};
+    executor.start();
+    NdArray frame{SHAPE, NdArray::DataType::FLOAT32, devices::DeviceId(devices::DeviceType::CPU, 0), ""};
+    std::atomic<size_t> nReleased{0};
+    executor.push(input, frame, [&nReleased]() { ++nReleased; });
+    executor.push(input, frame, [&nReleased]() { ++nReleased; });
+    block.unlock();
+    executor.stop();
+    EXPECT_EQ(nReleased, 2);
+}
+
+/** A buffer, which elements are produced by the test thread (i.e. the data acquisition thread). */
+class TestDataBuffer : public DataBuffer {
+public:
+    class Element : public BufferElement {
+    public:
+        explicit Element(size_t position)
+            : data(SHAPE, NdArray::DataType::FLOAT32, devices::DeviceId(devices::DeviceType::CPU, 0), ""),
+              position(position) {}
+        void release() override { ++nReleases; }
+        NdArray &getData() override { return data; }
+        size_t getSize() override { return data.getNumberOfBytes(); }
+        size_t getPosition() override { return position; }
+        State getState() const override { return State::READY; }
+
+        NdArray data;
+        size_t position;
+        std::atomic<size_t> nReleases{0};
+    };
+
+    explicit TestDataBuffer(size_t nElements) {
+        for (size_t i = 0; i < nElements; ++i) {
+            elements.push_back(std::make_shared<Element>(i));
+        }
+    }
+
+    void produce(size_t i) { callback(elements.at(i)); }
+
+    void registerOnNewDataCallback(OnNewDataCallback &cbk) override { callback = cbk; }
+    void registerOnOverflowCallback(OnOverflowCallback &) override {}
+    void registerShutdownCallback(OnShutdownCallback &) override {}
+    size_t getNumberOfElements() const override { return elements.size(); }
+    BufferElement::SharedHandle getElement(size_t i) override { return elements.at(i); }
+    size_t getElementSize() const override { return elements.at(0)->getSize(); }
+    size_t getNumberOfElementsInState(BufferElement::State) const override { return 0; }
+
+    std::vector<std::shared_ptr<Element>> elements;
+    OnNewDataCallback callback;
+};
+
+TEST(GraphExecutorTest, SlowNodeDoesNotBlockBufferProducer) {
+    Graph graph;
+    auto input = graph.addInput("input", INPUT_DEF);
+    std::mutex blockMutex;
+    std::unique_lock<std::mutex> block{blockMutex};
+    graph.addNode("slow",
+                  std::make_unique<FunctionNode>(
+                      [](const std::vector<ArrayDef> &inputs) { return inputs.at(0); },
+                      [&blockMutex](const std::vector<const NdArray *> &, NdArray &) {
+                          std::unique_lock<std::mutex> lock{blockMutex};
+                      }),
+                  {input});
+    GraphExecutor executor{std::move(graph), 2};
+    TestDataBuffer buffer{8};
+    executor.connect(input, buffer);
+    executor.start();
+
+    // The node is blocked: only the first queueSize elements can be taken, the rest should be dropped immediately.
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < buffer.elements.size(); ++i) {
+        buffer.produce(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+    EXPECT_EQ(executor.getNumberOfDroppedFrames(input), 6);
+    for (size_t i = 2; i < buffer.elements.size(); ++i) {
+        EXPECT_EQ(buffer.elements[i]->nReleases, 1);
+    }
+    EXPECT_EQ(buffer.elements[0]->nReleases, 0);
+    EXPECT_EQ(buffer.elements[1]->nReleases, 0);
+    block.unlock();
+    executor.stop();
+    EXPECT_EQ(buffer.elements[0]->nReleases, 1);
+    EXPECT_EQ(buffer.elements[1]->nReleases, 1);
+}
+
+TEST(GraphExecutorTest, DropsFramesOfAllBufferFedInputs) {
+    Graph graph;
+    auto inputA = graph.addInput("a", INPUT_DEF);
+    auto inputB = graph.addInput("b", INPUT_DEF);
+    // Processes the frames only when allowed by the test.
+    std::mutex gateMutex;
+    std::condition_variable gateCv;
+    size_t nAllowed = 0, nProcessed = 0;
+    auto gated = graph.addNode(
+        "gated",
+        std::make_unique<FunctionNode>(
+            [](const std::vector<ArrayDef> &inputs) { return inputs.at(0); },
+            [&](const std::vector<const NdArray *> &inputs, NdArray &output) {
+                std::unique_lock<std::mutex> lock{gateMutex};
+                gateCv.wait(lock, [&]() { return nProcessed < nAllowed; });
+                ++nProcessed;
+                output.get<float>()[0] = inputs.at(0)->get<float>()[0] + inputs.at(1)->get<float>()[0];
+            }),
+        {inputA, inputB});
+    GraphExecutor executor{std::move(graph), 2};
+    OutputCollector collector;
+    executor.registerOutputCallback(gated, std::ref(collector));
+    TestDataBuffer bufferA{4}, bufferB{4};
+    for (size_t i = 0; i < 4; ++i) {
+        bufferA.elements[i]->data.get<float>()[0] = (float) i;
+        bufferB.elements[i]->data.get<float>()[0] = 100.0f * (float) i;
+    }
+    executor.connect(inputA, bufferA);
+    executor.connect(inputB, bufferB);
+    executor.start();
+    auto allow = [&](size_t n) {
+        {
+            std::unique_lock<std::mutex> lock{gateMutex};
+            nAllowed += n;
+        }
+        gateCv.notify_all();
+    };
+
+    bufferA.produce(0);
+    bufferB.produce(0);
+    bufferA.produce(1);
+    bufferB.produce(1);
+    // All the input slots are occupied: the acquisition 2 is dropped.
+    bufferA.produce(2);
+    EXPECT_EQ(bufferA.elements[2]->nReleases, 1);
+    allow(1);
+    collector.waitFor(1);
+    while (bufferB.elements[0]->nReleases == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // The slot of b is free now, but the acquisition was already dropped by a.
+    bufferB.produce(2);
+    EXPECT_EQ(bufferB.elements[2]->nReleases, 1);
+    bufferA.produce(3);
+    bufferB.produce(3);
+    allow(2);
+    auto values = collector.waitFor(3);
+    executor.stop();
+
+    EXPECT_EQ(values, (std::vector<float>{0.0f, 101.0f, 303.0f}));
+    EXPECT_EQ(executor.getNumberOfDroppedFrames(inputA), 1);
+    EXPECT_EQ(executor.getNumberOfDroppedFrames(inputB), 1);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
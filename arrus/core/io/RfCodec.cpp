@@ -0,0 +1,307 @@
+#include "arrus/core/io/RfCodec.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "arrus/common/format.h"
+#include "arrus/core/api/common/exceptions.h"
+
+namespace arrus::io {
+
+namespace {
+
+constexpr char MAGIC[8] = {'A', 'R', 'R', 'U', 'S', '_', 'R', 'F'};
+/** The minimum number of values of a single chunk (smaller frames are encoded in a single chunk). */
+constexpr size_t MIN_CHUNK_SIZE = 1 << 16;
+
+inline uint16 zigzag(int16 value) {
+    return static_cast<uint16>((static_cast<uint16>(value) << 1) ^ static_cast<uint16>(value >> 15));
+}
+
+inline int16 unzigzag(uint16 value) {
+    return static_cast<int16>((value >> 1) ^ static_cast<uint16>(-(int16)(value & 1)));
+}
+
+/** Residuals modulo 2^16. */
+inline int16 subtract(int16 a, int32 b) {
+    return static_cast<int16>(static_cast<uint16>(static_cast<uint16>(a) - static_cast<uint16>(b)));
+}
+
+inline int16 add(int32 a, int16 b) {
+    return static_cast<int16>(static_cast<uint16>(static_cast<uint16>(a) + static_cast<uint16>(b)));
+}
+
+template<typename T> void writeValue(std::ostream &output, T value) {
+    char bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<char>(static_cast<uint64>(value) >> (8 * i));
+    }
+    output.write(bytes, sizeof(T));
+}
+
+template<typename T> T readValue(std::istream &input) {
+    unsigned char bytes[sizeof(T)];
+    input.read(reinterpret_cast<char *>(bytes), sizeof(T));
+    if (input.gcount() != (std::streamsize) sizeof(T)) {
+        throw ArrusException("Unexpected end of the RF recording, the file is truncated or corrupted.");
+    }
+    uint64 value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64>(bytes[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+}// namespace
+
+size_t RfCodec::getMaxEncodedSize(size_t nValues) {
+    const size_t nBlocks = (nValues + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    return nBlocks + nValues * sizeof(int16);
+}
+
+size_t RfCodec::encode(const int16 *input, size_t nValues, size_t sampleStride, uint8 *output) {
+    const size_t s = sampleStride, s2 = 2 * sampleStride;
+    uint16 residuals[3][BLOCK_SIZE];
+    uint8 *out = output;
+    for (size_t begin = 0; begin < nValues; begin += BLOCK_SIZE) {
+        const size_t n = std::min(BLOCK_SIZE, nValues - begin);
+        const int16 *x = input + begin;
+        uint16 bits[3] = {0, 0, 0};
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = begin + j;
+            const int32 x1 = i >= s ? x[(ptrdiff_t) j - (ptrdiff_t) s] : 0;
+            const int32 x2 = i >= s2 ? x[(ptrdiff_t) j - (ptrdiff_t) s2] : x1;
+            const uint16 r0 = zigzag(x[j]);
+            const uint16 r1 = zigzag(subtract(x[j], x1));
+            const uint16 r2 = zigzag(subtract(x[j], 2 * x1 - x2));
+            residuals[0][j] = r0;
+            residuals[1][j] = r1;
+            residuals[2][j] = r2;
+            bits[0] |= r0;
+            bits[1] |= r1;
+            bits[2] |= r2;
+        }
+        // Select the predictor with the smallest bit width (the simplest one, if equal).
+        size_t predictor = 0;
+        unsigned width = MAX_BIT_WIDTH + 1;
+        for (size_t p = 0; p < 3; ++p) {
+            unsigned w = 0;
+            while (w < MAX_BIT_WIDTH && (bits[p] >> w) != 0) {
+                ++w;
+            }
+            if (w < width) {
+                width = w;
+                predictor = p;
+            }
+        }
+        *out++ = static_cast<uint8>((predictor << 5) | width);
+        if (width == 0) {
+            continue;
+        }
+        const uint16 *r = residuals[predictor];
+        uint64 buffer = 0;
+        unsigned nBits = 0;
+        for (size_t j = 0; j < n; ++j) {
+            buffer |= static_cast<uint64>(r[j]) << nBits;
+            nBits += width;
+            if (nBits >= 32) {
+                out[0] = static_cast<uint8>(buffer);
+                out[1] = static_cast<uint8>(buffer >> 8);
+                out[2] = static_cast<uint8>(buffer >> 16);
+                out[3] = static_cast<uint8>(buffer >> 24);
+                out += 4;
+                buffer >>= 32;
+                nBits -= 32;
+            }
+        }
+        for (; nBits > 0; nBits = nBits > 8 ? nBits - 8 : 0) {
+            *out++ = static_cast<uint8>(buffer);
+            buffer >>= 8;
+        }
+    }
+    return out - output;
+}
+
+void RfCodec::decode(const uint8 *input, size_t nBytes, size_t nValues, size_t sampleStride, int16 *output) {
+    const size_t s = sampleStride, s2 = 2 * sampleStride;
+    const uint8 *in = input, *end = input + nBytes;
+    uint16 residuals[BLOCK_SIZE];
+    for (size_t begin = 0; begin < nValues; begin += BLOCK_SIZE) {
+        const size_t n = std::min(BLOCK_SIZE, nValues - begin);
+        if (in == end) {
+            throw ArrusException("Corrupted RF data: unexpected end of the chunk.");
+        }
+        const uint8 predictor = *in >> 5;
+        const unsigned width = *in & 0x1F;
+        ++in;
+        if (predictor > static_cast<uint8>(Predictor::LINEAR) || width > MAX_BIT_WIDTH) {
+            throw ArrusException(format("Corrupted RF data: invalid block header (predictor: {}, bit width: {}).",
+                                        predictor, width));
+        }
+        if ((size_t) (end - in) < (n * width + 7) / 8) {
+            throw ArrusException("Corrupted RF data: unexpected end of the chunk.");
+        }
+        if (width == 0) {
+            std::fill(residuals, residuals + n, 0);
+        } else {
+            const uint64 mask = (1ull << width) - 1;
+            uint64 buffer = 0;
+            unsigned nBits = 0;
+            for (size_t j = 0; j < n; ++j) {
+                while (nBits < width) {
+                    buffer |= static_cast<uint64>(*in++) << nBits;
+                    nBits += 8;
+                }
+                residuals[j] = static_cast<uint16>(buffer & mask);
+                buffer >>= width;
+                nBits -= width;
+            }
+        }
+        int16 *x = output + begin;
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = begin + j;
+            const int16 r = unzigzag(residuals[j]);
+            if (predictor == static_cast<uint8>(Predictor::NONE)) {
+                x[j] = r;
+                continue;
+            }
+            const int32 x1 = i >= s ? x[(ptrdiff_t) j - (ptrdiff_t) s] : 0;
+            if (predictor == static_cast<uint8>(Predictor::DELTA)) {
+                x[j] = add(x1, r);
+            } else {
+                const int32 x2 = i >= s2 ? x[(ptrdiff_t) j - (ptrdiff_t) s2] : x1;
+                x[j] = add(2 * x1 - x2, r);
+            }
+        }
+    }
+    if (in != end) {
+        throw ArrusException(format("Corrupted RF data: {} unexpected bytes at the end of the chunk.", end - in));
+    }
+}
+
+void writeRfRecordingHeader(std::ostream &output, const RfRecordingHeader &header) {
+    output.write(MAGIC, sizeof(MAGIC));
+    writeValue<uint32>(output, RfRecordingHeader::VERSION);
+    writeValue<uint32>(output, static_cast<uint32>(header.sampleStride));
+    writeValue<uint32>(output, static_cast<uint32>(header.shape.size()));
+    for (size_t i = 0; i < header.shape.size(); ++i) {
+        writeValue<uint64>(output, header.shape[i]);
+    }
+}
+
+std::optional<RfRecordingHeader> readRfRecordingHeader(std::istream &input) {
+    const auto position = input.tellg();
+    char magic[sizeof(MAGIC)];
+    input.read(magic, sizeof(magic));
+    if (input.gcount() != (std::streamsize) sizeof(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        input.clear();
+        input.seekg(position);
+        return std::nullopt;
+    }
+    auto version = readValue<uint32>(input);
+    if (version != RfRecordingHeader::VERSION) {
+        throw ArrusException(format("Unsupported RF recording version: {}.", version));
+    }
+    RfRecordingHeader header;
+    header.sampleStride = readValue<uint32>(input);
+    if (header.sampleStride == 0) {
+        throw ArrusException("Corrupted RF recording: sample stride should be positive.");
+    }
+    auto ndim = readValue<uint32>(input);
+    std::vector<size_t> shape;
+    for (uint32 i = 0; i < ndim; ++i) {
+        shape.push_back(static_cast<size_t>(readValue<uint64>(input)));
+    }
+    header.shape = framework::NdArray::Shape{shape};
+    return header;
+}
+
+std::vector<std::vector<int16>> readRfFrames(std::istream &input, const RfRecordingHeader &header,
+                                             unsigned nThreads) {
+    const size_t frameSize = header.shape.product();
+    std::vector<std::vector<int16>> frames;
+    std::vector<uint8> payload;
+    while (input.peek() != std::char_traits<char>::eof()) {
+        auto nChunks = readValue<uint32>(input);
+        std::vector<size_t> chunkOffsets, byteOffsets;
+        size_t nValues = 0, nBytes = 0;
+        for (uint32 i = 0; i < nChunks; ++i) {
+            chunkOffsets.push_back(nValues);
+            byteOffsets.push_back(nBytes);
+            nValues += static_cast<size_t>(readValue<uint64>(input));
+            nBytes += static_cast<size_t>(readValue<uint64>(input));
+        }
+        chunkOffsets.push_back(nValues);
+        byteOffsets.push_back(nBytes);
+        if (nValues != frameSize) {
+            throw ArrusException(format("Corrupted RF recording: frame {} has {} values, expected: {}.",
+                                        frames.size(), nValues, frameSize));
+        }
+        payload.resize(nBytes);
+        input.read(reinterpret_cast<char *>(payload.data()), (std::streamsize) nBytes);
+        if (input.gcount() != (std::streamsize) nBytes) {
+            throw ArrusException("Unexpected end of the RF recording, the file is truncated or corrupted.");
+        }
+        std::vector<int16> frame(frameSize);
+        runRfTasks(nChunks, nThreads, [&](size_t i) {
+            RfCodec::decode(payload.data() + byteOffsets[i], byteOffsets[i + 1] - byteOffsets[i],
+                            chunkOffsets[i + 1] - chunkOffsets[i], header.sampleStride,
+                            frame.data() + chunkOffsets[i]);
+        });
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+size_t getRfChunkSize(size_t frameSize, size_t sampleStride, unsigned nThreads) {
+    const size_t alignment = RfCodec::BLOCK_SIZE * sampleStride;
+    size_t chunkSize = std::max(MIN_CHUNK_SIZE, (frameSize + nThreads - 1) / nThreads);
+    chunkSize = (chunkSize + alignment - 1) / alignment * alignment;
+    return std::min(chunkSize, std::max<size_t>(frameSize, 1));
+}
+
+void runRfTasks(size_t nTasks, unsigned nThreads, const std::function<void(size_t)> &func) {
+    const size_t nWorkers = std::min<size_t>(getRfNumberOfThreads(nThreads), nTasks);
+    if (nWorkers <= 1) {
+        for (size_t i = 0; i < nTasks; ++i) {
+            func(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < nTasks; i = next++) {
+            try {
+                func(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < nWorkers; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto &w : workers) {
+        w.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+unsigned getRfNumberOfThreads(unsigned nThreads) {
+    return nThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : nThreads;
+}
+
+}// namespace arrus::io
@@ -0,0 +1,107 @@
+#ifndef ARRUS_CORE_IO_RFCODEC_H
+#define ARRUS_CORE_IO_RFCODEC_H
+
+#include <functional>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/framework/NdArray.h"
+
+namespace arrus::io {
+
+/**
+ * Lossless codec of the int16 RF data (see RfRecorder).
+ *
+ * The encoded chunk is a sequence of blocks of BLOCK_SIZE values (the last one can be shorter). Each block
+ * starts with a single byte: predictor (3 MSBs) and bit width (5 LSBs), followed by the bit-packed
+ * (LSB first) zigzag-encoded prediction residuals. The predictors:
+ * - NONE: 0,
+ * - DELTA: x[i-s],
+ * - LINEAR: 2*x[i-s]-x[i-2s],
+ * where s is the sample stride; x[i-s] and x[i-2s] are the previous samples of the same channel in the chunk
+ * (LINEAR falls back to DELTA for the first sample, DELTA falls back to 0 for the first sample). The residuals are
+ * computed modulo 2^16, so a block never requires more than 16 bits per value.
+ */
+class RfCodec {
+public:
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t MAX_BIT_WIDTH = 16;
+
+    enum class Predictor : uint8 { NONE = 0, DELTA = 1, LINEAR = 2 };
+
+    /**
+     * Returns the maximum number of bytes of the encoded chunk of the given number of values.
+     */
+    static size_t getMaxEncodedSize(size_t nValues);
+
+    /**
+     * Encodes the given chunk.
+     *
+     * @param output output memory, should have at least getMaxEncodedSize(nValues) bytes
+     * @return the number of bytes written to the output
+     */
+    static size_t encode(const int16 *input, size_t nValues, size_t sampleStride, uint8 *output);
+
+    /**
+     * Decodes the given chunk.
+     *
+     * @throws ArrusException when the input data is corrupted
+     */
+    static void decode(const uint8 *input, size_t nBytes, size_t nValues, size_t sampleStride, int16 *output);
+};
+
+/**
+ * RF recording file format (all numbers little-endian):
+ * - header: magic "ARRUS_RF" (8 bytes), version (uint32), sample stride (uint32), ndim (uint32),
+ *   frame shape (ndim x uint64),
+ * - frames, each: nChunks (uint32), nChunks x (nValues (uint64), nBytes (uint64)), encoded chunks.
+ */
+struct RfRecordingHeader {
+    static constexpr uint32 VERSION = 1;
+
+    size_t sampleStride;
+    framework::NdArray::Shape shape;
+};
+
+void writeRfRecordingHeader(std::ostream &output, const RfRecordingHeader &header);
+
+/**
+ * Reads the recording header from the current stream position. Returns std::nullopt (and restores the stream
+ * position) if the stream does not start with the recording magic.
+ *
+ * @throws ArrusException when the header is corrupted or the recording version is not supported
+ */
+std::optional<RfRecordingHeader> readRfRecordingHeader(std::istream &input);
+
+/**
+ * Reads and decodes all the remaining frames of the recording.
+ *
+ * @throws ArrusException when the recording is corrupted or truncated
+ */
+std::vector<std::vector<int16>> readRfFrames(std::istream &input, const RfRecordingHeader &header,
+                                             unsigned nThreads);
+
+/**
+ * Returns the number of values of the chunks the frame of the given size should be split into.
+ * Chunks start at the channel 0, so the previous samples of the first values of each channel are available.
+ */
+size_t getRfChunkSize(size_t frameSize, size_t sampleStride, unsigned nThreads);
+
+/**
+ * Runs func(i) for i = 0, ..., nTasks-1 on up to nThreads threads (the calling thread included).
+ * The first exception thrown by func is rethrown after all the tasks are done.
+ */
+void runRfTasks(size_t nTasks, unsigned nThreads, const std::function<void(size_t)> &func);
+
+/**
+ * Returns the given number of threads, or the number of hardware threads if nThreads == 0.
+ */
+unsigned getRfNumberOfThreads(unsigned nThreads);
+
+}// namespace arrus::io
+
+#endif//ARRUS_CORE_IO_RFCODEC_H
@@ -0,0 +1,84 @@
+/**
+ * Measures the RF codec encoding and decoding throughput (us4R element layout: (nSamples, 32)),
+ * single and multiple threads.
+ *
+ * Usage: io_RfCodecBenchmark [nSamples] [nRepeats] [nThreads]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arrus/core/io/RfCodec.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::io;
+
+constexpr size_t N_CHANNELS = 32;
+
+template<typename F> double measure(F &&func, size_t nRepeats) {
+    func();// warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRepeats; ++i) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / (double) nRepeats;
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    size_t nSamples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096 * 64;
+    size_t nRepeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+    unsigned nThreads = argc > 3 ? (unsigned) std::strtoul(argv[3], nullptr, 10) : 0;
+
+    // Echo decaying with depth + noise.
+    std::mt19937 generator{2023};
+    std::normal_distribution<float> noise{0.0f, 8.0f};
+    std::vector<int16> frame(nSamples * N_CHANNELS);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        const auto sample = (float) ((i / N_CHANNELS) % 4096);
+        const float amplitude = 2000.0f * std::exp(-sample / 1000.0f);
+        frame[i] = (int16) std::lround(amplitude * std::sin(0.48f * sample) + noise(generator));
+    }
+    const double nBytes = (double) (frame.size() * sizeof(int16));
+    std::cout << "Frame size: " << nBytes / (1 << 20) << " MiB" << std::endl;
+    for (unsigned threads : {1u, nThreads}) {
+        const unsigned n = getRfNumberOfThreads(threads);
+        const size_t chunkSize = getRfChunkSize(frame.size(), N_CHANNELS, n);
+        const size_t nChunks = (frame.size() + chunkSize - 1) / chunkSize;
+        std::vector<std::vector<uint8>> encoded(nChunks);
+        std::vector<size_t> encodedSizes(nChunks);
+        std::vector<int16> decoded(frame.size());
+        auto chunkLength = [&](size_t i) { return std::min(chunkSize, frame.size() - i * chunkSize); };
+        double encodeTime = measure([&]() {
+            runRfTasks(nChunks, n, [&](size_t i) {
+                encoded[i].resize(RfCodec::getMaxEncodedSize(chunkLength(i)));
+                encodedSizes[i] = RfCodec::encode(frame.data() + i * chunkSize, chunkLength(i), N_CHANNELS,
+                                                  encoded[i].data());
+            });
+        }, nRepeats);
+        double decodeTime = measure([&]() {
+            runRfTasks(nChunks, n, [&](size_t i) {
+                RfCodec::decode(encoded[i].data(), encodedSizes[i], chunkLength(i), N_CHANNELS,
+                                decoded.data() + i * chunkSize);
+            });
+        }, nRepeats);
+        size_t totalSize = 0;
+        for (auto size : encodedSizes) {
+            totalSize += size;
+        }
+        std::cout << "threads: " << (threads == 0 ? "all" : std::to_string(threads))
+                  << ", ratio: " << nBytes / (double) totalSize
+                  << ", encode: " << nBytes / encodeTime / (1 << 20) << " MiB/s"
+                  << ", decode: " << nBytes / decodeTime / (1 << 20) << " MiB/s"
+                  << (decoded == frame ? "" : " (DECODING ERROR)") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/api/io/RfRecorder.h"
+#include "arrus/core/common/logging.h"
+#include "arrus/core/io/RfCodec.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::io;
+using namespace arrus::framework;
+
+constexpr size_t N_CHANNELS = 32;
+
+std::vector<int16> getRandom(size_t size, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> distribution{std::numeric_limits<int16>::min(),
+                                                    std::numeric_limits<int16>::max()};
+    std::vector<int16> result(size);
+    for (auto &value : result) {
+        value = (int16) distribution(generator);
+    }
+    return result;
+}
+
+/** Low-amplitude, oversampled RF-like signal: (nSamples, N_CHANNELS). */
+std::vector<int16> getRf(size_t nSamples, unsigned seed) {
+    std::mt19937 generator{seed};
+    std::normal_distribution<float> noise{0.0f, 2.0f};
+    std::vector<int16> result(nSamples * N_CHANNELS);
+    for (size_t sample = 0; sample < nSamples; ++sample) {
+        for (size_t channel = 0; channel < N_CHANNELS; ++channel) {
+            float value = 500.0f * std::sin(2.0f * 3.14159f * 5e6f / 65e6f * (float) sample + (float) channel);
+            result[sample * N_CHANNELS + channel] = (int16) std::lround(value + noise(generator));
+        }
+    }
+    return result;
+}
+
+std::vector<int16> roundTrip(const std::vector<int16> &input, size_t sampleStride, size_t *nBytes = nullptr) {
+    std::vector<uint8> encoded(RfCodec::getMaxEncodedSize(input.size()));
+    size_t size = RfCodec::encode(input.data(), input.size(), sampleStride, encoded.data());
+    EXPECT_LE(size, encoded.size());
+    std::vector<int16> output(input.size());
+    RfCodec::decode(encoded.data(), size, input.size(), sampleStride, output.data());
+    if (nBytes != nullptr) {
+        *nBytes = size;
+    }
+    return output;
+}
+
+class RfRecordingTest : public ::testing::Test {
+protected:
+    void TearDown() override { std::remove(filepath.c_str()); }
+
+    std::string filepath{"RfCodecTest.rf"};
+};
+
+TEST(RfCodecTest, RoundTripsFullRangeData) {
+    // Not a multiple of the block size.
+    auto input = getRandom(N_CHANNELS * 100 + 13, 1);
+    size_t nBytes;
+    EXPECT_EQ(roundTrip(input, N_CHANNELS, &nBytes), input);
+    EXPECT_LE(nBytes, RfCodec::getMaxEncodedSize(input.size()));
+}
+
+TEST(RfCodecTest, RoundTripsExtremeValues) {
+    std::vector<int16> input(1000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = (i / 3) % 2 == 0 ? std::numeric_limits<int16>::min() : std::numeric_limits<int16>::max();
+    }
+    for (size_t stride : {1, 2, 32}) {
+        EXPECT_EQ(roundTrip(input, stride), input);
+    }
+    std::vector<int16> zeros(100, 0);
+    size_t nBytes;
+    EXPECT_EQ(roundTrip(zeros, 1, &nBytes), zeros);
+    EXPECT_EQ(nBytes, 2);// Two blocks with bit width 0.
+}
+
+TEST(RfCodecTest, CompressesRfData) {
+    auto input = getRf(4096, 2);
+    size_t nBytes;
+    EXPECT_EQ(roundTrip(input, N_CHANNELS, &nBytes), input);
+    EXPECT_LT((double) nBytes, 0.6 * (double) (input.size() * sizeof(int16)));
+}
+
+TEST(RfCodecTest, ThrowsOnCorruptedData) {
+    auto input = getRf(64, 3);
+    std::vector<uint8> encoded(RfCodec::getMaxEncodedSize(input.size()));
+    size_t size = RfCodec::encode(input.data(), input.size(), N_CHANNELS, encoded.data());
+    std::vector<int16> output(input.size());
+    EXPECT_THROW(RfCodec::decode(encoded.data(), size - 1, input.size(), N_CHANNELS, output.data()),
+                 ArrusException);
+    encoded[0] = 0xFF;// Invalid predictor and bit width.
+    EXPECT_THROW(RfCodec::decode(encoded.data(), size, input.size(), N_CHANNELS, output.data()), ArrusException);
+}
+
+TEST_F(RfRecordingTest, RecordsAndReadsFrames) {
+    const size_t nSamples = 8192, nFrames = 3;
+    std::vector<std::vector<int16>> frames;
+    {
+        RfRecorder recorder{filepath, N_CHANNELS, 4};
+        for (size_t i = 0; i < nFrames; ++i) {
+            frames.push_back(getRf(nSamples, 10 + (unsigned) i));
+            NdArray frame{frames.back().data(), {nSamples, N_CHANNELS}, NdArray::DataType::INT16,
+                          devices::DeviceId(devices::DeviceType::CPU, 0)};
+            recorder.write(frame);
+        }
+        EXPECT_EQ(recorder.getNumberOfFrames(), nFrames);
+        EXPECT_EQ(recorder.getNumberOfRawBytes(), nFrames * nSamples * N_CHANNELS * sizeof(int16));
+        EXPECT_LT((double) recorder.getNumberOfEncodedBytes(), 0.6 * (double) recorder.getNumberOfRawBytes());
+    }
+    ASSERT_TRUE(isRfRecording(filepath));
+    NdArray result = readRfRecording(filepath, 2);
+    EXPECT_EQ(result.getShape(), (NdArray::Shape{nFrames, nSamples, N_CHANNELS}));
+    for (size_t i = 0; i < nFrames; ++i) {
+        const int16 *data = result.get<int16>() + i * nSamples * N_CHANNELS;
+        EXPECT_EQ(std::vector<int16>(data, data + nSamples * N_CHANNELS), frames[i]);
+    }
+}
+
+TEST_F(RfRecordingTest, RejectsFramesOfDifferentSize) {
+    RfRecorder recorder{filepath, N_CHANNELS};
+    auto frame = getRandom(N_CHANNELS * 10, 4);
+    recorder.write(frame.data(), frame.size());
+    EXPECT_THROW(recorder.write(frame.data(), frame.size() - N_CHANNELS), IllegalArgumentException);
+    recorder.close();
+    EXPECT_THROW(recorder.write(frame.data(), frame.size()), IllegalStateException);
+}
+
+TEST_F(RfRecordingTest, DetectsRawFiles) {
+    {
+        std::ofstream file{filepath, std::ios::out | std::ios::binary};
+        auto frame = getRandom(100, 5);
+        file.write(reinterpret_cast<const char *>(frame.data()), (std::streamsize) (frame.size() * sizeof(int16)));
+    }
+    EXPECT_FALSE(isRfRecording(filepath));
+    EXPECT_THROW(readRfRecording(filepath), ArrusException);
+}
+
+TEST_F(RfRecordingTest, ThrowsOnTruncatedRecording) {
+    {
+        RfRecorder recorder{filepath, N_CHANNELS};
+        auto frame = getRandom(N_CHANNELS * 100, 6);
+        recorder.write(frame.data(), frame.size());
+        recorder.write(frame.data(), frame.size());
+    }
+    std::ifstream input{filepath, std::ios::in | std::ios::binary};
+    std::vector<char> content{std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+    input.close();
+    {
+        std::ofstream output{filepath, std::ios::out | std::ios::binary | std::ios::trunc};
+        output.write(content.data(), (std::streamsize) content.size() - 10);
+    }
+    EXPECT_THROW(readRfRecording(filepath), ArrusException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
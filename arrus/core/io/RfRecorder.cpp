@@ -0,0 +1,186 @@
+#include "arrus/core/api/io/RfRecorder.h"
+
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/io/RfCodec.h"
+
+namespace arrus::io {
+
+class RfRecorder::Impl {
+public:
+    Impl(const std::string &filepath, size_t sampleStride, unsigned nThreads)
+        : filepath(filepath), sampleStride(sampleStride), nThreads(getRfNumberOfThreads(nThreads)) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(sampleStride > 0, "Sample stride should be positive.");
+        file.open(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw IllegalArgumentException(format("Cannot open file for writing: {}", filepath));
+        }
+    }
+
+    ~Impl() {
+        try {
+            close();
+        } catch (...) {
+            // Destructor should not throw.
+        }
+    }
+
+    void write(const int16 *data, size_t size, const framework::NdArray::Shape &shape) {
+        std::lock_guard<std::mutex> lock{mutex};
+        ARRUS_REQUIRES_TRUE_E(file.is_open(), IllegalStateException(
+            format("The RF recording {} is already closed.", filepath)));
+        if (nFrames == 0) {
+            frameSize = size;
+            chunkSize = getRfChunkSize(frameSize, sampleStride, nThreads);
+            writeRfRecordingHeader(file, RfRecordingHeader{sampleStride, shape});
+        } else {
+            ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+                size == frameSize, format("All frames of the recording should have the same number of values "
+                                          "(expected: {}, got: {}).", frameSize, size));
+        }
+        const size_t nChunks = std::max<size_t>((frameSize + chunkSize - 1) / chunkSize, 1);
+        chunks.resize(nChunks);
+        chunkSizes.resize(nChunks);
+        runRfTasks(nChunks, nThreads, [&](size_t i) {
+            const size_t begin = i * chunkSize;
+            const size_t n = std::min(chunkSize, frameSize - std::min(begin, frameSize));
+            chunks[i].resize(RfCodec::getMaxEncodedSize(n));
+            chunkSizes[i] = RfCodec::encode(data + begin, n, sampleStride, chunks[i].data());
+        });
+        writeFrame(nChunks);
+        ++nFrames;
+        nRawBytes += frameSize * sizeof(int16);
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!file.is_open()) {
+            return;
+        }
+        file.close();
+        if (file.fail()) {
+            throw ArrusException(format("Error while closing the RF recording: {}", filepath));
+        }
+    }
+
+    size_t getNumberOfFrames() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return nFrames;
+    }
+
+    size_t getNumberOfRawBytes() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return nRawBytes;
+    }
+
+    size_t getNumberOfEncodedBytes() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return nEncodedBytes;
+    }
+
+private:
+    void writeFrame(size_t nChunks) {
+        // Frame header: the number of chunks and the (nValues, nBytes) table.
+        std::vector<uint8> header(sizeof(uint32) + nChunks * 2 * sizeof(uint64));
+        uint8 *out = header.data();
+        auto put = [&out](uint64 value, size_t nBytes) {
+            for (size_t i = 0; i < nBytes; ++i) {
+                *out++ = static_cast<uint8>(value >> (8 * i));
+            }
+        };
+        put(nChunks, sizeof(uint32));
+        for (size_t i = 0; i < nChunks; ++i) {
+            const size_t begin = i * chunkSize;
+            put(std::min(chunkSize, frameSize - std::min(begin, frameSize)), sizeof(uint64));
+            put(chunkSizes[i], sizeof(uint64));
+        }
+        file.write(reinterpret_cast<const char *>(header.data()), (std::streamsize) header.size());
+        nEncodedBytes += header.size();
+        for (size_t i = 0; i < nChunks; ++i) {
+            file.write(reinterpret_cast<const char *>(chunks[i].data()), (std::streamsize) chunkSizes[i]);
+            nEncodedBytes += chunkSizes[i];
+        }
+        if (file.fail()) {
+            throw ArrusException(format("Error while writing the RF recording: {}", filepath));
+        }
+    }
+
+    std::string filepath;
+    size_t sampleStride;
+    unsigned nThreads;
+    mutable std::mutex mutex;
+    std::ofstream file;
+    size_t frameSize{0}, chunkSize{0};
+    size_t nFrames{0}, nRawBytes{0}, nEncodedBytes{0};
+    /** Encoded chunks of the current frame (reused between frames). */
+    std::vector<std::vector<uint8>> chunks;
+    std::vector<size_t> chunkSizes;
+};
+
+RfRecorder::RfRecorder(const std::string &filepath, size_t sampleStride, unsigned nThreads)
+    : impl(std::make_unique<Impl>(filepath, sampleStride, nThreads)) {}
+
+void RfRecorder::write(const int16 *data, size_t size) { impl->write(data, size, framework::NdArray::Shape{size}); }
+
+void RfRecorder::write(const framework::NdArray &data) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(data.getDataType() == framework::NdArray::DataType::INT16,
+                                     "Only int16 data can be recorded.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(data.isContiguous(), "Only contiguous arrays can be recorded.");
+    impl->write(data.get<int16>(), data.getNumberOfElements(), data.getShape());
+}
+
+void RfRecorder::close() { impl->close(); }
+
+size_t RfRecorder::getNumberOfFrames() const { return impl->getNumberOfFrames(); }
+
+size_t RfRecorder::getNumberOfRawBytes() const { return impl->getNumberOfRawBytes(); }
+
+size_t RfRecorder::getNumberOfEncodedBytes() const { return impl->getNumberOfEncodedBytes(); }
+
+RfRecorder::RfRecorder(RfRecorder &&o) noexcept = default;
+RfRecorder::~RfRecorder() = default;
+RfRecorder &RfRecorder::operator=(RfRecorder &&o) noexcept = default;
+
+bool isRfRecording(const std::string &filepath) {
+    std::ifstream file{filepath, std::ios::in | std::ios::binary};
+    if (!file.is_open()) {
+        return false;
+    }
+    try {
+        return readRfRecordingHeader(file).has_value();
+    } catch (const ArrusException &) {
+        return false;
+    }
+}
+
+framework::NdArray readRfRecording(const std::string &filepath, unsigned nThreads) {
+    std::ifstream file{filepath, std::ios::in | std::ios::binary};
+    if (!file.is_open()) {
+        throw IllegalArgumentException(format("Cannot open file: {}", filepath));
+    }
+    auto header = readRfRecordingHeader(file);
+    if (!header.has_value()) {
+        throw ArrusException(format("{} is not an RF recording.", filepath));
+    }
+    auto frames = readRfFrames(file, header.value(), nThreads);
+    std::vector<size_t> shape{frames.size()};
+    for (size_t i = 0; i < header->shape.size(); ++i) {
+        shape.push_back(header->shape[i]);
+    }
+    framework::NdArray result{framework::NdArray::Shape{shape}, framework::NdArray::DataType::INT16,
+                              devices::DeviceId(devices::DeviceType::CPU, 0), filepath};
+    int16 *out = result.get<int16>();
+    for (auto &frame : frames) {
+        std::memcpy(out, frame.data(), frame.size() * sizeof(int16));
+        out += frame.size();
+    }
+    return result;
+}
+
+}// namespace arrus::io
@@ -0,0 +1,133 @@
+#include "BModeConversion.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+
+namespace arrus::processing {
+
+namespace {
+
+// log2(1+x) ~ P(x), x in [0, 1), least-squares fit, max. error ~1.5e-5.
+constexpr float LOG2_C0 = 1.4390929e-05f;
+constexpr float LOG2_C1 = 1.4415921f;
+constexpr float LOG2_C2 = -0.70725343f;
+constexpr float LOG2_C3 = 0.41156148f;
+constexpr float LOG2_C4 = -0.18983245f;
+constexpr float LOG2_C5 = 0.043928628f;
+// 20*log10(|z|) = 10*log10(|z|^2) = 10*log10(2)*log2(|z|^2)
+constexpr float DB_PER_LOG2 = 3.0102999566f;
+
+inline float fastLog2(float value) {
+    int32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    auto exponent = (float) (((bits >> 23) & 0xff) - 127);
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(bits));
+    float x = mantissa - 1.0f;
+    float p = LOG2_C5;
+    p = p * x + LOG2_C4;
+    p = p * x + LOG2_C3;
+    p = p * x + LOG2_C2;
+    p = p * x + LOG2_C1;
+    p = p * x + LOG2_C0;
+    return exponent + p;
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+inline __m256 fastLog2(__m256 value) {
+    __m256i bits = _mm256_castps_si256(value);
+    __m256 exponent = _mm256_cvtepi32_ps(
+        _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xff)),
+                         _mm256_set1_epi32(127)));
+    bits = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000));
+    __m256 x = _mm256_sub_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(1.0f));
+    __m256 p = _mm256_set1_ps(LOG2_C5);
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(LOG2_C4));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(LOG2_C3));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(LOG2_C2));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(LOG2_C1));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(LOG2_C0));
+    return _mm256_add_ps(exponent, p);
+}
+#endif
+
+}// namespace
+
+BModeConversion::BModeConversion(float dynamicRangeMin, float dynamicRangeMax) {
+    setDynamicRange(dynamicRangeMin, dynamicRangeMax);
+}
+
+void BModeConversion::setDynamicRange(float min, float max) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(min < max, format("Invalid dynamic range: [{}, {}]", min, max));
+    dynamicRangeMin = min;
+    dynamicRangeMax = max;
+}
+
+void BModeConversion::process(const float32 *iq, uint8 *output, size_t nPixels) const {
+    const float scale = 255.0f / (dynamicRangeMax - dynamicRangeMin);
+    size_t i = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256 dbPerLog2 = _mm256_set1_ps(DB_PER_LOG2);
+    const __m256 min = _mm256_set1_ps(dynamicRangeMin);
+    const __m256 max = _mm256_set1_ps(dynamicRangeMax);
+    const __m256 scaleV = _mm256_set1_ps(scale);
+    for (; i + 8 <= nPixels; i += 8) {
+        __m256 a = _mm256_loadu_ps(iq + 2 * i);
+        __m256 b = _mm256_loadu_ps(iq + 2 * i + 8);
+        // Pairwise sums of squares: p0 p1 p4 p5 | p2 p3 p6 p7 -> p0..p7.
+        __m256 power = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+        power = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(power), 0xD8));
+        __m256 db = _mm256_mul_ps(fastLog2(power), dbPerLog2);
+        db = _mm256_min_ps(_mm256_max_ps(db, min), max);
+        __m256i value = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(db, min), scaleV));
+        __m128i value16 = _mm_packus_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+        _mm_storel_epi64((__m128i *) (output + i), _mm_packus_epi16(value16, value16));
+    }
+#endif
+    for (; i < nPixels; ++i) {
+        float re = iq[2 * i];
+        float im = iq[2 * i + 1];
+        float db = fastLog2(re * re + im * im) * DB_PER_LOG2;
+        db = std::min(std::max(db, dynamicRangeMin), dynamicRangeMax);
+        output[i] = static_cast<uint8>((db - dynamicRangeMin) * scale);
+    }
+}
+
+void BModeConversion::process(const framework::NdArray &input, framework::NdArray &output) const {
+    using DataType = framework::NdArray::DataType;
+    const auto &shape = input.getShape().getValues();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(input.getDataType() == DataType::FLOAT32 && !shape.empty() && shape.back() == 2,
+                                     "B-mode conversion input should be a float32 array with shape (..., 2).");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(output.getDataType() == DataType::UINT8
+                                         && output.getNumberOfElements() == input.getNumberOfElements() / 2,
+                                     "B-mode conversion output should be an uint8 array with the input pixel count.");
+    process(input.get<float32>(), output.get<uint8>(), output.getNumberOfElements());
+}
+
+framework::graph::ArrayDef
+BModeConversionNode::prepare(const std::vector<framework::graph::ArrayDef> &inputs) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(inputs.size() == 1, "B-mode conversion node should have exactly one input.");
+    const auto &input = inputs[0];
+    std::vector<size_t> shape = input.getShape().getValues();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        input.getDataType() == framework::NdArray::DataType::FLOAT32 && shape.size() > 1 && shape.back() == 2,
+        "B-mode conversion node input should be a float32 array with shape (..., 2).");
+    shape.pop_back();
+    return framework::graph::ArrayDef{framework::NdArray::Shape{shape}, framework::NdArray::DataType::UINT8};
+}
+
+void BModeConversionNode::process(const std::vector<const framework::NdArray *> &inputs,
+                                  framework::NdArray &output) {
+    conversion.process(*inputs.at(0), output);
+}
+
+}// namespace arrus::processing
@@ -0,0 +1,74 @@
+#ifndef ARRUS_CORE_PROCESSING_BMODECONVERSION_H
+#define ARRUS_CORE_PROCESSING_BMODECONVERSION_H
+
+#include <vector>
+
+#include "arrus/core/framework/graph/Graph.h"
+
+namespace arrus::processing {
+
+/**
+ * Converts beamformed IQ data to an 8-bit B-mode image, in a single pass over the data.
+ *
+ * The conversion is equivalent to the following chain of operations (arrus.utils.imaging):
+ * EnvelopeDetection, LogCompression, DynamicRangeAdjustment(min, max), ToGrayscaleImg; the only difference is that
+ * the output image is scaled to the [min, max] range, instead of the [min(data), max(data)] range.
+ *
+ * The logarithm is computed using a polynomial approximation (max. error below 1e-4 dB). The computations are
+ * vectorized with AVX2 when available at compile time.
+ */
+class BModeConversion {
+public:
+    /**
+     * @param dynamicRangeMin minimum value [dB] (mapped to 0)
+     * @param dynamicRangeMax maximum value [dB] (mapped to 255)
+     */
+    BModeConversion(float dynamicRangeMin, float dynamicRangeMax);
+
+    /**
+     * Converts the given IQ data.
+     *
+     * @param iq input IQ data, interleaved real and imaginary parts (i.e. complex64 data)
+     * @param output output image
+     * @param nPixels the number of pixels (complex values) to convert
+     */
+    void process(const float32 *iq, uint8 *output, size_t nPixels) const;
+
+    /**
+     * Converts the given IQ array.
+     *
+     * @param input FLOAT32 array, with shape (..., 2), where the last axis are the I and Q components
+     * @param output UINT8 array, with the shape of the input array without the last axis
+     */
+    void process(const framework::NdArray &input, framework::NdArray &output) const;
+
+    void setDynamicRange(float min, float max);
+
+    float getDynamicRangeMin() const { return dynamicRangeMin; }
+
+    float getDynamicRangeMax() const { return dynamicRangeMax; }
+
+private:
+    float dynamicRangeMin;
+    float dynamicRangeMax;
+};
+
+/**
+ * Graph node that converts IQ data to B-mode image (see BModeConversion).
+ */
+class BModeConversionNode : public framework::graph::Node {
+public:
+    BModeConversionNode(float dynamicRangeMin, float dynamicRangeMax)
+        : conversion(dynamicRangeMin, dynamicRangeMax) {}
+
+    framework::graph::ArrayDef prepare(const std::vector<framework::graph::ArrayDef> &inputs) override;
+
+    void process(const std::vector<const framework::NdArray *> &inputs, framework::NdArray &output) override;
+
+private:
+    BModeConversion conversion;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_PROCESSING_BMODECONVERSION_H
@@ -0,0 +1,94 @@
+/**
+ * Compares the fused B-mode conversion with the chain of separate operations
+ * (envelope detection, log compression, dynamic range adjustment, conversion to uint8), each of them reading
+ * and writing a complete frame, as done by the arrus.utils.imaging operations.
+ *
+ * Usage: processing_BModeConversionBenchmark [nPixels] [nRepeats]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "arrus/core/processing/BModeConversion.h"
+
+namespace {
+
+using namespace arrus;
+
+constexpr float MIN_DB = 20.0f;
+constexpr float MAX_DB = 80.0f;
+
+/** The number of bytes read/written per pixel by the chained operations. */
+constexpr size_t CHAINED_BYTES_PER_PIXEL =
+    (8 + 4)    // envelope detection: complex64 -> float32
+    + (4 + 4)  // log compression: float32 -> float32
+    + (4 + 4)  // dynamic range adjustment: float32 -> float32
+    + (4 + 4)  // grayscale: min and max of the frame
+    + (4 + 1); // grayscale: float32 -> uint8
+/** The number of bytes read/written per pixel by the fused kernel. */
+constexpr size_t FUSED_BYTES_PER_PIXEL = 8 + 1;
+
+void processChained(const std::vector<float> &iq, std::vector<float> &tmp1, std::vector<float> &tmp2,
+                    std::vector<uint8> &output) {
+    const size_t n = output.size();
+    for (size_t i = 0; i < n; ++i) {
+        tmp1[i] = std::sqrt(iq[2 * i] * iq[2 * i] + iq[2 * i + 1] * iq[2 * i + 1]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        tmp2[i] = 20.0f * std::log10(std::max(tmp1[i], 1e-9f));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        tmp1[i] = std::min(std::max(tmp2[i], MIN_DB), MAX_DB);
+    }
+    auto [minIt, maxIt] = std::minmax_element(std::begin(tmp1), std::end(tmp1));
+    float min = *minIt;
+    float scale = 255.0f / std::max(*maxIt - min, 1e-9f);
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = static_cast<uint8>((tmp1[i] - min) * scale);
+    }
+}
+
+template<typename F> double measure(F &&func, size_t nRepeats) {
+    func();// warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRepeats; ++i) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / (double) nRepeats;
+}
+
+void report(const char *name, double time, size_t nPixels, size_t bytesPerPixel) {
+    double bytes = (double) (nPixels * bytesPerPixel);
+    std::cout << name << ": " << time * 1e3 << " ms/frame, " << bytesPerPixel << " bytes/pixel, "
+              << bytes / time / 1e9 << " GB/s effective bandwidth, " << (double) nPixels / time / 1e6
+              << " Mpixels/s" << std::endl;
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    size_t nPixels = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2048 * 1024;
+    size_t nRepeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+
+    std::mt19937 generator{2023};
+    std::normal_distribution<float> distribution{0.0f, 1000.0f};
+    std::vector<float> iq(2 * nPixels);
+    std::generate(std::begin(iq), std::end(iq), [&]() { return distribution(generator); });
+    std::vector<float> tmp1(nPixels), tmp2(nPixels);
+    std::vector<uint8> output(nPixels);
+
+    std::cout << "Frame size: " << nPixels << " pixels" << std::endl;
+    double chained = measure([&]() { processChained(iq, tmp1, tmp2, output); }, nRepeats);
+    report("chained", chained, nPixels, CHAINED_BYTES_PER_PIXEL);
+
+    processing::BModeConversion conversion{MIN_DB, MAX_DB};
+    double fused = measure([&]() { conversion.process(iq.data(), output.data(), nPixels); }, nRepeats);
+    report("fused", fused, nPixels, FUSED_BYTES_PER_PIXEL);
+    std::cout << "speedup: " << chained / fused << std::endl;
+    return 0;
+}
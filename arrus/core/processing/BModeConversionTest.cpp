@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "arrus/core/processing/BModeConversion.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using arrus::framework::NdArray;
+using arrus::framework::graph::ArrayDef;
+
+/** Envelope detection, log compression, dynamic range adjustment, conversion to uint8. */
+uint8 reference(float re, float im, float min, float max) {
+    double envelope = std::sqrt((double) re * re + (double) im * im);
+    double db = envelope > 0 ? 20.0 * std::log10(envelope) : -180.0;
+    db = std::min(std::max(db, (double) min), (double) max);
+    return static_cast<uint8>((db - min) / (max - min) * 255.0);
+}
+
+std::vector<float> getRandomIq(size_t nPixels) {
+    std::mt19937 generator{2023};
+    // Log-uniform magnitudes, covering the whole dynamic range.
+    std::uniform_real_distribution<float> magnitude{-1.0f, 5.0f};
+    std::uniform_real_distribution<float> phase{0.0f, 6.2831853f};
+    std::vector<float> result(2 * nPixels);
+    for (size_t i = 0; i < nPixels; ++i) {
+        float m = std::pow(10.0f, magnitude(generator));
+        float p = phase(generator);
+        result[2 * i] = m * std::cos(p);
+        result[2 * i + 1] = m * std::sin(p);
+    }
+    return result;
+}
+
+TEST(BModeConversionTest, IsEquivalentToChainedOperations) {
+    const size_t nPixels = 10007;
+    auto iq = getRandomIq(nPixels);
+    iq[0] = 0.0f;
+    iq[1] = 0.0f;
+    BModeConversion conversion{20.0f, 80.0f};
+    std::vector<uint8> output(nPixels);
+    conversion.process(iq.data(), output.data(), nPixels);
+    for (size_t i = 0; i < nPixels; ++i) {
+        int expected = reference(iq[2 * i], iq[2 * i + 1], 20.0f, 80.0f);
+        // The result may differ by one, when the value is close to the quantization threshold.
+        ASSERT_LE(std::abs((int) output[i] - expected), 1) << "at pixel " << i;
+    }
+    EXPECT_EQ(output[0], 0);
+}
+
+TEST(BModeConversionTest, ClampsToDynamicRange) {
+    BModeConversion conversion{0.0f, 40.0f};
+    // 0 dB, 20 dB, 40 dB, 60 dB
+    std::vector<float> iq{1.0f, 0.0f, 0.0f, 10.0f, 60.0f, 80.0f, 1000.0f, 0.0f};
+    std::vector<uint8> output(4);
+    conversion.process(iq.data(), output.data(), 4);
+    EXPECT_EQ(output[0], 0);
+    EXPECT_NEAR(output[1], 127, 1);
+    EXPECT_EQ(output[2], 255);
+    EXPECT_EQ(output[3], 255);
+    EXPECT_THROW(conversion.setDynamicRange(40.0f, 40.0f), IllegalArgumentException);
+}
+
+TEST(BModeConversionTest, NodeProducesUint8Image) {
+    BModeConversionNode node{20.0f, 80.0f};
+    auto def = node.prepare({ArrayDef{NdArray::Shape{16, 32, 2}, NdArray::DataType::FLOAT32}});
+    EXPECT_EQ(def, (ArrayDef{NdArray::Shape{16, 32}, NdArray::DataType::UINT8}));
+    EXPECT_THROW(node.prepare({ArrayDef{NdArray::Shape{16, 32}, NdArray::DataType::FLOAT32}}),
+                 IllegalArgumentException);
+
+    const devices::DeviceId cpu{devices::DeviceType::CPU, 0};
+    NdArray input{NdArray::Shape{16, 32, 2}, NdArray::DataType::FLOAT32, cpu, "iq"};
+    auto iq = getRandomIq(16 * 32);
+    std::copy(std::begin(iq), std::end(iq), input.get<float>());
+    NdArray output{def.getShape(), def.getDataType(), cpu, "bmode"};
+    node.process({&input}, output);
+    std::vector<uint8> expected(16 * 32);
+    BModeConversion{20.0f, 80.0f}.process(iq.data(), expected.data(), 16 * 32);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(output.get<uint8>()[i], expected[i]);
+    }
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include "arrus/core/api/processing/ColorDoppler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/common/collections.h"
+
+namespace arrus::processing {
+
+class ColorDoppler::Impl {
+public:
+    /** The number of pixels processed together (filter state and accumulators of a block stay in L1 cache). */
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    Impl(std::vector<float> b, std::vector<float> a, std::vector<float> initialState, unsigned nRejected,
+         unsigned nThreads)
+        : nRejected(nRejected) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!b.empty() && !a.empty(),
+                                         "Wall filter coefficients (b and a) cannot be empty.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(a[0] != 0.0f, "Wall filter coefficient a[0] cannot be 0.");
+        order = std::max(a.size(), b.size()) - 1;
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            initialState.empty() || initialState.size() == order,
+            format("Wall filter initial state should be empty or have {} elements (the filter order).", order));
+        // Normalize, so that a[0] == 1.
+        this->b = std::vector<float>(order + 1, 0.0f);
+        this->a = std::vector<float>(order + 1, 0.0f);
+        for (size_t i = 0; i < b.size(); ++i) {
+            this->b[i] = b[i] / a[0];
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            this->a[i] = a[i] / a[0];
+        }
+        this->initialState = initialState.empty() ? std::vector<float>(order, 0.0f) : std::move(initialState);
+        if (nThreads == 0) {
+            nThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        this->nThreads = nThreads;
+    }
+
+    void process(const float32 *iq, size_t nRepetitions, size_t nPixels, float32 *color, float32 *power,
+                 float32 *turbulence) const {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            nRepetitions >= nRejected + 2,
+            format("The ensemble length ({}) should be at least the number of rejected samples ({}) + 2.",
+                   nRepetitions, nRejected));
+        const size_t nBlocks = (nPixels + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const size_t nWorkers = std::min<size_t>(nThreads, nBlocks);
+        auto processBlocks = [&, this](size_t start, size_t end) {
+            for (size_t block = start; block < end; ++block) {
+                size_t pixel = block * BLOCK_SIZE;
+                size_t n = std::min(BLOCK_SIZE, nPixels - pixel);
+                processBlock(iq, nRepetitions, nPixels, pixel, n, color, power, turbulence);
+            }
+        };
+        if (nWorkers <= 1) {
+            processBlocks(0, nBlocks);
+            return;
+        }
+        const size_t blocksPerWorker = (nBlocks + nWorkers - 1) / nWorkers;
+        std::vector<std::thread> workers;
+        for (size_t start = 0; start < nBlocks; start += blocksPerWorker) {
+            workers.emplace_back(processBlocks, start, std::min(start + blocksPerWorker, nBlocks));
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    /**
+     * Processes pixels [pixel, pixel+n): wall filter (transposed direct form II), R0 and R1 accumulation,
+     * in a single pass over the ensemble.
+     */
+    void processBlock(const float32 *iq, size_t nRepetitions, size_t nPixels, size_t pixel, size_t n,
+                      float32 *color, float32 *power, float32 *turbulence) const {
+        constexpr size_t B = BLOCK_SIZE;
+        // Filter state: stateRe[k*B + p].
+        std::vector<float> stateRe(order * B), stateIm(order * B);
+        float yRe[B], yIm[B], prevRe[B], prevIm[B];
+        float r0[B], r1Re[B], r1Im[B];
+        std::fill(r0, r0 + B, 0.0f);
+        std::fill(r1Re, r1Re + B, 0.0f);
+        std::fill(r1Im, r1Im + B, 0.0f);
+
+        const float32 *first = iq + 2 * pixel;
+        for (size_t k = 0; k < order; ++k) {
+            for (size_t p = 0; p < n; ++p) {
+                stateRe[k * B + p] = initialState[k] * first[2 * p];
+                stateIm[k * B + p] = initialState[k] * first[2 * p + 1];
+            }
+        }
+        for (size_t rep = 0; rep < nRepetitions; ++rep) {
+            const float32 *x = iq + 2 * (rep * nPixels + pixel);
+            for (size_t p = 0; p < n; ++p) {
+                float xRe = x[2 * p], xIm = x[2 * p + 1];
+                yRe[p] = b[0] * xRe + (order > 0 ? stateRe[p] : 0.0f);
+                yIm[p] = b[0] * xIm + (order > 0 ? stateIm[p] : 0.0f);
+            }
+            for (size_t k = 0; k < order; ++k) {
+                float *sRe = stateRe.data() + k * B, *sIm = stateIm.data() + k * B;
+                const float bk = b[k + 1], ak = a[k + 1];
+                if (k + 1 < order) {
+                    const float *nextRe = sRe + B, *nextIm = sIm + B;
+                    for (size_t p = 0; p < n; ++p) {
+                        sRe[p] = nextRe[p] + bk * x[2 * p] - ak * yRe[p];
+                        sIm[p] = nextIm[p] + bk * x[2 * p + 1] - ak * yIm[p];
+                    }
+                } else {
+                    for (size_t p = 0; p < n; ++p) {
+                        sRe[p] = bk * x[2 * p] - ak * yRe[p];
+                        sIm[p] = bk * x[2 * p + 1] - ak * yIm[p];
+                    }
+                }
+            }
+            if (rep < nRejected) {
+                continue;
+            }
+            for (size_t p = 0; p < n; ++p) {
+                r0[p] += yRe[p] * yRe[p] + yIm[p] * yIm[p];
+            }
+            if (rep > nRejected) {
+                for (size_t p = 0; p < n; ++p) {
+                    r1Re[p] += yRe[p] * prevRe[p] + yIm[p] * prevIm[p];
+                    r1Im[p] += yIm[p] * prevRe[p] - yRe[p] * prevIm[p];
+                }
+            }
+            std::copy(yRe, yRe + n, prevRe);
+            std::copy(yIm, yIm + n, prevIm);
+        }
+        const auto nSamples = (float) (nRepetitions - nRejected);
+        for (size_t p = 0; p < n; ++p) {
+            color[pixel + p] = std::atan2(r1Im[p], r1Re[p]);
+            power[pixel + p] = r0[p] / nSamples;
+            turbulence[pixel + p] =
+                r0[p] > 0.0f ? 1.0f - std::hypot(r1Re[p], r1Im[p]) / r0[p] * nSamples / (nSamples - 1.0f) : 0.0f;
+        }
+    }
+
+    std::vector<float> b, a, initialState;
+    size_t order;
+    unsigned nRejected;
+    unsigned nThreads;
+};
+
+ColorDoppler::ColorDoppler(Span<float> b, Span<float> a, Span<float> initialState, unsigned nRejected,
+                           unsigned nThreads) {
+    this->impl = UniqueHandle<Impl>::create(copyToVector(b), copyToVector(a), copyToVector(initialState), nRejected,
+                                            nThreads);
+}
+
+void ColorDoppler::process(const float32 *iq, size_t nRepetitions, size_t nPixels, float32 *color, float32 *power,
+                           float32 *turbulence) const {
+    impl->process(iq, nRepetitions, nPixels, color, power, turbulence);
+}
+
+ColorDoppler::ColorDoppler(const ColorDoppler &o) = default;
+ColorDoppler::ColorDoppler(ColorDoppler &&o) noexcept = default;
+ColorDoppler::~ColorDoppler() {}
+ColorDoppler &ColorDoppler::operator=(const ColorDoppler &o) = default;
+ColorDoppler &ColorDoppler::operator=(ColorDoppler &&o) noexcept = default;
+
+}// namespace arrus::processing
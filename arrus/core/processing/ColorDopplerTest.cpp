@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "arrus/core/api/processing/ColorDoppler.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using Complex = std::complex<double>;
+
+/** Pixel p, repetition n: exp(j*theta_p*n) * amplitude + clutter. */
+std::vector<float> getEnsemble(size_t nRepetitions, size_t nPixels, float clutter) {
+    std::mt19937 generator{2023};
+    std::uniform_real_distribution<float> distribution{-1.0f, 1.0f};
+    std::vector<float> result(2 * nRepetitions * nPixels);
+    for (size_t p = 0; p < nPixels; ++p) {
+        float theta = 2.5f * distribution(generator);
+        float amplitude = 1.0f + distribution(generator) * 0.5f;
+        for (size_t n = 0; n < nRepetitions; ++n) {
+            result[2 * (n * nPixels + p)] = amplitude * std::cos(theta * (float) n) + clutter;
+            result[2 * (n * nPixels + p) + 1] = amplitude * std::sin(theta * (float) n) + clutter;
+        }
+    }
+    return result;
+}
+
+/** Reference: MATLAB filter(b, a, x, zi) + the Kasai estimator, in double precision. */
+void reference(const std::vector<float> &iq, size_t nRepetitions, size_t nPixels, const std::vector<double> &b,
+               const std::vector<double> &a, const std::vector<double> &init, size_t nRejected,
+               std::vector<float> &color, std::vector<float> &power, std::vector<float> &turbulence) {
+    const size_t order = b.size() - 1;
+    for (size_t p = 0; p < nPixels; ++p) {
+        std::vector<Complex> x(nRepetitions), y(nRepetitions);
+        for (size_t n = 0; n < nRepetitions; ++n) {
+            x[n] = Complex(iq[2 * (n * nPixels + p)], iq[2 * (n * nPixels + p) + 1]);
+        }
+        std::vector<Complex> z(order);
+        for (size_t k = 0; k < order; ++k) {
+            z[k] = init[k] * x[0];
+        }
+        for (size_t n = 0; n < nRepetitions; ++n) {
+            y[n] = b[0] * x[n] + (order > 0 ? z[0] : 0.0);
+            for (size_t k = 0; k < order; ++k) {
+                z[k] = (k + 1 < order ? z[k + 1] : 0.0) + b[k + 1] * x[n] - a[k + 1] * y[n];
+            }
+        }
+        double r0 = 0.0;
+        Complex r1 = 0.0;
+        for (size_t n = nRejected; n < nRepetitions; ++n) {
+            r0 += std::norm(y[n]);
+            if (n > nRejected) {
+                r1 += y[n] * std::conj(y[n - 1]);
+            }
+        }
+        double nSamples = (double) (nRepetitions - nRejected);
+        color[p] = (float) std::arg(r1);
+        power[p] = (float) (r0 / nSamples);
+        turbulence[p] = (float) (1.0 - std::abs(r1) / r0 * nSamples / (nSamples - 1.0));
+    }
+}
+
+TEST(ColorDopplerTest, EstimatesPhaseShiftWithoutFilter) {
+    const size_t nRepetitions = 16, nPixels = 100;
+    ColorDoppler doppler{std::vector<float>{1.0f}, std::vector<float>{1.0f}, std::vector<float>{}, 0, 1};
+    std::vector<float> iq(2 * nRepetitions * nPixels);
+    for (size_t p = 0; p < nPixels; ++p) {
+        for (size_t n = 0; n < nRepetitions; ++n) {
+            float theta = -1.5f + 3.0f * (float) p / (float) nPixels;
+            iq[2 * (n * nPixels + p)] = 2.0f * std::cos(theta * (float) n);
+            iq[2 * (n * nPixels + p) + 1] = 2.0f * std::sin(theta * (float) n);
+        }
+    }
+    std::vector<float> color(nPixels), power(nPixels), turbulence(nPixels);
+    doppler.process(iq.data(), nRepetitions, nPixels, color.data(), power.data(), turbulence.data());
+    for (size_t p = 0; p < nPixels; ++p) {
+        EXPECT_NEAR(color[p], -1.5f + 3.0f * (float) p / (float) nPixels, 1e-4f);
+        EXPECT_NEAR(power[p], 4.0f, 1e-4f);
+        EXPECT_NEAR(turbulence[p], 0.0f, 1e-4f);
+    }
+}
+
+TEST(ColorDopplerTest, IirWallFilterMatchesReference) {
+    const size_t nRepetitions = 24, nPixels = 1000, nRejected = 4;
+    // 3rd order high-pass filter.
+    std::vector<double> b{0.5, -1.5, 1.5, -0.5};
+    std::vector<double> a{1.0, -0.8, 0.3, -0.05};
+    std::vector<double> init{-0.5, 1.0, -0.45};
+    auto iq = getEnsemble(nRepetitions, nPixels, 0.5f);
+    std::vector<float> color(nPixels), power(nPixels), turbulence(nPixels);
+    std::vector<float> expectedColor(nPixels), expectedPower(nPixels), expectedTurbulence(nPixels);
+    reference(iq, nRepetitions, nPixels, b, a, init, nRejected, expectedColor, expectedPower, expectedTurbulence);
+
+    // Not normalized coefficients (a[0] != 1).
+    std::vector<float> bf, af, initf;
+    for (auto v : b) { bf.push_back(2.0f * (float) v); }
+    for (auto v : a) { af.push_back(2.0f * (float) v); }
+    for (auto v : init) { initf.push_back((float) v); }
+    ColorDoppler doppler{bf, af, initf, nRejected, 4};
+    doppler.process(iq.data(), nRepetitions, nPixels, color.data(), power.data(), turbulence.data());
+    for (size_t p = 0; p < nPixels; ++p) {
+        ASSERT_NEAR(color[p], expectedColor[p], 1e-3f) << "pixel " << p;
+        ASSERT_NEAR(power[p], expectedPower[p], 1e-4f * (1.0f + expectedPower[p])) << "pixel " << p;
+        ASSERT_NEAR(turbulence[p], expectedTurbulence[p], 1e-3f) << "pixel " << p;
+    }
+}
+
+TEST(ColorDopplerTest, FirWallFilterRemovesClutter) {
+    const size_t nRepetitions = 10, nPixels = 70;
+    // First-order difference: removes the constant clutter.
+    ColorDoppler doppler{std::vector<float>{1.0f, -1.0f}, std::vector<float>{1.0f}, std::vector<float>{}, 1};
+    std::vector<float> iq(2 * nRepetitions * nPixels, 3.0f);
+    std::vector<float> color(nPixels), power(nPixels), turbulence(nPixels);
+    doppler.process(iq.data(), nRepetitions, nPixels, color.data(), power.data(), turbulence.data());
+    for (size_t p = 0; p < nPixels; ++p) {
+        EXPECT_EQ(power[p], 0.0f);
+        EXPECT_EQ(turbulence[p], 0.0f);
+    }
+}
+
+TEST(ColorDopplerTest, ThrowsOnInvalidParameters) {
+    EXPECT_THROW((ColorDoppler{std::vector<float>{1.0f}, std::vector<float>{0.0f}, std::vector<float>{}, 0}),
+                 IllegalArgumentException);
+    EXPECT_THROW((ColorDoppler{std::vector<float>{1.0f, 1.0f}, std::vector<float>{1.0f}, std::vector<float>{1, 2}, 0}),
+                 IllegalArgumentException);
+    ColorDoppler doppler{std::vector<float>{1.0f}, std::vector<float>{1.0f}, std::vector<float>{}, 3};
+    std::vector<float> iq(2 * 4), out(1);
+    EXPECT_THROW(doppler.process(iq.data(), 4, 1, out.data(), out.data(), out.data()), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
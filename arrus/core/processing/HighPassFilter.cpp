@@ -0,0 +1,82 @@
+#include "HighPassFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+
+namespace arrus::processing {
+
+namespace {
+constexpr double PI = 3.14159265358979323846;
+}
+
+HighPassFilter::HighPassFilter(unsigned order, double cutoff, double fs) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(order > 0, "High-pass filter order should be positive.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        cutoff > 0.0 && cutoff < fs / 2.0,
+        format("High-pass filter cutoff frequency should be in range (0, {}), got: {}", fs / 2.0, cutoff));
+    // Bilinear transform with frequency prewarping; one biquad per pair of the complex conjugate poles.
+    const double k = std::tan(PI * cutoff / fs);
+    for (unsigned i = 0; i < order / 2; ++i) {
+        const double q = 1.0 / (2.0 * std::sin(PI * (2.0 * i + 1.0) / (2.0 * order)));
+        const double d = 1.0 + k / q + k * k;
+        sections.push_back({1.0 / d, -2.0 / d, 1.0 / d, 2.0 * (k * k - 1.0) / d, (1.0 - k / q + k * k) / d});
+    }
+    if (order % 2 == 1) {
+        sections.push_back({1.0 / (1.0 + k), -1.0 / (1.0 + k), 0.0, (k - 1.0) / (k + 1.0), 0.0});
+    }
+    padLength = 3 * (2 * sections.size() + 1 - order % 2);
+    // Steady state of each section for the unit step input (scipy.signal.sosfilt_zi).
+    double scale = 1.0;
+    for (auto &s : sections) {
+        const double gain = (s.b0 + s.b1 + s.b2) / (1.0 + s.a1 + s.a2);
+        const double z2 = s.b2 - s.a2 * gain;
+        const double z1 = s.b1 - s.a1 * gain + z2;
+        initialState.push_back({scale * z1, scale * z2});
+        scale *= gain;
+    }
+}
+
+void HighPassFilter::filtfilt(double *buffer, size_t n, size_t nChannels) const {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        n > padLength, format("The signal should be longer than {} samples, got: {}", padLength, n));
+    const size_t p = padLength;
+    const double *x = buffer + p * nChannels;
+    // Odd extension of the signal at both ends.
+    for (size_t r = 0; r < p; ++r) {
+        for (size_t c = 0; c < nChannels; ++c) {
+            buffer[r * nChannels + c] = 2.0 * x[c] - x[(p - r) * nChannels + c];
+            buffer[(p + n + r) * nChannels + c] =
+                2.0 * x[(n - 1) * nChannels + c] - x[(n - 2 - r) * nChannels + c];
+        }
+    }
+    const size_t nRows = n + 2 * p;
+    std::vector<double> x0(nChannels), z1(nChannels), z2(nChannels);
+    for (bool forward : {true, false}) {
+        const size_t first = forward ? 0 : nRows - 1;
+        std::copy(buffer + first * nChannels, buffer + (first + 1) * nChannels, std::begin(x0));
+        for (size_t i = 0; i < sections.size(); ++i) {
+            const auto &s = sections[i];
+            for (size_t c = 0; c < nChannels; ++c) {
+                z1[c] = initialState[i][0] * x0[c];
+                z2[c] = initialState[i][1] * x0[c];
+            }
+            for (size_t j = 0; j < nRows; ++j) {
+                double *row = buffer + (forward ? j : nRows - 1 - j) * nChannels;
+                for (size_t c = 0; c < nChannels; ++c) {
+                    // Transposed direct form II.
+                    const double in = row[c];
+                    const double out = s.b0 * in + z1[c];
+                    z1[c] = s.b1 * in - s.a1 * out + z2[c];
+                    z2[c] = s.b2 * in - s.a2 * out;
+                    row[c] = out;
+                }
+            }
+        }
+    }
+}
+
+}// namespace arrus::processing
@@ -0,0 +1,55 @@
+#ifndef ARRUS_CORE_PROCESSING_HIGHPASSFILTER_H
+#define ARRUS_CORE_PROCESSING_HIGHPASSFILTER_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace arrus::processing {
+
+/**
+ * High-pass Butterworth filter (cascade of second-order sections), applied forward and backward (zero-phase).
+ *
+ * The result is equivalent to scipy.signal.sosfiltfilt(butter(order, cutoff, "highpass", output="sos", fs=fs), x):
+ * the signal is extended at both ends with its odd extension of padLength samples and the initial conditions
+ * correspond to the steady state for the first (last) sample of the extended signal.
+ */
+class HighPassFilter {
+public:
+    /**
+     * @param order filter order
+     * @param cutoff cutoff frequency [Hz], should be in range (0, fs/2)
+     * @param fs sampling frequency [Hz]
+     */
+    HighPassFilter(unsigned order, double cutoff, double fs);
+
+    /**
+     * Returns the number of samples the signal is extended with at each end.
+     */
+    size_t getPadLength() const { return padLength; }
+
+    /**
+     * Filters nChannels signals of length n (n should be greater than padLength), in place.
+     *
+     * @param buffer (n + 2*padLength) rows x nChannels values (channel is the fastest changing index); rows
+     *   [padLength, padLength+n) should contain the input signals, the remaining rows are used for the extension of
+     *   the signals. The output is written to rows [padLength, padLength+n).
+     * @param n signal length
+     * @param nChannels the number of signals
+     */
+    void filtfilt(double *buffer, size_t n, size_t nChannels) const;
+
+private:
+    /** Second order section (a0 == 1). */
+    struct Section {
+        double b0, b1, b2, a1, a2;
+    };
+    std::vector<Section> sections;
+    /** The steady state of each section (transposed direct form II) for the unit step input. */
+    std::vector<std::array<double, 2>> initialState;
+    size_t padLength;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_PROCESSING_HIGHPASSFILTER_H
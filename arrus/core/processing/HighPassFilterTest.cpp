@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/processing/HighPassFilter.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+
+constexpr double PI = 3.14159265358979323846;
+
+/** Squared magnitude response of the digital Butterworth high-pass filter (applied twice by filtfilt). */
+double getExpectedGain(unsigned order, double cutoff, double frequency, double fs) {
+    double ratio = std::tan(PI * cutoff / fs) / std::tan(PI * frequency / fs);
+    return 1.0 / (1.0 + std::pow(ratio, 2.0 * order));
+}
+
+TEST(HighPassFilterTest, HasButterworthZeroPhaseResponse) {
+    const double fs = 65e6, cutoff = 1e6;
+    const size_t n = 4000;
+    for (unsigned order : {2u, 3u, 4u}) {
+        for (double frequency : {0.5e6, 1e6, 2e6, 10e6}) {
+            HighPassFilter filter{order, cutoff, fs};
+            const size_t p = filter.getPadLength();
+            // Two channels: sine and cosine.
+            std::vector<double> buffer((n + 2 * p) * 2);
+            for (size_t i = 0; i < n; ++i) {
+                buffer[(p + i) * 2] = std::sin(2 * PI * frequency / fs * (double) i);
+                buffer[(p + i) * 2 + 1] = std::cos(2 * PI * frequency / fs * (double) i);
+            }
+            filter.filtfilt(buffer.data(), n, 2);
+            const double gain = getExpectedGain(order, cutoff, frequency, fs);
+            // Skip the edges (transient response).
+            for (size_t i = 1000; i < n - 1000; ++i) {
+                ASSERT_NEAR(buffer[(p + i) * 2], gain * std::sin(2 * PI * frequency / fs * (double) i), 1e-3)
+                    << "order: " << order << ", frequency: " << frequency << ", sample: " << i;
+                ASSERT_NEAR(buffer[(p + i) * 2 + 1], gain * std::cos(2 * PI * frequency / fs * (double) i), 1e-3)
+                    << "order: " << order << ", frequency: " << frequency << ", sample: " << i;
+            }
+        }
+    }
+}
+
+TEST(HighPassFilterTest, RemovesConstantSignalCompletely) {
+    // Steady state initial conditions: no transient for a constant signal.
+    HighPassFilter filter{4, 1e5, 65e6};
+    const size_t n = 100, p = filter.getPadLength();
+    EXPECT_EQ(p, 15);
+    std::vector<double> buffer(n + 2 * p, 0.0);
+    std::fill(std::begin(buffer) + (long) p, std::begin(buffer) + (long) (p + n), 123.0);
+    filter.filtfilt(buffer.data(), n, 1);
+    for (size_t i = p; i < p + n; ++i) {
+        ASSERT_NEAR(buffer[i], 0.0, 1e-9);
+    }
+}
+
+TEST(HighPassFilterTest, ThrowsOnInvalidParameters) {
+    EXPECT_THROW(HighPassFilter(4, 40e6, 65e6), IllegalArgumentException);
+    EXPECT_THROW(HighPassFilter(0, 1e6, 65e6), IllegalArgumentException);
+    HighPassFilter filter{4, 1e6, 65e6};
+    std::vector<double> buffer(100);
+    EXPECT_THROW(filter.filtfilt(buffer.data(), filter.getPadLength(), 1), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
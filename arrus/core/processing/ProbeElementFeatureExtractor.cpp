@@ -0,0 +1,339 @@
+#include "arrus/core/api/processing/ProbeElementFeatureExtractor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/external/eigen/Dense.h"
+#include "arrus/core/external/eigen/FFT.h"
+#include "arrus/core/processing/HighPassFilter.h"
+
+namespace arrus::processing {
+
+namespace {
+
+/** Envelope of the signal: the absolute value of the analytic signal (scipy.signal.hilbert). */
+void envelope(const double *x, size_t n, std::vector<double> &output) {
+    Eigen::FFT<double> fft;
+    std::vector<std::complex<double>> signal(x, x + n), spectrum;
+    fft.fwd(spectrum, signal);
+    for (size_t i = 1; i < n; ++i) {
+        if (2 * i < n) {
+            spectrum[i] *= 2.0;
+        } else if (2 * i > n) {
+            spectrum[i] = 0.0;
+        }
+    }
+    fft.inv(signal, spectrum);
+    output.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = std::abs(signal[i]);
+    }
+}
+
+/**
+ * Fits a*exp(-(x-x0)^2/(2*sigma^2)) to the given y (x = 0, 1, ..., n-1) with the Levenberg-Marquardt method
+ * with bounds: a in [0, max(y)], x0 in [0, n], sigma in [1, 0.9*n], starting from (max(y)/2, n/2, 20).
+ * Returns sigma, or 0 if the fit is not possible.
+ */
+double fitGaussianSigma(const std::vector<double> &y) {
+    const auto n = (double) y.size();
+    const double yMax = *std::max_element(std::begin(y), std::end(y));
+    if (std::all_of(std::begin(y), std::end(y), [](double v) { return v == 0.0; })) {
+        return 0.0;
+    }
+    const Eigen::Vector3d lower{0.0, 0.0, 1.0}, upper{yMax, n, 0.9 * n};
+    Eigen::Vector3d p{yMax / 2.0, n / 2.0, 20.0};
+    if ((p.array() < lower.array()).any() || (p.array() > upper.array()).any()) {
+        return 0.0;
+    }
+    auto cost = [&](const Eigen::Vector3d &params) {
+        double result = 0.0;
+        for (size_t i = 0; i < y.size(); ++i) {
+            const double d = (double) i - params[1];
+            const double r = params[0] * std::exp(-d * d / (2.0 * params[2] * params[2])) - y[i];
+            result += r * r;
+        }
+        return result;
+    };
+    double currentCost = cost(p);
+    double lambda = 1e-3;
+    for (int iteration = 0; iteration < 200 && lambda < 1e12; ++iteration) {
+        Eigen::Matrix3d jtj = Eigen::Matrix3d::Zero();
+        Eigen::Vector3d jtr = Eigen::Vector3d::Zero();
+        const double a = p[0], x0 = p[1], s = p[2];
+        for (size_t i = 0; i < y.size(); ++i) {
+            const double d = (double) i - x0;
+            const double e = std::exp(-d * d / (2.0 * s * s));
+            const Eigen::Vector3d j{e, a * e * d / (s * s), a * e * d * d / (s * s * s)};
+            jtj += j * j.transpose();
+            jtr += j * (a * e - y[i]);
+        }
+        bool improved = false;
+        while (!improved && lambda < 1e12) {
+            Eigen::Matrix3d lhs = jtj;
+            for (int i = 0; i < 3; ++i) {
+                lhs(i, i) += lambda * std::max(jtj(i, i), 1e-12);
+            }
+            Eigen::Vector3d candidate = (p - lhs.ldlt().solve(jtr)).cwiseMax(lower).cwiseMin(upper);
+            const double candidateCost = cost(candidate);
+            if (candidateCost < currentCost) {
+                improved = true;
+                const bool converged = currentCost - candidateCost <= 1e-12 * currentCost
+                    || (candidate - p).norm() <= 1e-10 * (p.norm() + 1e-10);
+                p = candidate;
+                currentCost = candidateCost;
+                lambda = std::max(lambda / 10.0, 1e-12);
+                if (converged) {
+                    return p[2];
+                }
+            } else {
+                lambda *= 10.0;
+            }
+        }
+    }
+    return p[2];
+}
+
+double median(std::vector<double> values) {
+    const size_t n = values.size();
+    auto middle = std::begin(values) + (std::ptrdiff_t) (n / 2);
+    std::nth_element(std::begin(values), middle, std::end(values));
+    if (n % 2 == 1) {
+        return *middle;
+    }
+    return (*middle + *std::max_element(std::begin(values), middle)) / 2.0;
+}
+
+}// namespace
+
+class ProbeElementFeatureExtractor::Impl {
+public:
+    /** The number of RX channels filtered together. */
+    static constexpr size_t RX_BLOCK_SIZE = 16;
+
+    Impl(size_t nFrames, size_t nTx, size_t nSamples, size_t nRx, float samplingFrequency, unsigned nSkippedSamples,
+         unsigned filterOrder, unsigned nThreads)
+        : nFrames(nFrames), nTx(nTx), nSamples(nSamples), nRx(nRx), samplingFrequency(samplingFrequency),
+          nSkippedSamples(nSkippedSamples), filterOrder(filterOrder) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nFrames > 0 && nTx > 0 && nRx > 0,
+                                         "The number of frames, TXs and RXs should be positive.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            nSamples > nSkippedSamples,
+            format("The number of samples ({}) should be greater than the number of skipped samples ({}).",
+                   nSamples, nSkippedSamples));
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(samplingFrequency > 0.0f, "Sampling frequency should be positive.");
+        if (nThreads == 0) {
+            nThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        this->nThreads = nThreads;
+        midRx = (nRx + 1) / 2 - 1;
+    }
+
+    template<typename T> void getMaxAmplitude(const T *rf, float cutoffFrequency, float32 *output) const {
+        HighPassFilter filter{filterOrder, cutoffFrequency, samplingFrequency};
+        const size_t p = filter.getPadLength();
+        runForTxs([&](size_t tx) {
+            std::vector<double> buffer((nSamples + 2 * p) * RX_BLOCK_SIZE), frameMax(nFrames, 0.0);
+            for (size_t frame = 0; frame < nFrames; ++frame) {
+                for (size_t rx = 0; rx < nRx; rx += RX_BLOCK_SIZE) {
+                    const size_t nChannels = std::min(RX_BLOCK_SIZE, nRx - rx);
+                    for (size_t sample = 0; sample < nSamples; ++sample) {
+                        const T *in = rf + getOffset(frame, tx, sample, rx);
+                        std::copy(in, in + nChannels, buffer.data() + (p + sample) * nChannels);
+                    }
+                    filter.filtfilt(buffer.data(), nSamples, nChannels);
+                    auto begin = std::begin(buffer) + (std::ptrdiff_t) ((p + nSkippedSamples) * nChannels);
+                    auto end = std::begin(buffer) + (std::ptrdiff_t) ((p + nSamples) * nChannels);
+                    for (auto it = begin; it != end; ++it) {
+                        frameMax[frame] = std::max(frameMax[frame], std::abs(*it));
+                    }
+                }
+            }
+            output[tx] = (float32) median(frameMax);
+        });
+    }
+
+    template<typename T> void getEnergy(const T *rf, float cutoffFrequency, float32 *output) const {
+        HighPassFilter filter{filterOrder, cutoffFrequency, samplingFrequency};
+        runForTxs([&](size_t tx) {
+            std::vector<double> buffer;
+            double sum = 0.0;
+            for (size_t frame = 0; frame < nFrames; ++frame) {
+                const double *x = filterMidRx(filter, rf, frame, tx, buffer);
+                const size_t n = nSamples - nSkippedSamples;
+                std::vector<double> power(n);
+                std::transform(x, x + n, std::begin(power), [](double v) { return v * v; });
+                auto [minIt, maxIt] = std::minmax_element(std::begin(power), std::end(power));
+                const double min = *minIt, range = *maxIt - *minIt;
+                if (range != 0.0) {
+                    for (double v : power) {
+                        sum += (v - min) / range;
+                    }
+                }
+            }
+            output[tx] = (float32) (sum / (double) nFrames);
+        });
+    }
+
+    template<typename T> void getSignalDuration(const T *rf, float cutoffFrequency, float32 *output) const {
+        HighPassFilter filter{filterOrder, cutoffFrequency, samplingFrequency};
+        runForTxs([&](size_t tx) {
+            std::vector<double> buffer, env;
+            double sum = 0.0;
+            for (size_t frame = 0; frame < nFrames; ++frame) {
+                const double *x = filterMidRx(filter, rf, frame, tx, buffer);
+                envelope(x, nSamples - nSkippedSamples, env);
+                sum += std::nearbyint(3.0 * fitGaussianSigma(env));
+            }
+            output[tx] = (float32) (sum / (double) nFrames);
+        });
+    }
+
+    template<typename T>
+    void getFootprintPcc(const T *rf, const T *footprint, size_t gateLength, float cutoffFrequency,
+                         float32 *output) const {
+        HighPassFilter filter{filterOrder, cutoffFrequency, samplingFrequency};
+        const size_t p = filter.getPadLength();
+        const size_t gateBegin = nSkippedSamples, gateEnd = std::min(nSkippedSamples + gateLength, nSamples);
+        runForTxs([&](size_t tx) {
+            // Channel 0: rf, channel 1: footprint, both averaged over frames.
+            std::vector<double> buffer((nSamples + 2 * p) * 2, 0.0);
+            for (size_t frame = 0; frame < nFrames; ++frame) {
+                for (size_t sample = 0; sample < nSamples; ++sample) {
+                    const size_t offset = getOffset(frame, tx, sample, midRx);
+                    buffer[(p + sample) * 2] += (double) rf[offset];
+                    buffer[(p + sample) * 2 + 1] += (double) footprint[offset];
+                }
+            }
+            for (size_t i = p * 2; i < (p + nSamples) * 2; ++i) {
+                buffer[i] /= (double) nFrames;
+            }
+            filter.filtfilt(buffer.data(), nSamples, 2);
+            const auto n = (double) (gateEnd - gateBegin);
+            double meanX = 0.0, meanY = 0.0;
+            for (size_t sample = gateBegin; sample < gateEnd; ++sample) {
+                meanX += buffer[(p + sample) * 2];
+                meanY += buffer[(p + sample) * 2 + 1];
+            }
+            meanX /= n;
+            meanY /= n;
+            double sxx = 0.0, syy = 0.0, sxy = 0.0;
+            for (size_t sample = gateBegin; sample < gateEnd; ++sample) {
+                const double dx = buffer[(p + sample) * 2] - meanX, dy = buffer[(p + sample) * 2 + 1] - meanY;
+                sxx += dx * dx;
+                syy += dy * dy;
+                sxy += dx * dy;
+            }
+            output[tx] = (sxx > 0.0 && syy > 0.0) ? (float32) (sxy / std::sqrt(sxx * syy))
+                                                  : std::numeric_limits<float32>::quiet_NaN();
+        });
+    }
+
+private:
+    size_t getOffset(size_t frame, size_t tx, size_t sample, size_t rx) const {
+        return ((frame * nTx + tx) * nSamples + sample) * nRx + rx;
+    }
+
+    /**
+     * High-pass filters the middle RX signal (starting from nSkippedSamples) of the given frame and TX.
+     * Returns pointer to the first filtered sample.
+     */
+    template<typename T>
+    const double *filterMidRx(const HighPassFilter &filter, const T *rf, size_t frame, size_t tx,
+                              std::vector<double> &buffer) const {
+        const size_t p = filter.getPadLength(), n = nSamples - nSkippedSamples;
+        buffer.resize(n + 2 * p);
+        for (size_t i = 0; i < n; ++i) {
+            buffer[p + i] = (double) rf[getOffset(frame, tx, nSkippedSamples + i, midRx)];
+        }
+        filter.filtfilt(buffer.data(), n, 1);
+        return buffer.data() + p;
+    }
+
+    /** Runs func(tx) for all TXs; contiguous ranges of TXs are distributed over threads. */
+    void runForTxs(const std::function<void(size_t)> &func) const {
+        const size_t nWorkers = std::min<size_t>(nThreads, nTx);
+        auto processTxs = [&func](size_t start, size_t end) {
+            for (size_t tx = start; tx < end; ++tx) {
+                func(tx);
+            }
+        };
+        if (nWorkers <= 1) {
+            processTxs(0, nTx);
+            return;
+        }
+        const size_t txsPerWorker = (nTx + nWorkers - 1) / nWorkers;
+        std::vector<std::thread> workers;
+        for (size_t start = 0; start < nTx; start += txsPerWorker) {
+            workers.emplace_back(processTxs, start, std::min(start + txsPerWorker, nTx));
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t nFrames, nTx, nSamples, nRx, midRx;
+    double samplingFrequency;
+    size_t nSkippedSamples;
+    unsigned filterOrder;
+    unsigned nThreads;
+};
+
+ProbeElementFeatureExtractor::ProbeElementFeatureExtractor(size_t nFrames, size_t nTx, size_t nSamples, size_t nRx,
+                                                           float samplingFrequency, unsigned nSkippedSamples,
+                                                           unsigned filterOrder, unsigned nThreads) {
+    this->impl = UniqueHandle<Impl>::create(nFrames, nTx, nSamples, nRx, samplingFrequency, nSkippedSamples,
+                                            filterOrder, nThreads);
+}
+
+void ProbeElementFeatureExtractor::getMaxAmplitude(const int16 *rf, float cutoffFrequency, float32 *output) const {
+    impl->getMaxAmplitude(rf, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getMaxAmplitude(const float32 *rf, float cutoffFrequency, float32 *output) const {
+    impl->getMaxAmplitude(rf, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getEnergy(const int16 *rf, float cutoffFrequency, float32 *output) const {
+    impl->getEnergy(rf, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getEnergy(const float32 *rf, float cutoffFrequency, float32 *output) const {
+    impl->getEnergy(rf, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getSignalDuration(const int16 *rf, float cutoffFrequency, float32 *output) const {
+    impl->getSignalDuration(rf, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getSignalDuration(const float32 *rf, float cutoffFrequency,
+                                                     float32 *output) const {
+    impl->getSignalDuration(rf, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getFootprintPcc(const int16 *rf, const int16 *footprint, size_t gateLength,
+                                                   float cutoffFrequency, float32 *output) const {
+    impl->getFootprintPcc(rf, footprint, gateLength, cutoffFrequency, output);
+}
+
+void ProbeElementFeatureExtractor::getFootprintPcc(const float32 *rf, const float32 *footprint, size_t gateLength,
+                                                   float cutoffFrequency, float32 *output) const {
+    impl->getFootprintPcc(rf, footprint, gateLength, cutoffFrequency, output);
+}
+
+ProbeElementFeatureExtractor::ProbeElementFeatureExtractor(const ProbeElementFeatureExtractor &o) = default;
+ProbeElementFeatureExtractor::ProbeElementFeatureExtractor(ProbeElementFeatureExtractor &&o) noexcept = default;
+ProbeElementFeatureExtractor::~ProbeElementFeatureExtractor() {}
+ProbeElementFeatureExtractor &
+ProbeElementFeatureExtractor::operator=(const ProbeElementFeatureExtractor &o) = default;
+ProbeElementFeatureExtractor &
+ProbeElementFeatureExtractor::operator=(ProbeElementFeatureExtractor &&o) noexcept = default;
+
+}// namespace arrus::processing
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "arrus/core/api/processing/ProbeElementFeatureExtractor.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+
+constexpr double PI = 3.14159265358979323846;
+constexpr float FS = 65e6f;
+constexpr size_t N_FRAMES = 3, N_TX = 5, N_SAMPLES = 512, N_RX = 8;
+constexpr size_t MID_RX = 3;
+
+/**
+ * RF data (nFrames, nTx, nSamples, nRx): a Gaussian-modulated sine (fs/8) with the given envelope sigma [samples],
+ * centered at sample 250, amplitude 100*(tx+1) (the middle RX channel) or 10*(tx+1) (the remaining channels).
+ */
+template<typename T> std::vector<T> getPulses(double sigma) {
+    std::vector<T> rf(N_FRAMES * N_TX * N_SAMPLES * N_RX);
+    for (size_t frame = 0; frame < N_FRAMES; ++frame) {
+        for (size_t tx = 0; tx < N_TX; ++tx) {
+            for (size_t sample = 0; sample < N_SAMPLES; ++sample) {
+                const double d = (double) sample - 250.0;
+                const double value = std::exp(-d * d / (2 * sigma * sigma)) * std::sin(2 * PI * (double) sample / 8);
+                for (size_t rx = 0; rx < N_RX; ++rx) {
+                    const double amplitude = (rx == MID_RX ? 100.0 : 10.0) * (double) (tx + 1);
+                    rf[((frame * N_TX + tx) * N_SAMPLES + sample) * N_RX + rx] = (T) std::round(amplitude * value);
+                }
+            }
+        }
+    }
+    return rf;
+}
+
+TEST(ProbeElementFeatureExtractorTest, ComputesMaxAmplitude) {
+    auto rf = getPulses<float32>(20.0);
+    for (unsigned nThreads : {1u, 3u}) {
+        ProbeElementFeatureExtractor extractor{N_FRAMES, N_TX, N_SAMPLES, N_RX, FS, 80, 4, nThreads};
+        std::vector<float32> output(N_TX);
+        extractor.getMaxAmplitude(rf.data(), 1e6f, output.data());
+        for (size_t tx = 0; tx < N_TX; ++tx) {
+            EXPECT_NEAR(output[tx], 100.0f * (float) (tx + 1), 1.0f * (float) (tx + 1)) << "tx: " << tx;
+        }
+    }
+}
+
+TEST(ProbeElementFeatureExtractorTest, ComputesTheSameFeaturesForInt16AndFloat) {
+    auto rf16 = getPulses<int16>(10.0);
+    auto rf32 = getPulses<float32>(10.0);
+    ProbeElementFeatureExtractor extractor{N_FRAMES, N_TX, N_SAMPLES, N_RX, FS, 80, 4, 2};
+    std::vector<float32> output16(N_TX), output32(N_TX);
+    extractor.getEnergy(rf16.data(), 1e5f, output16.data());
+    extractor.getEnergy(rf32.data(), 1e5f, output32.data());
+    EXPECT_EQ(output16, output32);
+    extractor.getSignalDuration(rf16.data(), 1e5f, output16.data());
+    extractor.getSignalDuration(rf32.data(), 1e5f, output32.data());
+    EXPECT_EQ(output16, output32);
+}
+
+TEST(ProbeElementFeatureExtractorTest, ComputesScaleInvariantEnergy) {
+    auto rf = getPulses<float32>(10.0);
+    ProbeElementFeatureExtractor extractor{N_FRAMES, N_TX, N_SAMPLES, N_RX, FS};
+    std::vector<float32> output(N_TX);
+    extractor.getEnergy(rf.data(), 1e5f, output.data());
+    // Energy normalized to [0, 1]: the pulse amplitude (tx) does not matter.
+    for (size_t tx = 0; tx < N_TX; ++tx) {
+        EXPECT_GT(output[tx], 1.0f);
+        EXPECT_NEAR(output[tx], output[0], 1e-2f * output[0]) << "tx: " << tx;
+    }
+    std::vector<float32> zeros(rf.size(), 0.0f);
+    extractor.getEnergy(zeros.data(), 1e5f, output.data());
+    EXPECT_EQ(output, std::vector<float32>(N_TX, 0.0f));
+}
+
+TEST(ProbeElementFeatureExtractorTest, ComputesSignalDuration) {
+    for (double sigma : {8.0, 15.0, 25.0}) {
+        auto rf = getPulses<float32>(sigma);
+        ProbeElementFeatureExtractor extractor{N_FRAMES, N_TX, N_SAMPLES, N_RX, FS};
+        std::vector<float32> output(N_TX);
+        extractor.getSignalDuration(rf.data(), 1e5f, output.data());
+        for (size_t tx = 0; tx < N_TX; ++tx) {
+            EXPECT_NEAR(output[tx], 3.0 * sigma, 1.0) << "sigma: " << sigma << ", tx: " << tx;
+        }
+    }
+}
+
+TEST(ProbeElementFeatureExtractorTest, ComputesFootprintPcc) {
+    auto rf = getPulses<float32>(10.0);
+    std::vector<float32> negated(rf.size()), constant(rf.size(), 7.0f);
+    std::transform(std::begin(rf), std::end(rf), std::begin(negated), [](float32 v) { return -v; });
+    ProbeElementFeatureExtractor extractor{N_FRAMES, N_TX, N_SAMPLES, N_RX, FS, 80, 4, 2};
+    std::vector<float32> output(N_TX);
+
+    extractor.getFootprintPcc(rf.data(), rf.data(), 256, 1e5f, output.data());
+    for (auto value : output) {
+        EXPECT_NEAR(value, 1.0f, 1e-5f);
+    }
+    extractor.getFootprintPcc(rf.data(), negated.data(), 256, 1e5f, output.data());
+    for (auto value : output) {
+        EXPECT_NEAR(value, -1.0f, 1e-5f);
+    }
+    extractor.getFootprintPcc(rf.data(), constant.data(), 256, 1e5f, output.data());
+    for (auto value : output) {
+        EXPECT_TRUE(std::isnan(value));
+    }
+}
+
+TEST(ProbeElementFeatureExtractorTest, ThrowsOnInvalidParameters) {
+    EXPECT_THROW(ProbeElementFeatureExtractor(0, N_TX, N_SAMPLES, N_RX), IllegalArgumentException);
+    EXPECT_THROW(ProbeElementFeatureExtractor(N_FRAMES, N_TX, 80, N_RX), IllegalArgumentException);
+    ProbeElementFeatureExtractor extractor{N_FRAMES, N_TX, N_SAMPLES, N_RX, FS};
+    std::vector<float32> rf(N_FRAMES * N_TX * N_SAMPLES * N_RX), output(N_TX);
+    EXPECT_THROW(extractor.getEnergy(rf.data(), 40e6f, output.data()), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
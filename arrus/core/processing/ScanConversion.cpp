@@ -0,0 +1,197 @@
+#include "ScanConversion.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/common/utils.h"
+
+namespace arrus::processing {
+
+namespace {
+// Points that are outside the input data by at most this number of samples (e.g. due to the rounding errors of the
+// output grid) are moved to the input data border.
+constexpr float EDGE_TOLERANCE = 1e-3f;
+}// namespace
+
+std::pair<float, float> ScanGeometry::getInputPosition(float x, float z) const {
+    float row, column;
+    if (type == Type::LINEAR) {
+        row = z;
+        column = x;
+    } else {
+        float zMoved = z + apexDepth;
+        row = std::hypot(x, zMoved) - curvatureRadius;
+        column = std::atan2(x, zMoved);
+    }
+    return {(row - rowOrigin) / rowStep, (column - columnOrigin) / columnStep};
+}
+
+ScanConverter::ScanConverter(ScanGeometry geometry, std::vector<float> xGrid, std::vector<float> zGrid,
+                             unsigned nThreads)
+    : geometry(geometry), xGrid(std::move(xGrid)), zGrid(std::move(zGrid)) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!this->xGrid.empty() && !this->zGrid.empty(),
+                                     "Scan conversion output grid cannot be empty.");
+    if (nThreads == 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    this->nThreads = nThreads;
+}
+
+void ScanConverter::prepare(size_t nSamples, size_t nScanLines) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nSamples >= 2 && nScanLines >= 2,
+                                     "Scan conversion input should have at least 2 samples and 2 scan lines.");
+    // Note: AVX2 gather uses signed 32-bit indices.
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nSamples * nScanLines <= (size_t) std::numeric_limits<int32>::max(),
+                                     "Scan conversion input frame is too large.");
+    const size_t nx = xGrid.size();
+    const size_t nz = zGrid.size();
+    this->nSamples = nSamples;
+    this->nScanLines = nScanLines;
+    nTilesX = (nx + TILE_SIZE - 1) / TILE_SIZE;
+    nTilesZ = (nz + TILE_SIZE - 1) / TILE_SIZE;
+    sourceIdx.clear();
+    destinationIdx.clear();
+    rowWeights.clear();
+    columnWeights.clear();
+    tileOffsets.clear();
+    const auto maxRow = (float) (nSamples - 1);
+    const auto maxColumn = (float) (nScanLines - 1);
+    for (size_t tz = 0; tz < nTilesZ; ++tz) {
+        for (size_t tx = 0; tx < nTilesX; ++tx) {
+            tileOffsets.push_back(sourceIdx.size());
+            for (size_t z = tz * TILE_SIZE; z < std::min(nz, (tz + 1) * TILE_SIZE); ++z) {
+                for (size_t x = tx * TILE_SIZE; x < std::min(nx, (tx + 1) * TILE_SIZE); ++x) {
+                    auto [row, column] = geometry.getInputPosition(xGrid[x], zGrid[z]);
+                    // Note: NaNs are rejected here too.
+                    if (!(row >= -EDGE_TOLERANCE && row <= maxRow + EDGE_TOLERANCE && column >= -EDGE_TOLERANCE
+                          && column <= maxColumn + EDGE_TOLERANCE)) {
+                        continue;
+                    }
+                    row = std::clamp(row, 0.0f, maxRow);
+                    column = std::clamp(column, 0.0f, maxColumn);
+                    auto i = std::min((size_t) row, nSamples - 2);
+                    auto j = std::min((size_t) column, nScanLines - 2);
+                    sourceIdx.push_back(ARRUS_SAFE_CAST(i * nScanLines + j, uint32));
+                    destinationIdx.push_back(ARRUS_SAFE_CAST(z * nx + x, uint32));
+                    rowWeights.push_back(row - (float) i);
+                    columnWeights.push_back(column - (float) j);
+                }
+            }
+        }
+    }
+    tileOffsets.push_back(sourceIdx.size());
+}
+
+void ScanConverter::processTiles(const float32 *input, float32 *output, size_t start, size_t end) const {
+    const size_t nTiles = nTilesX * nTilesZ;
+    const size_t nx = xGrid.size();
+    const size_t nz = zGrid.size();
+    const auto ns = (int32) nScanLines;
+    for (size_t unit = start; unit < end; ++unit) {
+        const size_t frame = unit / nTiles;
+        const size_t tile = unit % nTiles;
+        const float32 *in = input + frame * nSamples * nScanLines;
+        float32 *out = output + frame * nx * nz;
+        // Pixels outside the input data.
+        const size_t tz = tile / nTilesX, tx = tile % nTilesX;
+        const size_t xBegin = tx * TILE_SIZE, xEnd = std::min(nx, xBegin + TILE_SIZE);
+        for (size_t z = tz * TILE_SIZE; z < std::min(nz, (tz + 1) * TILE_SIZE); ++z) {
+            std::fill(out + z * nx + xBegin, out + z * nx + xEnd, 0.0f);
+        }
+        size_t k = tileOffsets[tile];
+        const size_t kEnd = tileOffsets[tile + 1];
+#if defined(__AVX2__) && defined(__FMA__)
+        alignas(32) float values[8];
+        for (; k + 8 <= kEnd; k += 8) {
+            __m256i idx = _mm256_loadu_si256((const __m256i *) (sourceIdx.data() + k));
+            __m256 a = _mm256_i32gather_ps(in, idx, 4);
+            __m256 b = _mm256_i32gather_ps(in + 1, idx, 4);
+            __m256 c = _mm256_i32gather_ps(in + ns, idx, 4);
+            __m256 d = _mm256_i32gather_ps(in + ns + 1, idx, 4);
+            __m256 wr = _mm256_loadu_ps(rowWeights.data() + k);
+            __m256 wc = _mm256_loadu_ps(columnWeights.data() + k);
+            __m256 top = _mm256_fmadd_ps(wc, _mm256_sub_ps(b, a), a);
+            __m256 bottom = _mm256_fmadd_ps(wc, _mm256_sub_ps(d, c), c);
+            _mm256_store_ps(values, _mm256_fmadd_ps(wr, _mm256_sub_ps(bottom, top), top));
+            for (size_t l = 0; l < 8; ++l) {
+                out[destinationIdx[k + l]] = values[l];
+            }
+        }
+#endif
+        for (; k < kEnd; ++k) {
+            const float32 *s = in + sourceIdx[k];
+            float wc = columnWeights[k];
+            float top = s[0] + wc * (s[1] - s[0]);
+            float bottom = s[ns] + wc * (s[ns + 1] - s[ns]);
+            out[destinationIdx[k]] = top + rowWeights[k] * (bottom - top);
+        }
+    }
+}
+
+void ScanConverter::process(const float32 *input, float32 *output, size_t nFrames) const {
+    if (tileOffsets.empty()) {
+        throw IllegalStateException("Scan converter should be prepared first.");
+    }
+    const size_t nUnits = nFrames * nTilesX * nTilesZ;
+    const size_t nWorkers = std::min<size_t>(nThreads, nUnits);
+    if (nWorkers <= 1) {
+        processTiles(input, output, 0, nUnits);
+        return;
+    }
+    const size_t unitsPerWorker = (nUnits + nWorkers - 1) / nWorkers;
+    std::vector<std::thread> workers;
+    for (size_t start = 0; start < nUnits; start += unitsPerWorker) {
+        size_t end = std::min(start + unitsPerWorker, nUnits);
+        workers.emplace_back([=]() { processTiles(input, output, start, end); });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void ScanConverter::process(const framework::NdArray &input, framework::NdArray &output) const {
+    const auto &inputShape = input.getShape().getValues();
+    const auto &outputShape = output.getShape().getValues();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        input.getDataType() == framework::NdArray::DataType::FLOAT32
+            && output.getDataType() == framework::NdArray::DataType::FLOAT32,
+        "Scan conversion input and output should be float32 arrays.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        inputShape.size() >= 2 && inputShape[inputShape.size() - 2] == nSamples && inputShape.back() == nScanLines,
+        format("Scan conversion input should have shape (..., {}, {}).", nSamples, nScanLines));
+    const size_t nFrames = input.getNumberOfElements() / (nSamples * nScanLines);
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(output.getNumberOfElements() == nFrames * getNumberOfPixels()
+                                         && outputShape.size() >= 2 && outputShape.back() == xGrid.size(),
+                                     format("Scan conversion output should have shape (..., {}, {}).", zGrid.size(),
+                                            xGrid.size()));
+    process(input.get<float32>(), output.get<float32>(), nFrames);
+}
+
+framework::graph::ArrayDef ScanConversionNode::prepare(const std::vector<framework::graph::ArrayDef> &inputs) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(inputs.size() == 1, "Scan conversion node should have exactly one input.");
+    std::vector<size_t> shape = inputs[0].getShape().getValues();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        inputs[0].getDataType() == framework::NdArray::DataType::FLOAT32 && shape.size() >= 2,
+        "Scan conversion node input should be a float32 array with shape (..., nSamples, nScanLines).");
+    converter.prepare(shape[shape.size() - 2], shape[shape.size() - 1]);
+    shape.pop_back();
+    shape.pop_back();
+    shape.push_back(converter.getZGrid().size());
+    shape.push_back(converter.getXGrid().size());
+    return framework::graph::ArrayDef{framework::NdArray::Shape{shape}, framework::NdArray::DataType::FLOAT32};
+}
+
+void ScanConversionNode::process(const std::vector<const framework::NdArray *> &inputs, framework::NdArray &output) {
+    converter.process(*inputs.at(0), output);
+}
+
+}// namespace arrus::processing
@@ -0,0 +1,148 @@
+#ifndef ARRUS_CORE_PROCESSING_SCANCONVERSION_H
+#define ARRUS_CORE_PROCESSING_SCANCONVERSION_H
+
+#include <utility>
+#include <vector>
+
+#include "arrus/core/framework/graph/Graph.h"
+
+namespace arrus::processing {
+
+/**
+ * Geometry of the input (scan line) data: positions of the input samples (rows) and scan lines (columns).
+ */
+class ScanGeometry {
+public:
+    enum class Type {
+        /** Parallel scan lines, e.g. linear array with moving aperture. */
+        LINEAR,
+        /** Scan lines with a common apex, e.g. phased array or convex array. */
+        SECTOR
+    };
+
+    /**
+     * Linear scanning: sample i of the scan line j is located at (x, z) = (xOrigin + j*xStep, zOrigin + i*zStep).
+     */
+    static ScanGeometry linear(float zOrigin, float zStep, float xOrigin, float xStep) {
+        return ScanGeometry{Type::LINEAR, zOrigin, zStep, xOrigin, xStep, 0.0f, 0.0f};
+    }
+
+    /**
+     * Sector scanning: sample i of the scan line j is located at the radial distance radiusOrigin + i*radiusStep
+     * and azimuth angle (measured from the OZ axis) azimuthOrigin + j*azimuthStep.
+     *
+     * For convex probes, the radial distance is measured from the probe surface, i.e. the point (x, z) has the radial
+     * distance sqrt(x^2 + (z+apexDepth)^2) - curvatureRadius, where apexDepth is the distance of the probe curvature
+     * center from the origin (curvatureRadius - max(elementPositionZ)). For phased arrays both parameters are zero.
+     */
+    static ScanGeometry sector(float radiusOrigin, float radiusStep, float azimuthOrigin, float azimuthStep,
+                               float curvatureRadius = 0.0f, float apexDepth = 0.0f) {
+        return ScanGeometry{Type::SECTOR, radiusOrigin, radiusStep, azimuthOrigin, azimuthStep, curvatureRadius,
+                            apexDepth};
+    }
+
+    Type getType() const { return type; }
+
+    /**
+     * Returns the position of the given point (x, z) [m] in the input data, expressed in (fractional) sample and
+     * scan line numbers.
+     */
+    std::pair<float, float> getInputPosition(float x, float z) const;
+
+private:
+    ScanGeometry(Type type, float rowOrigin, float rowStep, float columnOrigin, float columnStep,
+                 float curvatureRadius, float apexDepth)
+        : type(type), rowOrigin(rowOrigin), rowStep(rowStep), columnOrigin(columnOrigin), columnStep(columnStep),
+          curvatureRadius(curvatureRadius), apexDepth(apexDepth) {}
+
+    Type type;
+    float rowOrigin, rowStep;
+    float columnOrigin, columnStep;
+    float curvatureRadius, apexDepth;
+};
+
+/**
+ * Scan conversion: bilinear interpolation of the scan line data (nSamples, nScanLines) on the given output grid
+ * (nz, nx). Output pixels outside the input data are set to 0.
+ *
+ * The mapping is fixed for the given geometry and grid, so it is computed once (see prepare) and stored as a lookup
+ * table: for each output pixel inside the input data, the index of the top-left input sample and the two
+ * interpolation weights. The table is ordered by output tiles (TILE_SIZE x TILE_SIZE pixels), so that the input
+ * samples used by subsequent entries are close to each other in memory. The table is applied with AVX2 gathers (when
+ * available at compile time), the tiles are distributed over the given number of threads.
+ */
+class ScanConverter {
+public:
+    static constexpr size_t TILE_SIZE = 32;
+
+    /**
+     * @param geometry input data geometry
+     * @param xGrid output grid points along OX axis [m]
+     * @param zGrid output grid points along OZ axis [m]
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    ScanConverter(ScanGeometry geometry, std::vector<float> xGrid, std::vector<float> zGrid, unsigned nThreads = 0);
+
+    /**
+     * Computes the lookup table for the input data with the given number of samples and scan lines.
+     */
+    void prepare(size_t nSamples, size_t nScanLines);
+
+    /**
+     * Converts the given frames. The converter must be prepared first.
+     *
+     * @param input input data, shape: (nFrames, nSamples, nScanLines)
+     * @param output output images, shape: (nFrames, nz, nx)
+     */
+    void process(const float32 *input, float32 *output, size_t nFrames) const;
+
+    /**
+     * Converts the given FLOAT32 array (..., nSamples, nScanLines) to the array (..., nz, nx).
+     */
+    void process(const framework::NdArray &input, framework::NdArray &output) const;
+
+    const std::vector<float> &getXGrid() const { return xGrid; }
+
+    const std::vector<float> &getZGrid() const { return zGrid; }
+
+    size_t getNumberOfPixels() const { return xGrid.size() * zGrid.size(); }
+
+    /** The number of output pixels inside the input data. */
+    size_t getLookupTableSize() const { return sourceIdx.size(); }
+
+private:
+    /** Processes the given range of (frame, tile) pairs (frame-major order). */
+    void processTiles(const float32 *input, float32 *output, size_t start, size_t end) const;
+
+    ScanGeometry geometry;
+    std::vector<float> xGrid, zGrid;
+    unsigned nThreads;
+    size_t nSamples{0}, nScanLines{0};
+    size_t nTilesX{0}, nTilesZ{0};
+    // Lookup table (structure of arrays), ordered by tiles.
+    std::vector<uint32> sourceIdx;
+    std::vector<uint32> destinationIdx;
+    std::vector<float> rowWeights;
+    std::vector<float> columnWeights;
+    // Lookup table entries of tile t: [tileOffsets[t], tileOffsets[t+1]).
+    std::vector<size_t> tileOffsets;
+};
+
+/**
+ * Graph node that applies scan conversion (see ScanConverter).
+ */
+class ScanConversionNode : public framework::graph::Node {
+public:
+    explicit ScanConversionNode(ScanConverter converter) : converter(std::move(converter)) {}
+
+    framework::graph::ArrayDef prepare(const std::vector<framework::graph::ArrayDef> &inputs) override;
+
+    void process(const std::vector<const framework::NdArray *> &inputs, framework::NdArray &output) override;
+
+private:
+    ScanConverter converter;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_PROCESSING_SCANCONVERSION_H
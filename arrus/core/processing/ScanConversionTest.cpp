@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "arrus/core/processing/ScanConversion.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using arrus::framework::NdArray;
+using arrus::framework::graph::ArrayDef;
+
+std::vector<float> linspace(float start, float end, size_t n) {
+    std::vector<float> result(n);
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = start + (end - start) * (float) i / (float) (n - 1);
+    }
+    return result;
+}
+
+/** Input data: value(frame, i, j) = frame*1000 + i + 10*j (bilinear interpolation is exact for this function). */
+std::vector<float> getInput(size_t nFrames, size_t nSamples, size_t nScanLines) {
+    std::vector<float> result(nFrames * nSamples * nScanLines);
+    for (size_t f = 0; f < nFrames; ++f) {
+        for (size_t i = 0; i < nSamples; ++i) {
+            for (size_t j = 0; j < nScanLines; ++j) {
+                result[(f * nSamples + i) * nScanLines + j] = (float) f * 1000.0f + (float) i + 10.0f * (float) j;
+            }
+        }
+    }
+    return result;
+}
+
+void verify(const ScanGeometry &geometry, const std::vector<float> &xGrid, const std::vector<float> &zGrid,
+            size_t nFrames, size_t nSamples, size_t nScanLines, unsigned nThreads) {
+    ScanConverter converter{geometry, xGrid, zGrid, nThreads};
+    converter.prepare(nSamples, nScanLines);
+    auto input = getInput(nFrames, nSamples, nScanLines);
+    std::vector<float> output(nFrames * zGrid.size() * xGrid.size(), -1.0f);
+    converter.process(input.data(), output.data(), nFrames);
+    size_t nInside = 0;
+    for (size_t f = 0; f < nFrames; ++f) {
+        for (size_t z = 0; z < zGrid.size(); ++z) {
+            for (size_t x = 0; x < xGrid.size(); ++x) {
+                auto [row, column] = geometry.getInputPosition(xGrid[x], zGrid[z]);
+                const float tolerance = 1e-3f;
+                bool isInside = row >= -tolerance && row <= (float) (nSamples - 1) + tolerance
+                    && column >= -tolerance && column <= (float) (nScanLines - 1) + tolerance;
+                float expected = isInside ? (float) f * 1000.0f + row + 10.0f * column : 0.0f;
+                nInside += isInside;
+                ASSERT_NEAR(output[(f * zGrid.size() + z) * xGrid.size() + x], expected, 1e-2f)
+                    << "frame " << f << ", z " << z << ", x " << x;
+            }
+        }
+    }
+    EXPECT_EQ(nInside, nFrames * converter.getLookupTableSize());
+}
+
+TEST(ScanConversionTest, LinearGeometry) {
+    // 128 scan lines, pitch 0.3 mm, 1024 samples, 0.0118 mm per sample.
+    auto geometry = ScanGeometry::linear(1e-3f, 1.18e-5f, -19.05e-3f, 0.3e-3f);
+    verify(geometry, linspace(-25e-3f, 25e-3f, 201), linspace(0.0f, 15e-3f, 151), 2, 1024, 128, 1);
+}
+
+TEST(ScanConversionTest, SectorGeometryPhasedArray) {
+    auto geometry = ScanGeometry::sector(0.0f, 1.18e-5f, -0.6f, 1.2f / 63.0f);
+    verify(geometry, linspace(-10e-3f, 10e-3f, 97), linspace(0.0f, 12e-3f, 131), 3, 1024, 64, 4);
+}
+
+TEST(ScanConversionTest, SectorGeometryConvexArray) {
+    const float radius = 50e-3f;
+    auto geometry = ScanGeometry::sector(0.0f, 2e-5f, -0.5f, 1.0f / 127.0f, radius, radius - 1e-3f);
+    verify(geometry, linspace(-30e-3f, 30e-3f, 150), linspace(0.0f, 20e-3f, 100), 2, 1024, 128, 3);
+}
+
+TEST(ScanConversionTest, NodeDeterminesOutputShape) {
+    auto geometry = ScanGeometry::linear(0.0f, 1e-4f, 0.0f, 1e-4f);
+    ScanConversionNode node{ScanConverter{geometry, linspace(0.0f, 1e-3f, 20), linspace(0.0f, 2e-3f, 30), 2}};
+    auto def = node.prepare({ArrayDef{NdArray::Shape{4, 21, 11}, NdArray::DataType::FLOAT32}});
+    EXPECT_EQ(def, (ArrayDef{NdArray::Shape{4, 30, 20}, NdArray::DataType::FLOAT32}));
+
+    const devices::DeviceId cpu{devices::DeviceType::CPU, 0};
+    NdArray input{NdArray::Shape{4, 21, 11}, NdArray::DataType::FLOAT32, cpu, "input"};
+    auto data = getInput(4, 21, 11);
+    std::copy(std::begin(data), std::end(data), input.get<float>());
+    NdArray output{def.getShape(), def.getDataType(), cpu, "output"};
+    node.process({&input}, output);
+    // The last frame: the first and the last pixel (the corners of the input data).
+    EXPECT_NEAR(output.get<float>()[(3 * 30 + 0) * 20 + 0], 3000.0f, 1e-3f);
+    EXPECT_NEAR(output.get<float>()[(3 * 30 + 29) * 20 + 19], 3000.0f + 20.0f + 100.0f, 1e-2f);
+
+    NdArray invalidInput{NdArray::Shape{4, 20, 11}, NdArray::DataType::FLOAT32, cpu, "input"};
+    EXPECT_THROW(node.process({&invalidInput}, output), IllegalArgumentException);
+}
+
+TEST(ScanConversionTest, ThrowsWhenNotPrepared) {
+    ScanConverter converter{ScanGeometry::linear(0.0f, 1.0f, 0.0f, 1.0f), {0.0f}, {0.0f}};
+    float input[4] = {0}, output[1];
+    EXPECT_THROW(converter.process(input, output, 1), IllegalStateException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
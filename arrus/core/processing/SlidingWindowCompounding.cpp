@@ -0,0 +1,95 @@
+#include "SlidingWindowCompounding.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+
+namespace arrus::processing {
+
+SlidingWindowCompounding::SlidingWindowCompounding(size_t windowSize, size_t nValues, bool average,
+                                                   size_t refreshPeriod)
+    : windowSize(windowSize), nValues(nValues), average(average), refreshPeriod(refreshPeriod),
+      ring(windowSize * nValues), sum(nValues, 0.0f) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(windowSize > 0, "Compounding window size should be positive.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(refreshPeriod > 0, "Compounding refresh period should be positive.");
+}
+
+void SlidingWindowCompounding::push(const float32 *lri, float32 *output) {
+    float *slot = ring.data() + next * nValues;
+    float *s = sum.data();
+    if (isFull()) {
+        // Replace the oldest LRI.
+        for (size_t i = 0; i < nValues; ++i) {
+            s[i] += lri[i] - slot[i];
+        }
+    } else {
+        for (size_t i = 0; i < nValues; ++i) {
+            s[i] += lri[i];
+        }
+        ++count;
+    }
+    std::copy(lri, lri + nValues, slot);
+    next = (next + 1) % windowSize;
+    if (++nUpdates % refreshPeriod == 0) {
+        refresh();
+    }
+    if (average) {
+        const float scale = 1.0f / (float) count;
+        for (size_t i = 0; i < nValues; ++i) {
+            output[i] = s[i] * scale;
+        }
+    } else {
+        std::copy(std::begin(sum), std::end(sum), output);
+    }
+}
+
+void SlidingWindowCompounding::reset() {
+    std::fill(std::begin(sum), std::end(sum), 0.0f);
+    next = 0;
+    count = 0;
+    nUpdates = 0;
+}
+
+void SlidingWindowCompounding::refresh() {
+    std::fill(std::begin(sum), std::end(sum), 0.0f);
+    // Note: until the window is full, slots [0, count) are used.
+    for (size_t slot = 0; slot < count; ++slot) {
+        const float *lri = ring.data() + slot * nValues;
+        for (size_t i = 0; i < nValues; ++i) {
+            sum[i] += lri[i];
+        }
+    }
+}
+
+framework::graph::ArrayDef
+SlidingWindowCompoundingNode::prepare(const std::vector<framework::graph::ArrayDef> &inputs) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(inputs.size() == 1, "Compounding node should have exactly one input.");
+    const auto &shape = inputs[0].getShape().getValues();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        inputs[0].getDataType() == framework::NdArray::DataType::FLOAT32 && shape.size() >= 2,
+        "Compounding node input should be a float32 array with shape (nLris, ...).");
+    compounding.emplace(windowSize, inputs[0].getShape().product() / shape[0], average);
+    return inputs[0];
+}
+
+void SlidingWindowCompoundingNode::process(const std::vector<const framework::NdArray *> &inputs,
+                                           framework::NdArray &output) {
+    const framework::NdArray &input = *inputs.at(0);
+    if (!compounding.has_value()) {
+        throw IllegalStateException("Compounding node should be prepared first.");
+    }
+    const size_t nValues = compounding->getNumberOfValues();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(input.getDataType() == framework::NdArray::DataType::FLOAT32
+                                         && input.getNumberOfElements() % nValues == 0
+                                         && output.getNumberOfElements() == input.getNumberOfElements(),
+                                     format("Compounding node expects float32 arrays of LRIs, {} values each.",
+                                            nValues));
+    const size_t nLris = input.getNumberOfElements() / nValues;
+    for (size_t i = 0; i < nLris; ++i) {
+        compounding->push(input.get<float32>() + i * nValues, output.get<float32>() + i * nValues);
+    }
+}
+
+}// namespace arrus::processing
@@ -0,0 +1,93 @@
+#ifndef ARRUS_CORE_PROCESSING_SLIDINGWINDOWCOMPOUNDING_H
+#define ARRUS_CORE_PROCESSING_SLIDINGWINDOWCOMPOUNDING_H
+
+#include <optional>
+#include <vector>
+
+#include "arrus/core/framework/graph/Graph.h"
+
+namespace arrus::processing {
+
+/**
+ * Coherent compounding of the last windowSize low-resolution images (LRIs), updated incrementally.
+ *
+ * The compounder keeps a ring of the last windowSize LRIs and their sum. Each new LRI replaces the oldest one and
+ * the sum is updated by subtracting the oldest and adding the newest image, so producing a compounded frame costs
+ * O(nValues) regardless of the window size. With plane-wave imaging, this gives one compounded frame per TX
+ * (angle) instead of one per full sequence.
+ *
+ * To limit the accumulation of the floating point rounding errors, the sum is recomputed from the ring every
+ * refreshPeriod updates.
+ *
+ * Until windowSize LRIs are collected, the compound of the LRIs collected so far is returned.
+ */
+class SlidingWindowCompounding {
+public:
+    static constexpr size_t DEFAULT_REFRESH_PERIOD = 1024;
+
+    /**
+     * @param windowSize the number of compounded LRIs (e.g. the number of TX angles)
+     * @param nValues the number of float values of a single LRI (2*nPixels for complex images)
+     * @param average whether to return the mean instead of the sum of LRIs
+     * @param refreshPeriod the number of updates after which the sum is recomputed from the stored LRIs
+     */
+    SlidingWindowCompounding(size_t windowSize, size_t nValues, bool average = false,
+                             size_t refreshPeriod = DEFAULT_REFRESH_PERIOD);
+
+    /**
+     * Adds a new LRI to the window and writes the current compounded image to the output.
+     *
+     * @param lri new low-resolution image (nValues values)
+     * @param output output compounded image (nValues values)
+     */
+    void push(const float32 *lri, float32 *output);
+
+    /** Forgets all collected LRIs. */
+    void reset();
+
+    /** Returns true if the window contains windowSize LRIs. */
+    bool isFull() const { return count == windowSize; }
+
+    size_t getWindowSize() const { return windowSize; }
+
+    size_t getNumberOfValues() const { return nValues; }
+
+private:
+    void refresh();
+
+    size_t windowSize, nValues;
+    bool average;
+    size_t refreshPeriod;
+    /** Ring of LRIs: [slot*nValues + i]. */
+    std::vector<float> ring;
+    std::vector<float> sum;
+    /** The slot to write the next LRI to (the oldest LRI when the window is full). */
+    size_t next{0};
+    size_t count{0};
+    size_t nUpdates{0};
+};
+
+/**
+ * Graph node that applies sliding-window compounding (see SlidingWindowCompounding) to a batch of LRIs.
+ *
+ * Input: FLOAT32 array (nLris, ...), output: FLOAT32 array with the same shape, where output[i] is the compound of
+ * the last windowSize LRIs up to and including the input[i] (the window is kept between the subsequent batches).
+ */
+class SlidingWindowCompoundingNode : public framework::graph::Node {
+public:
+    SlidingWindowCompoundingNode(size_t windowSize, bool average = false)
+        : windowSize(windowSize), average(average) {}
+
+    framework::graph::ArrayDef prepare(const std::vector<framework::graph::ArrayDef> &inputs) override;
+
+    void process(const std::vector<const framework::NdArray *> &inputs, framework::NdArray &output) override;
+
+private:
+    size_t windowSize;
+    bool average;
+    std::optional<SlidingWindowCompounding> compounding;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_PROCESSING_SLIDINGWINDOWCOMPOUNDING_H
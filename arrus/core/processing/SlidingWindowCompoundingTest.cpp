@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "arrus/core/processing/SlidingWindowCompounding.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using arrus::framework::NdArray;
+using arrus::framework::graph::ArrayDef;
+
+std::vector<float> getLris(size_t nLris, size_t nValues) {
+    std::mt19937 generator{2023};
+    std::uniform_real_distribution<float> distribution{-100.0f, 100.0f};
+    std::vector<float> result(nLris * nValues);
+    for (auto &value : result) {
+        value = distribution(generator);
+    }
+    return result;
+}
+
+/** The compound of LRIs [max(0, i-windowSize+1), i]. */
+std::vector<double> getExpected(const std::vector<float> &lris, size_t i, size_t windowSize, size_t nValues,
+                                bool average) {
+    std::vector<double> result(nValues, 0.0);
+    size_t first = i + 1 >= windowSize ? i + 1 - windowSize : 0;
+    for (size_t j = first; j <= i; ++j) {
+        for (size_t k = 0; k < nValues; ++k) {
+            result[k] += lris[j * nValues + k];
+        }
+    }
+    if (average) {
+        for (auto &value : result) {
+            value /= (double) (i - first + 1);
+        }
+    }
+    return result;
+}
+
+TEST(SlidingWindowCompoundingTest, MatchesFullCompounding) {
+    const size_t windowSize = 7, nValues = 2 * 300, nLris = 100;
+    for (bool average : {false, true}) {
+        auto lris = getLris(nLris, nValues);
+        SlidingWindowCompounding compounding{windowSize, nValues, average, 16};
+        std::vector<float> output(nValues);
+        for (size_t i = 0; i < nLris; ++i) {
+            compounding.push(lris.data() + i * nValues, output.data());
+            EXPECT_EQ(compounding.isFull(), i + 1 >= windowSize);
+            auto expected = getExpected(lris, i, windowSize, nValues, average);
+            for (size_t k = 0; k < nValues; ++k) {
+                ASSERT_NEAR(output[k], expected[k], 1e-3) << "LRI " << i << ", value " << k;
+            }
+        }
+        compounding.reset();
+        EXPECT_FALSE(compounding.isFull());
+        compounding.push(lris.data(), output.data());
+        EXPECT_EQ(output[0], lris[0]);
+    }
+}
+
+TEST(SlidingWindowCompoundingTest, NodeKeepsWindowBetweenBatches) {
+    const size_t windowSize = 4, nTx = 4, nx = 5, nz = 6;
+    const size_t nValues = nx * nz * 2;
+    SlidingWindowCompoundingNode node{windowSize};
+    ArrayDef def{NdArray::Shape{nTx, nx, nz, 2}, NdArray::DataType::FLOAT32};
+    EXPECT_EQ(node.prepare({def}), def);
+
+    const devices::DeviceId cpu{devices::DeviceType::CPU, 0};
+    auto lris = getLris(3 * nTx, nValues);
+    NdArray input{def.getShape(), def.getDataType(), cpu, "input"};
+    NdArray output{def.getShape(), def.getDataType(), cpu, "output"};
+    for (size_t batch = 0; batch < 3; ++batch) {
+        std::copy(lris.data() + batch * nTx * nValues, lris.data() + (batch + 1) * nTx * nValues,
+                  input.get<float>());
+        node.process({&input}, output);
+        for (size_t tx = 0; tx < nTx; ++tx) {
+            auto expected = getExpected(lris, batch * nTx + tx, windowSize, nValues, false);
+            for (size_t k = 0; k < nValues; ++k) {
+                ASSERT_NEAR(output.get<float>()[tx * nValues + k], expected[k], 1e-3);
+            }
+        }
+    }
+}
+
+TEST(SlidingWindowCompoundingTest, ThrowsOnInvalidParameters) {
+    EXPECT_THROW(SlidingWindowCompounding(0, 10), IllegalArgumentException);
+    SlidingWindowCompoundingNode node{2};
+    const devices::DeviceId cpu{devices::DeviceType::CPU, 0};
+    NdArray input{NdArray::Shape{2, 3}, NdArray::DataType::FLOAT32, cpu, "input"};
+    EXPECT_THROW(node.process({&input}, input), IllegalStateException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
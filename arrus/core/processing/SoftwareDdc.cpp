@@ -0,0 +1,223 @@
+#include "SoftwareDdc.h"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+
+namespace arrus::processing {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/**
+ * Returns the interpolation factor L, such that decimationFactor*L is an integer.
+ */
+unsigned getInterpolationFactorFor(float decimationFactor) {
+    float fraction = decimationFactor - std::floor(decimationFactor);
+    if (fraction == 0.0f) {
+        return 1;
+    } else if (fraction == 0.5f) {
+        return 2;
+    } else if (fraction == 0.25f || fraction == 0.75f) {
+        return 4;
+    } else {
+        throw IllegalArgumentException(
+            format("Unsupported DDC decimation factor: {}, the fractional part should be equal 0, 0.25, 0.5 or 0.75.",
+                   decimationFactor));
+    }
+}
+
+template<typename OutputType> OutputType convert(float value);
+
+template<> inline float32 convert<float32>(float value) { return value; }
+
+template<> inline int16 convert<int16>(float value) {
+    float result = std::nearbyint(value);
+    result = std::min(result, (float) std::numeric_limits<int16>::max());
+    result = std::max(result, (float) std::numeric_limits<int16>::min());
+    return static_cast<int16>(result);
+}
+
+}// namespace
+
+SoftwareDdc::SoftwareDdc(const ops::us4r::DigitalDownConversion &ddc, float samplingFrequency, unsigned nThreads)
+    : demodulationFrequency(ddc.getDemodulationFrequency()), samplingFrequency(samplingFrequency) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(samplingFrequency > 0.0f, "Sampling frequency should be positive.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(ddc.getDecimationFactor() >= 1.0f, "DDC decimation factor should be >= 1.");
+    auto coefficients = ddc.getFirCoefficients();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(coefficients.size() > 0, "DDC FIR filter coefficients cannot be empty.");
+
+    interpolation = getInterpolationFactorFor(ddc.getDecimationFactor());
+    decimation = static_cast<unsigned>(std::lround(ddc.getDecimationFactor() * (float) interpolation));
+    if (nThreads == 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    this->nThreads = nThreads;
+    // Only the upper half of the symmetric filter is provided (the same convention as for the us4OEM DDC).
+    const float *coeffs = coefficients.data();
+    const size_t nCoeffs = coefficients.size();
+    filter = std::vector<float>(std::reverse_iterator<const float *>(coeffs + nCoeffs),
+                                std::reverse_iterator<const float *>(coeffs));
+    filter.insert(std::end(filter), coeffs, coeffs + nCoeffs);
+}
+
+size_t SoftwareDdc::getNumberOfOutputSamples(size_t nSamples) const {
+    return nSamples * interpolation / decimation;
+}
+
+void SoftwareDdc::prepare(size_t nSamples) {
+    if (nSamples == currentNSamples) {
+        return;
+    }
+    // Output sample m: y[m] = sum_k h[k]*L * xu[m*M + c - k], where xu is the mixed input signal interpolated with
+    // zeros (L-1 zeros between subsequent samples), M is the decimation factor at the interpolated rate, c is the
+    // filter center. Only the taps that correspond to the input samples (i.e. the non-zero elements of xu) are kept;
+    // the quadrature mixing (2*exp(-j*omega*n)) is folded into the tap weights.
+    const auto nOutputSamples = getNumberOfOutputSamples(nSamples);
+    const auto nInterpolated = (long long) (nSamples * interpolation);
+    const auto center = (long long) (filter.size() / 2);
+    const double omega = 2.0 * PI * demodulationFrequency / samplingFrequency;
+    taps.clear();
+    tapOffsets.clear();
+    tapOffsets.reserve(nOutputSamples + 1);
+    for (size_t m = 0; m < nOutputSamples; ++m) {
+        tapOffsets.push_back(taps.size());
+        for (size_t k = 0; k < filter.size(); ++k) {
+            long long j = (long long) (m * decimation) + center - (long long) k;
+            if (j < 0 || j >= nInterpolated || j % interpolation != 0) {
+                continue;
+            }
+            auto n = (uint32_t) (j / interpolation);
+            double weight = 2.0 * filter[k] * interpolation;
+            taps.push_back(Tap{n, (float) (weight * std::cos(omega * n)), (float) (-weight * std::sin(omega * n))});
+        }
+    }
+    tapOffsets.push_back(taps.size());
+    currentNSamples = nSamples;
+}
+
+template<typename OutputType>
+void SoftwareDdc::processRange(const int16 *input, OutputType *output, size_t nSamples, size_t nChannels,
+                               size_t rowStart, size_t rowEnd) const {
+    const size_t nOutputSamples = getNumberOfOutputSamples(nSamples);
+    // I and Q rows for a single output sample.
+    std::vector<float> acc(2 * nChannels);
+    for (size_t row = rowStart; row < rowEnd; ++row) {
+        const size_t frame = row / nOutputSamples;
+        const size_t m = row % nOutputSamples;
+        const int16 *frameInput = input + frame * nSamples * nChannels;
+        const Tap *tapsBegin = taps.data() + tapOffsets[m];
+        const Tap *tapsEnd = taps.data() + tapOffsets[m + 1];
+        float *accI = acc.data();
+        float *accQ = acc.data() + nChannels;
+        size_t ch = 0;
+#if defined(__AVX512F__)
+        for (; ch + 16 <= nChannels; ch += 16) {
+            __m512 i = _mm512_setzero_ps();
+            __m512 q = _mm512_setzero_ps();
+            for (const Tap *tap = tapsBegin; tap != tapsEnd; ++tap) {
+                auto raw = _mm256_loadu_si256((const __m256i *) (frameInput + tap->sample * nChannels + ch));
+                __m512 x = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(raw));
+                i = _mm512_fmadd_ps(x, _mm512_set1_ps(tap->i), i);
+                q = _mm512_fmadd_ps(x, _mm512_set1_ps(tap->q), q);
+            }
+            _mm512_storeu_ps(accI + ch, i);
+            _mm512_storeu_ps(accQ + ch, q);
+        }
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+        for (; ch + 8 <= nChannels; ch += 8) {
+            __m256 i = _mm256_setzero_ps();
+            __m256 q = _mm256_setzero_ps();
+            for (const Tap *tap = tapsBegin; tap != tapsEnd; ++tap) {
+                auto raw = _mm_loadu_si128((const __m128i *) (frameInput + tap->sample * nChannels + ch));
+                __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(raw));
+                i = _mm256_fmadd_ps(x, _mm256_set1_ps(tap->i), i);
+                q = _mm256_fmadd_ps(x, _mm256_set1_ps(tap->q), q);
+            }
+            _mm256_storeu_ps(accI + ch, i);
+            _mm256_storeu_ps(accQ + ch, q);
+        }
+#endif
+        // Scalar fallback (and the remaining channels).
+        if (ch < nChannels) {
+            std::fill(accI + ch, accI + nChannels, 0.0f);
+            std::fill(accQ + ch, accQ + nChannels, 0.0f);
+            for (const Tap *tap = tapsBegin; tap != tapsEnd; ++tap) {
+                const int16 *x = frameInput + tap->sample * nChannels;
+                for (size_t c = ch; c < nChannels; ++c) {
+                    accI[c] += tap->i * (float) x[c];
+                    accQ[c] += tap->q * (float) x[c];
+                }
+            }
+        }
+        OutputType *out = output + row * 2 * nChannels;
+        std::transform(std::begin(acc), std::end(acc), out, convert<OutputType>);
+    }
+}
+
+template<typename OutputType>
+void SoftwareDdc::run(const int16 *input, OutputType *output, size_t nFrames, size_t nSamples, size_t nChannels) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(input != nullptr && output != nullptr, "Input and output cannot be null.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(getNumberOfOutputSamples(nSamples) > 0,
+                                     format("Too few input samples for DDC: {}", nSamples));
+    prepare(nSamples);
+    const size_t nRows = nFrames * getNumberOfOutputSamples(nSamples);
+    const size_t nWorkers = std::min<size_t>(nThreads, nRows);
+    if (nWorkers <= 1) {
+        processRange(input, output, nSamples, nChannels, 0, nRows);
+        return;
+    }
+    const size_t rowsPerWorker = (nRows + nWorkers - 1) / nWorkers;
+    std::vector<std::thread> workers;
+    for (size_t start = 0; start < nRows; start += rowsPerWorker) {
+        size_t end = std::min(start + rowsPerWorker, nRows);
+        workers.emplace_back([=]() { processRange(input, output, nSamples, nChannels, start, end); });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void SoftwareDdc::process(const int16 *input, float32 *output, size_t nFrames, size_t nSamples, size_t nChannels) {
+    run(input, output, nFrames, nSamples, nChannels);
+}
+
+void SoftwareDdc::process(const int16 *input, int16 *output, size_t nFrames, size_t nSamples, size_t nChannels) {
+    run(input, output, nFrames, nSamples, nChannels);
+}
+
+void SoftwareDdc::process(const framework::NdArray &input, framework::NdArray &output, size_t nSamples) {
+    using DataType = framework::NdArray::DataType;
+    const auto &inputShape = input.getShape();
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(input.getDataType() == DataType::INT16, "DDC input should be an int16 array.");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(inputShape.size() == 2, "DDC input should be a 2D array (samples, channels).");
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        nSamples > 0 && inputShape[0] % nSamples == 0,
+        format("The number of input rows ({}) should be a multiple of the number of samples ({}).", inputShape[0],
+               nSamples));
+    const size_t nFrames = inputShape[0] / nSamples;
+    const size_t nChannels = inputShape[1];
+    const std::vector<size_t> expectedShape{nFrames * getNumberOfOutputSamples(nSamples), 2, nChannels};
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        output.getShape().getValues() == expectedShape,
+        format("Invalid DDC output shape, expected: ({}, 2, {})", expectedShape[0], nChannels));
+    if (output.getDataType() == DataType::FLOAT32) {
+        process(input.get<int16>(), output.get<float32>(), nFrames, nSamples, nChannels);
+    } else {
+        process(input.get<int16>(), output.get<int16>(), nFrames, nSamples, nChannels);
+    }
+}
+
+}// namespace arrus::processing
@@ -0,0 +1,107 @@
+#ifndef ARRUS_CORE_PROCESSING_SOFTWAREDDC_H
+#define ARRUS_CORE_PROCESSING_SOFTWAREDDC_H
+
+#include <cstdint>
+#include <vector>
+
+#include "arrus/core/api/common/types.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/api/framework/NdArray.h"
+#include "arrus/core/api/ops/us4r/DigitalDownConversion.h"
+
+namespace arrus::processing {
+
+/**
+ * CPU implementation of the us4OEM digital down conversion (quadrature mixing, FIR low-pass filtering, decimation).
+ *
+ * The DDC parameters are interpreted in the same way as by the us4OEM hardware DDC (see
+ * ops::us4r::DigitalDownConversion): only the upper half of the (symmetric) FIR filter is provided, the decimation
+ * factor can have a fractional part 0.25, 0.5 or 0.75. Contrary to the hardware DDC, the length of the FIR filter
+ * is not limited.
+ *
+ * The mixing, filtering and decimation are fused into a single polyphase pass: for each output sample, only the
+ * taps that are not multiplied by zeros (in the interpolated signal) are evaluated, and the mixing oscillator is
+ * folded into the filter weights. The output layout is the same as the layout of the data produced by the hardware
+ * DDC, i.e. (nSamples, 2, nChannels) for each frame (I and Q rows for each sample).
+ *
+ * The computations are vectorized over channels (AVX-512 or AVX2 when available at compile time, scalar otherwise)
+ * and distributed over the given number of threads.
+ */
+class SoftwareDdc {
+public:
+    /**
+     * @param ddc DDC parameters
+     * @param samplingFrequency input data sampling frequency [Hz]
+     * @param nThreads number of threads to use; 0 means the number of hardware threads
+     */
+    SoftwareDdc(const ops::us4r::DigitalDownConversion &ddc, float samplingFrequency, unsigned nThreads = 0);
+
+    /**
+     * Returns the number of output (IQ) samples, for the given number of input (RF) samples.
+     */
+    size_t getNumberOfOutputSamples(size_t nSamples) const;
+
+    /**
+     * Applies DDC on the given RF frames.
+     *
+     * @param input RF data, shape: (nFrames*nSamples, nChannels)
+     * @param output output IQ data, shape: (nFrames*nOutputSamples, 2, nChannels)
+     */
+    void process(const int16 *input, float32 *output, size_t nFrames, size_t nSamples, size_t nChannels);
+
+    /**
+     * Same as above, the output values are rounded and saturated to int16 (the data type of the hardware DDC output).
+     */
+    void process(const int16 *input, int16 *output, size_t nFrames, size_t nSamples, size_t nChannels);
+
+    /**
+     * Applies DDC on the given array.
+     *
+     * @param input INT16 RF data, shape: (nFrames*nSamples, nChannels)
+     * @param output INT16 or FLOAT32 array with shape (nFrames*nOutputSamples, 2, nChannels)
+     * @param nSamples number of samples of a single frame
+     */
+    void process(const framework::NdArray &input, framework::NdArray &output, size_t nSamples);
+
+    /** Interpolation factor of the polyphase filter (4 for quarter decimation factors). */
+    unsigned getInterpolationFactor() const { return interpolation; }
+
+    /** Decimation factor of the polyphase filter (at the interpolated rate). */
+    unsigned getDecimationFactor() const { return decimation; }
+
+    /** The complete (symmetric) FIR filter. */
+    const std::vector<float> &getFirFilter() const { return filter; }
+
+private:
+    /** Weight of a single input sample, for the given output sample. */
+    struct Tap {
+        uint32_t sample;
+        float i;
+        float q;
+    };
+
+    void prepare(size_t nSamples);
+
+    template<typename OutputType>
+    void processRange(const int16 *input, OutputType *output, size_t nSamples, size_t nChannels, size_t rowStart,
+                      size_t rowEnd) const;
+
+    template<typename OutputType>
+    void run(const int16 *input, OutputType *output, size_t nFrames, size_t nSamples, size_t nChannels);
+
+    float demodulationFrequency;
+    float samplingFrequency;
+    unsigned interpolation;
+    unsigned decimation;
+    unsigned nThreads;
+    std::vector<float> filter;
+
+    // Taps for the current number of input samples: output sample m uses taps [tapOffsets[m], tapOffsets[m+1]).
+    size_t currentNSamples{0};
+    std::vector<Tap> taps;
+    std::vector<size_t> tapOffsets;
+};
+
+}// namespace arrus::processing
+
+#endif//ARRUS_CORE_PROCESSING_SOFTWAREDDC_H
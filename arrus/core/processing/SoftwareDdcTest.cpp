@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "arrus/core/processing/SoftwareDdc.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using arrus::framework::NdArray;
+using arrus::ops::us4r::DigitalDownConversion;
+
+constexpr float FS = 65e6f;
+
+std::vector<int16> getRandomRf(size_t n) {
+    std::mt19937 generator{2023};
+    std::uniform_int_distribution<int> distribution{-2000, 2000};
+    std::vector<int16> result(n);
+    for (auto &value : result) {
+        value = (int16) distribution(generator);
+    }
+    return result;
+}
+
+/**
+ * Reference implementation: mixing, interpolation (with zeros), filtering with the full filter, decimation.
+ */
+std::vector<float> referenceDdc(const std::vector<int16> &rf, size_t nFrames, size_t nSamples, size_t nChannels,
+                                float fc, const std::vector<float> &filter, unsigned l, unsigned m) {
+    const size_t nOut = nSamples * l / m;
+    const long long nInterp = (long long) (nSamples * l);
+    const long long center = (long long) filter.size() / 2;
+    std::vector<float> result(nFrames * nOut * 2 * nChannels);
+    for (size_t frame = 0; frame < nFrames; ++frame) {
+        for (size_t ch = 0; ch < nChannels; ++ch) {
+            std::vector<double> i(nInterp, 0.0), q(nInterp, 0.0);
+            for (size_t n = 0; n < nSamples; ++n) {
+                double x = rf[(frame * nSamples + n) * nChannels + ch];
+                double phase = 2.0 * M_PI * fc * (double) n / FS;
+                i[n * l] = 2.0 * x * std::cos(phase) * l;
+                q[n * l] = -2.0 * x * std::sin(phase) * l;
+            }
+            for (size_t o = 0; o < nOut; ++o) {
+                double accI = 0.0, accQ = 0.0;
+                for (size_t k = 0; k < filter.size(); ++k) {
+                    long long j = (long long) (o * m) + center - (long long) k;
+                    if (j >= 0 && j < nInterp) {
+                        accI += filter[k] * i[j];
+                        accQ += filter[k] * q[j];
+                    }
+                }
+                result[((frame * nOut + o) * 2 + 0) * nChannels + ch] = (float) accI;
+                result[((frame * nOut + o) * 2 + 1) * nChannels + ch] = (float) accQ;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<float> getLowPassUpperHalf(size_t n) {
+    std::vector<float> result(n);
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = 1.0f / (float) (i + 1) / (float) n;
+    }
+    return result;
+}
+
+void testAgainstReference(float decimationFactor, size_t nHalfTaps, size_t nFrames, size_t nSamples,
+                          size_t nChannels, unsigned nThreads) {
+    const float fc = 5e6f;
+    DigitalDownConversion ddc{fc, getLowPassUpperHalf(nHalfTaps), decimationFactor};
+    SoftwareDdc softwareDdc{ddc, FS, nThreads};
+    auto rf = getRandomRf(nFrames * nSamples * nChannels);
+    const size_t nOut = softwareDdc.getNumberOfOutputSamples(nSamples);
+    ASSERT_EQ(nOut, (size_t) std::floor((float) nSamples / decimationFactor));
+
+    std::vector<float> output(nFrames * nOut * 2 * nChannels);
+    softwareDdc.process(rf.data(), output.data(), nFrames, nSamples, nChannels);
+    auto expected = referenceDdc(rf, nFrames, nSamples, nChannels, fc, softwareDdc.getFirFilter(),
+                                 softwareDdc.getInterpolationFactor(), softwareDdc.getDecimationFactor());
+    ASSERT_EQ(output.size(), expected.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_NEAR(output[i], expected[i], 1e-3f * (1.0f + std::abs(expected[i]))) << "at index " << i;
+    }
+}
+
+TEST(SoftwareDdcTest, IntegerDecimationFactor) {
+    testAgainstReference(4.0f, 32, 3, 256, 37, 1);
+}
+
+TEST(SoftwareDdcTest, HalfDecimationFactor) {
+    testAgainstReference(2.5f, 40, 2, 250, 32, 1);
+}
+
+TEST(SoftwareDdcTest, QuarterDecimationFactor) {
+    testAgainstReference(3.25f, 104, 2, 260, 19, 1);
+}
+
+TEST(SoftwareDdcTest, LongFilterMultipleThreads) {
+    testAgainstReference(8.0f, 256, 5, 512, 64, 4);
+}
+
+TEST(SoftwareDdcTest, SaturatesInt16Output) {
+    DigitalDownConversion ddc{0.0f, std::vector<float>{1.0f}, 2.0f};
+    SoftwareDdc softwareDdc{ddc, FS, 1};
+    // fc = 0: I[m] = 2*(x[2m] + x[2m+1]), Q = 0.
+    std::vector<int16> rf{30000, 30000, -100, -101};
+    std::vector<int16> output(2 * 2 * 1);
+    softwareDdc.process(rf.data(), output.data(), 1, 4, 1);
+    EXPECT_EQ(output[0], 32767);
+    EXPECT_EQ(output[1], 0);
+    EXPECT_EQ(output[2], 2 * (-100 - 101));
+    EXPECT_EQ(output[3], 0);
+}
+
+TEST(SoftwareDdcTest, ProcessesNdArrays) {
+    DigitalDownConversion ddc{5e6f, getLowPassUpperHalf(16), 4.0f};
+    SoftwareDdc softwareDdc{ddc, FS};
+    const devices::DeviceId cpu{devices::DeviceType::CPU, 0};
+    NdArray input{NdArray::Shape{2 * 128, 16}, NdArray::DataType::INT16, cpu, "rf"};
+    auto rf = getRandomRf(2 * 128 * 16);
+    std::copy(std::begin(rf), std::end(rf), input.get<int16>());
+    NdArray output{NdArray::Shape{2 * 32, 2, 16}, NdArray::DataType::FLOAT32, cpu, "iq"};
+    softwareDdc.process(input, output, 128);
+    std::vector<float> expected(2 * 32 * 2 * 16);
+    softwareDdc.process(rf.data(), expected.data(), 2, 128, 16);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(output.get<float>()[i], expected[i]);
+    }
+    NdArray invalidOutput{NdArray::Shape{2 * 31, 2, 16}, NdArray::DataType::FLOAT32, cpu, "iq"};
+    EXPECT_THROW(softwareDdc.process(input, invalidOutput, 128), IllegalArgumentException);
+    EXPECT_THROW(softwareDdc.process(input, output, 100), IllegalArgumentException);
+}
+
+TEST(SoftwareDdcTest, ThrowsOnUnsupportedDecimationFactor) {
+    DigitalDownConversion ddc{5e6f, getLowPassUpperHalf(16), 4.1f};
+    EXPECT_THROW((SoftwareDdc{ddc, FS}), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+#include "arrus/core/api/processing/SvdClutterFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/external/eigen/Dense.h"
+
+namespace arrus::processing {
+
+class SvdClutterFilter::Impl {
+public:
+    /** The number of pixels (rows of the Casorati matrix) processed at once. */
+    static constexpr size_t BLOCK_SIZE = 2048;
+
+    using Complex = std::complex<float>;
+    using Matrix = Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>;
+    using MatrixD = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic>;
+    using ConstMap = Eigen::Map<const Matrix>;
+    using Map = Eigen::Map<Matrix>;
+
+    Impl(size_t nFrames, size_t nPixels, unsigned nTissueComponents, unsigned nNoiseComponents, unsigned nThreads)
+        : nFrames(nFrames), nPixels(nPixels), nTissueComponents(nTissueComponents),
+          nNoiseComponents(nNoiseComponents) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nFrames >= 2, "The ensemble should contain at least two frames.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nPixels > 0, "The number of pixels should be positive.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            (size_t) nTissueComponents + nNoiseComponents < nFrames,
+            format("The number of removed components ({} tissue, {} noise) should be less than the ensemble "
+                   "length ({}).", nTissueComponents, nNoiseComponents, nFrames));
+        if (nThreads == 0) {
+            nThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        this->nThreads = nThreads;
+        casorati.resize((Eigen::Index) nPixels, (Eigen::Index) nFrames);
+    }
+
+    size_t push(const float32 *frames, size_t n) {
+        n = std::min(n, nFrames - nCollected);
+        auto destination = reinterpret_cast<float32 *>(casorati.data() + nCollected * nPixels);
+        std::copy(frames, frames + 2 * n * nPixels, destination);
+        nCollected += n;
+        return n;
+    }
+
+    bool isReady() const { return nCollected == nFrames; }
+
+    void process(float32 *output) {
+        ARRUS_REQUIRES_TRUE_E(isReady(), IllegalStateException(format(
+            "The ensemble is not complete yet ({} of {} frames).", nCollected, nFrames)));
+        filter(casorati.data(), reinterpret_cast<Complex *>(output));
+        nCollected = 0;
+    }
+
+    void process(const float32 *iq, float32 *output) {
+        filter(reinterpret_cast<const Complex *>(iq), reinterpret_cast<Complex *>(output));
+    }
+
+    void reset() { nCollected = 0; }
+
+    std::vector<float> getSingularValues() const { return singularValues; }
+
+    size_t getNumberOfFrames() const { return nFrames; }
+
+    size_t getNumberOfPixels() const { return nPixels; }
+
+private:
+    void filter(const Complex *input, Complex *output) {
+        ConstMap s{input, (Eigen::Index) nPixels, (Eigen::Index) nFrames};
+        Map out{output, (Eigen::Index) nPixels, (Eigen::Index) nFrames};
+        const auto n = (Eigen::Index) nFrames;
+
+        // Gram matrix S^H*S; each block is computed in single precision, the blocks are accumulated in double.
+        std::vector<MatrixD> partialGrams;
+        runBlocks([&](size_t worker, size_t start, size_t end) {
+            MatrixD &gram = partialGrams[worker];
+            gram = MatrixD::Zero(n, n);
+            Matrix blockGram(n, n);
+            for (size_t row = start; row < end; row += BLOCK_SIZE) {
+                auto block = s.middleRows((Eigen::Index) row, (Eigen::Index) std::min(BLOCK_SIZE, end - row));
+                // Only the lower triangle is computed (and used by the eigensolver).
+                blockGram.setZero();
+                blockGram.selfadjointView<Eigen::Lower>().rankUpdate(block.adjoint());
+                gram += blockGram.cast<std::complex<double>>();
+            }
+        }, [&](size_t nWorkers) { partialGrams.resize(nWorkers); });
+        MatrixD gram = MatrixD::Zero(n, n);
+        for (auto &partial : partialGrams) {
+            gram += partial;
+        }
+
+        // Eigenvalues in ascending order: sigma_i^2.
+        Eigen::SelfAdjointEigenSolver<MatrixD> solver(gram);
+        const auto &eigenvalues = solver.eigenvalues();
+        singularValues.resize(nFrames);
+        for (size_t i = 0; i < nFrames; ++i) {
+            singularValues[i] = (float) std::sqrt(std::max(eigenvalues((Eigen::Index) (nFrames - 1 - i)), 0.0));
+        }
+        const auto &v = solver.eigenvectors();
+        const auto nNoise = (Eigen::Index) nNoiseComponents, nTissue = (Eigen::Index) nTissueComponents;
+        const Eigen::Index nKept = n - nNoise - nTissue;
+        // Project onto the smaller of the two subspaces: S*Vk*Vk^H = S - S*Vr*Vr^H.
+        const bool projectOnKept = nKept <= n - nKept;
+        Matrix basis;
+        if (projectOnKept) {
+            basis = v.middleCols(nNoise, nKept).cast<Complex>();
+        } else {
+            basis.resize(n, n - nKept);
+            basis.leftCols(nNoise) = v.leftCols(nNoise).cast<Complex>();
+            basis.rightCols(nTissue) = v.rightCols(nTissue).cast<Complex>();
+        }
+        const Matrix basisAdjoint = basis.adjoint();
+        runBlocks([&](size_t, size_t start, size_t end) {
+            Matrix coefficients;
+            for (size_t row = start; row < end; row += BLOCK_SIZE) {
+                const auto r = (Eigen::Index) row, nRows = (Eigen::Index) std::min(BLOCK_SIZE, end - row);
+                coefficients.noalias() = s.middleRows(r, nRows) * basis;
+                auto outBlock = out.middleRows(r, nRows);
+                if (projectOnKept) {
+                    outBlock.noalias() = coefficients * basisAdjoint;
+                } else {
+                    if (output != input) {
+                        outBlock = s.middleRows(r, nRows);
+                    }
+                    outBlock.noalias() -= coefficients * basisAdjoint;
+                }
+            }
+        });
+    }
+
+    /**
+     * Runs func(worker, start, end) for contiguous ranges of pixels, one range per worker.
+     * onStart is called with the number of workers, before any of them starts.
+     */
+    void runBlocks(const std::function<void(size_t, size_t, size_t)> &func,
+                   const std::function<void(size_t)> &onStart = [](size_t) {}) const {
+        const size_t nBlocks = (nPixels + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const size_t nWorkers = std::min<size_t>(nThreads, nBlocks);
+        const size_t blocksPerWorker = (nBlocks + nWorkers - 1) / nWorkers;
+        const size_t nRanges = (nBlocks + blocksPerWorker - 1) / blocksPerWorker;
+        onStart(nRanges);
+        if (nRanges == 1) {
+            func(0, 0, nPixels);
+            return;
+        }
+        std::vector<std::thread> workers;
+        for (size_t worker = 0; worker < nRanges; ++worker) {
+            size_t start = worker * blocksPerWorker * BLOCK_SIZE;
+            size_t end = std::min(start + blocksPerWorker * BLOCK_SIZE, nPixels);
+            workers.emplace_back(func, worker, start, end);
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t nFrames, nPixels;
+    unsigned nTissueComponents, nNoiseComponents;
+    unsigned nThreads;
+    /** The accumulated ensemble: column i is the i-th frame. */
+    Matrix casorati;
+    size_t nCollected{0};
+    std::vector<float> singularValues;
+};
+
+SvdClutterFilter::SvdClutterFilter(size_t nFrames, size_t nPixels, unsigned nTissueComponents,
+                                   unsigned nNoiseComponents, unsigned nThreads) {
+    this->impl = UniqueHandle<Impl>::create(nFrames, nPixels, nTissueComponents, nNoiseComponents, nThreads);
+}
+
+size_t SvdClutterFilter::push(const float32 *frames, size_t n) { return impl->push(frames, n); }
+
+bool SvdClutterFilter::isReady() const { return impl->isReady(); }
+
+void SvdClutterFilter::process(float32 *output) { impl->process(output); }
+
+void SvdClutterFilter::process(const float32 *iq, float32 *output) { impl->process(iq, output); }
+
+void SvdClutterFilter::reset() { impl->reset(); }
+
+std::vector<float> SvdClutterFilter::getSingularValues() const { return impl->getSingularValues(); }
+
+size_t SvdClutterFilter::getNumberOfFrames() const { return impl->getNumberOfFrames(); }
+
+size_t SvdClutterFilter::getNumberOfPixels() const { return impl->getNumberOfPixels(); }
+
+SvdClutterFilter::SvdClutterFilter(const SvdClutterFilter &o) = default;
+SvdClutterFilter::SvdClutterFilter(SvdClutterFilter &&o) noexcept = default;
+SvdClutterFilter::~SvdClutterFilter() {}
+SvdClutterFilter &SvdClutterFilter::operator=(const SvdClutterFilter &o) = default;
+SvdClutterFilter &SvdClutterFilter::operator=(SvdClutterFilter &&o) noexcept = default;
+
+}// namespace arrus::processing
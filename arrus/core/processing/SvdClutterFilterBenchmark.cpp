@@ -0,0 +1,52 @@
+/**
+ * Measures the SVD clutter filter processing time for the ensemble sizes 64-512, single and multiple threads.
+ *
+ * Usage: processing_SvdClutterFilterBenchmark [nPixels] [nRepeats] [nThreads]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "arrus/core/api/processing/SvdClutterFilter.h"
+
+namespace {
+
+using namespace arrus;
+
+template<typename F> double measure(F &&func, size_t nRepeats) {
+    func();// warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nRepeats; ++i) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / (double) nRepeats;
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    size_t nPixels = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 128 * 256;
+    size_t nRepeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5;
+    unsigned nThreads = argc > 3 ? (unsigned) std::strtoul(argv[3], nullptr, 10) : 0;
+
+    std::mt19937 generator{2023};
+    std::normal_distribution<float> distribution{0.0f, 1000.0f};
+    std::cout << "Frame size: " << nPixels << " pixels" << std::endl;
+    for (size_t nFrames : {64, 128, 256, 512}) {
+        std::vector<float> iq(2 * nFrames * nPixels), output(iq.size());
+        std::generate(std::begin(iq), std::end(iq), [&]() { return distribution(generator); });
+        const auto nTissue = (unsigned) (nFrames / 16);
+        for (unsigned threads : {1u, nThreads}) {
+            processing::SvdClutterFilter filter{nFrames, nPixels, nTissue, 0, threads};
+            double time = measure([&]() { filter.process(iq.data(), output.data()); }, nRepeats);
+            std::cout << "ensemble: " << nFrames << ", threads: " << (threads == 0 ? "all" : std::to_string(threads))
+                      << ": " << time * 1e3 << " ms/ensemble, " << (double) nFrames / time << " frames/s"
+                      << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "arrus/core/api/processing/SvdClutterFilter.h"
+#include "arrus/core/common/logging.h"
+#include "arrus/core/external/eigen/Dense.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using MatrixD = Eigen::Matrix<std::complex<double>, Eigen::Dynamic, Eigen::Dynamic>;
+
+/**
+ * Random ensemble (nFrames, nPixels): a sum of nFrames components with well separated amplitudes (so that the filtered
+ * subspace is well defined): a strong "tissue" components and weaker "blood" and "noise" components.
+ */
+std::vector<float> getEnsemble(size_t nFrames, size_t nPixels) {
+    std::mt19937 generator{2023};
+    std::normal_distribution<float> distribution{0.0f, 1.0f};
+    std::vector<std::complex<float>> result(nFrames * nPixels, 0.0f);
+    float amplitude = 100.0f;
+    for (size_t k = 0; k < nFrames; ++k) {
+        std::vector<std::complex<float>> u(nPixels);
+        for (auto &value : u) {
+            value = {distribution(generator), distribution(generator)};
+        }
+        const float frequency = 0.3f * (float) k + 0.05f * distribution(generator);
+        for (size_t f = 0; f < nFrames; ++f) {
+            auto v = amplitude * std::polar(1.0f, frequency * (float) f);
+            for (size_t p = 0; p < nPixels; ++p) {
+                result[f * nPixels + p] += u[p] * v;
+            }
+        }
+        amplitude *= 0.7f;
+    }
+    std::vector<float> interleaved(2 * result.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        interleaved[2 * i] = result[i].real();
+        interleaved[2 * i + 1] = result[i].imag();
+    }
+    return interleaved;
+}
+
+/** Reference: full SVD of the Casorati matrix, in double precision. */
+MatrixD reference(const std::vector<float> &iq, size_t nFrames, size_t nPixels, unsigned nTissue, unsigned nNoise,
+                  std::vector<double> &singularValues) {
+    MatrixD s(nPixels, nFrames);
+    for (size_t f = 0; f < nFrames; ++f) {
+        for (size_t p = 0; p < nPixels; ++p) {
+            s(p, f) = {iq[2 * (f * nPixels + p)], iq[2 * (f * nPixels + p) + 1]};
+        }
+    }
+    Eigen::JacobiSVD<MatrixD> svd(s, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    auto sigma = svd.singularValues();
+    singularValues.assign(sigma.data(), sigma.data() + sigma.size());
+    // Singular values in descending order.
+    for (size_t i = 0; i < nFrames; ++i) {
+        if (i < nTissue || i >= nFrames - nNoise) {
+            sigma(i) = 0.0;
+        }
+    }
+    return svd.matrixU() * sigma.asDiagonal() * svd.matrixV().adjoint();
+}
+
+void verify(const std::vector<float> &output, const MatrixD &expected, size_t nFrames, size_t nPixels) {
+    for (size_t f = 0; f < nFrames; ++f) {
+        for (size_t p = 0; p < nPixels; ++p) {
+            ASSERT_NEAR(output[2 * (f * nPixels + p)], expected(p, f).real(), 2e-2) << "frame " << f << " pixel " << p;
+            ASSERT_NEAR(output[2 * (f * nPixels + p) + 1], expected(p, f).imag(), 2e-2)
+                << "frame " << f << " pixel " << p;
+        }
+    }
+}
+
+TEST(SvdClutterFilterTest, RemovesTissueComponents) {
+    const size_t nFrames = 16, nPixels = 5000;
+    auto iq = getEnsemble(nFrames, nPixels);
+    std::vector<double> expectedSingularValues;
+    auto expected = reference(iq, nFrames, nPixels, 2, 0, expectedSingularValues);
+
+    for (unsigned nThreads : {1u, 3u}) {
+        SvdClutterFilter filter{nFrames, nPixels, 2, 0, nThreads};
+        std::vector<float> output(iq.size());
+        filter.process(iq.data(), output.data());
+        verify(output, expected, nFrames, nPixels);
+        auto singularValues = filter.getSingularValues();
+        ASSERT_EQ(singularValues.size(), nFrames);
+        for (size_t i = 0; i < nFrames; ++i) {
+            EXPECT_NEAR(singularValues[i], expectedSingularValues[i], 1e-3 * expectedSingularValues[0]);
+        }
+    }
+}
+
+TEST(SvdClutterFilterTest, RemovesTissueAndNoiseComponentsInPlace) {
+    const size_t nFrames = 12, nPixels = 3000;
+    auto iq = getEnsemble(nFrames, nPixels);
+    std::vector<double> singularValues;
+    // Most of the components removed: projection onto the kept components.
+    auto expected = reference(iq, nFrames, nPixels, 2, 7, singularValues);
+    SvdClutterFilter filter{nFrames, nPixels, 2, 7, 2};
+    filter.process(iq.data(), iq.data());
+    verify(iq, expected, nFrames, nPixels);
+}
+
+TEST(SvdClutterFilterTest, AccumulatesEnsemble) {
+    const size_t nFrames = 10, nPixels = 2500;
+    auto iq = getEnsemble(nFrames, nPixels);
+    std::vector<double> singularValues;
+    auto expected = reference(iq, nFrames, nPixels, 1, 1, singularValues);
+
+    SvdClutterFilter filter{nFrames, nPixels, 1, 1, 2};
+    std::vector<float> output(iq.size());
+    EXPECT_THROW(filter.process(output.data()), IllegalStateException);
+    EXPECT_EQ(filter.push(iq.data(), 4), 4);
+    EXPECT_FALSE(filter.isReady());
+    // Only the missing frames are taken.
+    EXPECT_EQ(filter.push(iq.data() + 2 * 4 * nPixels, 8), 6);
+    EXPECT_TRUE(filter.isReady());
+    filter.process(output.data());
+    verify(output, expected, nFrames, nPixels);
+    EXPECT_FALSE(filter.isReady());
+}
+
+TEST(SvdClutterFilterTest, ThrowsOnInvalidParameters) {
+    EXPECT_THROW(SvdClutterFilter(1, 100, 0), IllegalArgumentException);
+    EXPECT_THROW(SvdClutterFilter(8, 100, 5, 3), IllegalArgumentException);
+    EXPECT_THROW(SvdClutterFilter(8, 0, 1), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,448 @@
+#include "arrus/core/api/processing/VolumeReconstruction.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+
+namespace arrus::processing {
+
+namespace {
+constexpr double PI = 3.14159265358979323846;
+}// namespace
+
+class VolumeReconstruction::Impl {
+public:
+    /** Voxel tile size (z is the innermost, contiguous dimension of the output). */
+    static constexpr size_t TILE_Z = 32, TILE_X = 4, TILE_Y = 2;
+    static constexpr size_t TILE_SIZE = TILE_Z * TILE_X * TILE_Y;
+    /** RX element block size. */
+    static constexpr size_t BLOCK_X = 4, BLOCK_Y = 4;
+    static constexpr size_t BLOCK_SIZE = BLOCK_X * BLOCK_Y;
+
+    Impl(const VolumeReconstructionSettings &settings, unsigned nThreads) : s(settings) {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!s.xGrid.empty() && !s.yGrid.empty() && !s.zGrid.empty(),
+                                         "The output grid cannot be empty.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!s.xElements.empty() && !s.yElements.empty(),
+                                         "Probe element positions cannot be empty.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!s.rxApodization.empty(), "RX apodization cannot be empty.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(s.speedOfSound > 0.0f && s.samplingFrequency > 0.0f,
+                                         "Speed of sound and sampling frequency should be positive.");
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(s.minRxTangZx < s.maxRxTangZx && s.minRxTangZy < s.maxRxTangZy,
+                                         "Invalid RX apodization angle limits.");
+        const size_t nTx = s.txFocus.size();
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nTx > 0, "At least one transmission is required.");
+        for (size_t size : {s.txAngleZx.size(), s.txAngleZy.size(), s.txApertureCenterX.size(),
+                            s.txApertureCenterY.size(), s.txApertureFirstElementX.size(),
+                            s.txApertureLastElementX.size(), s.txApertureFirstElementY.size(),
+                            s.txApertureLastElementY.size(), s.rxApertureFirstElementX.size(),
+                            s.rxApertureFirstElementY.size()}) {
+            ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+                size == nTx, format("All TX/RX parameters should have the same number of values ({}).", nTx));
+        }
+        for (size_t i = 0; i < nTx; ++i) {
+            ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+                s.txApertureLastElementX[i] < s.xElements.size() && s.txApertureLastElementY[i] < s.yElements.size()
+                    && s.txApertureFirstElementX[i] <= s.txApertureLastElementX[i]
+                    && s.txApertureFirstElementY[i] <= s.txApertureLastElementY[i],
+                format("Invalid TX aperture of TX/RX {}.", i));
+            transmits.push_back(getTransmit(i));
+        }
+        if (nThreads == 0) {
+            nThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        this->nThreads = nThreads;
+    }
+
+    void process(const float32 *iq, size_t nSequences, size_t nRxY, size_t nRxX, size_t nSamples,
+                 float32 *output) const {
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(nSamples >= 2, "At least 2 samples are required.");
+        // Note: AVX2 gather uses signed 32-bit indices.
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(2 * nSamples + 4 <= (size_t) std::numeric_limits<int32>::max(),
+                                         "The number of samples is too large.");
+        for (size_t i = 0; i < transmits.size(); ++i) {
+            ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+                s.rxApertureFirstElementX[i] + nRxX <= s.xElements.size()
+                    && s.rxApertureFirstElementY[i] + nRxY <= s.yElements.size(),
+                format("RX aperture of TX/RX {} exceeds the probe.", i));
+        }
+        const size_t nTiles = getNumberOfTiles();
+        const size_t nUnits = nSequences * nTiles;
+        const size_t nWorkers = std::min<size_t>(nThreads, nUnits);
+        auto processUnits = [&, this](size_t start, size_t end) {
+            Workspace workspace(transmits.size());
+            for (size_t unit = start; unit < end; ++unit) {
+                processTile(iq, unit / nTiles, unit % nTiles, nRxY, nRxX, nSamples, output, workspace);
+            }
+        };
+        if (nWorkers <= 1) {
+            processUnits(0, nUnits);
+            return;
+        }
+        const size_t unitsPerWorker = (nUnits + nWorkers - 1) / nWorkers;
+        std::vector<std::thread> workers;
+        for (size_t start = 0; start < nUnits; start += unitsPerWorker) {
+            workers.emplace_back(processUnits, start, std::min(start + unitsPerWorker, nUnits));
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    /** TX/RX parameters, precomputed for the delay tables. */
+    struct Transmit {
+        bool isPlaneWave;
+        float focus, zFocus, xFocus, yFocus;
+        float cosZenith, sinZenith, cosAzimuth, sinAzimuth;
+        float cosZx, sinZx, cosZy, sinZy;
+        float apertureCenterX, apertureCenterY;
+        // Positions of the TX aperture edges.
+        float xFirst, xLast, yFirst, yLast;
+        size_t rxFirstX, rxFirstY;
+    };
+
+    /** Per-worker delay tables and accumulators. */
+    struct Workspace {
+        explicit Workspace(size_t nTx)
+            : txTime(nTx * TILE_SIZE), txCos(nTx * TILE_SIZE), txSin(nTx * TILE_SIZE), accRe(nTx * TILE_SIZE),
+              accIm(nTx * TILE_SIZE), accWeight(nTx * TILE_SIZE), isTxActive(nTx), rxTime(BLOCK_SIZE * TILE_SIZE),
+              rxCos(BLOCK_SIZE * TILE_SIZE), rxSin(BLOCK_SIZE * TILE_SIZE), rxApod(BLOCK_SIZE * TILE_SIZE),
+              isRxActive(BLOCK_SIZE) {}
+
+        // TX tables: [tx*TILE_SIZE + voxel]; NaN TX time means voxel not sonified by the given TX.
+        std::vector<float> txTime, txCos, txSin;
+        std::vector<float> accRe, accIm, accWeight;
+        std::vector<char> isTxActive;
+        // RX tables: [element*TILE_SIZE + voxel].
+        std::vector<float> rxTime, rxCos, rxSin, rxApod;
+        std::vector<char> isRxActive;
+    };
+
+    Transmit getTransmit(size_t i) const {
+        Transmit tx{};
+        const float tanZx = std::tan(s.txAngleZx[i]), tanZy = std::tan(s.txAngleZy[i]);
+        const float zenith = std::atan(std::hypot(tanZx, tanZy));
+        const float azimuth = std::atan2(tanZy, tanZx);
+        tx.isPlaneWave = std::isinf(s.txFocus[i]);
+        tx.focus = s.txFocus[i];
+        tx.cosZenith = std::cos(zenith);
+        tx.sinZenith = std::sin(zenith);
+        tx.cosAzimuth = std::cos(azimuth);
+        tx.sinAzimuth = std::sin(azimuth);
+        tx.cosZx = std::cos(s.txAngleZx[i]);
+        tx.sinZx = std::sin(s.txAngleZx[i]);
+        tx.cosZy = std::cos(s.txAngleZy[i]);
+        tx.sinZy = std::sin(s.txAngleZy[i]);
+        tx.apertureCenterX = s.txApertureCenterX[i];
+        tx.apertureCenterY = s.txApertureCenterY[i];
+        if (!tx.isPlaneWave) {
+            tx.zFocus = tx.focus * tx.cosZenith;
+            tx.xFocus = tx.focus * tx.sinZenith * tx.cosAzimuth + tx.apertureCenterX;
+            tx.yFocus = tx.focus * tx.sinZenith * tx.sinAzimuth + tx.apertureCenterY;
+        }
+        tx.xFirst = s.xElements[s.txApertureFirstElementX[i]];
+        tx.xLast = s.xElements[s.txApertureLastElementX[i]];
+        tx.yFirst = s.yElements[s.txApertureFirstElementY[i]];
+        tx.yLast = s.yElements[s.txApertureLastElementY[i]];
+        tx.rxFirstX = s.rxApertureFirstElementX[i];
+        tx.rxFirstY = s.rxApertureFirstElementY[i];
+        return tx;
+    }
+
+    size_t getNumberOfTiles() const {
+        return ((s.zGrid.size() + TILE_Z - 1) / TILE_Z) * ((s.xGrid.size() + TILE_X - 1) / TILE_X)
+            * ((s.yGrid.size() + TILE_Y - 1) / TILE_Y);
+    }
+
+    /** Returns the TX distance for the given voxel, NaN if the voxel is not sonified. */
+    static float getTxDistance(const Transmit &tx, float z, float x, float y) {
+        bool isSonified;
+        float distance;
+        if (tx.isPlaneWave) {
+            distance = z * tx.cosZenith
+                + ((x - tx.apertureCenterX) * tx.cosAzimuth + (y - tx.apertureCenterY) * tx.sinAzimuth) * tx.sinZenith;
+            isSonified = (-tx.sinZx * z + tx.cosZx * (x - tx.xFirst)) >= 0.0f
+                && (tx.sinZx * z - tx.cosZx * (x - tx.xLast)) >= 0.0f
+                && (-tx.sinZy * z + tx.cosZy * (y - tx.yFirst)) >= 0.0f
+                && (tx.sinZy * z - tx.cosZy * (y - tx.yLast)) >= 0.0f;
+        } else {
+            const float dz = z - tx.zFocus, dx = x - tx.xFocus, dy = y - tx.yFocus;
+            float arrangement = 1.0f;
+            if (tx.focus > 0.0f) {
+                // Focal point in front of the probe: is the voxel behind (-) or in front of (+) the focal point?
+                arrangement = (dz * tx.zFocus + dx * (tx.xFocus - tx.apertureCenterX)
+                               + dy * (tx.yFocus - tx.apertureCenterY)) >= 0.0f ? 1.0f : -1.0f;
+            }
+            distance = std::sqrt(dz * dz + dx * dx + dy * dy) * arrangement + tx.focus;
+            isSonified = (-dz * (tx.xFirst - tx.xFocus) - dx * tx.zFocus) * arrangement >= 0.0f
+                && (dz * (tx.xLast - tx.xFocus) + dx * tx.zFocus) * arrangement >= 0.0f
+                && (-dz * (tx.yFirst - tx.yFocus) - dy * tx.zFocus) * arrangement >= 0.0f
+                && (dz * (tx.yLast - tx.yFocus) + dy * tx.zFocus) * arrangement >= 0.0f;
+        }
+        return isSonified ? distance : std::numeric_limits<float>::quiet_NaN();
+    }
+
+    /** RX apodization weight for the given (normalized to [0, 1]) position in the apodization window. */
+    float getRxApodization(float position) const {
+        const size_t n = s.rxApodization.size();
+        if (n == 1) {
+            return s.rxApodization[0];
+        }
+        float sample = position * (float) (n - 1);
+        auto i = std::min((size_t) sample, n - 2);
+        float weight = sample - (float) i;
+        return s.rxApodization[i] * (1.0f - weight) + s.rxApodization[i + 1] * weight;
+    }
+
+    /** Voxel v of the given tile -> (z, x, y) grid indices. */
+    struct TileOrigin {
+        size_t z, x, y;
+    };
+
+    TileOrigin getTileOrigin(size_t tile) const {
+        const size_t nTilesZ = (s.zGrid.size() + TILE_Z - 1) / TILE_Z;
+        const size_t nTilesX = (s.xGrid.size() + TILE_X - 1) / TILE_X;
+        return {(tile % nTilesZ) * TILE_Z, ((tile / nTilesZ) % nTilesX) * TILE_X, (tile / (nTilesZ * nTilesX)) * TILE_Y};
+    }
+
+    template<typename F> void forEachVoxel(const TileOrigin &origin, F &&f) const {
+        for (size_t ly = 0; ly < TILE_Y; ++ly) {
+            for (size_t lx = 0; lx < TILE_X; ++lx) {
+                for (size_t lz = 0; lz < TILE_Z; ++lz) {
+                    size_t z = origin.z + lz, x = origin.x + lx, y = origin.y + ly;
+                    bool isInside = z < s.zGrid.size() && x < s.xGrid.size() && y < s.yGrid.size();
+                    f((ly * TILE_X + lx) * TILE_Z + lz, isInside, z, x, y);
+                }
+            }
+        }
+    }
+
+    void computeTxTables(const TileOrigin &origin, Workspace &w) const {
+        const double omega = 2.0 * PI * s.centerFrequency;
+        for (size_t t = 0; t < transmits.size(); ++t) {
+            bool isActive = false;
+            float *time = w.txTime.data() + t * TILE_SIZE;
+            float *cos = w.txCos.data() + t * TILE_SIZE;
+            float *sin = w.txSin.data() + t * TILE_SIZE;
+            forEachVoxel(origin, [&](size_t v, bool isInside, size_t z, size_t x, size_t y) {
+                float distance = isInside ? getTxDistance(transmits[t], s.zGrid[z], s.xGrid[x], s.yGrid[y])
+                                          : std::numeric_limits<float>::quiet_NaN();
+                // Note: the phase is computed in double precision (the absolute phase is large).
+                double txTime = (double) distance / s.speedOfSound + s.initialDelay;
+                time[v] = (float) txTime;
+                cos[v] = std::isnan(distance) ? 0.0f : (float) std::cos(omega * txTime);
+                sin[v] = std::isnan(distance) ? 0.0f : (float) std::sin(omega * txTime);
+                isActive |= !std::isnan(distance);
+            });
+            w.isTxActive[t] = isActive;
+        }
+    }
+
+    /** Computes RX tables for elements [x0, x0+BLOCK_X) x [y0, y0+BLOCK_Y). Returns false if all weights are 0. */
+    bool computeRxTables(const TileOrigin &origin, size_t x0, size_t y0, Workspace &w) const {
+        const double omega = 2.0 * PI * s.centerFrequency;
+        const float rangeZxInv = 1.0f / (s.maxRxTangZx - s.minRxTangZx);
+        const float rangeZyInv = 1.0f / (s.maxRxTangZy - s.minRxTangZy);
+        bool isAnyActive = false;
+        for (size_t e = 0; e < BLOCK_SIZE; ++e) {
+            const size_t ex = x0 + e % BLOCK_X, ey = y0 + e / BLOCK_X;
+            float *time = w.rxTime.data() + e * TILE_SIZE;
+            float *cos = w.rxCos.data() + e * TILE_SIZE;
+            float *sin = w.rxSin.data() + e * TILE_SIZE;
+            float *apod = w.rxApod.data() + e * TILE_SIZE;
+            if (ex >= s.xElements.size() || ey >= s.yElements.size()) {
+                std::fill(apod, apod + TILE_SIZE, 0.0f);
+                w.isRxActive[e] = false;
+                continue;
+            }
+            const float xe = s.xElements[ex], ye = s.yElements[ey];
+            bool isActive = false;
+            forEachVoxel(origin, [&](size_t v, bool isInside, size_t z, size_t x, size_t y) {
+                apod[v] = 0.0f;
+                time[v] = cos[v] = sin[v] = 0.0f;
+                if (!isInside) {
+                    return;
+                }
+                const float zp = s.zGrid[z], dx = s.xGrid[x] - xe, dy = s.yGrid[y] - ye;
+                const float tangZy = dy / zp, tangZx = dx / zp;
+                // Note: NaNs are rejected here too.
+                if (!(tangZy >= s.minRxTangZy && tangZy <= s.maxRxTangZy && tangZx >= s.minRxTangZx
+                      && tangZx <= s.maxRxTangZx)) {
+                    return;
+                }
+                apod[v] = getRxApodization((tangZy - s.minRxTangZy) * rangeZyInv)
+                    * getRxApodization((tangZx - s.minRxTangZx) * rangeZxInv);
+                double rxTime = std::sqrt((double) zp * zp + (double) dx * dx + (double) dy * dy) / s.speedOfSound;
+                time[v] = (float) rxTime;
+                cos[v] = (float) std::cos(omega * rxTime);
+                sin[v] = (float) std::sin(omega * rxTime);
+                isActive |= apod[v] != 0.0f;
+            });
+            w.isRxActive[e] = isActive;
+            isAnyActive |= isActive;
+        }
+        return isAnyActive;
+    }
+
+    /**
+     * Accumulates the delayed, phase-rotated and apodized samples of a single element for all voxels of a tile.
+     */
+    void accumulate(const float32 *data, size_t nSamples, const float *txTime, const float *txCos,
+                    const float *txSin, const float *rxTime, const float *rxCos, const float *rxSin,
+                    const float *rxApod, float *accRe, float *accIm, float *accWeight) const {
+        const float fs = s.samplingFrequency;
+        const auto maxSample = (float) (nSamples - 1);
+#if defined(__AVX2__) && defined(__FMA__)
+        static_assert(TILE_SIZE % 8 == 0, "Tile size should be a multiple of the AVX2 vector size.");
+        const __m256 fsV = _mm256_set1_ps(fs), maxSampleV = _mm256_set1_ps(maxSample), zero = _mm256_setzero_ps();
+        const __m256i maxIndex = _mm256_set1_epi32((int) nSamples - 2);
+        for (size_t v = 0; v < TILE_SIZE; v += 8) {
+            __m256 apod = _mm256_loadu_ps(rxApod + v);
+            __m256 sample = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(txTime + v), _mm256_loadu_ps(rxTime + v)), fsV);
+            __m256 isValid = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(sample, zero, _CMP_GE_OQ), _mm256_cmp_ps(sample, maxSampleV, _CMP_LE_OQ)),
+                _mm256_cmp_ps(apod, zero, _CMP_NEQ_OQ));
+            if (_mm256_movemask_ps(isValid) == 0) {
+                continue;
+            }
+            // Invalid lanes -> sample 0 (a valid memory address).
+            sample = _mm256_and_ps(sample, isValid);
+            apod = _mm256_and_ps(apod, isValid);
+            __m256i i = _mm256_min_epi32(_mm256_cvttps_epi32(sample), maxIndex);
+            __m256 weight = _mm256_sub_ps(sample, _mm256_cvtepi32_ps(i));
+            __m256i idx = _mm256_slli_epi32(i, 1);
+            __m256 re0 = _mm256_i32gather_ps(data, idx, 4);
+            __m256 im0 = _mm256_i32gather_ps(data + 1, idx, 4);
+            __m256 re1 = _mm256_i32gather_ps(data + 2, idx, 4);
+            __m256 im1 = _mm256_i32gather_ps(data + 3, idx, 4);
+            __m256 re = _mm256_fmadd_ps(weight, _mm256_sub_ps(re1, re0), re0);
+            __m256 im = _mm256_fmadd_ps(weight, _mm256_sub_ps(im1, im0), im0);
+            __m256 tc = _mm256_loadu_ps(txCos + v), ts = _mm256_loadu_ps(txSin + v);
+            __m256 rc = _mm256_loadu_ps(rxCos + v), rs = _mm256_loadu_ps(rxSin + v);
+            __m256 c = _mm256_fmsub_ps(tc, rc, _mm256_mul_ps(ts, rs));
+            __m256 sn = _mm256_fmadd_ps(ts, rc, _mm256_mul_ps(tc, rs));
+            __m256 outRe = _mm256_fmsub_ps(re, c, _mm256_mul_ps(im, sn));
+            __m256 outIm = _mm256_fmadd_ps(re, sn, _mm256_mul_ps(im, c));
+            _mm256_storeu_ps(accRe + v, _mm256_fmadd_ps(apod, outRe, _mm256_loadu_ps(accRe + v)));
+            _mm256_storeu_ps(accIm + v, _mm256_fmadd_ps(apod, outIm, _mm256_loadu_ps(accIm + v)));
+            _mm256_storeu_ps(accWeight + v, _mm256_add_ps(apod, _mm256_loadu_ps(accWeight + v)));
+        }
+#else
+        for (size_t v = 0; v < TILE_SIZE; ++v) {
+            const float apod = rxApod[v];
+            const float sample = (txTime[v] + rxTime[v]) * fs;
+            if (apod == 0.0f || !(sample >= 0.0f && sample <= maxSample)) {
+                continue;
+            }
+            const auto i = std::min((size_t) sample, nSamples - 2);
+            const float weight = sample - (float) i;
+            const float32 *x = data + 2 * i;
+            const float re = x[0] + weight * (x[2] - x[0]);
+            const float im = x[1] + weight * (x[3] - x[1]);
+            const float c = txCos[v] * rxCos[v] - txSin[v] * rxSin[v];
+            const float sn = txSin[v] * rxCos[v] + txCos[v] * rxSin[v];
+            accRe[v] += apod * (re * c - im * sn);
+            accIm[v] += apod * (re * sn + im * c);
+            accWeight[v] += apod;
+        }
+#endif
+    }
+
+    void processTile(const float32 *iq, size_t sequence, size_t tile, size_t nRxY, size_t nRxX, size_t nSamples,
+                     float32 *output, Workspace &w) const {
+        const size_t nTx = transmits.size();
+        const TileOrigin origin = getTileOrigin(tile);
+        computeTxTables(origin, w);
+        std::fill(std::begin(w.accRe), std::end(w.accRe), 0.0f);
+        std::fill(std::begin(w.accIm), std::end(w.accIm), 0.0f);
+        std::fill(std::begin(w.accWeight), std::end(w.accWeight), 0.0f);
+
+        // The elements covered by any of the RX apertures.
+        size_t xBegin = s.xElements.size(), xEnd = 0, yBegin = s.yElements.size(), yEnd = 0;
+        for (size_t t = 0; t < nTx; ++t) {
+            if (w.isTxActive[t]) {
+                xBegin = std::min(xBegin, transmits[t].rxFirstX);
+                xEnd = std::max(xEnd, transmits[t].rxFirstX + nRxX);
+                yBegin = std::min(yBegin, transmits[t].rxFirstY);
+                yEnd = std::max(yEnd, transmits[t].rxFirstY + nRxY);
+            }
+        }
+        for (size_t y0 = yBegin; y0 < yEnd; y0 += BLOCK_Y) {
+            for (size_t x0 = xBegin; x0 < xEnd; x0 += BLOCK_X) {
+                if (!computeRxTables(origin, x0, y0, w)) {
+                    continue;
+                }
+                for (size_t t = 0; t < nTx; ++t) {
+                    const Transmit &tx = transmits[t];
+                    if (!w.isTxActive[t]) {
+                        continue;
+                    }
+                    for (size_t e = 0; e < BLOCK_SIZE; ++e) {
+                        const size_t ex = x0 + e % BLOCK_X, ey = y0 + e / BLOCK_X;
+                        if (!w.isRxActive[e] || ex < tx.rxFirstX || ex >= tx.rxFirstX + nRxX || ey < tx.rxFirstY
+                            || ey >= tx.rxFirstY + nRxY) {
+                            continue;
+                        }
+                        const size_t channel = ((sequence * nTx + t) * nRxY + (ey - tx.rxFirstY)) * nRxX
+                            + (ex - tx.rxFirstX);
+                        const size_t txOffset = t * TILE_SIZE, rxOffset = e * TILE_SIZE;
+                        accumulate(iq + 2 * channel * nSamples, nSamples, w.txTime.data() + txOffset,
+                                   w.txCos.data() + txOffset, w.txSin.data() + txOffset, w.rxTime.data() + rxOffset,
+                                   w.rxCos.data() + rxOffset, w.rxSin.data() + rxOffset, w.rxApod.data() + rxOffset,
+                                   w.accRe.data() + txOffset, w.accIm.data() + txOffset,
+                                   w.accWeight.data() + txOffset);
+                    }
+                }
+            }
+        }
+        // Compounding: the sum of the (normalized) low resolution volumes.
+        const size_t nz = s.zGrid.size(), nx = s.xGrid.size(), ny = s.yGrid.size();
+        forEachVoxel(origin, [&](size_t v, bool isInside, size_t z, size_t x, size_t y) {
+            if (!isInside) {
+                return;
+            }
+            float re = 0.0f, im = 0.0f;
+            for (size_t t = 0; t < nTx; ++t) {
+                const float weight = w.accWeight[t * TILE_SIZE + v];
+                if (weight != 0.0f) {
+                    re += w.accRe[t * TILE_SIZE + v] / weight;
+                    im += w.accIm[t * TILE_SIZE + v] / weight;
+                }
+            }
+            float32 *out = output + 2 * (((sequence * ny + y) * nx + x) * nz + z);
+            out[0] = re;
+            out[1] = im;
+        });
+    }
+
+    VolumeReconstructionSettings s;
+    std::vector<Transmit> transmits;
+    unsigned nThreads;
+};
+
+VolumeReconstruction::VolumeReconstruction(const VolumeReconstructionSettings &settings, unsigned nThreads) {
+    this->impl = UniqueHandle<Impl>::create(settings, nThreads);
+}
+
+void VolumeReconstruction::process(const float32 *iq, size_t nSequences, size_t nRxY, size_t nRxX, size_t nSamples,
+                                   float32 *output) const {
+    impl->process(iq, nSequences, nRxY, nRxX, nSamples, output);
+}
+
+VolumeReconstruction::VolumeReconstruction(const VolumeReconstruction &o) = default;
+VolumeReconstruction::VolumeReconstruction(VolumeReconstruction &&o) noexcept = default;
+VolumeReconstruction::~VolumeReconstruction() {}
+VolumeReconstruction &VolumeReconstruction::operator=(const VolumeReconstruction &o) = default;
+VolumeReconstruction &VolumeReconstruction::operator=(VolumeReconstruction &&o) noexcept = default;
+
+}// namespace arrus::processing
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "arrus/core/api/processing/VolumeReconstruction.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::processing;
+using Complex = std::complex<double>;
+
+std::vector<float> linspace(float start, float end, size_t n) {
+    std::vector<float> result(n);
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = start + (end - start) * (float) i / (float) (n - 1);
+    }
+    return result;
+}
+
+/** 8x8 matrix array, 4x4 RX apertures, plane waves and diverging/focused waves. */
+VolumeReconstructionSettings getSettings() {
+    VolumeReconstructionSettings s;
+    s.xGrid = linspace(-1.2e-3f, 1.2e-3f, 7);
+    s.yGrid = linspace(-1e-3f, 1e-3f, 5);
+    s.zGrid = linspace(2e-3f, 8e-3f, 45);
+    s.xElements = linspace(-1.05e-3f, 1.05e-3f, 8);
+    s.yElements = linspace(-1.05e-3f, 1.05e-3f, 8);
+    s.speedOfSound = 1540.0f;
+    s.samplingFrequency = 20e6f;
+    s.centerFrequency = 5e6f;
+    s.initialDelay = 1e-6f;
+    const float inf = std::numeric_limits<float>::infinity();
+    s.txFocus = {inf, inf, 5e-3f, -3e-3f};
+    s.txAngleZx = {0.0f, 0.1f, 0.0f, 0.05f};
+    s.txAngleZy = {0.0f, -0.05f, 0.0f, 0.0f};
+    s.txApertureCenterX = {0.0f, 0.0f, 0.0f, 0.0f};
+    s.txApertureCenterY = {0.0f, 0.0f, 0.0f, 0.0f};
+    s.txApertureFirstElementX = {0, 0, 0, 0};
+    s.txApertureLastElementX = {7, 7, 7, 7};
+    s.txApertureFirstElementY = {0, 0, 0, 0};
+    s.txApertureLastElementY = {7, 7, 7, 7};
+    s.rxApertureFirstElementX = {0, 4, 2, 4};
+    s.rxApertureFirstElementY = {0, 0, 4, 4};
+    s.minRxTangZx = s.minRxTangZy = -0.5f;
+    s.maxRxTangZx = s.maxRxTangZy = 0.5f;
+    for (size_t i = 0; i < 20; ++i) {
+        s.rxApodization.push_back((float) (0.54 - 0.46 * std::cos(2.0 * M_PI * (double) i / 19.0)));
+    }
+    return s;
+}
+
+double interpolateApodization(const std::vector<float> &apod, double position) {
+    double sample = position * (double) (apod.size() - 1);
+    auto i = std::min((size_t) sample, apod.size() - 2);
+    double weight = sample - (double) i;
+    return apod[i] * (1.0 - weight) + apod[i + 1] * weight;
+}
+
+/** Double precision port of the iqRaw2Lri3D kernel. */
+std::vector<Complex> reference(const VolumeReconstructionSettings &s, const std::vector<float> &iq, size_t nSequences,
+                               size_t nRxY, size_t nRxX, size_t nSamples) {
+    const size_t nz = s.zGrid.size(), nx = s.xGrid.size(), ny = s.yGrid.size(), nTx = s.txFocus.size();
+    const double omega = 2.0 * M_PI * s.centerFrequency;
+    std::vector<Complex> result(nSequences * ny * nx * nz);
+    for (size_t seq = 0; seq < nSequences; ++seq) {
+        for (size_t y = 0; y < ny; ++y) {
+            for (size_t x = 0; x < nx; ++x) {
+                for (size_t z = 0; z < nz; ++z) {
+                    const double zp = s.zGrid[z], xp = s.xGrid[x], yp = s.yGrid[y];
+                    Complex value = 0.0;
+                    for (size_t t = 0; t < nTx; ++t) {
+                        double tanZx = std::tan(s.txAngleZx[t]), tanZy = std::tan(s.txAngleZy[t]);
+                        double zenith = std::atan(std::hypot(tanZx, tanZy)), azimuth = std::atan2(tanZy, tanZx);
+                        double cx = s.txApertureCenterX[t], cy = s.txApertureCenterY[t];
+                        double xFirst = s.xElements[s.txApertureFirstElementX[t]];
+                        double xLast = s.xElements[s.txApertureLastElementX[t]];
+                        double yFirst = s.yElements[s.txApertureFirstElementY[t]];
+                        double yLast = s.yElements[s.txApertureLastElementY[t]];
+                        double txDist;
+                        bool txApod;
+                        if (std::isinf(s.txFocus[t])) {
+                            double ax = s.txAngleZx[t], ay = s.txAngleZy[t];
+                            txDist = zp * std::cos(zenith)
+                                + ((xp - cx) * std::cos(azimuth) + (yp - cy) * std::sin(azimuth)) * std::sin(zenith);
+                            txApod = (-std::sin(ax) * zp + std::cos(ax) * (xp - xFirst)) >= 0
+                                && (std::sin(ax) * zp - std::cos(ax) * (xp - xLast)) >= 0
+                                && (-std::sin(ay) * zp + std::cos(ay) * (yp - yFirst)) >= 0
+                                && (std::sin(ay) * zp - std::cos(ay) * (yp - yLast)) >= 0;
+                        } else {
+                            double focus = s.txFocus[t];
+                            double zf = focus * std::cos(zenith);
+                            double xf = focus * std::sin(zenith) * std::cos(azimuth) + cx;
+                            double yf = focus * std::sin(zenith) * std::sin(azimuth) + cy;
+                            double arrangement = 1.0;
+                            if (focus > 0) {
+                                arrangement = ((zp - zf) * zf + (xp - xf) * (xf - cx) + (yp - yf) * (yf - cy)) >= 0
+                                    ? 1.0 : -1.0;
+                            }
+                            txDist = std::sqrt((zp - zf) * (zp - zf) + (xp - xf) * (xp - xf) + (yp - yf) * (yp - yf));
+                            txDist = txDist * arrangement + focus;
+                            txApod = (-(zp - zf) * (xFirst - xf) - (xp - xf) * zf) * arrangement >= 0
+                                && ((zp - zf) * (xLast - xf) + (xp - xf) * zf) * arrangement >= 0
+                                && (-(zp - zf) * (yFirst - yf) - (yp - yf) * zf) * arrangement >= 0
+                                && ((zp - zf) * (yLast - yf) + (yp - yf) * zf) * arrangement >= 0;
+                        }
+                        if (!txApod) {
+                            continue;
+                        }
+                        Complex pix = 0.0;
+                        double pixWeight = 0.0;
+                        for (size_t ey = 0; ey < nRxY; ++ey) {
+                            double ye = s.yElements[ey + s.rxApertureFirstElementY[t]];
+                            double tangY = (yp - ye) / zp;
+                            if (tangY < s.minRxTangZy || tangY > s.maxRxTangZy) {
+                                continue;
+                            }
+                            double apodY = interpolateApodization(
+                                s.rxApodization, (tangY - s.minRxTangZy) / (s.maxRxTangZy - s.minRxTangZy));
+                            for (size_t ex = 0; ex < nRxX; ++ex) {
+                                double xe = s.xElements[ex + s.rxApertureFirstElementX[t]];
+                                double tangX = (xp - xe) / zp;
+                                if (tangX < s.minRxTangZx || tangX > s.maxRxTangZx) {
+                                    continue;
+                                }
+                                double apodX = interpolateApodization(
+                                    s.rxApodization, (tangX - s.minRxTangZx) / (s.maxRxTangZx - s.minRxTangZx));
+                                double rxDist = std::sqrt(zp * zp + (xp - xe) * (xp - xe) + (yp - ye) * (yp - ye));
+                                double time = (txDist + rxDist) / s.speedOfSound + s.initialDelay;
+                                double sample = time * s.samplingFrequency;
+                                if (sample < 0 || sample > (double) (nSamples - 1)) {
+                                    continue;
+                                }
+                                auto i = std::min((size_t) sample, nSamples - 2);
+                                double w = sample - (double) i;
+                                size_t offset = 2 * ((((seq * nTx + t) * nRxY + ey) * nRxX + ex) * nSamples + i);
+                                Complex x0(iq[offset], iq[offset + 1]), x1(iq[offset + 2], iq[offset + 3]);
+                                pix += (x0 * (1.0 - w) + x1 * w) * std::polar(1.0, omega * time) * apodX * apodY;
+                                pixWeight += apodX * apodY;
+                            }
+                        }
+                        if (pixWeight != 0.0) {
+                            value += pix / pixWeight;
+                        }
+                    }
+                    result[((seq * ny + y) * nx + x) * nz + z] = value;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void verify(const VolumeReconstructionSettings &settings, unsigned nThreads) {
+    const size_t nSequences = 2, nRxY = 4, nRxX = 4, nSamples = 256, nTx = settings.txFocus.size();
+    std::mt19937 generator{2023};
+    std::uniform_real_distribution<float> distribution{-1.0f, 1.0f};
+    std::vector<float> iq(2 * nSequences * nTx * nRxY * nRxX * nSamples);
+    for (auto &value : iq) {
+        value = distribution(generator);
+    }
+    const size_t nVoxels = settings.xGrid.size() * settings.yGrid.size() * settings.zGrid.size();
+    std::vector<float> output(2 * nSequences * nVoxels, -1.0f);
+    VolumeReconstruction reconstruction{settings, nThreads};
+    reconstruction.process(iq.data(), nSequences, nRxY, nRxX, nSamples, output.data());
+
+    auto expected = reference(settings, iq, nSequences, nRxY, nRxX, nSamples);
+    size_t nNonZero = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(output[2 * i], expected[i].real(), 1e-3) << "voxel " << i;
+        ASSERT_NEAR(output[2 * i + 1], expected[i].imag(), 1e-3) << "voxel " << i;
+        nNonZero += std::abs(expected[i]) > 0.0;
+    }
+    // Make sure the test covers both sonified and not sonified voxels.
+    EXPECT_GT(nNonZero, expected.size() / 2);
+    EXPECT_LT(nNonZero, expected.size());
+}
+
+TEST(VolumeReconstructionTest, MatchesReferenceSingleThread) { verify(getSettings(), 1); }
+
+TEST(VolumeReconstructionTest, MatchesReferenceMultipleThreads) {
+    auto settings = getSettings();
+    settings.zGrid = linspace(1e-3f, 9e-3f, 70);
+    verify(settings, 5);
+}
+
+TEST(VolumeReconstructionTest, ThrowsOnInvalidParameters) {
+    auto settings = getSettings();
+    settings.txAngleZx.pop_back();
+    EXPECT_THROW(VolumeReconstruction{settings}, IllegalArgumentException);
+
+    settings = getSettings();
+    settings.txApertureLastElementX[0] = 8;
+    EXPECT_THROW(VolumeReconstruction{settings}, IllegalArgumentException);
+
+    VolumeReconstruction reconstruction{getSettings()};
+    std::vector<float> iq(2 * 4 * 5 * 4 * 16), output(2 * 7 * 5 * 45);
+    // RX aperture 5x4 exceeds the probe for the last TX/RX.
+    EXPECT_THROW(reconstruction.process(iq.data(), 1, 5, 4, 16, output.data()), IllegalArgumentException);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
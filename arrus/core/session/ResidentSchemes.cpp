@@ -0,0 +1,79 @@
+#include "arrus/core/session/ResidentSchemes.h"
+
+#include <limits>
+
+#include "arrus/common/asserts.h"
+#include "arrus/common/format.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/common/collections.h"
+
+namespace arrus::session {
+
+using ::arrus::ops::us4r::DigitalDownConversion;
+using ::arrus::ops::us4r::TxRx;
+using ::arrus::ops::us4r::TxRxSequence;
+
+namespace {
+
+bool isEqual(const std::optional<DigitalDownConversion> &a, const std::optional<DigitalDownConversion> &b) {
+    if (!a.has_value() || !b.has_value()) {
+        return a.has_value() == b.has_value();
+    }
+    return a->getDemodulationFrequency() == b->getDemodulationFrequency()
+        && a->getDecimationFactor() == b->getDecimationFactor()
+        && copyToVector(a->getFirCoefficients()) == copyToVector(b->getFirCoefficients());
+}
+
+}// namespace
+
+ResidentSchemes::ResidentSchemes(std::vector<Scheme> schemes)
+    : schemes(std::move(schemes)), mergedScheme(merge(this->schemes)) {
+    size_t start = 0;
+    for (const auto &scheme : this->schemes) {
+        size_t end = start + scheme.getTxRxSequence().getOps().size() - 1;
+        opRanges.emplace_back((uint16) start, (uint16) end);
+        start = end + 1;
+    }
+}
+
+ResidentSchemes::Scheme ResidentSchemes::merge(const std::vector<Scheme> &schemes) {
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!schemes.empty(), "At least one scheme should be provided.");
+    const Scheme &first = schemes.at(0);
+    const TxRxSequence &firstSeq = first.getTxRxSequence();
+    std::vector<TxRx> ops;
+    for (size_t i = 0; i < schemes.size(); ++i) {
+        const Scheme &scheme = schemes[i];
+        const TxRxSequence &seq = scheme.getTxRxSequence();
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(!seq.getOps().empty(), format("Scheme {}: the sequence is empty.", i));
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            scheme.getRxBufferSize() == first.getRxBufferSize()
+                && scheme.getWorkMode() == first.getWorkMode()
+                && isEqual(scheme.getDigitalDownConversion(), first.getDigitalDownConversion()),
+            format("Scheme {}: all resident schemes should have the same rx buffer size, work mode "
+                   "and digital down conversion.", i));
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+            seq.getTgcCurve() == firstSeq.getTgcCurve() && seq.getNRepeats() == firstSeq.getNRepeats()
+                && seq.getAutoPriMargin() == firstSeq.getAutoPriMargin(),
+            format("Scheme {}: all resident schemes should have the same TGC curve, number of repeats and "
+                   "automatic PRI margin.", i));
+        ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(scheme.getConstants().empty() && !scheme.getTransferRoi().has_value(),
+                                         format("Scheme {}: constants and transfer ROI are not supported for "
+                                                "resident schemes.", i));
+        ops.insert(std::end(ops), std::begin(seq.getOps()), std::end(seq.getOps()));
+    }
+    const size_t maxNOps = (size_t) std::numeric_limits<uint16>::max() + 1;
+    ARRUS_REQUIRES_AT_MOST(ops.size(), maxNOps,
+                           format("The total number of TX/RXs of the resident schemes ({}) exceeds the maximum ({}).",
+                                  ops.size(), maxNOps));
+    // Each scheme applies its own SRI when selected (see Session::switchScheme).
+    TxRxSequence mergedSeq{ops, firstSeq.getTgcCurve(), TxRxSequence::NO_SRI, firstSeq.getNRepeats(),
+                           firstSeq.getAutoPriMargin()};
+    if (first.getDigitalDownConversion().has_value()) {
+        return Scheme{mergedSeq, first.getRxBufferSize(), first.getOutputBuffer(), first.getWorkMode(),
+                      first.getDigitalDownConversion().value()};
+    } else {
+        return Scheme{mergedSeq, first.getRxBufferSize(), first.getOutputBuffer(), first.getWorkMode()};
+    }
+}
+
+}// namespace arrus::session
@@ -0,0 +1,55 @@
+#ifndef ARRUS_CORE_SESSION_RESIDENTSCHEMES_H
+#define ARRUS_CORE_SESSION_RESIDENTSCHEMES_H
+
+#include <utility>
+#include <vector>
+
+#include "arrus/core/api/ops/us4r/Scheme.h"
+
+namespace arrus::session {
+
+/**
+ * A set of schemes uploaded to the device at once (see Session::upload(const std::vector<Scheme>&)).
+ *
+ * The TX/RXs of all schemes are merged into a single scheme (in the order of the schemes), so each of the
+ * input schemes is the [start, end] sub-sequence of the merged one. The parameters of the merged sequence are shared
+ * by all schemes, so they should be the same: rx buffer size, work mode, DDC, TGC curve, the number of repeats and
+ * the automatic PRI margin. Each scheme has its own SRI and output buffer. Constants and transfer ROI are not
+ * supported.
+ */
+class ResidentSchemes {
+public:
+    using Scheme = ::arrus::ops::us4r::Scheme;
+    using OpRange = std::pair<uint16, uint16>;
+
+    /**
+     * @throws IllegalArgumentException when the schemes cannot be merged
+     */
+    explicit ResidentSchemes(std::vector<Scheme> schemes);
+
+    /**
+     * Returns the scheme with the TX/RXs of all schemes, that should be uploaded to the device.
+     */
+    [[nodiscard]] const Scheme &getMergedScheme() const { return mergedScheme; }
+
+    [[nodiscard]] size_t getNumberOfSchemes() const { return schemes.size(); }
+
+    [[nodiscard]] const Scheme &getScheme(size_t i) const { return schemes.at(i); }
+
+    /**
+     * Returns the [start, end] (both inclusive) range of the merged scheme TX/RXs, that corresponds to
+     * the i-th scheme.
+     */
+    [[nodiscard]] OpRange getOpRange(size_t i) const { return opRanges.at(i); }
+
+private:
+    static Scheme merge(const std::vector<Scheme> &schemes);
+
+    std::vector<Scheme> schemes;
+    std::vector<OpRange> opRanges;
+    Scheme mergedScheme;
+};
+
+}// namespace arrus::session
+
+#endif//ARRUS_CORE_SESSION_RESIDENTSCHEMES_H
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "arrus/core/session/ResidentSchemes.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::ops::us4r;
+using arrus::framework::DataBufferSpec;
+using arrus::session::ResidentSchemes;
+
+TxRx getTxRx(unsigned nSamples) {
+    Tx tx{std::vector<bool>(4, true), std::vector<float>(4, 0.0f), Pulse{5e6f, 2, false}};
+    Rx rx{std::vector<bool>(4, true), {0, nSamples}};
+    return TxRx{tx, rx, 100e-6f};
+}
+
+Scheme getScheme(size_t nOps, float sri = TxRxSequence::NO_SRI, int16 nRepeats = 1) {
+    std::vector<TxRx> ops(nOps, getTxRx(1024));
+    TxRxSequence seq{ops, {}, sri, nRepeats};
+    return Scheme{seq, 2, DataBufferSpec{DataBufferSpec::Type::FIFO, 4}, Scheme::WorkMode::HOST};
+}
+
+TEST(ResidentSchemesTest, MergesTxRxsOfAllSchemes) {
+    ResidentSchemes schemes{{getScheme(3), getScheme(1, 10e-3f), getScheme(2)}};
+    EXPECT_EQ(schemes.getNumberOfSchemes(), 3);
+    EXPECT_EQ(schemes.getMergedScheme().getTxRxSequence().getOps().size(), 6);
+    EXPECT_FALSE(schemes.getMergedScheme().getTxRxSequence().getSri().has_value());
+    EXPECT_EQ(schemes.getOpRange(0), (ResidentSchemes::OpRange{0, 2}));
+    EXPECT_EQ(schemes.getOpRange(1), (ResidentSchemes::OpRange{3, 3}));
+    EXPECT_EQ(schemes.getOpRange(2), (ResidentSchemes::OpRange{4, 5}));
+    EXPECT_EQ(schemes.getScheme(1).getTxRxSequence().getSri(), std::optional<float>{10e-3f});
+}
+
+TEST(ResidentSchemesTest, RequiresTheSameSchemeParameters) {
+    EXPECT_THROW(ResidentSchemes({}), IllegalArgumentException);
+    EXPECT_THROW(ResidentSchemes({getScheme(2), getScheme(2, TxRxSequence::NO_SRI, 2)}), IllegalArgumentException);
+    auto other = getScheme(2);
+    Scheme otherWorkMode{other.getTxRxSequence(), 2, other.getOutputBuffer(), Scheme::WorkMode::ASYNC};
+    EXPECT_THROW(ResidentSchemes({getScheme(2), otherWorkMode}), IllegalArgumentException);
+    EXPECT_THROW(ResidentSchemes({getScheme(2), getScheme(2).withTransferRoi(TransferRoi{{0, 16}})}),
+                 IllegalArgumentException);
+}
+
+TEST(ResidentSchemesTest, AllowsDifferentOutputBuffers) {
+    auto other = getScheme(2);
+    Scheme otherBuffer{other.getTxRxSequence(), 2, DataBufferSpec{DataBufferSpec::Type::FIFO, 8},
+                       Scheme::WorkMode::HOST};
+    ResidentSchemes schemes{{getScheme(2), otherBuffer}};
+    EXPECT_EQ(schemes.getScheme(1).getOutputBuffer().getNumberOfElements(), 8);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,18 +1,25 @@
 #include "arrus/core/session/SessionImpl.h"
 
 #include <gsl/gsl>
+#include <algorithm>
+#include <exception>
+#include <future>
 #include <memory>
+#include <numeric>
 
 #include <boost/algorithm/string.hpp>
 
+#include "arrus/common/asserts.h"
 #include "arrus/common/compiler.h"
 #include "arrus/common/format.h"
 #include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/common/tracing.h"
 #include "arrus/core/devices/utils.h"
 
 #include "arrus/core/api/io/settings.h"
 #include "arrus/core/devices/probe/ProbeFactoryImpl.h"
 #include "arrus/core/devices/us4r/Us4RFactoryImpl.h"
+#include "arrus/core/devices/us4r/Us4RImpl.h"
 #include "arrus/core/devices/us4r/Us4RSettingsConverterImpl.h"
 #include "arrus/core/devices/us4r/external/ius4oem/IUs4OEMFactoryImpl.h"
 #include "arrus/core/devices/us4r/external/ius4oem/IUs4OEMInitializerImpl.h"
@@ -21,6 +28,7 @@
 #include "arrus/core/devices/us4r/probeadapter/ProbeAdapterFactoryImpl.h"
 #include "arrus/core/devices/us4r/us4oem/Us4OEMFactoryImpl.h"
 #include "arrus/core/devices/file/FileFactoryImpl.h"
+#include "arrus/core/framework/MergedDataBuffer.h"
 #include "arrus/core/session/SessionSettings.h"
 
 namespace arrus::session {
@@ -43,6 +51,40 @@ using namespace arrus::devices;
         }                                                                                                              \
     } while (0)
 
+namespace {
+
+/**
+ * Calls the given function for each of the systems, in parallel if there is more than one system.
+ * Waits for all the calls to finish; rethrows the first exception, if any.
+ */
+std::vector<UploadResult> runOnSystems(const std::vector<Ultrasound *> &systems,
+                                       const std::function<UploadResult(Ultrasound *)> &func) {
+    if (systems.size() == 1) {
+        return {func(systems[0])};
+    }
+    std::vector<std::future<UploadResult>> futures;
+    for (auto *system : systems) {
+        futures.push_back(std::async(std::launch::async, func, system));
+    }
+    std::vector<UploadResult> results;
+    std::exception_ptr error;
+    for (auto &future : futures) {
+        try {
+            results.push_back(future.get());
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return results;
+}
+
+}// namespace
+
 Session::Handle createSession(const SessionSettings &sessionSettings) {
     return std::make_unique<SessionImpl>(
         sessionSettings,
@@ -116,6 +158,7 @@ void SessionImpl::configureDevices(const SessionSettings &sessionSettings) {
     for(size_t i = 0; i < sessionSettings.getNumberOfUs4Rs(); ++i) {
         const Us4RSettings &settings = sessionSettings.getUs4RSettings(Ordinal(i));
         Us4R::Handle us4r = us4rFactory->getUs4R(Ordinal(i), settings);
+        us4rSettings.push_back(settings);
         aliases.emplace(DeviceId(DeviceType::Ultrasound, ultrasoundOrdinal), us4r.get());
         devices.emplace(us4r->getDeviceId(), std::move(us4r));
         ultrasoundOrdinal++;
@@ -128,6 +171,17 @@ void SessionImpl::configureDevices(const SessionSettings &sessionSettings) {
         devices.emplace(file->getDeviceId(), std::move(file));
         ultrasoundOrdinal++;
     }
+    if (us4rSettings.size() > 1) {
+        auto nMasters = std::count_if(std::begin(us4rSettings), std::end(us4rSettings),
+                                      [](const auto &settings) { return !settings.isExternalTrigger(); });
+        if (nMasters != 1) {
+            getDefaultLogger()->log(
+                LogSeverity::WARNING,
+                format("The session drives {} us4R systems, {} of them generate the trigger; exactly one master "
+                       "is expected (the other systems should be configured with the external trigger), "
+                       "otherwise the frames of the systems may not be aligned.", us4rSettings.size(), nMasters));
+        }
+    }
 }
 
 SessionImpl::~SessionImpl() {
@@ -145,26 +199,190 @@ UploadResult SessionImpl::upload(const ops::us4r::Scheme &scheme) {
     std::lock_guard<std::recursive_mutex> guard(stateMutex);
     ASSERT_STATE(State::STOPPED);
 
-    auto ultrasound = (::arrus::devices::Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0));
+    auto systems = getSystems();
     this->verifyScheme(scheme);
-    auto[buffer, metadata] = ultrasound->upload(scheme);
+    auto results = runOnSystems(systems, [&scheme](Ultrasound *ultrasound) {
+        auto [buffer, metadata] = ultrasound->upload(scheme);
+        return UploadResult(buffer, metadata);
+    });
     currentScheme = scheme;
-    return UploadResult(buffer, metadata);
+    residentSchemes.reset();
+    return mergeResults(std::move(results));
+}
+
+UploadResult SessionImpl::upload(const std::vector<ops::us4r::Scheme> &schemes) {
+    std::lock_guard<std::recursive_mutex> guard(stateMutex);
+    ASSERT_STATE(State::STOPPED);
+
+    ResidentSchemes newSchemes{schemes};
+    const auto &mergedScheme = newSchemes.getMergedScheme();
+    std::vector<Us4RImpl::Subsequence> subsequences;
+    for (size_t i = 0; i < newSchemes.getNumberOfSchemes(); ++i) {
+        auto [start, end] = newSchemes.getOpRange(i);
+        const auto &scheme = newSchemes.getScheme(i);
+        subsequences.push_back(
+            Us4RImpl::Subsequence{start, end, scheme.getTxRxSequence().getSri(), scheme.getOutputBuffer()});
+    }
+    residentSchemes.reset();
+    runOnSystems(getSystems(), [&](Ultrasound *system) {
+        auto *us4r = dynamic_cast<Us4RImpl *>(system);
+        if (us4r == nullptr) {
+            throw IllegalArgumentException("Resident schemes are available for us4R devices only.");
+        }
+        us4r->uploadResidentSubsequences(mergedScheme, subsequences);
+        return UploadResult{};
+    });
+    currentScheme = mergedScheme;
+    residentSchemes = std::move(newSchemes);
+    return switchScheme(0);
+}
+
+UploadFuture::SharedHandle SessionImpl::uploadAsync(const ops::us4r::Scheme &scheme) {
+    std::vector<Ultrasound *> systems;
+    {
+        std::lock_guard<std::recursive_mutex> guard(stateMutex);
+        ASSERT_STATE_NOT(State::CLOSED);
+        systems = getSystems();
+    }
+    verifyScheme(scheme);
+    // System number -> the scheme compiled for that system; nullptr for the systems which cannot compile
+    // the scheme ahead of programming (the whole upload is done while programming then).
+    auto compiled = std::make_shared<std::vector<Us4RImpl::CompiledScheme::Handle>>(systems.size());
+    auto compile = [scheme, systems, compiled](UploadFutureImpl &future) {
+        ARRUS_TRACE_SCOPE("upload", "compile");
+        const auto nSystems = static_cast<float>(systems.size());
+        for (size_t i = 0; i < systems.size(); ++i) {
+            auto *us4r = dynamic_cast<Us4RImpl *>(systems[i]);
+            if (us4r == nullptr) {
+                continue;
+            }
+            auto onProgress = [&future, i, nSystems](float progress) {
+                future.setProgress((static_cast<float>(i) + progress) / nSystems);
+            };
+            try {
+                compiled->at(i) = us4r->compile(scheme, onProgress);
+            } catch (const IllegalArgumentException &e) {
+                if (systems.size() == 1) {
+                    throw;
+                }
+                throw IllegalArgumentException(format("The scheme cannot be uploaded to Us4R:{}: {}", i, e.what()));
+            }
+        }
+    };
+    auto program = [this, scheme, systems, compiled](UploadFutureImpl &future) {
+        std::unique_lock<std::recursive_mutex> lock(stateMutex);
+        {
+            ARRUS_TRACE_SCOPE("upload", "waitForDevice");
+            stateChanged.wait(lock, [&]() { return state != State::STARTED || future.isCancelled(); });
+        }
+        if (!future.beginProgramming()) {
+            return UploadResult{};
+        }
+        ARRUS_TRACE_SCOPE("upload", "program");
+        ASSERT_STATE(State::STOPPED);
+        std::mutex progressMutex;
+        std::vector<float> progress(systems.size(), 0.0f);
+        auto results = runOnSystems(systems, [&](Ultrasound *system) {
+            auto i = static_cast<size_t>(std::distance(std::begin(systems),
+                                                       std::find(std::begin(systems), std::end(systems), system)));
+            auto &compiledScheme = compiled->at(i);
+            if (!compiledScheme) {
+                auto [buffer, metadata] = system->upload(scheme);
+                return UploadResult(buffer, metadata);
+            }
+            auto onProgress = [&, i](float value) {
+                std::lock_guard<std::mutex> guard(progressMutex);
+                progress[i] = value;
+                future.setProgress(std::accumulate(std::begin(progress), std::end(progress), 0.0f)
+                                   / static_cast<float>(progress.size()));
+            };
+            auto [buffer, metadata] =
+                dynamic_cast<Us4RImpl *>(system)->program(std::move(compiledScheme), onProgress);
+            return UploadResult(buffer, metadata);
+        });
+        currentScheme = scheme;
+        residentSchemes.reset();
+        return mergeResults(std::move(results));
+    };
+    auto onCancel = [this]() {
+        // Make sure the programming thread is either before checking the wait condition or is already waiting.
+        { std::lock_guard<std::recursive_mutex> guard(stateMutex); }
+        stateChanged.notify_all();
+    };
+    auto future = std::make_shared<UploadFutureImpl>(compile, program, onCancel);
+    std::lock_guard<std::mutex> guard(pendingUploadsMutex);
+    // Forget about the finished uploads.
+    pendingUploads.erase(std::remove_if(std::begin(pendingUploads), std::end(pendingUploads),
+                                        [](const auto &upload) { return upload->wait(0); }),
+                         std::end(pendingUploads));
+    pendingUploads.push_back(future);
+    return future;
+}
+
+void SessionImpl::cancelPendingUploads() {
+    std::vector<UploadFutureImpl::SharedHandle> uploads;
+    {
+        std::lock_guard<std::mutex> guard(pendingUploadsMutex);
+        uploads.swap(pendingUploads);
+    }
+    for (auto &upload : uploads) {
+        upload->cancel();
+    }
+    // The upload threads may still refer to this session.
+    for (auto &upload : uploads) {
+        upload->join();
+    }
 }
 
 void SessionImpl::startScheme() {
     std::lock_guard<std::recursive_mutex> guard(stateMutex);
     ASSERT_STATE(State::STOPPED);
-    auto ultrasound = (::arrus::devices::Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0));
-    ultrasound->start();
+    auto systems = getSystems();
+    // Start the systems waiting for the external trigger first, so none of them misses the first master trigger.
+    std::vector<size_t> order(systems.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::stable_partition(std::begin(order), std::end(order), [this](size_t i) { return isExternalTrigger(i); });
+    std::vector<Ultrasound *> started;
+    try {
+        for (auto i : order) {
+            systems[i]->start();
+            started.push_back(systems[i]);
+        }
+    } catch (...) {
+        for (auto it = std::rbegin(started); it != std::rend(started); ++it) {
+            try {
+                (*it)->stop();
+            } catch (const std::exception &e) {
+                getDefaultLogger()->log(LogSeverity::ERROR, format("Error while stopping the system: {}", e.what()));
+            }
+        }
+        throw;
+    }
     state = State::STARTED;
 }
 
 void SessionImpl::stopScheme() {
     std::lock_guard<std::recursive_mutex> guard(stateMutex);
-    auto ultrasound = (::arrus::devices::Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0));
-    ultrasound->stop();
+    auto systems = getSystems();
+    // Stop the masters first (reverse start order), so the slaves do not wait for the trigger anymore.
+    std::vector<size_t> order(systems.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::stable_partition(std::begin(order), std::end(order), [this](size_t i) { return !isExternalTrigger(i); });
+    std::exception_ptr error;
+    for (auto i : order) {
+        try {
+            systems[i]->stop();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
     state = State::STOPPED;
+    stateChanged.notify_all();
     getDefaultLogger()->log(LogSeverity::INFO, "Scheme stopped.");
 }
 
@@ -175,16 +393,31 @@ void SessionImpl::run(bool sync, std::optional<long long> timeout) {
     if (!currentScheme.has_value()) {
         throw IllegalStateException("Upload scheme before running.");
     }
+    auto systems = getSystems();
     if (state == State::STOPPED) {
         startScheme();
         if(sync) {
-            auto ultrasound = (::arrus::devices::Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0));
-            ultrasound->sync(timeout); // wait for the first TX/RX to end
+            for (auto *ultrasound : systems) {
+                ultrasound->sync(timeout); // wait for the first TX/RX to end
+            }
         }
     } else {
         if (currentScheme.value().isWorkModeManual()) {
-            auto ultrasound = (::arrus::devices::Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0));
-            ultrasound->trigger(sync, timeout);
+            if (systems.size() == 1) {
+                systems[0]->trigger(sync, timeout);
+                return;
+            }
+            // The slaves are triggered by the master, wait for them only.
+            for (size_t i = 0; i < systems.size(); ++i) {
+                if (!isExternalTrigger(i)) {
+                    systems[i]->trigger(sync, timeout);
+                }
+            }
+            for (size_t i = 0; sync && i < systems.size(); ++i) {
+                if (isExternalTrigger(i)) {
+                    systems[i]->sync(timeout);
+                }
+            }
         } else {
             throw IllegalStateException("Scheme already started.");
         }
@@ -192,6 +425,8 @@ void SessionImpl::run(bool sync, std::optional<long long> timeout) {
 }
 
 void SessionImpl::close() {
+    // NOTE: the pending uploads should be cancelled before locking the session state, they may be waiting for it.
+    cancelPendingUploads();
     std::lock_guard<std::recursive_mutex> guard(stateMutex);
     if (this->state == State::CLOSED) {
         getDefaultLogger()->log(LogSeverity::INFO, arrus::format("Session already closed."));
@@ -203,6 +438,7 @@ void SessionImpl::close() {
     getDefaultLogger()->log(LogSeverity::INFO, arrus::format("Closing session."));
     this->devices.clear();
     this->state = State::CLOSED;
+    stateChanged.notify_all();
 }
 
 void SessionImpl::setParameters(const Parameters &params) {
@@ -242,10 +478,90 @@ UploadResult SessionImpl::setSubsequence(uint16 start, uint16 end, std::optional
     std::lock_guard guard(stateMutex);
     ASSERT_STATE(State::STOPPED);
 
-    auto ultrasound = (Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0));
-    auto[buffer, metadata] = ultrasound->setSubsequence(start, end, sri);
-    return UploadResult(buffer, metadata);
+    auto results = runOnSystems(getSystems(), [=](Ultrasound *ultrasound) {
+        auto [buffer, metadata] = ultrasound->setSubsequence(start, end, sri);
+        return UploadResult(buffer, metadata);
+    });
+    // The host buffers of the resident schemes are released by the devices.
+    residentSchemes.reset();
+    return mergeResults(std::move(results));
+}
+
+UploadResult SessionImpl::switchScheme(size_t scheme) {
+    std::lock_guard guard(stateMutex);
+    ASSERT_STATE(State::STOPPED);
+    if (!residentSchemes.has_value()) {
+        throw IllegalStateException("Please upload a list of schemes before switching the scheme.");
+    }
+    ARRUS_REQUIRES_TRUE_FOR_ARGUMENT(
+        scheme < residentSchemes->getNumberOfSchemes(),
+        format("Scheme number {} is out of the range of uploaded schemes [0, {}).", scheme,
+               residentSchemes->getNumberOfSchemes()));
+    auto results = runOnSystems(getSystems(), [scheme](Ultrasound *system) {
+        auto [buffer, metadata] = dynamic_cast<Us4RImpl *>(system)->switchResidentSubsequence(scheme);
+        return UploadResult(buffer, metadata);
+    });
+    return mergeResults(std::move(results));
+}
+
+void SessionImpl::setMergedBufferConcatenation(bool enabled) {
+    std::lock_guard<std::recursive_mutex> guard(stateMutex);
+    isMergedBufferConcatenated = enabled;
+}
+
+arrus::devices::AcquisitionStatistics SessionImpl::getAcquisitionStatistics(Ordinal us4r) {
+    return getUs4R(us4r)->getAcquisitionStatistics();
+}
+
+void SessionImpl::resetAcquisitionStatistics() {
+    getUs4R(0)->resetAcquisitionStatistics();
+    for (size_t i = 1; i < us4rSettings.size(); ++i) {
+        getUs4R(Ordinal(i))->resetAcquisitionStatistics();
+    }
+}
+
+arrus::devices::Us4R *SessionImpl::getUs4R(Ordinal ordinal) {
+    if (!containsKey(devices, DeviceId(DeviceType::Us4R, 0))) {
+        throw IllegalStateException("Acquisition statistics are available for sessions with a us4R device only.");
+    }
+    DeviceId id(DeviceType::Us4R, ordinal);
+    if (!containsKey(devices, id)) {
+        throw IllegalArgumentException(arrus::format("There is no {} device in the session.", id.toString()));
+    }
+    return (Us4R *) devices.at(id).get();
+}
+
+std::vector<Ultrasound *> SessionImpl::getSystems() {
+    std::vector<Ultrasound *> result;
+    if (us4rSettings.size() > 1) {
+        for (size_t i = 0; i < us4rSettings.size(); ++i) {
+            result.push_back((Ultrasound *) getDevice(DeviceId(DeviceType::Us4R, Ordinal(i))));
+        }
+    } else {
+        result.push_back((Ultrasound *) getDevice(DeviceId(DeviceType::Ultrasound, 0)));
+    }
+    return result;
+}
+
+bool SessionImpl::isExternalTrigger(size_t system) const {
+    return system < us4rSettings.size() && us4rSettings[system].isExternalTrigger();
+}
 
+UploadResult SessionImpl::mergeResults(std::vector<UploadResult> results) const {
+    if (results.size() == 1) {
+        return results[0];
+    }
+    std::vector<framework::DataBuffer::SharedHandle> buffers;
+    for (auto &result : results) {
+        auto buffer = std::dynamic_pointer_cast<framework::DataBuffer>(result.getBuffer());
+        if (!buffer) {
+            throw IllegalStateException("The output buffers of the systems cannot be merged.");
+        }
+        buffers.push_back(buffer);
+    }
+    auto buffer = std::make_shared<framework::MergedDataBuffer>(std::move(buffers), isMergedBufferConcatenated);
+    auto metadata = results[0].getConstMetadata();
+    return UploadResult(buffer, metadata, std::move(results));
 }
 
 }// namespace arrus::session
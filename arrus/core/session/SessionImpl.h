@@ -1,14 +1,18 @@
 #ifndef ARRUS_CORE_SESSION_SESSIONIMPL_H
 #define ARRUS_CORE_SESSION_SESSIONIMPL_H
 
+#include <condition_variable>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 
 #include "arrus/core/devices/us4r/Us4RFactory.h"
 #include "arrus/core/devices/file/FileFactory.h"
 #include "arrus/core/api/session/Session.h"
 #include "arrus/core/common/hash.h"
 #include "arrus/core/devices/DeviceId.h"
+#include "arrus/core/session/ResidentSchemes.h"
+#include "arrus/core/session/UploadFutureImpl.h"
 #include "arrus/common/utils.h"
 
 namespace arrus::session {
@@ -26,6 +30,8 @@ public:
     arrus::devices::Device::RawHandle
     getDevice(const arrus::devices::DeviceId &deviceId) override;
     UploadResult upload(const ops::us4r::Scheme &scheme) override;
+    UploadResult upload(const std::vector<ops::us4r::Scheme> &schemes) override;
+    UploadFuture::SharedHandle uploadAsync(const ops::us4r::Scheme &scheme) override;
     void startScheme() override;
     void stopScheme() override;
     void run(bool async, std::optional<long long> timeout) override;
@@ -37,6 +43,10 @@ public:
     void setParameters(const Parameters &params) override;
     State getCurrentState() override;
     UploadResult setSubsequence(uint16 start, uint16 end, std::optional<float> sri) override;
+    UploadResult switchScheme(size_t scheme) override;
+    void setMergedBufferConcatenation(bool enabled) override;
+    arrus::devices::AcquisitionStatistics getAcquisitionStatistics(arrus::devices::Ordinal us4r) override;
+    void resetAcquisitionStatistics() override;
 
 private:
     ARRUS_DEFINE_ENUM_TO_STRING(
@@ -61,13 +71,41 @@ private:
         GET_HASHER_NAME(arrus::devices::DeviceId)>;
 
     void configureDevices(const SessionSettings &sessionSettings);
+    void cancelPendingUploads();
+    /**
+     * Returns the given us4R device; throws IllegalStateException if the session does not contain any us4R,
+     * IllegalArgumentException if it does not contain the given one.
+     */
+    arrus::devices::Us4R *getUs4R(arrus::devices::Ordinal ordinal);
+    /**
+     * Returns the ultrasound systems driven by this session: all the us4Rs, if there is more than one us4R,
+     * the Ultrasound:0 device otherwise.
+     */
+    std::vector<arrus::devices::Ultrasound *> getSystems();
+    /** Returns true if the given system (see getSystems) waits for an external trigger, i.e. it is a slave. */
+    bool isExternalTrigger(size_t system) const;
+    /**
+     * Merges the upload results of the consecutive systems; for multiple systems, the output buffer
+     * is a MergedDataBuffer.
+     */
+    UploadResult mergeResults(std::vector<UploadResult> results) const;
 
     DeviceMap devices;
     AliasMap aliases;
     arrus::devices::Us4RFactory::Handle us4rFactory;
     arrus::devices::FileFactory::Handle fileFactory;
     std::recursive_mutex stateMutex;
+    /** Notified on each session state change (with the stateMutex locked). */
+    std::condition_variable_any stateChanged;
+    /** Settings of the consecutive us4R devices. */
+    std::vector<arrus::devices::Us4RSettings> us4rSettings;
+    /** Whether the merged output buffer should provide the concatenated data, see setMergedBufferConcatenation. */
+    bool isMergedBufferConcatenated{false};
+    std::mutex pendingUploadsMutex;
+    std::vector<UploadFutureImpl::SharedHandle> pendingUploads;
     std::optional<ops::us4r::Scheme> currentScheme;
+    /** Schemes uploaded at once (see upload(const std::vector<Scheme>&)), nullopt for a single scheme upload. */
+    std::optional<ResidentSchemes> residentSchemes;
     State state{State::STOPPED};
     void verifyScheme(const ops::us4r::Scheme &scheme);
 };
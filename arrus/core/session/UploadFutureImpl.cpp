@@ -0,0 +1,130 @@
+#include "arrus/core/session/UploadFutureImpl.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "arrus/core/api/common/exceptions.h"
+
+namespace arrus::session {
+
+UploadFutureImpl::UploadFutureImpl(CompileFunc compile, ProgramFunc program, std::function<void()> onCancel)
+    : compile(std::move(compile)), program(std::move(program)), onCancel(std::move(onCancel)) {
+    // NOTE: the thread should be started after all the other members are initialized.
+    thread = std::thread(&UploadFutureImpl::run, this);
+}
+
+UploadFutureImpl::~UploadFutureImpl() {
+    cancel();
+    join();
+}
+
+void UploadFutureImpl::run() {
+    try {
+        compile(*this);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (stage == Stage::CANCELLED) {
+                return;
+            }
+            stage = Stage::WAITING_FOR_DEVICE;
+            progress = 0.0f;
+        }
+        UploadResult uploadResult = program(*this);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (stage == Stage::CANCELLED) {
+                // Cancelled before the device programming has started.
+                return;
+            }
+            result = std::move(uploadResult);
+            stage = Stage::DONE;
+            progress = 1.0f;
+        }
+    } catch (...) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stage == Stage::CANCELLED) {
+            return;
+        }
+        error = std::current_exception();
+        stage = Stage::FAILED;
+    }
+    finished.notify_all();
+}
+
+UploadResult UploadFutureImpl::get() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return isFinished(stage); });
+    if (stage == Stage::CANCELLED) {
+        throw IllegalStateException("The upload was cancelled.");
+    }
+    if (stage == Stage::FAILED) {
+        std::rethrow_exception(error);
+    }
+    return result;
+}
+
+bool UploadFutureImpl::wait(std::optional<long long> timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto predicate = [this]() { return isFinished(stage); };
+    if (timeout.has_value()) {
+        return finished.wait_for(lock, std::chrono::milliseconds(timeout.value()), predicate);
+    } else {
+        finished.wait(lock, predicate);
+        return true;
+    }
+}
+
+UploadFuture::Stage UploadFutureImpl::getStage() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    return stage;
+}
+
+float UploadFutureImpl::getProgress() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    return progress;
+}
+
+void UploadFutureImpl::setProgress(float value) {
+    std::unique_lock<std::mutex> lock(mutex);
+    progress = std::clamp(value, 0.0f, 1.0f);
+}
+
+bool UploadFutureImpl::cancel() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stage != Stage::COMPILING && stage != Stage::WAITING_FOR_DEVICE) {
+            return stage == Stage::CANCELLED;
+        }
+        stage = Stage::CANCELLED;
+    }
+    finished.notify_all();
+    if (onCancel) {
+        onCancel();
+    }
+    return true;
+}
+
+bool UploadFutureImpl::isCancelled() const { return getStage() == Stage::CANCELLED; }
+
+bool UploadFutureImpl::beginProgramming() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stage == Stage::CANCELLED) {
+        return false;
+    }
+    stage = Stage::PROGRAMMING;
+    progress = 0.0f;
+    return true;
+}
+
+void UploadFutureImpl::join() {
+    std::unique_lock<std::mutex> lock(threadMutex);
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool UploadFutureImpl::isFinished(Stage stage) {
+    return stage == Stage::DONE || stage == Stage::FAILED || stage == Stage::CANCELLED;
+}
+
+}
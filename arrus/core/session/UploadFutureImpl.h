@@ -0,0 +1,97 @@
+#ifndef ARRUS_CORE_SESSION_UPLOADFUTUREIMPL_H
+#define ARRUS_CORE_SESSION_UPLOADFUTUREIMPL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "arrus/core/api/session/UploadFuture.h"
+
+namespace arrus::session {
+
+/**
+ * Asynchronous upload, executed in a separate thread in two phases:
+ *
+ * 1. compile: the host-side part of the upload, should not take any device or session lock,
+ * 2. program: the device part of the upload; the function should wait for the device (if necessary), then call
+ *    beginProgramming() right before programming the device, and return immediately when beginProgramming()
+ *    returns false (the upload was cancelled in the meantime).
+ *
+ * Both functions can report the progress of their phase with setProgress.
+ */
+class UploadFutureImpl : public UploadFuture {
+public:
+    using SharedHandle = std::shared_ptr<UploadFutureImpl>;
+    using CompileFunc = std::function<void(UploadFutureImpl &)>;
+    using ProgramFunc = std::function<UploadResult(UploadFutureImpl &)>;
+
+    /**
+     * Starts the upload.
+     *
+     * @param compile the host-side part of the upload
+     * @param program the device part of the upload
+     * @param onCancel called after the upload is cancelled, e.g. to wake up the program function waiting for
+     *  the device
+     */
+    UploadFutureImpl(CompileFunc compile, ProgramFunc program, std::function<void()> onCancel = nullptr);
+
+    /**
+     * Cancels the upload (if possible) and waits for the upload thread.
+     */
+    ~UploadFutureImpl() override;
+
+    UploadFutureImpl(UploadFutureImpl const &) = delete;
+    void operator=(UploadFutureImpl const &) = delete;
+    UploadFutureImpl(UploadFutureImpl const &&) = delete;
+    void operator=(UploadFutureImpl const &&) = delete;
+
+    UploadResult get() override;
+    bool wait(std::optional<long long> timeout) override;
+    Stage getStage() const override;
+    float getProgress() const override;
+    bool cancel() override;
+
+    /**
+     * Sets the progress of the current phase, a value in [0, 1].
+     */
+    void setProgress(float value);
+
+    bool isCancelled() const;
+
+    /**
+     * Changes the stage to PROGRAMMING, unless the upload was cancelled.
+     *
+     * @return true if the device can be programmed, false if the upload was cancelled
+     */
+    bool beginProgramming();
+
+    /**
+     * Waits until the upload thread ends. Note: a cancelled upload is finished (see wait), but its thread can still
+     * be running for a while (e.g. until the compilation is done).
+     */
+    void join();
+
+private:
+    void run();
+    static bool isFinished(Stage stage);
+
+    CompileFunc compile;
+    ProgramFunc program;
+    std::function<void()> onCancel;
+
+    mutable std::mutex mutex;
+    std::condition_variable finished;
+    Stage stage{Stage::COMPILING};
+    float progress{0.0f};
+    UploadResult result;
+    std::exception_ptr error;
+    std::mutex threadMutex;
+    std::thread thread;
+};
+
+}
+
+#endif //ARRUS_CORE_SESSION_UPLOADFUTUREIMPL_H
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "arrus/core/session/UploadFutureImpl.h"
+#include "arrus/core/api/common/exceptions.h"
+#include "arrus/core/common/logging.h"
+
+namespace {
+
+using namespace arrus;
+using namespace arrus::session;
+using Stage = UploadFuture::Stage;
+
+// A gate, that blocks the upload phase until it is opened by the test.
+class Gate {
+public:
+    void open() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            isOpen = true;
+        }
+        cv.notify_all();
+    }
+
+    void pass() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return isOpen; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool isOpen{false};
+};
+
+TEST(UploadFutureImplTest, ReturnsTheProgrammingResult) {
+    std::atomic<int> nPrograms{0};
+    UploadFutureImpl future{[](UploadFutureImpl &) {}, [&](UploadFutureImpl &f) {
+                                EXPECT_TRUE(f.beginProgramming());
+                                ++nPrograms;
+                                return UploadResult{};
+                            }};
+    future.get();
+    EXPECT_EQ(future.getStage(), Stage::DONE);
+    EXPECT_EQ(nPrograms, 1);
+    EXPECT_FALSE(future.cancel());
+}
+
+TEST(UploadFutureImplTest, RethrowsUploadException) {
+    std::atomic<bool> programmed{false};
+    UploadFutureImpl future{[](UploadFutureImpl &) { throw IllegalArgumentException("Invalid scheme."); },
+                            [&](UploadFutureImpl &) {
+                                programmed = true;
+                                return UploadResult{};
+                            }};
+    EXPECT_THROW(future.get(), IllegalArgumentException);
+    EXPECT_EQ(future.getStage(), Stage::FAILED);
+    EXPECT_FALSE(programmed);
+}
+
+TEST(UploadFutureImplTest, DoesNotProgramTheDeviceWhenCancelledDuringCompilation) {
+    Gate compileGate;
+    std::atomic<bool> programmed{false};
+    UploadFutureImpl future{[&](UploadFutureImpl &) { compileGate.pass(); },
+                            [&](UploadFutureImpl &) {
+                                programmed = true;
+                                return UploadResult{};
+                            }};
+    EXPECT_EQ(future.getStage(), Stage::COMPILING);
+    EXPECT_FALSE(future.wait(10));
+    EXPECT_TRUE(future.cancel());
+    compileGate.open();
+    EXPECT_TRUE(future.wait(std::nullopt));
+    EXPECT_THROW(future.get(), IllegalStateException);
+    EXPECT_EQ(future.getStage(), Stage::CANCELLED);
+    EXPECT_FALSE(programmed);
+}
+
+TEST(UploadFutureImplTest, WakesUpProgrammingWaitingForDeviceOnCancel) {
+    Gate deviceGate;
+    std::atomic<bool> programmed{false};
+    UploadFutureImpl future{[](UploadFutureImpl &) {},
+                            [&](UploadFutureImpl &f) {
+                                deviceGate.pass();
+                                if (!f.beginProgramming()) {
+                                    return UploadResult{};
+                                }
+                                programmed = true;
+                                return UploadResult{};
+                            },
+                            [&]() { deviceGate.open(); }};
+    EXPECT_TRUE(future.cancel());
+    EXPECT_THROW(future.get(), IllegalStateException);
+    EXPECT_FALSE(programmed);
+    // The destructor waits for the upload thread.
+}
+
+TEST(UploadFutureImplTest, CannotBeCancelledDuringProgramming) {
+    Gate programmingStarted, deviceGate;
+    UploadFutureImpl future{[](UploadFutureImpl &) {}, [&](UploadFutureImpl &f) {
+                                f.beginProgramming();
+                                programmingStarted.open();
+                                deviceGate.pass();
+                                return UploadResult{};
+                            }};
+    programmingStarted.pass();
+    EXPECT_EQ(future.getStage(), Stage::PROGRAMMING);
+    EXPECT_FALSE(future.cancel());
+    deviceGate.open();
+    future.get();
+    EXPECT_EQ(future.getStage(), Stage::DONE);
+}
+
+TEST(UploadFutureImplTest, ReportsTheProgressOfEachStage) {
+    Gate compileGate, programmingStarted, deviceGate;
+    UploadFutureImpl future{[&](UploadFutureImpl &f) {
+                                f.setProgress(0.5f);
+                                compileGate.pass();
+                            },
+                            [&](UploadFutureImpl &f) {
+                                f.beginProgramming();
+                                f.setProgress(0.25f);
+                                programmingStarted.open();
+                                deviceGate.pass();
+                                return UploadResult{};
+                            }};
+    while (future.getProgress() < 0.5f) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(future.getStage(), Stage::COMPILING);
+    compileGate.open();
+    programmingStarted.pass();
+    EXPECT_EQ(future.getStage(), Stage::PROGRAMMING);
+    EXPECT_FLOAT_EQ(future.getProgress(), 0.25f);
+    deviceGate.open();
+    future.get();
+    EXPECT_FLOAT_EQ(future.getProgress(), 1.0f);
+}
+
+}// namespace
+
+int main(int argc, char **argv) {
+    ARRUS_INIT_TEST_LOG(arrus::Logging);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}